@@ -12,7 +12,14 @@ import {
   getWasmSimParity,
   getWasmSimUrl
 } from './net/env';
-import { buildClientHello, buildPing, encodeFireWeaponRequest, encodeSetLoadoutRequest } from './net/protocol';
+import {
+  buildClientHello,
+  buildPing,
+  encodeDecalDebugReport,
+  encodeFireWeaponRequest,
+  encodeSetLoadoutRequest
+} from './net/protocol';
+import { quantizeInputCmd } from './net/input_cmd';
 import type {
   GameEventBatch,
   PlayerProfile as NetPlayerProfile,
@@ -81,6 +88,7 @@ const RECOIL_RECOVERY_SPEED = 10;
 const RECOIL_RECOVERY_MIN = 4;
 const SERVER_STALE_TIMEOUT_MS = 4000;
 const SERVER_STALE_POLL_INTERVAL_MS = 500;
+const DECAL_DEBUG_REPORT_INTERVAL_MS = 250;
 const FOOTSTEP_STRIDE = resolvePlayerHeight(SIM_CONFIG);
 const RECONNECT_DELAY_MS = 1000;
 const PROJECTILE_IMPACT_SIZE_DEFAULT = 0.5;
@@ -148,7 +156,7 @@ type ProjectionTelemetryEvent = {
   };
   timestampMs: number;
 };
-type DecalDebugReport = import('./net/input_cmd').DecalDebugReport;
+type DecalDebugReport = import('./net/protocol').DecalDebugReport;
 
 const dotVec = (a: Vec3, b: Vec3) => a.x * b.x + a.y * b.y + a.z * b.z;
 
@@ -1771,6 +1779,7 @@ if (!signalingUrl) {
     const seenProjectileImpactById = new Map<number, number>();
     const pendingDecalDebugReports: DecalDebugReport[] = [];
     const MAX_PENDING_DECAL_DEBUG_REPORTS = 64;
+    let lastDecalDebugReportAt = -Infinity;
     const pruneSeenFx = (serverTick: number) => {
       if (!Number.isFinite(serverTick) || serverTick < 0) {
         return;
@@ -2813,11 +2822,11 @@ const debugFxLog = (...args: unknown[]) => {
           sampler,
           nextMessageSeq: session.nextClientMessageSeq,
           getServerSeqAck: session.getServerSeqAck,
+          getServerSeqAckBits: session.getServerSeqAckBits,
           tickRate: session.serverHello.serverTickRate,
           logger,
           onSend: (cmd) => {
             if (reconnecting) {
-              cmd.debugDecalReport = undefined;
               cmd.moveX = 0;
               cmd.moveY = 0;
               cmd.lookDeltaX = 0;
@@ -2833,10 +2842,21 @@ const debugFxLog = (...args: unknown[]) => {
               cmd.shockwave = false;
               return;
             }
-            cmd.debugDecalReport =
-              debugOverlaysVisible && pendingDecalDebugReports.length > 0
-                ? pendingDecalDebugReports.shift()
-                : undefined;
+            const reportAt = window.performance.now();
+            if (
+              debugOverlaysVisible &&
+              pendingDecalDebugReports.length > 0 &&
+              reportAt - lastDecalDebugReportAt >= DECAL_DEBUG_REPORT_INTERVAL_MS
+            ) {
+              lastDecalDebugReportAt = reportAt;
+              session.unreliableChannel.send(
+                encodeDecalDebugReport(
+                  pendingDecalDebugReports.shift()!,
+                  session.nextClientMessageSeq(),
+                  session.getServerSeqAck()
+                )
+              );
+            }
             const lookX = cmd.lookDeltaX;
             const lookY = cmd.lookDeltaY;
             adsTarget = cmd.ads ? 1 : 0;
@@ -2852,6 +2872,7 @@ const debugFxLog = (...args: unknown[]) => {
             cmd.viewYaw = angles.yaw;
             cmd.viewPitch = angles.pitch;
             applyMovementYaw(cmd, cmd.viewYaw);
+            quantizeInputCmd(cmd);
             const firePressed = cmd.fire && !lastFire;
             const fireHeld = cmd.fire;
             lastFire = cmd.fire;
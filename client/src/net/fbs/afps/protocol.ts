@@ -3,6 +3,7 @@
 /* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
 
 export { ClientHello, ClientHelloT } from './protocol/client-hello.js';
+export { DecalDebugReport, DecalDebugReportT } from './protocol/decal-debug-report.js';
 export { Disconnect, DisconnectT } from './protocol/disconnect.js';
 export { Error, ErrorT } from './protocol/error.js';
 export { FireWeaponRequest, FireWeaponRequestT } from './protocol/fire-weapon-request.js';
@@ -11,6 +12,7 @@ export { GameEvent, GameEventT } from './protocol/game-event.js';
 export { HitConfirmedFx, HitConfirmedFxT } from './protocol/hit-confirmed-fx.js';
 export { HitKind } from './protocol/hit-kind.js';
 export { InputCmd, InputCmdT } from './protocol/input-cmd.js';
+export { InputFrame, InputFrameT } from './protocol/input-frame.js';
 export { JoinAccept, JoinAcceptT } from './protocol/join-accept.js';
 export { JoinRequest, JoinRequestT } from './protocol/join-request.js';
 export { KillFeedFx, KillFeedFxT } from './protocol/kill-feed-fx.js';
@@ -36,3 +38,4 @@ export { StateSnapshot, StateSnapshotT } from './protocol/state-snapshot.js';
 export { StateSnapshotDelta, StateSnapshotDeltaT } from './protocol/state-snapshot-delta.js';
 export { SurfaceType } from './protocol/surface-type.js';
 export { VentFx, VentFxT } from './protocol/vent-fx.js';
+export { WorldSnapshot, WorldSnapshotT } from './protocol/world-snapshot.js';
@@ -0,0 +1,369 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+import * as flatbuffers from 'flatbuffers';
+
+
+
+export class DecalDebugReport implements flatbuffers.IUnpackableObject<DecalDebugReportT> {
+  bb: flatbuffers.ByteBuffer|null = null;
+  bb_pos = 0;
+  __init(i:number, bb:flatbuffers.ByteBuffer):DecalDebugReport {
+  this.bb_pos = i;
+  this.bb = bb;
+  return this;
+}
+
+static getRootAsDecalDebugReport(bb:flatbuffers.ByteBuffer, obj?:DecalDebugReport):DecalDebugReport {
+  return (obj || new DecalDebugReport()).__init(bb.readInt32(bb.position()) + bb.position(), bb);
+}
+
+static getSizePrefixedRootAsDecalDebugReport(bb:flatbuffers.ByteBuffer, obj?:DecalDebugReport):DecalDebugReport {
+  bb.setPosition(bb.position() + flatbuffers.SIZE_PREFIX_LENGTH);
+  return (obj || new DecalDebugReport()).__init(bb.readInt32(bb.position()) + bb.position(), bb);
+}
+
+serverTick():number {
+  const offset = this.bb!.__offset(this.bb_pos, 4);
+  return offset ? this.bb!.readInt32(this.bb_pos + offset) : 0;
+}
+
+shotSeq():number {
+  const offset = this.bb!.__offset(this.bb_pos, 6);
+  return offset ? this.bb!.readInt32(this.bb_pos + offset) : 0;
+}
+
+hitKind():number {
+  const offset = this.bb!.__offset(this.bb_pos, 8);
+  return offset ? this.bb!.readUint8(this.bb_pos + offset) : 0;
+}
+
+surfaceType():number {
+  const offset = this.bb!.__offset(this.bb_pos, 10);
+  return offset ? this.bb!.readUint8(this.bb_pos + offset) : 0;
+}
+
+authoritativeWorldHit():boolean {
+  const offset = this.bb!.__offset(this.bb_pos, 12);
+  return offset ? !!this.bb!.readInt8(this.bb_pos + offset) : false;
+}
+
+usedProjectedHit():boolean {
+  const offset = this.bb!.__offset(this.bb_pos, 14);
+  return offset ? !!this.bb!.readInt8(this.bb_pos + offset) : false;
+}
+
+usedImpactProjection():boolean {
+  const offset = this.bb!.__offset(this.bb_pos, 16);
+  return offset ? !!this.bb!.readInt8(this.bb_pos + offset) : false;
+}
+
+decalSpawned():boolean {
+  const offset = this.bb!.__offset(this.bb_pos, 18);
+  return offset ? !!this.bb!.readInt8(this.bb_pos + offset) : false;
+}
+
+decalInFrustum():boolean {
+  const offset = this.bb!.__offset(this.bb_pos, 20);
+  return offset ? !!this.bb!.readInt8(this.bb_pos + offset) : false;
+}
+
+decalDistance():number {
+  const offset = this.bb!.__offset(this.bb_pos, 22);
+  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : -1.0;
+}
+
+decalPositionX():number {
+  const offset = this.bb!.__offset(this.bb_pos, 24);
+  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+}
+
+decalPositionY():number {
+  const offset = this.bb!.__offset(this.bb_pos, 26);
+  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+}
+
+decalPositionZ():number {
+  const offset = this.bb!.__offset(this.bb_pos, 28);
+  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+}
+
+decalNormalX():number {
+  const offset = this.bb!.__offset(this.bb_pos, 30);
+  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+}
+
+decalNormalY():number {
+  const offset = this.bb!.__offset(this.bb_pos, 32);
+  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+}
+
+decalNormalZ():number {
+  const offset = this.bb!.__offset(this.bb_pos, 34);
+  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+}
+
+traceHitPositionX():number {
+  const offset = this.bb!.__offset(this.bb_pos, 36);
+  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+}
+
+traceHitPositionY():number {
+  const offset = this.bb!.__offset(this.bb_pos, 38);
+  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+}
+
+traceHitPositionZ():number {
+  const offset = this.bb!.__offset(this.bb_pos, 40);
+  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+}
+
+traceHitNormalX():number {
+  const offset = this.bb!.__offset(this.bb_pos, 42);
+  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+}
+
+traceHitNormalY():number {
+  const offset = this.bb!.__offset(this.bb_pos, 44);
+  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+}
+
+traceHitNormalZ():number {
+  const offset = this.bb!.__offset(this.bb_pos, 46);
+  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+}
+
+static startDecalDebugReport(builder:flatbuffers.Builder) {
+  builder.startObject(22);
+}
+
+static addServerTick(builder:flatbuffers.Builder, serverTick:number) {
+  builder.addFieldInt32(0, serverTick, 0);
+}
+
+static addShotSeq(builder:flatbuffers.Builder, shotSeq:number) {
+  builder.addFieldInt32(1, shotSeq, 0);
+}
+
+static addHitKind(builder:flatbuffers.Builder, hitKind:number) {
+  builder.addFieldInt8(2, hitKind, 0);
+}
+
+static addSurfaceType(builder:flatbuffers.Builder, surfaceType:number) {
+  builder.addFieldInt8(3, surfaceType, 0);
+}
+
+static addAuthoritativeWorldHit(builder:flatbuffers.Builder, authoritativeWorldHit:boolean) {
+  builder.addFieldInt8(4, +authoritativeWorldHit, +false);
+}
+
+static addUsedProjectedHit(builder:flatbuffers.Builder, usedProjectedHit:boolean) {
+  builder.addFieldInt8(5, +usedProjectedHit, +false);
+}
+
+static addUsedImpactProjection(builder:flatbuffers.Builder, usedImpactProjection:boolean) {
+  builder.addFieldInt8(6, +usedImpactProjection, +false);
+}
+
+static addDecalSpawned(builder:flatbuffers.Builder, decalSpawned:boolean) {
+  builder.addFieldInt8(7, +decalSpawned, +false);
+}
+
+static addDecalInFrustum(builder:flatbuffers.Builder, decalInFrustum:boolean) {
+  builder.addFieldInt8(8, +decalInFrustum, +false);
+}
+
+static addDecalDistance(builder:flatbuffers.Builder, decalDistance:number) {
+  builder.addFieldFloat64(9, decalDistance, -1.0);
+}
+
+static addDecalPositionX(builder:flatbuffers.Builder, decalPositionX:number) {
+  builder.addFieldFloat64(10, decalPositionX, 0.0);
+}
+
+static addDecalPositionY(builder:flatbuffers.Builder, decalPositionY:number) {
+  builder.addFieldFloat64(11, decalPositionY, 0.0);
+}
+
+static addDecalPositionZ(builder:flatbuffers.Builder, decalPositionZ:number) {
+  builder.addFieldFloat64(12, decalPositionZ, 0.0);
+}
+
+static addDecalNormalX(builder:flatbuffers.Builder, decalNormalX:number) {
+  builder.addFieldFloat64(13, decalNormalX, 0.0);
+}
+
+static addDecalNormalY(builder:flatbuffers.Builder, decalNormalY:number) {
+  builder.addFieldFloat64(14, decalNormalY, 0.0);
+}
+
+static addDecalNormalZ(builder:flatbuffers.Builder, decalNormalZ:number) {
+  builder.addFieldFloat64(15, decalNormalZ, 0.0);
+}
+
+static addTraceHitPositionX(builder:flatbuffers.Builder, traceHitPositionX:number) {
+  builder.addFieldFloat64(16, traceHitPositionX, 0.0);
+}
+
+static addTraceHitPositionY(builder:flatbuffers.Builder, traceHitPositionY:number) {
+  builder.addFieldFloat64(17, traceHitPositionY, 0.0);
+}
+
+static addTraceHitPositionZ(builder:flatbuffers.Builder, traceHitPositionZ:number) {
+  builder.addFieldFloat64(18, traceHitPositionZ, 0.0);
+}
+
+static addTraceHitNormalX(builder:flatbuffers.Builder, traceHitNormalX:number) {
+  builder.addFieldFloat64(19, traceHitNormalX, 0.0);
+}
+
+static addTraceHitNormalY(builder:flatbuffers.Builder, traceHitNormalY:number) {
+  builder.addFieldFloat64(20, traceHitNormalY, 0.0);
+}
+
+static addTraceHitNormalZ(builder:flatbuffers.Builder, traceHitNormalZ:number) {
+  builder.addFieldFloat64(21, traceHitNormalZ, 0.0);
+}
+
+static endDecalDebugReport(builder:flatbuffers.Builder):flatbuffers.Offset {
+  const offset = builder.endObject();
+  return offset;
+}
+
+static createDecalDebugReport(builder:flatbuffers.Builder, serverTick:number, shotSeq:number, hitKind:number, surfaceType:number, authoritativeWorldHit:boolean, usedProjectedHit:boolean, usedImpactProjection:boolean, decalSpawned:boolean, decalInFrustum:boolean, decalDistance:number, decalPositionX:number, decalPositionY:number, decalPositionZ:number, decalNormalX:number, decalNormalY:number, decalNormalZ:number, traceHitPositionX:number, traceHitPositionY:number, traceHitPositionZ:number, traceHitNormalX:number, traceHitNormalY:number, traceHitNormalZ:number):flatbuffers.Offset {
+  DecalDebugReport.startDecalDebugReport(builder);
+  DecalDebugReport.addServerTick(builder, serverTick);
+  DecalDebugReport.addShotSeq(builder, shotSeq);
+  DecalDebugReport.addHitKind(builder, hitKind);
+  DecalDebugReport.addSurfaceType(builder, surfaceType);
+  DecalDebugReport.addAuthoritativeWorldHit(builder, authoritativeWorldHit);
+  DecalDebugReport.addUsedProjectedHit(builder, usedProjectedHit);
+  DecalDebugReport.addUsedImpactProjection(builder, usedImpactProjection);
+  DecalDebugReport.addDecalSpawned(builder, decalSpawned);
+  DecalDebugReport.addDecalInFrustum(builder, decalInFrustum);
+  DecalDebugReport.addDecalDistance(builder, decalDistance);
+  DecalDebugReport.addDecalPositionX(builder, decalPositionX);
+  DecalDebugReport.addDecalPositionY(builder, decalPositionY);
+  DecalDebugReport.addDecalPositionZ(builder, decalPositionZ);
+  DecalDebugReport.addDecalNormalX(builder, decalNormalX);
+  DecalDebugReport.addDecalNormalY(builder, decalNormalY);
+  DecalDebugReport.addDecalNormalZ(builder, decalNormalZ);
+  DecalDebugReport.addTraceHitPositionX(builder, traceHitPositionX);
+  DecalDebugReport.addTraceHitPositionY(builder, traceHitPositionY);
+  DecalDebugReport.addTraceHitPositionZ(builder, traceHitPositionZ);
+  DecalDebugReport.addTraceHitNormalX(builder, traceHitNormalX);
+  DecalDebugReport.addTraceHitNormalY(builder, traceHitNormalY);
+  DecalDebugReport.addTraceHitNormalZ(builder, traceHitNormalZ);
+  return DecalDebugReport.endDecalDebugReport(builder);
+}
+
+unpack(): DecalDebugReportT {
+  return new DecalDebugReportT(
+    this.serverTick(),
+    this.shotSeq(),
+    this.hitKind(),
+    this.surfaceType(),
+    this.authoritativeWorldHit(),
+    this.usedProjectedHit(),
+    this.usedImpactProjection(),
+    this.decalSpawned(),
+    this.decalInFrustum(),
+    this.decalDistance(),
+    this.decalPositionX(),
+    this.decalPositionY(),
+    this.decalPositionZ(),
+    this.decalNormalX(),
+    this.decalNormalY(),
+    this.decalNormalZ(),
+    this.traceHitPositionX(),
+    this.traceHitPositionY(),
+    this.traceHitPositionZ(),
+    this.traceHitNormalX(),
+    this.traceHitNormalY(),
+    this.traceHitNormalZ()
+  );
+}
+
+
+unpackTo(_o: DecalDebugReportT): void {
+  _o.serverTick = this.serverTick();
+  _o.shotSeq = this.shotSeq();
+  _o.hitKind = this.hitKind();
+  _o.surfaceType = this.surfaceType();
+  _o.authoritativeWorldHit = this.authoritativeWorldHit();
+  _o.usedProjectedHit = this.usedProjectedHit();
+  _o.usedImpactProjection = this.usedImpactProjection();
+  _o.decalSpawned = this.decalSpawned();
+  _o.decalInFrustum = this.decalInFrustum();
+  _o.decalDistance = this.decalDistance();
+  _o.decalPositionX = this.decalPositionX();
+  _o.decalPositionY = this.decalPositionY();
+  _o.decalPositionZ = this.decalPositionZ();
+  _o.decalNormalX = this.decalNormalX();
+  _o.decalNormalY = this.decalNormalY();
+  _o.decalNormalZ = this.decalNormalZ();
+  _o.traceHitPositionX = this.traceHitPositionX();
+  _o.traceHitPositionY = this.traceHitPositionY();
+  _o.traceHitPositionZ = this.traceHitPositionZ();
+  _o.traceHitNormalX = this.traceHitNormalX();
+  _o.traceHitNormalY = this.traceHitNormalY();
+  _o.traceHitNormalZ = this.traceHitNormalZ();
+}
+}
+
+export class DecalDebugReportT implements flatbuffers.IGeneratedObject {
+constructor(
+  public serverTick: number = 0,
+  public shotSeq: number = 0,
+  public hitKind: number = 0,
+  public surfaceType: number = 0,
+  public authoritativeWorldHit: boolean = false,
+  public usedProjectedHit: boolean = false,
+  public usedImpactProjection: boolean = false,
+  public decalSpawned: boolean = false,
+  public decalInFrustum: boolean = false,
+  public decalDistance: number = -1.0,
+  public decalPositionX: number = 0.0,
+  public decalPositionY: number = 0.0,
+  public decalPositionZ: number = 0.0,
+  public decalNormalX: number = 0.0,
+  public decalNormalY: number = 0.0,
+  public decalNormalZ: number = 0.0,
+  public traceHitPositionX: number = 0.0,
+  public traceHitPositionY: number = 0.0,
+  public traceHitPositionZ: number = 0.0,
+  public traceHitNormalX: number = 0.0,
+  public traceHitNormalY: number = 0.0,
+  public traceHitNormalZ: number = 0.0
+){}
+
+
+pack(builder:flatbuffers.Builder): flatbuffers.Offset {
+
+  return DecalDebugReport.createDecalDebugReport(builder,
+    this.serverTick,
+    this.shotSeq,
+    this.hitKind,
+    this.surfaceType,
+    this.authoritativeWorldHit,
+    this.usedProjectedHit,
+    this.usedImpactProjection,
+    this.decalSpawned,
+    this.decalInFrustum,
+    this.decalDistance,
+    this.decalPositionX,
+    this.decalPositionY,
+    this.decalPositionZ,
+    this.decalNormalX,
+    this.decalNormalY,
+    this.decalNormalZ,
+    this.traceHitPositionX,
+    this.traceHitPositionY,
+    this.traceHitPositionZ,
+    this.traceHitNormalX,
+    this.traceHitNormalY,
+    this.traceHitNormalZ
+  );
+}
+}
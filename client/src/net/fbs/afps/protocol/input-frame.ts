@@ -0,0 +1,111 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+import * as flatbuffers from 'flatbuffers';
+
+
+
+export class InputFrame implements flatbuffers.IUnpackableObject<InputFrameT> {
+  bb: flatbuffers.ByteBuffer|null = null;
+  bb_pos = 0;
+  __init(i:number, bb:flatbuffers.ByteBuffer):InputFrame {
+  this.bb_pos = i;
+  this.bb = bb;
+  return this;
+}
+
+inputSeq():number {
+  return this.bb!.readInt32(this.bb_pos);
+}
+
+moveXQ():number {
+  return this.bb!.readInt8(this.bb_pos + 4);
+}
+
+moveYQ():number {
+  return this.bb!.readInt8(this.bb_pos + 5);
+}
+
+buttons():number {
+  return this.bb!.readUint16(this.bb_pos + 6);
+}
+
+viewYawQ():number {
+  return this.bb!.readInt16(this.bb_pos + 8);
+}
+
+viewPitchQ():number {
+  return this.bb!.readInt16(this.bb_pos + 10);
+}
+
+weaponSlot():number {
+  return this.bb!.readUint8(this.bb_pos + 12);
+}
+
+static sizeOf():number {
+  return 16;
+}
+
+static createInputFrame(builder:flatbuffers.Builder, input_seq: number, move_x_q: number, move_y_q: number, buttons: number, view_yaw_q: number, view_pitch_q: number, weapon_slot: number):flatbuffers.Offset {
+  builder.prep(4, 16);
+  builder.pad(3);
+  builder.writeInt8(weapon_slot);
+  builder.writeInt16(view_pitch_q);
+  builder.writeInt16(view_yaw_q);
+  builder.writeInt16(buttons);
+  builder.writeInt8(move_y_q);
+  builder.writeInt8(move_x_q);
+  builder.writeInt32(input_seq);
+  return builder.offset();
+}
+
+
+unpack(): InputFrameT {
+  return new InputFrameT(
+    this.inputSeq(),
+    this.moveXQ(),
+    this.moveYQ(),
+    this.buttons(),
+    this.viewYawQ(),
+    this.viewPitchQ(),
+    this.weaponSlot()
+  );
+}
+
+
+unpackTo(_o: InputFrameT): void {
+  _o.inputSeq = this.inputSeq();
+  _o.moveXQ = this.moveXQ();
+  _o.moveYQ = this.moveYQ();
+  _o.buttons = this.buttons();
+  _o.viewYawQ = this.viewYawQ();
+  _o.viewPitchQ = this.viewPitchQ();
+  _o.weaponSlot = this.weaponSlot();
+}
+}
+
+export class InputFrameT implements flatbuffers.IGeneratedObject {
+constructor(
+  public inputSeq: number = 0,
+  public moveXQ: number = 0,
+  public moveYQ: number = 0,
+  public buttons: number = 0,
+  public viewYawQ: number = 0,
+  public viewPitchQ: number = 0,
+  public weaponSlot: number = 0
+){}
+
+
+pack(builder:flatbuffers.Builder): flatbuffers.Offset {
+  return InputFrame.createInputFrame(builder,
+    this.inputSeq,
+    this.moveXQ,
+    this.moveYQ,
+    this.buttons,
+    this.viewYawQ,
+    this.viewPitchQ,
+    this.weaponSlot
+  );
+}
+}
@@ -17,5 +17,7 @@ export enum MessageType {
   Error = 12,
   Disconnect = 13,
   FireWeaponRequest = 14,
-  SetLoadoutRequest = 15
+  SetLoadoutRequest = 15,
+  WorldSnapshot = 16,
+  DecalDebugReport = 17
 }
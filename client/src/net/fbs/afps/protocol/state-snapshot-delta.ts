@@ -51,64 +51,64 @@ clientId(optionalEncoding?:any):string|Uint8Array|null {
   return offset ? this.bb!.__string(this.bb_pos + offset, optionalEncoding) : null;
 }
 
-posX():number {
+posXQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 14);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readInt16(this.bb_pos + offset) : 0;
 }
 
-posY():number {
+posYQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 16);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readInt16(this.bb_pos + offset) : 0;
 }
 
-posZ():number {
+posZQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 18);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readInt16(this.bb_pos + offset) : 0;
 }
 
-velX():number {
+velXQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 20);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readInt16(this.bb_pos + offset) : 0;
 }
 
-velY():number {
+velYQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 22);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readInt16(this.bb_pos + offset) : 0;
 }
 
-velZ():number {
+velZQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 24);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readInt16(this.bb_pos + offset) : 0;
 }
 
 weaponSlot():number {
   const offset = this.bb!.__offset(this.bb_pos, 26);
-  return offset ? this.bb!.readInt32(this.bb_pos + offset) : 0;
+  return offset ? this.bb!.readUint8(this.bb_pos + offset) : 0;
 }
 
 ammoInMag():number {
   const offset = this.bb!.__offset(this.bb_pos, 28);
-  return offset ? this.bb!.readInt32(this.bb_pos + offset) : 0;
+  return offset ? this.bb!.readUint16(this.bb_pos + offset) : 0;
 }
 
-dashCooldown():number {
+dashCooldownQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 30);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readUint8(this.bb_pos + offset) : 0;
 }
 
-health():number {
+healthQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 32);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readUint16(this.bb_pos + offset) : 0;
 }
 
 kills():number {
   const offset = this.bb!.__offset(this.bb_pos, 34);
-  return offset ? this.bb!.readInt32(this.bb_pos + offset) : 0;
+  return offset ? this.bb!.readUint16(this.bb_pos + offset) : 0;
 }
 
 deaths():number {
   const offset = this.bb!.__offset(this.bb_pos, 36);
-  return offset ? this.bb!.readInt32(this.bb_pos + offset) : 0;
+  return offset ? this.bb!.readUint16(this.bb_pos + offset) : 0;
 }
 
 viewYawQ():number {
@@ -160,52 +160,52 @@ static addClientId(builder:flatbuffers.Builder, clientIdOffset:flatbuffers.Offse
   builder.addFieldOffset(4, clientIdOffset, 0);
 }
 
-static addPosX(builder:flatbuffers.Builder, posX:number) {
-  builder.addFieldFloat64(5, posX, 0.0);
+static addPosXQ(builder:flatbuffers.Builder, posXQ:number) {
+  builder.addFieldInt16(5, posXQ, 0);
 }
 
-static addPosY(builder:flatbuffers.Builder, posY:number) {
-  builder.addFieldFloat64(6, posY, 0.0);
+static addPosYQ(builder:flatbuffers.Builder, posYQ:number) {
+  builder.addFieldInt16(6, posYQ, 0);
 }
 
-static addPosZ(builder:flatbuffers.Builder, posZ:number) {
-  builder.addFieldFloat64(7, posZ, 0.0);
+static addPosZQ(builder:flatbuffers.Builder, posZQ:number) {
+  builder.addFieldInt16(7, posZQ, 0);
 }
 
-static addVelX(builder:flatbuffers.Builder, velX:number) {
-  builder.addFieldFloat64(8, velX, 0.0);
+static addVelXQ(builder:flatbuffers.Builder, velXQ:number) {
+  builder.addFieldInt16(8, velXQ, 0);
 }
 
-static addVelY(builder:flatbuffers.Builder, velY:number) {
-  builder.addFieldFloat64(9, velY, 0.0);
+static addVelYQ(builder:flatbuffers.Builder, velYQ:number) {
+  builder.addFieldInt16(9, velYQ, 0);
 }
 
-static addVelZ(builder:flatbuffers.Builder, velZ:number) {
-  builder.addFieldFloat64(10, velZ, 0.0);
+static addVelZQ(builder:flatbuffers.Builder, velZQ:number) {
+  builder.addFieldInt16(10, velZQ, 0);
 }
 
 static addWeaponSlot(builder:flatbuffers.Builder, weaponSlot:number) {
-  builder.addFieldInt32(11, weaponSlot, 0);
+  builder.addFieldInt8(11, weaponSlot, 0);
 }
 
 static addAmmoInMag(builder:flatbuffers.Builder, ammoInMag:number) {
-  builder.addFieldInt32(12, ammoInMag, 0);
+  builder.addFieldInt16(12, ammoInMag, 0);
 }
 
-static addDashCooldown(builder:flatbuffers.Builder, dashCooldown:number) {
-  builder.addFieldFloat64(13, dashCooldown, 0.0);
+static addDashCooldownQ(builder:flatbuffers.Builder, dashCooldownQ:number) {
+  builder.addFieldInt8(13, dashCooldownQ, 0);
 }
 
-static addHealth(builder:flatbuffers.Builder, health:number) {
-  builder.addFieldFloat64(14, health, 0.0);
+static addHealthQ(builder:flatbuffers.Builder, healthQ:number) {
+  builder.addFieldInt16(14, healthQ, 0);
 }
 
 static addKills(builder:flatbuffers.Builder, kills:number) {
-  builder.addFieldInt32(15, kills, 0);
+  builder.addFieldInt16(15, kills, 0);
 }
 
 static addDeaths(builder:flatbuffers.Builder, deaths:number) {
-  builder.addFieldInt32(16, deaths, 0);
+  builder.addFieldInt16(16, deaths, 0);
 }
 
 static addViewYawQ(builder:flatbuffers.Builder, viewYawQ:number) {
@@ -233,23 +233,23 @@ static endStateSnapshotDelta(builder:flatbuffers.Builder):flatbuffers.Offset {
   return offset;
 }
 
-static createStateSnapshotDelta(builder:flatbuffers.Builder, serverTick:number, baseTick:number, lastProcessedInputSeq:number, mask:number, clientIdOffset:flatbuffers.Offset, posX:number, posY:number, posZ:number, velX:number, velY:number, velZ:number, weaponSlot:number, ammoInMag:number, dashCooldown:number, health:number, kills:number, deaths:number, viewYawQ:number, viewPitchQ:number, playerFlags:number, weaponHeatQ:number, loadoutBits:number):flatbuffers.Offset {
+static createStateSnapshotDelta(builder:flatbuffers.Builder, serverTick:number, baseTick:number, lastProcessedInputSeq:number, mask:number, clientIdOffset:flatbuffers.Offset, posXQ:number, posYQ:number, posZQ:number, velXQ:number, velYQ:number, velZQ:number, weaponSlot:number, ammoInMag:number, dashCooldownQ:number, healthQ:number, kills:number, deaths:number, viewYawQ:number, viewPitchQ:number, playerFlags:number, weaponHeatQ:number, loadoutBits:number):flatbuffers.Offset {
   StateSnapshotDelta.startStateSnapshotDelta(builder);
   StateSnapshotDelta.addServerTick(builder, serverTick);
   StateSnapshotDelta.addBaseTick(builder, baseTick);
   StateSnapshotDelta.addLastProcessedInputSeq(builder, lastProcessedInputSeq);
   StateSnapshotDelta.addMask(builder, mask);
   StateSnapshotDelta.addClientId(builder, clientIdOffset);
-  StateSnapshotDelta.addPosX(builder, posX);
-  StateSnapshotDelta.addPosY(builder, posY);
-  StateSnapshotDelta.addPosZ(builder, posZ);
-  StateSnapshotDelta.addVelX(builder, velX);
-  StateSnapshotDelta.addVelY(builder, velY);
-  StateSnapshotDelta.addVelZ(builder, velZ);
+  StateSnapshotDelta.addPosXQ(builder, posXQ);
+  StateSnapshotDelta.addPosYQ(builder, posYQ);
+  StateSnapshotDelta.addPosZQ(builder, posZQ);
+  StateSnapshotDelta.addVelXQ(builder, velXQ);
+  StateSnapshotDelta.addVelYQ(builder, velYQ);
+  StateSnapshotDelta.addVelZQ(builder, velZQ);
   StateSnapshotDelta.addWeaponSlot(builder, weaponSlot);
   StateSnapshotDelta.addAmmoInMag(builder, ammoInMag);
-  StateSnapshotDelta.addDashCooldown(builder, dashCooldown);
-  StateSnapshotDelta.addHealth(builder, health);
+  StateSnapshotDelta.addDashCooldownQ(builder, dashCooldownQ);
+  StateSnapshotDelta.addHealthQ(builder, healthQ);
   StateSnapshotDelta.addKills(builder, kills);
   StateSnapshotDelta.addDeaths(builder, deaths);
   StateSnapshotDelta.addViewYawQ(builder, viewYawQ);
@@ -267,16 +267,16 @@ unpack(): StateSnapshotDeltaT {
     this.lastProcessedInputSeq(),
     this.mask(),
     this.clientId(),
-    this.posX(),
-    this.posY(),
-    this.posZ(),
-    this.velX(),
-    this.velY(),
-    this.velZ(),
+    this.posXQ(),
+    this.posYQ(),
+    this.posZQ(),
+    this.velXQ(),
+    this.velYQ(),
+    this.velZQ(),
     this.weaponSlot(),
     this.ammoInMag(),
-    this.dashCooldown(),
-    this.health(),
+    this.dashCooldownQ(),
+    this.healthQ(),
     this.kills(),
     this.deaths(),
     this.viewYawQ(),
@@ -294,16 +294,16 @@ unpackTo(_o: StateSnapshotDeltaT): void {
   _o.lastProcessedInputSeq = this.lastProcessedInputSeq();
   _o.mask = this.mask();
   _o.clientId = this.clientId();
-  _o.posX = this.posX();
-  _o.posY = this.posY();
-  _o.posZ = this.posZ();
-  _o.velX = this.velX();
-  _o.velY = this.velY();
-  _o.velZ = this.velZ();
+  _o.posXQ = this.posXQ();
+  _o.posYQ = this.posYQ();
+  _o.posZQ = this.posZQ();
+  _o.velXQ = this.velXQ();
+  _o.velYQ = this.velYQ();
+  _o.velZQ = this.velZQ();
   _o.weaponSlot = this.weaponSlot();
   _o.ammoInMag = this.ammoInMag();
-  _o.dashCooldown = this.dashCooldown();
-  _o.health = this.health();
+  _o.dashCooldownQ = this.dashCooldownQ();
+  _o.healthQ = this.healthQ();
   _o.kills = this.kills();
   _o.deaths = this.deaths();
   _o.viewYawQ = this.viewYawQ();
@@ -321,16 +321,16 @@ constructor(
   public lastProcessedInputSeq: number = 0,
   public mask: number = 0,
   public clientId: string|Uint8Array|null = null,
-  public posX: number = 0.0,
-  public posY: number = 0.0,
-  public posZ: number = 0.0,
-  public velX: number = 0.0,
-  public velY: number = 0.0,
-  public velZ: number = 0.0,
+  public posXQ: number = 0,
+  public posYQ: number = 0,
+  public posZQ: number = 0,
+  public velXQ: number = 0,
+  public velYQ: number = 0,
+  public velZQ: number = 0,
   public weaponSlot: number = 0,
   public ammoInMag: number = 0,
-  public dashCooldown: number = 0.0,
-  public health: number = 0.0,
+  public dashCooldownQ: number = 0,
+  public healthQ: number = 0,
   public kills: number = 0,
   public deaths: number = 0,
   public viewYawQ: number = 0,
@@ -350,16 +350,16 @@ pack(builder:flatbuffers.Builder): flatbuffers.Offset {
     this.lastProcessedInputSeq,
     this.mask,
     clientId,
-    this.posX,
-    this.posY,
-    this.posZ,
-    this.velX,
-    this.velY,
-    this.velZ,
+    this.posXQ,
+    this.posYQ,
+    this.posZQ,
+    this.velXQ,
+    this.velYQ,
+    this.velZQ,
     this.weaponSlot,
     this.ammoInMag,
-    this.dashCooldown,
-    this.health,
+    this.dashCooldownQ,
+    this.healthQ,
     this.kills,
     this.deaths,
     this.viewYawQ,
@@ -41,64 +41,64 @@ clientId(optionalEncoding?:any):string|Uint8Array|null {
   return offset ? this.bb!.__string(this.bb_pos + offset, optionalEncoding) : null;
 }
 
-posX():number {
+posXQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 10);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readInt16(this.bb_pos + offset) : 0;
 }
 
-posY():number {
+posYQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 12);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readInt16(this.bb_pos + offset) : 0;
 }
 
-posZ():number {
+posZQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 14);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readInt16(this.bb_pos + offset) : 0;
 }
 
-velX():number {
+velXQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 16);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readInt16(this.bb_pos + offset) : 0;
 }
 
-velY():number {
+velYQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 18);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readInt16(this.bb_pos + offset) : 0;
 }
 
-velZ():number {
+velZQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 20);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readInt16(this.bb_pos + offset) : 0;
 }
 
 weaponSlot():number {
   const offset = this.bb!.__offset(this.bb_pos, 22);
-  return offset ? this.bb!.readInt32(this.bb_pos + offset) : 0;
+  return offset ? this.bb!.readUint8(this.bb_pos + offset) : 0;
 }
 
 ammoInMag():number {
   const offset = this.bb!.__offset(this.bb_pos, 24);
-  return offset ? this.bb!.readInt32(this.bb_pos + offset) : 0;
+  return offset ? this.bb!.readUint16(this.bb_pos + offset) : 0;
 }
 
-dashCooldown():number {
+dashCooldownQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 26);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readUint8(this.bb_pos + offset) : 0;
 }
 
-health():number {
+healthQ():number {
   const offset = this.bb!.__offset(this.bb_pos, 28);
-  return offset ? this.bb!.readFloat64(this.bb_pos + offset) : 0.0;
+  return offset ? this.bb!.readUint16(this.bb_pos + offset) : 0;
 }
 
 kills():number {
   const offset = this.bb!.__offset(this.bb_pos, 30);
-  return offset ? this.bb!.readInt32(this.bb_pos + offset) : 0;
+  return offset ? this.bb!.readUint16(this.bb_pos + offset) : 0;
 }
 
 deaths():number {
   const offset = this.bb!.__offset(this.bb_pos, 32);
-  return offset ? this.bb!.readInt32(this.bb_pos + offset) : 0;
+  return offset ? this.bb!.readUint16(this.bb_pos + offset) : 0;
 }
 
 viewYawQ():number {
@@ -142,52 +142,52 @@ static addClientId(builder:flatbuffers.Builder, clientIdOffset:flatbuffers.Offse
   builder.addFieldOffset(2, clientIdOffset, 0);
 }
 
-static addPosX(builder:flatbuffers.Builder, posX:number) {
-  builder.addFieldFloat64(3, posX, 0.0);
+static addPosXQ(builder:flatbuffers.Builder, posXQ:number) {
+  builder.addFieldInt16(3, posXQ, 0);
 }
 
-static addPosY(builder:flatbuffers.Builder, posY:number) {
-  builder.addFieldFloat64(4, posY, 0.0);
+static addPosYQ(builder:flatbuffers.Builder, posYQ:number) {
+  builder.addFieldInt16(4, posYQ, 0);
 }
 
-static addPosZ(builder:flatbuffers.Builder, posZ:number) {
-  builder.addFieldFloat64(5, posZ, 0.0);
+static addPosZQ(builder:flatbuffers.Builder, posZQ:number) {
+  builder.addFieldInt16(5, posZQ, 0);
 }
 
-static addVelX(builder:flatbuffers.Builder, velX:number) {
-  builder.addFieldFloat64(6, velX, 0.0);
+static addVelXQ(builder:flatbuffers.Builder, velXQ:number) {
+  builder.addFieldInt16(6, velXQ, 0);
 }
 
-static addVelY(builder:flatbuffers.Builder, velY:number) {
-  builder.addFieldFloat64(7, velY, 0.0);
+static addVelYQ(builder:flatbuffers.Builder, velYQ:number) {
+  builder.addFieldInt16(7, velYQ, 0);
 }
 
-static addVelZ(builder:flatbuffers.Builder, velZ:number) {
-  builder.addFieldFloat64(8, velZ, 0.0);
+static addVelZQ(builder:flatbuffers.Builder, velZQ:number) {
+  builder.addFieldInt16(8, velZQ, 0);
 }
 
 static addWeaponSlot(builder:flatbuffers.Builder, weaponSlot:number) {
-  builder.addFieldInt32(9, weaponSlot, 0);
+  builder.addFieldInt8(9, weaponSlot, 0);
 }
 
 static addAmmoInMag(builder:flatbuffers.Builder, ammoInMag:number) {
-  builder.addFieldInt32(10, ammoInMag, 0);
+  builder.addFieldInt16(10, ammoInMag, 0);
 }
 
-static addDashCooldown(builder:flatbuffers.Builder, dashCooldown:number) {
-  builder.addFieldFloat64(11, dashCooldown, 0.0);
+static addDashCooldownQ(builder:flatbuffers.Builder, dashCooldownQ:number) {
+  builder.addFieldInt8(11, dashCooldownQ, 0);
 }
 
-static addHealth(builder:flatbuffers.Builder, health:number) {
-  builder.addFieldFloat64(12, health, 0.0);
+static addHealthQ(builder:flatbuffers.Builder, healthQ:number) {
+  builder.addFieldInt16(12, healthQ, 0);
 }
 
 static addKills(builder:flatbuffers.Builder, kills:number) {
-  builder.addFieldInt32(13, kills, 0);
+  builder.addFieldInt16(13, kills, 0);
 }
 
 static addDeaths(builder:flatbuffers.Builder, deaths:number) {
-  builder.addFieldInt32(14, deaths, 0);
+  builder.addFieldInt16(14, deaths, 0);
 }
 
 static addViewYawQ(builder:flatbuffers.Builder, viewYawQ:number) {
@@ -215,21 +215,21 @@ static endStateSnapshot(builder:flatbuffers.Builder):flatbuffers.Offset {
   return offset;
 }
 
-static createStateSnapshot(builder:flatbuffers.Builder, serverTick:number, lastProcessedInputSeq:number, clientIdOffset:flatbuffers.Offset, posX:number, posY:number, posZ:number, velX:number, velY:number, velZ:number, weaponSlot:number, ammoInMag:number, dashCooldown:number, health:number, kills:number, deaths:number, viewYawQ:number, viewPitchQ:number, playerFlags:number, weaponHeatQ:number, loadoutBits:number):flatbuffers.Offset {
+static createStateSnapshot(builder:flatbuffers.Builder, serverTick:number, lastProcessedInputSeq:number, clientIdOffset:flatbuffers.Offset, posXQ:number, posYQ:number, posZQ:number, velXQ:number, velYQ:number, velZQ:number, weaponSlot:number, ammoInMag:number, dashCooldownQ:number, healthQ:number, kills:number, deaths:number, viewYawQ:number, viewPitchQ:number, playerFlags:number, weaponHeatQ:number, loadoutBits:number):flatbuffers.Offset {
   StateSnapshot.startStateSnapshot(builder);
   StateSnapshot.addServerTick(builder, serverTick);
   StateSnapshot.addLastProcessedInputSeq(builder, lastProcessedInputSeq);
   StateSnapshot.addClientId(builder, clientIdOffset);
-  StateSnapshot.addPosX(builder, posX);
-  StateSnapshot.addPosY(builder, posY);
-  StateSnapshot.addPosZ(builder, posZ);
-  StateSnapshot.addVelX(builder, velX);
-  StateSnapshot.addVelY(builder, velY);
-  StateSnapshot.addVelZ(builder, velZ);
+  StateSnapshot.addPosXQ(builder, posXQ);
+  StateSnapshot.addPosYQ(builder, posYQ);
+  StateSnapshot.addPosZQ(builder, posZQ);
+  StateSnapshot.addVelXQ(builder, velXQ);
+  StateSnapshot.addVelYQ(builder, velYQ);
+  StateSnapshot.addVelZQ(builder, velZQ);
   StateSnapshot.addWeaponSlot(builder, weaponSlot);
   StateSnapshot.addAmmoInMag(builder, ammoInMag);
-  StateSnapshot.addDashCooldown(builder, dashCooldown);
-  StateSnapshot.addHealth(builder, health);
+  StateSnapshot.addDashCooldownQ(builder, dashCooldownQ);
+  StateSnapshot.addHealthQ(builder, healthQ);
   StateSnapshot.addKills(builder, kills);
   StateSnapshot.addDeaths(builder, deaths);
   StateSnapshot.addViewYawQ(builder, viewYawQ);
@@ -245,16 +245,16 @@ unpack(): StateSnapshotT {
     this.serverTick(),
     this.lastProcessedInputSeq(),
     this.clientId(),
-    this.posX(),
-    this.posY(),
-    this.posZ(),
-    this.velX(),
-    this.velY(),
-    this.velZ(),
+    this.posXQ(),
+    this.posYQ(),
+    this.posZQ(),
+    this.velXQ(),
+    this.velYQ(),
+    this.velZQ(),
     this.weaponSlot(),
     this.ammoInMag(),
-    this.dashCooldown(),
-    this.health(),
+    this.dashCooldownQ(),
+    this.healthQ(),
     this.kills(),
     this.deaths(),
     this.viewYawQ(),
@@ -270,16 +270,16 @@ unpackTo(_o: StateSnapshotT): void {
   _o.serverTick = this.serverTick();
   _o.lastProcessedInputSeq = this.lastProcessedInputSeq();
   _o.clientId = this.clientId();
-  _o.posX = this.posX();
-  _o.posY = this.posY();
-  _o.posZ = this.posZ();
-  _o.velX = this.velX();
-  _o.velY = this.velY();
-  _o.velZ = this.velZ();
+  _o.posXQ = this.posXQ();
+  _o.posYQ = this.posYQ();
+  _o.posZQ = this.posZQ();
+  _o.velXQ = this.velXQ();
+  _o.velYQ = this.velYQ();
+  _o.velZQ = this.velZQ();
   _o.weaponSlot = this.weaponSlot();
   _o.ammoInMag = this.ammoInMag();
-  _o.dashCooldown = this.dashCooldown();
-  _o.health = this.health();
+  _o.dashCooldownQ = this.dashCooldownQ();
+  _o.healthQ = this.healthQ();
   _o.kills = this.kills();
   _o.deaths = this.deaths();
   _o.viewYawQ = this.viewYawQ();
@@ -295,16 +295,16 @@ constructor(
   public serverTick: number = 0,
   public lastProcessedInputSeq: number = 0,
   public clientId: string|Uint8Array|null = null,
-  public posX: number = 0.0,
-  public posY: number = 0.0,
-  public posZ: number = 0.0,
-  public velX: number = 0.0,
-  public velY: number = 0.0,
-  public velZ: number = 0.0,
+  public posXQ: number = 0,
+  public posYQ: number = 0,
+  public posZQ: number = 0,
+  public velXQ: number = 0,
+  public velYQ: number = 0,
+  public velZQ: number = 0,
   public weaponSlot: number = 0,
   public ammoInMag: number = 0,
-  public dashCooldown: number = 0.0,
-  public health: number = 0.0,
+  public dashCooldownQ: number = 0,
+  public healthQ: number = 0,
   public kills: number = 0,
   public deaths: number = 0,
   public viewYawQ: number = 0,
@@ -322,16 +322,16 @@ pack(builder:flatbuffers.Builder): flatbuffers.Offset {
     this.serverTick,
     this.lastProcessedInputSeq,
     clientId,
-    this.posX,
-    this.posY,
-    this.posZ,
-    this.velX,
-    this.velY,
-    this.velZ,
+    this.posXQ,
+    this.posYQ,
+    this.posZQ,
+    this.velXQ,
+    this.velYQ,
+    this.velZQ,
     this.weaponSlot,
     this.ammoInMag,
-    this.dashCooldown,
-    this.health,
+    this.dashCooldownQ,
+    this.healthQ,
     this.kills,
     this.deaths,
     this.viewYawQ,
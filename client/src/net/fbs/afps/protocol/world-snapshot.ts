@@ -0,0 +1,141 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+import * as flatbuffers from 'flatbuffers';
+
+import { StateSnapshot, StateSnapshotT } from '../../afps/protocol/state-snapshot.js';
+import { StateSnapshotDelta, StateSnapshotDeltaT } from '../../afps/protocol/state-snapshot-delta.js';
+
+
+export class WorldSnapshot implements flatbuffers.IUnpackableObject<WorldSnapshotT> {
+  bb: flatbuffers.ByteBuffer|null = null;
+  bb_pos = 0;
+  __init(i:number, bb:flatbuffers.ByteBuffer):WorldSnapshot {
+  this.bb_pos = i;
+  this.bb = bb;
+  return this;
+}
+
+static getRootAsWorldSnapshot(bb:flatbuffers.ByteBuffer, obj?:WorldSnapshot):WorldSnapshot {
+  return (obj || new WorldSnapshot()).__init(bb.readInt32(bb.position()) + bb.position(), bb);
+}
+
+static getSizePrefixedRootAsWorldSnapshot(bb:flatbuffers.ByteBuffer, obj?:WorldSnapshot):WorldSnapshot {
+  bb.setPosition(bb.position() + flatbuffers.SIZE_PREFIX_LENGTH);
+  return (obj || new WorldSnapshot()).__init(bb.readInt32(bb.position()) + bb.position(), bb);
+}
+
+serverTick():number {
+  const offset = this.bb!.__offset(this.bb_pos, 4);
+  return offset ? this.bb!.readInt32(this.bb_pos + offset) : 0;
+}
+
+snapshots(index: number, obj?:StateSnapshot):StateSnapshot|null {
+  const offset = this.bb!.__offset(this.bb_pos, 6);
+  return offset ? (obj || new StateSnapshot()).__init(this.bb!.__indirect(this.bb!.__vector(this.bb_pos + offset) + index * 4), this.bb!) : null;
+}
+
+snapshotsLength():number {
+  const offset = this.bb!.__offset(this.bb_pos, 6);
+  return offset ? this.bb!.__vector_len(this.bb_pos + offset) : 0;
+}
+
+deltas(index: number, obj?:StateSnapshotDelta):StateSnapshotDelta|null {
+  const offset = this.bb!.__offset(this.bb_pos, 8);
+  return offset ? (obj || new StateSnapshotDelta()).__init(this.bb!.__indirect(this.bb!.__vector(this.bb_pos + offset) + index * 4), this.bb!) : null;
+}
+
+deltasLength():number {
+  const offset = this.bb!.__offset(this.bb_pos, 8);
+  return offset ? this.bb!.__vector_len(this.bb_pos + offset) : 0;
+}
+
+static startWorldSnapshot(builder:flatbuffers.Builder) {
+  builder.startObject(3);
+}
+
+static addServerTick(builder:flatbuffers.Builder, serverTick:number) {
+  builder.addFieldInt32(0, serverTick, 0);
+}
+
+static addSnapshots(builder:flatbuffers.Builder, snapshotsOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(1, snapshotsOffset, 0);
+}
+
+static createSnapshotsVector(builder:flatbuffers.Builder, data:flatbuffers.Offset[]):flatbuffers.Offset {
+  builder.startVector(4, data.length, 4);
+  for (let i = data.length - 1; i >= 0; i--) {
+    builder.addOffset(data[i]!);
+  }
+  return builder.endVector();
+}
+
+static startSnapshotsVector(builder:flatbuffers.Builder, numElems:number) {
+  builder.startVector(4, numElems, 4);
+}
+
+static addDeltas(builder:flatbuffers.Builder, deltasOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(2, deltasOffset, 0);
+}
+
+static createDeltasVector(builder:flatbuffers.Builder, data:flatbuffers.Offset[]):flatbuffers.Offset {
+  builder.startVector(4, data.length, 4);
+  for (let i = data.length - 1; i >= 0; i--) {
+    builder.addOffset(data[i]!);
+  }
+  return builder.endVector();
+}
+
+static startDeltasVector(builder:flatbuffers.Builder, numElems:number) {
+  builder.startVector(4, numElems, 4);
+}
+
+static endWorldSnapshot(builder:flatbuffers.Builder):flatbuffers.Offset {
+  const offset = builder.endObject();
+  return offset;
+}
+
+static createWorldSnapshot(builder:flatbuffers.Builder, serverTick:number, snapshotsOffset:flatbuffers.Offset, deltasOffset:flatbuffers.Offset):flatbuffers.Offset {
+  WorldSnapshot.startWorldSnapshot(builder);
+  WorldSnapshot.addServerTick(builder, serverTick);
+  WorldSnapshot.addSnapshots(builder, snapshotsOffset);
+  WorldSnapshot.addDeltas(builder, deltasOffset);
+  return WorldSnapshot.endWorldSnapshot(builder);
+}
+
+unpack(): WorldSnapshotT {
+  return new WorldSnapshotT(
+    this.serverTick(),
+    this.bb!.createObjList<StateSnapshot, StateSnapshotT>(this.snapshots.bind(this), this.snapshotsLength()),
+    this.bb!.createObjList<StateSnapshotDelta, StateSnapshotDeltaT>(this.deltas.bind(this), this.deltasLength())
+  );
+}
+
+
+unpackTo(_o: WorldSnapshotT): void {
+  _o.serverTick = this.serverTick();
+  _o.snapshots = this.bb!.createObjList<StateSnapshot, StateSnapshotT>(this.snapshots.bind(this), this.snapshotsLength());
+  _o.deltas = this.bb!.createObjList<StateSnapshotDelta, StateSnapshotDeltaT>(this.deltas.bind(this), this.deltasLength());
+}
+}
+
+export class WorldSnapshotT implements flatbuffers.IGeneratedObject {
+constructor(
+  public serverTick: number = 0,
+  public snapshots: (StateSnapshotT)[] = [],
+  public deltas: (StateSnapshotDeltaT)[] = []
+){}
+
+
+pack(builder:flatbuffers.Builder): flatbuffers.Offset {
+  const snapshots = WorldSnapshot.createSnapshotsVector(builder, builder.createObjectOffsetList(this.snapshots));
+  const deltas = WorldSnapshot.createDeltasVector(builder, builder.createObjectOffsetList(this.deltas));
+
+  return WorldSnapshot.createWorldSnapshot(builder,
+    this.serverTick,
+    snapshots,
+    deltas
+  );
+}
+}
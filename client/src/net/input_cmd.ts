@@ -1,35 +1,24 @@
 import type { InputSample } from '../input/sampler';
+import { decodePitchQ, decodeUnitI8, decodeYawQ, encodePitchQ, encodeUnitI8, encodeYawQ } from './quantization';
 
-export interface DecalDebugReport {
-  serverTick: number;
-  shotSeq: number;
-  hitKind: number;
-  surfaceType: number;
-  authoritativeWorldHit: boolean;
-  usedProjectedHit: boolean;
-  usedImpactProjection: boolean;
-  decalSpawned: boolean;
-  decalInFrustum: boolean;
-  decalDistance: number;
-  decalPositionX: number;
-  decalPositionY: number;
-  decalPositionZ: number;
-  decalNormalX: number;
-  decalNormalY: number;
-  decalNormalZ: number;
-  traceHitPositionX: number;
-  traceHitPositionY: number;
-  traceHitPositionZ: number;
-  traceHitNormalX: number;
-  traceHitNormalY: number;
-  traceHitNormalZ: number;
-}
+// Newest frame plus the inputs resent with it, so up to three lost packets in a row cost the server no input.
+export const MAX_INPUT_FRAMES_PER_CMD = 4;
+export const INPUT_BUTTON_JUMP = 1 << 0;
+export const INPUT_BUTTON_FIRE = 1 << 1;
+export const INPUT_BUTTON_ADS = 1 << 2;
+export const INPUT_BUTTON_SPRINT = 1 << 3;
+export const INPUT_BUTTON_DASH = 1 << 4;
+export const INPUT_BUTTON_GRAPPLE = 1 << 5;
+export const INPUT_BUTTON_SHIELD = 1 << 6;
+export const INPUT_BUTTON_SHOCKWAVE = 1 << 7;
+export const INPUT_BUTTON_CROUCH = 1 << 8;
 
 export interface InputCmd {
   type: 'InputCmd';
   inputSeq: number;
   moveX: number;
   moveY: number;
+  // Mouse movement for the local camera only; the server gets the resulting view angles.
   lookDeltaX: number;
   lookDeltaY: number;
   viewYaw: number;
@@ -44,7 +33,6 @@ export interface InputCmd {
   grapple: boolean;
   shield: boolean;
   shockwave: boolean;
-  debugDecalReport?: DecalDebugReport;
 }
 
 const clampAxis = (value: number) => {
@@ -77,3 +65,23 @@ export const buildInputCmd = (inputSeq: number, sample: InputSample): InputCmd =
   shield: Boolean(sample.shield),
   shockwave: Boolean(sample.shockwave)
 });
+
+export const packInputButtons = (cmd: InputCmd) =>
+  (cmd.jump ? INPUT_BUTTON_JUMP : 0) |
+  (cmd.fire ? INPUT_BUTTON_FIRE : 0) |
+  (cmd.ads ? INPUT_BUTTON_ADS : 0) |
+  (cmd.sprint ? INPUT_BUTTON_SPRINT : 0) |
+  (cmd.dash ? INPUT_BUTTON_DASH : 0) |
+  (cmd.grapple ? INPUT_BUTTON_GRAPPLE : 0) |
+  (cmd.shield ? INPUT_BUTTON_SHIELD : 0) |
+  (cmd.shockwave ? INPUT_BUTTON_SHOCKWAVE : 0) |
+  (cmd.crouch ? INPUT_BUTTON_CROUCH : 0);
+
+// Snaps the move axes and view angles to their wire steps so local prediction simulates exactly the
+// values the server decodes.
+export const quantizeInputCmd = (cmd: InputCmd) => {
+  cmd.moveX = decodeUnitI8(encodeUnitI8(cmd.moveX));
+  cmd.moveY = decodeUnitI8(encodeUnitI8(cmd.moveY));
+  cmd.viewYaw = decodeYawQ(encodeYawQ(cmd.viewYaw));
+  cmd.viewPitch = decodePitchQ(encodePitchQ(cmd.viewPitch));
+};
@@ -1,7 +1,7 @@
 import type { Logger, TimerLike, DataChannelLike } from './types';
 import type { InputSampler } from '../input/sampler';
 import type { InputCmd } from './input_cmd';
-import { buildInputCmd } from './input_cmd';
+import { buildInputCmd, MAX_INPUT_FRAMES_PER_CMD } from './input_cmd';
 import { encodeInputCmd } from './protocol';
 
 export interface InputSenderOptions {
@@ -9,6 +9,7 @@ export interface InputSenderOptions {
   sampler: InputSampler;
   nextMessageSeq: () => number;
   getServerSeqAck: () => number;
+  getServerSeqAckBits: () => number;
   tickRate?: number;
   logger?: Logger;
   timers?: TimerLike;
@@ -36,6 +37,7 @@ export const createInputSender = ({
   sampler,
   nextMessageSeq,
   getServerSeqAck,
+  getServerSeqAckBits,
   tickRate,
   logger,
   timers = defaultTimers,
@@ -44,6 +46,8 @@ export const createInputSender = ({
   let sequence = 0;
   let intervalId = 0;
   let running = false;
+  // Newest first; every packet resends the previous frames in case their packets were lost.
+  const history: InputCmd[] = [];
 
   const sendOnce = () => {
     if (channel.readyState !== 'open') {
@@ -55,7 +59,11 @@ export const createInputSender = ({
     sequence += 1;
     const cmd = buildInputCmd(sequence, sampler.sample());
     onSend?.(cmd);
-    channel.send(encodeInputCmd(cmd, nextMessageSeq(), getServerSeqAck()));
+    history.unshift(cmd);
+    if (history.length > MAX_INPUT_FRAMES_PER_CMD) {
+      history.length = MAX_INPUT_FRAMES_PER_CMD;
+    }
+    channel.send(encodeInputCmd(history, nextMessageSeq(), getServerSeqAck(), getServerSeqAckBits()));
     return true;
   };
 
@@ -1,5 +1,6 @@
 import * as flatbuffers from 'flatbuffers';
 import { ClientHello } from './fbs/afps/protocol/client-hello';
+import { DecalDebugReportT } from './fbs/afps/protocol/decal-debug-report';
 import { Error as ProtocolError } from './fbs/afps/protocol/error';
 import { FireWeaponRequestT } from './fbs/afps/protocol/fire-weapon-request';
 import { GameEvent as GameEventFbs } from './fbs/afps/protocol/game-event';
@@ -7,6 +8,7 @@ import { FxEvent as FxEventType, unionListToFxEvent } from './fbs/afps/protocol/
 import { HitConfirmedFx } from './fbs/afps/protocol/hit-confirmed-fx';
 import { HitKind } from './fbs/afps/protocol/hit-kind';
 import { InputCmdT } from './fbs/afps/protocol/input-cmd';
+import { InputFrameT } from './fbs/afps/protocol/input-frame';
 import { KillFeedFx } from './fbs/afps/protocol/kill-feed-fx';
 import { NearMissFx } from './fbs/afps/protocol/near-miss-fx';
 import { OverheatFx } from './fbs/afps/protocol/overheat-fx';
@@ -28,10 +30,13 @@ import { StateSnapshot as StateSnapshotFbs } from './fbs/afps/protocol/state-sna
 import { StateSnapshotDelta as StateSnapshotDeltaFbs } from './fbs/afps/protocol/state-snapshot-delta';
 import { SurfaceType } from './fbs/afps/protocol/surface-type';
 import { VentFx } from './fbs/afps/protocol/vent-fx';
+import { WorldSnapshot as WorldSnapshotFbs } from './fbs/afps/protocol/world-snapshot';
 import { MessageType } from './fbs/afps/protocol/message-type';
 import type { InputCmd } from './input_cmd';
+import { MAX_INPUT_FRAMES_PER_CMD, packInputButtons } from './input_cmd';
+import { encodePitchQ, encodeUnitI8, encodeYawQ } from './quantization';
 
-export const PROTOCOL_VERSION = 7;
+export const PROTOCOL_VERSION = 11;
 export const SNAPSHOT_MASK_POS_X = 1 << 0;
 export const SNAPSHOT_MASK_POS_Y = 1 << 1;
 export const SNAPSHOT_MASK_POS_Z = 1 << 2;
@@ -49,6 +54,12 @@ export const SNAPSHOT_MASK_VIEW_PITCH_Q = 1 << 13;
 export const SNAPSHOT_MASK_PLAYER_FLAGS = 1 << 14;
 export const SNAPSHOT_MASK_WEAPON_HEAT_Q = 1 << 15;
 export const SNAPSHOT_MASK_LOADOUT_BITS = 1 << 16;
+export const SNAPSHOT_BASELINE_HISTORY = 32;
+export const SNAPSHOT_POSITION_STEP_METERS = 1 / 512;
+export const SNAPSHOT_POSITION_RANGE_METERS = 32767 * SNAPSHOT_POSITION_STEP_METERS;
+export const SNAPSHOT_VELOCITY_STEP = 1 / 128;
+export const SNAPSHOT_DASH_COOLDOWN_STEP_SECONDS = 1 / 64;
+export const SNAPSHOT_HEALTH_STEP = 1 / 256;
 const SNAPSHOT_MASK_ALL =
   SNAPSHOT_MASK_POS_X |
   SNAPSHOT_MASK_POS_Y |
@@ -157,6 +168,13 @@ export interface StateSnapshotDelta {
   clientId?: string;
 }
 
+export interface WorldSnapshot {
+  type: 'WorldSnapshot';
+  serverTick: number;
+  snapshots: StateSnapshot[];
+  deltas: StateSnapshotDelta[];
+}
+
 export interface FireWeaponRequestMessage {
   type: 'FireWeaponRequest';
   clientShotSeq: number;
@@ -177,6 +195,31 @@ export interface FireWeaponRequestMessage {
   debugProjectionTelemetryEnabled?: boolean;
 }
 
+export interface DecalDebugReport {
+  serverTick: number;
+  shotSeq: number;
+  hitKind: number;
+  surfaceType: number;
+  authoritativeWorldHit: boolean;
+  usedProjectedHit: boolean;
+  usedImpactProjection: boolean;
+  decalSpawned: boolean;
+  decalInFrustum: boolean;
+  decalDistance: number;
+  decalPositionX: number;
+  decalPositionY: number;
+  decalPositionZ: number;
+  decalNormalX: number;
+  decalNormalY: number;
+  decalNormalZ: number;
+  traceHitPositionX: number;
+  traceHitPositionY: number;
+  traceHitPositionZ: number;
+  traceHitNormalX: number;
+  traceHitNormalY: number;
+  traceHitNormalZ: number;
+}
+
 export interface PingMessage {
   type: 'Ping';
   clientTimeMs: number;
@@ -319,7 +362,7 @@ const toUint8Array = (data: ArrayBuffer | Uint8Array) =>
   data instanceof Uint8Array ? data : new Uint8Array(data);
 
 const isMessageType = (value: number): value is MessageType =>
-  value >= MessageType.ClientHello && value <= MessageType.SetLoadoutRequest;
+  value >= MessageType.ClientHello && value <= MessageType.DecalDebugReport;
 
 export const decodeEnvelope = (data: ArrayBuffer | Uint8Array): DecodedEnvelope | null => {
   const bytes = toUint8Array(data);
@@ -355,6 +398,28 @@ export const decodeEnvelope = (data: ArrayBuffer | Uint8Array): DecodedEnvelope
   };
 };
 
+// The server bundles a tick's messages for one channel into a single DataChannel message by
+// writing the envelopes back to back; payloadBytes in each header marks where the next one starts.
+export const decodeEnvelopes = (data: ArrayBuffer | Uint8Array): DecodedEnvelope[] => {
+  const bytes = toUint8Array(data);
+  const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+  const envelopes: DecodedEnvelope[] = [];
+  let offset = 0;
+  while (offset + HEADER_BYTES <= bytes.byteLength) {
+    const end = offset + HEADER_BYTES + view.getUint32(offset + 8, true);
+    if (end > bytes.byteLength) {
+      break;
+    }
+    const envelope = decodeEnvelope(bytes.subarray(offset, end));
+    if (!envelope) {
+      break;
+    }
+    envelopes.push(envelope);
+    offset = end;
+  }
+  return envelopes;
+};
+
 export const encodeEnvelope = (
   msgType: MessageType,
   payload: Uint8Array,
@@ -404,53 +469,61 @@ export const buildClientHello = (
   return encodeEnvelope(MessageType.ClientHello, builder.asUint8Array(), msgSeq, serverSeqAck);
 };
 
-export const encodeInputCmd = (cmd: InputCmd, msgSeq = 1, serverSeqAck = 0) => {
-  const report = cmd.debugDecalReport;
+// cmds are newest first; the older ones ride along as redundancy for lost packets.
+export const encodeInputCmd = (
+  cmds: readonly InputCmd[],
+  msgSeq = 1,
+  serverSeqAck = 0,
+  serverSeqAckBits = 0
+) => {
+  const builder = new flatbuffers.Builder(128);
+  const frames = cmds
+    .slice(0, MAX_INPUT_FRAMES_PER_CMD)
+    .map(
+      (cmd) =>
+        new InputFrameT(
+          cmd.inputSeq,
+          encodeUnitI8(cmd.moveX),
+          encodeUnitI8(cmd.moveY),
+          packInputButtons(cmd),
+          encodeYawQ(cmd.viewYaw),
+          encodePitchQ(cmd.viewPitch),
+          Math.min(cmd.weaponSlot, 0xff)
+        )
+    );
+  const payload = new InputCmdT(frames, serverSeqAckBits).pack(builder);
+  builder.finish(payload);
+  return encodeEnvelope(MessageType.InputCmd, builder.asUint8Array(), msgSeq, serverSeqAck);
+};
+
+export const encodeDecalDebugReport = (report: DecalDebugReport, msgSeq = 1, serverSeqAck = 0) => {
   const builder = new flatbuffers.Builder(256);
-  const payload = new InputCmdT(
-    cmd.inputSeq,
-    cmd.moveX,
-    cmd.moveY,
-    cmd.lookDeltaX,
-    cmd.lookDeltaY,
-    cmd.viewYaw,
-    cmd.viewPitch,
-    cmd.weaponSlot,
-    cmd.jump,
-    cmd.fire,
-    cmd.ads,
-    cmd.sprint,
-    cmd.dash,
-    cmd.grapple,
-    cmd.shield,
-    cmd.shockwave,
-    cmd.crouch,
-    report !== undefined,
-    report?.serverTick ?? 0,
-    report?.shotSeq ?? 0,
-    report?.hitKind ?? 0,
-    report?.surfaceType ?? 0,
-    report?.authoritativeWorldHit ?? false,
-    report?.usedProjectedHit ?? false,
-    report?.usedImpactProjection ?? false,
-    report?.decalSpawned ?? false,
-    report?.decalInFrustum ?? false,
-    report?.decalDistance ?? -1,
-    report?.decalPositionX ?? 0,
-    report?.decalPositionY ?? 0,
-    report?.decalPositionZ ?? 0,
-    report?.decalNormalX ?? 0,
-    report?.decalNormalY ?? 0,
-    report?.decalNormalZ ?? 0,
-    report?.traceHitPositionX ?? 0,
-    report?.traceHitPositionY ?? 0,
-    report?.traceHitPositionZ ?? 0,
-    report?.traceHitNormalX ?? 0,
-    report?.traceHitNormalY ?? 0,
-    report?.traceHitNormalZ ?? 0
+  const payload = new DecalDebugReportT(
+    report.serverTick,
+    report.shotSeq,
+    report.hitKind,
+    report.surfaceType,
+    report.authoritativeWorldHit,
+    report.usedProjectedHit,
+    report.usedImpactProjection,
+    report.decalSpawned,
+    report.decalInFrustum,
+    report.decalDistance,
+    report.decalPositionX,
+    report.decalPositionY,
+    report.decalPositionZ,
+    report.decalNormalX,
+    report.decalNormalY,
+    report.decalNormalZ,
+    report.traceHitPositionX,
+    report.traceHitPositionY,
+    report.traceHitPositionZ,
+    report.traceHitNormalX,
+    report.traceHitNormalY,
+    report.traceHitNormalZ
   ).pack(builder);
   builder.finish(payload);
-  return encodeEnvelope(MessageType.InputCmd, builder.asUint8Array(), msgSeq, serverSeqAck);
+  return encodeEnvelope(MessageType.DecalDebugReport, builder.asUint8Array(), msgSeq, serverSeqAck);
 };
 
 export const encodeSetLoadoutRequest = (loadoutBits: number, msgSeq = 1, serverSeqAck = 0) => {
@@ -551,40 +624,27 @@ export const parsePongPayload = (payload: Uint8Array): PongMessage | null => {
   return { type: 'Pong', clientTimeMs };
 };
 
-export const parseStateSnapshotPayload = (payload: Uint8Array): StateSnapshot | null => {
-  const bb = new flatbuffers.ByteBuffer(payload);
-  const message = StateSnapshotFbs.getRootAsStateSnapshot(bb);
-  const serverTick = message.serverTick();
+// World snapshot entries omit server_tick when it matches the enclosing world tick.
+const readStateSnapshot = (message: StateSnapshotFbs, worldTick = 0): StateSnapshot | null => {
+  const serverTick = message.serverTick() || worldTick;
   const lastProcessedInputSeq = message.lastProcessedInputSeq();
   if (serverTick < 0 || lastProcessedInputSeq < -1) {
     return null;
   }
-  const posX = message.posX();
-  const posY = message.posY();
-  const posZ = message.posZ();
-  const velX = message.velX();
-  const velY = message.velY();
-  const velZ = message.velZ();
-  const dashCooldown = message.dashCooldown();
-  const health = message.health();
-  const ammoInMag = message.ammoInMag();
-  if (![posX, posY, posZ, velX, velY, velZ, dashCooldown, health].every(isFiniteNumber)) {
-    return null;
-  }
   const snapshot: StateSnapshot = {
     type: 'StateSnapshot',
     serverTick,
     lastProcessedInputSeq,
-    posX,
-    posY,
-    posZ,
-    velX,
-    velY,
-    velZ,
+    posX: message.posXQ() * SNAPSHOT_POSITION_STEP_METERS,
+    posY: message.posYQ() * SNAPSHOT_POSITION_STEP_METERS,
+    posZ: message.posZQ() * SNAPSHOT_POSITION_STEP_METERS,
+    velX: message.velXQ() * SNAPSHOT_VELOCITY_STEP,
+    velY: message.velYQ() * SNAPSHOT_VELOCITY_STEP,
+    velZ: message.velZQ() * SNAPSHOT_VELOCITY_STEP,
     weaponSlot: message.weaponSlot(),
-    ammoInMag,
-    dashCooldown,
-    health,
+    ammoInMag: message.ammoInMag(),
+    dashCooldown: message.dashCooldownQ() * SNAPSHOT_DASH_COOLDOWN_STEP_SECONDS,
+    health: message.healthQ() * SNAPSHOT_HEALTH_STEP,
     kills: message.kills(),
     deaths: message.deaths(),
     viewYawQ: message.viewYawQ(),
@@ -600,10 +660,8 @@ export const parseStateSnapshotPayload = (payload: Uint8Array): StateSnapshot |
   return snapshot;
 };
 
-export const parseStateSnapshotDeltaPayload = (payload: Uint8Array): StateSnapshotDelta | null => {
-  const bb = new flatbuffers.ByteBuffer(payload);
-  const message = StateSnapshotDeltaFbs.getRootAsStateSnapshotDelta(bb);
-  const serverTick = message.serverTick();
+const readStateSnapshotDelta = (message: StateSnapshotDeltaFbs, worldTick = 0): StateSnapshotDelta | null => {
+  const serverTick = message.serverTick() || worldTick;
   const baseTick = message.baseTick();
   const lastProcessedInputSeq = message.lastProcessedInputSeq();
   const mask = message.mask();
@@ -624,16 +682,18 @@ export const parseStateSnapshotDeltaPayload = (payload: Uint8Array): StateSnapsh
   if (clientId && clientId.length > 0) {
     snapshot.clientId = clientId;
   }
-  if (mask & SNAPSHOT_MASK_POS_X) snapshot.posX = message.posX();
-  if (mask & SNAPSHOT_MASK_POS_Y) snapshot.posY = message.posY();
-  if (mask & SNAPSHOT_MASK_POS_Z) snapshot.posZ = message.posZ();
-  if (mask & SNAPSHOT_MASK_VEL_X) snapshot.velX = message.velX();
-  if (mask & SNAPSHOT_MASK_VEL_Y) snapshot.velY = message.velY();
-  if (mask & SNAPSHOT_MASK_VEL_Z) snapshot.velZ = message.velZ();
+  if (mask & SNAPSHOT_MASK_POS_X) snapshot.posX = message.posXQ() * SNAPSHOT_POSITION_STEP_METERS;
+  if (mask & SNAPSHOT_MASK_POS_Y) snapshot.posY = message.posYQ() * SNAPSHOT_POSITION_STEP_METERS;
+  if (mask & SNAPSHOT_MASK_POS_Z) snapshot.posZ = message.posZQ() * SNAPSHOT_POSITION_STEP_METERS;
+  if (mask & SNAPSHOT_MASK_VEL_X) snapshot.velX = message.velXQ() * SNAPSHOT_VELOCITY_STEP;
+  if (mask & SNAPSHOT_MASK_VEL_Y) snapshot.velY = message.velYQ() * SNAPSHOT_VELOCITY_STEP;
+  if (mask & SNAPSHOT_MASK_VEL_Z) snapshot.velZ = message.velZQ() * SNAPSHOT_VELOCITY_STEP;
   if (mask & SNAPSHOT_MASK_WEAPON_SLOT) snapshot.weaponSlot = message.weaponSlot();
   if (mask & SNAPSHOT_MASK_AMMO_IN_MAG) snapshot.ammoInMag = message.ammoInMag();
-  if (mask & SNAPSHOT_MASK_DASH_COOLDOWN) snapshot.dashCooldown = message.dashCooldown();
-  if (mask & SNAPSHOT_MASK_HEALTH) snapshot.health = message.health();
+  if (mask & SNAPSHOT_MASK_DASH_COOLDOWN) {
+    snapshot.dashCooldown = message.dashCooldownQ() * SNAPSHOT_DASH_COOLDOWN_STEP_SECONDS;
+  }
+  if (mask & SNAPSHOT_MASK_HEALTH) snapshot.health = message.healthQ() * SNAPSHOT_HEALTH_STEP;
   if (mask & SNAPSHOT_MASK_KILLS) snapshot.kills = message.kills();
   if (mask & SNAPSHOT_MASK_DEATHS) snapshot.deaths = message.deaths();
   if (mask & SNAPSHOT_MASK_VIEW_YAW_Q) snapshot.viewYawQ = message.viewYawQ();
@@ -641,27 +701,45 @@ export const parseStateSnapshotDeltaPayload = (payload: Uint8Array): StateSnapsh
   if (mask & SNAPSHOT_MASK_PLAYER_FLAGS) snapshot.playerFlags = message.playerFlags();
   if (mask & SNAPSHOT_MASK_WEAPON_HEAT_Q) snapshot.weaponHeatQ = message.weaponHeatQ();
   if (mask & SNAPSHOT_MASK_LOADOUT_BITS) snapshot.loadoutBits = message.loadoutBits();
+  return snapshot;
+};
 
-  const numericValues = [
-    snapshot.posX,
-    snapshot.posY,
-    snapshot.posZ,
-    snapshot.velX,
-    snapshot.velY,
-    snapshot.velZ,
-    snapshot.ammoInMag,
-    snapshot.dashCooldown,
-    snapshot.health,
-    snapshot.viewYawQ,
-    snapshot.viewPitchQ,
-    snapshot.playerFlags,
-    snapshot.weaponHeatQ,
-    snapshot.loadoutBits
-  ].filter((value) => typeof value === 'number') as number[];
-  if (!numericValues.every(isFiniteNumber)) {
+export const parseStateSnapshotPayload = (payload: Uint8Array): StateSnapshot | null => {
+  const bb = new flatbuffers.ByteBuffer(payload);
+  return readStateSnapshot(StateSnapshotFbs.getRootAsStateSnapshot(bb));
+};
+
+export const parseStateSnapshotDeltaPayload = (payload: Uint8Array): StateSnapshotDelta | null => {
+  const bb = new flatbuffers.ByteBuffer(payload);
+  return readStateSnapshotDelta(StateSnapshotDeltaFbs.getRootAsStateSnapshotDelta(bb));
+};
+
+export const parseWorldSnapshotPayload = (payload: Uint8Array): WorldSnapshot | null => {
+  const bb = new flatbuffers.ByteBuffer(payload);
+  const message = WorldSnapshotFbs.getRootAsWorldSnapshot(bb);
+  const serverTick = message.serverTick();
+  if (serverTick < 0) {
     return null;
   }
-  return snapshot;
+  const snapshots: StateSnapshot[] = [];
+  for (let i = 0; i < message.snapshotsLength(); i += 1) {
+    const entry = message.snapshots(i);
+    const snapshot = entry ? readStateSnapshot(entry, serverTick) : null;
+    if (!snapshot) {
+      return null;
+    }
+    snapshots.push(snapshot);
+  }
+  const deltas: StateSnapshotDelta[] = [];
+  for (let i = 0; i < message.deltasLength(); i += 1) {
+    const entry = message.deltas(i);
+    const delta = entry ? readStateSnapshotDelta(entry, serverTick) : null;
+    if (!delta) {
+      return null;
+    }
+    deltas.push(delta);
+  }
+  return { type: 'WorldSnapshot', serverTick, snapshots, deltas };
 };
 
 export const parseGameEventPayload = (payload: Uint8Array): GameEventBatch | null => {
@@ -948,6 +1026,14 @@ export const parseSnapshotMessage = (data: ArrayBuffer | Uint8Array): SnapshotMe
   return null;
 };
 
+export const parseWorldSnapshot = (data: ArrayBuffer | Uint8Array): WorldSnapshot | null => {
+  const envelope = decodeEnvelope(data);
+  if (!envelope || envelope.header.msgType !== MessageType.WorldSnapshot) {
+    return null;
+  }
+  return parseWorldSnapshotPayload(envelope.payload);
+};
+
 export const parseGameEvent = (data: ArrayBuffer | Uint8Array): GameEventBatch | null => {
   const envelope = decodeEnvelope(data);
   if (!envelope || envelope.header.msgType !== MessageType.GameEvent) {
@@ -5,6 +5,7 @@ export interface Vec3 {
 }
 
 const INT16_MAX = 32767;
+const INT8_MAX = 127;
 const MAX_PITCH_RAD = Math.PI / 2 - 0.01;
 
 const clamp = (value: number, min: number, max: number) => Math.max(min, Math.min(max, value));
@@ -59,6 +60,43 @@ export const decodePitchQ = (value: number) => {
   return (clamped / INT16_MAX) * MAX_PITCH_RAD;
 };
 
+// Rounds half away from zero like the server's llround, and never returns -0.
+const roundToWire = (value: number) => {
+  const magnitude = Math.round(Math.abs(value));
+  return value < 0 && magnitude !== 0 ? -magnitude : magnitude;
+};
+
+export const encodeYawQ = (yaw: number) => {
+  if (!Number.isFinite(yaw)) {
+    return 0;
+  }
+  const wrapped = (yaw + Math.PI) % (2 * Math.PI);
+  const normalized = (wrapped < 0 ? wrapped + 2 * Math.PI : wrapped) - Math.PI;
+  return roundToWire(clamp(normalized / Math.PI, -1, 1) * INT16_MAX);
+};
+
+export const encodePitchQ = (pitch: number) => {
+  if (!Number.isFinite(pitch)) {
+    return 0;
+  }
+  const clamped = clamp(pitch, -MAX_PITCH_RAD, MAX_PITCH_RAD);
+  return roundToWire(clamp(clamped / MAX_PITCH_RAD, -1, 1) * INT16_MAX);
+};
+
+export const encodeUnitI8 = (value: number) => {
+  if (!Number.isFinite(value)) {
+    return 0;
+  }
+  return roundToWire(clamp(value, -1, 1) * INT8_MAX);
+};
+
+export const decodeUnitI8 = (value: number) => {
+  if (!Number.isFinite(value)) {
+    return 0;
+  }
+  return clamp(Math.floor(value), -INT8_MAX, INT8_MAX) / INT8_MAX;
+};
+
 export const decodeOct16 = (octX: number, octY: number): Vec3 => {
   if (!Number.isFinite(octX) || !Number.isFinite(octY)) {
     return { x: 0, y: 0, z: 1 };
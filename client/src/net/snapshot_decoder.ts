@@ -16,43 +16,43 @@ import {
   SNAPSHOT_MASK_PLAYER_FLAGS,
   SNAPSHOT_MASK_WEAPON_HEAT_Q,
   SNAPSHOT_MASK_LOADOUT_BITS,
+  SNAPSHOT_BASELINE_HISTORY,
   type SnapshotMessage,
   type StateSnapshot,
   type StateSnapshotDelta
 } from './protocol';
 
+// The server diffs against the newest snapshot we acked, which may be older than the newest one we
+// received, so keep a short per-client history of reconstructed snapshots to resolve base ticks.
 export class SnapshotDecoder {
-  private baseByClient: Map<string, StateSnapshot> = new Map();
+  private historyByClient: Map<string, StateSnapshot[]> = new Map();
   private readonly defaultKey = '__default__';
 
   reset() {
-    this.baseByClient.clear();
+    this.historyByClient.clear();
   }
 
   apply(message: StateSnapshot): StateSnapshot;
   apply(message: StateSnapshotDelta): StateSnapshot | null;
   apply(message: SnapshotMessage): StateSnapshot | null {
     if (message.type === 'StateSnapshot') {
-      const key = message.clientId ?? this.defaultKey;
-      this.baseByClient.set(key, message);
+      this.remember(message.clientId ?? this.defaultKey, message);
       return message;
     }
     let key = message.clientId ?? this.defaultKey;
-    let base = this.baseByClient.get(key);
-    if (!base && !message.clientId && this.baseByClient.size === 1) {
-      const [onlyKey, onlyBase] = this.baseByClient.entries().next().value as [string, StateSnapshot];
+    let history = this.historyByClient.get(key);
+    if (!history && !message.clientId && this.historyByClient.size === 1) {
+      const [onlyKey, onlyHistory] = this.historyByClient.entries().next().value as [string, StateSnapshot[]];
       key = onlyKey;
-      base = onlyBase;
+      history = onlyHistory;
     }
+    const base = history?.find((entry) => entry.serverTick === message.baseTick);
     if (!base) {
       return null;
     }
-    if (message.baseTick !== base.serverTick) {
-      return null;
-    }
 
     const mask = message.mask;
-    return {
+    const snapshot: StateSnapshot = {
       type: 'StateSnapshot',
       serverTick: message.serverTick,
       lastProcessedInputSeq: message.lastProcessedInputSeq,
@@ -82,5 +82,23 @@ export class SnapshotDecoder {
         mask & SNAPSHOT_MASK_LOADOUT_BITS ? (message.loadoutBits ?? base.loadoutBits) : base.loadoutBits,
       clientId: message.clientId ?? base.clientId
     };
+    this.remember(key, snapshot);
+    return snapshot;
+  }
+
+  private remember(key: string, snapshot: StateSnapshot) {
+    let history = this.historyByClient.get(key);
+    if (!history) {
+      history = [];
+      this.historyByClient.set(key, history);
+    }
+    const existing = history.findIndex((entry) => entry.serverTick === snapshot.serverTick);
+    if (existing >= 0) {
+      history.splice(existing, 1);
+    }
+    history.push(snapshot);
+    if (history.length > SNAPSHOT_BASELINE_HISTORY) {
+      history.shift();
+    }
   }
 }
@@ -91,5 +91,7 @@ export interface WebRtcSession {
   unreliableChannel: DataChannelLike;
   nextClientMessageSeq: () => number;
   getServerSeqAck: () => number;
+  // Which of the 32 server messages before getServerSeqAck() arrived; sent with each InputCmd.
+  getServerSeqAckBits: () => number;
   close: () => void;
 }
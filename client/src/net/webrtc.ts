@@ -1,14 +1,16 @@
 import {
   buildClientHello as buildClientHelloMessage,
-  decodeEnvelope,
+  decodeEnvelopes,
   parseGameEventPayload,
   parsePlayerProfilePayload,
   parsePongPayload,
   parseServerHelloPayload,
   parseStateSnapshotDeltaPayload,
   parseStateSnapshotPayload,
+  parseWorldSnapshotPayload,
   MessageType,
   PROTOCOL_VERSION,
+  type DecodedEnvelope,
   type GameEventBatch,
   type PlayerProfile,
   type PongMessage,
@@ -183,25 +185,28 @@ export const createWebRtcConnector = ({
     const snapshotDecoder = new SnapshotDecoder();
     let clientMsgSeq = 0;
     let serverSeqAck = 0;
+    // Bit i: server message serverSeqAck - 1 - i arrived too. FX and pong messages share the seq
+    // space with snapshot packets, so the newest seq alone does not say which packets arrived.
+    let serverSeqAckBits = 0;
     const nextClientSeq = () => {
       clientMsgSeq += 1;
       return clientMsgSeq;
     };
     const noteServerSeq = (seq: number) => {
       if (seq > serverSeqAck) {
+        const shift = seq - serverSeqAck;
+        const kept = shift < 32 ? serverSeqAckBits << shift : 0;
+        const previous = serverSeqAck > 0 && shift <= 32 ? 1 << (shift - 1) : 0;
+        serverSeqAckBits = (kept | previous) >>> 0;
         serverSeqAck = seq;
+      } else if (seq < serverSeqAck && serverSeqAck - seq <= 32) {
+        serverSeqAckBits = (serverSeqAckBits | (1 << (serverSeqAck - seq - 1))) >>> 0;
       }
     };
     const getServerSeqAck = () => serverSeqAck;
+    const getServerSeqAckBits = () => serverSeqAckBits;
 
-    const handleMessage = (message: { data: string | ArrayBuffer | Uint8Array }) => {
-      if (typeof message.data === 'string') {
-        return;
-      }
-      const envelope = decodeEnvelope(message.data);
-      if (!envelope) {
-        return;
-      }
+    const handleReliableEnvelope = (envelope: DecodedEnvelope) => {
       noteServerSeq(envelope.header.msgSeq);
       if (envelope.header.msgType === MessageType.ServerHello) {
         const serverHello = parseServerHelloPayload(envelope.payload);
@@ -226,14 +231,7 @@ export const createWebRtcConnector = ({
       }
     };
 
-    const handleSnapshot = (message: { data: string | ArrayBuffer | Uint8Array }) => {
-      if (typeof message.data === 'string') {
-        return;
-      }
-      const envelope = decodeEnvelope(message.data);
-      if (!envelope) {
-        return;
-      }
+    const handleUnreliableEnvelope = (envelope: DecodedEnvelope) => {
       noteServerSeq(envelope.header.msgSeq);
       if (envelope.header.msgType === MessageType.StateSnapshot) {
         const snapshotMessage = parseStateSnapshotPayload(envelope.payload);
@@ -253,6 +251,21 @@ export const createWebRtcConnector = ({
         }
         return;
       }
+      if (envelope.header.msgType === MessageType.WorldSnapshot) {
+        const worldSnapshot = parseWorldSnapshotPayload(envelope.payload);
+        if (worldSnapshot) {
+          for (const snapshotMessage of worldSnapshot.snapshots) {
+            onSnapshot?.(snapshotDecoder.apply(snapshotMessage));
+          }
+          for (const snapshotMessage of worldSnapshot.deltas) {
+            const snapshot = snapshotDecoder.apply(snapshotMessage);
+            if (snapshot) {
+              onSnapshot?.(snapshot);
+            }
+          }
+        }
+        return;
+      }
       if (envelope.header.msgType === MessageType.GameEvent) {
         const gameEvent = parseGameEventPayload(envelope.payload);
         if (gameEvent) {
@@ -268,6 +281,24 @@ export const createWebRtcConnector = ({
       }
     };
 
+    const handleMessage = (message: { data: string | ArrayBuffer | Uint8Array }) => {
+      if (typeof message.data === 'string') {
+        return;
+      }
+      for (const envelope of decodeEnvelopes(message.data)) {
+        handleReliableEnvelope(envelope);
+      }
+    };
+
+    const handleSnapshot = (message: { data: string | ArrayBuffer | Uint8Array }) => {
+      if (typeof message.data === 'string') {
+        return;
+      }
+      for (const envelope of decodeEnvelopes(message.data)) {
+        handleUnreliableEnvelope(envelope);
+      }
+    };
+
     let stopPolling: (() => void) | null = null;
     stopPolling = startCandidatePolling(timers, pollIntervalMs, async () => {
       try {
@@ -395,6 +426,7 @@ export const createWebRtcConnector = ({
         unreliableChannel: unreliable,
         nextClientMessageSeq: nextClientSeq,
         getServerSeqAck,
+        getServerSeqAckBits,
         close
       };
     } catch (error) {
@@ -562,7 +562,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'connecting', send: sendPing },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -583,7 +584,8 @@ describe('main entry', () => {
       reliableChannel: { label: 'afps_reliable', readyState: 'open', send: sendReliable },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: sendUnreliable },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -697,7 +699,8 @@ describe('main entry', () => {
         serverHello: { serverTickRate: 60, snapshotRate: 20, snapshotKeyframeInterval: 5 },
         unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: sendPing },
         nextClientMessageSeq: () => 1,
-        getServerSeqAck: () => 0
+        getServerSeqAck: () => 0,
+        getServerSeqAckBits: () => 0
       };
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
@@ -813,6 +816,7 @@ describe('main entry', () => {
           unreliableChannel: unreliable1,
           nextClientMessageSeq: () => 1,
           getServerSeqAck: () => 0,
+          getServerSeqAckBits: () => 0,
           close: closeSession1
         })
         .mockResolvedValueOnce({
@@ -822,6 +826,7 @@ describe('main entry', () => {
           unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
           nextClientMessageSeq: () => 1,
           getServerSeqAck: () => 0,
+          getServerSeqAckBits: () => 0,
           close: vi.fn()
         });
       envMock.getSignalingUrl.mockReturnValue('https://example.test');
@@ -902,7 +907,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: sendUnreliable },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -949,7 +955,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: sendUnreliable },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1010,7 +1017,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1061,7 +1069,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1155,7 +1164,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1201,7 +1211,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1251,7 +1262,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1325,7 +1337,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1374,7 +1387,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1456,7 +1470,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1529,7 +1544,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1625,7 +1641,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1685,7 +1702,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1772,7 +1790,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1829,7 +1848,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1886,7 +1906,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1929,7 +1950,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20, snapshotKeyframeInterval: 7 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -2079,7 +2101,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -2131,7 +2154,8 @@ describe('main entry', () => {
       serverHello: { serverTickRate: 60, snapshotRate: 20 },
       unreliableChannel: { label: 'afps_unreliable', readyState: 'open', send: vi.fn() },
       nextClientMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     envMock.getSignalingUrl.mockReturnValue('https://example.test');
     envMock.getSignalingAuthToken.mockReturnValue('token');
@@ -1,5 +1,12 @@
 import { describe, expect, it } from 'vitest';
-import { buildInputCmd } from '../../src/net/input_cmd';
+import {
+  buildInputCmd,
+  INPUT_BUTTON_CROUCH,
+  INPUT_BUTTON_FIRE,
+  INPUT_BUTTON_JUMP,
+  packInputButtons,
+  quantizeInputCmd
+} from '../../src/net/input_cmd';
 import type { InputSample } from '../../src/input/sampler';
 
 describe('input cmd', () => {
@@ -87,4 +94,37 @@ describe('input cmd', () => {
 
     expect(cmd.weaponSlot).toBe(0);
   });
+
+  it('packs buttons and snaps axes and angles to wire steps', () => {
+    const cmd = buildInputCmd(3, {
+      moveX: 0.5,
+      moveY: -0.3,
+      lookDeltaX: 0,
+      lookDeltaY: 0,
+      jump: true,
+      fire: true,
+      ads: false,
+      sprint: false,
+      crouch: true,
+      dash: false,
+      grapple: false,
+      shield: false,
+      shockwave: false,
+      weaponSlot: 0
+    });
+    cmd.viewYaw = 7;
+    cmd.viewPitch = 2;
+
+    expect(packInputButtons(cmd)).toBe(INPUT_BUTTON_JUMP | INPUT_BUTTON_FIRE | INPUT_BUTTON_CROUCH);
+
+    quantizeInputCmd(cmd);
+    expect(cmd.moveX).toBe(64 / 127);
+    expect(cmd.moveY).toBe(-38 / 127);
+    expect(cmd.viewYaw).toBeCloseTo(7 - 2 * Math.PI, 3);
+    expect(cmd.viewPitch).toBeCloseTo(Math.PI / 2 - 0.01);
+
+    const snapped = { ...cmd };
+    quantizeInputCmd(cmd);
+    expect(cmd).toEqual(snapped);
+  });
 });
@@ -3,6 +3,7 @@ import * as flatbuffers from 'flatbuffers';
 import { __test, createInputSender } from '../../src/net/input_sender';
 import { decodeEnvelope, MessageType } from '../../src/net/protocol';
 import { InputCmd } from '../../src/net/fbs/afps/protocol/input-cmd';
+import { INPUT_BUTTON_JUMP, MAX_INPUT_FRAMES_PER_CMD } from '../../src/net/input_cmd';
 import { FakeDataChannel } from './fakes';
 import type { InputSampler } from '../../src/input/sampler';
 
@@ -43,7 +44,8 @@ describe('input sender', () => {
         msgSeq += 1;
         return msgSeq;
       },
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     expect(sender.sendOnce()).toBe(true);
     expect(sender.sendOnce()).toBe(true);
@@ -55,13 +57,62 @@ describe('input sender', () => {
     const first = InputCmd.getRootAsInputCmd(new flatbuffers.ByteBuffer(firstEnvelope!.payload));
     const second = InputCmd.getRootAsInputCmd(new flatbuffers.ByteBuffer(secondEnvelope!.payload));
 
-    expect(first.inputSeq()).toBe(1);
-    expect(second.inputSeq()).toBe(2);
-    expect(first.moveX()).toBe(1);
+    expect(first.framesLength()).toBe(1);
+    expect(first.frames(0)?.inputSeq()).toBe(1);
+    expect(second.frames(0)?.inputSeq()).toBe(2);
+    expect(first.frames(0)?.moveXQ()).toBe(127);
     expect(onSend).toHaveBeenCalledTimes(2);
     expect(onSend).toHaveBeenCalledWith(expect.objectContaining({ inputSeq: 1 }));
   });
 
+  it('resends the previous frames newest first', () => {
+    const channel = new FakeDataChannel('afps_unreliable');
+    channel.readyState = 'open';
+    const sampler = createSampler({ jump: true });
+
+    const sender = createInputSender({
+      channel,
+      sampler,
+      nextMessageSeq: () => 1,
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
+    });
+    for (let i = 0; i < 6; i += 1) {
+      expect(sender.sendOnce()).toBe(true);
+    }
+
+    const second = decodeEnvelope(channel.sent[1] as Uint8Array);
+    const secondCmd = InputCmd.getRootAsInputCmd(new flatbuffers.ByteBuffer(second!.payload));
+    expect(secondCmd.framesLength()).toBe(2);
+    expect(secondCmd.frames(1)?.inputSeq()).toBe(1);
+
+    const last = decodeEnvelope(channel.sent[5] as Uint8Array);
+    const lastCmd = InputCmd.getRootAsInputCmd(new flatbuffers.ByteBuffer(last!.payload));
+    expect(lastCmd.framesLength()).toBe(MAX_INPUT_FRAMES_PER_CMD);
+    const seqs = Array.from({ length: lastCmd.framesLength() }, (_, index) => lastCmd.frames(index)?.inputSeq());
+    expect(seqs).toEqual([6, 5, 4, 3]);
+    expect(lastCmd.frames(0)?.buttons()).toBe(INPUT_BUTTON_JUMP);
+  });
+
+  it('sends the server seq ack and its ack bits', () => {
+    const channel = new FakeDataChannel('afps_unreliable');
+    channel.readyState = 'open';
+
+    const sender = createInputSender({
+      channel,
+      sampler: createSampler(),
+      nextMessageSeq: () => 1,
+      getServerSeqAck: () => 40,
+      getServerSeqAckBits: () => 0x80000005
+    });
+    expect(sender.sendOnce()).toBe(true);
+
+    const envelope = decodeEnvelope(channel.sent[0] as Uint8Array);
+    expect(envelope?.header.serverSeqAck).toBe(40);
+    const cmd = InputCmd.getRootAsInputCmd(new flatbuffers.ByteBuffer(envelope!.payload));
+    expect(cmd.serverSeqAckBits()).toBe(0x80000005);
+  });
+
   it('warns when channel is not open', () => {
     const channel = new FakeDataChannel('afps_unreliable');
     channel.readyState = 'connecting';
@@ -74,6 +125,7 @@ describe('input sender', () => {
       sampler,
       nextMessageSeq: () => 1,
       getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0,
       logger: { info: () => {}, warn, error: () => {} },
       onSend
     });
@@ -91,7 +143,8 @@ describe('input sender', () => {
       channel,
       sampler,
       nextMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
 
     expect(sender.sendOnce()).toBe(false);
@@ -127,7 +180,8 @@ describe('input sender', () => {
       tickRate: 0,
       timers,
       nextMessageSeq: () => 1,
-      getServerSeqAck: () => 0
+      getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0
     });
     sender.start();
     sender.start();
@@ -152,6 +206,7 @@ describe('input sender', () => {
       sampler,
       nextMessageSeq: () => 1,
       getServerSeqAck: () => 0,
+      getServerSeqAckBits: () => 0,
       timers: { setInterval: () => 1, clearInterval, setTimeout: () => 0, clearTimeout: () => {} }
     });
 
@@ -4,7 +4,9 @@ import {
   buildClientHello,
   buildPing,
   decodeEnvelope,
+  decodeEnvelopes,
   encodeEnvelope,
+  encodeDecalDebugReport,
   encodeFireWeaponRequest,
   encodeSetLoadoutRequest,
   parseErrorPayload,
@@ -22,6 +24,7 @@ import {
   parseStateSnapshotDelta,
   parseStateSnapshotDeltaPayload,
   parseStateSnapshotPayload,
+  parseWorldSnapshot,
   MessageType,
   PROTOCOL_VERSION,
   SNAPSHOT_MASK_AMMO_IN_MAG,
@@ -40,9 +43,14 @@ import {
   SNAPSHOT_MASK_VIEW_PITCH_Q,
   SNAPSHOT_MASK_VIEW_YAW_Q,
   SNAPSHOT_MASK_WEAPON_HEAT_Q,
-  SNAPSHOT_MASK_WEAPON_SLOT
+  SNAPSHOT_MASK_WEAPON_SLOT,
+  SNAPSHOT_DASH_COOLDOWN_STEP_SECONDS,
+  SNAPSHOT_HEALTH_STEP,
+  SNAPSHOT_POSITION_STEP_METERS,
+  SNAPSHOT_VELOCITY_STEP
 } from '../../src/net/protocol';
 import { ClientHello } from '../../src/net/fbs/afps/protocol/client-hello';
+import { DecalDebugReport } from '../../src/net/fbs/afps/protocol/decal-debug-report';
 import { Error as ErrorMessage } from '../../src/net/fbs/afps/protocol/error';
 import { FireWeaponRequest } from '../../src/net/fbs/afps/protocol/fire-weapon-request';
 import { FxEvent } from '../../src/net/fbs/afps/protocol/fx-event';
@@ -65,10 +73,16 @@ import { ServerHello } from '../../src/net/fbs/afps/protocol/server-hello';
 import { SetLoadoutRequest } from '../../src/net/fbs/afps/protocol/set-loadout-request';
 import { ShotFiredFxT } from '../../src/net/fbs/afps/protocol/shot-fired-fx';
 import { ShotTraceFxT } from '../../src/net/fbs/afps/protocol/shot-trace-fx';
-import { StateSnapshot } from '../../src/net/fbs/afps/protocol/state-snapshot';
-import { StateSnapshotDelta } from '../../src/net/fbs/afps/protocol/state-snapshot-delta';
+import { StateSnapshot, StateSnapshotT } from '../../src/net/fbs/afps/protocol/state-snapshot';
+import { StateSnapshotDelta, StateSnapshotDeltaT } from '../../src/net/fbs/afps/protocol/state-snapshot-delta';
 import { SurfaceType } from '../../src/net/fbs/afps/protocol/surface-type';
 import { VentFxT } from '../../src/net/fbs/afps/protocol/vent-fx';
+import { WorldSnapshotT } from '../../src/net/fbs/afps/protocol/world-snapshot';
+
+const quantizePosition = (meters: number) => Math.round(meters / SNAPSHOT_POSITION_STEP_METERS);
+const quantizeVelocity = (value: number) => Math.round(value / SNAPSHOT_VELOCITY_STEP);
+const quantizeDashCooldown = (seconds: number) => Math.round(seconds / SNAPSHOT_DASH_COOLDOWN_STEP_SECONDS);
+const quantizeHealth = (health: number) => Math.round(health / SNAPSHOT_HEALTH_STEP);
 
 const buildSnapshotPayload = (
   overrides: Partial<{
@@ -101,16 +115,16 @@ const buildSnapshotPayload = (
     overrides.serverTick ?? 12,
     overrides.lastProcessedInputSeq ?? 7,
     clientId,
-    overrides.posX ?? 1.25,
-    overrides.posY ?? -3,
-    overrides.posZ ?? 0.5,
-    overrides.velX ?? 0.5,
-    overrides.velY ?? -0.25,
-    overrides.velZ ?? 0.1,
+    quantizePosition(overrides.posX ?? 1.25),
+    quantizePosition(overrides.posY ?? -3),
+    quantizePosition(overrides.posZ ?? 0.5),
+    quantizeVelocity(overrides.velX ?? 0.5),
+    quantizeVelocity(overrides.velY ?? -0.25),
+    quantizeVelocity(overrides.velZ ?? 0.125),
     overrides.weaponSlot ?? 1,
     overrides.ammoInMag ?? 24,
-    overrides.dashCooldown ?? 0.4,
-    overrides.health ?? 75,
+    quantizeDashCooldown(overrides.dashCooldown ?? 0.375),
+    quantizeHealth(overrides.health ?? 75),
     overrides.kills ?? 2,
     overrides.deaths ?? 1,
     overrides.viewYawQ ?? 123,
@@ -158,16 +172,16 @@ const buildDeltaPayload = (
     overrides?.lastProcessedInputSeq ?? 9,
     overrides?.mask ?? SNAPSHOT_MASK_POS_X,
     clientId,
-    overrides?.posX ?? 0,
-    overrides?.posY ?? 0,
-    overrides?.posZ ?? 0,
-    overrides?.velX ?? 0,
-    overrides?.velY ?? 0,
-    overrides?.velZ ?? 0,
+    quantizePosition(overrides?.posX ?? 0),
+    quantizePosition(overrides?.posY ?? 0),
+    quantizePosition(overrides?.posZ ?? 0),
+    quantizeVelocity(overrides?.velX ?? 0),
+    quantizeVelocity(overrides?.velY ?? 0),
+    quantizeVelocity(overrides?.velZ ?? 0),
     overrides?.weaponSlot ?? 0,
     overrides?.ammoInMag ?? 0,
-    overrides?.dashCooldown ?? 0,
-    overrides?.health ?? 0,
+    quantizeDashCooldown(overrides?.dashCooldown ?? 0),
+    quantizeHealth(overrides?.health ?? 0),
     overrides?.kills ?? 0,
     overrides?.deaths ?? 0,
     overrides?.viewYawQ ?? 0,
@@ -373,10 +387,10 @@ describe('protocol helpers', () => {
       posZ: 0.5,
       velX: 0.5,
       velY: -0.25,
-      velZ: 0.1,
+      velZ: 0.125,
       weaponSlot: 1,
       ammoInMag: 24,
-      dashCooldown: 0.4,
+      dashCooldown: 0.375,
       health: 75,
       kills: 2,
       deaths: 1,
@@ -670,6 +684,19 @@ describe('protocol helpers', () => {
     expect(parsePong(envelope)).toEqual({ type: 'Pong', clientTimeMs: 5.5 });
   });
 
+  it('splits bundled envelopes', () => {
+    const first = buildPing(1.5, 1, 0);
+    const second = buildPing(2.5, 2, 0);
+    const bundle = new Uint8Array(first.byteLength + second.byteLength);
+    bundle.set(first, 0);
+    bundle.set(second, first.byteLength);
+
+    expect(decodeEnvelopes(bundle).map((envelope) => envelope.header.msgSeq)).toEqual([1, 2]);
+    expect(decodeEnvelopes(first).length).toBe(1);
+    expect(decodeEnvelopes(bundle.subarray(0, bundle.byteLength - 1)).length).toBe(1);
+    expect(decodeEnvelope(bundle)).toBeNull();
+  });
+
   it('clamps non-finite ping times', () => {
     const envelope = buildPing(Number.NaN, 2, 0);
     const decoded = decodeEnvelope(envelope);
@@ -695,6 +722,54 @@ describe('protocol helpers', () => {
     expect(parseSnapshotMessage(deltaEnvelope)?.type).toBe('StateSnapshotDelta');
   });
 
+  it('parses world snapshots with keyframes and deltas', () => {
+    const keyframe = new StateSnapshotT();
+    keyframe.serverTick = 30;
+    keyframe.lastProcessedInputSeq = 4;
+    keyframe.clientId = 'alpha';
+    keyframe.posXQ = quantizePosition(2.5);
+    keyframe.healthQ = quantizeHealth(90);
+    const delta = new StateSnapshotDeltaT();
+    delta.serverTick = 0;
+    delta.baseTick = 27;
+    delta.lastProcessedInputSeq = 6;
+    delta.mask = SNAPSHOT_MASK_POS_Y;
+    delta.clientId = 'bravo';
+    delta.posYQ = quantizePosition(-1.5);
+    const builder = new flatbuffers.Builder(256);
+    builder.finish(new WorldSnapshotT(30, [keyframe], [delta]).pack(builder));
+    const envelope = encodeEnvelope(MessageType.WorldSnapshot, builder.asUint8Array(), 3, 1);
+
+    const world = parseWorldSnapshot(envelope);
+    expect(world?.serverTick).toBe(30);
+    expect(world?.snapshots).toHaveLength(1);
+    expect(world?.snapshots[0]?.clientId).toBe('alpha');
+    expect(world?.snapshots[0]?.serverTick).toBe(30);
+    expect(world?.snapshots[0]?.posX).toBe(2.5);
+    expect(world?.snapshots[0]?.health).toBe(90);
+    expect(world?.deltas).toHaveLength(1);
+    expect(world?.deltas[0]?.clientId).toBe('bravo');
+    expect(world?.deltas[0]?.baseTick).toBe(27);
+    expect(world?.deltas[0]?.serverTick).toBe(30);
+    expect(world?.deltas[0]?.posY).toBe(-1.5);
+    expect(parseWorldSnapshot(buildPing(1, 1, 0))).toBeNull();
+  });
+
+  it('dequantizes snapshot fields within half a step', () => {
+    const samples = [-29.9, -7.3, 0.001, 3.14159, 29.99];
+    for (const value of samples) {
+      const snapshot = parseStateSnapshotPayload(
+        buildSnapshotPayload({ posX: value, velY: value, dashCooldown: Math.abs(value) / 10, health: Math.abs(value) })
+      );
+      expect(Math.abs((snapshot?.posX ?? Number.NaN) - value)).toBeLessThanOrEqual(SNAPSHOT_POSITION_STEP_METERS / 2);
+      expect(Math.abs((snapshot?.velY ?? Number.NaN) - value)).toBeLessThanOrEqual(SNAPSHOT_VELOCITY_STEP / 2);
+      expect(Math.abs((snapshot?.dashCooldown ?? Number.NaN) - Math.abs(value) / 10)).toBeLessThanOrEqual(
+        SNAPSHOT_DASH_COOLDOWN_STEP_SECONDS / 2
+      );
+      expect(Math.abs((snapshot?.health ?? Number.NaN) - Math.abs(value))).toBeLessThanOrEqual(SNAPSHOT_HEALTH_STEP / 2);
+    }
+  });
+
   it('parses snapshots without client ids', () => {
     const snapshot = parseStateSnapshotPayload(buildSnapshotPayload({ clientId: '' }));
     expect(snapshot?.clientId).toBeUndefined();
@@ -775,7 +850,6 @@ describe('protocol helpers', () => {
     expect(parsePongPayload(pongBuilder.asUint8Array())).toBeNull();
 
     expect(parseStateSnapshotPayload(buildSnapshotPayload({ serverTick: -1 }))).toBeNull();
-    expect(parseStateSnapshotPayload(buildSnapshotPayload({ posX: Number.NaN }))).toBeNull();
 
     const invalidDelta = parseStateSnapshotDeltaPayload(
       buildDeltaPayload({
@@ -819,17 +893,6 @@ describe('protocol helpers', () => {
       )
     ).toBeNull();
 
-    expect(
-      parseStateSnapshotDeltaPayload(
-        buildDeltaPayload({
-          serverTick: 1,
-          baseTick: 0,
-          mask: SNAPSHOT_MASK_POS_X,
-          posX: Number.NaN
-        })
-      )
-    ).toBeNull();
-
     const eventBadTickBuilder = new flatbuffers.Builder(128);
     const badTickPayload = new GameEventT( -1, [FxEvent.ShotFiredFx], [new ShotFiredFxT('shooter', 0, 1, false)] as never).pack(eventBadTickBuilder);
     eventBadTickBuilder.finish(badTickPayload);
@@ -945,6 +1008,55 @@ describe('protocol helpers', () => {
     expect(message.debugProjectionTelemetryEnabled()).toBe(true);
   });
 
+  it('builds DecalDebugReport envelopes', () => {
+    const envelope = encodeDecalDebugReport(
+      {
+        serverTick: 777,
+        shotSeq: 55,
+        hitKind: 1,
+        surfaceType: 2,
+        authoritativeWorldHit: true,
+        usedProjectedHit: false,
+        usedImpactProjection: true,
+        decalSpawned: true,
+        decalInFrustum: false,
+        decalDistance: 3.25,
+        decalPositionX: 11,
+        decalPositionY: 12,
+        decalPositionZ: 13,
+        decalNormalX: 0,
+        decalNormalY: 1,
+        decalNormalZ: 0,
+        traceHitPositionX: 21,
+        traceHitPositionY: 22,
+        traceHitPositionZ: 23,
+        traceHitNormalX: 0.2,
+        traceHitNormalY: 0.3,
+        traceHitNormalZ: 0.4
+      },
+      6,
+      2
+    );
+    const decoded = decodeEnvelope(envelope);
+    expect(decoded?.header.msgType).toBe(MessageType.DecalDebugReport);
+    expect(decoded?.header.msgSeq).toBe(6);
+    const message = DecalDebugReport.getRootAsDecalDebugReport(new flatbuffers.ByteBuffer(decoded!.payload));
+    expect(message.serverTick()).toBe(777);
+    expect(message.shotSeq()).toBe(55);
+    expect(message.hitKind()).toBe(1);
+    expect(message.surfaceType()).toBe(2);
+    expect(message.authoritativeWorldHit()).toBe(true);
+    expect(message.usedProjectedHit()).toBe(false);
+    expect(message.usedImpactProjection()).toBe(true);
+    expect(message.decalSpawned()).toBe(true);
+    expect(message.decalInFrustum()).toBe(false);
+    expect(message.decalDistance()).toBeCloseTo(3.25);
+    expect(message.decalPositionZ()).toBeCloseTo(13);
+    expect(message.decalNormalY()).toBeCloseTo(1);
+    expect(message.traceHitPositionX()).toBeCloseTo(21);
+    expect(message.traceHitNormalZ()).toBeCloseTo(0.4);
+  });
+
   it('builds FireWeaponRequest envelopes without weapon ids', () => {
     const envelope = encodeFireWeaponRequest(
       {
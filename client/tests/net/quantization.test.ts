@@ -3,8 +3,12 @@ import {
   __test,
   decodeOct16,
   decodePitchQ,
+  decodeUnitI8,
   decodeUnitU16,
   decodeYawQ,
+  encodePitchQ,
+  encodeUnitI8,
+  encodeYawQ,
   dequantizeI16,
   dequantizeU16
 } from '../../src/net/quantization';
@@ -53,6 +57,30 @@ describe('quantization helpers', () => {
     expect(decodePitchQ(-__test.INT16_MAX)).toBeCloseTo(-__test.MAX_PITCH_RAD);
   });
 
+  it('encodes yaw/pitch angles and unit axes to their wire steps', () => {
+    expect(encodeYawQ(Number.NaN)).toBe(0);
+    expect(encodePitchQ(Number.POSITIVE_INFINITY)).toBe(0);
+    expect(encodeUnitI8(Number.NaN)).toBe(0);
+
+    expect(encodeYawQ(0)).toBe(0);
+    expect(encodeYawQ(-1e-6)).toBe(0);
+    expect(encodeYawQ(Math.PI * 3)).toBe(encodeYawQ(Math.PI));
+    expect(encodeYawQ(-Math.PI / 2)).toBe(-16384);
+    expect(encodePitchQ(4)).toBe(__test.INT16_MAX);
+    expect(encodePitchQ(-4)).toBe(-__test.INT16_MAX);
+    expect(encodeUnitI8(2)).toBe(127);
+    expect(encodeUnitI8(-0.5)).toBe(-64);
+
+    for (const q of [-32767, -12345, -1, 0, 1, 20000, 32766]) {
+      expect(encodeYawQ(decodeYawQ(q))).toBe(q);
+      expect(encodePitchQ(decodePitchQ(q))).toBe(q);
+    }
+    for (let q = -127; q <= 127; q += 1) {
+      expect(encodeUnitI8(decodeUnitI8(q))).toBe(q);
+    }
+    expect(decodeUnitI8(-128)).toBe(-1);
+  });
+
   it('decodes octahedral unit vectors', () => {
     expect(decodeOct16(Number.NaN, 0)).toEqual({ x: 0, y: 0, z: 1 });
     expect(decodeOct16(0, Number.NaN)).toEqual({ x: 0, y: 0, z: 1 });
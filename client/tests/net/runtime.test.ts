@@ -66,6 +66,7 @@ const createDeps = () => {
     },
     nextClientMessageSeq: () => 1,
     getServerSeqAck: () => 0,
+    getServerSeqAckBits: () => 0,
     close: () => {}
   };
 
@@ -355,6 +355,47 @@ describe('SnapshotDecoder', () => {
     });
   });
 
+  it('resolves deltas against older reconstructed baselines', () => {
+    const decoder = new SnapshotDecoder();
+    decoder.apply(baseSnapshot);
+
+    const first = decoder.apply({
+      type: 'StateSnapshotDelta',
+      serverTick: 8,
+      baseTick: 5,
+      lastProcessedInputSeq: 3,
+      mask: SNAPSHOT_MASK_POS_X,
+      posX: 4,
+      clientId: 'client-1'
+    });
+    expect(first?.posX).toBe(4);
+
+    const fromDelta = decoder.apply({
+      type: 'StateSnapshotDelta',
+      serverTick: 11,
+      baseTick: 8,
+      lastProcessedInputSeq: 4,
+      mask: SNAPSHOT_MASK_POS_Y,
+      posY: 6,
+      clientId: 'client-1'
+    });
+    expect(fromDelta?.posX).toBe(4);
+    expect(fromDelta?.posY).toBe(6);
+
+    const fromKeyframe = decoder.apply({
+      type: 'StateSnapshotDelta',
+      serverTick: 14,
+      baseTick: 5,
+      lastProcessedInputSeq: 5,
+      mask: SNAPSHOT_MASK_POS_Z,
+      posZ: 3,
+      clientId: 'client-1'
+    });
+    expect(fromKeyframe?.posX).toBe(1.25);
+    expect(fromKeyframe?.posY).toBe(-2);
+    expect(fromKeyframe?.posZ).toBe(3);
+  });
+
   it('retains base positions when masks exclude them', () => {
     const decoder = new SnapshotDecoder();
     decoder.apply(baseSnapshot);
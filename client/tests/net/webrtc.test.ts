@@ -8,7 +8,11 @@ import {
   PROTOCOL_VERSION,
   SNAPSHOT_MASK_POS_X,
   SNAPSHOT_MASK_VEL_Y,
-  SNAPSHOT_MASK_AMMO_IN_MAG
+  SNAPSHOT_MASK_AMMO_IN_MAG,
+  SNAPSHOT_DASH_COOLDOWN_STEP_SECONDS,
+  SNAPSHOT_HEALTH_STEP,
+  SNAPSHOT_POSITION_STEP_METERS,
+  SNAPSHOT_VELOCITY_STEP
 } from '../../src/net/protocol';
 import { FakeDataChannel, FakePeerConnection, FakePeerConnectionFactory, FakeSignalingClient } from './fakes';
 import { ClientHello } from '../../src/net/fbs/afps/protocol/client-hello';
@@ -105,16 +109,16 @@ const buildStateSnapshot = (snapshot: {
     snapshot.serverTick,
     snapshot.lastProcessedInputSeq,
     clientId,
-    snapshot.posX,
-    snapshot.posY,
-    snapshot.posZ,
-    snapshot.velX,
-    snapshot.velY,
-    snapshot.velZ,
+    Math.round(snapshot.posX / SNAPSHOT_POSITION_STEP_METERS),
+    Math.round(snapshot.posY / SNAPSHOT_POSITION_STEP_METERS),
+    Math.round(snapshot.posZ / SNAPSHOT_POSITION_STEP_METERS),
+    Math.round(snapshot.velX / SNAPSHOT_VELOCITY_STEP),
+    Math.round(snapshot.velY / SNAPSHOT_VELOCITY_STEP),
+    Math.round(snapshot.velZ / SNAPSHOT_VELOCITY_STEP),
     snapshot.weaponSlot,
     snapshot.ammoInMag ?? 0,
-    snapshot.dashCooldown,
-    snapshot.health,
+    Math.round(snapshot.dashCooldown / SNAPSHOT_DASH_COOLDOWN_STEP_SECONDS),
+    Math.round(snapshot.health / SNAPSHOT_HEALTH_STEP),
     snapshot.kills,
     snapshot.deaths,
     snapshot.viewYawQ ?? 0,
@@ -160,16 +164,16 @@ const buildStateSnapshotDelta = (delta: {
     delta.lastProcessedInputSeq,
     delta.mask,
     clientId,
-    delta.posX ?? 0,
-    delta.posY ?? 0,
-    delta.posZ ?? 0,
-    delta.velX ?? 0,
-    delta.velY ?? 0,
-    delta.velZ ?? 0,
+    Math.round((delta.posX ?? 0) / SNAPSHOT_POSITION_STEP_METERS),
+    Math.round((delta.posY ?? 0) / SNAPSHOT_POSITION_STEP_METERS),
+    Math.round((delta.posZ ?? 0) / SNAPSHOT_POSITION_STEP_METERS),
+    Math.round((delta.velX ?? 0) / SNAPSHOT_VELOCITY_STEP),
+    Math.round((delta.velY ?? 0) / SNAPSHOT_VELOCITY_STEP),
+    Math.round((delta.velZ ?? 0) / SNAPSHOT_VELOCITY_STEP),
     delta.weaponSlot ?? 0,
     delta.ammoInMag ?? 0,
-    delta.dashCooldown ?? 0,
-    delta.health ?? 0,
+    Math.round((delta.dashCooldown ?? 0) / SNAPSHOT_DASH_COOLDOWN_STEP_SECONDS),
+    Math.round((delta.health ?? 0) / SNAPSHOT_HEALTH_STEP),
     delta.kills ?? 0,
     delta.deaths ?? 0,
     delta.viewYawQ ?? 0,
@@ -1107,6 +1111,55 @@ describe('webrtc connector', () => {
     vi.useRealTimers();
   });
 
+  it('tracks which earlier server messages arrived in the ack bits', async () => {
+    vi.useFakeTimers();
+    const signaling = new FakeSignalingClient();
+    const rtcFactory = new FakePeerConnectionFactory();
+    const connector = createWebRtcConnector({
+      signaling,
+      rtcFactory,
+      logger: silentLogger,
+      pollIntervalMs: 100,
+      connectTimeoutMs: 1000,
+      timers: createTimers()
+    });
+
+    const connectPromise = connector.connect();
+    const pc = await waitForPeer(rtcFactory);
+
+    const reliable = new FakeDataChannel('afps_reliable');
+    const unreliable = new FakeDataChannel('afps_unreliable');
+    pc.emitDataChannel(reliable);
+    pc.emitDataChannel(unreliable);
+    reliable.open();
+    unreliable.open();
+    await Promise.resolve();
+    reliable.emitMessage(buildServerHello(signaling.connectionId));
+
+    const session = await connectPromise;
+    expect(session.getServerSeqAck()).toBe(1);
+    expect(session.getServerSeqAckBits()).toBe(0);
+
+    unreliable.emitMessage(buildPong(1, 4));
+    expect(session.getServerSeqAck()).toBe(4);
+    expect(session.getServerSeqAckBits()).toBe(0b100);
+
+    unreliable.emitMessage(buildPong(1, 3));
+    expect(session.getServerSeqAck()).toBe(4);
+    expect(session.getServerSeqAckBits()).toBe(0b101);
+
+    unreliable.emitMessage(buildPong(1, 36));
+    expect(session.getServerSeqAck()).toBe(36);
+    expect(session.getServerSeqAckBits()).toBe(0x80000000);
+
+    unreliable.emitMessage(buildPong(1, 70));
+    unreliable.emitMessage(buildPong(1, 69));
+    expect(session.getServerSeqAck()).toBe(70);
+    expect(session.getServerSeqAckBits()).toBe(1);
+    session.close();
+    vi.useRealTimers();
+  });
+
   it('ignores ping messages on the unreliable channel', async () => {
     vi.useFakeTimers();
     const signaling = new FakeSignalingClient();
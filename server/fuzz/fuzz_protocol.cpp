@@ -1,38 +1,81 @@
 #include "protocol.h"
 
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
 #include <string>
 #include <vector>
 
-extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
-  std::vector<uint8_t> message;
-  message.reserve(size);
-  message.insert(message.end(), data, data + size);
-
-  DecodedEnvelope envelope;
+namespace {
+void ParsePayload(MessageType type, ByteSpan payload) {
   std::string error;
-  if (!DecodeEnvelope(message, envelope, error)) {
-    return 0;
-  }
-
-  switch (envelope.header.type) {
+  switch (type) {
     case MessageType::ClientHello: {
       ClientHello hello;
-      ParseClientHelloPayload(envelope.payload, hello, error);
+      ParseClientHelloPayload(payload, hello, error);
       break;
     }
     case MessageType::InputCmd: {
-      InputCmd cmd;
-      ParseInputCmdPayload(envelope.payload, cmd, error);
+      InputCmdFrames cmd;
+      ParseInputCmdPayload(payload, cmd, error);
+      break;
+    }
+    case MessageType::DecalDebugReport: {
+      DecalDebugReport report;
+      ParseDecalDebugReportPayload(payload, report, error);
+      break;
+    }
+    case MessageType::FireWeaponRequest: {
+      FireWeaponRequest request;
+      ParseFireWeaponRequestPayload(payload, request, error);
+      break;
+    }
+    case MessageType::SetLoadoutRequest: {
+      SetLoadoutRequest request;
+      ParseSetLoadoutRequestPayload(payload, request, error);
       break;
     }
     case MessageType::Ping: {
       Ping ping;
-      ParsePingPayload(envelope.payload, ping, error);
+      ParsePingPayload(payload, ping, error);
       break;
     }
     default:
       break;
   }
+}
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  // The receive path decodes DataChannel bytes in place, so the view sees the fuzzer's buffer.
+  EnvelopeView view;
+  std::string view_error;
+  const bool view_ok = DecodeEnvelopeView(ByteSpan(data, size), view, view_error);
+
+  const std::vector<uint8_t> message(data, data + size);
+  DecodedEnvelope envelope;
+  std::string error;
+  const bool copy_ok = DecodeEnvelope(message, envelope, error);
+
+  // The copying decoder is a wrapper over the view; both must agree on every input.
+  if (view_ok != copy_ok || view_error != error) {
+    std::abort();
+  }
+  if (!view_ok) {
+    // Still feed the bytes to each parser as a bare payload to reach the FlatBuffers verifier.
+    for (const auto type : {MessageType::ClientHello, MessageType::InputCmd, MessageType::FireWeaponRequest,
+                            MessageType::SetLoadoutRequest, MessageType::DecalDebugReport, MessageType::Ping}) {
+      ParsePayload(type, ByteSpan(data, size));
+    }
+    return 0;
+  }
+  if (view.header.msg_type != envelope.header.msg_type || view.header.msg_seq != envelope.header.msg_seq ||
+      view.payload.size() != envelope.payload.size() ||
+      (!view.payload.empty() &&
+       std::memcmp(view.payload.data(), envelope.payload.data(), view.payload.size()) != 0)) {
+    std::abort();
+  }
 
+  ParsePayload(view.header.msg_type, view.payload);
   return 0;
 }
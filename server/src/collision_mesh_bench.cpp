@@ -0,0 +1,112 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "world_collision_mesh.h"
+
+namespace {
+int ParseInt(const char *value, int fallback) {
+  if (!value) {
+    return fallback;
+  }
+  try {
+    return std::stoi(value);
+  } catch (...) {
+    return fallback;
+  }
+}
+
+struct BenchRay {
+  size_t prefab = 0;
+  afps::sim::Vec3 origin{};
+  afps::sim::Vec3 dir{};
+  double max_distance = 0.0;
+};
+}
+
+int main(int argc, char **argv) {
+  int rays_per_prefab = 20000;
+  int repeats = 5;
+  unsigned int seed = 1337;
+  std::string path;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--rays" && i + 1 < argc) {
+      rays_per_prefab = ParseInt(argv[++i], rays_per_prefab);
+    } else if (arg == "--repeats" && i + 1 < argc) {
+      repeats = ParseInt(argv[++i], repeats);
+    } else if (arg == "--seed" && i + 1 < argc) {
+      seed = static_cast<unsigned int>(ParseInt(argv[++i], seed));
+    } else if (arg == "--registry" && i + 1 < argc) {
+      path = argv[++i];
+    }
+  }
+  if (rays_per_prefab <= 0 || repeats <= 0) {
+    std::cerr << "Invalid rays/repeats\n";
+    return 1;
+  }
+
+  afps::world::CollisionMeshRegistry registry;
+  std::string error;
+  const bool loaded = path.empty() ? afps::world::LoadCollisionMeshRegistry(registry, error)
+                                   : afps::world::LoadCollisionMeshRegistry(path, registry, error);
+  if (!loaded) {
+    std::cerr << "[error] " << error << "\n";
+    return 1;
+  }
+
+  // Rays start outside each prefab and aim at a random point inside its bounds, like shots
+  // that reached the instance broadphase.
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::vector<BenchRay> rays;
+  rays.reserve(registry.prefabs.size() * static_cast<size_t>(rays_per_prefab));
+  for (size_t p = 0; p < registry.prefabs.size(); ++p) {
+    const auto &bounds = registry.prefabs[p].bounds;
+    const afps::sim::Vec3 center{(bounds.min_x + bounds.max_x) * 0.5, (bounds.min_y + bounds.max_y) * 0.5,
+                                 (bounds.min_z + bounds.max_z) * 0.5};
+    const double radius = std::sqrt((bounds.max_x - bounds.min_x) * (bounds.max_x - bounds.min_x) +
+                                    (bounds.max_y - bounds.min_y) * (bounds.max_y - bounds.min_y) +
+                                    (bounds.max_z - bounds.min_z) * (bounds.max_z - bounds.min_z));
+    for (int i = 0; i < rays_per_prefab; ++i) {
+      const double z = unit(rng) * 2.0 - 1.0;
+      const double phi = unit(rng) * 6.283185307179586;
+      const double r = std::sqrt(std::max(0.0, 1.0 - z * z));
+      const afps::sim::Vec3 origin{center.x + radius * r * std::cos(phi), center.y + radius * r * std::sin(phi),
+                                   center.z + radius * z};
+      const afps::sim::Vec3 target{bounds.min_x + unit(rng) * (bounds.max_x - bounds.min_x),
+                                   bounds.min_y + unit(rng) * (bounds.max_y - bounds.min_y),
+                                   bounds.min_z + unit(rng) * (bounds.max_z - bounds.min_z)};
+      afps::sim::Vec3 dir{target.x - origin.x, target.y - origin.y, target.z - origin.z};
+      const double len = std::sqrt(dir.x * dir.x + dir.y * dir.y + dir.z * dir.z);
+      dir = {dir.x / len, dir.y / len, dir.z / len};
+      rays.push_back({p, origin, dir, radius * 3.0});
+    }
+  }
+
+  size_t hits = 0;
+  double checksum = 0.0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int repeat = 0; repeat < repeats; ++repeat) {
+    for (const auto &ray : rays) {
+      afps::world::CollisionMeshRayHit hit;
+      if (afps::world::RaycastCollisionMeshPrefab(registry.prefabs[ray.prefab], ray.origin, ray.dir,
+                                                  ray.max_distance, hit)) {
+        ++hits;
+        checksum += hit.t;
+      }
+    }
+  }
+  const auto end = std::chrono::steady_clock::now();
+  const auto elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
+  const double total_rays = static_cast<double>(rays.size()) * static_cast<double>(repeats);
+  const double rays_per_sec = elapsed.count() > 0 ? total_rays / elapsed.count() : 0.0;
+
+  std::cout << "collision_mesh_bench prefabs=" << registry.prefabs.size() << " rays=" << rays.size()
+            << " repeats=" << repeats << " hits=" << hits << " t_sum=" << checksum
+            << " seconds=" << elapsed.count() << " rays_per_sec=" << rays_per_sec << "\n";
+  return 0;
+}
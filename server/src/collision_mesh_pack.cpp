@@ -0,0 +1,44 @@
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "world_collision_mesh.h"
+
+int main(int argc, char **argv) {
+  std::string source_path;
+  std::string binary_path;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--in" && i + 1 < argc) {
+      source_path = argv[++i];
+    } else if (arg == "--out" && i + 1 < argc) {
+      binary_path = argv[++i];
+    } else {
+      std::cerr << "Usage: afps_collision_mesh_pack [--in registry.json] [--out registry.bin]\n";
+      return 1;
+    }
+  }
+  if (source_path.empty()) {
+    source_path = afps::world::ResolveCollisionMeshRegistryPath();
+  }
+  if (binary_path.empty()) {
+    binary_path = afps::world::ResolveCollisionMeshBinaryPath(source_path);
+  }
+
+  std::string error;
+  if (!afps::world::PackCollisionMeshRegistry(source_path, binary_path, error)) {
+    std::cerr << "[error] " << error << "\n";
+    return 1;
+  }
+  afps::world::CollisionMeshBinaryInfo info;
+  if (!afps::world::ReadCollisionMeshBinaryInfo(binary_path, info, error)) {
+    std::cerr << "[error] " << error << "\n";
+    return 1;
+  }
+  std::cout << "{\"event\":\"collision_mesh_binary_written\",\"source\":" << std::quoted(source_path)
+            << ",\"path\":" << std::quoted(binary_path) << ",\"format_version\":" << info.format_version
+            << ",\"prefab_count\":" << info.prefab_count << ",\"triangle_count\":" << info.triangle_count
+            << ",\"bytes\":" << info.file_size << ",\"checksum\":\"" << std::hex << std::setw(16)
+            << std::setfill('0') << info.checksum << "\"}\n";
+  return 0;
+}
@@ -2,12 +2,17 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
+
+#include "ray_kernels.h"
 
 namespace afps::combat {
 
 namespace {
 constexpr double kPi = 3.14159265358979323846;
 constexpr double kMaxPitch = (kPi / 2.0) - 0.01;
+// Marks ring entries that hold no sample; no caller pushes ticks this far back.
+constexpr int kNoPoseTick = std::numeric_limits<int>::min();
 
 double WrapAngle(double angle) {
   if (!std::isfinite(angle)) {
@@ -20,101 +25,6 @@ double WrapAngle(double angle) {
   return wrapped - kPi;
 }
 
-double RaycastAabb2D(double origin_x, double origin_y, double dir_x, double dir_y, double min_x, double max_x,
-                     double min_y, double max_y) {
-  const double inf = std::numeric_limits<double>::infinity();
-  const double epsilon = 1e-8;
-  double t_min = -inf;
-  double t_max = inf;
-
-  auto update_axis = [&](double origin, double dir, double min_bound, double max_bound) -> bool {
-    if (std::abs(dir) < epsilon) {
-      return origin >= min_bound && origin <= max_bound;
-    }
-    double t1 = (min_bound - origin) / dir;
-    double t2 = (max_bound - origin) / dir;
-    if (t1 > t2) {
-      std::swap(t1, t2);
-    }
-    t_min = std::max(t_min, t1);
-    t_max = std::min(t_max, t2);
-    return t_min <= t_max;
-  };
-
-  if (!update_axis(origin_x, dir_x, min_x, max_x)) {
-    return inf;
-  }
-  if (!update_axis(origin_y, dir_y, min_y, max_y)) {
-    return inf;
-  }
-  if (t_max < 0.0) {
-    return inf;
-  }
-  if (t_min >= 0.0) {
-    return t_min;
-  }
-  return t_max;
-}
-
-double RaycastArena(const Vec3 &origin, const Vec3 &dir, const afps::sim::SimConfig &config) {
-  if (!std::isfinite(config.arena_half_size) || config.arena_half_size <= 0.0) {
-    return std::numeric_limits<double>::infinity();
-  }
-  const double half = std::max(0.0, config.arena_half_size);
-  return RaycastAabb2D(origin.x, origin.y, dir.x, dir.y, -half, half, -half, half);
-}
-
-double RaycastObstacle(const Vec3 &origin, const Vec3 &dir, const afps::sim::SimConfig &config) {
-  if (!std::isfinite(config.obstacle_min_x) || !std::isfinite(config.obstacle_max_x) ||
-      !std::isfinite(config.obstacle_min_y) || !std::isfinite(config.obstacle_max_y)) {
-    return std::numeric_limits<double>::infinity();
-  }
-  if (config.obstacle_min_x >= config.obstacle_max_x || config.obstacle_min_y >= config.obstacle_max_y) {
-    return std::numeric_limits<double>::infinity();
-  }
-  return RaycastAabb2D(origin.x, origin.y, dir.x, dir.y, config.obstacle_min_x, config.obstacle_max_x,
-                       config.obstacle_min_y, config.obstacle_max_y);
-}
-
-bool RaycastCylinder(const Vec3 &origin, const Vec3 &dir, const Vec3 &base, double height, double radius, double &t) {
-  const double epsilon = 1e-8;
-  const double a = dir.x * dir.x + dir.y * dir.y;
-  const double ox = origin.x - base.x;
-  const double oy = origin.y - base.y;
-  if (a <= epsilon) {
-    return false;
-  }
-  const double b = 2.0 * (ox * dir.x + oy * dir.y);
-  const double c = ox * ox + oy * oy - radius * radius;
-  const double discriminant = b * b - 4.0 * a * c;
-  if (discriminant < 0.0) {
-    return false;
-  }
-  const double sqrt_disc = std::sqrt(discriminant);
-  double t0 = (-b - sqrt_disc) / (2.0 * a);
-  double t1 = (-b + sqrt_disc) / (2.0 * a);
-  if (t1 < 0.0) {
-    return false;
-  }
-  double candidate = t0 >= 0.0 ? t0 : t1;
-  double hit_z = origin.z + dir.z * candidate;
-  if (hit_z < base.z || hit_z > base.z + height) {
-    if (candidate == t1) {
-      return false;
-    }
-    candidate = t1;
-    if (candidate < 0.0) {
-      return false;
-    }
-    hit_z = origin.z + dir.z * candidate;
-    if (hit_z < base.z || hit_z > base.z + height) {
-      return false;
-    }
-  }
-  t = candidate;
-  return true;
-}
-
 bool SegmentCylinder(const Vec3 &origin,
                      const Vec3 &delta,
                      const Vec3 &base,
@@ -193,51 +103,248 @@ double ResolveHeight(const afps::sim::SimConfig &config) {
   }
   return kPlayerHeight;
 }
+
+// Every slot with a pose at the rewind time, packed kRayKernelLanes to a block in slot order.
+struct RewoundTargets {
+  std::vector<CylinderLanes> blocks;
+  std::vector<afps::entity::EntitySlot> slots;
+  std::vector<RewindPose> states;
+};
+
+void SampleRewoundTargets(const std::vector<PoseHistory> &histories, double rewind_time, RewoundTargets &out) {
+  out.blocks.clear();
+  out.slots.clear();
+  out.states.clear();
+  RewindPose state;
+  for (size_t slot = 0; slot < histories.size(); ++slot) {
+    if (!histories[slot].SampleAt(rewind_time, state)) {
+      continue;
+    }
+    const size_t lane = out.slots.size() % kRayKernelLanes;
+    if (lane == 0) {
+      out.blocks.emplace_back();
+    }
+    auto &block = out.blocks.back();
+    block.base_x[lane] = state.x;
+    block.base_y[lane] = state.y;
+    block.base_z[lane] = state.z;
+    out.slots.push_back(static_cast<afps::entity::EntitySlot>(slot));
+    out.states.push_back(state);
+  }
+}
+
+// Nearest target other than shooter hit within max_range. Lanes are scanned in slot order with a
+// strict comparison, so ties still go to the lowest slot.
+double NearestRewoundTarget(const RewoundTargets &targets,
+                            afps::entity::EntitySlot shooter,
+                            const KernelRay &ray,
+                            double height,
+                            double radius,
+                            double max_range,
+                            afps::entity::EntitySlot &best_target) {
+  double best_t = std::numeric_limits<double>::infinity();
+  best_target = afps::entity::kInvalidSlot;
+  double lane_t[kRayKernelLanes] = {};
+  for (size_t block = 0; block < targets.blocks.size(); ++block) {
+    const size_t first = block * kRayKernelLanes;
+    const size_t count = std::min(kRayKernelLanes, targets.slots.size() - first);
+    uint32_t mask = RaycastCylinderLanes(ray, targets.blocks[block], count, height, radius, lane_t);
+    for (size_t lane = 0; mask != 0; ++lane, mask >>= 1) {
+      if ((mask & 1u) == 0 || targets.slots[first + lane] == shooter) {
+        continue;
+      }
+      const double t = lane_t[lane];
+      if (t < 0.0 || t > max_range) {
+        continue;
+      }
+      if (t < best_t) {
+        best_t = t;
+        best_target = targets.slots[first + lane];
+      }
+    }
+  }
+  return best_t;
+}
+
+double ResolveWorldDistance(const Vec3 &origin,
+                            const Vec3 &dir,
+                            const afps::sim::SimConfig &config,
+                            const afps::sim::CollisionWorld *world) {
+  const afps::sim::RaycastHit world_hit = afps::sim::RaycastWorld({origin.x, origin.y, origin.z},
+                                                                   {dir.x, dir.y, dir.z},
+                                                                   config,
+                                                                   world);
+  if (world_hit.hit && std::isfinite(world_hit.t) && world_hit.t >= 0.0) {
+    return world_hit.t;
+  }
+  return std::numeric_limits<double>::infinity();
+}
+
+HitResult MakeHitscanResult(afps::entity::EntitySlot best_target,
+                            double best_t,
+                            double world_distance,
+                            const Vec3 &origin,
+                            const Vec3 &dir) {
+  HitResult result;
+  if (best_target == afps::entity::kInvalidSlot) {
+    return result;
+  }
+  if (std::isfinite(world_distance) && world_distance >= 0.0 && best_t > world_distance) {
+    return result;
+  }
+  result.hit = true;
+  result.target_slot = best_target;
+  result.distance = best_t;
+  result.position = {origin.x + dir.x * best_t, origin.y + dir.y * best_t, origin.z + dir.z * best_t};
+  return result;
+}
 }  // namespace
 
-PoseHistory::PoseHistory(size_t max_samples) : max_samples_(max_samples) {}
+RewindPose MakeRewindPose(const afps::sim::PlayerState &state, const ViewAngles &view) {
+  RewindPose pose;
+  pose.x = state.x;
+  pose.y = state.y;
+  pose.z = state.z;
+  pose.view = view;
+  pose.crouched = state.crouched;
+  pose.shield_active = state.shield_active;
+  return pose;
+}
 
-void PoseHistory::SetMaxSamples(size_t max_samples) {
-  max_samples_ = max_samples;
-  Trim();
+PoseHistory::PoseHistory(size_t max_samples) {
+  SetMaxSamples(max_samples);
 }
 
-void PoseHistory::Push(int server_tick, const afps::sim::PlayerState &state) {
-  if (max_samples_ == 0) {
+void PoseHistory::SetMaxSamples(size_t max_samples) {
+  if (max_samples == samples_.size()) {
     return;
   }
-  samples_.push_back({server_tick, state});
-  Trim();
+  std::vector<PoseSample> kept;
+  kept.reserve(count_);
+  if (count_ > 0) {
+    const int oldest = newest_tick_ - static_cast<int>(samples_.size()) + 1;
+    for (int tick = oldest; tick <= newest_tick_; ++tick) {
+      if (const PoseSample *sample = Find(tick)) {
+        kept.push_back(*sample);
+      }
+    }
+  }
+  samples_.assign(max_samples, PoseSample{kNoPoseTick, RewindPose{}});
+  count_ = 0;
+  for (const auto &sample : kept) {
+    if (max_samples > 0 && newest_tick_ - sample.server_tick < static_cast<int>(max_samples)) {
+      samples_[SlotIndex(sample.server_tick)] = sample;
+      ++count_;
+    }
+  }
 }
 
-bool PoseHistory::SampleAtOrBefore(int server_tick, afps::sim::PlayerState &out) const {
+void PoseHistory::Push(int server_tick, const afps::sim::PlayerState &state, const ViewAngles &view) {
   if (samples_.empty()) {
+    return;
+  }
+  const int capacity = static_cast<int>(samples_.size());
+  if (count_ == 0) {
+    newest_tick_ = server_tick;
+  } else if (server_tick > newest_tick_) {
+    // Samples that fall out of the window as it advances are overwritten lazily; only the count
+    // needs to forget them.
+    const int window_start = newest_tick_ - capacity + 1;
+    const int evict_end = std::min(newest_tick_, server_tick - capacity);
+    for (int tick = window_start; tick <= evict_end; ++tick) {
+      if (Find(tick)) {
+        samples_[SlotIndex(tick)].server_tick = kNoPoseTick;
+        --count_;
+      }
+    }
+    newest_tick_ = server_tick;
+  } else if (newest_tick_ - server_tick >= capacity) {
+    return;
+  }
+  PoseSample &slot = samples_[SlotIndex(server_tick)];
+  if (slot.server_tick != server_tick) {
+    ++count_;
+  }
+  slot.server_tick = server_tick;
+  slot.pose = MakeRewindPose(state, view);
+}
+
+bool PoseHistory::SampleAtOrBefore(int server_tick, RewindPose &out) const {
+  if (count_ == 0) {
     return false;
   }
-  for (auto iter = samples_.rbegin(); iter != samples_.rend(); ++iter) {
-    if (iter->server_tick <= server_tick) {
-      out = iter->state;
+  const int oldest = newest_tick_ - static_cast<int>(samples_.size()) + 1;
+  for (int tick = std::min(server_tick, newest_tick_); tick >= oldest; --tick) {
+    if (const PoseSample *sample = Find(tick)) {
+      out = sample->pose;
       return true;
     }
   }
   return false;
 }
 
+bool PoseHistory::SampleAt(double server_time, RewindPose &out) const {
+  if (!std::isfinite(server_time)) {
+    return false;
+  }
+  const double floor_time = std::floor(server_time);
+  const double clamped_floor =
+      std::max(static_cast<double>(std::numeric_limits<int>::min()),
+               std::min(static_cast<double>(std::numeric_limits<int>::max() - 1), floor_time));
+  const int tick = static_cast<int>(clamped_floor);
+  if (!SampleAtOrBefore(tick, out)) {
+    return false;
+  }
+  const double alpha = server_time - floor_time;
+  if (alpha <= 0.0 || !Find(tick)) {
+    return true;
+  }
+  const PoseSample *next = Find(tick + 1);
+  if (!next) {
+    return true;
+  }
+  const RewindPose &to = next->pose;
+  out.x += (to.x - out.x) * alpha;
+  out.y += (to.y - out.y) * alpha;
+  out.z += (to.z - out.z) * alpha;
+  out.view.yaw = WrapAngle(out.view.yaw + WrapAngle(to.view.yaw - out.view.yaw) * alpha);
+  out.view.pitch += (to.view.pitch - out.view.pitch) * alpha;
+  if (alpha >= 0.5) {
+    out.crouched = to.crouched;
+    out.shield_active = to.shield_active;
+  }
+  return true;
+}
+
 int PoseHistory::OldestTick() const {
-  if (samples_.empty()) {
+  if (count_ == 0) {
     return 0;
   }
-  return samples_.front().server_tick;
+  for (int tick = newest_tick_ - static_cast<int>(samples_.size()) + 1; tick < newest_tick_; ++tick) {
+    if (Find(tick)) {
+      return tick;
+    }
+  }
+  return newest_tick_;
 }
 
 size_t PoseHistory::size() const {
-  return samples_.size();
+  return count_;
+}
+
+size_t PoseHistory::SlotIndex(int server_tick) const {
+  const long long capacity = static_cast<long long>(samples_.size());
+  const long long index = static_cast<long long>(server_tick) % capacity;
+  return static_cast<size_t>(index < 0 ? index + capacity : index);
 }
 
-void PoseHistory::Trim() {
-  while (samples_.size() > max_samples_) {
-    samples_.pop_front();
+const PoseSample *PoseHistory::Find(int server_tick) const {
+  if (count_ == 0 || server_tick > newest_tick_ ||
+      newest_tick_ - server_tick >= static_cast<int>(samples_.size())) {
+    return nullptr;
   }
+  const PoseSample &sample = samples_[SlotIndex(server_tick)];
+  return sample.server_tick == server_tick ? &sample : nullptr;
 }
 
 CombatState CreateCombatState() {
@@ -306,6 +413,12 @@ bool UpdateRespawn(CombatState &state, double dt) {
   return true;
 }
 
+double PlayerCollisionReach(const afps::sim::SimConfig &config, double extra_radius) {
+  const double radius = ResolveRadius(config) + (std::isfinite(extra_radius) ? std::max(0.0, extra_radius) : 0.0);
+  const double height = ResolveHeight(config);
+  return std::sqrt(radius * radius + height * height);
+}
+
 ViewAngles SanitizeViewAngles(double yaw, double pitch) {
   ViewAngles result;
   result.yaw = WrapAngle(yaw);
@@ -348,20 +461,19 @@ bool IsShieldFacing(const Vec3 &target_pos,
   return dot >= threshold;
 }
 
-HitResult ResolveHitscan(const std::string &shooter_id,
-                         const std::unordered_map<std::string, PoseHistory> &histories,
-                         int rewind_tick,
+HitResult ResolveHitscan(afps::entity::EntitySlot shooter,
+                         const std::vector<PoseHistory> &histories,
+                         double rewind_time,
                          const ViewAngles &view,
                          const afps::sim::SimConfig &config,
                          double range,
                          const afps::sim::CollisionWorld *world) {
   HitResult result;
-  const auto shooter_iter = histories.find(shooter_id);
-  if (shooter_iter == histories.end()) {
+  if (shooter >= histories.size()) {
     return result;
   }
-  afps::sim::PlayerState shooter_state;
-  if (!shooter_iter->second.SampleAtOrBefore(rewind_tick, shooter_state)) {
+  RewindPose shooter_state;
+  if (!histories[shooter].SampleAt(rewind_time, shooter_state)) {
     return result;
   }
 
@@ -375,61 +487,83 @@ HitResult ResolveHitscan(const std::string &shooter_id,
   const double max_range = (std::isfinite(range) && range > 0.0)
                                ? range
                                : std::numeric_limits<double>::infinity();
-  const afps::sim::RaycastHit world_hit = afps::sim::RaycastWorld({origin.x, origin.y, origin.z},
-                                                                   {dir.x, dir.y, dir.z},
-                                                                   config,
-                                                                   world);
-  double world_distance = std::numeric_limits<double>::infinity();
-  if (world_hit.hit && std::isfinite(world_hit.t) && world_hit.t >= 0.0) {
-    world_distance = world_hit.t;
-  }
+  const double world_distance = ResolveWorldDistance(origin, dir, config, world);
+
+  RewoundTargets targets;
+  SampleRewoundTargets(histories, rewind_time, targets);
+  const KernelRay ray{{origin.x, origin.y, origin.z}, {dir.x, dir.y, dir.z}};
+  afps::entity::EntitySlot best_target = afps::entity::kInvalidSlot;
+  const double best_t = NearestRewoundTarget(targets, shooter, ray, ResolveHeight(config), ResolveRadius(config),
+                                             max_range, best_target);
+  return MakeHitscanResult(best_target, best_t, world_distance, origin, dir);
+}
 
-  const double radius = ResolveRadius(config);
-  const double height = ResolveHeight(config);
-  double best_t = std::numeric_limits<double>::infinity();
-  std::string best_target;
-  for (const auto &entry : histories) {
-    if (entry.first == shooter_id) {
-      continue;
-    }
-    afps::sim::PlayerState target_state;
-    if (!entry.second.SampleAtOrBefore(rewind_tick, target_state)) {
-      continue;
-    }
-    const Vec3 base{target_state.x, target_state.y, target_state.z};
-    double t = 0.0;
-    if (!RaycastCylinder(origin, dir, base, height, radius, t)) {
-      continue;
-    }
-    if (t < 0.0 || t > max_range) {
-      continue;
-    }
-    if (t < best_t) {
-      best_t = t;
-      best_target = entry.first;
-    }
+void ResolveHitscanBatch(const std::vector<HitscanQuery> &queries,
+                         const std::vector<PoseHistory> &histories,
+                         const afps::sim::SimConfig &config,
+                         std::vector<HitResult> &out,
+                         const afps::sim::CollisionWorld *world) {
+  out.assign(queries.size(), HitResult{});
+  if (queries.empty()) {
+    return;
   }
-
-  if (best_target.empty()) {
-    return result;
+  // Shots in a tick mostly rewind to a few times; group them so each group samples the histories
+  // once and every ray in it shares the packed targets.
+  // Non-finite rewind times never sample a pose, so they stay misses and out of the sort.
+  std::vector<size_t> order;
+  order.reserve(queries.size());
+  for (size_t i = 0; i < queries.size(); ++i) {
+    if (std::isfinite(queries[i].rewind_time)) {
+      order.push_back(i);
+    }
   }
-  if (std::isfinite(world_distance) && world_distance >= 0.0 && best_t > world_distance) {
-    return result;
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return queries[a].rewind_time < queries[b].rewind_time;
+  });
+  const double radius = ResolveRadius(config);
+  const double height = ResolveHeight(config);
+  RewoundTargets targets;
+  for (size_t group = 0; group < order.size();) {
+    const double rewind_time = queries[order[group]].rewind_time;
+    size_t group_end = group;
+    while (group_end < order.size() && queries[order[group_end]].rewind_time == rewind_time) {
+      ++group_end;
+    }
+    SampleRewoundTargets(histories, rewind_time, targets);
+    for (size_t i = group; i < group_end; ++i) {
+      const size_t index = order[i];
+      const auto &query = queries[index];
+      const auto shooter_iter = std::lower_bound(targets.slots.begin(), targets.slots.end(), query.shooter);
+      if (shooter_iter == targets.slots.end() || *shooter_iter != query.shooter) {
+        continue;
+      }
+      const auto &shooter_state = targets.states[static_cast<size_t>(shooter_iter - targets.slots.begin())];
+      const ViewAngles safe_view = SanitizeViewAngles(query.view.yaw, query.view.pitch);
+      const Vec3 dir = ViewDirection(safe_view);
+      if (!std::isfinite(dir.x) || !std::isfinite(dir.y) || !std::isfinite(dir.z)) {
+        continue;
+      }
+      const Vec3 origin{shooter_state.x, shooter_state.y, shooter_state.z + kPlayerEyeHeight};
+      const double max_range = (std::isfinite(query.range) && query.range > 0.0)
+                                   ? query.range
+                                   : std::numeric_limits<double>::infinity();
+      const KernelRay ray{{origin.x, origin.y, origin.z}, {dir.x, dir.y, dir.z}};
+      afps::entity::EntitySlot best_target = afps::entity::kInvalidSlot;
+      const double best_t = NearestRewoundTarget(targets, query.shooter, ray, height, radius, max_range, best_target);
+      out[index] = MakeHitscanResult(best_target, best_t, ResolveWorldDistance(origin, dir, config, world),
+                                     origin, dir);
+    }
+    group = group_end;
   }
-
-  result.hit = true;
-  result.target_id = best_target;
-  result.distance = best_t;
-  result.position = {origin.x + dir.x * best_t, origin.y + dir.y * best_t, origin.z + dir.z * best_t};
-  return result;
 }
 
 ProjectileImpact ResolveProjectileImpact(
     const ProjectileState &projectile,
     const Vec3 &delta,
     const afps::sim::SimConfig &config,
-    const std::unordered_map<std::string, afps::sim::PlayerState> &players,
-    const std::string &ignore_id,
+    const std::vector<afps::sim::PlayerState> &players,
+    const std::vector<afps::entity::EntitySlot> &targets,
+    afps::entity::EntitySlot ignore,
     const afps::sim::CollisionWorld *world) {
   ProjectileImpact impact;
   if (!std::isfinite(delta.x) || !std::isfinite(delta.y) || !std::isfinite(delta.z)) {
@@ -438,17 +572,17 @@ ProjectileImpact ResolveProjectileImpact(
 
   const Vec3 origin = projectile.position;
   double best_t = std::numeric_limits<double>::infinity();
-  std::string best_target;
+  afps::entity::EntitySlot best_target = afps::entity::kInvalidSlot;
 
   const double radius = std::max(0.0, projectile.radius);
   const double player_radius = ResolveRadius(config) + radius;
   const double height = ResolveHeight(config);
 
-  for (const auto &entry : players) {
-    if (entry.first == ignore_id) {
+  for (const auto slot : targets) {
+    if (slot == ignore || slot >= players.size()) {
       continue;
     }
-    const auto &state = entry.second;
+    const auto &state = players[slot];
     const Vec3 base{state.x, state.y, state.z};
     double t = 0.0;
     if (!SegmentCylinder(origin, delta, base, height, player_radius, t)) {
@@ -459,29 +593,35 @@ ProjectileImpact ResolveProjectileImpact(
     }
     if (t < best_t) {
       best_t = t;
-      best_target = entry.first;
+      best_target = slot;
     }
   }
 
   double world_t = std::numeric_limits<double>::infinity();
   Vec3 world_normal{0.0, 0.0, 1.0};
   uint8_t world_surface_type = 0;
+  // Sweep the projectile's sphere so it stops on contact rather than when its center reaches a
+  // wall. max_t = 1 lets the collider BVH skip nodes beyond this tick's travel.
+  afps::sim::RaycastWorldOptions sweep_options;
+  sweep_options.max_t = 1.0;
+  sweep_options.sweep_radius = radius;
   const afps::sim::RaycastHit world_hit = afps::sim::RaycastWorld({origin.x, origin.y, origin.z},
                                                                    {delta.x, delta.y, delta.z},
                                                                    config,
-                                                                   world);
+                                                                   world,
+                                                                   sweep_options);
   if (world_hit.hit && std::isfinite(world_hit.t) && world_hit.t >= 0.0 && world_hit.t <= 1.0) {
     world_t = world_hit.t;
     world_normal = {world_hit.normal_x, world_hit.normal_y, world_hit.normal_z};
     world_surface_type = world_hit.surface_type;
   }
   if (!std::isfinite(world_t) && std::isfinite(delta.z) && delta.z < 0.0) {
-    if (origin.z <= 0.0) {
+    if (origin.z <= radius) {
       world_t = 0.0;
       world_normal = {0.0, 0.0, 1.0};
       world_surface_type = 2;
     } else {
-      const double t_ground = (0.0 - origin.z) / delta.z;
+      const double t_ground = (radius - origin.z) / delta.z;
       if (t_ground >= 0.0 && t_ground <= 1.0) {
         world_t = t_ground;
         world_normal = {0.0, 0.0, 1.0};
@@ -491,10 +631,10 @@ ProjectileImpact ResolveProjectileImpact(
   }
 
   bool hit_world = false;
-  if (!best_target.empty()) {
+  if (best_target != afps::entity::kInvalidSlot) {
     if (std::isfinite(world_t) && world_t <= best_t) {
       hit_world = true;
-      best_target.clear();
+      best_target = afps::entity::kInvalidSlot;
       best_t = world_t;
     }
   } else if (std::isfinite(world_t)) {
@@ -508,7 +648,7 @@ ProjectileImpact ResolveProjectileImpact(
 
   impact.hit = true;
   impact.hit_world = hit_world;
-  impact.target_id = best_target;
+  impact.target_slot = best_target;
   impact.t = best_t;
   impact.position = {origin.x + delta.x * best_t, origin.y + delta.y * best_t, origin.z + delta.z * best_t};
   if (hit_world) {
@@ -518,12 +658,25 @@ ProjectileImpact ResolveProjectileImpact(
   return impact;
 }
 
+int ProjectileSubsteps(const Vec3 &delta, double max_step, int max_substeps) {
+  if (!std::isfinite(max_step) || max_step <= 0.0 || max_substeps <= 1) {
+    return 1;
+  }
+  const double length = std::sqrt(delta.x * delta.x + delta.y * delta.y + delta.z * delta.z);
+  if (!std::isfinite(length) || length <= max_step) {
+    return 1;
+  }
+  const double steps = std::ceil(length / max_step);
+  return steps >= static_cast<double>(max_substeps) ? max_substeps : static_cast<int>(steps);
+}
+
 std::vector<ExplosionHit> ComputeExplosionDamage(
     const Vec3 &center,
     double radius,
     double max_damage,
-    const std::unordered_map<std::string, afps::sim::PlayerState> &players,
-    const std::string &ignore_id) {
+    const std::vector<afps::sim::PlayerState> &players,
+    const std::vector<afps::entity::EntitySlot> &targets,
+    afps::entity::EntitySlot ignore) {
   std::vector<ExplosionHit> hits;
   if (!std::isfinite(max_damage) || max_damage <= 0.0) {
     return hits;
@@ -532,11 +685,11 @@ std::vector<ExplosionHit> ComputeExplosionDamage(
     return hits;
   }
   const double radius_sq = radius * radius;
-  for (const auto &entry : players) {
-    if (!ignore_id.empty() && entry.first == ignore_id) {
+  for (const auto slot : targets) {
+    if (slot == ignore || slot >= players.size()) {
       continue;
     }
-    const auto &state = entry.second;
+    const auto &state = players[slot];
     const Vec3 target{state.x, state.y, state.z + (kPlayerHeight * 0.5)};
     const double dx = target.x - center.x;
     const double dy = target.y - center.y;
@@ -551,7 +704,7 @@ std::vector<ExplosionHit> ComputeExplosionDamage(
     if (!std::isfinite(damage) || damage <= 0.0) {
       continue;
     }
-    hits.push_back({entry.first, damage, dist});
+    hits.push_back({slot, damage, dist});
   }
   return hits;
 }
@@ -562,8 +715,9 @@ std::vector<ShockwaveHit> ComputeShockwaveHits(
     double max_impulse,
     double max_damage,
     const afps::sim::SimConfig &config,
-    const std::unordered_map<std::string, afps::sim::PlayerState> &players,
-    const std::string &ignore_id,
+    const std::vector<afps::sim::PlayerState> &players,
+    const std::vector<afps::entity::EntitySlot> &targets,
+    afps::entity::EntitySlot ignore,
     const afps::sim::CollisionWorld *world) {
   std::vector<ShockwaveHit> hits;
   if (!std::isfinite(radius) || radius <= 0.0) {
@@ -575,11 +729,11 @@ std::vector<ShockwaveHit> ComputeShockwaveHits(
     return hits;
   }
   const double radius_sq = radius * radius;
-  for (const auto &entry : players) {
-    if (!ignore_id.empty() && entry.first == ignore_id) {
+  for (const auto slot : targets) {
+    if (slot == ignore || slot >= players.size()) {
       continue;
     }
-    const auto &state = entry.second;
+    const auto &state = players[slot];
     const Vec3 target{state.x, state.y, state.z + (kPlayerHeight * 0.5)};
     const double dx = target.x - center.x;
     const double dy = target.y - center.y;
@@ -620,7 +774,7 @@ std::vector<ShockwaveHit> ComputeShockwaveHits(
     if (!std::isfinite(impulse.z)) {
       impulse.z = 0.0;
     }
-    hits.push_back({entry.first, impulse, std::max(0.0, damage), dist});
+    hits.push_back({slot, impulse, std::max(0.0, damage), dist});
   }
   return hits;
 }
@@ -1,12 +1,10 @@
 #pragma once
 
-#include <deque>
 #include <cstdint>
 #include <limits>
-#include <string>
-#include <unordered_map>
 #include <vector>
 
+#include "entity_registry.h"
 #include "sim/sim.h"
 
 namespace afps::combat {
@@ -22,9 +20,21 @@ struct ViewAngles {
   double pitch = 0.0;
 };
 
+// Hit-relevant slice of a player's state kept for lag compensation.
+struct RewindPose {
+  double x = 0.0;
+  double y = 0.0;
+  double z = 0.0;
+  ViewAngles view{};
+  bool crouched = false;
+  bool shield_active = false;
+};
+
+RewindPose MakeRewindPose(const afps::sim::PlayerState &state, const ViewAngles &view = {});
+
 struct PoseSample {
   int server_tick = 0;
-  afps::sim::PlayerState state{};
+  RewindPose pose{};
 };
 
 struct CombatState {
@@ -35,33 +45,41 @@ struct CombatState {
   double respawn_timer = 0.0;
 };
 
+// Fixed ring of one sample per server tick, indexed by server_tick % max_samples, so it holds
+// the samples from the last max_samples ticks and every lookup is constant time while ticks are
+// pushed without gaps. Pushing a tick older than the window is ignored.
 class PoseHistory {
 public:
   explicit PoseHistory(size_t max_samples = 0);
 
   void SetMaxSamples(size_t max_samples);
-  void Push(int server_tick, const afps::sim::PlayerState &state);
-  bool SampleAtOrBefore(int server_tick, afps::sim::PlayerState &out) const;
+  void Push(int server_tick, const afps::sim::PlayerState &state, const ViewAngles &view = {});
+  bool SampleAtOrBefore(int server_tick, RewindPose &out) const;
+  // Rewinds to a fractional tick, interpolating between the samples at floor(server_time) and the
+  // tick after it when both exist; otherwise behaves like SampleAtOrBefore(floor(server_time)).
+  bool SampleAt(double server_time, RewindPose &out) const;
   int OldestTick() const;
   size_t size() const;
 
 private:
-  void Trim();
+  size_t SlotIndex(int server_tick) const;
+  const PoseSample *Find(int server_tick) const;
 
-  size_t max_samples_ = 0;
-  std::deque<PoseSample> samples_;
+  std::vector<PoseSample> samples_;
+  size_t count_ = 0;
+  int newest_tick_ = 0;
 };
 
 struct HitResult {
   bool hit = false;
-  std::string target_id;
+  afps::entity::EntitySlot target_slot = afps::entity::kInvalidSlot;
   double distance = 0.0;
   Vec3 position{};
 };
 
 struct ProjectileState {
   int id = 0;
-  std::string owner_id;
+  afps::entity::EntityHandle owner{};
   Vec3 position{};
   Vec3 velocity{};
   double ttl = 0.0;
@@ -73,7 +91,7 @@ struct ProjectileState {
 struct ProjectileImpact {
   bool hit = false;
   bool hit_world = false;
-  std::string target_id;
+  afps::entity::EntitySlot target_slot = afps::entity::kInvalidSlot;
   double t = 1.0;
   Vec3 position{};
   Vec3 normal{0.0, 0.0, 1.0};
@@ -81,13 +99,13 @@ struct ProjectileImpact {
 };
 
 struct ExplosionHit {
-  std::string target_id;
+  afps::entity::EntitySlot target_slot = afps::entity::kInvalidSlot;
   double damage = 0.0;
   double distance = 0.0;
 };
 
 struct ShockwaveHit {
-  std::string target_id;
+  afps::entity::EntitySlot target_slot = afps::entity::kInvalidSlot;
   Vec3 impulse{};
   double damage = 0.0;
   double distance = 0.0;
@@ -109,6 +127,10 @@ bool ApplyDamageWithShield(CombatState &target,
                            double shield_multiplier);
 bool UpdateRespawn(CombatState &state, double dt);
 
+// Farthest a point of a player's collision cylinder, widened by extra_radius, lies from the player's
+// base position. Broadphase queries around base positions pad by it to stay conservative.
+double PlayerCollisionReach(const afps::sim::SimConfig &config, double extra_radius = 0.0);
+
 ViewAngles SanitizeViewAngles(double yaw, double pitch);
 Vec3 ViewDirection(const ViewAngles &angles);
 bool IsShieldFacing(const Vec3 &target_pos,
@@ -116,27 +138,53 @@ bool IsShieldFacing(const Vec3 &target_pos,
                     const Vec3 &source_pos,
                     double min_dot = kShieldBlockDot);
 
-HitResult ResolveHitscan(const std::string &shooter_id,
-                         const std::unordered_map<std::string, PoseHistory> &histories,
-                         int rewind_tick,
+// Histories and players are indexed by entity slot; empty histories are skipped. targets lists the
+// slots eligible to be hit, so callers can leave out dead players without copying state.
+HitResult ResolveHitscan(afps::entity::EntitySlot shooter,
+                         const std::vector<PoseHistory> &histories,
+                         double rewind_time,
                          const ViewAngles &view,
                          const afps::sim::SimConfig &config,
                          double range,
                          const afps::sim::CollisionWorld *world = nullptr);
 
+struct HitscanQuery {
+  afps::entity::EntitySlot shooter = afps::entity::kInvalidSlot;
+  double rewind_time = 0.0;
+  ViewAngles view{};
+  double range = 0.0;
+};
+
+// Resolves a tick's worth of shots against rewound players; out[i] equals ResolveHitscan for
+// queries[i]. Histories are sampled once per distinct rewind time and shared by every shot
+// rewound to it.
+void ResolveHitscanBatch(const std::vector<HitscanQuery> &queries,
+                         const std::vector<PoseHistory> &histories,
+                         const afps::sim::SimConfig &config,
+                         std::vector<HitResult> &out,
+                         const afps::sim::CollisionWorld *world = nullptr);
+
+// Sweeps the projectile's sphere along delta against the targets' cylinders and the world. t is
+// the fraction of delta travelled before first contact.
 ProjectileImpact ResolveProjectileImpact(const ProjectileState &projectile,
                                          const Vec3 &delta,
                                          const afps::sim::SimConfig &config,
-                                         const std::unordered_map<std::string, afps::sim::PlayerState> &players,
-                                         const std::string &ignore_id,
+                                         const std::vector<afps::sim::PlayerState> &players,
+                                         const std::vector<afps::entity::EntitySlot> &targets,
+                                         afps::entity::EntitySlot ignore,
                                          const afps::sim::CollisionWorld *world = nullptr);
 
+// Equal sub-steps that split delta into pieces no longer than max_step, clamped to
+// [1, max_substeps]. A non-positive max_step disables sub-stepping.
+int ProjectileSubsteps(const Vec3 &delta, double max_step, int max_substeps);
+
 std::vector<ExplosionHit> ComputeExplosionDamage(
     const Vec3 &center,
     double radius,
     double max_damage,
-    const std::unordered_map<std::string, afps::sim::PlayerState> &players,
-    const std::string &ignore_id);
+    const std::vector<afps::sim::PlayerState> &players,
+    const std::vector<afps::entity::EntitySlot> &targets,
+    afps::entity::EntitySlot ignore);
 
 std::vector<ShockwaveHit> ComputeShockwaveHits(
     const Vec3 &center,
@@ -144,8 +192,9 @@ std::vector<ShockwaveHit> ComputeShockwaveHits(
     double max_impulse,
     double max_damage,
     const afps::sim::SimConfig &config,
-    const std::unordered_map<std::string, afps::sim::PlayerState> &players,
-    const std::string &ignore_id,
+    const std::vector<afps::sim::PlayerState> &players,
+    const std::vector<afps::entity::EntitySlot> &targets,
+    afps::entity::EntitySlot ignore,
     const afps::sim::CollisionWorld *world = nullptr);
 
 }  // namespace afps::combat
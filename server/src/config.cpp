@@ -1,8 +1,12 @@
 #include "config.h"
 
+#include <algorithm>
+#include <cctype>
 #include <limits>
 #include <sstream>
 #include <string>
+#include <unordered_set>
+#include <utility>
 
 namespace {
 int ParsePort(const std::string &value, std::vector<std::string> &errors) {
@@ -65,10 +69,44 @@ uint32_t ParseUnsigned32(const std::string &value, const std::string &label,
     return 0;
   }
 }
+
+// id[:seed[:mode]]; seed and mode default to the --map-seed/--map-mode in effect at the end.
+bool ParseRoomSpec(const std::string &value, RoomConfig &room, bool &has_seed, bool &has_mode,
+                   std::vector<std::string> &errors) {
+  has_seed = false;
+  has_mode = false;
+  const size_t first = value.find(':');
+  room.id = value.substr(0, first);
+  if (room.id.empty()) {
+    errors.push_back("Invalid room value: " + value);
+    return false;
+  }
+  if (first == std::string::npos) {
+    return true;
+  }
+  const size_t second = value.find(':', first + 1);
+  const std::string seed = value.substr(first + 1, second == std::string::npos
+                                                       ? std::string::npos
+                                                       : second - first - 1);
+  if (!seed.empty()) {
+    bool ok = false;
+    room.map_seed = ParseUnsigned32(seed, "room map seed", errors, ok);
+    if (!ok) {
+      return false;
+    }
+    has_seed = true;
+  }
+  if (second != std::string::npos) {
+    room.map_mode = value.substr(second + 1);
+    has_mode = !room.map_mode.empty();
+  }
+  return true;
+}
 }
 
 ParseResult ParseArgs(int argc, const char *const *argv) {
   ParseResult result;
+  std::vector<std::pair<bool, bool>> room_defaults;
 
   for (int i = 1; i < argc; ++i) {
     std::string arg = argv[i];
@@ -166,6 +204,59 @@ ParseResult ParseArgs(int argc, const char *const *argv) {
       }
     } else if (arg == "--dump-map-signature") {
       result.config.dump_map_signature = true;
+    } else if (arg == "--interest-occlusion") {
+      result.config.interest_occlusion = true;
+    } else if (arg == "--rooms") {
+      auto value = require_value("--rooms");
+      if (!value.empty()) {
+        const int count = ParseNonNegativeInt(value, "rooms", result.errors);
+        if (count >= 0) {
+          result.config.room_count = count;
+        }
+      }
+    } else if (arg == "--room") {
+      auto value = require_value("--room");
+      if (!value.empty()) {
+        RoomConfig room;
+        bool has_seed = false;
+        bool has_mode = false;
+        if (ParseRoomSpec(value, room, has_seed, has_mode, result.errors)) {
+          result.config.rooms.push_back(std::move(room));
+          room_defaults.emplace_back(has_seed, has_mode);
+        }
+      }
+    } else if (arg == "--room-capacity") {
+      auto value = require_value("--room-capacity");
+      if (!value.empty()) {
+        const int capacity = ParseNonNegativeInt(value, "room capacity", result.errors);
+        if (capacity >= 0) {
+          result.config.room_capacity = capacity;
+        }
+      }
+    } else if (arg == "--tick-workers") {
+      auto value = require_value("--tick-workers");
+      if (!value.empty()) {
+        const int workers = ParseNonNegativeInt(value, "tick workers", result.errors);
+        if (workers >= 0) {
+          result.config.tick_workers = workers;
+        }
+      }
+    } else if (arg == "--movement-workers") {
+      auto value = require_value("--movement-workers");
+      if (!value.empty()) {
+        const int workers = ParseNonNegativeInt(value, "movement workers", result.errors);
+        if (workers >= 0) {
+          result.config.movement_workers = workers;
+        }
+      }
+    } else if (arg == "--send-workers") {
+      auto value = require_value("--send-workers");
+      if (!value.empty()) {
+        const int workers = ParseNonNegativeInt(value, "send workers", result.errors);
+        if (workers >= 0) {
+          result.config.send_workers = workers;
+        }
+      }
     } else if (arg == "--character-manifest") {
       auto value = require_value("--character-manifest");
       if (!value.empty()) {
@@ -176,6 +267,16 @@ ParseResult ParseArgs(int argc, const char *const *argv) {
     }
   }
 
+  for (size_t i = 0; i < result.config.rooms.size(); ++i) {
+    RoomConfig &room = result.config.rooms[i];
+    if (!room_defaults[i].first) {
+      room.map_seed = result.config.map_seed;
+    }
+    if (!room_defaults[i].second) {
+      room.map_mode = result.config.map_mode;
+    }
+  }
+
   return result;
 }
 
@@ -193,8 +294,9 @@ std::vector<std::string> ValidateConfig(const ServerConfig &config) {
   if (runtime_mode && config.auth_token.empty()) {
     errors.push_back("Missing --auth-token value");
   }
-  if (config.snapshot_keyframe_interval < 0) {
-    errors.push_back("Snapshot keyframe interval must be >= 0");
+  // ServerHello carries the interval as a ushort.
+  if (config.snapshot_keyframe_interval < 0 || config.snapshot_keyframe_interval > 65535) {
+    errors.push_back("Snapshot keyframe interval must be between 0 and 65535");
   }
   if (!config.turn_secret.empty() && config.turn_ttl_seconds <= 0) {
     errors.push_back("TURN TTL must be > 0 when --turn-secret is set");
@@ -205,5 +307,55 @@ std::vector<std::string> ValidateConfig(const ServerConfig &config) {
   if (config.map_mode == "static" && config.map_manifest_path.empty()) {
     errors.push_back("Static map mode requires --map-manifest <path>");
   }
+  if (config.rooms.empty() && config.room_count < 1) {
+    errors.push_back("Rooms must be >= 1");
+  }
+  if (config.room_capacity < 0) {
+    errors.push_back("Room capacity must be >= 0");
+  }
+  if (config.tick_workers < 0) {
+    errors.push_back("Tick workers must be >= 0");
+  }
+  if (config.movement_workers < 0) {
+    errors.push_back("Movement workers must be >= 0");
+  }
+  if (config.send_workers < 0) {
+    errors.push_back("Send workers must be >= 0");
+  }
+  std::unordered_set<std::string> room_ids;
+  for (const auto &room : config.rooms) {
+    const bool valid_id = std::all_of(room.id.begin(), room.id.end(), [](unsigned char ch) {
+      return std::isalnum(ch) != 0 || ch == '-' || ch == '_';
+    });
+    if (!valid_id) {
+      errors.push_back("Room id may only contain letters, digits, '-' and '_': " + room.id);
+    }
+    if (!room_ids.insert(room.id).second) {
+      errors.push_back("Duplicate room id: " + room.id);
+    }
+    if (!(room.map_mode == "legacy" || room.map_mode == "static")) {
+      errors.push_back("Room " + room.id + " map mode must be one of: legacy, static");
+    } else if (room.map_mode == "static" && config.map_mode != "static" &&
+               config.map_manifest_path.empty()) {
+      errors.push_back("Room " + room.id + " static map mode requires --map-manifest <path>");
+    }
+  }
   return errors;
 }
+
+std::vector<RoomConfig> ResolveRooms(const ServerConfig &config) {
+  if (!config.rooms.empty()) {
+    return config.rooms;
+  }
+  std::vector<RoomConfig> rooms;
+  const int count = config.room_count < 1 ? 1 : config.room_count;
+  rooms.reserve(static_cast<size_t>(count));
+  for (int i = 0; i < count; ++i) {
+    RoomConfig room;
+    room.id = "room-" + std::to_string(i);
+    room.map_seed = config.map_seed + static_cast<uint32_t>(i);
+    room.map_mode = config.map_mode;
+    rooms.push_back(std::move(room));
+  }
+  return rooms;
+}
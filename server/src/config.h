@@ -6,6 +6,12 @@
 
 #include "protocol.h"
 
+struct RoomConfig {
+  std::string id;
+  uint32_t map_seed = 0;
+  std::string map_mode = "legacy";
+};
+
 struct ServerConfig {
   std::string host = "0.0.0.0";
   int port = 8443;
@@ -21,6 +27,13 @@ struct ServerConfig {
   std::string map_mode = "legacy";
   std::string map_manifest_path;
   bool dump_map_signature = false;
+  bool interest_occlusion = false;
+  int room_count = 1;
+  std::vector<RoomConfig> rooms;
+  int room_capacity = 0;
+  int tick_workers = 0;
+  int movement_workers = 0;
+  int send_workers = 0;
   std::string character_manifest_path;
   bool use_https = true;
   bool show_help = false;
@@ -33,3 +46,5 @@ struct ParseResult {
 
 ParseResult ParseArgs(int argc, const char *const *argv);
 std::vector<std::string> ValidateConfig(const ServerConfig &config);
+// Explicit --room entries win; otherwise --rooms N rooms seeded map_seed, map_seed + 1, ...
+std::vector<RoomConfig> ResolveRooms(const ServerConfig &config);
@@ -0,0 +1,101 @@
+#include "entity_registry.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace afps::entity {
+
+namespace {
+const std::string kEmptyId;
+}
+
+EntityHandle EntityRegistry::Acquire(const std::string &id) {
+  if (id.empty()) {
+    return {};
+  }
+  auto iter = lookup_.find(id);
+  if (iter != lookup_.end()) {
+    return HandleOf(iter->second);
+  }
+  EntitySlot slot = kInvalidSlot;
+  if (!free_slots_.empty()) {
+    std::pop_heap(free_slots_.begin(), free_slots_.end(), std::greater<EntitySlot>());
+    slot = free_slots_.back();
+    free_slots_.pop_back();
+  } else if (ids_.size() < kMaxEntities) {
+    slot = static_cast<EntitySlot>(ids_.size());
+    ids_.emplace_back();
+    generations_.push_back(0);
+    live_.push_back(0);
+  } else {
+    return {};
+  }
+  ids_[slot] = id;
+  live_[slot] = 1;
+  lookup_.emplace(id, slot);
+  size_ += 1;
+  return HandleOf(slot);
+}
+
+bool EntityRegistry::Release(EntitySlot slot) {
+  if (!IsLive(slot)) {
+    return false;
+  }
+  lookup_.erase(ids_[slot]);
+  ids_[slot].clear();
+  live_[slot] = 0;
+  generations_[slot] = static_cast<uint16_t>(generations_[slot] + 1);
+  free_slots_.push_back(slot);
+  std::push_heap(free_slots_.begin(), free_slots_.end(), std::greater<EntitySlot>());
+  size_ -= 1;
+  return true;
+}
+
+void EntityRegistry::RetainOnly(const std::vector<EntitySlot> &keep, std::vector<EntitySlot> &released) {
+  retain_marks_.assign(ids_.size(), 0);
+  for (const EntitySlot slot : keep) {
+    if (slot < retain_marks_.size()) {
+      retain_marks_[slot] = 1;
+    }
+  }
+  for (size_t slot = 0; slot < ids_.size(); ++slot) {
+    if (live_[slot] && !retain_marks_[slot]) {
+      Release(static_cast<EntitySlot>(slot));
+      released.push_back(static_cast<EntitySlot>(slot));
+    }
+  }
+}
+
+EntitySlot EntityRegistry::Find(const std::string &id) const {
+  auto iter = lookup_.find(id);
+  return iter == lookup_.end() ? kInvalidSlot : iter->second;
+}
+
+EntityHandle EntityRegistry::HandleOf(EntitySlot slot) const {
+  if (!IsLive(slot)) {
+    return {};
+  }
+  return {slot, generations_[slot]};
+}
+
+bool EntityRegistry::IsLive(EntitySlot slot) const {
+  return slot < live_.size() && live_[slot] != 0;
+}
+
+bool EntityRegistry::IsCurrent(const EntityHandle &handle) const {
+  return IsLive(handle.slot) && generations_[handle.slot] == handle.generation;
+}
+
+const std::string &EntityRegistry::IdOf(EntitySlot slot) const {
+  return IsLive(slot) ? ids_[slot] : kEmptyId;
+}
+
+size_t EntityRegistry::capacity() const {
+  return ids_.size();
+}
+
+size_t EntityRegistry::size() const {
+  return size_;
+}
+
+}  // namespace afps::entity
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace afps::entity {
+
+using EntitySlot = uint16_t;
+
+constexpr EntitySlot kInvalidSlot = 0xFFFF;
+constexpr size_t kMaxEntities = kInvalidSlot;
+
+// A slot plus the generation it was issued under; stale once the slot is released.
+struct EntityHandle {
+  EntitySlot slot = kInvalidSlot;
+  uint16_t generation = 0;
+};
+
+// Maps connection ids to dense slots so per-player state can live in arrays indexed by slot.
+// Released slots are reused lowest first to keep those arrays compact.
+class EntityRegistry {
+public:
+  // Returns the existing handle for id, or assigns a slot. Invalid when id is empty or slots ran out.
+  EntityHandle Acquire(const std::string &id);
+  bool Release(EntitySlot slot);
+  // Releases every live slot not listed in keep, appending them to released.
+  void RetainOnly(const std::vector<EntitySlot> &keep, std::vector<EntitySlot> &released);
+
+  EntitySlot Find(const std::string &id) const;
+  EntityHandle HandleOf(EntitySlot slot) const;
+  bool IsLive(EntitySlot slot) const;
+  bool IsCurrent(const EntityHandle &handle) const;
+  const std::string &IdOf(EntitySlot slot) const;
+
+  // Number of slots ever issued; arrays indexed by slot must be at least this long.
+  size_t capacity() const;
+  size_t size() const;
+
+private:
+  std::vector<std::string> ids_;
+  std::vector<uint16_t> generations_;
+  std::vector<uint8_t> live_;
+  std::vector<EntitySlot> free_slots_;
+  std::unordered_map<std::string, EntitySlot> lookup_;
+  size_t size_ = 0;
+  // RetainOnly() scratch, kept so the per-tick call does not allocate.
+  std::vector<uint8_t> retain_marks_;
+};
+
+}  // namespace afps::entity
@@ -0,0 +1,102 @@
+#include "input_buffer.h"
+
+#include <algorithm>
+#include <limits>
+
+InputJitterBuffer::InputJitterBuffer(InputJitterConfig config) : config_(config) {
+  config_.capacity = std::max<size_t>(1, config_.capacity);
+  config_.min_delay_ticks = std::max(0, config_.min_delay_ticks);
+  config_.max_delay_ticks = std::max(config_.min_delay_ticks, config_.max_delay_ticks);
+  config_.max_steps_per_tick = std::max(1, config_.max_steps_per_tick);
+  config_.shrink_after_ticks = std::max(1, config_.shrink_after_ticks);
+  queue_.reserve(config_.capacity + 1);
+  Reset();
+}
+
+bool InputJitterBuffer::Push(const InputCmd &cmd) {
+  stats_.received += 1;
+  if (cmd.input_seq <= last_played_seq_) {
+    stats_.late_drops += 1;
+    return false;
+  }
+  auto it = std::lower_bound(queue_.begin(), queue_.end(), cmd.input_seq,
+                             [](const InputCmd &queued, int seq) { return queued.input_seq < seq; });
+  if (it != queue_.end() && it->input_seq == cmd.input_seq) {
+    stats_.late_drops += 1;
+    return false;
+  }
+  queue_.insert(it, cmd);
+  if (queue_.size() > config_.capacity) {
+    queue_.erase(queue_.begin());
+    stats_.overflow_drops += 1;
+  }
+  return true;
+}
+
+size_t InputJitterBuffer::Take(std::vector<InputCmd> &out) {
+  const size_t target = static_cast<size_t>(target_delay_);
+  if (!started_ && queue_.size() <= target) {
+    return 0;
+  }
+  if (queue_.empty()) {
+    stats_.underruns += 1;
+    target_delay_ = std::min(config_.max_delay_ticks, target_delay_ + 1);
+    ResetWindow();
+    return 0;
+  }
+
+  size_t steps = 1;
+  while (steps < static_cast<size_t>(config_.max_steps_per_tick) && queue_.size() - steps > target) {
+    steps += 1;
+  }
+  out.insert(out.end(), queue_.begin(), queue_.begin() + static_cast<long>(steps));
+  queue_.erase(queue_.begin(), queue_.begin() + static_cast<long>(steps));
+  last_played_seq_ = out.back().input_seq;
+  started_ = true;
+  stats_.played += steps;
+  stats_.catch_up_steps += steps - 1;
+
+  window_min_depth_ = std::min(window_min_depth_, queue_.size());
+  window_ticks_ += 1;
+  if (window_ticks_ >= config_.shrink_after_ticks) {
+    if (window_min_depth_ > 0 && target_delay_ > config_.min_delay_ticks) {
+      target_delay_ -= 1;
+    }
+    ResetWindow();
+  }
+  return steps;
+}
+
+void InputJitterBuffer::Reset() {
+  queue_.clear();
+  target_delay_ = std::clamp(config_.initial_delay_ticks, config_.min_delay_ticks, config_.max_delay_ticks);
+  last_played_seq_ = -1;
+  started_ = false;
+  stats_ = InputJitterStats{};
+  ResetWindow();
+}
+
+size_t InputJitterBuffer::depth() const {
+  return queue_.size();
+}
+
+int InputJitterBuffer::target_delay() const {
+  return target_delay_;
+}
+
+int InputJitterBuffer::last_played_seq() const {
+  return last_played_seq_;
+}
+
+bool InputJitterBuffer::started() const {
+  return started_;
+}
+
+const InputJitterStats &InputJitterBuffer::stats() const {
+  return stats_;
+}
+
+void InputJitterBuffer::ResetWindow() {
+  window_ticks_ = 0;
+  window_min_depth_ = std::numeric_limits<size_t>::max();
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "protocol.h"
+
+struct InputJitterConfig {
+  // Commands held per player; the oldest is dropped when a burst overflows it.
+  size_t capacity = 32;
+  int min_delay_ticks = 0;
+  int initial_delay_ticks = 1;
+  int max_delay_ticks = 8;
+  // Most commands simulated in one tick while draining a backlog.
+  int max_steps_per_tick = 3;
+  // Ticks with no underrun and a cushion that never ran dry before the delay shrinks by one.
+  int shrink_after_ticks = 120;
+};
+
+struct InputJitterStats {
+  uint64_t received = 0;
+  uint64_t played = 0;
+  uint64_t underruns = 0;
+  // Duplicates, and commands at or before the last one played.
+  uint64_t late_drops = 0;
+  uint64_t overflow_drops = 0;
+  // Commands played beyond the first in a tick.
+  uint64_t catch_up_steps = 0;
+};
+
+// One player's inputs ordered by input_seq and played out one per server tick behind an adaptive
+// delay. The buffer keeps target_delay() commands in reserve so a late packet does not stall the
+// player: an underrun grows the delay, and a long run with the reserve never touched shrinks it.
+// Backlogs above the delay are worked off a few extra commands per tick.
+class InputJitterBuffer {
+public:
+  explicit InputJitterBuffer(InputJitterConfig config = {});
+
+  // Returns false for duplicates, commands already played past, and nothing else.
+  bool Push(const InputCmd &cmd);
+  // Appends this tick's commands to out in input_seq order and returns how many. Zero means the
+  // buffer is still filling its first delay or underran; callers repeat the previous command.
+  size_t Take(std::vector<InputCmd> &out);
+  void Reset();
+
+  size_t depth() const;
+  int target_delay() const;
+  int last_played_seq() const;
+  // True once any command has been played; underruns only count after that.
+  bool started() const;
+  const InputJitterStats &stats() const;
+
+private:
+  void ResetWindow();
+
+  InputJitterConfig config_;
+  // Sorted by input_seq.
+  std::vector<InputCmd> queue_;
+  int target_delay_ = 0;
+  int last_played_seq_ = -1;
+  bool started_ = false;
+  int window_ticks_ = 0;
+  size_t window_min_depth_ = 0;
+  InputJitterStats stats_;
+};
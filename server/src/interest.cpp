@@ -0,0 +1,148 @@
+#include "interest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace afps::interest {
+
+SpatialGrid::SpatialGrid(double cell_size)
+    : cell_size_((std::isfinite(cell_size) && cell_size > 0.0) ? cell_size : kCellSizeMeters) {}
+
+void SpatialGrid::Clear() {
+  for (auto &cell : cells_) {
+    cell.second.clear();
+  }
+  count_ = 0;
+}
+
+void SpatialGrid::Insert(size_t index, const afps::sim::Vec3 &position) {
+  if (!std::isfinite(position.x) || !std::isfinite(position.y) || !std::isfinite(position.z)) {
+    return;
+  }
+  cells_[CellKey(CellCoord(position.x), CellCoord(position.y))].push_back({index, position});
+  count_ += 1;
+}
+
+void SpatialGrid::Query(const afps::sim::Vec3 &center, double radius, std::vector<size_t> &out) const {
+  if (!std::isfinite(radius) || radius < 0.0 || !std::isfinite(center.x) || !std::isfinite(center.y) ||
+      !std::isfinite(center.z)) {
+    return;
+  }
+  const double radius_sq = radius * radius;
+  const int min_x = CellCoord(center.x - radius);
+  const int max_x = CellCoord(center.x + radius);
+  const int min_y = CellCoord(center.y - radius);
+  const int max_y = CellCoord(center.y + radius);
+  for (int cell_x = min_x; cell_x <= max_x; ++cell_x) {
+    for (int cell_y = min_y; cell_y <= max_y; ++cell_y) {
+      auto iter = cells_.find(CellKey(cell_x, cell_y));
+      if (iter == cells_.end()) {
+        continue;
+      }
+      for (const auto &entry : iter->second) {
+        const double dx = entry.position.x - center.x;
+        const double dy = entry.position.y - center.y;
+        const double dz = entry.position.z - center.z;
+        if (dx * dx + dy * dy + dz * dz <= radius_sq) {
+          out.push_back(entry.index);
+        }
+      }
+    }
+  }
+}
+
+void SpatialGrid::QuerySegment(const afps::sim::Vec3 &start,
+                               const afps::sim::Vec3 &end,
+                               double radius,
+                               std::vector<size_t> &out) const {
+  if (!std::isfinite(radius) || radius < 0.0 || !std::isfinite(start.x) || !std::isfinite(start.y) ||
+      !std::isfinite(start.z) || !std::isfinite(end.x) || !std::isfinite(end.y) || !std::isfinite(end.z)) {
+    return;
+  }
+  const double radius_sq = radius * radius;
+  const double dir_x = end.x - start.x;
+  const double dir_y = end.y - start.y;
+  const double dir_z = end.z - start.z;
+  const double length_sq = dir_x * dir_x + dir_y * dir_y + dir_z * dir_z;
+  const int min_y = CellCoord(std::min(start.y, end.y) - radius);
+  const int max_y = CellCoord(std::max(start.y, end.y) + radius);
+  for (int cell_y = min_y; cell_y <= max_y; ++cell_y) {
+    // Clip the segment to this row's band grown by radius; only its X span (also grown) can hold matches.
+    double t_min = 0.0;
+    double t_max = 1.0;
+    if (dir_y != 0.0) {
+      const double band_lo = static_cast<double>(cell_y) * cell_size_ - radius;
+      const double band_hi = static_cast<double>(cell_y + 1) * cell_size_ + radius;
+      const double t_lo = (band_lo - start.y) / dir_y;
+      const double t_hi = (band_hi - start.y) / dir_y;
+      t_min = std::max(t_min, std::min(t_lo, t_hi));
+      t_max = std::min(t_max, std::max(t_lo, t_hi));
+      if (t_min > t_max) {
+        continue;
+      }
+    }
+    const double x_a = start.x + dir_x * t_min;
+    const double x_b = start.x + dir_x * t_max;
+    const int min_x = CellCoord(std::min(x_a, x_b) - radius);
+    const int max_x = CellCoord(std::max(x_a, x_b) + radius);
+    for (int cell_x = min_x; cell_x <= max_x; ++cell_x) {
+      auto iter = cells_.find(CellKey(cell_x, cell_y));
+      if (iter == cells_.end()) {
+        continue;
+      }
+      for (const auto &entry : iter->second) {
+        const double rel_x = entry.position.x - start.x;
+        const double rel_y = entry.position.y - start.y;
+        const double rel_z = entry.position.z - start.z;
+        double t = 0.0;
+        if (length_sq > 0.0) {
+          t = std::max(0.0, std::min(1.0, (rel_x * dir_x + rel_y * dir_y + rel_z * dir_z) / length_sq));
+        }
+        const double dx = rel_x - dir_x * t;
+        const double dy = rel_y - dir_y * t;
+        const double dz = rel_z - dir_z * t;
+        if (dx * dx + dy * dy + dz * dz <= radius_sq) {
+          out.push_back(entry.index);
+        }
+      }
+    }
+  }
+}
+
+size_t SpatialGrid::size() const {
+  return count_;
+}
+
+int SpatialGrid::CellCoord(double value) const {
+  const double cell = std::floor(value / cell_size_);
+  const double limit = static_cast<double>(std::numeric_limits<int>::max() / 2);
+  if (cell > limit) {
+    return static_cast<int>(limit);
+  }
+  if (cell < -limit) {
+    return static_cast<int>(-limit);
+  }
+  return static_cast<int>(cell);
+}
+
+int64_t SpatialGrid::CellKey(int cell_x, int cell_y) {
+  return (static_cast<int64_t>(cell_x) << 32) ^ static_cast<int64_t>(static_cast<uint32_t>(cell_y));
+}
+
+bool ShouldSendFarSnapshot(int snapshot_index, uint32_t subject_hash, int divisor) {
+  if (divisor <= 1) {
+    return true;
+  }
+  const uint32_t phase = static_cast<uint32_t>(snapshot_index) + subject_hash;
+  return (phase % static_cast<uint32_t>(divisor)) == 0;
+}
+
+bool IsLineOfSightBlocked(const afps::sim::CollisionWorld &world,
+                          const afps::sim::Vec3 &from,
+                          const afps::sim::Vec3 &to) {
+  const afps::sim::Vec3 dir{to.x - from.x, to.y - from.y, to.z - from.z};
+  return afps::sim::RayHitsAnyCollider(world, from, dir, 0.0, 1.0);
+}
+
+}  // namespace afps::interest
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "sim/sim.h"
+
+namespace afps::interest {
+
+constexpr double kCellSizeMeters = 16.0;
+constexpr double kNearRadiusMeters = 32.0;
+constexpr double kFxAudibleRadiusMeters = 60.0;
+// Occluded players closer than this keep the full rate so they do not pop in around corners.
+constexpr double kOcclusionMinDistanceMeters = 8.0;
+constexpr int kFarSnapshotDivisor = 4;
+
+// Uniform XY grid over player positions; entries are caller-owned indices.
+class SpatialGrid {
+public:
+  explicit SpatialGrid(double cell_size = kCellSizeMeters);
+
+  void Clear();
+  void Insert(size_t index, const afps::sim::Vec3 &position);
+  // Appends entries within radius of center (3D distance), in insertion order per cell.
+  void Query(const afps::sim::Vec3 &center, double radius, std::vector<size_t> &out) const;
+  // Appends entries within radius of the segment from start to end (3D distance), visiting only the cells
+  // the padded segment crosses. Each entry is reported once.
+  void QuerySegment(const afps::sim::Vec3 &start,
+                    const afps::sim::Vec3 &end,
+                    double radius,
+                    std::vector<size_t> &out) const;
+  size_t size() const;
+
+private:
+  struct Entry {
+    size_t index = 0;
+    afps::sim::Vec3 position{};
+  };
+
+  int CellCoord(double value) const;
+  static int64_t CellKey(int cell_x, int cell_y);
+
+  double cell_size_ = kCellSizeMeters;
+  size_t count_ = 0;
+  std::unordered_map<int64_t, std::vector<Entry>> cells_;
+};
+
+// Far subjects are sent on one snapshot in every divisor, staggered by subject so each tick carries a
+// similar share.
+bool ShouldSendFarSnapshot(int snapshot_index, uint32_t subject_hash, int divisor);
+bool IsLineOfSightBlocked(const afps::sim::CollisionWorld &world,
+                          const afps::sim::Vec3 &from,
+                          const afps::sim::Vec3 &to);
+
+}  // namespace afps::interest
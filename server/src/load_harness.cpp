@@ -0,0 +1,512 @@
+#include "load_harness.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "combat.h"
+#include "outbound_queue.h"
+#include "signaling.h"
+#include "tick.h"
+#include "weapons/weapon_defs.h"
+
+namespace {
+// Scripted clients connected straight to the tick. Every client is ready from the first tick and
+// sends one input per tick, like a browser client running at the server tick rate.
+class ScriptedTransport final : public TickTransport {
+public:
+  struct Counters {
+    uint64_t inputs = 0;
+    uint64_t fire_requests = 0;
+    uint64_t reliable_messages = 0;
+    uint64_t unreliable_messages = 0;
+    uint64_t reliable_bundles = 0;
+    uint64_t unreliable_bundles = 0;
+    uint64_t bytes_sent = 0;
+  };
+
+  ScriptedTransport(int clients, unsigned int seed, double fire_rate, int tick_rate)
+      : rng_(seed), fire_chance_(std::clamp(fire_rate / std::max(1, tick_rate), 0.0, 1.0)) {
+    const auto weapons = afps::weapons::BuildDefaultWeaponConfig();
+    std::uniform_real_distribution<double> phase(0.0, 6.283185307179586);
+    clients_.resize(static_cast<size_t>(clients));
+    ids_.reserve(clients_.size());
+    for (size_t i = 0; i < clients_.size(); ++i) {
+      auto &client = clients_[i];
+      client.id = "bot-" + std::to_string(i);
+      client.phase = phase(rng_);
+      client.weapon_slot = weapons.slots.empty() ? 0 : static_cast<int>(i % weapons.slots.size());
+      const auto *weapon = afps::weapons::ResolveWeaponSlot(weapons, client.weapon_slot);
+      client.weapon_id = weapon ? weapon->id : std::string();
+      index_by_id_[client.id] = i;
+      ids_.push_back(client.id);
+    }
+  }
+
+  // Queues what every client sends before the given tick runs.
+  void QueueTick(int tick, int tick_rate) {
+    const double t = static_cast<double>(tick) / std::max(1, tick_rate);
+    const int rate = std::max(1, tick_rate);
+    pending_.clear();
+    pending_.reserve(clients_.size());
+    for (size_t i = 0; i < clients_.size(); ++i) {
+      auto &client = clients_[i];
+      const int offset = static_cast<int>(i) * 7;
+      CommandBatch batch;
+      batch.connection_id = client.id;
+
+      // Clients ack the newest server message they have seen, which is everything sent last tick.
+      // Nothing is lost in the harness, so every earlier message is marked received as well.
+      if (client.next_server_msg_seq != client.acked_server_seq) {
+        client.acked_server_seq = client.next_server_msg_seq;
+        batch.seq_acks.push_back({client.acked_server_seq, ~0u});
+      }
+
+      InputCmd input;
+      input.input_seq = ++client.input_seq;
+      input.move_x = std::cos(client.phase + t * 0.7);
+      input.move_y = std::sin(client.phase + t * 0.9);
+      input.view_yaw = client.phase + 0.8 * std::sin(t * 0.5 + client.phase);
+      input.view_pitch = 0.15 * std::sin(t * 0.3 + client.phase);
+      input.weapon_slot = client.weapon_slot;
+      input.sprint = ((tick + offset) % (rate * 3)) < rate * 2;
+      input.jump = ((tick + offset) % (rate * 3 / 2 + 1)) == 0;
+      input.dash = ((tick + offset) % (rate * 4)) == rate;
+      input.crouch = ((tick + offset) % (rate * 5)) < rate / 2;
+      input.grapple = ((tick + offset) % (rate * 7)) < rate;
+      input.shield = ((tick + offset) % (rate * 11)) < rate / 2;
+      input.shockwave = ((tick + offset) % (rate * 9)) == 0;
+      input.ads = ((tick + offset) % (rate * 2)) < rate;
+      input.fire = fire_roll_(rng_) < fire_chance_;
+      batch.inputs.push_back(input);
+      client.last_client_msg_seq += 1;
+      counters_.inputs += 1;
+
+      if (input.fire) {
+        const auto dir = afps::combat::ViewDirection({input.view_yaw, input.view_pitch});
+        FireWeaponRequest request;
+        request.client_shot_seq = ++client.shot_seq;
+        request.weapon_id = client.weapon_id;
+        request.weapon_slot = client.weapon_slot;
+        request.dir_x = dir.x;
+        request.dir_y = dir.y;
+        request.dir_z = dir.z;
+        batch.fire_requests.push_back(std::move(request));
+        client.last_client_msg_seq += 1;
+        counters_.fire_requests += 1;
+      }
+      pending_.push_back(std::move(batch));
+    }
+  }
+
+  std::vector<CommandBatch> DrainAllCommands(const std::string &) override {
+    std::vector<CommandBatch> drained;
+    drained.swap(pending_);
+    return drained;
+  }
+
+  std::vector<std::string> ReadyConnectionIds(const std::string &) override {
+    return ids_;
+  }
+
+  bool SendReliable(const std::string &connection_id, const std::vector<uint8_t> &message) override {
+    Client *client = Find(connection_id);
+    if (!client) {
+      return false;
+    }
+    client->outbound_reliable.Push(message);
+    counters_.reliable_messages += 1;
+    counters_.bytes_sent += message.size();
+    return true;
+  }
+
+  bool SendUnreliable(const std::string &connection_id, const std::vector<uint8_t> &message) override {
+    Client *client = Find(connection_id);
+    if (!client) {
+      return false;
+    }
+    client->outbound_unreliable.Push(message);
+    counters_.unreliable_messages += 1;
+    counters_.bytes_sent += message.size();
+    return true;
+  }
+
+  uint32_t NextServerMessageSeq(const std::string &connection_id) override {
+    Client *client = Find(connection_id);
+    return client ? ++client->next_server_msg_seq : 0;
+  }
+
+  uint32_t LastClientMessageSeq(const std::string &connection_id) override {
+    const Client *client = Find(connection_id);
+    return client ? client->last_client_msg_seq : 0;
+  }
+
+  size_t ConnectionCount() const override {
+    return clients_.size();
+  }
+
+  // Bundles the same way SignalingStore does, so bundle counts match what a peer would send.
+  size_t FlushOutbound(const std::string &) override {
+    auto accept = [](const uint8_t *, size_t) { return true; };
+    size_t bundles = 0;
+    for (auto &client : clients_) {
+      const size_t reliable = client.outbound_reliable.Flush(kMaxClientMessageBytes, accept);
+      const size_t unreliable = client.outbound_unreliable.Flush(kMaxSnapshotPacketBytes, accept);
+      counters_.reliable_bundles += reliable;
+      counters_.unreliable_bundles += unreliable;
+      bundles += reliable + unreliable;
+    }
+    return bundles;
+  }
+
+  const Counters &counters() const {
+    return counters_;
+  }
+
+private:
+  struct Client {
+    std::string id;
+    double phase = 0.0;
+    int input_seq = 0;
+    int shot_seq = 0;
+    int weapon_slot = 0;
+    std::string weapon_id;
+    uint32_t last_client_msg_seq = 0;
+    uint32_t next_server_msg_seq = 0;
+    uint32_t acked_server_seq = 0;
+    OutboundQueue outbound_reliable;
+    OutboundQueue outbound_unreliable;
+  };
+
+  Client *Find(const std::string &connection_id) {
+    const auto it = index_by_id_.find(connection_id);
+    return it == index_by_id_.end() ? nullptr : &clients_[it->second];
+  }
+
+  std::mt19937 rng_;
+  std::uniform_real_distribution<double> fire_roll_{0.0, 1.0};
+  double fire_chance_ = 0.0;
+  std::vector<Client> clients_;
+  std::vector<std::string> ids_;
+  std::unordered_map<std::string, size_t> index_by_id_;
+  std::vector<CommandBatch> pending_;
+  Counters counters_;
+};
+
+// Swallows the tick's per-second stdout logs during a run; formatting them still counts.
+class NullBuffer : public std::streambuf {
+protected:
+  int overflow(int c) override {
+    return traits_type::not_eof(c);
+  }
+  std::streamsize xsputn(const char *, std::streamsize count) override {
+    return count;
+  }
+};
+
+class ScopedStdoutSilence {
+public:
+  ScopedStdoutSilence() : previous_(std::cout.rdbuf(&buffer_)) {}
+  ~ScopedStdoutSilence() {
+    std::cout.rdbuf(previous_);
+  }
+  ScopedStdoutSilence(const ScopedStdoutSilence &) = delete;
+  ScopedStdoutSilence &operator=(const ScopedStdoutSilence &) = delete;
+
+private:
+  NullBuffer buffer_;
+  std::streambuf *previous_ = nullptr;
+};
+
+bool ParseInt(const std::string &value, const std::string &label, int min_value, int &out, std::string &error) {
+  try {
+    size_t idx = 0;
+    const int parsed = std::stoi(value, &idx);
+    if (idx != value.size()) {
+      error = "Invalid " + label + " value: " + value;
+      return false;
+    }
+    if (parsed < min_value) {
+      error = label + " must be >= " + std::to_string(min_value);
+      return false;
+    }
+    out = parsed;
+    return true;
+  } catch (const std::exception &) {
+    error = "Invalid " + label + " value: " + value;
+    return false;
+  }
+}
+
+bool ParseUnsigned32(const std::string &value, const std::string &label, uint32_t &out, std::string &error) {
+  try {
+    size_t idx = 0;
+    const unsigned long long parsed = std::stoull(value, &idx);
+    if (idx != value.size() || value.find('-') != std::string::npos) {
+      error = "Invalid " + label + " value: " + value;
+      return false;
+    }
+    if (parsed > std::numeric_limits<uint32_t>::max()) {
+      error = label + " out of range: " + value;
+      return false;
+    }
+    out = static_cast<uint32_t>(parsed);
+    return true;
+  } catch (const std::exception &) {
+    error = "Invalid " + label + " value: " + value;
+    return false;
+  }
+}
+
+bool ParseRate(const std::string &value, const std::string &label, double &out, std::string &error) {
+  try {
+    size_t idx = 0;
+    const double parsed = std::stod(value, &idx);
+    if (idx != value.size() || !std::isfinite(parsed) || parsed < 0.0) {
+      error = "Invalid " + label + " value: " + value;
+      return false;
+    }
+    out = parsed;
+    return true;
+  } catch (const std::exception &) {
+    error = "Invalid " + label + " value: " + value;
+    return false;
+  }
+}
+
+double Percentile(const std::vector<double> &sorted, double fraction) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  const double rank = std::ceil(fraction * static_cast<double>(sorted.size()));
+  const size_t index = static_cast<size_t>(std::max(1.0, rank)) - 1;
+  return sorted[std::min(index, sorted.size() - 1)];
+}
+}  // namespace
+
+bool ParseLoadHarnessArgs(int argc, const char *const *argv, LoadHarnessOptions &options, std::string &error) {
+  std::string map_manifest_path;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    auto require_value = [&](std::string &value) {
+      if (i + 1 >= argc) {
+        error = "Missing value for " + arg;
+        return false;
+      }
+      value = argv[++i];
+      return true;
+    };
+    std::string value;
+    if (arg == "--help" || arg == "-h") {
+      options.show_help = true;
+    } else if (arg == "--clients") {
+      if (!require_value(value) || !ParseInt(value, "clients", 1, options.clients, error)) {
+        return false;
+      }
+    } else if (arg == "--ticks") {
+      if (!require_value(value) || !ParseInt(value, "ticks", 1, options.ticks, error)) {
+        return false;
+      }
+    } else if (arg == "--warmup-ticks") {
+      if (!require_value(value) || !ParseInt(value, "warmup ticks", 0, options.warmup_ticks, error)) {
+        return false;
+      }
+    } else if (arg == "--tick-rate") {
+      if (!require_value(value) || !ParseInt(value, "tick rate", 1, options.tick_rate, error)) {
+        return false;
+      }
+    } else if (arg == "--snapshot-keyframe-interval") {
+      if (!require_value(value) ||
+          !ParseInt(value, "snapshot keyframe interval", 0, options.snapshot_keyframe_interval, error)) {
+        return false;
+      }
+    } else if (arg == "--seed") {
+      uint32_t seed = 0;
+      if (!require_value(value) || !ParseUnsigned32(value, "seed", seed, error)) {
+        return false;
+      }
+      options.seed = seed;
+    } else if (arg == "--map-seed") {
+      if (!require_value(value) || !ParseUnsigned32(value, "map seed", options.map_seed, error)) {
+        return false;
+      }
+    } else if (arg == "--map-mode") {
+      if (!require_value(value)) {
+        return false;
+      }
+      if (value != "legacy" && value != "static") {
+        error = "Invalid map mode: " + value;
+        return false;
+      }
+      options.map_mode = value;
+    } else if (arg == "--map-manifest") {
+      if (!require_value(map_manifest_path)) {
+        return false;
+      }
+    } else if (arg == "--fire-rate") {
+      if (!require_value(value) || !ParseRate(value, "fire rate", options.fire_rate, error)) {
+        return false;
+      }
+    } else if (arg == "--interest-occlusion") {
+      options.interest_occlusion = true;
+    } else if (arg == "--movement-workers") {
+      int workers = 0;
+      if (!require_value(value) || !ParseInt(value, "movement workers", 1, workers, error)) {
+        return false;
+      }
+      options.movement_workers = static_cast<size_t>(workers);
+    } else if (arg == "--out") {
+      if (!require_value(options.output_path)) {
+        return false;
+      }
+    } else {
+      error = "Unknown argument: " + arg;
+      return false;
+    }
+  }
+
+  if (options.map_mode == "static") {
+    options.map_options.mode = afps::world::MapWorldMode::Static;
+    options.map_options.static_manifest_path = map_manifest_path;
+  } else {
+    options.map_options.mode = afps::world::MapWorldMode::Legacy;
+    options.map_options.static_manifest_path.clear();
+  }
+  return true;
+}
+
+std::string LoadHarnessUsage() {
+  return "Usage: afps_server_loadtest [options]\n"
+         "  --clients N                      Scripted clients (default 32)\n"
+         "  --ticks N                        Measured ticks (default 600)\n"
+         "  --warmup-ticks N                 Unmeasured ticks run first (default 120)\n"
+         "  --tick-rate N                    Server tick rate (default 60)\n"
+         "  --snapshot-keyframe-interval N   Keyframe every N snapshots (default 5)\n"
+         "  --seed N                         Client script seed (default 1337)\n"
+         "  --map-seed N                     Map seed (default 0)\n"
+         "  --map-mode legacy|static         Map world mode (default legacy)\n"
+         "  --map-manifest PATH              Static map manifest\n"
+         "  --fire-rate N                    Fire requests per client per second (default 4)\n"
+         "  --interest-occlusion             Enable interest occlusion\n"
+         "  --movement-workers N             Movement threads, including the tick thread (default 1)\n"
+         "  --out PATH                       Write the JSON report to PATH instead of stdout\n";
+}
+
+bool RunLoadHarness(const LoadHarnessOptions &options, LoadHarnessReport &report, std::string &error) {
+  if (options.clients <= 0 || options.ticks <= 0 || options.warmup_ticks < 0 || options.tick_rate <= 0) {
+    error = "Invalid clients/ticks/warmup ticks/tick rate";
+    return false;
+  }
+
+  report = LoadHarnessReport{};
+  report.clients = options.clients;
+  report.ticks = options.ticks;
+  report.warmup_ticks = options.warmup_ticks;
+  report.tick_rate = options.tick_rate;
+  report.seed = options.seed;
+  report.map_seed = options.map_seed;
+  report.map_mode = options.map_mode;
+  report.movement_workers = std::max<size_t>(1, options.movement_workers);
+
+  std::vector<double> tick_ms;
+  tick_ms.reserve(static_cast<size_t>(options.ticks));
+  ScriptedTransport transport(options.clients, options.seed, options.fire_rate, options.tick_rate);
+  ScriptedTransport::Counters baseline;
+  uint64_t allocations_before = 0;
+  uint64_t allocations = 0;
+  {
+    ScopedStdoutSilence silence;
+    TickLoop loop(transport, options.tick_rate, options.snapshot_keyframe_interval, options.map_seed,
+                  options.map_options, options.interest_occlusion, {}, report.movement_workers);
+
+    // A synthetic clock makes every Advance run exactly one tick, back to back.
+    using Clock = TickAccumulator::Clock;
+    auto now = Clock::time_point{};
+    loop.Advance(now);
+    const int total_ticks = options.warmup_ticks + options.ticks;
+    for (int tick = 0; tick < total_ticks; ++tick) {
+      const bool measured = tick >= options.warmup_ticks;
+      if (tick == options.warmup_ticks) {
+        baseline = transport.counters();
+      }
+      transport.QueueTick(tick, options.tick_rate);
+      now += loop.tick_duration();
+      if (measured && options.allocation_count) {
+        allocations_before = options.allocation_count();
+      }
+      const auto start = Clock::now();
+      loop.Advance(now);
+      const auto end = Clock::now();
+      if (measured) {
+        if (options.allocation_count) {
+          allocations += options.allocation_count() - allocations_before;
+        }
+        tick_ms.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+      }
+    }
+  }
+
+  const auto &counters = transport.counters();
+  report.inputs = counters.inputs - baseline.inputs;
+  report.fire_requests = counters.fire_requests - baseline.fire_requests;
+  report.reliable_messages = counters.reliable_messages - baseline.reliable_messages;
+  report.unreliable_messages = counters.unreliable_messages - baseline.unreliable_messages;
+  report.reliable_bundles = counters.reliable_bundles - baseline.reliable_bundles;
+  report.unreliable_bundles = counters.unreliable_bundles - baseline.unreliable_bundles;
+  report.bytes_sent = counters.bytes_sent - baseline.bytes_sent;
+
+  const double ticks = static_cast<double>(options.ticks);
+  const double seconds = ticks / static_cast<double>(options.tick_rate);
+  report.bytes_per_client_per_second =
+      static_cast<double>(report.bytes_sent) / (static_cast<double>(options.clients) * seconds);
+  report.messages_per_tick = static_cast<double>(report.reliable_messages + report.unreliable_messages) / ticks;
+  report.bundles_per_tick = static_cast<double>(report.reliable_bundles + report.unreliable_bundles) / ticks;
+
+  double total_ms = 0.0;
+  for (const double ms : tick_ms) {
+    total_ms += ms;
+  }
+  std::sort(tick_ms.begin(), tick_ms.end());
+  report.tick_p50_ms = Percentile(tick_ms, 0.50);
+  report.tick_p99_ms = Percentile(tick_ms, 0.99);
+  report.tick_max_ms = tick_ms.empty() ? 0.0 : tick_ms.back();
+  report.tick_mean_ms = tick_ms.empty() ? 0.0 : total_ms / static_cast<double>(tick_ms.size());
+
+  report.allocations_counted = options.allocation_count != nullptr;
+  report.allocations = allocations;
+  report.allocations_per_tick = static_cast<double>(allocations) / ticks;
+  return true;
+}
+
+std::string BuildLoadHarnessJson(const LoadHarnessReport &report) {
+  std::ostringstream out;
+  out << "{\"clients\":" << report.clients << ",\"ticks\":" << report.ticks
+      << ",\"warmup_ticks\":" << report.warmup_ticks << ",\"tick_rate\":" << report.tick_rate
+      << ",\"seed\":" << report.seed << ",\"map_mode\":\"" << report.map_mode << "\""
+      << ",\"map_seed\":" << report.map_seed << ",\"movement_workers\":" << report.movement_workers
+      << ",\"tick_ms\":{\"p50\":" << report.tick_p50_ms << ",\"p99\":" << report.tick_p99_ms
+      << ",\"max\":" << report.tick_max_ms << ",\"mean\":" << report.tick_mean_ms << "}"
+      << ",\"inputs\":" << report.inputs << ",\"fire_requests\":" << report.fire_requests
+      << ",\"reliable_messages\":" << report.reliable_messages
+      << ",\"unreliable_messages\":" << report.unreliable_messages << ",\"bytes_sent\":" << report.bytes_sent
+      << ",\"bytes_per_client_per_second\":" << report.bytes_per_client_per_second
+      << ",\"messages_per_tick\":" << report.messages_per_tick
+      << ",\"reliable_bundles\":" << report.reliable_bundles
+      << ",\"unreliable_bundles\":" << report.unreliable_bundles
+      << ",\"bundles_per_tick\":" << report.bundles_per_tick << ",\"allocations\":";
+  if (report.allocations_counted) {
+    out << "{\"total\":" << report.allocations << ",\"per_tick\":" << report.allocations_per_tick << "}";
+  } else {
+    out << "null";
+  }
+  out << "}";
+  return out.str();
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "map_world.h"
+#include "protocol.h"
+
+// Drives a real TickLoop with scripted in-process clients and measures each tick. The clients
+// stand in for SignalingStore: they queue inputs, fire requests and snapshot acks straight into
+// the tick's command batches and count every message the tick sends back.
+struct LoadHarnessOptions {
+  int clients = 32;
+  int ticks = 600;
+  // Ticks run before measuring, so joins and first-use allocations are left out.
+  int warmup_ticks = 120;
+  int tick_rate = kServerTickRate;
+  int snapshot_keyframe_interval = kSnapshotKeyframeInterval;
+  unsigned int seed = 1337;
+  uint32_t map_seed = 0;
+  std::string map_mode = "legacy";
+  afps::world::MapWorldOptions map_options{};
+  // Fire requests per client per second.
+  double fire_rate = 4.0;
+  bool interest_occlusion = false;
+  size_t movement_workers = 1;
+  // Writes the JSON report here instead of stdout when set.
+  std::string output_path;
+  bool show_help = false;
+  // Process-wide allocation counter, supplied by binaries that replace operator new. Allocations
+  // are reported as not counted without one.
+  size_t (*allocation_count)() = nullptr;
+};
+
+struct LoadHarnessReport {
+  int clients = 0;
+  int ticks = 0;
+  int warmup_ticks = 0;
+  int tick_rate = 0;
+  unsigned int seed = 0;
+  uint32_t map_seed = 0;
+  std::string map_mode;
+  size_t movement_workers = 0;
+  double tick_p50_ms = 0.0;
+  double tick_p99_ms = 0.0;
+  double tick_max_ms = 0.0;
+  double tick_mean_ms = 0.0;
+  uint64_t inputs = 0;
+  uint64_t fire_requests = 0;
+  uint64_t reliable_messages = 0;
+  uint64_t unreliable_messages = 0;
+  // DataChannel messages after bundling.
+  uint64_t reliable_bundles = 0;
+  uint64_t unreliable_bundles = 0;
+  uint64_t bytes_sent = 0;
+  double bytes_per_client_per_second = 0.0;
+  double messages_per_tick = 0.0;
+  double bundles_per_tick = 0.0;
+  bool allocations_counted = false;
+  uint64_t allocations = 0;
+  double allocations_per_tick = 0.0;
+};
+
+// Fills options from afps_server_loadtest's command line; unknown or malformed arguments fail.
+bool ParseLoadHarnessArgs(int argc, const char *const *argv, LoadHarnessOptions &options, std::string &error);
+std::string LoadHarnessUsage();
+bool RunLoadHarness(const LoadHarnessOptions &options, LoadHarnessReport &report, std::string &error);
+// One JSON object; keys are only ever added, so reports from different builds stay comparable.
+std::string BuildLoadHarnessJson(const LoadHarnessReport &report);
@@ -1,75 +1,101 @@
-#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
 #include <iostream>
-#include <random>
+#include <new>
 #include <string>
-#include <vector>
 
-#include "sim/sim.h"
+#include "load_harness.h"
 
+// Counts every allocation in the process so the report can include allocations per tick.
 namespace {
-int ParseInt(const char *value, int fallback) {
-  if (!value) {
-    return fallback;
+std::atomic<size_t> g_allocation_count{0};
+
+void *CountedAllocate(std::size_t size) noexcept {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+size_t AllocationCount() {
+  return g_allocation_count.load(std::memory_order_relaxed);
+}
+}  // namespace
+
+void *operator new(std::size_t size) {
+  if (void *ptr = CountedAllocate(size)) {
+    return ptr;
   }
-  try {
-    return std::stoi(value);
-  } catch (...) {
-    return fallback;
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+  if (void *ptr = CountedAllocate(size)) {
+    return ptr;
   }
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return CountedAllocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return CountedAllocate(size);
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
 }
+
+void operator delete[](void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  std::free(ptr);
 }
 
 int main(int argc, char **argv) {
-  int clients = 32;
-  int ticks = 600;
-  unsigned int seed = 1337;
-  for (int i = 1; i < argc; ++i) {
-    const std::string arg = argv[i];
-    if (arg == "--clients" && i + 1 < argc) {
-      clients = ParseInt(argv[++i], clients);
-    } else if (arg == "--ticks" && i + 1 < argc) {
-      ticks = ParseInt(argv[++i], ticks);
-    } else if (arg == "--seed" && i + 1 < argc) {
-      seed = static_cast<unsigned int>(ParseInt(argv[++i], seed));
-    }
+  LoadHarnessOptions options;
+  std::string error;
+  if (!ParseLoadHarnessArgs(argc, argv, options, error)) {
+    std::cerr << "[error] " << error << "\n" << LoadHarnessUsage();
+    return 1;
   }
+  if (options.show_help) {
+    std::cout << LoadHarnessUsage();
+    return 0;
+  }
+  options.allocation_count = AllocationCount;
 
-  if (clients <= 0 || ticks <= 0) {
-    std::cerr << "Invalid clients/ticks\n";
+  LoadHarnessReport report;
+  if (!RunLoadHarness(options, report, error)) {
+    std::cerr << "[error] " << error << "\n";
     return 1;
   }
 
-  std::vector<afps::sim::PlayerState> players(static_cast<size_t>(clients));
-  const auto config = afps::sim::kDefaultSimConfig;
-  const double dt = 1.0 / 60.0;
-
-  std::mt19937 rng(seed);
-  std::uniform_real_distribution<double> axis(-1.0, 1.0);
-  std::bernoulli_distribution toggle(0.05);
-
-  auto start = std::chrono::steady_clock::now();
-  for (int tick = 0; tick < ticks; ++tick) {
-    for (auto &state : players) {
-      const auto input = afps::sim::MakeInput(
-          axis(rng), axis(rng),
-          toggle(rng),
-          toggle(rng),
-          toggle(rng),
-          toggle(rng),
-          toggle(rng),
-          toggle(rng),
-          axis(rng) * 3.14159265358979323846,
-          axis(rng) * 0.5);
-      afps::sim::StepPlayer(state, input, config, dt);
-    }
+  const std::string json = BuildLoadHarnessJson(report);
+  if (options.output_path.empty()) {
+    std::cout << json << "\n";
+    return 0;
+  }
+  std::ofstream out(options.output_path);
+  if (!out) {
+    std::cerr << "[error] Failed to open " << options.output_path << "\n";
+    return 1;
   }
-  auto end = std::chrono::steady_clock::now();
-  const auto elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
-  const double total_steps = static_cast<double>(clients) * static_cast<double>(ticks);
-  const double steps_per_sec = elapsed.count() > 0 ? total_steps / elapsed.count() : 0.0;
-
-  std::cout << "load_test clients=" << clients << " ticks=" << ticks
-            << " seconds=" << elapsed.count()
-            << " steps_per_sec=" << steps_per_sec << "\n";
-  return 0;
+  out << json << "\n";
+  return out ? 0 : 1;
 }
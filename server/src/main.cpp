@@ -13,8 +13,10 @@
 
 #ifdef AFPS_ENABLE_WEBRTC
 #include "protocol.h"
+#include "room_manager.h"
 #include "signaling.h"
 #include "signaling_json.h"
+#include "weapon_config.h"
 #include <rtc/rtc.hpp>
 #endif
 
@@ -156,9 +158,9 @@ std::string ComputePickupHash(const std::vector<PickupRow> &rows) {
   return HashToHex(hash);
 }
 
-afps::world::MapWorldOptions BuildMapOptions(const ServerConfig &config) {
+afps::world::MapWorldOptions BuildMapOptions(const ServerConfig &config, const std::string &map_mode) {
   afps::world::MapWorldOptions options;
-  if (config.map_mode == "static") {
+  if (map_mode == "static") {
     options.mode = afps::world::MapWorldMode::Static;
     options.static_manifest_path = config.map_manifest_path;
   } else {
@@ -168,6 +170,10 @@ afps::world::MapWorldOptions BuildMapOptions(const ServerConfig &config) {
   return options;
 }
 
+afps::world::MapWorldOptions BuildMapOptions(const ServerConfig &config) {
+  return BuildMapOptions(config, config.map_mode);
+}
+
 bool EnvFlagEnabled(const char *raw) {
   if (!raw) {
     return false;
@@ -249,10 +255,11 @@ bool RunCollisionMeshBuildTool(const std::string &registry_path, std::string &er
 
 bool ValidateCollisionMeshRegistryForMap(const ServerConfig &config) {
   const std::string path = afps::world::ResolveCollisionMeshRegistryPath();
+  const std::string binary_path = afps::world::ResolveCollisionMeshBinaryPath(path);
   const bool strict = EnvFlagEnabled(std::getenv("AFPS_STRICT_COLLISION_MESH"));
   afps::world::CollisionMeshRegistry registry;
   std::string load_error;
-  bool loaded = afps::world::LoadCollisionMeshRegistry(path, registry, load_error);
+  bool loaded = afps::world::LoadCollisionMeshRegistry(registry, load_error);
   size_t missing_triangle_prefabs = 0;
   bool has_triangles = loaded && CollisionMeshRegistryHasTriangleData(registry, missing_triangle_prefabs);
   bool rebuilt_registry = false;
@@ -270,7 +277,7 @@ bool ValidateCollisionMeshRegistryForMap(const ServerConfig &config) {
     rebuilt_registry = true;
     registry = {};
     load_error.clear();
-    loaded = afps::world::LoadCollisionMeshRegistry(path, registry, load_error);
+    loaded = afps::world::LoadCollisionMeshRegistry(registry, load_error);
     has_triangles = loaded && CollisionMeshRegistryHasTriangleData(registry, missing_triangle_prefabs);
   }
 
@@ -284,6 +291,18 @@ bool ValidateCollisionMeshRegistryForMap(const ServerConfig &config) {
     return false;
   }
 
+  // Rooms map the binary sidecar instead of each parsing the JSON registry.
+  bool binary_written = false;
+  if (binary_path != path && !afps::world::IsCollisionMeshBinaryCurrent(binary_path, path)) {
+    uint64_t source_hash = 0;
+    std::string binary_error;
+    binary_written = afps::world::HashCollisionMeshSourceFile(path, source_hash, binary_error) &&
+                     afps::world::WriteCollisionMeshRegistryBinary(registry, source_hash, binary_path, binary_error);
+    if (!binary_written) {
+      std::cerr << "[warn] collision mesh binary registry not written: " << binary_error << "\n";
+    }
+  }
+
   const auto options = BuildMapOptions(config);
   const auto generated = afps::world::GenerateMapWorld(
       afps::sim::kDefaultSimConfig, config.map_seed, kMapSignatureTickRate, options);
@@ -295,6 +314,8 @@ bool ValidateCollisionMeshRegistryForMap(const ServerConfig &config) {
             << ",\"version\":" << registry.version
             << ",\"prefab_count\":" << registry.prefabs.size()
             << ",\"rebuilt\":" << (rebuilt_registry ? "true" : "false")
+            << ",\"binary_path\":" << std::quoted(binary_path)
+            << ",\"binary_written\":" << (binary_written ? "true" : "false")
             << ",\"missing_triangle_prefab_count\":" << missing_triangle_prefabs
             << ",\"checksum\":" << std::quoted(HashToHex(
                    afps::world::ComputeCollisionMeshRegistryChecksum(registry)))
@@ -324,6 +345,27 @@ bool ValidateCollisionMeshRegistryForMap(const ServerConfig &config) {
   return true;
 }
 
+#ifdef AFPS_ENABLE_WEBRTC
+// Snapshot quantizers clamp silently, so refuse to start when a room's map or config would not fit them.
+bool ValidateSnapshotRangesForRooms(const std::vector<RoomSpec> &rooms) {
+  std::string weapon_error;
+  const auto weapons =
+      afps::weapons::LoadWeaponConfig(afps::weapons::ResolveWeaponConfigPath(), weapon_error);
+  for (const auto &room : rooms) {
+    const auto generated = afps::world::GenerateMapWorld(afps::sim::kDefaultSimConfig, room.map_seed,
+                                                         kServerTickRate, room.map_options);
+    const auto bounds = afps::server::ComputeSnapshotFieldBounds(afps::sim::kDefaultSimConfig,
+                                                                 generated.collision_world, weapons);
+    std::string error;
+    if (!ValidateSnapshotFieldBounds(bounds, error)) {
+      std::cerr << "[error] room " << room.id << ": " << error << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+#endif
+
 int DumpMapSignature(const ServerConfig &config) {
   const auto options = BuildMapOptions(config);
   const auto generated =
@@ -516,6 +558,20 @@ int main(int argc, char **argv) {
   signaling_config.turn_ttl_seconds = parse.config.turn_ttl_seconds;
   signaling_config.snapshot_keyframe_interval = parse.config.snapshot_keyframe_interval;
   signaling_config.map_seed = parse.config.map_seed;
+  const auto room_configs = ResolveRooms(parse.config);
+  std::vector<RoomSpec> room_specs;
+  room_specs.reserve(room_configs.size());
+  for (const auto &room : room_configs) {
+    signaling_config.rooms.push_back({room.id, room.map_seed});
+    room_specs.push_back({room.id, room.map_seed, BuildMapOptions(parse.config, room.map_mode)});
+  }
+  if (!ValidateSnapshotRangesForRooms(room_specs)) {
+    return 1;
+  }
+  signaling_config.room_capacity = static_cast<size_t>(parse.config.room_capacity);
+  signaling_config.send_workers = parse.config.send_workers > 0
+                                      ? static_cast<size_t>(parse.config.send_workers)
+                                      : SendPool::DefaultThreadCount();
   std::filesystem::path manifest_path;
   if (!parse.config.character_manifest_path.empty()) {
     manifest_path = parse.config.character_manifest_path;
@@ -536,10 +592,12 @@ int main(int argc, char **argv) {
     }
   }
   SignalingStore signaling_store(signaling_config);
-  afps::world::MapWorldOptions map_options = BuildMapOptions(parse.config);
-  TickLoop tick_loop(signaling_store, kServerTickRate,
-                     parse.config.snapshot_keyframe_interval, parse.config.map_seed, map_options);
-  tick_loop.Start();
+  RoomManager room_manager(signaling_store, room_specs, kServerTickRate,
+                           parse.config.snapshot_keyframe_interval,
+                           parse.config.interest_occlusion,
+                           static_cast<size_t>(parse.config.tick_workers),
+                           static_cast<size_t>(parse.config.movement_workers));
+  room_manager.Start();
 #endif
 
   auto configure_server = [&](auto &server) {
@@ -605,6 +663,17 @@ int main(int argc, char **argv) {
     });
 
 #ifdef AFPS_ENABLE_WEBRTC
+    server.Get("/rooms", [&](const httplib::Request &req, httplib::Response &res) {
+      const auto auth = ValidateBearerAuth(req.get_header_value("Authorization"),
+                                           parse.config.auth_token);
+      if (!auth.ok) {
+        LogAuditEvent(req, res, "auth_failed", auth.code);
+        RespondError(res, 401, auth.code, auth.message);
+        return;
+      }
+      RespondJson(res, BuildRoomMetricsJson(room_manager.Metrics(), room_manager.SendMetrics()));
+    });
+
     server.Post("/session", [&](const httplib::Request &req, httplib::Response &res) {
       if (!EnsureBodySize(req, res)) {
         return;
@@ -639,7 +708,7 @@ int main(int argc, char **argv) {
       auto result = signaling_store.CreateConnection(parsed.request.session_token,
                                                       std::chrono::milliseconds(2000));
       if (!result.ok || !result.value.has_value()) {
-        RespondError(res, 401, SignalingStore::ErrorCode(result.error),
+        RespondError(res, result.error == SignalingError::RoomsFull ? 503 : 401, SignalingStore::ErrorCode(result.error),
                      "failed to create connection");
         return;
       }
@@ -729,7 +798,7 @@ int main(int argc, char **argv) {
     if (!server.listen(parse.config.host.c_str(), parse.config.port)) {
       std::cerr << "Failed to bind to " << parse.config.host << ":" << parse.config.port << "\n";
 #ifdef AFPS_ENABLE_WEBRTC
-      tick_loop.Stop();
+      room_manager.Stop();
 #endif
       return 1;
     }
@@ -746,7 +815,7 @@ int main(int argc, char **argv) {
   }
 
 #ifdef AFPS_ENABLE_WEBRTC
-  tick_loop.Stop();
+  room_manager.Stop();
 #endif
 
   return result;
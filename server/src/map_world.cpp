@@ -857,10 +857,11 @@ GeneratedMapWorld GenerateMapWorld(const afps::sim::SimConfig &config,
                                    uint32_t seed,
                                    int tick_rate,
                                    const MapWorldOptions &options) {
-  if (options.mode == MapWorldMode::Static) {
-    return GenerateStaticMapWorld(config, seed, tick_rate, options);
-  }
-  return GenerateLegacyMapWorld(config, seed, tick_rate);
+  GeneratedMapWorld generated = options.mode == MapWorldMode::Static
+                                    ? GenerateStaticMapWorld(config, seed, tick_rate, options)
+                                    : GenerateLegacyMapWorld(config, seed, tick_rate);
+  afps::sim::BuildColliderBvh(generated.collision_world);
+  return generated;
 }
 
 }  // namespace afps::world
@@ -0,0 +1,30 @@
+#include "outbound_queue.h"
+
+void OutboundQueue::Push(const std::vector<uint8_t> &message) {
+  Push(message.data(), message.size());
+}
+
+void OutboundQueue::Push(const uint8_t *data, size_t size) {
+  if (size == 0) {
+    return;
+  }
+  bytes_.insert(bytes_.end(), data, data + size);
+  ends_.push_back(bytes_.size());
+}
+
+void OutboundQueue::Clear() {
+  bytes_.clear();
+  ends_.clear();
+}
+
+size_t OutboundQueue::size() const {
+  return ends_.size();
+}
+
+size_t OutboundQueue::bytes() const {
+  return bytes_.size();
+}
+
+bool OutboundQueue::empty() const {
+  return ends_.empty();
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Messages for one connection channel, queued during a tick and sent together when it ends.
+// Protocol envelopes carry their own payload length, so a bundle is just consecutive envelopes
+// back to back; queued messages are stored that way and each bundle is a slice of one buffer.
+class OutboundQueue {
+public:
+  void Push(const std::vector<uint8_t> &message);
+  void Push(const uint8_t *data, size_t size);
+
+  // Calls send(data, size) for each bundle of consecutive messages totalling at most
+  // max_bundle_bytes, in queue order, then empties the queue. A message larger than
+  // max_bundle_bytes goes alone. Returns how many bundles send accepted.
+  template <typename Send>
+  size_t Flush(size_t max_bundle_bytes, Send &&send) {
+    size_t accepted = 0;
+    size_t start = 0;
+    for (size_t i = 0; i < ends_.size(); ++i) {
+      const size_t message_start = i == 0 ? 0 : ends_[i - 1];
+      if (message_start > start && ends_[i] - start > max_bundle_bytes) {
+        accepted += send(bytes_.data() + start, message_start - start) ? 1 : 0;
+        start = message_start;
+      }
+    }
+    if (start < bytes_.size()) {
+      accepted += send(bytes_.data() + start, bytes_.size() - start) ? 1 : 0;
+    }
+    Clear();
+    return accepted;
+  }
+
+  // Drops queued messages but keeps the buffers for the next tick.
+  void Clear();
+  size_t size() const;
+  size_t bytes() const;
+  bool empty() const;
+
+private:
+  std::vector<uint8_t> bytes_;
+  // End offset of each queued message in bytes_.
+  std::vector<size_t> ends_;
+};
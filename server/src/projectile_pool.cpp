@@ -0,0 +1,142 @@
+#include "projectile_pool.h"
+
+#include <algorithm>
+
+namespace afps::combat {
+
+int ProjectilePool::Spawn(const ProjectileState &projectile) {
+  const int id = next_id_++;
+  ids_.push_back(id);
+  owners_.push_back(projectile.owner);
+  positions_.push_back(projectile.position);
+  velocities_.push_back(projectile.velocity);
+  ttls_.push_back(projectile.ttl);
+  radii_.push_back(projectile.radius);
+  damages_.push_back(projectile.damage);
+  explosion_radii_.push_back(projectile.explosion_radius);
+  removed_.push_back(0);
+  return id;
+}
+
+void ProjectilePool::Remove(size_t index) {
+  if (index >= ids_.size() || removed_[index]) {
+    return;
+  }
+  removed_[index] = 1;
+  removed_count_ += 1;
+}
+
+void ProjectilePool::Compact() {
+  if (removed_count_ == 0) {
+    return;
+  }
+  size_t write = 0;
+  for (size_t read = 0; read < ids_.size(); ++read) {
+    if (removed_[read]) {
+      continue;
+    }
+    if (write != read) {
+      ids_[write] = ids_[read];
+      owners_[write] = owners_[read];
+      positions_[write] = positions_[read];
+      velocities_[write] = velocities_[read];
+      ttls_[write] = ttls_[read];
+      radii_[write] = radii_[read];
+      damages_[write] = damages_[read];
+      explosion_radii_[write] = explosion_radii_[read];
+      removed_[write] = 0;
+    }
+    ++write;
+  }
+  ids_.resize(write);
+  owners_.resize(write);
+  positions_.resize(write);
+  velocities_.resize(write);
+  ttls_.resize(write);
+  radii_.resize(write);
+  damages_.resize(write);
+  explosion_radii_.resize(write);
+  removed_.resize(write);
+  removed_count_ = 0;
+}
+
+void ProjectilePool::Clear() {
+  ids_.clear();
+  owners_.clear();
+  positions_.clear();
+  velocities_.clear();
+  ttls_.clear();
+  radii_.clear();
+  damages_.clear();
+  explosion_radii_.clear();
+  removed_.clear();
+  removed_count_ = 0;
+}
+
+size_t ProjectilePool::Find(int id) const {
+  const auto iter = std::lower_bound(ids_.begin(), ids_.end(), id);
+  if (iter == ids_.end() || *iter != id) {
+    return kNoProjectileIndex;
+  }
+  const size_t index = static_cast<size_t>(iter - ids_.begin());
+  return removed_[index] ? kNoProjectileIndex : index;
+}
+
+ProjectileState ProjectilePool::Get(size_t index) const {
+  ProjectileState projectile;
+  projectile.id = ids_[index];
+  projectile.owner = owners_[index];
+  projectile.position = positions_[index];
+  projectile.velocity = velocities_[index];
+  projectile.ttl = ttls_[index];
+  projectile.radius = radii_[index];
+  projectile.damage = damages_[index];
+  projectile.explosion_radius = explosion_radii_[index];
+  return projectile;
+}
+
+bool ProjectilePool::IsRemoved(size_t index) const {
+  return index >= removed_.size() || removed_[index] != 0;
+}
+
+int ProjectilePool::id(size_t index) const {
+  return ids_[index];
+}
+
+const afps::entity::EntityHandle &ProjectilePool::owner(size_t index) const {
+  return owners_[index];
+}
+
+Vec3 &ProjectilePool::position(size_t index) {
+  return positions_[index];
+}
+
+const Vec3 &ProjectilePool::velocity(size_t index) const {
+  return velocities_[index];
+}
+
+double &ProjectilePool::ttl(size_t index) {
+  return ttls_[index];
+}
+
+double ProjectilePool::radius(size_t index) const {
+  return radii_[index];
+}
+
+double ProjectilePool::damage(size_t index) const {
+  return damages_[index];
+}
+
+double ProjectilePool::explosion_radius(size_t index) const {
+  return explosion_radii_[index];
+}
+
+size_t ProjectilePool::size() const {
+  return ids_.size();
+}
+
+bool ProjectilePool::empty() const {
+  return ids_.empty();
+}
+
+}  // namespace afps::combat
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "combat.h"
+
+namespace afps::combat {
+
+constexpr size_t kNoProjectileIndex = static_cast<size_t>(-1);
+
+// Live projectiles stored one array per field. Ids are issued in increasing order and never
+// reused, and entries stay in spawn order, so Find is a binary search. Remove only marks an
+// entry; Compact closes the gaps in place and keeps capacity for the next tick's spawns.
+class ProjectilePool {
+public:
+  // Stores projectile under the next id, ignoring projectile.id, and returns that id.
+  int Spawn(const ProjectileState &projectile);
+  void Remove(size_t index);
+  void Compact();
+  void Clear();
+
+  size_t Find(int id) const;
+  ProjectileState Get(size_t index) const;
+  bool IsRemoved(size_t index) const;
+
+  int id(size_t index) const;
+  const afps::entity::EntityHandle &owner(size_t index) const;
+  Vec3 &position(size_t index);
+  const Vec3 &velocity(size_t index) const;
+  double &ttl(size_t index);
+  double radius(size_t index) const;
+  double damage(size_t index) const;
+  double explosion_radius(size_t index) const;
+
+  // Entries including removed ones not yet compacted.
+  size_t size() const;
+  bool empty() const;
+
+private:
+  std::vector<int> ids_;
+  std::vector<afps::entity::EntityHandle> owners_;
+  std::vector<Vec3> positions_;
+  std::vector<Vec3> velocities_;
+  std::vector<double> ttls_;
+  std::vector<double> radii_;
+  std::vector<double> damages_;
+  std::vector<double> explosion_radii_;
+  std::vector<uint8_t> removed_;
+  size_t removed_count_ = 0;
+  int next_id_ = 1;
+};
+
+}  // namespace afps::combat
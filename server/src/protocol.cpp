@@ -18,6 +18,9 @@ constexpr size_t kTypeOffset = 6;
 constexpr size_t kPayloadSizeOffset = 8;
 constexpr size_t kMsgSeqOffset = 12;
 constexpr size_t kAckOffset = 16;
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kMaxViewPitch = (kPi / 2.0) - 0.01;
+constexpr double kViewAngleSteps = 32767.0;
 
 bool IsFinite(double value) {
   return std::isfinite(value);
@@ -47,27 +50,269 @@ void WriteU32(uint8_t *data, uint32_t value) {
 
 bool IsValidMessageType(uint16_t value) {
   return value >= static_cast<uint16_t>(MessageType::ClientHello) &&
-         value <= static_cast<uint16_t>(MessageType::SetLoadoutRequest);
+         value <= static_cast<uint16_t>(MessageType::DecalDebugReport);
 }
 
 template <typename T>
-const T *VerifyPayload(const std::vector<uint8_t> &payload, std::string &error) {
+const T *VerifyPayload(ByteSpan payload, std::string &error) {
   if (payload.empty()) {
     error = "empty_payload";
     return nullptr;
   }
+  // VerifyBuffer checks the root offset before following it; payloads shorter than one offset are rejected.
   flatbuffers::Verifier verifier(payload.data(), payload.size());
-  const T *root = flatbuffers::GetRoot<T>(payload.data());
-  if (!root || !root->Verify(verifier)) {
+  if (!verifier.VerifyBuffer<T>(nullptr)) {
     error = "invalid_flatbuffer";
     return nullptr;
   }
-  return root;
+  return flatbuffers::GetRoot<T>(payload.data());
+}
+
+template <typename T>
+T ClampToWire(int value) {
+  return static_cast<T>(std::max<int>(std::numeric_limits<T>::min(),
+                                      std::min<int>(std::numeric_limits<T>::max(), value)));
+}
+
+template <typename T>
+T QuantizeStep(double value, double step) {
+  if (!std::isfinite(value)) {
+    return 0;
+  }
+  const double q = std::round(value / step);
+  const double lo = static_cast<double>(std::numeric_limits<T>::min());
+  const double hi = static_cast<double>(std::numeric_limits<T>::max());
+  return static_cast<T>(std::max(lo, std::min(hi, q)));
+}
+
+// World snapshot entries leave server_tick unset when it matches the enclosing WorldSnapshot tick.
+flatbuffers::Offset<afps::protocol::StateSnapshot> CreateStateSnapshotOffset(flatbuffers::FlatBufferBuilder &builder,
+                                                                           const StateSnapshot &snapshot,
+                                                                           bool include_server_tick = true) {
+  const auto client_id = builder.CreateString(snapshot.client_id);
+  return afps::protocol::CreateStateSnapshot(
+      builder,
+      include_server_tick ? snapshot.server_tick : 0,
+      snapshot.last_processed_input_seq,
+      client_id,
+      snapshot.pos_x_q,
+      snapshot.pos_y_q,
+      snapshot.pos_z_q,
+      snapshot.vel_x_q,
+      snapshot.vel_y_q,
+      snapshot.vel_z_q,
+      ClampToWire<uint8_t>(snapshot.weapon_slot),
+      ClampToWire<uint16_t>(snapshot.ammo_in_mag),
+      snapshot.dash_cooldown_q,
+      snapshot.health_q,
+      ClampToWire<uint16_t>(snapshot.kills),
+      ClampToWire<uint16_t>(snapshot.deaths),
+      snapshot.view_yaw_q,
+      snapshot.view_pitch_q,
+      snapshot.player_flags,
+      snapshot.weapon_heat_q,
+      snapshot.loadout_bits);
+}
+
+// Only fields named by the mask are written, so unchanged fields cost nothing on the wire even when
+// the caller left stale values in them.
+flatbuffers::Offset<afps::protocol::StateSnapshotDelta> CreateStateSnapshotDeltaOffset(
+    flatbuffers::FlatBufferBuilder &builder, const StateSnapshotDelta &delta, bool include_server_tick = true) {
+  const auto client_id = builder.CreateString(delta.client_id);
+  const int mask = delta.mask;
+  afps::protocol::StateSnapshotDeltaBuilder out(builder);
+  if (mask & kSnapshotMaskLoadoutBits) {
+    out.add_loadout_bits(delta.loadout_bits);
+  }
+  out.add_client_id(client_id);
+  out.add_mask(mask);
+  out.add_last_processed_input_seq(delta.last_processed_input_seq);
+  out.add_base_tick(delta.base_tick);
+  if (include_server_tick) {
+    out.add_server_tick(delta.server_tick);
+  }
+  if (mask & kSnapshotMaskWeaponHeatQ) {
+    out.add_weapon_heat_q(delta.weapon_heat_q);
+  }
+  if (mask & kSnapshotMaskViewPitchQ) {
+    out.add_view_pitch_q(delta.view_pitch_q);
+  }
+  if (mask & kSnapshotMaskViewYawQ) {
+    out.add_view_yaw_q(delta.view_yaw_q);
+  }
+  if (mask & kSnapshotMaskDeaths) {
+    out.add_deaths(ClampToWire<uint16_t>(delta.deaths));
+  }
+  if (mask & kSnapshotMaskKills) {
+    out.add_kills(ClampToWire<uint16_t>(delta.kills));
+  }
+  if (mask & kSnapshotMaskHealth) {
+    out.add_health_q(delta.health_q);
+  }
+  if (mask & kSnapshotMaskAmmoInMag) {
+    out.add_ammo_in_mag(ClampToWire<uint16_t>(delta.ammo_in_mag));
+  }
+  if (mask & kSnapshotMaskVelZ) {
+    out.add_vel_z_q(delta.vel_z_q);
+  }
+  if (mask & kSnapshotMaskVelY) {
+    out.add_vel_y_q(delta.vel_y_q);
+  }
+  if (mask & kSnapshotMaskVelX) {
+    out.add_vel_x_q(delta.vel_x_q);
+  }
+  if (mask & kSnapshotMaskPosZ) {
+    out.add_pos_z_q(delta.pos_z_q);
+  }
+  if (mask & kSnapshotMaskPosY) {
+    out.add_pos_y_q(delta.pos_y_q);
+  }
+  if (mask & kSnapshotMaskPosX) {
+    out.add_pos_x_q(delta.pos_x_q);
+  }
+  if (mask & kSnapshotMaskPlayerFlags) {
+    out.add_player_flags(delta.player_flags);
+  }
+  if (mask & kSnapshotMaskDashCooldown) {
+    out.add_dash_cooldown_q(delta.dash_cooldown_q);
+  }
+  if (mask & kSnapshotMaskWeaponSlot) {
+    out.add_weapon_slot(ClampToWire<uint8_t>(delta.weapon_slot));
+  }
+  return out.Finish();
+}
+
+// Encodes entries [begin, end) of the combined deltas-then-snapshots sequence.
+std::vector<uint8_t> BuildWorldSnapshotRange(const WorldSnapshot &world, size_t begin, size_t end,
+                                             uint32_t msg_seq, uint32_t server_seq_ack) {
+  const size_t delta_count = world.deltas.size();
+  flatbuffers::FlatBufferBuilder builder(256 + (end - begin) * 192);
+  std::vector<flatbuffers::Offset<afps::protocol::StateSnapshot>> snapshots;
+  std::vector<flatbuffers::Offset<afps::protocol::StateSnapshotDelta>> deltas;
+  for (size_t i = begin; i < end; ++i) {
+    if (i < delta_count) {
+      const auto &delta = world.deltas[i];
+      deltas.push_back(CreateStateSnapshotDeltaOffset(builder, delta, delta.server_tick != world.server_tick));
+    } else {
+      const auto &snapshot = world.snapshots[i - delta_count];
+      snapshots.push_back(
+          CreateStateSnapshotOffset(builder, snapshot, snapshot.server_tick != world.server_tick));
+    }
+  }
+  const auto snapshots_vec = snapshots.empty() ? 0 : builder.CreateVector(snapshots);
+  const auto deltas_vec = deltas.empty() ? 0 : builder.CreateVector(deltas);
+  builder.Finish(afps::protocol::CreateWorldSnapshot(builder, world.server_tick, snapshots_vec, deltas_vec));
+  return EncodeEnvelope(MessageType::WorldSnapshot, builder.GetBufferPointer(), builder.GetSize(), msg_seq,
+                        server_seq_ack);
+}
+
+// An entry table is the only table in its builder, so its vtable and client_id string sit in the same
+// block and every offset inside the block is relative to the block itself.
+EncodedSnapshotEntry TakeSnapshotEntry(const flatbuffers::FlatBufferBuilder &builder, flatbuffers::uoffset_t table,
+                                       bool delta) {
+  EncodedSnapshotEntry entry;
+  const uint8_t *data = builder.GetCurrentBufferPointer();
+  entry.bytes.assign(data, data + builder.GetSize());
+  entry.table_offset = builder.GetSize() - table;
+  entry.delta = delta;
+  return entry;
+}
+
+// Entry tables hold no 8-byte fields, so copying a block at a 4-byte boundary keeps every field aligned.
+constexpr size_t kSnapshotEntryAlign = sizeof(flatbuffers::uoffset_t);
+
+size_t RoundUp(size_t value, size_t align) {
+  return (value + align - 1) / align * align;
+}
+
+// The table and its string; the vtable is copied separately so a packet stores each distinct one once.
+size_t EntryBodyBytes(const EncodedSnapshotEntry &entry) {
+  return entry.bytes.size() - entry.table_offset;
+}
+
+const uint8_t *EntryVtable(const EncodedSnapshotEntry &entry, size_t &size) {
+  const auto soffset = flatbuffers::ReadScalar<flatbuffers::soffset_t>(entry.bytes.data() + entry.table_offset);
+  const uint8_t *vtable = entry.bytes.data() + entry.table_offset - soffset;
+  size = flatbuffers::ReadScalar<flatbuffers::voffset_t>(vtable);
+  return vtable;
+}
+
+struct SplicedVtable {
+  const uint8_t *data = nullptr;
+  size_t size = 0;
+  flatbuffers::uoffset_t offset = 0;
+};
+
+// Entries in one packet mostly share a handful of field layouts, so this stays a short list.
+SplicedVtable *FindSplicedVtable(std::vector<SplicedVtable> &vtables, const uint8_t *data, size_t size) {
+  for (auto &vtable : vtables) {
+    if (vtable.size == size && std::memcmp(vtable.data, data, size) == 0) {
+      return &vtable;
+    }
+  }
+  return nullptr;
+}
+
+std::vector<uint8_t> BuildSplicedWorldSnapshot(int server_tick, const std::vector<const EncodedSnapshotEntry *> &entries,
+                                               size_t begin, size_t end, bool force_vectors = false) {
+  size_t bytes = 64;
+  for (size_t i = begin; i < end; ++i) {
+    bytes += entries[i]->bytes.size() + kSnapshotEntryAlign * 2;
+  }
+  flatbuffers::FlatBufferBuilder builder(bytes);
+  std::vector<flatbuffers::uoffset_t> tables;
+  tables.reserve(end - begin);
+  for (size_t i = begin; i < end; ++i) {
+    const auto &entry = *entries[i];
+    builder.Align(kSnapshotEntryAlign);
+    builder.PushBytes(entry.bytes.data() + entry.table_offset, EntryBodyBytes(entry));
+    tables.push_back(builder.GetSize());
+  }
+  std::vector<SplicedVtable> vtables;
+  std::vector<flatbuffers::uoffset_t> table_vtables;
+  table_vtables.reserve(tables.size());
+  for (size_t i = begin; i < end; ++i) {
+    size_t size = 0;
+    const uint8_t *data = EntryVtable(*entries[i], size);
+    SplicedVtable *vtable = FindSplicedVtable(vtables, data, size);
+    if (!vtable) {
+      builder.Align(sizeof(flatbuffers::voffset_t));
+      builder.PushBytes(data, size);
+      vtables.push_back({data, size, builder.GetSize()});
+      vtable = &vtables.back();
+    }
+    table_vtables.push_back(vtable->offset);
+  }
+  // Offsets from the end of the buffer stay fixed as it grows, so each copied table can now be pointed at
+  // its vtable.
+  uint8_t *buffer_end = builder.GetCurrentBufferPointer() + builder.GetSize();
+  std::vector<flatbuffers::Offset<afps::protocol::StateSnapshot>> snapshots;
+  std::vector<flatbuffers::Offset<afps::protocol::StateSnapshotDelta>> deltas;
+  for (size_t i = 0; i < tables.size(); ++i) {
+    flatbuffers::WriteScalar<flatbuffers::soffset_t>(
+        buffer_end - tables[i], static_cast<flatbuffers::soffset_t>(table_vtables[i] - tables[i]));
+    if (entries[begin + i]->delta) {
+      deltas.emplace_back(tables[i]);
+    } else {
+      snapshots.emplace_back(tables[i]);
+    }
+  }
+  const auto snapshots_vec = (snapshots.empty() && !force_vectors) ? 0 : builder.CreateVector(snapshots);
+  const auto deltas_vec = (deltas.empty() && !force_vectors) ? 0 : builder.CreateVector(deltas);
+  builder.Finish(afps::protocol::CreateWorldSnapshot(builder, server_tick, snapshots_vec, deltas_vec));
+  return EncodeEnvelope(MessageType::WorldSnapshot, builder.GetBufferPointer(), builder.GetSize(), 0, 0);
+}
+
+// Envelope, root table and both vector headers, measured once from an empty packet, plus the padding
+// that can follow the copied vtables.
+size_t WorldSnapshotFramingBytes() {
+  static const size_t framing = BuildSplicedWorldSnapshot(1, {}, 0, 0, true).size() + kSnapshotEntryAlign;
+  return framing;
 }
 
 }  // namespace
 
-bool DecodeEnvelope(const std::vector<uint8_t> &message, DecodedEnvelope &out, std::string &error) {
+bool DecodeEnvelopeView(ByteSpan message, EnvelopeView &out, std::string &error) {
   if (message.size() < kProtocolHeaderBytes) {
     error = "message_too_small";
     return false;
@@ -101,7 +346,17 @@ bool DecodeEnvelope(const std::vector<uint8_t> &message, DecodedEnvelope &out, s
   out.header.payload_bytes = payload_bytes;
   out.header.msg_seq = msg_seq;
   out.header.server_seq_ack = server_seq_ack;
-  out.payload.assign(message.begin() + static_cast<long>(kProtocolHeaderBytes), message.end());
+  out.payload = ByteSpan(message.data() + kProtocolHeaderBytes, payload_bytes);
+  return true;
+}
+
+bool DecodeEnvelope(const std::vector<uint8_t> &message, DecodedEnvelope &out, std::string &error) {
+  EnvelopeView view;
+  if (!DecodeEnvelopeView(message, view, error)) {
+    return false;
+  }
+  out.header = view.header;
+  out.payload.assign(view.payload.data(), view.payload.data() + view.payload.size());
   return true;
 }
 
@@ -125,7 +380,16 @@ std::vector<uint8_t> EncodeEnvelope(MessageType type, const uint8_t *payload, si
   return message;
 }
 
-bool ParseClientHelloPayload(const std::vector<uint8_t> &payload, ClientHello &out, std::string &error) {
+bool StampEnvelopeSequence(std::vector<uint8_t> &message, uint32_t msg_seq, uint32_t server_seq_ack) {
+  if (message.size() < kProtocolHeaderBytes) {
+    return false;
+  }
+  WriteU32(message.data() + kMsgSeqOffset, msg_seq);
+  WriteU32(message.data() + kAckOffset, server_seq_ack);
+  return true;
+}
+
+bool ParseClientHelloPayload(ByteSpan payload, ClientHello &out, std::string &error) {
   const auto *hello = VerifyPayload<afps::protocol::ClientHello>(payload, error);
   if (!hello) {
     return false;
@@ -160,100 +424,113 @@ bool ParseClientHelloPayload(const std::vector<uint8_t> &payload, ClientHello &o
   return true;
 }
 
-bool ParseInputCmdPayload(const std::vector<uint8_t> &payload, InputCmd &out, std::string &error) {
+bool ParseInputCmdPayload(ByteSpan payload, InputCmdFrames &out, std::string &error) {
   const auto *cmd = VerifyPayload<afps::protocol::InputCmd>(payload, error);
   if (!cmd) {
     return false;
   }
 
-  out.input_seq = cmd->input_seq();
-  if (out.input_seq < 0) {
-    error = "invalid_field: inputSeq";
-    return false;
-  }
-
-  out.move_x = cmd->move_x();
-  out.move_y = cmd->move_y();
-  if (!IsFinite(out.move_x) || !IsFinite(out.move_y)) {
-    error = "invalid_field: move";
+  const auto *frames = cmd->frames();
+  if (!frames || frames->size() == 0) {
+    error = "missing_field: frames";
     return false;
   }
-  if (out.move_x < -1.0 || out.move_x > 1.0) {
-    error = "out_of_range: moveX";
-    return false;
-  }
-  if (out.move_y < -1.0 || out.move_y > 1.0) {
-    error = "out_of_range: moveY";
+  if (frames->size() > kMaxInputFramesPerCmd) {
+    error = "out_of_range: frames";
     return false;
   }
 
-  out.look_delta_x = cmd->look_delta_x();
-  out.look_delta_y = cmd->look_delta_y();
-  if (!IsFinite(out.look_delta_x) || !IsFinite(out.look_delta_y)) {
-    error = "invalid_field: lookDelta";
-    return false;
-  }
+  out.count = 0;
+  out.server_seq_ack_bits = cmd->server_seq_ack_bits();
+  for (const auto *frame : *frames) {
+    InputCmd &input = out.frames[out.count];
+    input = InputCmd{};
+    input.input_seq = frame->input_seq();
+    if (input.input_seq < 0) {
+      error = "invalid_field: inputSeq";
+      return false;
+    }
+    if (out.count > 0 && input.input_seq >= out.frames[out.count - 1].input_seq) {
+      error = "invalid_field: frameOrder";
+      return false;
+    }
 
-  out.view_yaw = cmd->view_yaw();
-  out.view_pitch = cmd->view_pitch();
-  if (!IsFinite(out.view_yaw) || !IsFinite(out.view_pitch)) {
-    error = "invalid_field: view";
-    return false;
+    // -128 has no positive counterpart and would decode below -1.
+    if (frame->move_x_q() < -kInputMoveAxisSteps) {
+      error = "out_of_range: moveX";
+      return false;
+    }
+    if (frame->move_y_q() < -kInputMoveAxisSteps) {
+      error = "out_of_range: moveY";
+      return false;
+    }
+    input.move_x = DequantizeInputAxis(frame->move_x_q());
+    input.move_y = DequantizeInputAxis(frame->move_y_q());
+    input.view_yaw = DequantizeViewYaw(frame->view_yaw_q());
+    input.view_pitch = DequantizeViewPitch(frame->view_pitch_q());
+    input.weapon_slot = frame->weapon_slot();
+
+    const uint16_t buttons = frame->buttons();
+    if ((buttons & ~kInputButtonsAll) != 0) {
+      error = "invalid_field: buttons";
+      return false;
+    }
+    input.jump = (buttons & kInputButtonJump) != 0;
+    input.fire = (buttons & kInputButtonFire) != 0;
+    input.ads = (buttons & kInputButtonAds) != 0;
+    input.sprint = (buttons & kInputButtonSprint) != 0;
+    input.dash = (buttons & kInputButtonDash) != 0;
+    input.grapple = (buttons & kInputButtonGrapple) != 0;
+    input.shield = (buttons & kInputButtonShield) != 0;
+    input.shockwave = (buttons & kInputButtonShockwave) != 0;
+    input.crouch = (buttons & kInputButtonCrouch) != 0;
+    out.count += 1;
   }
+  return true;
+}
 
-  out.weapon_slot = cmd->weapon_slot();
-  if (out.weapon_slot < 0) {
-    error = "invalid_field: weaponSlot";
+bool ParseDecalDebugReportPayload(ByteSpan payload, DecalDebugReport &out, std::string &error) {
+  const auto *report = VerifyPayload<afps::protocol::DecalDebugReport>(payload, error);
+  if (!report) {
     return false;
   }
 
-  out.jump = cmd->jump();
-  out.fire = cmd->fire();
-  out.ads = cmd->ads();
-  out.sprint = cmd->sprint();
-  out.dash = cmd->dash();
-  out.grapple = cmd->grapple();
-  out.shield = cmd->shield();
-  out.shockwave = cmd->shockwave();
-  out.crouch = cmd->crouch();
-  out.debug_decal_report_present = cmd->debug_decal_report_present();
-  out.debug_decal_server_tick = cmd->debug_decal_server_tick();
-  out.debug_decal_shot_seq = cmd->debug_decal_shot_seq();
-  out.debug_decal_hit_kind = cmd->debug_decal_hit_kind();
-  out.debug_decal_surface_type = cmd->debug_decal_surface_type();
-  out.debug_decal_authoritative_world_hit = cmd->debug_decal_authoritative_world_hit();
-  out.debug_decal_used_projected_hit = cmd->debug_decal_used_projected_hit();
-  out.debug_decal_used_impact_projection = cmd->debug_decal_used_impact_projection();
-  out.debug_decal_spawned = cmd->debug_decal_spawned();
-  out.debug_decal_in_frustum = cmd->debug_decal_in_frustum();
-  out.debug_decal_distance = cmd->debug_decal_distance();
-  out.debug_decal_position_x = cmd->debug_decal_position_x();
-  out.debug_decal_position_y = cmd->debug_decal_position_y();
-  out.debug_decal_position_z = cmd->debug_decal_position_z();
-  out.debug_decal_normal_x = cmd->debug_decal_normal_x();
-  out.debug_decal_normal_y = cmd->debug_decal_normal_y();
-  out.debug_decal_normal_z = cmd->debug_decal_normal_z();
-  out.debug_trace_hit_position_x = cmd->debug_trace_hit_position_x();
-  out.debug_trace_hit_position_y = cmd->debug_trace_hit_position_y();
-  out.debug_trace_hit_position_z = cmd->debug_trace_hit_position_z();
-  out.debug_trace_hit_normal_x = cmd->debug_trace_hit_normal_x();
-  out.debug_trace_hit_normal_y = cmd->debug_trace_hit_normal_y();
-  out.debug_trace_hit_normal_z = cmd->debug_trace_hit_normal_z();
-  if (out.debug_decal_report_present &&
-      (!IsFinite(out.debug_decal_distance) ||
-       !IsFinite(out.debug_decal_position_x) || !IsFinite(out.debug_decal_position_y) ||
-       !IsFinite(out.debug_decal_position_z) || !IsFinite(out.debug_decal_normal_x) ||
-       !IsFinite(out.debug_decal_normal_y) || !IsFinite(out.debug_decal_normal_z) ||
-       !IsFinite(out.debug_trace_hit_position_x) || !IsFinite(out.debug_trace_hit_position_y) ||
-       !IsFinite(out.debug_trace_hit_position_z) || !IsFinite(out.debug_trace_hit_normal_x) ||
-       !IsFinite(out.debug_trace_hit_normal_y) || !IsFinite(out.debug_trace_hit_normal_z))) {
-    error = "invalid_field: debug_decal_report";
+  out.server_tick = report->server_tick();
+  out.shot_seq = report->shot_seq();
+  out.hit_kind = report->hit_kind();
+  out.surface_type = report->surface_type();
+  out.authoritative_world_hit = report->authoritative_world_hit();
+  out.used_projected_hit = report->used_projected_hit();
+  out.used_impact_projection = report->used_impact_projection();
+  out.decal_spawned = report->decal_spawned();
+  out.decal_in_frustum = report->decal_in_frustum();
+  out.decal_distance = report->decal_distance();
+  out.decal_position_x = report->decal_position_x();
+  out.decal_position_y = report->decal_position_y();
+  out.decal_position_z = report->decal_position_z();
+  out.decal_normal_x = report->decal_normal_x();
+  out.decal_normal_y = report->decal_normal_y();
+  out.decal_normal_z = report->decal_normal_z();
+  out.trace_hit_position_x = report->trace_hit_position_x();
+  out.trace_hit_position_y = report->trace_hit_position_y();
+  out.trace_hit_position_z = report->trace_hit_position_z();
+  out.trace_hit_normal_x = report->trace_hit_normal_x();
+  out.trace_hit_normal_y = report->trace_hit_normal_y();
+  out.trace_hit_normal_z = report->trace_hit_normal_z();
+  if (!IsFinite(out.decal_distance) ||
+      !IsFinite(out.decal_position_x) || !IsFinite(out.decal_position_y) ||
+      !IsFinite(out.decal_position_z) || !IsFinite(out.decal_normal_x) ||
+      !IsFinite(out.decal_normal_y) || !IsFinite(out.decal_normal_z) ||
+      !IsFinite(out.trace_hit_position_x) || !IsFinite(out.trace_hit_position_y) ||
+      !IsFinite(out.trace_hit_position_z) || !IsFinite(out.trace_hit_normal_x) ||
+      !IsFinite(out.trace_hit_normal_y) || !IsFinite(out.trace_hit_normal_z)) {
+    error = "invalid_field: decal_debug_report";
     return false;
   }
   return true;
 }
 
-bool ParseFireWeaponRequestPayload(const std::vector<uint8_t> &payload, FireWeaponRequest &out, std::string &error) {
+bool ParseFireWeaponRequestPayload(ByteSpan payload, FireWeaponRequest &out, std::string &error) {
   const auto *req = VerifyPayload<afps::protocol::FireWeaponRequest>(payload, error);
   if (!req) {
     return false;
@@ -295,8 +572,7 @@ bool ParseFireWeaponRequestPayload(const std::vector<uint8_t> &payload, FireWeap
   return true;
 }
 
-bool ParseSetLoadoutRequestPayload(const std::vector<uint8_t> &payload, SetLoadoutRequest &out,
-                                   std::string &error) {
+bool ParseSetLoadoutRequestPayload(ByteSpan payload, SetLoadoutRequest &out, std::string &error) {
   const auto *req = VerifyPayload<afps::protocol::SetLoadoutRequest>(payload, error);
   if (!req) {
     return false;
@@ -305,7 +581,7 @@ bool ParseSetLoadoutRequestPayload(const std::vector<uint8_t> &payload, SetLoado
   return true;
 }
 
-bool ParsePingPayload(const std::vector<uint8_t> &payload, Ping &out, std::string &error) {
+bool ParsePingPayload(ByteSpan payload, Ping &out, std::string &error) {
   const auto *ping = VerifyPayload<afps::protocol::Ping>(payload, error);
   if (!ping) {
     return false;
@@ -594,30 +870,7 @@ std::vector<uint8_t> BuildGameEventBatch(const GameEventBatch &event, uint32_t m
 std::vector<uint8_t> BuildStateSnapshot(const StateSnapshot &snapshot, uint32_t msg_seq,
                                         uint32_t server_seq_ack) {
   flatbuffers::FlatBufferBuilder builder(256);
-  const auto client_id = builder.CreateString(snapshot.client_id);
-  const auto offset = afps::protocol::CreateStateSnapshot(
-      builder,
-      snapshot.server_tick,
-      snapshot.last_processed_input_seq,
-      client_id,
-      snapshot.pos_x,
-      snapshot.pos_y,
-      snapshot.pos_z,
-      snapshot.vel_x,
-      snapshot.vel_y,
-      snapshot.vel_z,
-      snapshot.weapon_slot,
-      snapshot.ammo_in_mag,
-      snapshot.dash_cooldown,
-      snapshot.health,
-      snapshot.kills,
-      snapshot.deaths,
-      snapshot.view_yaw_q,
-      snapshot.view_pitch_q,
-      snapshot.player_flags,
-      snapshot.weapon_heat_q,
-      snapshot.loadout_bits);
-  builder.Finish(offset);
+  builder.Finish(CreateStateSnapshotOffset(builder, snapshot));
   return EncodeEnvelope(MessageType::StateSnapshot, builder.GetBufferPointer(), builder.GetSize(), msg_seq,
                         server_seq_ack);
 }
@@ -625,36 +878,296 @@ std::vector<uint8_t> BuildStateSnapshot(const StateSnapshot &snapshot, uint32_t
 std::vector<uint8_t> BuildStateSnapshotDelta(const StateSnapshotDelta &delta, uint32_t msg_seq,
                                              uint32_t server_seq_ack) {
   flatbuffers::FlatBufferBuilder builder(256);
-  const auto client_id = builder.CreateString(delta.client_id);
-  const auto offset = afps::protocol::CreateStateSnapshotDelta(
-      builder,
-      delta.server_tick,
-      delta.base_tick,
-      delta.last_processed_input_seq,
-      delta.mask,
-      client_id,
-      delta.pos_x,
-      delta.pos_y,
-      delta.pos_z,
-      delta.vel_x,
-      delta.vel_y,
-      delta.vel_z,
-      delta.weapon_slot,
-      delta.ammo_in_mag,
-      delta.dash_cooldown,
-      delta.health,
-      delta.kills,
-      delta.deaths,
-      delta.view_yaw_q,
-      delta.view_pitch_q,
-      delta.player_flags,
-      delta.weapon_heat_q,
-      delta.loadout_bits);
-  builder.Finish(offset);
+  builder.Finish(CreateStateSnapshotDeltaOffset(builder, delta));
   return EncodeEnvelope(MessageType::StateSnapshotDelta, builder.GetBufferPointer(), builder.GetSize(), msg_seq,
                         server_seq_ack);
 }
 
+SnapshotBaseline ToSnapshotBaseline(const StateSnapshot &snapshot) {
+  SnapshotBaseline baseline;
+  baseline.server_tick = snapshot.server_tick;
+  baseline.pos_x_q = snapshot.pos_x_q;
+  baseline.pos_y_q = snapshot.pos_y_q;
+  baseline.pos_z_q = snapshot.pos_z_q;
+  baseline.vel_x_q = snapshot.vel_x_q;
+  baseline.vel_y_q = snapshot.vel_y_q;
+  baseline.vel_z_q = snapshot.vel_z_q;
+  baseline.weapon_slot = snapshot.weapon_slot;
+  baseline.ammo_in_mag = snapshot.ammo_in_mag;
+  baseline.dash_cooldown_q = snapshot.dash_cooldown_q;
+  baseline.health_q = snapshot.health_q;
+  baseline.kills = snapshot.kills;
+  baseline.deaths = snapshot.deaths;
+  baseline.view_yaw_q = snapshot.view_yaw_q;
+  baseline.view_pitch_q = snapshot.view_pitch_q;
+  baseline.player_flags = snapshot.player_flags;
+  baseline.weapon_heat_q = snapshot.weapon_heat_q;
+  baseline.loadout_bits = snapshot.loadout_bits;
+  return baseline;
+}
+
+StateSnapshotDelta DiffStateSnapshot(const SnapshotBaseline &baseline, const StateSnapshot &snapshot) {
+  StateSnapshotDelta delta;
+  delta.server_tick = snapshot.server_tick;
+  delta.base_tick = baseline.server_tick;
+  delta.last_processed_input_seq = snapshot.last_processed_input_seq;
+  delta.client_id = snapshot.client_id;
+  delta.mask = 0;
+  if (snapshot.pos_x_q != baseline.pos_x_q) {
+    delta.mask |= kSnapshotMaskPosX;
+    delta.pos_x_q = snapshot.pos_x_q;
+  }
+  if (snapshot.pos_y_q != baseline.pos_y_q) {
+    delta.mask |= kSnapshotMaskPosY;
+    delta.pos_y_q = snapshot.pos_y_q;
+  }
+  if (snapshot.pos_z_q != baseline.pos_z_q) {
+    delta.mask |= kSnapshotMaskPosZ;
+    delta.pos_z_q = snapshot.pos_z_q;
+  }
+  if (snapshot.vel_x_q != baseline.vel_x_q) {
+    delta.mask |= kSnapshotMaskVelX;
+    delta.vel_x_q = snapshot.vel_x_q;
+  }
+  if (snapshot.vel_y_q != baseline.vel_y_q) {
+    delta.mask |= kSnapshotMaskVelY;
+    delta.vel_y_q = snapshot.vel_y_q;
+  }
+  if (snapshot.vel_z_q != baseline.vel_z_q) {
+    delta.mask |= kSnapshotMaskVelZ;
+    delta.vel_z_q = snapshot.vel_z_q;
+  }
+  if (snapshot.weapon_slot != baseline.weapon_slot) {
+    delta.mask |= kSnapshotMaskWeaponSlot;
+    delta.weapon_slot = snapshot.weapon_slot;
+  }
+  if (snapshot.ammo_in_mag != baseline.ammo_in_mag) {
+    delta.mask |= kSnapshotMaskAmmoInMag;
+    delta.ammo_in_mag = snapshot.ammo_in_mag;
+  }
+  if (snapshot.dash_cooldown_q != baseline.dash_cooldown_q) {
+    delta.mask |= kSnapshotMaskDashCooldown;
+    delta.dash_cooldown_q = snapshot.dash_cooldown_q;
+  }
+  if (snapshot.health_q != baseline.health_q) {
+    delta.mask |= kSnapshotMaskHealth;
+    delta.health_q = snapshot.health_q;
+  }
+  if (snapshot.kills != baseline.kills) {
+    delta.mask |= kSnapshotMaskKills;
+    delta.kills = snapshot.kills;
+  }
+  if (snapshot.deaths != baseline.deaths) {
+    delta.mask |= kSnapshotMaskDeaths;
+    delta.deaths = snapshot.deaths;
+  }
+  if (snapshot.view_yaw_q != baseline.view_yaw_q) {
+    delta.mask |= kSnapshotMaskViewYawQ;
+    delta.view_yaw_q = snapshot.view_yaw_q;
+  }
+  if (snapshot.view_pitch_q != baseline.view_pitch_q) {
+    delta.mask |= kSnapshotMaskViewPitchQ;
+    delta.view_pitch_q = snapshot.view_pitch_q;
+  }
+  if (snapshot.player_flags != baseline.player_flags) {
+    delta.mask |= kSnapshotMaskPlayerFlags;
+    delta.player_flags = snapshot.player_flags;
+  }
+  if (snapshot.weapon_heat_q != baseline.weapon_heat_q) {
+    delta.mask |= kSnapshotMaskWeaponHeatQ;
+    delta.weapon_heat_q = snapshot.weapon_heat_q;
+  }
+  if (snapshot.loadout_bits != baseline.loadout_bits) {
+    delta.mask |= kSnapshotMaskLoadoutBits;
+    delta.loadout_bits = snapshot.loadout_bits;
+  }
+  return delta;
+}
+
+int16_t QuantizeSnapshotPosition(double meters) {
+  return QuantizeStep<int16_t>(meters, kSnapshotPositionStepMeters);
+}
+
+double DequantizeSnapshotPosition(int16_t value) {
+  return static_cast<double>(value) * kSnapshotPositionStepMeters;
+}
+
+int16_t QuantizeSnapshotVelocity(double meters_per_second) {
+  return QuantizeStep<int16_t>(meters_per_second, kSnapshotVelocityStepMetersPerSecond);
+}
+
+double DequantizeSnapshotVelocity(int16_t value) {
+  return static_cast<double>(value) * kSnapshotVelocityStepMetersPerSecond;
+}
+
+uint8_t QuantizeSnapshotDashCooldown(double seconds) {
+  return QuantizeStep<uint8_t>(seconds, kSnapshotDashCooldownStepSeconds);
+}
+
+double DequantizeSnapshotDashCooldown(uint8_t value) {
+  return static_cast<double>(value) * kSnapshotDashCooldownStepSeconds;
+}
+
+uint16_t QuantizeSnapshotHealth(double health) {
+  return QuantizeStep<uint16_t>(health, kSnapshotHealthStep);
+}
+
+double DequantizeSnapshotHealth(uint16_t value) {
+  return static_cast<double>(value) * kSnapshotHealthStep;
+}
+
+bool ValidateSnapshotFieldBounds(const SnapshotFieldBounds &bounds, std::string &error) {
+  if (!std::isfinite(bounds.max_abs_position) || bounds.max_abs_position > kSnapshotPositionRangeMeters) {
+    error = "snapshot positions reach " + std::to_string(bounds.max_abs_position) + " m, past the int16 range of " +
+            std::to_string(kSnapshotPositionRangeMeters) + " m";
+    return false;
+  }
+  if (!std::isfinite(bounds.max_dash_cooldown) || bounds.max_dash_cooldown > kSnapshotDashCooldownRangeSeconds) {
+    error = "dash cooldown reaches " + std::to_string(bounds.max_dash_cooldown) + " s, past the uint8 range of " +
+            std::to_string(kSnapshotDashCooldownRangeSeconds) + " s";
+    return false;
+  }
+  if (!std::isfinite(bounds.max_health) || bounds.max_health > kSnapshotHealthRange) {
+    error = "health reaches " + std::to_string(bounds.max_health) + ", past the uint16 range of " +
+            std::to_string(kSnapshotHealthRange);
+    return false;
+  }
+  if (bounds.max_ammo_in_mag > std::numeric_limits<uint16_t>::max()) {
+    error = "magazine size reaches " + std::to_string(bounds.max_ammo_in_mag) + ", past the uint16 range";
+    return false;
+  }
+  return true;
+}
+
+int16_t QuantizeViewYaw(double yaw_rad) {
+  if (!std::isfinite(yaw_rad)) {
+    return 0;
+  }
+  const double wrapped = std::fmod(yaw_rad + kPi, 2.0 * kPi);
+  const double normalized = (wrapped < 0.0 ? wrapped + 2.0 * kPi : wrapped) - kPi;
+  const double q = normalized / kPi;
+  return static_cast<int16_t>(std::llround(std::max(-1.0, std::min(1.0, q)) * kViewAngleSteps));
+}
+
+double DequantizeViewYaw(int16_t value) {
+  const double clamped = std::max(-kViewAngleSteps, static_cast<double>(value));
+  return (clamped / kViewAngleSteps) * kPi;
+}
+
+int16_t QuantizeViewPitch(double pitch_rad) {
+  if (!std::isfinite(pitch_rad)) {
+    return 0;
+  }
+  const double clamped = std::max(-kMaxViewPitch, std::min(kMaxViewPitch, pitch_rad));
+  const double q = clamped / kMaxViewPitch;
+  return static_cast<int16_t>(std::llround(std::max(-1.0, std::min(1.0, q)) * kViewAngleSteps));
+}
+
+double DequantizeViewPitch(int16_t value) {
+  const double clamped = std::max(-kViewAngleSteps, static_cast<double>(value));
+  return (clamped / kViewAngleSteps) * kMaxViewPitch;
+}
+
+int8_t QuantizeInputAxis(double value) {
+  if (!std::isfinite(value)) {
+    return 0;
+  }
+  const double clamped = std::max(-1.0, std::min(1.0, value));
+  return static_cast<int8_t>(std::lround(clamped * kInputMoveAxisSteps));
+}
+
+double DequantizeInputAxis(int8_t value) {
+  const double clamped = std::max(-kInputMoveAxisSteps, static_cast<double>(value));
+  return clamped / kInputMoveAxisSteps;
+}
+
+uint16_t PackInputButtons(const InputCmd &cmd) {
+  uint16_t buttons = 0;
+  buttons |= cmd.jump ? kInputButtonJump : 0;
+  buttons |= cmd.fire ? kInputButtonFire : 0;
+  buttons |= cmd.ads ? kInputButtonAds : 0;
+  buttons |= cmd.sprint ? kInputButtonSprint : 0;
+  buttons |= cmd.dash ? kInputButtonDash : 0;
+  buttons |= cmd.grapple ? kInputButtonGrapple : 0;
+  buttons |= cmd.shield ? kInputButtonShield : 0;
+  buttons |= cmd.shockwave ? kInputButtonShockwave : 0;
+  buttons |= cmd.crouch ? kInputButtonCrouch : 0;
+  return buttons;
+}
+
+std::vector<uint8_t> BuildWorldSnapshot(const WorldSnapshot &world, uint32_t msg_seq, uint32_t server_seq_ack) {
+  return BuildWorldSnapshotRange(world, 0, world.snapshots.size() + world.deltas.size(), msg_seq,
+                                 server_seq_ack);
+}
+
+std::vector<WorldSnapshotPacket> BuildWorldSnapshotPackets(const WorldSnapshot &world, size_t max_packet_bytes) {
+  std::vector<EncodedSnapshotEntry> encoded;
+  encoded.reserve(world.deltas.size() + world.snapshots.size());
+  for (const auto &delta : world.deltas) {
+    encoded.push_back(EncodeSnapshotEntry(delta, world.server_tick));
+  }
+  for (const auto &snapshot : world.snapshots) {
+    encoded.push_back(EncodeSnapshotEntry(snapshot, world.server_tick));
+  }
+  std::vector<const EncodedSnapshotEntry *> entries;
+  entries.reserve(encoded.size());
+  for (const auto &entry : encoded) {
+    entries.push_back(&entry);
+  }
+  return BuildWorldSnapshotPackets(world.server_tick, entries, max_packet_bytes);
+}
+
+EncodedSnapshotEntry EncodeSnapshotEntry(const StateSnapshot &snapshot, int world_tick) {
+  flatbuffers::FlatBufferBuilder builder(128);
+  const auto table = CreateStateSnapshotOffset(builder, snapshot, snapshot.server_tick != world_tick);
+  return TakeSnapshotEntry(builder, table.o, false);
+}
+
+EncodedSnapshotEntry EncodeSnapshotEntry(const StateSnapshotDelta &delta, int world_tick) {
+  flatbuffers::FlatBufferBuilder builder(128);
+  const auto table = CreateStateSnapshotDeltaOffset(builder, delta, delta.server_tick != world_tick);
+  return TakeSnapshotEntry(builder, table.o, true);
+}
+
+std::vector<WorldSnapshotPacket> BuildWorldSnapshotPackets(int server_tick,
+                                                           const std::vector<const EncodedSnapshotEntry *> &entries,
+                                                           size_t max_packet_bytes) {
+  std::vector<WorldSnapshotPacket> packets;
+  const size_t framing = WorldSnapshotFramingBytes();
+  std::vector<SplicedVtable> vtables;
+  size_t index = 0;
+  while (index < entries.size()) {
+    // Each entry adds its padded body and vector slot, plus its vtable the first time that layout
+    // appears in the packet. At least one entry is taken so an oversized one still goes out alone.
+    vtables.clear();
+    size_t count = 0;
+    size_t bytes = framing;
+    while (index + count < entries.size()) {
+      const auto &entry = *entries[index + count];
+      size_t vtable_size = 0;
+      const uint8_t *vtable = EntryVtable(entry, vtable_size);
+      const bool new_vtable = FindSplicedVtable(vtables, vtable, vtable_size) == nullptr;
+      const size_t next = RoundUp(EntryBodyBytes(entry), kSnapshotEntryAlign) + sizeof(flatbuffers::uoffset_t) +
+                          (new_vtable ? RoundUp(vtable_size, sizeof(flatbuffers::voffset_t)) : 0);
+      if (count > 0 && bytes + next > max_packet_bytes) {
+        break;
+      }
+      if (new_vtable) {
+        vtables.push_back({vtable, vtable_size, 0});
+      }
+      bytes += next;
+      count += 1;
+    }
+    WorldSnapshotPacket packet;
+    packet.message = BuildSplicedWorldSnapshot(server_tick, entries, index, index + count);
+    packet.first_entry = index;
+    packet.entry_count = count;
+    packets.push_back(std::move(packet));
+    index += count;
+  }
+  return packets;
+}
+
 std::vector<uint8_t> BuildPlayerProfile(const PlayerProfile &profile, uint32_t msg_seq, uint32_t server_seq_ack) {
   flatbuffers::FlatBufferBuilder builder(128);
   const auto client_id = builder.CreateString(profile.client_id);
@@ -1,17 +1,20 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <string>
 #include <variant>
 #include <vector>
 
-constexpr int kProtocolVersion = 7;
+constexpr int kProtocolVersion = 11;
 constexpr int kServerTickRate = 60;
 constexpr int kSnapshotRate = 20;
 constexpr int kSnapshotKeyframeInterval = 5;
 constexpr size_t kMaxClientMessageBytes = 4096;
 constexpr size_t kProtocolHeaderBytes = 20;
+constexpr size_t kMaxSnapshotPacketBytes = 1200;
+constexpr size_t kSnapshotBaselineHistory = 32;
 constexpr const char *kReliableChannelLabel = "afps_reliable";
 constexpr const char *kUnreliableChannelLabel = "afps_unreliable";
 constexpr uint8_t kProtocolMagic[4] = {'A', 'F', 'P', 'S'};
@@ -39,6 +42,28 @@ constexpr int kSnapshotMaskAll =
     kSnapshotMaskDeaths | kSnapshotMaskWeaponSlot | kSnapshotMaskAmmoInMag |
     kSnapshotMaskViewYawQ | kSnapshotMaskViewPitchQ | kSnapshotMaskPlayerFlags |
     kSnapshotMaskWeaponHeatQ | kSnapshotMaskLoadoutBits;
+// Snapshot positions are int16 fixed point; the covered range must contain the arena. Steps are powers of
+// two so round values survive the trip exactly.
+constexpr double kSnapshotPositionStepMeters = 1.0 / 512.0;
+constexpr double kSnapshotPositionRangeMeters = 32767.0 * kSnapshotPositionStepMeters;
+constexpr double kSnapshotVelocityStepMetersPerSecond = 1.0 / 128.0;
+constexpr double kSnapshotDashCooldownStepSeconds = 1.0 / 64.0;
+constexpr double kSnapshotHealthStep = 1.0 / 256.0;
+// Largest values the uint8 dash cooldown and uint16 health fields can carry before clamping.
+constexpr double kSnapshotDashCooldownRangeSeconds = 255.0 * kSnapshotDashCooldownStepSeconds;
+constexpr double kSnapshotHealthRange = 65535.0 * kSnapshotHealthStep;
+constexpr size_t kMaxInputFramesPerCmd = 4;
+constexpr double kInputMoveAxisSteps = 127.0;
+constexpr uint16_t kInputButtonJump = 1 << 0;
+constexpr uint16_t kInputButtonFire = 1 << 1;
+constexpr uint16_t kInputButtonAds = 1 << 2;
+constexpr uint16_t kInputButtonSprint = 1 << 3;
+constexpr uint16_t kInputButtonDash = 1 << 4;
+constexpr uint16_t kInputButtonGrapple = 1 << 5;
+constexpr uint16_t kInputButtonShield = 1 << 6;
+constexpr uint16_t kInputButtonShockwave = 1 << 7;
+constexpr uint16_t kInputButtonCrouch = 1 << 8;
+constexpr uint16_t kInputButtonsAll = (1 << 9) - 1;
 
 struct ClientHello {
   int protocol_version = 0;
@@ -61,12 +86,13 @@ struct ServerHello {
   uint32_t map_seed = 0;
 };
 
+// Gameplay input for one client tick. On the wire it is an InputFrame: move axes in int8 steps of
+// 1/kInputMoveAxisSteps, buttons as kInputButton* bits and view angles in the snapshot int16 encoding,
+// so the values here are already quantized and client prediction replays exactly what the server runs.
 struct InputCmd {
   int input_seq = 0;
   double move_x = 0.0;
   double move_y = 0.0;
-  double look_delta_x = 0.0;
-  double look_delta_y = 0.0;
   double view_yaw = 0.0;
   double view_pitch = 0.0;
   int weapon_slot = 0;
@@ -79,29 +105,41 @@ struct InputCmd {
   bool shield = false;
   bool shockwave = false;
   bool crouch = false;
-  bool debug_decal_report_present = false;
-  int debug_decal_server_tick = 0;
-  int debug_decal_shot_seq = 0;
-  uint8_t debug_decal_hit_kind = 0;
-  uint8_t debug_decal_surface_type = 0;
-  bool debug_decal_authoritative_world_hit = false;
-  bool debug_decal_used_projected_hit = false;
-  bool debug_decal_used_impact_projection = false;
-  bool debug_decal_spawned = false;
-  bool debug_decal_in_frustum = false;
-  double debug_decal_distance = -1.0;
-  double debug_decal_position_x = 0.0;
-  double debug_decal_position_y = 0.0;
-  double debug_decal_position_z = 0.0;
-  double debug_decal_normal_x = 0.0;
-  double debug_decal_normal_y = 0.0;
-  double debug_decal_normal_z = 0.0;
-  double debug_trace_hit_position_x = 0.0;
-  double debug_trace_hit_position_y = 0.0;
-  double debug_trace_hit_position_z = 0.0;
-  double debug_trace_hit_normal_x = 0.0;
-  double debug_trace_hit_normal_y = 0.0;
-  double debug_trace_hit_normal_z = 0.0;
+};
+
+// One InputCmd message: the newest frame first, then up to kMaxInputFramesPerCmd - 1 earlier ones
+// resent so a lost packet is covered by the next.
+struct InputCmdFrames {
+  std::array<InputCmd, kMaxInputFramesPerCmd> frames{};
+  size_t count = 0;
+  // Bit i: the server message with msg_seq server_seq_ack - 1 - i also arrived.
+  uint32_t server_seq_ack_bits = 0;
+};
+
+// Client decal telemetry, sent on its own at a low rate while the debug overlays are open.
+struct DecalDebugReport {
+  int server_tick = 0;
+  int shot_seq = 0;
+  uint8_t hit_kind = 0;
+  uint8_t surface_type = 0;
+  bool authoritative_world_hit = false;
+  bool used_projected_hit = false;
+  bool used_impact_projection = false;
+  bool decal_spawned = false;
+  bool decal_in_frustum = false;
+  double decal_distance = -1.0;
+  double decal_position_x = 0.0;
+  double decal_position_y = 0.0;
+  double decal_position_z = 0.0;
+  double decal_normal_x = 0.0;
+  double decal_normal_y = 0.0;
+  double decal_normal_z = 0.0;
+  double trace_hit_position_x = 0.0;
+  double trace_hit_position_y = 0.0;
+  double trace_hit_position_z = 0.0;
+  double trace_hit_normal_x = 0.0;
+  double trace_hit_normal_y = 0.0;
+  double trace_hit_normal_z = 0.0;
 };
 
 struct FireWeaponRequest {
@@ -279,16 +317,39 @@ struct StateSnapshot {
   int server_tick = 0;
   int last_processed_input_seq = -1;
   std::string client_id;
-  double pos_x = 0.0;
-  double pos_y = 0.0;
-  double pos_z = 0.0;
-  double vel_x = 0.0;
-  double vel_y = 0.0;
-  double vel_z = 0.0;
+  int16_t pos_x_q = 0;
+  int16_t pos_y_q = 0;
+  int16_t pos_z_q = 0;
+  int16_t vel_x_q = 0;
+  int16_t vel_y_q = 0;
+  int16_t vel_z_q = 0;
   int weapon_slot = 0;
   int ammo_in_mag = 0;
-  double dash_cooldown = 0.0;
-  double health = 100.0;
+  uint8_t dash_cooldown_q = 0;
+  uint16_t health_q = 25600;  // 100 hp at kSnapshotHealthStep
+  int kills = 0;
+  int deaths = 0;
+  int16_t view_yaw_q = 0;
+  int16_t view_pitch_q = 0;
+  uint8_t player_flags = 0;
+  uint16_t weapon_heat_q = 0;
+  uint32_t loadout_bits = 0;
+};
+
+// The quantized fields of a StateSnapshot that deltas are diffed against, without the client id, so
+// per-recipient baseline histories hold no strings.
+struct SnapshotBaseline {
+  int server_tick = 0;
+  int16_t pos_x_q = 0;
+  int16_t pos_y_q = 0;
+  int16_t pos_z_q = 0;
+  int16_t vel_x_q = 0;
+  int16_t vel_y_q = 0;
+  int16_t vel_z_q = 0;
+  int weapon_slot = 0;
+  int ammo_in_mag = 0;
+  uint8_t dash_cooldown_q = 0;
+  uint16_t health_q = 0;
   int kills = 0;
   int deaths = 0;
   int16_t view_yaw_q = 0;
@@ -304,16 +365,16 @@ struct StateSnapshotDelta {
   int last_processed_input_seq = -1;
   int mask = 0;
   std::string client_id;
-  double pos_x = 0.0;
-  double pos_y = 0.0;
-  double pos_z = 0.0;
-  double vel_x = 0.0;
-  double vel_y = 0.0;
-  double vel_z = 0.0;
+  int16_t pos_x_q = 0;
+  int16_t pos_y_q = 0;
+  int16_t pos_z_q = 0;
+  int16_t vel_x_q = 0;
+  int16_t vel_y_q = 0;
+  int16_t vel_z_q = 0;
   int weapon_slot = 0;
   int ammo_in_mag = 0;
-  double dash_cooldown = 0.0;
-  double health = 0.0;
+  uint8_t dash_cooldown_q = 0;
+  uint16_t health_q = 0;
   int kills = 0;
   int deaths = 0;
   int16_t view_yaw_q = 0;
@@ -323,6 +384,28 @@ struct StateSnapshotDelta {
   uint32_t loadout_bits = 0;
 };
 
+struct WorldSnapshot {
+  int server_tick = 0;
+  std::vector<StateSnapshot> snapshots;
+  std::vector<StateSnapshotDelta> deltas;
+};
+
+// Entries of a WorldSnapshot are packed deltas first, then keyframes; first_entry/entry_count index
+// that combined order.
+struct WorldSnapshotPacket {
+  std::vector<uint8_t> message;
+  size_t first_entry = 0;
+  size_t entry_count = 0;
+};
+
+// One StateSnapshot or StateSnapshotDelta table encoded on its own, so it can be copied into any number
+// of WorldSnapshot packets for the same server tick without being encoded again.
+struct EncodedSnapshotEntry {
+  std::vector<uint8_t> bytes;
+  uint32_t table_offset = 0;
+  bool delta = false;
+};
+
 struct PlayerProfile {
   std::string client_id;
   std::string nickname;
@@ -344,7 +427,9 @@ enum class MessageType : uint16_t {
   Error = 12,
   Disconnect = 13,
   FireWeaponRequest = 14,
-  SetLoadoutRequest = 15
+  SetLoadoutRequest = 15,
+  WorldSnapshot = 16,
+  DecalDebugReport = 17
 };
 
 struct MessageHeader {
@@ -355,23 +440,52 @@ struct MessageHeader {
   uint32_t server_seq_ack = 0;
 };
 
+// Bytes owned by someone else, e.g. a received DataChannel message. Converts from a vector so
+// callers holding one can pass it straight through.
+class ByteSpan {
+public:
+  ByteSpan() = default;
+  ByteSpan(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+  ByteSpan(const std::vector<uint8_t> &bytes) : data_(bytes.data()), size_(bytes.size()) {}
+
+  const uint8_t *data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+private:
+  const uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+};
+
 struct DecodedEnvelope {
   MessageHeader header;
   std::vector<uint8_t> payload;
 };
 
+// DecodedEnvelope without the payload copy; payload points into the decoded message.
+struct EnvelopeView {
+  MessageHeader header;
+  ByteSpan payload;
+};
+
 bool DecodeEnvelope(const std::vector<uint8_t> &message, DecodedEnvelope &out, std::string &error);
+// Same checks as DecodeEnvelope. Used on the receive path, which verifies and reads payloads in
+// place so a message costs no heap allocation.
+bool DecodeEnvelopeView(ByteSpan message, EnvelopeView &out, std::string &error);
 std::vector<uint8_t> EncodeEnvelope(MessageType type, const uint8_t *payload, size_t payload_size,
                                     uint32_t msg_seq, uint32_t server_seq_ack,
                                     uint16_t protocol_version = static_cast<uint16_t>(kProtocolVersion));
-
-bool ParseClientHelloPayload(const std::vector<uint8_t> &payload, ClientHello &out, std::string &error);
-bool ParseInputCmdPayload(const std::vector<uint8_t> &payload, InputCmd &out, std::string &error);
-bool ParseFireWeaponRequestPayload(const std::vector<uint8_t> &payload, FireWeaponRequest &out,
-                                   std::string &error);
-bool ParseSetLoadoutRequestPayload(const std::vector<uint8_t> &payload, SetLoadoutRequest &out,
-                                   std::string &error);
-bool ParsePingPayload(const std::vector<uint8_t> &payload, Ping &out, std::string &error);
+// Rewrites msg_seq/server_seq_ack of an already encoded envelope in place so a payload built once
+// can be fanned out to many recipients.
+bool StampEnvelopeSequence(std::vector<uint8_t> &message, uint32_t msg_seq, uint32_t server_seq_ack);
+
+bool ParseClientHelloPayload(ByteSpan payload, ClientHello &out, std::string &error);
+// Rejects more than kMaxInputFramesPerCmd frames and frames not in strictly decreasing input_seq order.
+bool ParseInputCmdPayload(ByteSpan payload, InputCmdFrames &out, std::string &error);
+bool ParseDecalDebugReportPayload(ByteSpan payload, DecalDebugReport &out, std::string &error);
+bool ParseFireWeaponRequestPayload(ByteSpan payload, FireWeaponRequest &out, std::string &error);
+bool ParseSetLoadoutRequestPayload(ByteSpan payload, SetLoadoutRequest &out, std::string &error);
+bool ParsePingPayload(ByteSpan payload, Ping &out, std::string &error);
 std::vector<uint8_t> BuildServerHello(const ServerHello &hello, uint32_t msg_seq, uint32_t server_seq_ack);
 std::vector<uint8_t> BuildProtocolError(const std::string &code, const std::string &message,
                                         uint32_t msg_seq, uint32_t server_seq_ack);
@@ -380,4 +494,48 @@ std::vector<uint8_t> BuildGameEventBatch(const GameEventBatch &event, uint32_t m
 std::vector<uint8_t> BuildStateSnapshot(const StateSnapshot &snapshot, uint32_t msg_seq, uint32_t server_seq_ack);
 std::vector<uint8_t> BuildStateSnapshotDelta(const StateSnapshotDelta &delta, uint32_t msg_seq,
                                              uint32_t server_seq_ack);
+SnapshotBaseline ToSnapshotBaseline(const StateSnapshot &snapshot);
+StateSnapshotDelta DiffStateSnapshot(const SnapshotBaseline &baseline, const StateSnapshot &snapshot);
+int16_t QuantizeSnapshotPosition(double meters);
+double DequantizeSnapshotPosition(int16_t value);
+int16_t QuantizeSnapshotVelocity(double meters_per_second);
+double DequantizeSnapshotVelocity(int16_t value);
+uint8_t QuantizeSnapshotDashCooldown(double seconds);
+double DequantizeSnapshotDashCooldown(uint8_t value);
+uint16_t QuantizeSnapshotHealth(double health);
+double DequantizeSnapshotHealth(uint16_t value);
+
+// Largest magnitudes the server can put in each quantized snapshot field for a given map and config.
+struct SnapshotFieldBounds {
+  double max_abs_position = 0.0;
+  double max_dash_cooldown = 0.0;
+  double max_health = 0.0;
+  int max_ammo_in_mag = 0;
+};
+
+// The quantizers clamp silently, so this is checked once at startup. Fails naming the first field whose
+// bound the wire encoding cannot carry.
+bool ValidateSnapshotFieldBounds(const SnapshotFieldBounds &bounds, std::string &error);
+// View angles share one encoding between snapshots and inputs: yaw wraps to [-pi, pi] and pitch
+// clamps to the sim's limit, each scaled onto [-32767, 32767].
+int16_t QuantizeViewYaw(double yaw_rad);
+double DequantizeViewYaw(int16_t value);
+int16_t QuantizeViewPitch(double pitch_rad);
+double DequantizeViewPitch(int16_t value);
+int8_t QuantizeInputAxis(double value);
+double DequantizeInputAxis(int8_t value);
+uint16_t PackInputButtons(const InputCmd &cmd);
+std::vector<uint8_t> BuildWorldSnapshot(const WorldSnapshot &world, uint32_t msg_seq, uint32_t server_seq_ack);
+// Splits a world snapshot into envelopes of at most max_packet_bytes; an entry that cannot fit on its own
+// is still sent alone. Sequence fields are zero and are expected to be set with StampEnvelopeSequence.
+std::vector<WorldSnapshotPacket> BuildWorldSnapshotPackets(const WorldSnapshot &world,
+                                                           size_t max_packet_bytes = kMaxSnapshotPacketBytes);
+// world_tick is the server_tick of the WorldSnapshot the entry will be sent in.
+EncodedSnapshotEntry EncodeSnapshotEntry(const StateSnapshot &snapshot, int world_tick);
+EncodedSnapshotEntry EncodeSnapshotEntry(const StateSnapshotDelta &delta, int world_tick);
+// Packs already encoded entries into WorldSnapshot envelopes in order, filling each packet greedily up to
+// max_packet_bytes. first_entry/entry_count index the entries vector.
+std::vector<WorldSnapshotPacket> BuildWorldSnapshotPackets(int server_tick,
+                                                           const std::vector<const EncodedSnapshotEntry *> &entries,
+                                                           size_t max_packet_bytes = kMaxSnapshotPacketBytes);
 std::vector<uint8_t> BuildPlayerProfile(const PlayerProfile &profile, uint32_t msg_seq, uint32_t server_seq_ack);
@@ -0,0 +1,573 @@
+#include "ray_kernels.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define AFPS_RAY_KERNELS_X86 1
+#else
+#define AFPS_RAY_KERNELS_X86 0
+#endif
+
+namespace afps::combat {
+namespace {
+constexpr double kParallelEpsilon = 1e-8;
+
+// Scalar lanes mirror the single-primitive tests the kernels replaced, operation for operation.
+bool ScalarBoxLane(const KernelRay &ray, const BoxLanes &boxes, size_t lane, double &t_enter, double &t_exit) {
+  const double mins[3] = {boxes.min_x[lane], boxes.min_y[lane], boxes.min_z[lane]};
+  const double maxs[3] = {boxes.max_x[lane], boxes.max_y[lane], boxes.max_z[lane]};
+  double t_min = -std::numeric_limits<double>::infinity();
+  double t_max = std::numeric_limits<double>::infinity();
+  for (int axis = 0; axis < 3; ++axis) {
+    const double origin = ray.origin[axis];
+    const double dir = ray.dir[axis];
+    if (std::abs(dir) < kParallelEpsilon) {
+      if (!(origin >= mins[axis] && origin <= maxs[axis])) {
+        return false;
+      }
+      continue;
+    }
+    double t1 = (mins[axis] - origin) / dir;
+    double t2 = (maxs[axis] - origin) / dir;
+    if (t1 > t2) {
+      std::swap(t1, t2);
+    }
+    t_min = std::max(t_min, t1);
+    t_max = std::min(t_max, t2);
+    if (!(t_min <= t_max)) {
+      return false;
+    }
+  }
+  t_enter = t_min;
+  t_exit = t_max;
+  return true;
+}
+
+bool ScalarTriangleLane(const KernelRay &ray,
+                        const TriangleLanes &triangles,
+                        size_t lane,
+                        double max_distance,
+                        double &out_t) {
+  const double v0[3] = {triangles.v0_x[lane], triangles.v0_y[lane], triangles.v0_z[lane]};
+  const double edge1[3] = {triangles.v1_x[lane] - v0[0], triangles.v1_y[lane] - v0[1], triangles.v1_z[lane] - v0[2]};
+  const double edge2[3] = {triangles.v2_x[lane] - v0[0], triangles.v2_y[lane] - v0[1], triangles.v2_z[lane] - v0[2]};
+  const double *dir = ray.dir;
+  const double pvec[3] = {dir[1] * edge2[2] - dir[2] * edge2[1], dir[2] * edge2[0] - dir[0] * edge2[2],
+                          dir[0] * edge2[1] - dir[1] * edge2[0]};
+  const double det = edge1[0] * pvec[0] + edge1[1] * pvec[1] + edge1[2] * pvec[2];
+  if (std::abs(det) <= kParallelEpsilon) {
+    return false;
+  }
+  const double inv_det = 1.0 / det;
+  const double tvec[3] = {ray.origin[0] - v0[0], ray.origin[1] - v0[1], ray.origin[2] - v0[2]};
+  const double u = (tvec[0] * pvec[0] + tvec[1] * pvec[1] + tvec[2] * pvec[2]) * inv_det;
+  if (u < 0.0 || u > 1.0) {
+    return false;
+  }
+  const double qvec[3] = {tvec[1] * edge1[2] - tvec[2] * edge1[1], tvec[2] * edge1[0] - tvec[0] * edge1[2],
+                          tvec[0] * edge1[1] - tvec[1] * edge1[0]};
+  const double v = (dir[0] * qvec[0] + dir[1] * qvec[1] + dir[2] * qvec[2]) * inv_det;
+  if (v < 0.0 || (u + v) > 1.0) {
+    return false;
+  }
+  const double t = (edge2[0] * qvec[0] + edge2[1] * qvec[1] + edge2[2] * qvec[2]) * inv_det;
+  if (!std::isfinite(t) || t < 0.0 || t > max_distance) {
+    return false;
+  }
+  out_t = t;
+  return true;
+}
+
+bool ScalarCylinderLane(const KernelRay &ray,
+                        const CylinderLanes &cylinders,
+                        size_t lane,
+                        double height,
+                        double radius,
+                        double &t) {
+  const double a = ray.dir[0] * ray.dir[0] + ray.dir[1] * ray.dir[1];
+  const double ox = ray.origin[0] - cylinders.base_x[lane];
+  const double oy = ray.origin[1] - cylinders.base_y[lane];
+  if (a <= kParallelEpsilon) {
+    return false;
+  }
+  const double base_z = cylinders.base_z[lane];
+  const double b = 2.0 * (ox * ray.dir[0] + oy * ray.dir[1]);
+  const double c = ox * ox + oy * oy - radius * radius;
+  const double discriminant = b * b - 4.0 * a * c;
+  if (discriminant < 0.0) {
+    return false;
+  }
+  const double sqrt_disc = std::sqrt(discriminant);
+  const double t0 = (-b - sqrt_disc) / (2.0 * a);
+  const double t1 = (-b + sqrt_disc) / (2.0 * a);
+  if (t1 < 0.0) {
+    return false;
+  }
+  double candidate = t0 >= 0.0 ? t0 : t1;
+  double hit_z = ray.origin[2] + ray.dir[2] * candidate;
+  if (hit_z < base_z || hit_z > base_z + height) {
+    if (candidate == t1) {
+      return false;
+    }
+    candidate = t1;
+    hit_z = ray.origin[2] + ray.dir[2] * candidate;
+    if (hit_z < base_z || hit_z > base_z + height) {
+      return false;
+    }
+  }
+  t = candidate;
+  return true;
+}
+
+#if AFPS_RAY_KERNELS_X86
+// Generic vector kernels written with GCC/Clang vector extensions. They are force-inlined into the
+// SSE2 (2 x double) and AVX2 (4 x double) entry points below, so each copy is compiled for the
+// instruction set of its caller. Every comparison and select mirrors the scalar lane above,
+// including std::max/std::min tie handling, which keeps results bit-identical.
+#define AFPS_KERNEL_INLINE inline __attribute__((always_inline))
+
+typedef double Double2 __attribute__((vector_size(16)));
+typedef long long Mask2 __attribute__((vector_size(16)));
+typedef double Double4 __attribute__((vector_size(32)));
+typedef long long Mask4 __attribute__((vector_size(32)));
+
+template <typename V>
+struct VectorMask;
+template <>
+struct VectorMask<Double2> {
+  using type = Mask2;
+};
+template <>
+struct VectorMask<Double4> {
+  using type = Mask4;
+};
+
+template <typename V, size_t W = sizeof(V) / sizeof(double)>
+AFPS_KERNEL_INLINE void KernelBoxes(const KernelRay &ray,
+                                    const BoxLanes &boxes,
+                                    size_t first,
+                                    double *t_enter,
+                                    double *t_exit,
+                                    uint32_t &mask_out) {
+  using M = typename VectorMask<V>::type;
+  const double *mins[3] = {boxes.min_x + first, boxes.min_y + first, boxes.min_z + first};
+  const double *maxs[3] = {boxes.max_x + first, boxes.max_y + first, boxes.max_z + first};
+  V t_min;
+  V t_max;
+  for (size_t i = 0; i < W; ++i) {
+    t_min[i] = -std::numeric_limits<double>::infinity();
+    t_max[i] = std::numeric_limits<double>::infinity();
+  }
+  M ok = t_min == t_min;
+  for (int axis = 0; axis < 3; ++axis) {
+    V lo;
+    V hi;
+    std::memcpy(&lo, mins[axis], sizeof(V));
+    std::memcpy(&hi, maxs[axis], sizeof(V));
+    V origin;
+    for (size_t i = 0; i < W; ++i) {
+      origin[i] = ray.origin[axis];
+    }
+    const double dir = ray.dir[axis];
+    if (std::abs(dir) < kParallelEpsilon) {
+      ok &= (origin >= lo) & (origin <= hi);
+      continue;
+    }
+    V dir_v;
+    for (size_t i = 0; i < W; ++i) {
+      dir_v[i] = dir;
+    }
+    const V t1 = (lo - origin) / dir_v;
+    const V t2 = (hi - origin) / dir_v;
+    const M swapped = t1 > t2;
+    const V near_t = swapped ? t2 : t1;
+    const V far_t = swapped ? t1 : t2;
+    t_min = (t_min < near_t) ? near_t : t_min;
+    t_max = (far_t < t_max) ? far_t : t_max;
+    ok &= t_min <= t_max;
+  }
+  std::memcpy(t_enter + first, &t_min, sizeof(V));
+  std::memcpy(t_exit + first, &t_max, sizeof(V));
+  for (size_t i = 0; i < W; ++i) {
+    if (ok[i]) {
+      mask_out |= 1u << (first + i);
+    }
+  }
+}
+
+template <typename V, size_t W = sizeof(V) / sizeof(double)>
+AFPS_KERNEL_INLINE void KernelTriangles(const KernelRay &ray,
+                                        const TriangleLanes &triangles,
+                                        size_t first,
+                                        double max_distance,
+                                        double *t_out,
+                                        uint32_t &mask_out) {
+  using M = typename VectorMask<V>::type;
+  V v0[3];
+  V v1[3];
+  V v2[3];
+  std::memcpy(&v0[0], triangles.v0_x + first, sizeof(V));
+  std::memcpy(&v0[1], triangles.v0_y + first, sizeof(V));
+  std::memcpy(&v0[2], triangles.v0_z + first, sizeof(V));
+  std::memcpy(&v1[0], triangles.v1_x + first, sizeof(V));
+  std::memcpy(&v1[1], triangles.v1_y + first, sizeof(V));
+  std::memcpy(&v1[2], triangles.v1_z + first, sizeof(V));
+  std::memcpy(&v2[0], triangles.v2_x + first, sizeof(V));
+  std::memcpy(&v2[1], triangles.v2_y + first, sizeof(V));
+  std::memcpy(&v2[2], triangles.v2_z + first, sizeof(V));
+  V dir[3];
+  V origin[3];
+  V eps;
+  V zero;
+  V one;
+  V limit;
+  for (size_t i = 0; i < W; ++i) {
+    for (int axis = 0; axis < 3; ++axis) {
+      dir[axis][i] = ray.dir[axis];
+      origin[axis][i] = ray.origin[axis];
+    }
+    eps[i] = kParallelEpsilon;
+    zero[i] = 0.0;
+    one[i] = 1.0;
+    limit[i] = max_distance;
+  }
+
+  const V edge1[3] = {v1[0] - v0[0], v1[1] - v0[1], v1[2] - v0[2]};
+  const V edge2[3] = {v2[0] - v0[0], v2[1] - v0[1], v2[2] - v0[2]};
+  const V pvec[3] = {dir[1] * edge2[2] - dir[2] * edge2[1], dir[2] * edge2[0] - dir[0] * edge2[2],
+                     dir[0] * edge2[1] - dir[1] * edge2[0]};
+  const V det = edge1[0] * pvec[0] + edge1[1] * pvec[1] + edge1[2] * pvec[2];
+  const V abs_det = det < zero ? -det : det;
+  M miss = abs_det <= eps;
+  const V inv_det = one / det;
+  const V tvec[3] = {origin[0] - v0[0], origin[1] - v0[1], origin[2] - v0[2]};
+  const V u = (tvec[0] * pvec[0] + tvec[1] * pvec[1] + tvec[2] * pvec[2]) * inv_det;
+  miss |= (u < zero) | (u > one);
+  const V qvec[3] = {tvec[1] * edge1[2] - tvec[2] * edge1[1], tvec[2] * edge1[0] - tvec[0] * edge1[2],
+                     tvec[0] * edge1[1] - tvec[1] * edge1[0]};
+  const V v = (dir[0] * qvec[0] + dir[1] * qvec[1] + dir[2] * qvec[2]) * inv_det;
+  miss |= (v < zero) | ((u + v) > one);
+  const V t = (edge2[0] * qvec[0] + edge2[1] * qvec[1] + edge2[2] * qvec[2]) * inv_det;
+  // t - t is 0 only for finite t, matching the scalar std::isfinite check.
+  miss |= ~((t - t) == zero) | (t < zero) | (t > limit);
+  std::memcpy(t_out + first, &t, sizeof(V));
+  for (size_t i = 0; i < W; ++i) {
+    if (!miss[i]) {
+      mask_out |= 1u << (first + i);
+    }
+  }
+}
+
+template <typename V, size_t W = sizeof(V) / sizeof(double)>
+AFPS_KERNEL_INLINE void KernelCylinders(const KernelRay &ray,
+                                        const CylinderLanes &cylinders,
+                                        size_t first,
+                                        double a,
+                                        double height,
+                                        double radius,
+                                        double *t_out,
+                                        uint32_t &mask_out) {
+  using M = typename VectorMask<V>::type;
+  V base_x;
+  V base_y;
+  V base_z;
+  std::memcpy(&base_x, cylinders.base_x + first, sizeof(V));
+  std::memcpy(&base_y, cylinders.base_y + first, sizeof(V));
+  std::memcpy(&base_z, cylinders.base_z + first, sizeof(V));
+  V origin[3];
+  V dir[3];
+  V a_v;
+  V two;
+  V four;
+  V zero;
+  V radius_v;
+  V height_v;
+  for (size_t i = 0; i < W; ++i) {
+    for (int axis = 0; axis < 3; ++axis) {
+      origin[axis][i] = ray.origin[axis];
+      dir[axis][i] = ray.dir[axis];
+    }
+    a_v[i] = a;
+    two[i] = 2.0;
+    four[i] = 4.0;
+    zero[i] = 0.0;
+    radius_v[i] = radius;
+    height_v[i] = height;
+  }
+  const V ox = origin[0] - base_x;
+  const V oy = origin[1] - base_y;
+  const V b = two * (ox * dir[0] + oy * dir[1]);
+  const V c = ox * ox + oy * oy - radius_v * radius_v;
+  const V discriminant = b * b - four * a_v * c;
+  M miss = discriminant < zero;
+  V sqrt_disc;
+  for (size_t i = 0; i < W; ++i) {
+    sqrt_disc[i] = miss[i] ? 0.0 : std::sqrt(discriminant[i]);
+  }
+  const V t0 = (-b - sqrt_disc) / (two * a_v);
+  const V t1 = (-b + sqrt_disc) / (two * a_v);
+  miss |= t1 < zero;
+  const V candidate = t0 >= zero ? t0 : t1;
+  const V top = base_z + height_v;
+  const V hit_z = origin[2] + dir[2] * candidate;
+  const M outside = (hit_z < base_z) | (hit_z > top);
+  miss |= outside & (candidate == t1);
+  const V retry = outside ? t1 : candidate;
+  const V retry_z = origin[2] + dir[2] * retry;
+  miss |= (retry_z < base_z) | (retry_z > top);
+  std::memcpy(t_out + first, &retry, sizeof(V));
+  for (size_t i = 0; i < W; ++i) {
+    if (!miss[i]) {
+      mask_out |= 1u << (first + i);
+    }
+  }
+}
+
+uint32_t Sse2Boxes(const KernelRay &ray, const BoxLanes &boxes, double *t_enter, double *t_exit) {
+  uint32_t mask = 0;
+  KernelBoxes<Double2>(ray, boxes, 0, t_enter, t_exit, mask);
+  KernelBoxes<Double2>(ray, boxes, 2, t_enter, t_exit, mask);
+  return mask;
+}
+
+uint32_t Sse2Triangles(const KernelRay &ray, const TriangleLanes &triangles, double max_distance, double *t) {
+  uint32_t mask = 0;
+  KernelTriangles<Double2>(ray, triangles, 0, max_distance, t, mask);
+  KernelTriangles<Double2>(ray, triangles, 2, max_distance, t, mask);
+  return mask;
+}
+
+uint32_t Sse2Cylinders(const KernelRay &ray,
+                       const CylinderLanes &cylinders,
+                       double a,
+                       double height,
+                       double radius,
+                       double *t) {
+  uint32_t mask = 0;
+  KernelCylinders<Double2>(ray, cylinders, 0, a, height, radius, t, mask);
+  KernelCylinders<Double2>(ray, cylinders, 2, a, height, radius, t, mask);
+  return mask;
+}
+
+// AVX2 without FMA: fused multiply-adds would round differently from the scalar lanes.
+__attribute__((target("avx2"))) uint32_t Avx2Boxes(const KernelRay &ray,
+                                                   const BoxLanes &boxes,
+                                                   double *t_enter,
+                                                   double *t_exit) {
+  uint32_t mask = 0;
+  KernelBoxes<Double4>(ray, boxes, 0, t_enter, t_exit, mask);
+  return mask;
+}
+
+__attribute__((target("avx2"))) uint32_t Avx2Triangles(const KernelRay &ray,
+                                                       const TriangleLanes &triangles,
+                                                       double max_distance,
+                                                       double *t) {
+  uint32_t mask = 0;
+  KernelTriangles<Double4>(ray, triangles, 0, max_distance, t, mask);
+  return mask;
+}
+
+__attribute__((target("avx2"))) uint32_t Avx2Cylinders(const KernelRay &ray,
+                                                       const CylinderLanes &cylinders,
+                                                       double a,
+                                                       double height,
+                                                       double radius,
+                                                       double *t) {
+  uint32_t mask = 0;
+  KernelCylinders<Double4>(ray, cylinders, 0, a, height, radius, t, mask);
+  return mask;
+}
+#endif
+
+uint32_t LaneMask(size_t count) {
+  return count >= kRayKernelLanes ? (1u << kRayKernelLanes) - 1u : (1u << count) - 1u;
+}
+
+RayKernelBackend ParseRayKernelBackend(const char *raw, RayKernelBackend fallback, bool &recognized) {
+  recognized = true;
+  if (!raw || raw[0] == '\0') {
+    return fallback;
+  }
+  std::string value(raw);
+  value.erase(std::remove_if(value.begin(), value.end(), [](unsigned char ch) {
+                return std::isspace(ch) != 0;
+              }),
+              value.end());
+  std::transform(value.begin(), value.end(), value.begin(), [](unsigned char ch) {
+    return static_cast<char>(std::tolower(ch));
+  });
+  if (value == "scalar") {
+    return RayKernelBackend::Scalar;
+  }
+  if (value == "sse2") {
+    return RayKernelBackend::Sse2;
+  }
+  if (value == "avx2") {
+    return RayKernelBackend::Avx2;
+  }
+  recognized = false;
+  return fallback;
+}
+}  // namespace
+
+bool RayKernelBackendSupported(RayKernelBackend backend) {
+  switch (backend) {
+    case RayKernelBackend::Scalar:
+      return true;
+#if AFPS_RAY_KERNELS_X86
+    case RayKernelBackend::Sse2:
+      return __builtin_cpu_supports("sse2");
+    case RayKernelBackend::Avx2:
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+const char *RayKernelBackendName(RayKernelBackend backend) {
+  switch (backend) {
+    case RayKernelBackend::Sse2:
+      return "sse2";
+    case RayKernelBackend::Avx2:
+      return "avx2";
+    case RayKernelBackend::Scalar:
+    default:
+      return "scalar";
+  }
+}
+
+RayKernelBackend ActiveRayKernelBackend() {
+  static const RayKernelBackend backend = [] {
+    RayKernelBackend best = RayKernelBackend::Scalar;
+    if (RayKernelBackendSupported(RayKernelBackend::Avx2)) {
+      best = RayKernelBackend::Avx2;
+    } else if (RayKernelBackendSupported(RayKernelBackend::Sse2)) {
+      best = RayKernelBackend::Sse2;
+    }
+    bool recognized = true;
+    const RayKernelBackend requested = ParseRayKernelBackend(std::getenv("AFPS_RAY_KERNEL"), best, recognized);
+    if (!recognized) {
+      std::cerr << "[warn] invalid AFPS_RAY_KERNEL value; expected scalar|sse2|avx2. Using "
+                << RayKernelBackendName(best) << ".\n";
+    }
+    return std::min(requested, best);
+  }();
+  return backend;
+}
+
+uint32_t RaycastBoxLanes(const KernelRay &ray,
+                         const BoxLanes &boxes,
+                         size_t count,
+                         double t_enter[kRayKernelLanes],
+                         double t_exit[kRayKernelLanes]) {
+  return RaycastBoxLanes(ActiveRayKernelBackend(), ray, boxes, count, t_enter, t_exit);
+}
+
+uint32_t RaycastBoxLanes(RayKernelBackend backend,
+                         const KernelRay &ray,
+                         const BoxLanes &boxes,
+                         size_t count,
+                         double t_enter[kRayKernelLanes],
+                         double t_exit[kRayKernelLanes]) {
+#if AFPS_RAY_KERNELS_X86
+  if (backend == RayKernelBackend::Avx2) {
+    return Avx2Boxes(ray, boxes, t_enter, t_exit) & LaneMask(count);
+  }
+  if (backend == RayKernelBackend::Sse2) {
+    return Sse2Boxes(ray, boxes, t_enter, t_exit) & LaneMask(count);
+  }
+#else
+  (void)backend;
+#endif
+  uint32_t mask = 0;
+  for (size_t lane = 0; lane < std::min(count, kRayKernelLanes); ++lane) {
+    if (ScalarBoxLane(ray, boxes, lane, t_enter[lane], t_exit[lane])) {
+      mask |= 1u << lane;
+    }
+  }
+  return mask;
+}
+
+uint32_t RaycastTriangleLanes(const KernelRay &ray,
+                              const TriangleLanes &triangles,
+                              size_t count,
+                              double max_distance,
+                              double t[kRayKernelLanes]) {
+  return RaycastTriangleLanes(ActiveRayKernelBackend(), ray, triangles, count, max_distance, t);
+}
+
+uint32_t RaycastTriangleLanes(RayKernelBackend backend,
+                              const KernelRay &ray,
+                              const TriangleLanes &triangles,
+                              size_t count,
+                              double max_distance,
+                              double t[kRayKernelLanes]) {
+#if AFPS_RAY_KERNELS_X86
+  if (backend == RayKernelBackend::Avx2) {
+    return Avx2Triangles(ray, triangles, max_distance, t) & LaneMask(count);
+  }
+  if (backend == RayKernelBackend::Sse2) {
+    return Sse2Triangles(ray, triangles, max_distance, t) & LaneMask(count);
+  }
+#else
+  (void)backend;
+#endif
+  uint32_t mask = 0;
+  for (size_t lane = 0; lane < std::min(count, kRayKernelLanes); ++lane) {
+    if (ScalarTriangleLane(ray, triangles, lane, max_distance, t[lane])) {
+      mask |= 1u << lane;
+    }
+  }
+  return mask;
+}
+
+uint32_t RaycastCylinderLanes(const KernelRay &ray,
+                              const CylinderLanes &cylinders,
+                              size_t count,
+                              double height,
+                              double radius,
+                              double t[kRayKernelLanes]) {
+  return RaycastCylinderLanes(ActiveRayKernelBackend(), ray, cylinders, count, height, radius, t);
+}
+
+uint32_t RaycastCylinderLanes(RayKernelBackend backend,
+                              const KernelRay &ray,
+                              const CylinderLanes &cylinders,
+                              size_t count,
+                              double height,
+                              double radius,
+                              double t[kRayKernelLanes]) {
+#if AFPS_RAY_KERNELS_X86
+  if (backend == RayKernelBackend::Avx2 || backend == RayKernelBackend::Sse2) {
+    // The horizontal term only depends on the ray, so a near-vertical ray misses every lane.
+    const double a = ray.dir[0] * ray.dir[0] + ray.dir[1] * ray.dir[1];
+    if (a <= kParallelEpsilon) {
+      return 0;
+    }
+    const uint32_t mask = backend == RayKernelBackend::Avx2
+                              ? Avx2Cylinders(ray, cylinders, a, height, radius, t)
+                              : Sse2Cylinders(ray, cylinders, a, height, radius, t);
+    return mask & LaneMask(count);
+  }
+#else
+  (void)backend;
+#endif
+  uint32_t mask = 0;
+  for (size_t lane = 0; lane < std::min(count, kRayKernelLanes); ++lane) {
+    if (ScalarCylinderLane(ray, cylinders, lane, height, radius, t[lane])) {
+      mask |= 1u << lane;
+    }
+  }
+  return mask;
+}
+
+}  // namespace afps::combat
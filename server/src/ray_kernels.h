@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace afps::combat {
+
+// Primitives tested per kernel call. Callers pass count <= kRayKernelLanes; lanes at or past
+// count are ignored and never reported as hits.
+constexpr size_t kRayKernelLanes = 4;
+
+// The SIMD backends evaluate the same IEEE double operations in the same order as the scalar
+// backend (no FMA contraction, no reciprocal approximations), so every backend reports the same
+// hit mask and bit-identical distances. The only tolerance is the shared 1e-8 threshold below
+// which a direction axis is treated as parallel or a triangle as degenerate.
+enum class RayKernelBackend : uint8_t {
+  Scalar = 0,
+  Sse2 = 1,
+  Avx2 = 2,
+};
+
+struct KernelRay {
+  double origin[3] = {0.0, 0.0, 0.0};
+  double dir[3] = {0.0, 0.0, 0.0};
+};
+
+struct BoxLanes {
+  double min_x[kRayKernelLanes] = {};
+  double min_y[kRayKernelLanes] = {};
+  double min_z[kRayKernelLanes] = {};
+  double max_x[kRayKernelLanes] = {};
+  double max_y[kRayKernelLanes] = {};
+  double max_z[kRayKernelLanes] = {};
+};
+
+struct TriangleLanes {
+  double v0_x[kRayKernelLanes] = {};
+  double v0_y[kRayKernelLanes] = {};
+  double v0_z[kRayKernelLanes] = {};
+  double v1_x[kRayKernelLanes] = {};
+  double v1_y[kRayKernelLanes] = {};
+  double v1_z[kRayKernelLanes] = {};
+  double v2_x[kRayKernelLanes] = {};
+  double v2_y[kRayKernelLanes] = {};
+  double v2_z[kRayKernelLanes] = {};
+};
+
+// Vertical player capsules approximated as cylinders standing on base.
+struct CylinderLanes {
+  double base_x[kRayKernelLanes] = {};
+  double base_y[kRayKernelLanes] = {};
+  double base_z[kRayKernelLanes] = {};
+};
+
+bool RayKernelBackendSupported(RayKernelBackend backend);
+const char *RayKernelBackendName(RayKernelBackend backend);
+
+// Widest backend the CPU supports, capped by AFPS_RAY_KERNEL=scalar|sse2|avx2. Resolved once.
+RayKernelBackend ActiveRayKernelBackend();
+
+// Slab test against count boxes. Returns a bitmask of boxes whose slabs the ray's line overlaps
+// and writes the unclamped entry/exit distances for those lanes.
+uint32_t RaycastBoxLanes(const KernelRay &ray,
+                         const BoxLanes &boxes,
+                         size_t count,
+                         double t_enter[kRayKernelLanes],
+                         double t_exit[kRayKernelLanes]);
+uint32_t RaycastBoxLanes(RayKernelBackend backend,
+                         const KernelRay &ray,
+                         const BoxLanes &boxes,
+                         size_t count,
+                         double t_enter[kRayKernelLanes],
+                         double t_exit[kRayKernelLanes]);
+
+// Double-sided Moller-Trumbore test against count triangles. Returns a bitmask of triangles hit
+// with t in [0, max_distance] and writes t for those lanes.
+uint32_t RaycastTriangleLanes(const KernelRay &ray,
+                              const TriangleLanes &triangles,
+                              size_t count,
+                              double max_distance,
+                              double t[kRayKernelLanes]);
+uint32_t RaycastTriangleLanes(RayKernelBackend backend,
+                              const KernelRay &ray,
+                              const TriangleLanes &triangles,
+                              size_t count,
+                              double max_distance,
+                              double t[kRayKernelLanes]);
+
+// Ray against count vertical cylinders of the given height and radius. Returns a bitmask of
+// cylinders hit at t >= 0 (nearest side within the height span) and writes t for those lanes.
+uint32_t RaycastCylinderLanes(const KernelRay &ray,
+                              const CylinderLanes &cylinders,
+                              size_t count,
+                              double height,
+                              double radius,
+                              double t[kRayKernelLanes]);
+uint32_t RaycastCylinderLanes(RayKernelBackend backend,
+                              const KernelRay &ray,
+                              const CylinderLanes &cylinders,
+                              size_t count,
+                              double height,
+                              double radius,
+                              double t[kRayKernelLanes]);
+
+}  // namespace afps::combat
@@ -0,0 +1,157 @@
+#include "room_manager.h"
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+#include "work_pool.h"
+
+namespace {
+constexpr auto kMetricsLogInterval = std::chrono::seconds(1);
+
+void WriteRoomMetrics(std::ostream &out, const RoomMetrics &room) {
+  out << "\"room\":\"" << room.room_id << "\",\"map_seed\":" << room.map_seed
+      << ",\"players\":" << room.players << ",\"runs\":" << room.ticks.runs
+      << ",\"late_runs\":" << room.ticks.late_runs << ",\"last_tick_ms\":" << room.ticks.last_run_ms
+      << ",\"avg_tick_ms\":" << room.ticks.avg_run_ms << ",\"max_tick_ms\":" << room.ticks.max_run_ms
+      << ",\"max_lateness_ms\":" << room.ticks.max_lateness_ms << ",\"last_flush_ms\":" << room.last_flush_ms
+      << ",\"max_flush_ms\":" << room.max_flush_ms;
+}
+
+void WriteSendMetrics(std::ostream &out, const SendPoolMetrics &send) {
+  out << "\"batches\":" << send.batches << ",\"dropped_batches\":" << send.dropped_batches
+      << ",\"bundles\":" << send.bundles << ",\"failed_bundles\":" << send.failed_bundles
+      << ",\"bytes\":" << send.bytes << ",\"avg_send_ms\":" << send.avg_send_ms
+      << ",\"max_send_ms\":" << send.max_send_ms << ",\"max_queue_ms\":" << send.max_queue_ms
+      << ",\"max_pending_bytes\":" << send.max_pending_bytes;
+}
+}  // namespace
+
+RoomManager::RoomManager(SignalingStore &store,
+                         const std::vector<RoomSpec> &rooms,
+                         int tick_rate,
+                         int snapshot_keyframe_interval,
+                         bool interest_occlusion,
+                         size_t worker_count,
+                         size_t movement_workers)
+    : store_(store),
+      scheduler_(worker_count == 0 ? TickScheduler::DefaultWorkerCount(rooms.size()) : worker_count) {
+  if (movement_workers == 0) {
+    movement_workers = WorkPool::DefaultParticipantCount(scheduler_.worker_count());
+  }
+  rooms_.reserve(rooms.size());
+  for (const auto &spec : rooms) {
+    auto room = std::make_unique<Room>();
+    room->spec = spec;
+    room->loop = std::make_unique<TickLoop>(store, tick_rate, snapshot_keyframe_interval,
+                                            spec.map_seed, spec.map_options, interest_occlusion,
+                                            spec.id, movement_workers);
+    rooms_.push_back(std::move(room));
+  }
+}
+
+RoomManager::~RoomManager() {
+  Stop();
+}
+
+void RoomManager::Start() {
+  if (started_.load()) {
+    return;
+  }
+  const auto now = TickScheduler::Clock::now();
+  for (auto &room : rooms_) {
+    Room *target = room.get();
+    room->task = scheduler_.AddTask(
+        [target](TickScheduler::Clock::time_point at) {
+          const auto next = target->loop->Advance(at);
+          target->players.store(target->loop->player_count());
+          const double flush_ms = target->loop->last_flush_ms();
+          target->last_flush_ms.store(flush_ms);
+          if (flush_ms > target->max_flush_ms.load()) {
+            target->max_flush_ms.store(flush_ms);
+          }
+          return next;
+        },
+        room->loop->tick_duration(), now);
+  }
+  scheduler_.AddTask(
+      [this](TickScheduler::Clock::time_point at) {
+        LogMetrics();
+        return at + kMetricsLogInterval;
+      },
+      kMetricsLogInterval, now + kMetricsLogInterval);
+  // Published after every room task id is set, so Metrics() never reads an unassigned task.
+  started_.store(true);
+  scheduler_.Start();
+  std::cout << "{\"event\":\"rooms_started\",\"rooms\":" << rooms_.size()
+            << ",\"workers\":" << scheduler_.worker_count() << "}\n";
+}
+
+void RoomManager::Stop() {
+  scheduler_.Stop();
+}
+
+std::vector<RoomMetrics> RoomManager::Metrics() const {
+  std::vector<RoomMetrics> metrics;
+  metrics.reserve(rooms_.size());
+  for (const auto &room : rooms_) {
+    RoomMetrics entry;
+    entry.room_id = room->spec.id;
+    entry.map_seed = room->spec.map_seed;
+    entry.players = room->players.load();
+    entry.last_flush_ms = room->last_flush_ms.load();
+    entry.max_flush_ms = room->max_flush_ms.load();
+    if (started_.load()) {
+      entry.ticks = scheduler_.Metrics(room->task);
+    }
+    metrics.push_back(std::move(entry));
+  }
+  return metrics;
+}
+
+SendPoolMetrics RoomManager::SendMetrics() const {
+  return store_.SendMetrics();
+}
+
+size_t RoomManager::room_count() const {
+  return rooms_.size();
+}
+
+size_t RoomManager::worker_count() const {
+  return scheduler_.worker_count();
+}
+
+void RoomManager::LogMetrics() const {
+  for (const auto &room : Metrics()) {
+    std::ostringstream line;
+    line << "{\"event\":\"room_metrics\",";
+    WriteRoomMetrics(line, room);
+    line << "}\n";
+    std::cout << line.str();
+  }
+  const auto send = SendMetrics();
+  if (send.batches > 0 || send.dropped_batches > 0) {
+    std::ostringstream line;
+    line << "{\"event\":\"send_metrics\",";
+    WriteSendMetrics(line, send);
+    line << "}\n";
+    std::cout << line.str();
+  }
+}
+
+std::string BuildRoomMetricsJson(const std::vector<RoomMetrics> &metrics, const SendPoolMetrics &send) {
+  std::ostringstream out;
+  out << "{\"rooms\":[";
+  for (size_t i = 0; i < metrics.size(); ++i) {
+    if (i > 0) {
+      out << ",";
+    }
+    out << "{";
+    WriteRoomMetrics(out, metrics[i]);
+    out << "}";
+  }
+  out << "],\"send\":{";
+  WriteSendMetrics(out, send);
+  out << "}}";
+  return out.str();
+}
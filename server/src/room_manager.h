@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "map_world.h"
+#include "signaling.h"
+#include "tick.h"
+#include "tick_scheduler.h"
+
+struct RoomSpec {
+  std::string id;
+  uint32_t map_seed = 0;
+  afps::world::MapWorldOptions map_options{};
+};
+
+struct RoomMetrics {
+  std::string room_id;
+  uint32_t map_seed = 0;
+  size_t players = 0;
+  TickTaskMetrics ticks;
+  // Part of each tick spent handing queued sends to SignalingStore.
+  double last_flush_ms = 0.0;
+  double max_flush_ms = 0.0;
+};
+
+// Owns one TickLoop per room and steps them on a shared TickScheduler worker pool.
+// Rooms only see the connections SignalingStore routed to their id.
+class RoomManager {
+public:
+  RoomManager(SignalingStore &store,
+              const std::vector<RoomSpec> &rooms,
+              int tick_rate,
+              int snapshot_keyframe_interval,
+              bool interest_occlusion = false,
+              size_t worker_count = 0,
+              size_t movement_workers = 0);
+  ~RoomManager();
+
+  void Start();
+  void Stop();
+
+  std::vector<RoomMetrics> Metrics() const;
+  SendPoolMetrics SendMetrics() const;
+  size_t room_count() const;
+  size_t worker_count() const;
+
+private:
+  struct Room {
+    RoomSpec spec;
+    std::unique_ptr<TickLoop> loop;
+    size_t task = 0;
+    std::atomic<size_t> players{0};
+    std::atomic<double> last_flush_ms{0.0};
+    std::atomic<double> max_flush_ms{0.0};
+  };
+
+  void LogMetrics() const;
+
+  SignalingStore &store_;
+  std::vector<std::unique_ptr<Room>> rooms_;
+  TickScheduler scheduler_;
+  // Written by Start() and read by Metrics() from HTTP threads.
+  std::atomic<bool> started_{false};
+};
+
+std::string BuildRoomMetricsJson(const std::vector<RoomMetrics> &metrics, const SendPoolMetrics &send = {});
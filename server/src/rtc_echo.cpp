@@ -203,15 +203,20 @@ bool RtcEchoPeer::SendOn(const std::string &label, const rtc::binary &message) {
   if (label.empty()) {
     return false;
   }
-  std::shared_ptr<rtc::DataChannel> channel;
-  {
-    std::scoped_lock lock(state_->mutex);
-    auto iter = state_->channels.find(label);
-    if (iter == state_->channels.end()) {
-      return false;
-    }
-    channel = iter->second;
+  const auto channel = Channel(label);
+  return SendOnChannel(channel.get(), message);
+}
+
+std::shared_ptr<rtc::DataChannel> RtcEchoPeer::Channel(const std::string &label) {
+  std::scoped_lock lock(state_->mutex);
+  auto iter = state_->channels.find(label);
+  if (iter == state_->channels.end()) {
+    return nullptr;
   }
+  return iter->second;
+}
+
+bool RtcEchoPeer::SendOnChannel(rtc::DataChannel *channel, const rtc::binary &message) {
   if (!channel || !channel->isOpen()) {
     return false;
   }
@@ -41,6 +41,9 @@ public:
   bool SendOn(const std::string &label, const std::string &message);
   bool Send(const rtc::binary &message);
   bool SendOn(const std::string &label, const rtc::binary &message);
+  // Looks a channel up once so repeated sends skip the label map and its lock; null until created.
+  std::shared_ptr<rtc::DataChannel> Channel(const std::string &label);
+  static bool SendOnChannel(rtc::DataChannel *channel, const rtc::binary &message);
 
 private:
   std::string PrimaryLabel();
@@ -0,0 +1,147 @@
+#include "send_pool.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+SendPool::SendPool(size_t threads, SendFn send, size_t max_pending_bytes)
+    : send_(send),
+      max_pending_bytes_(max_pending_bytes),
+      thread_count_(std::max<size_t>(1, threads)),
+      shards_(new Shard[thread_count_]) {
+  for (size_t i = 0; i < thread_count_; ++i) {
+    shards_[i].thread = std::thread(&SendPool::WorkerLoop, this, std::ref(shards_[i]));
+  }
+}
+
+SendPool::~SendPool() {
+  for (size_t i = 0; i < thread_count_; ++i) {
+    {
+      std::scoped_lock lock(shards_[i].mutex);
+      shards_[i].stopping = true;
+    }
+    shards_[i].work_cv.notify_one();
+  }
+  for (size_t i = 0; i < thread_count_; ++i) {
+    if (shards_[i].thread.joinable()) {
+      shards_[i].thread.join();
+    }
+  }
+}
+
+bool SendPool::Post(size_t key, std::shared_ptr<void> target, OutboundQueue &queue, size_t max_bundle_bytes,
+                    bool droppable) {
+  if (queue.empty()) {
+    return false;
+  }
+  Shard &shard = shards_[key % thread_count_];
+  {
+    std::scoped_lock lock(shard.mutex);
+    if (droppable && shard.pending_bytes >= max_pending_bytes_) {
+      shard.metrics.dropped_batches += 1;
+      queue.Clear();
+      return false;
+    }
+    shard.pending_bytes += queue.bytes();
+    shard.metrics.max_pending_bytes = std::max(shard.metrics.max_pending_bytes, shard.pending_bytes);
+    Job job;
+    job.target = std::move(target);
+    job.queue = std::move(queue);
+    job.max_bundle_bytes = max_bundle_bytes;
+    job.posted_at = Clock::now();
+    shard.pending.push_back(std::move(job));
+    if (shard.spare.empty()) {
+      queue = OutboundQueue();
+    } else {
+      queue = std::move(shard.spare.back());
+      shard.spare.pop_back();
+    }
+  }
+  shard.work_cv.notify_one();
+  return true;
+}
+
+void SendPool::WaitIdle() {
+  for (size_t i = 0; i < thread_count_; ++i) {
+    Shard &shard = shards_[i];
+    std::unique_lock lock(shard.mutex);
+    shard.idle_cv.wait(lock, [&] { return shard.pending.empty() && !shard.busy; });
+  }
+}
+
+SendPoolMetrics SendPool::Metrics() const {
+  SendPoolMetrics total;
+  double send_ms_sum = 0.0;
+  for (size_t i = 0; i < thread_count_; ++i) {
+    std::scoped_lock lock(shards_[i].mutex);
+    const auto &metrics = shards_[i].metrics;
+    total.batches += metrics.batches;
+    total.dropped_batches += metrics.dropped_batches;
+    total.bundles += metrics.bundles;
+    total.failed_bundles += metrics.failed_bundles;
+    total.bytes += metrics.bytes;
+    send_ms_sum += metrics.avg_send_ms * static_cast<double>(metrics.batches);
+    total.max_send_ms = std::max(total.max_send_ms, metrics.max_send_ms);
+    total.max_queue_ms = std::max(total.max_queue_ms, metrics.max_queue_ms);
+    total.max_pending_bytes = std::max(total.max_pending_bytes, metrics.max_pending_bytes);
+  }
+  if (total.batches > 0) {
+    total.avg_send_ms = send_ms_sum / static_cast<double>(total.batches);
+  }
+  return total;
+}
+
+size_t SendPool::thread_count() const {
+  return thread_count_;
+}
+
+size_t SendPool::DefaultThreadCount() {
+  const size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+  return std::max<size_t>(1, cores / 8);
+}
+
+void SendPool::WorkerLoop(Shard &shard) {
+  using Millis = std::chrono::duration<double, std::milli>;
+  std::vector<Job> working;
+  std::unique_lock lock(shard.mutex);
+  while (true) {
+    shard.work_cv.wait(lock, [&] { return shard.stopping || !shard.pending.empty(); });
+    if (shard.pending.empty()) {
+      return;
+    }
+    working.swap(shard.pending);
+    shard.busy = true;
+    lock.unlock();
+
+    for (auto &job : working) {
+      const auto start = Clock::now();
+      const size_t bytes = job.queue.bytes();
+      size_t attempted = 0;
+      const size_t accepted = job.queue.Flush(job.max_bundle_bytes, [&](const uint8_t *data, size_t size) {
+        attempted += 1;
+        return send_(job.target.get(), data, size);
+      });
+      const auto end = Clock::now();
+
+      lock.lock();
+      auto &metrics = shard.metrics;
+      metrics.batches += 1;
+      metrics.bundles += accepted;
+      metrics.failed_bundles += attempted - accepted;
+      metrics.bytes += bytes;
+      const double send_ms = Millis(end - start).count();
+      metrics.max_send_ms = std::max(metrics.max_send_ms, send_ms);
+      metrics.avg_send_ms += (send_ms - metrics.avg_send_ms) / static_cast<double>(metrics.batches);
+      metrics.max_queue_ms = std::max(metrics.max_queue_ms, Millis(start - job.posted_at).count());
+      shard.pending_bytes -= bytes;
+      shard.spare.push_back(std::move(job.queue));
+      lock.unlock();
+    }
+    // Drops the targets outside the lock; a closed connection's channel may be freed here.
+    working.clear();
+
+    lock.lock();
+    shard.busy = false;
+    shard.idle_cv.notify_all();
+  }
+}
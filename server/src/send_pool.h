@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "outbound_queue.h"
+
+struct SendPoolMetrics {
+  // Queues handed over by Post, and those discarded because their thread was backed up.
+  uint64_t batches = 0;
+  uint64_t dropped_batches = 0;
+  uint64_t bundles = 0;
+  uint64_t failed_bundles = 0;
+  uint64_t bytes = 0;
+  // Time spent sending one queue, and the longest a queue waited between Post and its send.
+  double avg_send_ms = 0.0;
+  double max_send_ms = 0.0;
+  double max_queue_ms = 0.0;
+  size_t max_pending_bytes = 0;
+};
+
+// Sends outbound queues on a fixed set of I/O threads, so DataChannel backpressure and DTLS work
+// overlap the next tick instead of running on a tick thread. Each key is served by one thread,
+// which keeps the queues posted under a key in order.
+class SendPool {
+public:
+  using Clock = std::chrono::steady_clock;
+  // Sends one bundle to the target given to Post; returns whether it was accepted.
+  using SendFn = bool (*)(void *target, const uint8_t *data, size_t size);
+
+  static constexpr size_t kDefaultMaxPendingBytes = 4 * 1024 * 1024;
+
+  SendPool(size_t threads, SendFn send, size_t max_pending_bytes = kDefaultMaxPendingBytes);
+  // Sends everything already posted, then joins the threads.
+  ~SendPool();
+  SendPool(const SendPool &) = delete;
+  SendPool &operator=(const SendPool &) = delete;
+
+  // Takes the messages in queue, leaving it empty with recycled buffers, to be sent to target in
+  // bundles of at most max_bundle_bytes. A droppable queue is discarded instead when the key's
+  // thread already has max_pending_bytes waiting. Returns whether the messages were queued.
+  bool Post(size_t key, std::shared_ptr<void> target, OutboundQueue &queue, size_t max_bundle_bytes,
+            bool droppable);
+  // Blocks until every queue posted before the call has been sent.
+  void WaitIdle();
+  SendPoolMetrics Metrics() const;
+  size_t thread_count() const;
+
+  // One thread per eight cores; at least 1.
+  static size_t DefaultThreadCount();
+
+private:
+  struct Job {
+    std::shared_ptr<void> target;
+    OutboundQueue queue;
+    size_t max_bundle_bytes = 0;
+    Clock::time_point posted_at{};
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable idle_cv;
+    std::vector<Job> pending;
+    // Emptied queues handed back to Post so steady-state sends reuse their buffers.
+    std::vector<OutboundQueue> spare;
+    size_t pending_bytes = 0;
+    bool busy = false;
+    bool stopping = false;
+    SendPoolMetrics metrics;
+    std::thread thread;
+  };
+
+  void WorkerLoop(Shard &shard);
+
+  SendFn send_ = nullptr;
+  size_t max_pending_bytes_ = kDefaultMaxPendingBytes;
+  size_t thread_count_ = 1;
+  std::unique_ptr<Shard[]> shards_;
+};
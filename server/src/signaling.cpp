@@ -6,6 +6,7 @@
 #include <cctype>
 #include <cstddef>
 #include <exception>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -17,9 +18,20 @@
 
 namespace {
 constexpr int kMaxClientHelloAttempts = 3;
-constexpr size_t kMaxPendingInputs = 128;
-constexpr size_t kMaxPendingFireRequests = 128;
-constexpr size_t kMaxPendingLoadoutRequests = 8;
+
+// Least-loaded room with space; ties go to the lowest index. Returns loads.size() when all are full.
+size_t PickRoom(const std::vector<size_t> &loads, size_t capacity) {
+  size_t best = loads.size();
+  for (size_t i = 0; i < loads.size(); ++i) {
+    if (capacity > 0 && loads[i] >= capacity) {
+      continue;
+    }
+    if (best == loads.size() || loads[i] < loads[best]) {
+      best = i;
+    }
+  }
+  return best;
+}
 
 std::string TrimWhitespace(const std::string &value) {
   const auto start = value.find_first_not_of(" \t\r\n");
@@ -117,13 +129,9 @@ rtc::binary ToRtcBinary(const std::vector<uint8_t> &message) {
   return out;
 }
 
-std::vector<uint8_t> ToByteVector(const rtc::binary &message) {
-  std::vector<uint8_t> out;
-  out.reserve(message.size());
-  for (std::byte byte : message) {
-    out.push_back(static_cast<uint8_t>(byte));
-  }
-  return out;
+// Views the received bytes in place; only valid while message is.
+ByteSpan ToByteSpan(const rtc::binary &message) {
+  return ByteSpan(reinterpret_cast<const uint8_t *>(message.data()), message.size());
 }
 
 #ifdef AFPS_ENABLE_OPENSSL
@@ -240,13 +248,23 @@ std::string NormalizeCharacterId(const std::string &value,
   }
   return trimmed;
 }
+
+// SendPool::SendFn over a DataChannel; also used for inline flushes.
+bool SendBundle(void *channel, const uint8_t *data, size_t size) {
+  const auto *bytes = reinterpret_cast<const std::byte *>(data);
+  return RtcEchoPeer::SendOnChannel(static_cast<rtc::DataChannel *>(channel), rtc::binary(bytes, bytes + size));
+}
 }
 
 SignalingStore::SignalingStore(SignalingConfig config)
     : config_(std::move(config)),
       input_limiter_(config_.input_max_tokens, config_.input_refill_per_second),
+      debug_report_limiter_(config_.debug_report_max_tokens, config_.debug_report_refill_per_second),
       rng_(std::random_device{}()) {
   allowed_character_ids_ = BuildAllowedCharacterIds(config_.allowed_character_ids);
+  if (config_.send_workers > 0) {
+    send_pool_ = std::make_unique<SendPool>(config_.send_workers, SendBundle);
+  }
 }
 
 SessionInfo SignalingStore::CreateSession() {
@@ -289,7 +307,11 @@ SignalingResult<ConnectionOffer> SignalingStore::CreateConnection(const std::str
     connection = std::make_shared<ConnectionState>();
     connection->id = GenerateToken(12);
     connection->session = session_token;
+    if (!AssignRoomLocked(*connection)) {
+      return {false, std::nullopt, SignalingError::RoomsFull};
+    }
     connections_[connection->id] = connection;
+    PublishConnectionsLocked();
   }
 
   connection->connection_nonce = GenerateToken(8);
@@ -344,6 +366,7 @@ SignalingResult<ConnectionOffer> SignalingStore::CreateConnection(const std::str
     if (!ready) {
       std::scoped_lock store_lock(mutex_);
       connections_.erase(connection->id);
+      PublishConnectionsLocked();
       return {false, std::nullopt, SignalingError::OfferTimeout};
     }
     description = connection->local_description;
@@ -445,208 +468,145 @@ SignalingResult<std::vector<IceCandidate>> SignalingStore::DrainLocalCandidates(
   return {true, drained, SignalingError::None};
 }
 
-SignalingResult<std::vector<InputCmd>> SignalingStore::DrainInputs(
-    const std::string &session_token, const std::string &connection_id) {
-  std::shared_ptr<ConnectionState> connection;
-  {
-    std::scoped_lock lock(mutex_);
-    PruneExpiredSessionsLocked();
-    SignalingError error = SignalingError::None;
-    if (!IsSessionValidLocked(session_token, error)) {
-      return {false, std::nullopt, error};
-    }
-
-    auto iter = connections_.find(connection_id);
-    if (iter == connections_.end()) {
-      return {false, std::nullopt, SignalingError::ConnectionNotFound};
-    }
-    connection = iter->second;
-  }
-
-  std::vector<InputCmd> drained;
-  {
-    std::scoped_lock lock(connection->mutex);
-    drained.swap(connection->pending_inputs);
-  }
-
-  return {true, drained, SignalingError::None};
-}
-
-std::vector<InputBatch> SignalingStore::DrainAllInputs() {
-  std::vector<std::shared_ptr<ConnectionState>> connections;
-  {
-    std::scoped_lock lock(mutex_);
-    PruneExpiredSessionsLocked();
-    connections.reserve(connections_.size());
-    for (const auto &entry : connections_) {
-      connections.push_back(entry.second);
-    }
-  }
+std::vector<CommandBatch> SignalingStore::DrainAllCommands(const std::string &room_id) {
+  const auto connections = CollectConnections(room_id);
 
-  std::vector<InputBatch> batches;
+  std::vector<CommandBatch> batches;
   for (const auto &connection : connections) {
-    InputBatch batch;
-    {
-      std::scoped_lock lock(connection->mutex);
-      if (connection->pending_inputs.empty()) {
-        continue;
-      }
-      batch.connection_id = connection->id;
-      batch.inputs.swap(connection->pending_inputs);
+    if (connection->commands.empty()) {
+      continue;
     }
+    CommandBatch batch;
+    batch.connection_id = connection->id;
+    connection->commands.Drain([&batch](ClientCommand &&command) {
+      if (auto *input = std::get_if<InputCmd>(&command)) {
+        batch.inputs.push_back(*input);
+      } else if (auto *fire = std::get_if<FireWeaponRequest>(&command)) {
+        batch.fire_requests.push_back(std::move(*fire));
+      } else if (auto *loadout = std::get_if<SetLoadoutRequest>(&command)) {
+        batch.loadout_requests.push_back(*loadout);
+      } else if (auto *report = std::get_if<DecalDebugReport>(&command)) {
+        batch.decal_reports.push_back(*report);
+      } else if (auto *ack = std::get_if<ServerSeqAck>(&command)) {
+        batch.seq_acks.push_back(*ack);
+      }
+    });
     batches.push_back(std::move(batch));
   }
 
   return batches;
 }
 
-std::vector<FireRequestBatch> SignalingStore::DrainAllFireRequests() {
-  std::vector<std::shared_ptr<ConnectionState>> connections;
-  {
-    std::scoped_lock lock(mutex_);
-    PruneExpiredSessionsLocked();
-    connections.reserve(connections_.size());
-    for (const auto &entry : connections_) {
-      connections.push_back(entry.second);
-    }
-  }
+std::vector<std::string> SignalingStore::ReadyConnectionIds(const std::string &room_id) {
+  const auto connections = CollectConnections(room_id);
 
-  std::vector<FireRequestBatch> batches;
+  std::vector<std::string> ready;
+  ready.reserve(connections.size());
   for (const auto &connection : connections) {
-    FireRequestBatch batch;
-    {
-      std::scoped_lock lock(connection->mutex);
-      if (connection->pending_fire_requests.empty()) {
-        continue;
-      }
-      batch.connection_id = connection->id;
-      batch.requests.swap(connection->pending_fire_requests);
+    if (connection->handshake_complete && !connection->closed) {
+      ready.push_back(connection->id);
     }
-    batches.push_back(std::move(batch));
   }
 
-  return batches;
+  return ready;
 }
 
-std::vector<LoadoutRequestBatch> SignalingStore::DrainAllLoadoutRequests() {
-  std::vector<std::shared_ptr<ConnectionState>> connections;
-  {
-    std::scoped_lock lock(mutex_);
-    PruneExpiredSessionsLocked();
-    connections.reserve(connections_.size());
-    for (const auto &entry : connections_) {
-      connections.push_back(entry.second);
-    }
+bool SignalingStore::SendReliable(const std::string &connection_id, const std::vector<uint8_t> &message) {
+  const auto connection = FindConnection(connection_id);
+  if (!connection) {
+    return false;
   }
 
-  std::vector<LoadoutRequestBatch> batches;
-  for (const auto &connection : connections) {
-    LoadoutRequestBatch batch;
-    {
-      std::scoped_lock lock(connection->mutex);
-      if (connection->pending_loadout_requests.empty()) {
-        continue;
-      }
-      batch.connection_id = connection->id;
-      batch.requests.swap(connection->pending_loadout_requests);
-    }
-    batches.push_back(std::move(batch));
+  if (!connection->handshake_complete || connection->closed) {
+    return false;
   }
 
-  return batches;
+  connection->outbound_reliable.Push(message);
+  return true;
 }
 
-std::vector<std::string> SignalingStore::ReadyConnectionIds() {
-  std::vector<std::shared_ptr<ConnectionState>> connections;
-  {
-    std::scoped_lock lock(mutex_);
-    PruneExpiredSessionsLocked();
-    connections.reserve(connections_.size());
-    for (const auto &entry : connections_) {
-      connections.push_back(entry.second);
-    }
+bool SignalingStore::SendUnreliable(const std::string &connection_id, const std::vector<uint8_t> &message) {
+  const auto connection = FindConnection(connection_id);
+  if (!connection) {
+    return false;
   }
 
-  std::vector<std::string> ready;
-  for (const auto &connection : connections) {
-    std::scoped_lock lock(connection->mutex);
-    if (connection->handshake_complete && !connection->closed) {
-      ready.push_back(connection->id);
-    }
+  if (!connection->handshake_complete || connection->closed) {
+    return false;
   }
 
-  return ready;
+  connection->outbound_unreliable.Push(message);
+  return true;
 }
 
-bool SignalingStore::SendReliable(const std::string &connection_id, const std::vector<uint8_t> &message) {
-  std::shared_ptr<ConnectionState> connection;
-  {
-    std::scoped_lock lock(mutex_);
-    auto iter = connections_.find(connection_id);
-    if (iter == connections_.end()) {
-      return false;
-    }
-    connection = iter->second;
-  }
-
-  {
-    std::scoped_lock lock(connection->mutex);
-    if (!connection->handshake_complete || connection->closed) {
-      return false;
-    }
+size_t SignalingStore::FlushOutbound(const std::string &room_id) {
+  size_t bundles = 0;
+  for (const auto &connection : CollectConnections(room_id)) {
+    bundles += FlushConnection(*connection);
   }
-
-  return connection->peer->SendOn(kReliableChannelLabel, ToRtcBinary(message));
+  return bundles;
 }
 
-bool SignalingStore::SendUnreliable(const std::string &connection_id, const std::vector<uint8_t> &message) {
-  std::shared_ptr<ConnectionState> connection;
-  {
-    std::scoped_lock lock(mutex_);
-    auto iter = connections_.find(connection_id);
-    if (iter == connections_.end()) {
-      return false;
-    }
-    connection = iter->second;
+size_t SignalingStore::FlushConnection(ConnectionState &connection) {
+  if (connection.outbound_reliable.empty() && connection.outbound_unreliable.empty()) {
+    return 0;
   }
-
-  {
-    std::scoped_lock lock(connection->mutex);
-    if (!connection->handshake_complete || connection->closed) {
-      return false;
-    }
+  if (connection.closed) {
+    connection.outbound_reliable.Clear();
+    connection.outbound_unreliable.Clear();
+    return 0;
+  }
+  if (!connection.reliable_channel) {
+    connection.reliable_channel = connection.peer->Channel(kReliableChannelLabel);
   }
+  if (!connection.unreliable_channel) {
+    connection.unreliable_channel = connection.peer->Channel(kUnreliableChannelLabel);
+  }
+  if (send_pool_) {
+    const size_t key = std::hash<std::string>{}(connection.id);
+    size_t posted = send_pool_->Post(key, connection.reliable_channel, connection.outbound_reliable,
+                                     kMaxClientMessageBytes, false) ? 1 : 0;
+    posted += send_pool_->Post(key, connection.unreliable_channel, connection.outbound_unreliable,
+                               kMaxSnapshotPacketBytes, true) ? 1 : 0;
+    return posted;
+  }
+  auto send_on = [](rtc::DataChannel *channel) {
+    return [channel](const uint8_t *data, size_t size) { return SendBundle(channel, data, size); };
+  };
+  size_t bundles = connection.outbound_reliable.Flush(kMaxClientMessageBytes,
+                                                      send_on(connection.reliable_channel.get()));
+  bundles += connection.outbound_unreliable.Flush(kMaxSnapshotPacketBytes,
+                                                  send_on(connection.unreliable_channel.get()));
+  return bundles;
+}
 
-  return connection->peer->SendOn(kUnreliableChannelLabel, ToRtcBinary(message));
+SendPoolMetrics SignalingStore::SendMetrics() const {
+  return send_pool_ ? send_pool_->Metrics() : SendPoolMetrics{};
 }
 
 uint32_t SignalingStore::NextServerMessageSeq(const std::string &connection_id) {
-  std::shared_ptr<ConnectionState> connection;
-  {
-    std::scoped_lock lock(mutex_);
-    auto iter = connections_.find(connection_id);
-    if (iter == connections_.end()) {
-      return 0;
-    }
-    connection = iter->second;
+  const auto connection = FindConnection(connection_id);
+  if (!connection) {
+    return 0;
   }
-  std::scoped_lock lock(connection->mutex);
-  connection->next_server_msg_seq += 1;
-  return connection->next_server_msg_seq;
+  return connection->next_server_msg_seq.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
 uint32_t SignalingStore::LastClientMessageSeq(const std::string &connection_id) {
-  std::shared_ptr<ConnectionState> connection;
-  {
-    std::scoped_lock lock(mutex_);
-    auto iter = connections_.find(connection_id);
-    if (iter == connections_.end()) {
-      return 0;
-    }
-    connection = iter->second;
+  const auto connection = FindConnection(connection_id);
+  if (!connection) {
+    return 0;
   }
-  std::scoped_lock lock(connection->mutex);
-  return connection->last_client_msg_seq;
+  return connection->last_client_msg_seq.load(std::memory_order_relaxed);
+}
+
+std::string SignalingStore::RoomOf(const std::string &connection_id) const {
+  std::scoped_lock lock(mutex_);
+  auto iter = connections_.find(connection_id);
+  if (iter == connections_.end()) {
+    return {};
+  }
+  return iter->second->room;
 }
 
 size_t SignalingStore::SessionCount() const {
@@ -673,6 +633,8 @@ const char *SignalingStore::ErrorCode(SignalingError error) {
       return "offer_timeout";
     case SignalingError::InvalidRequest:
       return "invalid_request";
+    case SignalingError::RoomsFull:
+      return "rooms_full";
   }
   return "unknown";
 }
@@ -717,17 +679,82 @@ void SignalingStore::PruneExpiredSessionsLocked() {
   for (auto iter = connections_.begin(); iter != connections_.end();) {
     const bool expired = std::find(expired_tokens.begin(), expired_tokens.end(),
                                    iter->second->session) != expired_tokens.end();
-    bool closed = false;
-    {
-      std::scoped_lock lock(iter->second->mutex);
-      closed = iter->second->closed;
-    }
+    const bool closed = iter->second->closed;
     if (expired || closed) {
       iter = connections_.erase(iter);
     } else {
       ++iter;
     }
   }
+  PublishConnectionsLocked();
+}
+
+void SignalingStore::PublishConnectionsLocked() {
+  std::atomic_store(&connection_snapshot_, std::shared_ptr<const ConnectionMap>(
+                                               std::make_shared<ConnectionMap>(connections_)));
+}
+
+std::shared_ptr<const SignalingStore::ConnectionMap> SignalingStore::ConnectionSnapshot() const {
+  return std::atomic_load(&connection_snapshot_);
+}
+
+std::shared_ptr<SignalingStore::ConnectionState> SignalingStore::FindConnection(
+    const std::string &connection_id) const {
+  const auto snapshot = ConnectionSnapshot();
+  if (!snapshot) {
+    return nullptr;
+  }
+  auto iter = snapshot->find(connection_id);
+  return iter == snapshot->end() ? nullptr : iter->second;
+}
+
+std::vector<std::shared_ptr<SignalingStore::ConnectionState>> SignalingStore::CollectConnections(
+    const std::string &room_id) {
+  {
+    // Expiry is housekeeping; skip it rather than wait when signaling holds the lock.
+    std::unique_lock lock(mutex_, std::try_to_lock);
+    if (lock.owns_lock()) {
+      PruneExpiredSessionsLocked();
+    }
+  }
+  std::vector<std::shared_ptr<ConnectionState>> connections;
+  const auto snapshot = ConnectionSnapshot();
+  if (!snapshot) {
+    return connections;
+  }
+  connections.reserve(snapshot->size());
+  for (const auto &entry : *snapshot) {
+    if (room_id.empty() || entry.second->room == room_id) {
+      connections.push_back(entry.second);
+    }
+  }
+  return connections;
+}
+
+bool SignalingStore::AssignRoomLocked(ConnectionState &connection) {
+  if (config_.rooms.empty()) {
+    connection.map_seed = config_.map_seed;
+    return true;
+  }
+  std::vector<size_t> loads(config_.rooms.size(), 0);
+  for (const auto &entry : connections_) {
+    if (entry.second->closed) {
+      continue;
+    }
+    for (size_t i = 0; i < config_.rooms.size(); ++i) {
+      if (config_.rooms[i].id == entry.second->room) {
+        loads[i] += 1;
+        break;
+      }
+    }
+  }
+  const size_t room = PickRoom(loads, config_.room_capacity);
+  if (room >= config_.rooms.size()) {
+    return false;
+  }
+  connection.room = config_.rooms[room].id;
+  connection.map_seed = config_.rooms[room].map_seed;
+  return true;
 }
 
 std::string SignalingStore::GenerateToken(size_t bytes) {
@@ -785,7 +812,7 @@ std::vector<IceServerConfig> SignalingStore::BuildIceServers(
 
 void SignalingStore::HandleClientMessage(const std::shared_ptr<ConnectionState> &connection,
                                          const std::string &label, const rtc::binary &message) {
-  const auto message_bytes = ToByteVector(message);
+  const ByteSpan message_bytes = ToByteSpan(message);
   auto log_event = [&connection, this](const std::string &event, const std::string &detail) {
     LogAudit(FormatUtc(std::chrono::system_clock::now()),
              event,
@@ -808,6 +835,7 @@ void SignalingStore::HandleClientMessage(const std::shared_ptr<ConnectionState>
       connection->peer->Close();
       std::scoped_lock lock(mutex_);
       connections_.erase(connection->id);
+      PublishConnectionsLocked();
     }
   };
 
@@ -869,9 +897,9 @@ void SignalingStore::HandleClientMessage(const std::shared_ptr<ConnectionState>
       return;
     }
 
-    DecodedEnvelope envelope;
+    EnvelopeView envelope;
     std::string envelope_error;
-    if (!DecodeEnvelope(message_bytes, envelope, envelope_error)) {
+    if (!DecodeEnvelopeView(message_bytes, envelope, envelope_error)) {
       log_event("handshake_error", "invalid_envelope");
       const auto seq = NextServerMessageSeq(connection->id);
       const auto ack = LastClientMessageSeq(connection->id);
@@ -986,7 +1014,7 @@ void SignalingStore::HandleClientMessage(const std::shared_ptr<ConnectionState>
     response.snapshot_rate = kSnapshotRate;
     response.snapshot_keyframe_interval = config_.snapshot_keyframe_interval;
     response.connection_nonce = connection->connection_nonce;
-    response.map_seed = config_.map_seed;
+    response.map_seed = connection->map_seed;
     {
       const auto seq = NextServerMessageSeq(connection->id);
       const auto ack = LastClientMessageSeq(connection->id);
@@ -1004,14 +1032,7 @@ void SignalingStore::HandleClientMessage(const std::shared_ptr<ConnectionState>
     };
     std::vector<ProfileTarget> profiles;
     {
-      std::vector<std::shared_ptr<ConnectionState>> connections;
-      {
-        std::scoped_lock lock(mutex_);
-        connections.reserve(connections_.size());
-        for (const auto &entry : connections_) {
-          connections.push_back(entry.second);
-        }
-      }
+      const auto connections = CollectConnections(connection->room);
       for (const auto &peer : connections) {
         std::scoped_lock lock(peer->mutex);
         if (peer->closed || !peer->handshake_complete || !peer->channel_open) {
@@ -1078,18 +1099,28 @@ void SignalingStore::HandleClientMessage(const std::shared_ptr<ConnectionState>
     return;
   }
 
-  DecodedEnvelope envelope;
+  EnvelopeView envelope;
   std::string envelope_error;
-  if (!DecodeEnvelope(message_bytes, envelope, envelope_error)) {
+  if (!DecodeEnvelopeView(message_bytes, envelope, envelope_error)) {
     record_invalid("invalid_envelope");
     return;
   }
 
+  // Only this channel's message callback pushes to connection->commands, which keeps the ring
+  // single-producer. A full ring means the client outran the tick; drop and count it.
+  auto enqueue_command = [&connection, &record_rate_limit](ClientCommand command) {
+    if (!connection->commands.TryPush(std::move(command))) {
+      record_rate_limit("command_queue_full");
+    }
+  };
+
   bool valid_seq = false;
+  bool new_seq_ack = false;
   {
     std::scoped_lock lock(connection->mutex);
     if (envelope.header.msg_seq > connection->last_client_msg_seq) {
       connection->last_client_msg_seq = envelope.header.msg_seq;
+      new_seq_ack = envelope.header.server_seq_ack != connection->last_client_seq_ack;
       connection->last_client_seq_ack = envelope.header.server_seq_ack;
       valid_seq = true;
     }
@@ -1098,6 +1129,10 @@ void SignalingStore::HandleClientMessage(const std::shared_ptr<ConnectionState>
     record_invalid("invalid_sequence");
     return;
   }
+  // InputCmd acks go out below with their ack bits, which every input packet restates.
+  if (new_seq_ack && envelope.header.msg_type != MessageType::InputCmd) {
+    enqueue_command(ServerSeqAck{envelope.header.server_seq_ack, 0});
+  }
 
   if (envelope.header.protocol_version != kProtocolVersion) {
     record_invalid("protocol_mismatch");
@@ -1131,13 +1166,7 @@ void SignalingStore::HandleClientMessage(const std::shared_ptr<ConnectionState>
       record_invalid("invalid_fire_weapon_request");
       return;
     }
-    {
-      std::scoped_lock lock(connection->mutex);
-      if (connection->pending_fire_requests.size() >= kMaxPendingFireRequests) {
-        connection->pending_fire_requests.erase(connection->pending_fire_requests.begin());
-      }
-      connection->pending_fire_requests.push_back(std::move(request));
-    }
+    enqueue_command(std::move(request));
     return;
   }
 
@@ -1148,13 +1177,22 @@ void SignalingStore::HandleClientMessage(const std::shared_ptr<ConnectionState>
       record_invalid("invalid_set_loadout_request");
       return;
     }
-    {
-      std::scoped_lock lock(connection->mutex);
-      if (connection->pending_loadout_requests.size() >= kMaxPendingLoadoutRequests) {
-        connection->pending_loadout_requests.erase(connection->pending_loadout_requests.begin());
-      }
-      connection->pending_loadout_requests.push_back(std::move(request));
+    enqueue_command(request);
+    return;
+  }
+
+  if (envelope.header.msg_type == MessageType::DecalDebugReport) {
+    DecalDebugReport report;
+    std::string error;
+    if (!ParseDecalDebugReportPayload(envelope.payload, report, error)) {
+      record_invalid("invalid_decal_debug_report");
+      return;
     }
+    if (!debug_report_limiter_.AllowNow(connection->id)) {
+      record_rate_limit("debug_report_rate_limit");
+      return;
+    }
+    enqueue_command(report);
     return;
   }
 
@@ -1163,28 +1201,34 @@ void SignalingStore::HandleClientMessage(const std::shared_ptr<ConnectionState>
     return;
   }
 
-  InputCmd cmd;
+  InputCmdFrames cmd;
   std::string error;
   if (!ParseInputCmdPayload(envelope.payload, cmd, error)) {
     record_invalid("invalid_input_cmd");
     return;
   }
+  // server_seq_ack is the newest message seen on any channel, often an FX or pong message rather
+  // than a snapshot packet; the bits name the earlier messages that arrived too.
+  enqueue_command(ServerSeqAck{envelope.header.server_seq_ack, cmd.server_seq_ack_bits});
 
-  bool invalid_seq = false;
+  // Frames arrive newest first and repeat the last few inputs. Queue the ones not seen yet, oldest
+  // first, so a dropped packet is filled in by the next one.
+  size_t fresh = 0;
   {
     std::scoped_lock lock(connection->mutex);
-    if (cmd.input_seq <= connection->last_input_seq) {
-      invalid_seq = true;
-    } else {
-      connection->last_input_seq = cmd.input_seq;
-      if (connection->pending_inputs.size() >= kMaxPendingInputs) {
-        connection->pending_inputs.erase(connection->pending_inputs.begin());
-      }
-      connection->pending_inputs.push_back(cmd);
+    while (fresh < cmd.count && cmd.frames[fresh].input_seq > connection->last_input_seq) {
+      ++fresh;
+    }
+    if (fresh > 0) {
+      connection->last_input_seq = cmd.frames[0].input_seq;
     }
   }
 
-  if (invalid_seq) {
+  if (fresh == 0) {
     record_invalid("non_monotonic_input_seq");
+    return;
+  }
+  for (size_t i = fresh; i > 0; --i) {
+    enqueue_command(cmd.frames[i - 1]);
   }
 }
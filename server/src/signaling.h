@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <memory>
@@ -9,11 +10,15 @@
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <variant>
 #include <vector>
 
+#include "outbound_queue.h"
 #include "protocol.h"
 #include "rate_limiter.h"
 #include "rtc_echo.h"
+#include "send_pool.h"
+#include "spsc_ring.h"
 
 struct SessionInfo {
   std::string token;
@@ -39,19 +44,21 @@ struct ConnectionOffer {
   std::string expires_at;
 };
 
-struct InputBatch {
-  std::string connection_id;
-  std::vector<InputCmd> inputs;
+// Which server messages a client has received: server_seq_ack itself, plus msg_seq
+// server_seq_ack - 1 - i for every set bit i of ack_bits.
+struct ServerSeqAck {
+  uint32_t server_seq_ack = 0;
+  uint32_t ack_bits = 0;
 };
 
-struct FireRequestBatch {
+// Everything one connection queued since the last drain, split by kind in arrival order.
+struct CommandBatch {
   std::string connection_id;
-  std::vector<FireWeaponRequest> requests;
-};
-
-struct LoadoutRequestBatch {
-  std::string connection_id;
-  std::vector<SetLoadoutRequest> requests;
+  std::vector<InputCmd> inputs;
+  std::vector<FireWeaponRequest> fire_requests;
+  std::vector<SetLoadoutRequest> loadout_requests;
+  std::vector<DecalDebugReport> decal_reports;
+  std::vector<ServerSeqAck> seq_acks;
 };
 
 enum class SignalingError {
@@ -60,7 +67,13 @@ enum class SignalingError {
   SessionExpired,
   ConnectionNotFound,
   OfferTimeout,
-  InvalidRequest
+  InvalidRequest,
+  RoomsFull
+};
+
+struct SignalingRoom {
+  std::string id;
+  uint32_t map_seed = 0;
 };
 
 struct SignalingConfig {
@@ -71,11 +84,20 @@ struct SignalingConfig {
   int turn_ttl_seconds = 3600;
   double input_max_tokens = 120.0;
   double input_refill_per_second = 120.0;
+  // Decal debug reports are telemetry; anything past this rate is dropped and counted as rate limited.
+  double debug_report_max_tokens = 4.0;
+  double debug_report_refill_per_second = 4.0;
   int max_invalid_inputs = 5;
   int max_rate_limit_drops = 20;
   int snapshot_keyframe_interval = kSnapshotKeyframeInterval;
   uint32_t map_seed = 0;
   std::vector<std::string> allowed_character_ids;
+  // New connections join the least-loaded room; map_seed above is only used without rooms.
+  std::vector<SignalingRoom> rooms;
+  // 0 means unlimited.
+  size_t room_capacity = 0;
+  // Threads sending flushed bundles; 0 sends them inline on the flushing tick thread.
+  size_t send_workers = 0;
 };
 
 template <typename T>
@@ -85,7 +107,26 @@ struct SignalingResult {
   SignalingError error = SignalingError::None;
 };
 
-class SignalingStore {
+// The connection side of a room as TickLoop sees it. SignalingStore implements it over WebRTC
+// peers; afps_server_loadtest implements it in process with scripted clients.
+class TickTransport {
+public:
+  virtual ~TickTransport() = default;
+
+  virtual std::vector<CommandBatch> DrainAllCommands(const std::string &room_id) = 0;
+  virtual std::vector<std::string> ReadyConnectionIds(const std::string &room_id) = 0;
+  virtual bool SendReliable(const std::string &connection_id, const std::vector<uint8_t> &message) = 0;
+  virtual bool SendUnreliable(const std::string &connection_id, const std::vector<uint8_t> &message) = 0;
+  virtual uint32_t NextServerMessageSeq(const std::string &connection_id) = 0;
+  virtual uint32_t LastClientMessageSeq(const std::string &connection_id) = 0;
+  virtual size_t ConnectionCount() const = 0;
+  // Sends everything the room's Send* calls queued since the last flush and returns how many
+  // bundles went out, or were handed to send threads. Called by the tick thread once at the end
+  // of each tick.
+  virtual size_t FlushOutbound(const std::string &room_id) = 0;
+};
+
+class SignalingStore : public TickTransport {
 public:
   explicit SignalingStore(SignalingConfig config);
 
@@ -98,19 +139,27 @@ public:
                                     const std::string &candidate, const std::string &mid);
   SignalingResult<std::vector<IceCandidate>> DrainLocalCandidates(const std::string &session_token,
                                                                   const std::string &connection_id);
-  SignalingResult<std::vector<InputCmd>> DrainInputs(const std::string &session_token,
-                                                     const std::string &connection_id);
-  std::vector<InputBatch> DrainAllInputs();
-  std::vector<FireRequestBatch> DrainAllFireRequests();
-  std::vector<LoadoutRequestBatch> DrainAllLoadoutRequests();
-  std::vector<std::string> ReadyConnectionIds();
-  bool SendReliable(const std::string &connection_id, const std::vector<uint8_t> &message);
-  bool SendUnreliable(const std::string &connection_id, const std::vector<uint8_t> &message);
-  uint32_t NextServerMessageSeq(const std::string &connection_id);
-  uint32_t LastClientMessageSeq(const std::string &connection_id);
+  // Tick-thread API: these read a published connection snapshot and never wait on the store
+  // mutex. Each connection's command ring has one consumer, so a room must be drained from a
+  // single thread. An empty room_id covers every connection.
+  std::vector<CommandBatch> DrainAllCommands(const std::string &room_id = {}) override;
+  std::vector<std::string> ReadyConnectionIds(const std::string &room_id = {}) override;
+  std::string RoomOf(const std::string &connection_id) const;
+  // Send* only queue on the connection; FlushOutbound sends the queues as bundled DataChannel
+  // messages, reliable ones up to kMaxClientMessageBytes and unreliable ones up to
+  // kMaxSnapshotPacketBytes so they stay a single datagram. With send_workers the flush only
+  // hands each connection's queues to the send thread for its id and returns the number handed
+  // over; unreliable queues are dropped while that thread is backed up.
+  bool SendReliable(const std::string &connection_id, const std::vector<uint8_t> &message) override;
+  bool SendUnreliable(const std::string &connection_id, const std::vector<uint8_t> &message) override;
+  size_t FlushOutbound(const std::string &room_id = {}) override;
+  uint32_t NextServerMessageSeq(const std::string &connection_id) override;
+  uint32_t LastClientMessageSeq(const std::string &connection_id) override;
 
   size_t SessionCount() const;
-  size_t ConnectionCount() const;
+  size_t ConnectionCount() const override;
+  // Zero without send_workers.
+  SendPoolMetrics SendMetrics() const;
   static const char *ErrorCode(SignalingError error);
 
 private:
@@ -119,35 +168,54 @@ private:
     std::chrono::system_clock::time_point expires_at;
   };
 
+  // Client-to-server commands, queued by the unreliable channel callback for the tick thread.
+  using ClientCommand = std::variant<InputCmd, FireWeaponRequest, SetLoadoutRequest, DecalDebugReport, ServerSeqAck>;
+  static constexpr size_t kCommandQueueCapacity = 256;
+
   struct ConnectionState {
     std::string id;
     std::string session;
+    std::string room;
+    uint32_t map_seed = 0;
     std::shared_ptr<RtcEchoPeer> peer;
     std::vector<IceCandidate> local_candidates;
     std::optional<rtc::Description> local_description;
     bool channel_open = false;
-    bool handshake_complete = false;
+    std::atomic<bool> handshake_complete{false};
     int handshake_attempts = 0;
     std::string client_build;
     std::string nickname;
     std::string character_id;
     std::string connection_nonce;
-    std::vector<InputCmd> pending_inputs;
-    std::vector<FireWeaponRequest> pending_fire_requests;
-    std::vector<SetLoadoutRequest> pending_loadout_requests;
+    SpscRing<ClientCommand, kCommandQueueCapacity> commands;
+    // Filled and flushed only by the tick thread that drains this connection's room. The channels
+    // are resolved on the first flush after they exist.
+    OutboundQueue outbound_reliable;
+    OutboundQueue outbound_unreliable;
+    std::shared_ptr<rtc::DataChannel> reliable_channel;
+    std::shared_ptr<rtc::DataChannel> unreliable_channel;
     int last_input_seq = -1;
-    uint32_t last_client_msg_seq = 0;
+    // Written under mutex, read by the tick without it.
+    std::atomic<uint32_t> last_client_msg_seq{0};
     uint32_t last_client_seq_ack = 0;
-    uint32_t next_server_msg_seq = 0;
+    std::atomic<uint32_t> next_server_msg_seq{0};
     int invalid_input_count = 0;
     int rate_limit_count = 0;
-    bool closed = false;
+    std::atomic<bool> closed{false};
     std::mutex mutex;
     std::condition_variable cv;
   };
 
   bool IsSessionValidLocked(const std::string &session_token, SignalingError &error) const;
   void PruneExpiredSessionsLocked();
+  using ConnectionMap = std::unordered_map<std::string, std::shared_ptr<ConnectionState>>;
+
+  void PublishConnectionsLocked();
+  std::shared_ptr<const ConnectionMap> ConnectionSnapshot() const;
+  std::shared_ptr<ConnectionState> FindConnection(const std::string &connection_id) const;
+  std::vector<std::shared_ptr<ConnectionState>> CollectConnections(const std::string &room_id);
+  size_t FlushConnection(ConnectionState &connection);
+  bool AssignRoomLocked(ConnectionState &connection);
   std::string GenerateToken(size_t bytes);
   static std::string FormatUtc(std::chrono::system_clock::time_point time_point);
   rtc::Configuration BuildRtcConfig(const std::vector<IceServerConfig> &ice_servers) const;
@@ -157,9 +225,14 @@ private:
 
   SignalingConfig config_;
   RateLimiter input_limiter_;
+  RateLimiter debug_report_limiter_;
   mutable std::mutex mutex_;
   std::unordered_map<std::string, Session> sessions_;
-  std::unordered_map<std::string, std::shared_ptr<ConnectionState>> connections_;
+  ConnectionMap connections_;
+  // Copy of connections_ republished on every change, read by the tick thread without mutex_.
+  std::shared_ptr<const ConnectionMap> connection_snapshot_;
   std::unordered_set<std::string> allowed_character_ids_;
   std::mt19937 rng_;
+  // Declared last so queued sends finish before the connections go away.
+  std::unique_ptr<SendPool> send_pool_;
 };
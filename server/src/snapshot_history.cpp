@@ -0,0 +1,73 @@
+#include "snapshot_history.h"
+
+#include <algorithm>
+
+SnapshotHistory::SnapshotHistory(size_t capacity) : entries_(std::max<size_t>(1, capacity)) {}
+
+void SnapshotHistory::Record(uint32_t msg_seq, const std::vector<SentState> &states) {
+  Entry &entry = entries_[next_];
+  entry.msg_seq = msg_seq;
+  entry.acked = false;
+  entry.states.assign(states.begin(), states.end());
+  next_ = (next_ + 1) % entries_.size();
+  count_ = std::min(count_ + 1, entries_.size());
+}
+
+bool SnapshotHistory::Acknowledge(uint32_t server_seq_ack, uint32_t ack_bits) {
+  bool acked = false;
+  for (size_t i = 0; i < count_; ++i) {
+    Entry &entry = entries_[i];
+    if (entry.acked) {
+      continue;
+    }
+    const uint32_t age = server_seq_ack - entry.msg_seq;
+    const bool received = age == 0 || (age <= 32 && ((ack_bits >> (age - 1)) & 1u) != 0);
+    if (!received) {
+      continue;
+    }
+    entry.acked = true;
+    acked = true;
+    for (const auto &sent : entry.states) {
+      const afps::entity::EntitySlot slot = sent.subject.slot;
+      if (slot == afps::entity::kInvalidSlot) {
+        continue;
+      }
+      if (slot >= baselines_.size()) {
+        baselines_.resize(static_cast<size_t>(slot) + 1);
+      }
+      SlotBaseline &baseline = baselines_[slot];
+      if (!baseline.valid || baseline.generation != sent.subject.generation ||
+          sent.state.server_tick > baseline.state.server_tick) {
+        baseline.valid = true;
+        baseline.generation = sent.subject.generation;
+        baseline.state = sent.state;
+      }
+    }
+  }
+  return acked;
+}
+
+const SnapshotBaseline *SnapshotHistory::Baseline(const afps::entity::EntityHandle &subject,
+                                                  int min_server_tick) const {
+  if (subject.slot >= baselines_.size()) {
+    return nullptr;
+  }
+  const SlotBaseline &baseline = baselines_[subject.slot];
+  if (!baseline.valid || baseline.generation != subject.generation ||
+      baseline.state.server_tick < min_server_tick) {
+    return nullptr;
+  }
+  return &baseline.state;
+}
+
+void SnapshotHistory::DropBaselinesBefore(int min_server_tick) {
+  for (auto &baseline : baselines_) {
+    if (baseline.valid && baseline.state.server_tick < min_server_tick) {
+      baseline.valid = false;
+    }
+  }
+}
+
+size_t SnapshotHistory::size() const {
+  return count_;
+}
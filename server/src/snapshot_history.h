@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "entity_registry.h"
+#include "protocol.h"
+
+// Snapshot packets sent to one recipient, keyed by envelope msg_seq. A packet's states only become
+// delta baselines once the client acks that msg_seq, either as server_seq_ack itself or through
+// bit (server_seq_ack - 1 - msg_seq) of its ack bits. Subjects are tracked by entity handle, so a
+// slot reused by a new player never inherits the previous player's baseline.
+class SnapshotHistory {
+public:
+  struct SentState {
+    afps::entity::EntityHandle subject;
+    SnapshotBaseline state;
+  };
+
+  explicit SnapshotHistory(size_t capacity = kSnapshotBaselineHistory);
+
+  // Copies states into the ring entry, reusing its buffer.
+  void Record(uint32_t msg_seq, const std::vector<SentState> &states);
+  bool Acknowledge(uint32_t server_seq_ack, uint32_t ack_bits = 0);
+  const SnapshotBaseline *Baseline(const afps::entity::EntityHandle &subject, int min_server_tick) const;
+  void DropBaselinesBefore(int min_server_tick);
+  size_t size() const;
+
+private:
+  struct Entry {
+    uint32_t msg_seq = 0;
+    bool acked = false;
+    std::vector<SentState> states;
+  };
+  struct SlotBaseline {
+    bool valid = false;
+    uint16_t generation = 0;
+    SnapshotBaseline state;
+  };
+
+  std::vector<Entry> entries_;
+  size_t next_ = 0;
+  size_t count_ = 0;
+  // Indexed by subject slot.
+  std::vector<SlotBaseline> baselines_;
+};
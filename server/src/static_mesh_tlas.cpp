@@ -0,0 +1,304 @@
+#include "static_mesh_tlas.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+
+namespace afps::world {
+namespace {
+constexpr uint32_t kTlasLeafInstanceCount = 4;
+
+std::array<double, 2> RotateQuarterTurns(double x, double y, uint8_t quarter_turns) {
+  switch (quarter_turns & 3u) {
+    case 1:
+      return {-y, x};
+    case 2:
+      return {-x, -y};
+    case 3:
+      return {y, -x};
+    case 0:
+    default:
+      return {x, y};
+  }
+}
+
+bool IsFiniteBounds(const CollisionMeshBounds &bounds) {
+  return std::isfinite(bounds.min_x) && std::isfinite(bounds.max_x) && std::isfinite(bounds.min_y) &&
+         std::isfinite(bounds.max_y) && std::isfinite(bounds.min_z) && std::isfinite(bounds.max_z);
+}
+
+double Centroid(const CollisionMeshBounds &bounds, int axis) {
+  switch (axis) {
+    case 0:
+      return bounds.min_x + bounds.max_x;
+    case 1:
+      return bounds.min_y + bounds.max_y;
+    default:
+      return bounds.min_z + bounds.max_z;
+  }
+}
+
+void BuildNode(StaticMeshTlas &tlas, uint32_t node_index, uint32_t first, uint32_t count) {
+  CollisionMeshBounds bounds = tlas.instance_bounds[tlas.instance_indices[first]];
+  CollisionMeshBounds centroids{};
+  centroids.min_x = centroids.max_x = Centroid(bounds, 0);
+  centroids.min_y = centroids.max_y = Centroid(bounds, 1);
+  centroids.min_z = centroids.max_z = Centroid(bounds, 2);
+  for (uint32_t i = first + 1; i < first + count; ++i) {
+    const auto &item = tlas.instance_bounds[tlas.instance_indices[i]];
+    bounds.min_x = std::min(bounds.min_x, item.min_x);
+    bounds.min_y = std::min(bounds.min_y, item.min_y);
+    bounds.min_z = std::min(bounds.min_z, item.min_z);
+    bounds.max_x = std::max(bounds.max_x, item.max_x);
+    bounds.max_y = std::max(bounds.max_y, item.max_y);
+    bounds.max_z = std::max(bounds.max_z, item.max_z);
+    centroids.min_x = std::min(centroids.min_x, Centroid(item, 0));
+    centroids.max_x = std::max(centroids.max_x, Centroid(item, 0));
+    centroids.min_y = std::min(centroids.min_y, Centroid(item, 1));
+    centroids.max_y = std::max(centroids.max_y, Centroid(item, 1));
+    centroids.min_z = std::min(centroids.min_z, Centroid(item, 2));
+    centroids.max_z = std::max(centroids.max_z, Centroid(item, 2));
+  }
+  tlas.nodes[node_index].bounds = bounds;
+  if (count <= kTlasLeafInstanceCount) {
+    tlas.nodes[node_index].first = first;
+    tlas.nodes[node_index].count = count;
+    return;
+  }
+
+  const double extent_x = centroids.max_x - centroids.min_x;
+  const double extent_y = centroids.max_y - centroids.min_y;
+  const double extent_z = centroids.max_z - centroids.min_z;
+  int axis = 0;
+  if (extent_y > extent_x && extent_y >= extent_z) {
+    axis = 1;
+  } else if (extent_z > extent_x && extent_z > extent_y) {
+    axis = 2;
+  }
+  const uint32_t half = count / 2;
+  auto begin = tlas.instance_indices.begin() + first;
+  std::nth_element(begin, begin + half, begin + count, [&](uint32_t a, uint32_t b) {
+    const double ca = Centroid(tlas.instance_bounds[a], axis);
+    const double cb = Centroid(tlas.instance_bounds[b], axis);
+    return ca < cb || (ca == cb && a < b);
+  });
+
+  // Children are allocated as a pair so the right child always sits at first + 1.
+  const uint32_t left = static_cast<uint32_t>(tlas.nodes.size());
+  tlas.nodes.emplace_back();
+  tlas.nodes.emplace_back();
+  tlas.nodes[node_index].first = left;
+  tlas.nodes[node_index].count = 0;
+  BuildNode(tlas, left, first, half);
+  BuildNode(tlas, left + 1, first + half, count - half);
+}
+
+bool RayOverlapsBounds(double origin_x,
+                       double origin_y,
+                       double origin_z,
+                       double dir_x,
+                       double dir_y,
+                       double dir_z,
+                       double max_t,
+                       const CollisionMeshBounds &bounds) {
+  const double inf = std::numeric_limits<double>::infinity();
+  const double epsilon = 1e-8;
+  double t_min = -inf;
+  double t_max = inf;
+  auto update_axis = [&](double origin, double dir, double min_bound, double max_bound) -> bool {
+    if (std::abs(dir) < epsilon) {
+      return origin >= min_bound && origin <= max_bound;
+    }
+    double t1 = (min_bound - origin) / dir;
+    double t2 = (max_bound - origin) / dir;
+    if (t1 > t2) {
+      std::swap(t1, t2);
+    }
+    t_min = std::max(t_min, t1);
+    t_max = std::min(t_max, t2);
+    return t_min <= t_max;
+  };
+  if (!update_axis(origin_x, dir_x, bounds.min_x, bounds.max_x)) {
+    return false;
+  }
+  if (!update_axis(origin_y, dir_y, bounds.min_y, bounds.max_y)) {
+    return false;
+  }
+  if (!update_axis(origin_z, dir_z, bounds.min_z, bounds.max_z)) {
+    return false;
+  }
+  return t_max >= 0.0 && t_min <= max_t;
+}
+}  // namespace
+
+CollisionMeshBounds BuildStaticMeshInstanceBounds(const StaticMeshInstance &instance,
+                                                  const CollisionMeshBounds &local_bounds) {
+  const double safe_scale = (std::isfinite(instance.scale) && instance.scale > 0.0)
+                                ? instance.scale
+                                : 1.0;
+  const double local_min_x = local_bounds.min_x * safe_scale;
+  const double local_max_x = local_bounds.max_x * safe_scale;
+  const double local_min_y = local_bounds.min_y * safe_scale;
+  const double local_max_y = local_bounds.max_y * safe_scale;
+  const double local_min_z = local_bounds.min_z * safe_scale;
+  const double local_max_z = local_bounds.max_z * safe_scale;
+
+  const std::array<std::array<double, 2>, 4> corners = {
+      RotateQuarterTurns(local_min_x, local_min_y, instance.yaw_quarter_turns),
+      RotateQuarterTurns(local_min_x, local_max_y, instance.yaw_quarter_turns),
+      RotateQuarterTurns(local_max_x, local_min_y, instance.yaw_quarter_turns),
+      RotateQuarterTurns(local_max_x, local_max_y, instance.yaw_quarter_turns),
+  };
+
+  CollisionMeshBounds world;
+  world.min_x = std::numeric_limits<double>::infinity();
+  world.max_x = -std::numeric_limits<double>::infinity();
+  world.min_y = std::numeric_limits<double>::infinity();
+  world.max_y = -std::numeric_limits<double>::infinity();
+  for (const auto &corner : corners) {
+    world.min_x = std::min(world.min_x, instance.center_x + corner[0]);
+    world.max_x = std::max(world.max_x, instance.center_x + corner[0]);
+    world.min_y = std::min(world.min_y, instance.center_y + corner[1]);
+    world.max_y = std::max(world.max_y, instance.center_y + corner[1]);
+  }
+  world.min_z = instance.base_z + local_min_z;
+  world.max_z = instance.base_z + local_max_z;
+  return world;
+}
+
+StaticMeshTlas BuildStaticMeshTlas(const std::vector<StaticMeshInstance> &instances,
+                                   const CollisionMeshRegistry &registry) {
+  StaticMeshTlas tlas;
+  tlas.prefab_indices.assign(instances.size(), kNoStaticMeshPrefab);
+  tlas.instance_bounds.resize(instances.size());
+
+  std::unordered_map<std::string, size_t> prefab_lookup;
+  prefab_lookup.reserve(registry.prefabs.size());
+  for (size_t i = 0; i < registry.prefabs.size(); ++i) {
+    if (!registry.prefabs[i].id.empty()) {
+      prefab_lookup[registry.prefabs[i].id] = i;
+    }
+  }
+
+  for (size_t i = 0; i < instances.size(); ++i) {
+    const auto lookup_iter = prefab_lookup.find(instances[i].prefab_id);
+    if (lookup_iter == prefab_lookup.end()) {
+      continue;
+    }
+    const auto &prefab = registry.prefabs[lookup_iter->second];
+    if (prefab.triangles.empty() || prefab.bvh_nodes.empty()) {
+      continue;
+    }
+    const CollisionMeshBounds bounds = BuildStaticMeshInstanceBounds(instances[i], prefab.bounds);
+    if (!IsFiniteBounds(bounds)) {
+      continue;
+    }
+    tlas.prefab_indices[i] = lookup_iter->second;
+    tlas.instance_bounds[i] = bounds;
+    tlas.instance_indices.push_back(static_cast<uint32_t>(i));
+  }
+
+  if (!tlas.instance_indices.empty()) {
+    tlas.nodes.reserve(tlas.instance_indices.size() * 2);
+    tlas.nodes.emplace_back();
+    BuildNode(tlas, 0, 0, static_cast<uint32_t>(tlas.instance_indices.size()));
+  }
+  return tlas;
+}
+
+void QueryStaticMeshTlas(const StaticMeshTlas &tlas,
+                         double origin_x,
+                         double origin_y,
+                         double origin_z,
+                         double dir_x,
+                         double dir_y,
+                         double dir_z,
+                         double max_t,
+                         std::vector<uint32_t> &out) {
+  out.clear();
+  if (tlas.nodes.empty()) {
+    return;
+  }
+  std::vector<uint32_t> stack;
+  stack.reserve(64);
+  stack.push_back(0);
+  while (!stack.empty()) {
+    const auto &node = tlas.nodes[stack.back()];
+    stack.pop_back();
+    if (!RayOverlapsBounds(origin_x, origin_y, origin_z, dir_x, dir_y, dir_z, max_t, node.bounds)) {
+      continue;
+    }
+    if (node.count > 0) {
+      out.insert(out.end(), tlas.instance_indices.begin() + node.first,
+                 tlas.instance_indices.begin() + node.first + node.count);
+    } else {
+      stack.push_back(node.first);
+      stack.push_back(node.first + 1);
+    }
+  }
+  std::sort(out.begin(), out.end());
+}
+
+void QueryStaticMeshTlasPacket(const StaticMeshTlas &tlas,
+                               const std::vector<StaticMeshTlasRay> &rays,
+                               std::vector<std::vector<uint32_t>> &out) {
+  out.resize(rays.size());
+  for (auto &candidates : out) {
+    candidates.clear();
+  }
+  if (tlas.nodes.empty() || rays.empty()) {
+    return;
+  }
+  // Each stack entry names a node and the span of active_rays that reached its parent. Survivors
+  // of the node's slab test are appended as a new span shared by both children; spans are popped
+  // in reverse allocation order, so everything past the popped span is dead and can be reused.
+  struct PacketEntry {
+    uint32_t node = 0;
+    size_t begin = 0;
+    size_t end = 0;
+  };
+  std::vector<uint32_t> active_rays;
+  active_rays.reserve(rays.size() * 4);
+  for (size_t i = 0; i < rays.size(); ++i) {
+    active_rays.push_back(static_cast<uint32_t>(i));
+  }
+  std::vector<PacketEntry> stack;
+  stack.reserve(64);
+  stack.push_back({0, 0, rays.size()});
+  while (!stack.empty()) {
+    const PacketEntry entry = stack.back();
+    stack.pop_back();
+    active_rays.resize(entry.end);
+    const auto &node = tlas.nodes[entry.node];
+    const size_t begin = active_rays.size();
+    for (size_t i = entry.begin; i < entry.end; ++i) {
+      const uint32_t ray_index = active_rays[i];
+      const auto &ray = rays[ray_index];
+      if (RayOverlapsBounds(ray.origin_x, ray.origin_y, ray.origin_z, ray.dir_x, ray.dir_y, ray.dir_z, ray.max_t,
+                            node.bounds)) {
+        active_rays.push_back(ray_index);
+      }
+    }
+    const size_t end = active_rays.size();
+    if (begin == end) {
+      continue;
+    }
+    if (node.count > 0) {
+      for (size_t i = begin; i < end; ++i) {
+        auto &candidates = out[active_rays[i]];
+        candidates.insert(candidates.end(), tlas.instance_indices.begin() + node.first,
+                          tlas.instance_indices.begin() + node.first + node.count);
+      }
+    } else {
+      stack.push_back({node.first, begin, end});
+      stack.push_back({node.first + 1, begin, end});
+    }
+  }
+  for (auto &candidates : out) {
+    std::sort(candidates.begin(), candidates.end());
+  }
+}
+
+}  // namespace afps::world
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "map_world.h"
+#include "world_collision_mesh.h"
+
+namespace afps::world {
+
+constexpr size_t kNoStaticMeshPrefab = std::numeric_limits<size_t>::max();
+
+// Top-level BVH over static mesh instance world bounds. Prefab indices and world bounds are
+// resolved once at map load so hitscan only descends the prefab BVHs of instances the ray reaches.
+struct StaticMeshTlas {
+  // Inner nodes have count == 0 and children at first and first + 1; leaves cover
+  // instance_indices[first, first + count).
+  struct Node {
+    CollisionMeshBounds bounds{};
+    uint32_t first = 0;
+    uint32_t count = 0;
+  };
+
+  std::vector<Node> nodes;
+  std::vector<uint32_t> instance_indices;
+  // Indexed by instance; kNoStaticMeshPrefab when the prefab is missing or has no triangles.
+  std::vector<size_t> prefab_indices;
+  std::vector<CollisionMeshBounds> instance_bounds;
+};
+
+CollisionMeshBounds BuildStaticMeshInstanceBounds(const StaticMeshInstance &instance,
+                                                  const CollisionMeshBounds &local_bounds);
+
+StaticMeshTlas BuildStaticMeshTlas(const std::vector<StaticMeshInstance> &instances,
+                                   const CollisionMeshRegistry &registry);
+
+// Collects, in ascending order, every instance whose world bounds the ray overlaps within
+// [0, max_t]. The slab test is conservative, so callers can rerun their exact per-instance test.
+void QueryStaticMeshTlas(const StaticMeshTlas &tlas,
+                         double origin_x,
+                         double origin_y,
+                         double origin_z,
+                         double dir_x,
+                         double dir_y,
+                         double dir_z,
+                         double max_t,
+                         std::vector<uint32_t> &out);
+
+struct StaticMeshTlasRay {
+  double origin_x = 0.0;
+  double origin_y = 0.0;
+  double origin_z = 0.0;
+  double dir_x = 0.0;
+  double dir_y = 0.0;
+  double dir_z = 0.0;
+  double max_t = 0.0;
+};
+
+// Packet form of QueryStaticMeshTlas: the tree is walked once and each node is tested against the
+// rays still active under it. out[i] holds exactly the candidates QueryStaticMeshTlas returns for
+// rays[i].
+void QueryStaticMeshTlasPacket(const StaticMeshTlas &tlas,
+                               const std::vector<StaticMeshTlasRay> &rays,
+                               std::vector<std::vector<uint32_t>> &out);
+
+}  // namespace afps::world
@@ -8,7 +8,6 @@
 #include <limits>
 #include <random>
 #include <type_traits>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -54,6 +53,7 @@ bool TickAccumulator::initialized() const {
 
 #ifdef AFPS_ENABLE_WEBRTC
 #include "protocol.h"
+#include "ray_kernels.h"
 #include "weapon_config.h"
 
 #include <chrono>
@@ -85,6 +85,39 @@ bool WorldHitAllowsAabbFallback(const WorldHitFallbackPolicyInput &input) {
   }
 }
 
+// The defaults must fit the wire ranges; configs built at runtime go through ValidateSnapshotFieldBounds.
+static_assert(afps::sim::kDefaultSimConfig.arena_half_size < kSnapshotPositionRangeMeters,
+              "default arena must fit the snapshot position range");
+static_assert(afps::sim::kDefaultSimConfig.dash_cooldown <= kSnapshotDashCooldownRangeSeconds,
+              "default dash cooldown must fit the snapshot dash cooldown range");
+static_assert(afps::combat::kMaxHealth <= kSnapshotHealthRange, "max health must fit the snapshot health range");
+
+SnapshotFieldBounds ComputeSnapshotFieldBounds(const afps::sim::SimConfig &config,
+                                               const afps::sim::CollisionWorld &world,
+                                               const afps::weapons::WeaponConfig &weapons) {
+  SnapshotFieldBounds bounds;
+  // Players stay inside the arena and can stand on top of any collider, then jump from there.
+  double max_abs = std::abs(config.arena_half_size);
+  double max_top = 0.0;
+  for (const auto &collider : world.colliders) {
+    if (!afps::sim::IsValidAabbCollider(collider)) {
+      continue;
+    }
+    max_abs = std::max({max_abs, std::abs(collider.min_x), std::abs(collider.max_x), std::abs(collider.min_y),
+                        std::abs(collider.max_y), std::abs(collider.min_z)});
+    max_top = std::max(max_top, collider.max_z);
+  }
+  const double jump_apex =
+      config.gravity > 0.0 ? (config.jump_velocity * config.jump_velocity) / (2.0 * config.gravity) : 0.0;
+  bounds.max_abs_position = std::max(max_abs, max_top + jump_apex);
+  bounds.max_dash_cooldown = config.dash_cooldown;
+  bounds.max_health = afps::combat::kMaxHealth;
+  for (const auto &weapon : weapons.weapons) {
+    bounds.max_ammo_in_mag = std::max(bounds.max_ammo_in_mag, weapon.max_ammo_in_mag);
+  }
+  return bounds;
+}
+
 }  // namespace afps::server
 
 namespace {
@@ -94,17 +127,26 @@ using afps::server::WorldHitFallbackPolicyInput;
 constexpr double kPi = 3.14159265358979323846;
 constexpr double kProjectileTtlSeconds = 3.0;
 constexpr double kProjectileRadius = 0.15;
+// Players per movement chunk; rooms at or below this step inline without waking the pool.
+constexpr size_t kMovementChunkPlayers = 8;
+// Fast projectiles sweep in pieces no longer than this so each piece's player query stays small.
+constexpr double kProjectileSubstepMeters = 4.0;
+constexpr int kProjectileMaxSubsteps = 8;
 constexpr double kHitDistanceStepMeters = 0.01;
 constexpr double kShotTracePositionStepMeters = 0.01;
 constexpr double kProjectilePositionStepMeters = 0.01;
 constexpr double kProjectileVelocityStepMetersPerSecond = 0.01;
 constexpr double kProjectileTtlStepSeconds = 0.01;
 constexpr double kNearMissExtraRadius = 0.75;
+// Upper bound on player speed used to widen the near-miss grid query over the rewind window.
+constexpr double kNearMissRewindSpeedMetersPerSecond = 30.0;
 constexpr double kEnergyHeatPerShot = 0.06;
 constexpr double kEnergyCoolPerSecond = 0.25;
 constexpr double kEnergyVentCoolPerSecond = 0.6;
 constexpr double kEnergyVentSeconds = 1.5;
 constexpr double kTraceCullDistanceMeters = 85.0;
+// Slack on broadphase reach so candidates on the boundary survive rounding in the grid distance test.
+constexpr double kBroadphasePaddingMeters = 0.01;
 constexpr int kSpawnAngleSamples = 24;
 constexpr double kShotMuzzleOffsetMeters = 0.2;
 constexpr double kShotNearMuzzleGraceMeters = 0.22;
@@ -152,26 +194,6 @@ int16_t QuantizeI16(double value, double step) {
   return static_cast<int16_t>(clamped);
 }
 
-int16_t QuantizeYaw(double yaw_rad) {
-  if (!std::isfinite(yaw_rad)) {
-    return 0;
-  }
-  const double wrapped = std::fmod(yaw_rad + kPi, 2.0 * kPi);
-  const double normalized = (wrapped < 0.0 ? wrapped + 2.0 * kPi : wrapped) - kPi;
-  const double q = normalized / kPi;
-  return static_cast<int16_t>(std::llround(std::max(-1.0, std::min(1.0, q)) * 32767.0));
-}
-
-int16_t QuantizePitch(double pitch_rad) {
-  if (!std::isfinite(pitch_rad)) {
-    return 0;
-  }
-  const double max_pitch = (kPi / 2.0) - 0.01;
-  const double clamped = std::max(-max_pitch, std::min(max_pitch, pitch_rad));
-  const double q = clamped / max_pitch;
-  return static_cast<int16_t>(std::llround(std::max(-1.0, std::min(1.0, q)) * 32767.0));
-}
-
 uint32_t HashString(const std::string &value) {
   uint32_t hash = 2166136261u;
   for (char ch : value) {
@@ -225,42 +247,6 @@ OctEncoded16 EncodeOct16(double x, double y, double z) {
           static_cast<int16_t>(std::llround(y * 32767.0))};
 }
 
-double RaycastAabb2D(double origin_x, double origin_y, double dir_x, double dir_y, double min_x, double max_x,
-                     double min_y, double max_y) {
-  const double inf = std::numeric_limits<double>::infinity();
-  const double epsilon = 1e-8;
-  double t_min = -inf;
-  double t_max = inf;
-
-  auto update_axis = [&](double origin, double dir, double min_bound, double max_bound) -> bool {
-    if (std::abs(dir) < epsilon) {
-      return origin >= min_bound && origin <= max_bound;
-    }
-    double t1 = (min_bound - origin) / dir;
-    double t2 = (max_bound - origin) / dir;
-    if (t1 > t2) {
-      std::swap(t1, t2);
-    }
-    t_min = std::max(t_min, t1);
-    t_max = std::min(t_max, t2);
-    return t_min <= t_max;
-  };
-
-  if (!update_axis(origin_x, dir_x, min_x, max_x)) {
-    return inf;
-  }
-  if (!update_axis(origin_y, dir_y, min_y, max_y)) {
-    return inf;
-  }
-  if (t_max < 0.0) {
-    return inf;
-  }
-  if (t_min >= 0.0) {
-    return t_min;
-  }
-  return t_max;
-}
-
 struct WorldHitscanHit {
   enum class Backend : uint8_t {
     None = 0,
@@ -521,6 +507,7 @@ void LogHitscanShotDebug(int server_tick,
                          double max_range,
                          double intended_distance,
                          const afps::combat::HitResult &player_hit,
+                         const std::string &player_hit_target,
                          const WorldHitscanHit &eye_world_hit,
                          bool muzzle_block_checked,
                          const WorldHitscanHit &muzzle_block_hit,
@@ -573,7 +560,7 @@ void LogHitscanShotDebug(int server_tick,
   out << ",\"dir\":";
   WriteVec3Json(out, dir);
   out << ",\"player_hit\":{\"hit\":" << (player_hit.hit ? "true" : "false")
-      << ",\"target_id\":\"" << EscapeJsonText(player_hit.target_id) << "\""
+      << ",\"target_id\":\"" << EscapeJsonText(player_hit_target) << "\""
       << ",\"distance\":" << (std::isfinite(player_hit.distance) ? player_hit.distance : -1.0)
       << ",\"position\":";
   WriteVec3Json(out, player_hit.position);
@@ -609,42 +596,43 @@ void LogHitscanShotDebug(int server_tick,
 
 void LogClientDecalDebug(int server_tick,
                          const std::string &connection_id,
-                         const InputCmd &cmd,
+                         const DecalDebugReport &report,
+                         const InputCmd *last_input,
                          const afps::sim::PlayerState *player_state) {
-  if (!cmd.debug_decal_report_present) {
-    return;
-  }
-
   std::ostringstream out;
   out << "{\"event\":\"client_decal_debug\""
       << ",\"server_tick\":" << server_tick
       << ",\"connection_id\":\"" << EscapeJsonText(connection_id) << "\""
-      << ",\"input_seq\":" << cmd.input_seq
-      << ",\"client_report\":{\"server_tick\":" << cmd.debug_decal_server_tick
-      << ",\"shot_seq\":" << cmd.debug_decal_shot_seq
-      << ",\"hit_kind\":" << static_cast<int>(cmd.debug_decal_hit_kind)
-      << ",\"surface_type\":" << static_cast<int>(cmd.debug_decal_surface_type)
-      << ",\"authoritative_world_hit\":" << (cmd.debug_decal_authoritative_world_hit ? "true" : "false")
-      << ",\"used_projected_hit\":" << (cmd.debug_decal_used_projected_hit ? "true" : "false")
-      << ",\"used_impact_projection\":" << (cmd.debug_decal_used_impact_projection ? "true" : "false")
-      << ",\"decal_spawned\":" << (cmd.debug_decal_spawned ? "true" : "false")
-      << ",\"decal_in_frustum\":" << (cmd.debug_decal_in_frustum ? "true" : "false")
-      << ",\"decal_distance\":" << cmd.debug_decal_distance
-      << ",\"decal_position\":{\"x\":" << cmd.debug_decal_position_x
-      << ",\"y\":" << cmd.debug_decal_position_y
-      << ",\"z\":" << cmd.debug_decal_position_z << "}"
-      << ",\"decal_normal\":{\"x\":" << cmd.debug_decal_normal_x
-      << ",\"y\":" << cmd.debug_decal_normal_y
-      << ",\"z\":" << cmd.debug_decal_normal_z << "}"
-      << ",\"trace_hit_position\":{\"x\":" << cmd.debug_trace_hit_position_x
-      << ",\"y\":" << cmd.debug_trace_hit_position_y
-      << ",\"z\":" << cmd.debug_trace_hit_position_z << "}"
-      << ",\"trace_hit_normal\":{\"x\":" << cmd.debug_trace_hit_normal_x
-      << ",\"y\":" << cmd.debug_trace_hit_normal_y
-      << ",\"z\":" << cmd.debug_trace_hit_normal_z << "}"
-      << "}"
-      << ",\"server_view\":{\"yaw\":" << cmd.view_yaw
-      << ",\"pitch\":" << cmd.view_pitch << "}";
+      << ",\"input_seq\":" << (last_input ? last_input->input_seq : -1)
+      << ",\"client_report\":{\"server_tick\":" << report.server_tick
+      << ",\"shot_seq\":" << report.shot_seq
+      << ",\"hit_kind\":" << static_cast<int>(report.hit_kind)
+      << ",\"surface_type\":" << static_cast<int>(report.surface_type)
+      << ",\"authoritative_world_hit\":" << (report.authoritative_world_hit ? "true" : "false")
+      << ",\"used_projected_hit\":" << (report.used_projected_hit ? "true" : "false")
+      << ",\"used_impact_projection\":" << (report.used_impact_projection ? "true" : "false")
+      << ",\"decal_spawned\":" << (report.decal_spawned ? "true" : "false")
+      << ",\"decal_in_frustum\":" << (report.decal_in_frustum ? "true" : "false")
+      << ",\"decal_distance\":" << report.decal_distance
+      << ",\"decal_position\":{\"x\":" << report.decal_position_x
+      << ",\"y\":" << report.decal_position_y
+      << ",\"z\":" << report.decal_position_z << "}"
+      << ",\"decal_normal\":{\"x\":" << report.decal_normal_x
+      << ",\"y\":" << report.decal_normal_y
+      << ",\"z\":" << report.decal_normal_z << "}"
+      << ",\"trace_hit_position\":{\"x\":" << report.trace_hit_position_x
+      << ",\"y\":" << report.trace_hit_position_y
+      << ",\"z\":" << report.trace_hit_position_z << "}"
+      << ",\"trace_hit_normal\":{\"x\":" << report.trace_hit_normal_x
+      << ",\"y\":" << report.trace_hit_normal_y
+      << ",\"z\":" << report.trace_hit_normal_z << "}"
+      << "}";
+  if (last_input) {
+    out << ",\"server_view\":{\"yaw\":" << last_input->view_yaw
+        << ",\"pitch\":" << last_input->view_pitch << "}";
+  } else {
+    out << ",\"server_view\":null";
+  }
   if (player_state) {
     out << ",\"server_player\":{\"x\":" << player_state->x
         << ",\"y\":" << player_state->y
@@ -695,15 +683,6 @@ afps::combat::Vec3 Normalize(const afps::combat::Vec3 &v) {
 
 double Clamp(double value, double min_value, double max_value);
 
-struct WorldAabbBounds {
-  double min_x = 0.0;
-  double max_x = 0.0;
-  double min_y = 0.0;
-  double max_y = 0.0;
-  double min_z = 0.0;
-  double max_z = 0.0;
-};
-
 std::array<double, 2> RotateQuarterTurns(double x, double y, uint8_t quarter_turns) {
   switch (quarter_turns & 3u) {
     case 1:
@@ -732,82 +711,51 @@ std::array<double, 2> InverseRotateQuarterTurns(double x, double y, uint8_t quar
   }
 }
 
-WorldAabbBounds BuildWorldBounds(const afps::world::StaticMeshInstance &instance,
-                                 const afps::world::CollisionMeshBounds &local_bounds) {
-  const double safe_scale = (std::isfinite(instance.scale) && instance.scale > 0.0)
-                                ? instance.scale
-                                : 1.0;
-  const double local_min_x = local_bounds.min_x * safe_scale;
-  const double local_max_x = local_bounds.max_x * safe_scale;
-  const double local_min_y = local_bounds.min_y * safe_scale;
-  const double local_max_y = local_bounds.max_y * safe_scale;
-  const double local_min_z = local_bounds.min_z * safe_scale;
-  const double local_max_z = local_bounds.max_z * safe_scale;
-
-  const std::array<std::array<double, 2>, 4> corners = {
-      RotateQuarterTurns(local_min_x, local_min_y, instance.yaw_quarter_turns),
-      RotateQuarterTurns(local_min_x, local_max_y, instance.yaw_quarter_turns),
-      RotateQuarterTurns(local_max_x, local_min_y, instance.yaw_quarter_turns),
-      RotateQuarterTurns(local_max_x, local_max_y, instance.yaw_quarter_turns),
-  };
-
-  WorldAabbBounds world;
-  world.min_x = std::numeric_limits<double>::infinity();
-  world.max_x = -std::numeric_limits<double>::infinity();
-  world.min_y = std::numeric_limits<double>::infinity();
-  world.max_y = -std::numeric_limits<double>::infinity();
-  for (const auto &corner : corners) {
-    world.min_x = std::min(world.min_x, instance.center_x + corner[0]);
-    world.max_x = std::max(world.max_x, instance.center_x + corner[0]);
-    world.min_y = std::min(world.min_y, instance.center_y + corner[1]);
-    world.max_y = std::max(world.max_y, instance.center_y + corner[1]);
-  }
-  world.min_z = instance.base_z + local_min_z;
-  world.max_z = instance.base_z + local_max_z;
-  return world;
-}
-
-double RaycastAabb3D(double origin_x,
-                     double origin_y,
-                     double origin_z,
-                     double dir_x,
-                     double dir_y,
-                     double dir_z,
-                     const WorldAabbBounds &bounds) {
-  const double inf = std::numeric_limits<double>::infinity();
-  const double epsilon = 1e-8;
-  double t_min = -inf;
-  double t_max = inf;
-  auto update_axis = [&](double origin, double dir, double min_bound, double max_bound) -> bool {
-    if (std::abs(dir) < epsilon) {
-      return origin >= min_bound && origin <= max_bound;
-    }
-    double t1 = (min_bound - origin) / dir;
-    double t2 = (max_bound - origin) / dir;
-    if (t1 > t2) {
-      std::swap(t1, t2);
-    }
-    t_min = std::max(t_min, t1);
-    t_max = std::min(t_max, t2);
-    return t_min <= t_max;
-  };
-
-  if (!update_axis(origin_x, dir_x, bounds.min_x, bounds.max_x)) {
-    return inf;
-  }
-  if (!update_axis(origin_y, dir_y, bounds.min_y, bounds.max_y)) {
-    return inf;
-  }
-  if (!update_axis(origin_z, dir_z, bounds.min_z, bounds.max_z)) {
-    return inf;
-  }
-  if (t_max < 0.0) {
-    return inf;
-  }
-  if (t_min >= 0.0) {
-    return t_min;
+size_t StaticMeshPrefabIndex(const afps::world::StaticMeshTlas &tlas,
+                             const std::vector<afps::world::StaticMeshInstance> &instances,
+                             const afps::world::CollisionMeshRegistry &registry,
+                             uint32_t instance_index) {
+  if (instance_index >= instances.size() || instance_index >= tlas.prefab_indices.size()) {
+    return afps::world::kNoStaticMeshPrefab;
+  }
+  const size_t prefab_index = tlas.prefab_indices[instance_index];
+  if (prefab_index >= registry.prefabs.size()) {
+    return afps::world::kNoStaticMeshPrefab;
+  }
+  return prefab_index;
+}
+
+// Distance to each candidate's world bounds (entry, or exit when the origin is inside; infinity
+// on a miss), computed kRayKernelLanes candidates per ray kernel call.
+void RaycastCandidateBounds(const afps::world::StaticMeshTlas &tlas,
+                            const std::vector<uint32_t> &candidates,
+                            const afps::combat::Vec3 &origin,
+                            const afps::combat::Vec3 &dir,
+                            std::vector<double> &out_t) {
+  const afps::combat::KernelRay ray{{origin.x, origin.y, origin.z}, {dir.x, dir.y, dir.z}};
+  afps::combat::BoxLanes boxes;
+  double t_enter[afps::combat::kRayKernelLanes] = {};
+  double t_exit[afps::combat::kRayKernelLanes] = {};
+  out_t.assign(candidates.size(), std::numeric_limits<double>::infinity());
+  for (size_t first = 0; first < candidates.size(); first += afps::combat::kRayKernelLanes) {
+    const size_t count = std::min(afps::combat::kRayKernelLanes, candidates.size() - first);
+    for (size_t lane = 0; lane < count; ++lane) {
+      const auto &bounds = tlas.instance_bounds[candidates[first + lane]];
+      boxes.min_x[lane] = bounds.min_x;
+      boxes.min_y[lane] = bounds.min_y;
+      boxes.min_z[lane] = bounds.min_z;
+      boxes.max_x[lane] = bounds.max_x;
+      boxes.max_y[lane] = bounds.max_y;
+      boxes.max_z[lane] = bounds.max_z;
+    }
+    const uint32_t mask = afps::combat::RaycastBoxLanes(ray, boxes, count, t_enter, t_exit);
+    for (size_t lane = 0; lane < count; ++lane) {
+      if ((mask & (1u << lane)) == 0 || t_exit[lane] < 0.0) {
+        continue;
+      }
+      out_t[first + lane] = t_enter[lane] >= 0.0 ? t_enter[lane] : t_exit[lane];
+    }
   }
-  return t_max;
 }
 
 afps::combat::Vec3 TransformWorldToLocalPoint(const afps::world::StaticMeshInstance &instance,
@@ -852,46 +800,6 @@ afps::combat::Vec3 TransformLocalToWorldNormal(const afps::world::StaticMeshInst
   return Normalize({rotated[0], rotated[1], local_normal.z});
 }
 
-bool IntersectTriangle(const afps::combat::Vec3 &origin,
-                       const afps::combat::Vec3 &dir,
-                       const afps::world::CollisionMeshPrefab::Triangle &triangle,
-                       double max_distance,
-                       double &out_t,
-                       afps::combat::Vec3 &out_normal) {
-  const afps::combat::Vec3 v0{triangle.v0_x, triangle.v0_y, triangle.v0_z};
-  const afps::combat::Vec3 v1{triangle.v1_x, triangle.v1_y, triangle.v1_z};
-  const afps::combat::Vec3 v2{triangle.v2_x, triangle.v2_y, triangle.v2_z};
-  const afps::combat::Vec3 edge1 = Sub(v1, v0);
-  const afps::combat::Vec3 edge2 = Sub(v2, v0);
-  const afps::combat::Vec3 pvec = Cross(dir, edge2);
-  const double det = Dot(edge1, pvec);
-  constexpr double kEps = 1e-8;
-  if (std::abs(det) <= kEps) {
-    return false;
-  }
-  const double inv_det = 1.0 / det;
-  const afps::combat::Vec3 tvec = Sub(origin, v0);
-  const double u = Dot(tvec, pvec) * inv_det;
-  if (u < 0.0 || u > 1.0) {
-    return false;
-  }
-  const afps::combat::Vec3 qvec = Cross(tvec, edge1);
-  const double v = Dot(dir, qvec) * inv_det;
-  if (v < 0.0 || (u + v) > 1.0) {
-    return false;
-  }
-  const double t = Dot(edge2, qvec) * inv_det;
-  if (!std::isfinite(t) || t < 0.0 || t > max_distance) {
-    return false;
-  }
-  out_t = t;
-  out_normal = Normalize(Cross(edge1, edge2));
-  if (!std::isfinite(out_normal.x) || !std::isfinite(out_normal.y) || !std::isfinite(out_normal.z)) {
-    return false;
-  }
-  return true;
-}
-
 bool RaycastPrefabBvh(const afps::world::CollisionMeshPrefab &prefab,
                       const afps::combat::Vec3 &origin_local,
                       const afps::combat::Vec3 &dir_local,
@@ -899,71 +807,17 @@ bool RaycastPrefabBvh(const afps::world::CollisionMeshPrefab &prefab,
                       double &out_t,
                       uint32_t &out_triangle_index,
                       afps::combat::Vec3 &out_normal_local) {
-  if (prefab.bvh_nodes.empty() || prefab.triangle_indices.empty() || prefab.triangles.empty()) {
+  afps::world::CollisionMeshRayHit hit;
+  if (!afps::world::RaycastCollisionMeshPrefab(prefab,
+                                               {origin_local.x, origin_local.y, origin_local.z},
+                                               {dir_local.x, dir_local.y, dir_local.z},
+                                               max_distance,
+                                               hit)) {
     return false;
   }
-  double best_t = max_distance;
-  uint32_t best_triangle = 0;
-  afps::combat::Vec3 best_normal{};
-  bool hit = false;
-
-  std::vector<uint32_t> stack;
-  stack.reserve(64);
-  stack.push_back(0);
-
-  while (!stack.empty()) {
-    const uint32_t node_index = stack.back();
-    stack.pop_back();
-    if (node_index >= prefab.bvh_nodes.size()) {
-      continue;
-    }
-    const auto &node = prefab.bvh_nodes[node_index];
-    const WorldAabbBounds node_bounds{
-        node.bounds.min_x, node.bounds.max_x, node.bounds.min_y, node.bounds.max_y, node.bounds.min_z, node.bounds.max_z};
-    const double node_t = RaycastAabb3D(origin_local.x,
-                                        origin_local.y,
-                                        origin_local.z,
-                                        dir_local.x,
-                                        dir_local.y,
-                                        dir_local.z,
-                                        node_bounds);
-    if (!std::isfinite(node_t) || node_t > best_t) {
-      continue;
-    }
-
-    if (node.leaf) {
-      const uint32_t end = std::min<uint32_t>(node.end, static_cast<uint32_t>(prefab.triangle_indices.size()));
-      for (uint32_t i = node.begin; i < end; ++i) {
-        const uint32_t triangle_index = prefab.triangle_indices[i];
-        if (triangle_index >= prefab.triangles.size()) {
-          continue;
-        }
-        double tri_t = 0.0;
-        afps::combat::Vec3 tri_normal{};
-        if (!IntersectTriangle(origin_local, dir_local, prefab.triangles[triangle_index], best_t, tri_t, tri_normal)) {
-          continue;
-        }
-        hit = true;
-        best_t = tri_t;
-        best_triangle = triangle_index;
-        best_normal = tri_normal;
-      }
-    } else {
-      if (node.left < prefab.bvh_nodes.size()) {
-        stack.push_back(node.left);
-      }
-      if (node.right < prefab.bvh_nodes.size()) {
-        stack.push_back(node.right);
-      }
-    }
-  }
-
-  if (!hit) {
-    return false;
-  }
-  out_t = best_t;
-  out_triangle_index = best_triangle;
-  out_normal_local = best_normal;
+  out_t = hit.t;
+  out_triangle_index = hit.triangle_index;
+  out_normal_local = {hit.normal.x, hit.normal.y, hit.normal.z};
   return true;
 }
 
@@ -973,7 +827,7 @@ ShadowDetailedWorldHit ResolveShadowDetailedWorldHitscan(
     double max_distance,
     const std::vector<afps::world::StaticMeshInstance> &instances,
     const afps::world::CollisionMeshRegistry &registry,
-    const std::unordered_map<std::string, size_t> &prefab_lookup) {
+    const afps::world::StaticMeshTlas &tlas) {
   ShadowDetailedWorldHit best;
   best.distance = std::numeric_limits<double>::infinity();
   const double limit =
@@ -983,19 +837,20 @@ ShadowDetailedWorldHit ResolveShadowDetailedWorldHitscan(
   }
 
   const afps::combat::Vec3 safe_dir = Normalize(dir);
-  for (const auto &instance : instances) {
-    const auto lookup_iter = prefab_lookup.find(instance.prefab_id);
-    if (lookup_iter == prefab_lookup.end()) {
-      continue;
-    }
-    const size_t prefab_index = lookup_iter->second;
-    if (prefab_index >= registry.prefabs.size()) {
+  std::vector<uint32_t> candidates;
+  afps::world::QueryStaticMeshTlas(
+      tlas, origin.x, origin.y, origin.z, safe_dir.x, safe_dir.y, safe_dir.z, limit, candidates);
+  std::vector<double> candidate_t;
+  RaycastCandidateBounds(tlas, candidates, origin, safe_dir, candidate_t);
+  for (size_t candidate = 0; candidate < candidates.size(); ++candidate) {
+    const uint32_t instance_index = candidates[candidate];
+    const size_t prefab_index = StaticMeshPrefabIndex(tlas, instances, registry, instance_index);
+    if (prefab_index == afps::world::kNoStaticMeshPrefab) {
       continue;
     }
+    const auto &instance = instances[instance_index];
     const auto &prefab = registry.prefabs[prefab_index];
-    const WorldAabbBounds bounds = BuildWorldBounds(instance, prefab.bounds);
-    const double t = RaycastAabb3D(
-        origin.x, origin.y, origin.z, safe_dir.x, safe_dir.y, safe_dir.z, bounds);
+    const double t = candidate_t[candidate];
     if (!std::isfinite(t) || t < 0.0 || t > limit || t >= best.distance) {
       continue;
     }
@@ -1181,55 +1036,70 @@ WorldHitscanHit ResolveWorldHitscanAabb(const afps::combat::Vec3 &origin,
   return best;
 }
 
-WorldHitscanHit ResolveWorldHitscanDetailed(const afps::combat::Vec3 &origin,
-                                            const afps::combat::Vec3 &dir,
-                                            double max_range,
-                                            const afps::sim::RaycastWorldOptions &options,
-                                            const std::vector<afps::world::StaticMeshInstance> &instances,
-                                            const afps::world::CollisionMeshRegistry &registry,
-                                            const std::unordered_map<std::string, size_t> &prefab_lookup,
-                                            uint32_t ignore_instance_id,
-                                            uint32_t only_instance_id = 0) {
-  WorldHitscanHit best;
-  best.distance = std::numeric_limits<double>::infinity();
+// Trace window of a detailed (mesh) hitscan. Invalid when the window is empty or there is no
+// mesh data to test.
+struct DetailedTraceWindow {
+  bool valid = false;
+  double min_t = 0.0;
+  double max_t = 0.0;
+};
+
+DetailedTraceWindow ResolveDetailedTraceWindow(double max_range,
+                                               const afps::sim::RaycastWorldOptions &options,
+                                               const std::vector<afps::world::StaticMeshInstance> &instances,
+                                               const afps::world::CollisionMeshRegistry &registry) {
+  DetailedTraceWindow window;
   const double clamped_max_range =
       (std::isfinite(max_range) && max_range > 0.0) ? max_range : std::numeric_limits<double>::infinity();
-  double min_t = options.min_t;
-  if (!std::isfinite(min_t) || min_t < 0.0) {
-    min_t = 0.0;
-  }
-  double max_t = options.max_t;
-  if (!std::isfinite(max_t) || max_t > clamped_max_range) {
-    max_t = clamped_max_range;
-  }
-  if (!std::isfinite(max_t) || max_t < min_t || instances.empty() || registry.prefabs.empty()) {
+  window.min_t = options.min_t;
+  if (!std::isfinite(window.min_t) || window.min_t < 0.0) {
+    window.min_t = 0.0;
+  }
+  window.max_t = options.max_t;
+  if (!std::isfinite(window.max_t) || window.max_t > clamped_max_range) {
+    window.max_t = clamped_max_range;
+  }
+  window.valid = std::isfinite(window.max_t) && window.max_t >= window.min_t && !instances.empty() &&
+                 !registry.prefabs.empty();
+  return window;
+}
+
+// Exact mesh test of TLAS candidates, which must come from a query of origin and safe_dir over
+// window.max_t.
+WorldHitscanHit ResolveWorldHitscanCandidates(const afps::combat::Vec3 &origin,
+                                              const afps::combat::Vec3 &safe_dir,
+                                              const DetailedTraceWindow &window,
+                                              const std::vector<uint32_t> &candidates,
+                                              const std::vector<afps::world::StaticMeshInstance> &instances,
+                                              const afps::world::CollisionMeshRegistry &registry,
+                                              const afps::world::StaticMeshTlas &tlas,
+                                              uint32_t ignore_instance_id,
+                                              uint32_t only_instance_id = 0) {
+  WorldHitscanHit best;
+  best.distance = std::numeric_limits<double>::infinity();
+  if (!window.valid) {
     return best;
   }
-
-  const afps::combat::Vec3 safe_dir = Normalize(dir);
-  for (const auto &instance : instances) {
-    if (only_instance_id > 0 && instance.instance_id != only_instance_id) {
+  const double min_t = window.min_t;
+  const double max_t = window.max_t;
+  std::vector<double> candidate_t;
+  RaycastCandidateBounds(tlas, candidates, origin, safe_dir, candidate_t);
+  for (size_t candidate = 0; candidate < candidates.size(); ++candidate) {
+    const uint32_t instance_index = candidates[candidate];
+    const size_t prefab_index = StaticMeshPrefabIndex(tlas, instances, registry, instance_index);
+    if (prefab_index == afps::world::kNoStaticMeshPrefab) {
       continue;
     }
-    if (ignore_instance_id > 0 && instance.instance_id == ignore_instance_id) {
-      continue;
-    }
-    const auto lookup_iter = prefab_lookup.find(instance.prefab_id);
-    if (lookup_iter == prefab_lookup.end()) {
+    const auto &instance = instances[instance_index];
+    if (only_instance_id > 0 && instance.instance_id != only_instance_id) {
       continue;
     }
-    const size_t prefab_index = lookup_iter->second;
-    if (prefab_index >= registry.prefabs.size()) {
+    if (ignore_instance_id > 0 && instance.instance_id == ignore_instance_id) {
       continue;
     }
     const auto &prefab = registry.prefabs[prefab_index];
-    if (prefab.triangles.empty() || prefab.bvh_nodes.empty()) {
-      continue;
-    }
 
-    const WorldAabbBounds bounds = BuildWorldBounds(instance, prefab.bounds);
-    const double t_aabb = RaycastAabb3D(
-        origin.x, origin.y, origin.z, safe_dir.x, safe_dir.y, safe_dir.z, bounds);
+    const double t_aabb = candidate_t[candidate];
     if (!std::isfinite(t_aabb) || t_aabb > max_t || t_aabb >= best.distance) {
       continue;
     }
@@ -1272,13 +1142,61 @@ WorldHitscanHit ResolveWorldHitscanDetailed(const afps::combat::Vec3 &origin,
   return best;
 }
 
+WorldHitscanHit ResolveWorldHitscanDetailed(const afps::combat::Vec3 &origin,
+                                            const afps::combat::Vec3 &dir,
+                                            double max_range,
+                                            const afps::sim::RaycastWorldOptions &options,
+                                            const std::vector<afps::world::StaticMeshInstance> &instances,
+                                            const afps::world::CollisionMeshRegistry &registry,
+                                            const afps::world::StaticMeshTlas &tlas,
+                                            uint32_t ignore_instance_id,
+                                            uint32_t only_instance_id = 0) {
+  const DetailedTraceWindow window = ResolveDetailedTraceWindow(max_range, options, instances, registry);
+  const afps::combat::Vec3 safe_dir = Normalize(dir);
+  std::vector<uint32_t> candidates;
+  if (window.valid) {
+    afps::world::QueryStaticMeshTlas(
+        tlas, origin.x, origin.y, origin.z, safe_dir.x, safe_dir.y, safe_dir.z, window.max_t, candidates);
+  }
+  return ResolveWorldHitscanCandidates(origin, safe_dir, window, candidates, instances, registry, tlas,
+                                       ignore_instance_id, only_instance_id);
+}
+
+// Picks between the AABB and mesh answers for one trace.
+WorldHitscanHit MergeWorldHitscanHits(const WorldHitscanHit &aabb_hit,
+                                      const WorldHitscanHit &mesh_hit,
+                                      WorldHitBackendMode backend_mode,
+                                      double max_range) {
+  if (!mesh_hit.hit) {
+    const WorldHitFallbackPolicyInput fallback_input{
+        backend_mode,
+        aabb_hit.hit,
+        aabb_hit.collider_id,
+        false,
+    };
+    if (afps::server::WorldHitAllowsAabbFallback(fallback_input)) {
+      return aabb_hit;
+    }
+    WorldHitscanHit no_hit;
+    no_hit.distance = (std::isfinite(max_range) && max_range > 0.0) ? max_range : 0.0;
+    return no_hit;
+  }
+
+  if (aabb_hit.hit && aabb_hit.collider_id <= 0 &&
+      aabb_hit.distance + kShotRetraceEpsilonMeters < mesh_hit.distance) {
+    return aabb_hit;
+  }
+
+  return mesh_hit;
+}
+
 WorldHitscanHit ResolveWorldHitscan(const afps::combat::Vec3 &origin,
                                     const afps::combat::Vec3 &dir,
                                     const afps::sim::SimConfig &config,
                                     const afps::sim::CollisionWorld *world,
                                     const std::vector<afps::world::StaticMeshInstance> &instances,
                                     const afps::world::CollisionMeshRegistry &registry,
-                                    const std::unordered_map<std::string, size_t> &prefab_lookup,
+                                    const afps::world::StaticMeshTlas &tlas,
                                     bool collision_mesh_enabled,
                                     double max_range,
                                     WorldHitBackendMode backend_mode,
@@ -1313,29 +1231,66 @@ WorldHitscanHit ResolveWorldHitscan(const afps::combat::Vec3 &origin,
   }
 
   const WorldHitscanHit mesh_hit =
-      ResolveWorldHitscanDetailed(origin, dir, max_range, options, instances, registry, prefab_lookup,
+      ResolveWorldHitscanDetailed(origin, dir, max_range, options, instances, registry, tlas,
                                   resolved_ignore_instance_id);
-  if (!mesh_hit.hit) {
-    const WorldHitFallbackPolicyInput fallback_input{
-        backend_mode,
-        aabb_hit.hit,
-        aabb_hit.collider_id,
-        false,
-    };
-    if (afps::server::WorldHitAllowsAabbFallback(fallback_input)) {
-      return aabb_hit;
-    }
-    WorldHitscanHit no_hit;
-    no_hit.distance = (std::isfinite(max_range) && max_range > 0.0) ? max_range : 0.0;
-    return no_hit;
-  }
+  return MergeWorldHitscanHits(aabb_hit, mesh_hit, backend_mode, max_range);
+}
 
-  if (aabb_hit.hit && aabb_hit.collider_id <= 0 &&
-      aabb_hit.distance + kShotRetraceEpsilonMeters < mesh_hit.distance) {
-    return aabb_hit;
+struct WorldHitscanRay {
+  afps::combat::Vec3 origin{};
+  afps::combat::Vec3 dir{};
+  double max_range = 0.0;
+  // Packets never resolve an ignored mesh instance, so ignore_collider_id must keep its default.
+  afps::sim::RaycastWorldOptions options{};
+};
+
+// Packet form of ResolveWorldHitscan: the static mesh TLAS is walked once for every ray and out[i]
+// equals ResolveWorldHitscan for rays[i].
+void ResolveWorldHitscanPacket(const std::vector<WorldHitscanRay> &rays,
+                               const afps::sim::SimConfig &config,
+                               const afps::sim::CollisionWorld *world,
+                               const std::vector<afps::world::StaticMeshInstance> &instances,
+                               const afps::world::CollisionMeshRegistry &registry,
+                               const afps::world::StaticMeshTlas &tlas,
+                               bool collision_mesh_enabled,
+                               WorldHitBackendMode backend_mode,
+                               std::vector<WorldHitscanHit> &out) {
+  out.clear();
+  out.reserve(rays.size());
+  for (const auto &ray : rays) {
+    out.push_back(ResolveWorldHitscanAabb(ray.origin, ray.dir, config, world, ray.max_range, ray.options));
+  }
+  if (backend_mode == WorldHitBackendMode::Aabb || !collision_mesh_enabled) {
+    return;
   }
 
-  return mesh_hit;
+  std::vector<DetailedTraceWindow> windows;
+  std::vector<afps::world::StaticMeshTlasRay> tlas_rays;
+  windows.reserve(rays.size());
+  tlas_rays.reserve(rays.size());
+  for (const auto &ray : rays) {
+    const DetailedTraceWindow window = ResolveDetailedTraceWindow(ray.max_range, ray.options, instances, registry);
+    const afps::combat::Vec3 safe_dir = Normalize(ray.dir);
+    afps::world::StaticMeshTlasRay tlas_ray;
+    tlas_ray.origin_x = ray.origin.x;
+    tlas_ray.origin_y = ray.origin.y;
+    tlas_ray.origin_z = ray.origin.z;
+    tlas_ray.dir_x = safe_dir.x;
+    tlas_ray.dir_y = safe_dir.y;
+    tlas_ray.dir_z = safe_dir.z;
+    // Rays without a valid window still ride along; their candidates are ignored below.
+    tlas_ray.max_t = window.valid ? window.max_t : 0.0;
+    windows.push_back(window);
+    tlas_rays.push_back(tlas_ray);
+  }
+  std::vector<std::vector<uint32_t>> candidates;
+  afps::world::QueryStaticMeshTlasPacket(tlas, tlas_rays, candidates);
+  for (size_t i = 0; i < rays.size(); ++i) {
+    const afps::combat::Vec3 safe_dir{tlas_rays[i].dir_x, tlas_rays[i].dir_y, tlas_rays[i].dir_z};
+    const WorldHitscanHit mesh_hit = ResolveWorldHitscanCandidates(
+        rays[i].origin, safe_dir, windows[i], candidates[i], instances, registry, tlas, 0);
+    out[i] = MergeWorldHitscanHits(out[i], mesh_hit, backend_mode, rays[i].max_range);
+  }
 }
 
 bool IsSpawnPointBlocked(const afps::sim::CollisionWorld &world,
@@ -1464,16 +1419,49 @@ void LogSpawnState(const std::string &connection_id,
 }
 }  // namespace
 
-TickLoop::TickLoop(SignalingStore &store,
+struct TickLoop::FireEvent {
+  afps::entity::EntitySlot slot = afps::entity::kInvalidSlot;
+  FireWeaponRequest request;
+};
+
+// A hitscan shot that passed its weapon checks, waiting for the tick's batched trace.
+struct TickLoop::PendingHitscanShot {
+  const FireEvent *event = nullptr;
+  const afps::weapons::WeaponDef *weapon = nullptr;
+  int active_slot = 0;
+  int shot_seq = 0;
+  uint32_t loadout_bits = 0;
+  int estimated_tick = 0;
+  afps::combat::RewindPose shooter_pose{};
+  afps::combat::Vec3 origin{};
+  afps::combat::Vec3 muzzle{};
+  afps::combat::Vec3 shot_dir{};
+  afps::combat::ViewAngles shot_view{};
+  OctEncoded16 dir_oct{};
+  double max_range = 0.0;
+};
+
+struct TickLoop::ShockwaveEvent {
+  afps::entity::EntitySlot slot = afps::entity::kInvalidSlot;
+  afps::combat::Vec3 origin{};
+};
+
+TickLoop::TickLoop(TickTransport &transport,
                    int tick_rate,
                    int snapshot_keyframe_interval,
                    uint32_t map_seed,
-                   const afps::world::MapWorldOptions &map_options)
-    : store_(store),
+                   const afps::world::MapWorldOptions &map_options,
+                   bool interest_occlusion,
+                   std::string room_id,
+                   size_t movement_workers)
+    : transport_(transport),
+      room_id_(std::move(room_id)),
       accumulator_(tick_rate),
-      snapshot_keyframe_interval_(snapshot_keyframe_interval),
+      movement_pool_(movement_workers),
       map_seed_(map_seed),
-      map_options_(map_options) {
+      map_options_(map_options),
+      interest_occlusion_(interest_occlusion),
+      snapshot_keyframe_interval_(snapshot_keyframe_interval) {
   pose_history_limit_ = std::max(1, accumulator_.tick_rate() * 2);
   std::string weapon_error;
   weapon_config_ = afps::weapons::LoadWeaponConfig(afps::weapons::ResolveWeaponConfigPath(),
@@ -1496,19 +1484,13 @@ TickLoop::TickLoop(SignalingStore &store,
   std::string collision_mesh_error;
   collision_mesh_registry_loaded_ =
       afps::world::LoadCollisionMeshRegistry(collision_mesh_registry_, collision_mesh_error);
-  collision_mesh_prefab_lookup_.clear();
+  static_mesh_tlas_ = {};
   if (!collision_mesh_registry_loaded_) {
     if (!collision_mesh_error.empty()) {
       std::cerr << "[warn] " << collision_mesh_error << "\n";
     }
   } else {
-    collision_mesh_prefab_lookup_.reserve(collision_mesh_registry_.prefabs.size());
-    for (size_t i = 0; i < collision_mesh_registry_.prefabs.size(); ++i) {
-      const std::string &id = collision_mesh_registry_.prefabs[i].id;
-      if (!id.empty()) {
-        collision_mesh_prefab_lookup_[id] = i;
-      }
-    }
+    static_mesh_tlas_ = afps::world::BuildStaticMeshTlas(static_mesh_instances_, collision_mesh_registry_);
   }
   std::cout << "{\"event\":\"world_hit_backend_mode\",\"mode\":\""
             << WorldHitBackendModeName(ResolveWorldHitBackendMode())
@@ -1545,105 +1527,169 @@ void TickLoop::Stop() {
 void TickLoop::Run() {
   last_log_time_ = TickAccumulator::Clock::now();
   while (running_.load()) {
-    auto now = TickAccumulator::Clock::now();
-    const int ticks = accumulator_.Advance(now);
-    if (ticks == 0) {
-      std::this_thread::sleep_until(accumulator_.next_tick_time());
-      continue;
-    }
-    for (int i = 0; i < ticks; ++i) {
-      Step();
-      ++tick_count_;
-    }
-    now = TickAccumulator::Clock::now();
+    const auto next_tick_time = Advance(TickAccumulator::Clock::now());
+    const auto now = TickAccumulator::Clock::now();
     if (now - last_log_time_ >= std::chrono::seconds(1)) {
-      const auto connections = store_.ConnectionCount();
+      const auto connections = transport_.ConnectionCount();
       std::cout << "[tick] rate=" << accumulator_.tick_rate() << " ticks=" << tick_count_
                 << " conns=" << connections << " batches=" << batch_count_ << " inputs="
-                << input_count_ << " snapshots=" << snapshot_count_ << "\n";
+                << input_count_ << " input_underruns=" << input_underrun_count_
+                << " input_catch_up=" << input_catch_up_count_ << " snapshots=" << snapshot_count_ << "\n";
       tick_count_ = 0;
       batch_count_ = 0;
       input_count_ = 0;
+      input_underrun_count_ = 0;
+      input_catch_up_count_ = 0;
       snapshot_count_ = 0;
       last_log_time_ = now;
     }
+    std::this_thread::sleep_until(next_tick_time);
   }
 }
 
+TickAccumulator::Clock::time_point TickLoop::Advance(TickAccumulator::Clock::time_point now) {
+  const int ticks = accumulator_.Advance(now);
+  for (int i = 0; i < ticks; ++i) {
+    Step();
+    ++tick_count_;
+  }
+  return accumulator_.next_tick_time();
+}
+
+TickAccumulator::Clock::duration TickLoop::tick_duration() const {
+  return accumulator_.tick_duration();
+}
+
+const std::string &TickLoop::room_id() const {
+  return room_id_;
+}
+
+size_t TickLoop::player_count() const {
+  return entities_.size();
+}
+
+double TickLoop::last_flush_ms() const {
+  return last_flush_ms_;
+}
+
+void TickLoop::ResizeEntityComponents(size_t count) {
+  if (players_.size() >= count) {
+    return;
+  }
+  entity_hashes_.resize(count, 0);
+  last_inputs_.resize(count);
+  has_last_input_.resize(count, 0);
+  input_buffers_.resize(count);
+  tick_inputs_.resize(count);
+  players_.resize(count);
+  last_input_seq_.resize(count, -1);
+  last_input_server_tick_.resize(count, -1);
+  snapshot_histories_.resize(count);
+  weapon_states_.resize(count);
+  loadout_bits_.resize(count, 0);
+  pose_histories_.resize(count);
+  combat_states_.resize(count, afps::combat::CreateCombatState());
+  pickup_sync_sent_.resize(count, 0);
+  trace_sent_.resize(count, 0);
+}
+
+void TickLoop::ResetEntityComponents(afps::entity::EntitySlot slot) {
+  if (slot >= players_.size()) {
+    return;
+  }
+  entity_hashes_[slot] = 0;
+  last_inputs_[slot] = InputCmd{};
+  has_last_input_[slot] = 0;
+  input_buffers_[slot].Reset();
+  tick_inputs_[slot].clear();
+  players_[slot] = afps::sim::PlayerState{};
+  last_input_seq_[slot] = -1;
+  last_input_server_tick_[slot] = -1;
+  snapshot_histories_[slot] = SnapshotHistory();
+  weapon_states_[slot] = PlayerWeaponState{};
+  loadout_bits_[slot] = 0;
+  pose_histories_[slot] = afps::combat::PoseHistory();
+  combat_states_[slot] = afps::combat::CreateCombatState();
+  pickup_sync_sent_[slot] = 0;
+}
+
 void TickLoop::Step() {
   server_tick_ += 1;
 
-  const auto active_ids = store_.ReadyConnectionIds();
-  std::unordered_set<std::string> active_set(active_ids.begin(), active_ids.end());
-  auto prune = [&active_set](auto &map) {
-    for (auto iter = map.begin(); iter != map.end(); ) {
-      if (active_set.find(iter->first) == active_set.end()) {
-        iter = map.erase(iter);
-      } else {
-        ++iter;
+  const auto ready_ids = transport_.ReadyConnectionIds(room_id_);
+  auto &active_slots = active_slots_;
+  auto &joined_slots = joined_slots_;
+  active_slots.clear();
+  joined_slots.clear();
+  active_slots.reserve(ready_ids.size());
+  for (const auto &connection_id : ready_ids) {
+    afps::entity::EntitySlot slot = entities_.Find(connection_id);
+    if (slot == afps::entity::kInvalidSlot) {
+      slot = entities_.Acquire(connection_id).slot;
+      if (slot == afps::entity::kInvalidSlot) {
+        continue;
       }
+      joined_slots.push_back(slot);
     }
-  };
-  prune(last_inputs_);
-  prune(players_);
-  prune(last_input_seq_);
-  prune(last_input_server_tick_);
-  prune(last_full_snapshots_);
-  prune(snapshot_sequence_);
-  prune(weapon_states_);
-  prune(loadout_bits_);
-  prune(pose_histories_);
-  prune(combat_states_);
-  for (auto iter = pickup_sync_sent_.begin(); iter != pickup_sync_sent_.end();) {
-    if (active_set.find(*iter) == active_set.end()) {
-      iter = pickup_sync_sent_.erase(iter);
-    } else {
-      ++iter;
-    }
+    active_slots.push_back(slot);
   }
+  auto &released_slots = released_slots_;
+  released_slots.clear();
+  entities_.RetainOnly(active_slots, released_slots);
+  ResizeEntityComponents(entities_.capacity());
+  for (const auto slot : released_slots) {
+    ResetEntityComponents(slot);
+  }
+  const size_t entity_capacity = entities_.capacity();
 
-  struct FireEvent {
-    std::string connection_id;
-    FireWeaponRequest request;
-  };
-  std::vector<FireEvent> fire_events;
-  struct ShockwaveEvent {
-    std::string connection_id;
-    afps::combat::Vec3 origin{};
-  };
-  std::vector<ShockwaveEvent> shockwave_events;
+  auto &fire_events = fire_events_;
+  fire_events.clear();
+  auto &shockwave_events = shockwave_events_;
+  shockwave_events.clear();
 
-  std::unordered_map<std::string, std::vector<FxEventData>> fx_events;
-  fx_events.reserve(active_ids.size());
-  std::unordered_map<std::string, std::vector<FxEventData>> reliable_decal_events;
-  reliable_decal_events.reserve(active_ids.size());
-  for (const auto &connection_id : active_ids) {
-    fx_events.emplace(connection_id, std::vector<FxEventData>{});
-    reliable_decal_events.emplace(connection_id, std::vector<FxEventData>{});
+  fx_events_.resize(entity_capacity);
+  reliable_decal_events_.resize(entity_capacity);
+  for (size_t slot = 0; slot < entity_capacity; ++slot) {
+    fx_events_[slot].clear();
+    reliable_decal_events_[slot].clear();
   }
+  auto &fx_events = fx_events_;
+  auto &reliable_decal_events = reliable_decal_events_;
   auto emit_fx_all = [&](const FxEventData &event) {
-    for (auto &entry : fx_events) {
-      entry.second.push_back(event);
+    for (const auto slot : active_slots) {
+      fx_events[slot].push_back(event);
     }
   };
-  auto emit_fx_to = [&](const std::string &connection_id, const FxEventData &event) {
-    auto iter = fx_events.find(connection_id);
-    if (iter != fx_events.end()) {
-      iter->second.push_back(event);
+  auto emit_fx_to = [&](afps::entity::EntitySlot slot, const FxEventData &event) {
+    if (slot < fx_events.size()) {
+      fx_events[slot].push_back(event);
     }
   };
-  auto emit_reliable_decal_to = [&](const std::string &connection_id, const FxEventData &event) {
-    auto iter = reliable_decal_events.find(connection_id);
-    if (iter != reliable_decal_events.end()) {
-      iter->second.push_back(event);
+  auto &interest_matches = interest_matches_;
+  auto emit_fx_near = [&](afps::entity::EntitySlot source, const afps::sim::Vec3 &origin, double radius,
+                          const FxEventData &event) {
+    emit_fx_to(source, event);
+    interest_matches.clear();
+    interest_grid_.Query(origin, radius, interest_matches);
+    for (const size_t index : interest_matches) {
+      if (index != source) {
+        emit_fx_to(static_cast<afps::entity::EntitySlot>(index), event);
+      }
+    }
+  };
+  auto emit_reliable_decal_to = [&](afps::entity::EntitySlot slot, const FxEventData &event) {
+    if (slot < reliable_decal_events.size()) {
+      reliable_decal_events[slot].push_back(event);
     }
   };
   auto emit_reliable_decal_all = [&](const FxEventData &event) {
-    for (auto &entry : reliable_decal_events) {
-      entry.second.push_back(event);
+    for (const auto slot : active_slots) {
+      reliable_decal_events[slot].push_back(event);
     }
   };
-  auto emit_kill_feed_all = [&](const std::string &killer_id, const std::string &victim_id) {
+  auto emit_kill_feed_all = [&](afps::entity::EntitySlot killer, afps::entity::EntitySlot victim) {
+    const std::string &killer_id = entities_.IdOf(killer);
+    const std::string &victim_id = entities_.IdOf(victim);
     if (killer_id.empty() || victim_id.empty()) {
       return;
     }
@@ -1664,10 +1710,11 @@ void TickLoop::Step() {
     return fx;
   };
 
-  for (const auto &connection_id : active_ids) {
-    if (pickup_sync_sent_.find(connection_id) != pickup_sync_sent_.end()) {
+  for (const auto slot : active_slots) {
+    if (pickup_sync_sent_[slot]) {
       continue;
     }
+    const std::string &connection_id = entities_.IdOf(slot);
     std::vector<FxEventData> active_pickups;
     active_pickups.reserve(pickups_.size());
     for (const auto &pickup : pickups_) {
@@ -1686,25 +1733,21 @@ void TickLoop::Step() {
         batch.events.insert(batch.events.end(), active_pickups.begin() + static_cast<long>(index),
                             active_pickups.begin() + static_cast<long>(end));
         const auto payload = BuildGameEventBatch(batch,
-                                                 store_.NextServerMessageSeq(connection_id),
-                                                 store_.LastClientMessageSeq(connection_id));
-        store_.SendReliable(connection_id, payload);
+                                                 transport_.NextServerMessageSeq(connection_id),
+                                                 transport_.LastClientMessageSeq(connection_id));
+        transport_.SendReliable(connection_id, payload);
         index = end;
       }
     }
-    pickup_sync_sent_.insert(connection_id);
+    pickup_sync_sent_[slot] = 1;
   }
 
-	  auto resolve_view = [&](const std::string &connection_id) {
-	    auto input_iter = last_inputs_.find(connection_id);
-	    if (input_iter == last_inputs_.end()) {
-	      return afps::combat::SanitizeViewAngles(0.0, 0.0);
-	    }
-	    return afps::combat::SanitizeViewAngles(input_iter->second.view_yaw, input_iter->second.view_pitch);
+	  auto resolve_view = [&](afps::entity::EntitySlot slot) {
+	    const auto &input = last_inputs_[slot];
+	    return afps::combat::SanitizeViewAngles(input.view_yaw, input.view_pitch);
 	  };
-	  auto resolve_fire_view = [&](const std::string &connection_id, const FireWeaponRequest &request) {
-	    const auto fallback_view = resolve_view(connection_id);
-	    const afps::combat::Vec3 fallback_dir = afps::combat::ViewDirection(fallback_view);
+	  auto resolve_fire_view = [&](afps::entity::EntitySlot slot, const FireWeaponRequest &request) {
+	    const auto fallback_view = resolve_view(slot);
 	    const afps::combat::Vec3 request_dir{request.dir_x, request.dir_y, request.dir_z};
 	    const double request_len_sq =
 	        request_dir.x * request_dir.x + request_dir.y * request_dir.y + request_dir.z * request_dir.z;
@@ -1715,22 +1758,19 @@ void TickLoop::Step() {
 	    return ViewFromDirection(safe_request_dir);
 	  };
 
-  auto resolve_shield_facing = [&](const std::string &target_id,
+  auto resolve_shield_facing = [&](afps::entity::EntitySlot target,
                                    const afps::combat::Vec3 &source_pos) {
-    auto state_iter = players_.find(target_id);
-    if (state_iter == players_.end()) {
+    if (target >= players_.size()) {
       return false;
     }
-    const auto view = resolve_view(target_id);
-    const afps::combat::Vec3 target_pos{state_iter->second.x,
-                                        state_iter->second.y,
-                                        state_iter->second.z + (afps::combat::kPlayerHeight * 0.5)};
+    const auto &state = players_[target];
+    const auto view = resolve_view(target);
+    const afps::combat::Vec3 target_pos{state.x, state.y, state.z + (afps::combat::kPlayerHeight * 0.5)};
     return afps::combat::IsShieldFacing(target_pos, view, source_pos);
   };
 
-  auto resolve_loadout_bits = [&](const std::string &connection_id) -> uint32_t {
-    auto iter = loadout_bits_.find(connection_id);
-    return iter == loadout_bits_.end() ? 0u : iter->second;
+  auto resolve_loadout_bits = [&](afps::entity::EntitySlot slot) -> uint32_t {
+    return loadout_bits_[slot];
   };
 
   auto resolve_max_ammo = [&](const afps::weapons::WeaponDef *weapon, uint32_t loadout_bits) -> int {
@@ -1793,10 +1833,10 @@ void TickLoop::Step() {
   };
 
   const size_t slot_count = weapon_config_.slots.empty() ? 1 : weapon_config_.slots.size();
-  auto init_weapon_state = [&](PlayerWeaponState &state, const std::string &connection_id) {
+  auto init_weapon_state = [&](PlayerWeaponState &state, afps::entity::EntitySlot entity) {
     state.slots.clear();
     state.slots.resize(slot_count);
-    const uint32_t loadout_bits = resolve_loadout_bits(connection_id);
+    const uint32_t loadout_bits = resolve_loadout_bits(entity);
     for (size_t i = 0; i < slot_count; ++i) {
       const auto *weapon = afps::weapons::ResolveWeaponSlot(weapon_config_, static_cast<int>(i));
       if (weapon) {
@@ -1812,66 +1852,90 @@ void TickLoop::Step() {
     state.shot_seq = 0;
   };
 
-  for (const auto &connection_id : active_ids) {
-    if (combat_states_.find(connection_id) == combat_states_.end()) {
-      combat_states_[connection_id] = afps::combat::CreateCombatState();
-      players_[connection_id] = MakeSpawnState(connection_id, sim_config_, collision_world_);
-      LogSpawnState(connection_id, players_[connection_id], "join");
-    } else if (players_.find(connection_id) == players_.end()) {
-      players_[connection_id] = MakeSpawnState(connection_id, sim_config_, collision_world_);
-      LogSpawnState(connection_id, players_[connection_id], "restore");
-    }
-    auto weapon_iter = weapon_states_.find(connection_id);
-    if (weapon_iter == weapon_states_.end()) {
-      PlayerWeaponState state;
-      init_weapon_state(state, connection_id);
-      weapon_states_[connection_id] = std::move(state);
-    } else if (weapon_iter->second.slots.size() != slot_count) {
-      init_weapon_state(weapon_iter->second, connection_id);
+  for (const auto slot : joined_slots) {
+    const std::string &connection_id = entities_.IdOf(slot);
+    entity_hashes_[slot] = HashString(connection_id);
+    combat_states_[slot] = afps::combat::CreateCombatState();
+    players_[slot] = MakeSpawnState(connection_id, sim_config_, collision_world_);
+    LogSpawnState(connection_id, players_[slot], "join");
+  }
+  for (const auto slot : active_slots) {
+    if (weapon_states_[slot].slots.size() != slot_count) {
+      init_weapon_state(weapon_states_[slot], slot);
     }
   }
 
-  auto batches = store_.DrainAllInputs();
-  for (const auto &batch : batches) {
+  const auto command_batches = transport_.DrainAllCommands(room_id_);
+  for (const auto &batch : command_batches) {
+    const afps::entity::EntitySlot slot = entities_.Find(batch.connection_id);
+    // Acks arrive on every tick, not just snapshot ticks, so apply them before anything can skip the batch.
+    if (slot != afps::entity::kInvalidSlot) {
+      for (const ServerSeqAck &ack : batch.seq_acks) {
+        snapshot_histories_[slot].Acknowledge(ack.server_seq_ack, ack.ack_bits);
+      }
+    }
+    if (!batch.decal_reports.empty()) {
+      const bool known = slot != afps::entity::kInvalidSlot;
+      const InputCmd *last_input = (known && has_last_input_[slot]) ? &last_inputs_[slot] : nullptr;
+      for (const auto &report : batch.decal_reports) {
+        LogClientDecalDebug(server_tick_, batch.connection_id, report, last_input, known ? &players_[slot] : nullptr);
+      }
+    }
+    if (batch.inputs.empty()) {
+      continue;
+    }
     ++batch_count_;
     input_count_ += batch.inputs.size();
-    int max_seq = -1;
-    for (const auto &cmd : batch.inputs) {
-      max_seq = std::max(max_seq, cmd.input_seq);
-      const auto player_iter = players_.find(batch.connection_id);
-      const afps::sim::PlayerState *player_state = (player_iter == players_.end()) ? nullptr : &player_iter->second;
-      LogClientDecalDebug(server_tick_, batch.connection_id, cmd, player_state);
+    if (slot == afps::entity::kInvalidSlot) {
+      continue;
     }
-    if (max_seq >= 0) {
-      last_input_seq_[batch.connection_id] = max_seq;
-      last_input_server_tick_[batch.connection_id] = server_tick_;
-      last_inputs_[batch.connection_id] = batch.inputs.back();
+    for (const auto &cmd : batch.inputs) {
+      input_buffers_[slot].Push(cmd);
     }
+    last_input_server_tick_[slot] = server_tick_;
   }
 
-  auto fire_batches = store_.DrainAllFireRequests();
-  for (const auto &batch : fire_batches) {
-    for (const auto &request : batch.requests) {
-      fire_events.push_back({batch.connection_id, request});
+  // Each player plays one buffered input per tick, a few more while working off a backlog, or none
+  // on an underrun, in which case the previous input is repeated.
+  for (const auto slot : active_slots) {
+    auto &commands = tick_inputs_[slot];
+    commands.clear();
+    auto &buffer = input_buffers_[slot];
+    const size_t played = buffer.Take(commands);
+    if (played == 0) {
+      if (buffer.started()) {
+        ++input_underrun_count_;
+      }
+      continue;
     }
+    input_catch_up_count_ += played - 1;
+    last_input_seq_[slot] = buffer.last_played_seq();
+    last_inputs_[slot] = commands.back();
+    has_last_input_[slot] = 1;
   }
 
-  auto loadout_batches = store_.DrainAllLoadoutRequests();
-  for (const auto &batch : loadout_batches) {
-    if (batch.requests.empty()) {
+  for (const auto &batch : command_batches) {
+    const afps::entity::EntitySlot slot = entities_.Find(batch.connection_id);
+    if (slot == afps::entity::kInvalidSlot) {
       continue;
     }
-    const uint32_t previous_bits = resolve_loadout_bits(batch.connection_id);
-    const uint32_t next_bits = batch.requests.back().loadout_bits;
-    loadout_bits_[batch.connection_id] = next_bits;
-    if (previous_bits == next_bits) {
+    for (const auto &request : batch.fire_requests) {
+      fire_events.push_back({slot, request});
+    }
+  }
+
+  for (const auto &batch : command_batches) {
+    const afps::entity::EntitySlot slot = entities_.Find(batch.connection_id);
+    if (batch.loadout_requests.empty() || slot == afps::entity::kInvalidSlot) {
       continue;
     }
-    auto weapon_iter = weapon_states_.find(batch.connection_id);
-    if (weapon_iter == weapon_states_.end()) {
+    const uint32_t previous_bits = resolve_loadout_bits(slot);
+    const uint32_t next_bits = batch.loadout_requests.back().loadout_bits;
+    loadout_bits_[slot] = next_bits;
+    if (previous_bits == next_bits) {
       continue;
     }
-    auto &weapon_state = weapon_iter->second;
+    auto &weapon_state = weapon_states_[slot];
     for (size_t i = 0; i < weapon_state.slots.size(); ++i) {
       auto &slot_state = weapon_state.slots[i];
       const auto *weapon = afps::weapons::ResolveWeaponSlot(weapon_config_, static_cast<int>(i));
@@ -1894,46 +1958,60 @@ void TickLoop::Step() {
   }
 
   const double dt = std::chrono::duration<double>(accumulator_.tick_duration()).count();
-  for (const auto &connection_id : active_ids) {
-    const auto input_iter = last_inputs_.find(connection_id);
-    InputCmd input;
-    if (input_iter != last_inputs_.end()) {
-      input = input_iter->second;
-    }
-    auto &state = players_[connection_id];
-    auto &combat_state = combat_states_[connection_id];
-    if (combat_state.alive) {
-      const auto sim_input = afps::sim::MakeInput(input.move_x, input.move_y, input.sprint, input.jump, input.dash,
-                                                  input.grapple, input.shield, input.shockwave, input.view_yaw,
-                                                  input.view_pitch, input.crouch);
-      afps::sim::StepPlayer(state, sim_input, sim_config_, dt, &collision_world_);
-      if (state.shockwave_triggered) {
-        shockwave_events.push_back({connection_id,
-                                    {state.x, state.y, state.z + (afps::combat::kPlayerHeight * 0.5)}});
+  // StepPlayer only reads the collision world and writes its own player, so chunks of players step
+  // in parallel. Everything with effects beyond one player runs afterwards in slot order.
+  movement_pool_.ParallelFor(active_slots.size(), kMovementChunkPlayers, [&](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) {
+      const auto slot = active_slots[index];
+      auto &state = players_[slot];
+      if (combat_states_[slot].alive) {
+        auto step_input = [&](const InputCmd &input) {
+          const auto sim_input = afps::sim::MakeInput(input.move_x, input.move_y, input.sprint, input.jump,
+                                                      input.dash, input.grapple, input.shield, input.shockwave,
+                                                      input.view_yaw, input.view_pitch, input.crouch);
+          afps::sim::StepPlayer(state, sim_input, sim_config_, dt, &collision_world_);
+        };
+        const auto &commands = tick_inputs_[slot];
+        if (commands.empty()) {
+          step_input(last_inputs_[slot]);
+        }
+        for (const auto &input : commands) {
+          step_input(input);
+        }
+      } else {
+        state.vel_x = 0.0;
+        state.vel_y = 0.0;
+        state.vel_z = 0.0;
+        state.dash_cooldown = 0.0;
+        state.grapple_cooldown = 0.0;
+        state.grapple_active = false;
+        state.grapple_input = false;
+        state.grapple_length = 0.0;
+        state.grapple_anchor_x = 0.0;
+        state.grapple_anchor_y = 0.0;
+        state.grapple_anchor_z = 0.0;
+        state.grapple_anchor_nx = 0.0;
+        state.grapple_anchor_ny = 0.0;
+        state.grapple_anchor_nz = 0.0;
+        state.shield_timer = 0.0;
+        state.shield_cooldown = 0.0;
+        state.shield_active = false;
+        state.shield_input = false;
+        state.shockwave_cooldown = 0.0;
+        state.shockwave_input = false;
+        state.shockwave_triggered = false;
+        state.crouched = false;
       }
-    } else {
-      state.vel_x = 0.0;
-      state.vel_y = 0.0;
-      state.vel_z = 0.0;
-      state.dash_cooldown = 0.0;
-      state.grapple_cooldown = 0.0;
-      state.grapple_active = false;
-      state.grapple_input = false;
-      state.grapple_length = 0.0;
-      state.grapple_anchor_x = 0.0;
-      state.grapple_anchor_y = 0.0;
-      state.grapple_anchor_z = 0.0;
-      state.grapple_anchor_nx = 0.0;
-      state.grapple_anchor_ny = 0.0;
-      state.grapple_anchor_nz = 0.0;
-      state.shield_timer = 0.0;
-      state.shield_cooldown = 0.0;
-      state.shield_active = false;
-      state.shield_input = false;
-      state.shockwave_cooldown = 0.0;
-      state.shockwave_input = false;
-      state.shockwave_triggered = false;
-      state.crouched = false;
+    }
+  });
+
+  for (const auto slot : active_slots) {
+    const std::string &connection_id = entities_.IdOf(slot);
+    const InputCmd &input = last_inputs_[slot];
+    auto &state = players_[slot];
+    auto &combat_state = combat_states_[slot];
+    if (combat_state.alive && state.shockwave_triggered) {
+      shockwave_events.push_back({slot, {state.x, state.y, state.z + (afps::combat::kPlayerHeight * 0.5)}});
     }
 
     const int safe_tick_rate = std::max(1, accumulator_.tick_rate());
@@ -1941,19 +2019,25 @@ void TickLoop::Step() {
       std::cout << "{\"event\":\"player_tick\",\"connection_id\":\"" << connection_id
                 << "\",\"x\":" << state.x << ",\"y\":" << state.y << ",\"z\":" << state.z
                 << ",\"move_x\":" << input.move_x << ",\"move_y\":" << input.move_y
+                << ",\"input_depth\":" << input_buffers_[slot].depth()
+                << ",\"input_delay\":" << input_buffers_[slot].target_delay()
+                << ",\"input_underruns\":" << input_buffers_[slot].stats().underruns
                 << ",\"alive\":" << (combat_state.alive ? "true" : "false") << "}\n";
     }
 
     if (afps::combat::UpdateRespawn(combat_state, dt)) {
       state = MakeSpawnState(connection_id, sim_config_, collision_world_);
       LogSpawnState(connection_id, state, "respawn");
-      auto weapon_iter = weapon_states_.find(connection_id);
-      if (weapon_iter != weapon_states_.end()) {
-        init_weapon_state(weapon_iter->second, connection_id);
-      }
+      init_weapon_state(weapon_states_[slot], slot);
     }
   }
 
+  interest_grid_.Clear();
+  for (const auto slot : active_slots) {
+    const auto &state = players_[slot];
+    interest_grid_.Insert(slot, {state.x, state.y, state.z});
+  }
+
   const double player_height =
       (std::isfinite(sim_config_.player_height) && sim_config_.player_height > 0.0) ? sim_config_.player_height : 1.7;
   for (auto &pickup : pickups_) {
@@ -1966,62 +2050,57 @@ void TickLoop::Step() {
       continue;
     }
 
-    std::string taker_id;
-    for (const auto &connection_id : active_ids) {
-      auto combat_iter = combat_states_.find(connection_id);
-      auto state_iter = players_.find(connection_id);
-      if (combat_iter == combat_states_.end() || state_iter == players_.end()) {
-        continue;
-      }
-      if (!combat_iter->second.alive) {
+    afps::entity::EntitySlot taker = afps::entity::kInvalidSlot;
+    for (const auto candidate : active_slots) {
+      const auto &combat_state = combat_states_[candidate];
+      const auto &state = players_[candidate];
+      if (!combat_state.alive) {
         continue;
       }
-      const double dx = state_iter->second.x - pickup.definition.position.x;
-      const double dy = state_iter->second.y - pickup.definition.position.y;
+      const double dx = state.x - pickup.definition.position.x;
+      const double dy = state.y - pickup.definition.position.y;
       const double radius = std::max(0.0, pickup.definition.radius);
       if ((dx * dx + dy * dy) > (radius * radius)) {
         continue;
       }
-      const double player_min_z = state_iter->second.z;
-      const double player_max_z = state_iter->second.z + player_height;
+      const double player_min_z = state.z;
+      const double player_max_z = state.z + player_height;
       if (pickup.definition.position.z < player_min_z - 0.5 || pickup.definition.position.z > player_max_z + 0.5) {
         continue;
       }
       if (pickup.definition.kind == afps::world::PickupKind::Health &&
-          combat_iter->second.health >= afps::combat::kMaxHealth - 1e-6) {
+          combat_state.health >= afps::combat::kMaxHealth - 1e-6) {
         continue;
       }
-      taker_id = connection_id;
+      taker = candidate;
       break;
     }
 
-    if (taker_id.empty()) {
+    if (taker == afps::entity::kInvalidSlot) {
       continue;
     }
 
     if (pickup.definition.kind == afps::world::PickupKind::Health) {
-      auto combat_iter = combat_states_.find(taker_id);
-      if (combat_iter != combat_states_.end()) {
-        const double amount = pickup.definition.amount > 0 ? static_cast<double>(pickup.definition.amount) : 25.0;
-        combat_iter->second.health = std::min(afps::combat::kMaxHealth, combat_iter->second.health + amount);
-      }
+      auto &combat_state = combat_states_[taker];
+      const double amount = pickup.definition.amount > 0 ? static_cast<double>(pickup.definition.amount) : 25.0;
+      combat_state.health = std::min(afps::combat::kMaxHealth, combat_state.health + amount);
     } else if (pickup.definition.kind == afps::world::PickupKind::Weapon) {
-      auto weapon_iter = weapon_states_.find(taker_id);
-      if (weapon_iter != weapon_states_.end() && !weapon_iter->second.slots.empty()) {
-        const int max_slot = static_cast<int>(weapon_iter->second.slots.size() - 1);
+      auto &weapon_state = weapon_states_[taker];
+      if (!weapon_state.slots.empty()) {
+        const int max_slot = static_cast<int>(weapon_state.slots.size() - 1);
         const int slot = std::max(0, std::min(max_slot, pickup.definition.weapon_slot));
         const auto *weapon = afps::weapons::ResolveWeaponSlot(weapon_config_, slot);
-        const int max_ammo = resolve_max_ammo(weapon, resolve_loadout_bits(taker_id));
+        const int max_ammo = resolve_max_ammo(weapon, resolve_loadout_bits(taker));
         if (max_ammo > 0) {
-          auto &slot_state = weapon_iter->second.slots[static_cast<size_t>(slot)];
+          auto &slot_state = weapon_state.slots[static_cast<size_t>(slot)];
           if (pickup.definition.amount > 0) {
             slot_state.ammo_in_mag = std::min(max_ammo, slot_state.ammo_in_mag + pickup.definition.amount);
           } else {
             slot_state.ammo_in_mag = max_ammo;
           }
         }
-        auto &last_input = last_inputs_[taker_id];
-        last_input.weapon_slot = slot;
+        last_inputs_[taker].weapon_slot = slot;
+        has_last_input_[taker] = 1;
       }
     }
 
@@ -2029,14 +2108,14 @@ void TickLoop::Step() {
     pickup.respawn_tick = server_tick_ + std::max(1, pickup.definition.respawn_ticks);
     PickupTakenFx taken;
     taken.pickup_id = pickup.definition.id;
-    taken.taker_id = taker_id;
+    taken.taker_id = entities_.IdOf(taker);
     taken.server_tick = server_tick_;
     emit_fx_all(taken);
   }
 
-  for (auto &entry : weapon_states_) {
-    const uint32_t loadout_bits = resolve_loadout_bits(entry.first);
-    auto &state = entry.second;
+  for (const auto slot : active_slots) {
+    const uint32_t loadout_bits = resolve_loadout_bits(slot);
+    auto &state = weapon_states_[slot];
     for (size_t i = 0; i < state.slots.size(); ++i) {
       auto &slot_state = state.slots[i];
       if (slot_state.cooldown > 0.0) {
@@ -2067,79 +2146,96 @@ void TickLoop::Step() {
     }
   }
 
-  for (const auto &connection_id : active_ids) {
-    auto &history = pose_histories_[connection_id];
-    if (history.size() == 0) {
-      history.SetMaxSamples(static_cast<size_t>(pose_history_limit_));
+  movement_pool_.ParallelFor(active_slots.size(), kMovementChunkPlayers, [&](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; ++index) {
+      const auto slot = active_slots[index];
+      auto &history = pose_histories_[slot];
+      if (history.size() == 0) {
+        history.SetMaxSamples(static_cast<size_t>(pose_history_limit_));
+      }
+      history.Push(server_tick_, players_[slot], resolve_view(slot));
     }
-    history.Push(server_tick_, players_[connection_id]);
-  }
+  });
 
-  if (!shockwave_events.empty()) {
-    std::unordered_map<std::string, afps::sim::PlayerState> alive_players;
-    alive_players.reserve(players_.size());
-    for (const auto &entry : players_) {
-      auto combat_iter = combat_states_.find(entry.first);
-      if (combat_iter != combat_states_.end() && combat_iter->second.alive) {
-        alive_players.emplace(entry.first, entry.second);
+  // Shockwave and projectile queries take their targets from the interest grid, which holds the
+  // post-movement positions. Candidates keep active_slots order so hit order and ties match a scan
+  // of every alive player.
+  auto &active_rank = active_rank_;
+  active_rank.resize(entity_capacity, 0);
+  for (size_t rank = 0; rank < active_slots.size(); ++rank) {
+    active_rank[active_slots[rank]] = rank;
+  }
+  auto &broadphase_matches = broadphase_matches_;
+  auto &nearby_targets = nearby_targets_;
+  auto gather_alive_targets = [&](const afps::combat::Vec3 &center,
+                                  double reach) -> const std::vector<afps::entity::EntitySlot> & {
+    broadphase_matches.clear();
+    interest_grid_.Query({center.x, center.y, center.z}, reach + kBroadphasePaddingMeters, broadphase_matches);
+    nearby_targets.clear();
+    for (const size_t index : broadphase_matches) {
+      if (combat_states_[index].alive) {
+        nearby_targets.push_back(static_cast<afps::entity::EntitySlot>(index));
       }
     }
+    std::sort(nearby_targets.begin(), nearby_targets.end(),
+              [&](afps::entity::EntitySlot a, afps::entity::EntitySlot b) {
+                return active_rank[a] < active_rank[b];
+              });
+    return nearby_targets;
+  };
+
+  if (!shockwave_events.empty()) {
     for (const auto &event : shockwave_events) {
+        const auto &targets =
+            gather_alive_targets(event.origin, sim_config_.shockwave_radius + afps::combat::kPlayerHeight * 0.5);
         const auto hits = afps::combat::ComputeShockwaveHits(
             event.origin, sim_config_.shockwave_radius, sim_config_.shockwave_impulse,
-            sim_config_.shockwave_damage, sim_config_, alive_players, event.connection_id, &collision_world_);
-      auto attacker_iter = combat_states_.find(event.connection_id);
-      afps::combat::CombatState *attacker =
-          attacker_iter == combat_states_.end() ? nullptr : &attacker_iter->second;
+            sim_config_.shockwave_damage, sim_config_, players_, targets, event.slot, &collision_world_);
+      afps::combat::CombatState *attacker = &combat_states_[event.slot];
       for (const auto &hit : hits) {
-        auto target_state_iter = players_.find(hit.target_id);
-        auto target_combat_iter = combat_states_.find(hit.target_id);
-        if (target_state_iter == players_.end() || target_combat_iter == combat_states_.end()) {
-          continue;
-        }
-        if (!target_combat_iter->second.alive) {
+        auto &target_state = players_[hit.target_slot];
+        auto &target_combat = combat_states_[hit.target_slot];
+        if (!target_combat.alive) {
           continue;
         }
         if (std::isfinite(hit.impulse.x)) {
-          target_state_iter->second.vel_x += hit.impulse.x;
+          target_state.vel_x += hit.impulse.x;
         }
         if (std::isfinite(hit.impulse.y)) {
-          target_state_iter->second.vel_y += hit.impulse.y;
+          target_state.vel_y += hit.impulse.y;
         }
         if (std::isfinite(hit.impulse.z)) {
-          target_state_iter->second.vel_z += hit.impulse.z;
+          target_state.vel_z += hit.impulse.z;
         }
         bool killed = false;
         if (hit.damage > 0.0) {
-          const bool shield_active = target_state_iter->second.shield_active;
+          const bool shield_active = target_state.shield_active;
           const bool shield_facing =
-              shield_active ? resolve_shield_facing(hit.target_id, event.origin) : true;
-          killed = afps::combat::ApplyDamageWithShield(target_combat_iter->second, attacker, hit.damage,
+              shield_active ? resolve_shield_facing(hit.target_slot, event.origin) : true;
+          killed = afps::combat::ApplyDamageWithShield(target_combat, attacker, hit.damage,
                                                        shield_active && shield_facing,
                                                        sim_config_.shield_damage_multiplier);
           HitConfirmedFx hit_event;
-          hit_event.target_id = hit.target_id;
+          hit_event.target_id = entities_.IdOf(hit.target_slot);
           hit_event.damage = hit.damage;
           hit_event.killed = killed;
-          emit_fx_to(event.connection_id, hit_event);
+          emit_fx_to(event.slot, hit_event);
         }
         if (killed) {
-          emit_kill_feed_all(event.connection_id, hit.target_id);
-          target_state_iter->second.vel_x = 0.0;
-          target_state_iter->second.vel_y = 0.0;
-          target_state_iter->second.vel_z = 0.0;
-          target_state_iter->second.dash_cooldown = 0.0;
-          alive_players.erase(hit.target_id);
+          emit_kill_feed_all(event.slot, hit.target_slot);
+          target_state.vel_x = 0.0;
+          target_state.vel_y = 0.0;
+          target_state.vel_z = 0.0;
+          target_state.dash_cooldown = 0.0;
         }
       }
     }
   }
 
-  auto resolve_active_slot = [&](const std::string &connection_id, int requested_slot) -> int {
+  auto resolve_active_slot = [&](afps::entity::EntitySlot entity, int requested_slot) -> int {
 	    int slot = requested_slot;
-	    auto input_iter = last_inputs_.find(connection_id);
-	    if (input_iter != last_inputs_.end()) {
-	      slot = input_iter->second.weapon_slot;
+	    if (has_last_input_[entity]) {
+	      slot = last_inputs_[entity].weapon_slot;
     }
     if (slot < 0) {
       slot = 0;
@@ -2177,29 +2273,27 @@ void TickLoop::Step() {
 	    return static_cast<uint16_t>(std::llround(clamped * 65535.0));
 	  };
 
+	  auto &pending_hitscan_shots = pending_hitscan_shots_;
+	  pending_hitscan_shots.clear();
 	  for (const auto &event : fire_events) {
-	    auto shooter_iter = combat_states_.find(event.connection_id);
-	    if (shooter_iter == combat_states_.end() || !shooter_iter->second.alive) {
+	    auto &shooter_combat = combat_states_[event.slot];
+	    if (!shooter_combat.alive) {
 	      continue;
     }
-    auto state_iter = players_.find(event.connection_id);
-    if (state_iter == players_.end()) {
-      continue;
-    }
-    auto weapon_state_iter = weapon_states_.find(event.connection_id);
-    if (weapon_state_iter == weapon_states_.end()) {
-      continue;
-    }
-    const int active_slot = resolve_active_slot(event.connection_id, event.request.weapon_slot);
+    const std::string &shooter_id = entities_.IdOf(event.slot);
+    const auto &shooter_state = players_[event.slot];
+    auto &weapon_state = weapon_states_[event.slot];
+    const int active_slot = resolve_active_slot(event.slot, event.request.weapon_slot);
     if (active_slot < 0 || weapon_config_.slots.empty() ||
-        static_cast<size_t>(active_slot) >= weapon_state_iter->second.slots.size()) {
+        static_cast<size_t>(active_slot) >= weapon_state.slots.size()) {
       continue;
     }
     const auto *weapon = afps::weapons::ResolveWeaponSlot(weapon_config_, active_slot);
 	    if (!weapon) {
 	      continue;
 	    }
-	    auto &slot_state = weapon_state_iter->second.slots[active_slot];
+	    const afps::sim::Vec3 shooter_position{shooter_state.x, shooter_state.y, shooter_state.z};
+	    auto &slot_state = weapon_state.slots[active_slot];
 	    if (slot_state.reload_timer > 0.0) {
 	      continue;
 	    }
@@ -2210,19 +2304,15 @@ void TickLoop::Step() {
 	      continue;
 	    }
 
-	    weapon_state_iter->second.shot_seq += 1;
-	    const int shot_seq = weapon_state_iter->second.shot_seq;
-	    const uint32_t loadout_bits = resolve_loadout_bits(event.connection_id);
-	    InputCmd input;
-	    auto input_iter = last_inputs_.find(event.connection_id);
-	    if (input_iter != last_inputs_.end()) {
-	      input = input_iter->second;
-	    }
-	    const auto view = resolve_fire_view(event.connection_id, event.request);
+	    weapon_state.shot_seq += 1;
+	    const int shot_seq = weapon_state.shot_seq;
+	    const uint32_t loadout_bits = resolve_loadout_bits(event.slot);
+	    const InputCmd &input = last_inputs_[event.slot];
+	    const auto view = resolve_fire_view(event.slot, event.request);
 	    const auto dir = afps::combat::ViewDirection(view);
-	    const double spread_deg = resolve_spread_deg(weapon, slot_state, input, state_iter->second, loadout_bits);
+	    const double spread_deg = resolve_spread_deg(weapon, slot_state, input, shooter_state, loadout_bits);
 	    const uint32_t spread_seed =
-	        HashString(event.connection_id) ^
+	        entity_hashes_[event.slot] ^
 	        (static_cast<uint32_t>(shot_seq) * 0x9e3779b9u) ^
 	        (static_cast<uint32_t>(active_slot + 1) * 0x85ebca6bu);
 	    const auto shot_dir = ApplySpread(dir, spread_deg, spread_seed);
@@ -2233,19 +2323,19 @@ void TickLoop::Step() {
 	    if (slot_state.ammo_in_mag <= 0) {
 	      slot_state.cooldown = weapon_cooldown;
 	      ShotFiredFx fired;
-	      fired.shooter_id = event.connection_id;
+	      fired.shooter_id = shooter_id;
 	      fired.weapon_slot = static_cast<uint8_t>(active_slot);
 	      fired.shot_seq = shot_seq;
 	      fired.dry_fire = true;
-	      emit_fx_all(fired);
+	      emit_fx_near(event.slot, shooter_position, afps::interest::kFxAudibleRadiusMeters, fired);
 
 	      const double reload_seconds = resolve_reload_seconds(weapon, loadout_bits);
 	      if (reload_seconds > 0.0) {
 	        slot_state.reload_timer = reload_seconds;
 	        ReloadFx reload;
-	        reload.shooter_id = event.connection_id;
+	        reload.shooter_id = shooter_id;
 	        reload.weapon_slot = static_cast<uint8_t>(active_slot);
-	        emit_fx_all(reload);
+	        emit_fx_near(event.slot, shooter_position, afps::interest::kFxAudibleRadiusMeters, reload);
 	      }
 	      continue;
 	    }
@@ -2254,11 +2344,11 @@ void TickLoop::Step() {
 	    slot_state.cooldown = weapon_cooldown;
 
 	    ShotFiredFx fired;
-	    fired.shooter_id = event.connection_id;
+	    fired.shooter_id = shooter_id;
 	    fired.weapon_slot = static_cast<uint8_t>(active_slot);
 	    fired.shot_seq = shot_seq;
 	    fired.dry_fire = false;
-	    emit_fx_all(fired);
+	    emit_fx_near(event.slot, shooter_position, afps::interest::kFxAudibleRadiusMeters, fired);
 
 	    const bool energy_weapon = IsEnergyWeapon(weapon);
 	    if (energy_weapon) {
@@ -2267,21 +2357,20 @@ void TickLoop::Step() {
 	      if (prev_heat < 1.0 && slot_state.heat >= 1.0) {
 	        slot_state.overheat_timer = kEnergyVentSeconds;
 	        OverheatFx overheat;
-	        overheat.shooter_id = event.connection_id;
+	        overheat.shooter_id = shooter_id;
 	        overheat.weapon_slot = static_cast<uint8_t>(active_slot);
 	        overheat.heat_q = quantize_unit_u16(slot_state.heat);
-	        emit_fx_all(overheat);
+	        emit_fx_near(event.slot, shooter_position, afps::interest::kFxAudibleRadiusMeters, overheat);
 	        VentFx vent;
-	        vent.shooter_id = event.connection_id;
+	        vent.shooter_id = shooter_id;
 	        vent.weapon_slot = static_cast<uint8_t>(active_slot);
-	        emit_fx_all(vent);
+	        emit_fx_near(event.slot, shooter_position, afps::interest::kFxAudibleRadiusMeters, vent);
 	      }
 	    }
 
 	    int estimated_tick = server_tick_;
-	    auto tick_iter = last_input_server_tick_.find(event.connection_id);
-	    if (tick_iter != last_input_server_tick_.end()) {
-	      estimated_tick = tick_iter->second;
+	    if (last_input_server_tick_[event.slot] >= 0) {
+	      estimated_tick = last_input_server_tick_[event.slot];
     }
     if (pose_history_limit_ > 0) {
       const int min_tick = server_tick_ - pose_history_limit_ + 1;
@@ -2289,12 +2378,9 @@ void TickLoop::Step() {
 	    }
 
 	    if (weapon->kind == afps::weapons::WeaponKind::kHitscan) {
-	      afps::sim::PlayerState shooter_pose;
-	      auto history_iter = pose_histories_.find(event.connection_id);
-	      if (history_iter != pose_histories_.end()) {
-	        history_iter->second.SampleAtOrBefore(estimated_tick, shooter_pose);
-	      } else {
-	        shooter_pose = state_iter->second;
+	      afps::combat::RewindPose shooter_pose;
+	      if (!pose_histories_[event.slot].SampleAtOrBefore(estimated_tick, shooter_pose)) {
+	        shooter_pose = afps::combat::MakeRewindPose(shooter_state, resolve_view(event.slot));
 	      }
 	      const afps::combat::Vec3 origin{shooter_pose.x,
 	                                      shooter_pose.y,
@@ -2303,268 +2389,29 @@ void TickLoop::Step() {
 	      const double max_range = (std::isfinite(weapon->range) && weapon->range > 0.0)
 	                                   ? weapon->range
 	                                   : 0.0;
-		      const auto result = afps::combat::ResolveHitscan(
-		          event.connection_id, pose_histories_, estimated_tick, shot_view, sim_config_, weapon->range,
-		          nullptr);
-		      const WorldHitBackendMode world_hit_backend_mode = ResolveWorldHitBackendMode();
-		      const bool collision_mesh_enabled = collision_mesh_registry_loaded_ && !static_mesh_instances_.empty();
-		      WorldHitscanHit world_hit = ResolveWorldHitscan(origin, shot_dir, sim_config_, &collision_world_,
-		                                                     static_mesh_instances_, collision_mesh_registry_,
-		                                                     collision_mesh_prefab_lookup_, collision_mesh_enabled,
-		                                                     weapon->range, world_hit_backend_mode,
-		                                                     &collider_instance_lookup_);
-		      const WorldHitscanHit eye_world_hit = world_hit;
-		      WorldHitscanHit muzzle_block_hit;
-		      bool muzzle_block_checked = false;
-		      bool retry_attempted = false;
-		      bool retry_suppressed = false;
-		      bool retry_hit = false;
-		      WorldHitscanHit retry_world_hit;
-		      std::string world_hit_source = world_hit.hit ? "eye" : "none";
-		      const double intended_distance =
-		          world_hit.hit ? world_hit.distance : max_range;
-	      if (std::isfinite(intended_distance) && intended_distance > 0.0) {
-	        muzzle_block_checked = true;
-	        afps::sim::RaycastWorldOptions muzzle_trace_options;
-	        muzzle_trace_options.max_t = intended_distance;
-		        const auto muzzle_block = ResolveWorldHitscan(
-		            muzzle, shot_dir, sim_config_, &collision_world_, static_mesh_instances_,
-		            collision_mesh_registry_, collision_mesh_prefab_lookup_, collision_mesh_enabled,
-		            intended_distance, world_hit_backend_mode, &collider_instance_lookup_,
-		            muzzle_trace_options);
-	        if (muzzle_block.hit) {
-	          muzzle_block_hit = muzzle_block;
-	        }
-	        if (muzzle_block.hit &&
-	            muzzle_block.distance + kShotRetraceEpsilonMeters < intended_distance) {
-	          bool suppressed_near_muzzle_block = false;
-	          const bool near_muzzle_block =
-	              muzzle_block.distance <= kShotNearMuzzleGraceMeters;
-	          uint32_t retry_ignore_instance_id = muzzle_block.instance_id;
-	          if (retry_ignore_instance_id == 0 && muzzle_block.collider_id > 0) {
-	            const auto collider_iter = collider_instance_lookup_.find(muzzle_block.collider_id);
-	            if (collider_iter != collider_instance_lookup_.end()) {
-	              retry_ignore_instance_id = collider_iter->second;
-	            }
-	          }
-	          const bool can_retry_ignore =
-	              (muzzle_block.collider_id > 0) || (retry_ignore_instance_id > 0);
-	          if (near_muzzle_block && can_retry_ignore) {
-	            retry_attempted = true;
-	            afps::sim::RaycastWorldOptions retry_options;
-	            retry_options.min_t = kShotNearMuzzleGraceMeters;
-	            retry_options.max_t = intended_distance;
-	            retry_options.ignore_collider_id = muzzle_block.collider_id;
-		            const auto retrace_hit = ResolveWorldHitscan(
-		                muzzle, shot_dir, sim_config_, &collision_world_, static_mesh_instances_,
-		                collision_mesh_registry_, collision_mesh_prefab_lookup_, collision_mesh_enabled,
-		                intended_distance, world_hit_backend_mode, &collider_instance_lookup_,
-		                retry_options, retry_ignore_instance_id);
-	            if (retrace_hit.hit) {
-	              retry_hit = true;
-	              retry_world_hit = retrace_hit;
-	            }
-	            if (!retrace_hit.hit ||
-	                retrace_hit.distance + kShotRetraceEpsilonMeters >= intended_distance) {
-	              suppressed_near_muzzle_block = true;
-	              retry_suppressed = true;
-	              world_hit_source = "eye_near_muzzle_suppressed";
-	            } else {
-		              world_hit = retrace_hit;
-		              world_hit.distance = std::min(max_range,
-		                                            std::max(0.0, retrace_hit.distance + kShotMuzzleOffsetMeters));
-		              world_hit.position = Add(origin, Mul(shot_dir, world_hit.distance));
-		              world_hit_source = "muzzle_retry";
-		            }
-		          }
-	          if (!suppressed_near_muzzle_block &&
-	              !(near_muzzle_block && can_retry_ignore)) {
-		            world_hit = muzzle_block;
-		            world_hit.distance = std::min(max_range,
-		                                          std::max(0.0, muzzle_block.distance + kShotMuzzleOffsetMeters));
-		            world_hit.position = Add(origin, Mul(shot_dir, world_hit.distance));
-		            world_hit_source = "muzzle_block";
-		          }
-		        }
-		      }
-
-	      HitKind hit_kind = HitKind::None;
-	      SurfaceType surface_type = SurfaceType::Stone;
-	      afps::combat::Vec3 hit_normal{-shot_dir.x, -shot_dir.y, -shot_dir.z};
-	      double hit_distance = max_range;
-	      std::string hit_target;
-	      if (world_hit.hit &&
-	          world_hit.backend == WorldHitscanHit::Backend::Aabb &&
-	          world_hit.collider_id == -1 &&
-	          std::abs(world_hit.normal.z) < 0.5) {
-	        world_hit.hit = false;
-	        world_hit.distance = max_range;
-	        world_hit.backend = WorldHitscanHit::Backend::None;
-	        world_hit.instance_id = 0;
-	        world_hit.face_id = -1;
-	        world_hit.prefab_id.clear();
-	        world_hit_source = "arena_side_ignored";
-	      }
-	      if (world_hit.hit &&
-	          world_hit.backend == WorldHitscanHit::Backend::MeshBvh &&
-	          world_hit_source.find("mesh") == std::string::npos) {
-	        world_hit_source += "_mesh";
-	      }
-
-	      if (result.hit && (!world_hit.hit || result.distance <= world_hit.distance)) {
-	        hit_kind = HitKind::Player;
-	        hit_distance = result.distance;
-	        hit_target = result.target_id;
-	        surface_type = SurfaceType::Energy;
-	      } else if (world_hit.hit) {
-	        hit_kind = HitKind::World;
-	        hit_distance = world_hit.distance;
-	        surface_type = world_hit.surface;
-	        hit_normal = world_hit.normal;
-	      }
-	      const afps::combat::Vec3 hit_position =
-	          (hit_kind == HitKind::World) ? world_hit.position : Add(origin, Mul(shot_dir, hit_distance));
-	      ShadowDetailedWorldHit shadow_world_hit;
-	      bool shadow_world_checked = false;
-	      if (event.request.debug_enabled || ShouldLogShotDebug()) {
-	        shadow_world_checked = collision_mesh_enabled;
-	        if (shadow_world_checked) {
-	          shadow_world_hit = ResolveShadowDetailedWorldHitscan(
-	              origin, shot_dir, hit_distance, static_mesh_instances_,
-	              collision_mesh_registry_, collision_mesh_prefab_lookup_);
-	        }
-	      }
-		      LogHitscanShotDebug(server_tick_, event.connection_id, weapon->id, active_slot, shot_seq, estimated_tick,
-		                          event.request, origin, muzzle, shot_dir, max_range, intended_distance, result, eye_world_hit,
-		                          muzzle_block_checked, muzzle_block_hit, retry_attempted, retry_suppressed, retry_hit,
-		                          retry_world_hit, world_hit_source.c_str(), world_hit_backend_mode,
-		                          world_hit, shadow_world_checked, shadow_world_hit,
-		                          hit_kind, hit_target, hit_distance,
-		                          hit_position, hit_normal, surface_type);
-
-	      if (hit_kind == HitKind::Player) {
-	        auto target_iter = combat_states_.find(hit_target);
-	        bool killed = false;
-	        bool shield_active = false;
-	        bool shield_facing = true;
-	        if (target_iter != combat_states_.end()) {
-	          auto target_state_iter = players_.find(hit_target);
-	          if (target_state_iter != players_.end()) {
-	            shield_active = target_state_iter->second.shield_active;
-	          }
-	          if (shield_active) {
-	            shield_facing = resolve_shield_facing(hit_target, muzzle);
-	          }
-		          killed = afps::combat::ApplyDamageWithShield(target_iter->second, &shooter_iter->second, weapon->damage,
-		                                                       shield_active && shield_facing,
-		                                                       sim_config_.shield_damage_multiplier);
-		          if (killed) {
-		            emit_kill_feed_all(event.connection_id, hit_target);
-		            auto &target_state = players_[hit_target];
-		            target_state.vel_x = 0.0;
-		            target_state.vel_y = 0.0;
-	            target_state.vel_z = 0.0;
-	            target_state.dash_cooldown = 0.0;
-	          }
-	        }
-	        if (shield_active && shield_facing) {
-	          surface_type = SurfaceType::Energy;
-	        }
-	        HitConfirmedFx confirmed;
-	        confirmed.target_id = hit_target;
-	        confirmed.damage = weapon->damage;
-	        confirmed.killed = killed;
-	        emit_fx_to(event.connection_id, confirmed);
-	      }
-
-	      if (max_range > 0.0) {
-	        const auto normal_oct = EncodeOct16(hit_normal.x, hit_normal.y, hit_normal.z);
-	        ShotTraceFx trace;
-	        trace.shooter_id = event.connection_id;
-	        trace.weapon_slot = static_cast<uint8_t>(active_slot);
-	        trace.shot_seq = shot_seq;
-	        trace.dir_oct_x = dir_oct.x;
-	        trace.dir_oct_y = dir_oct.y;
-	        trace.hit_dist_q = QuantizeU16(hit_distance, kHitDistanceStepMeters);
-	        trace.hit_kind = hit_kind;
-	        trace.surface_type = surface_type;
-	        trace.normal_oct_x = normal_oct.x;
-	        trace.normal_oct_y = normal_oct.y;
-	        trace.show_tracer = should_show_tracer(weapon, shot_seq, loadout_bits);
-	        trace.hit_pos_x_q = QuantizeI16(hit_position.x, kShotTracePositionStepMeters);
-	        trace.hit_pos_y_q = QuantizeI16(hit_position.y, kShotTracePositionStepMeters);
-	        trace.hit_pos_z_q = QuantizeI16(hit_position.z, kShotTracePositionStepMeters);
-
-	        const double cull_sq = kTraceCullDistanceMeters * kTraceCullDistanceMeters;
-	        for (const auto &recipient_id : active_ids) {
-	          auto recipient_state_iter = players_.find(recipient_id);
-	          if (recipient_state_iter == players_.end()) {
-	            continue;
-	          }
-	          const double dx = recipient_state_iter->second.x - shooter_pose.x;
-	          const double dy = recipient_state_iter->second.y - shooter_pose.y;
-	          const double dz = recipient_state_iter->second.z - shooter_pose.z;
-	          const double dist_sq = dx * dx + dy * dy + dz * dz;
-	          ShotTraceFx recipient_trace = trace;
-	          // Keep world-hit data replicated for decal/impact sync, but suppress
-	          // long-distance tracers to control visual noise/bandwidth.
-	          if (dist_sq > cull_sq) {
-	            recipient_trace.show_tracer = false;
-	          }
-	          emit_fx_to(recipient_id, recipient_trace);
-	          if (hit_kind == HitKind::World) {
-	            // Stream world-hit traces reliably so remote decals are authoritative.
-	            emit_reliable_decal_to(recipient_id, recipient_trace);
-	          }
-	        }
-	      }
-
-	      const afps::combat::Vec3 segment_start = origin;
-	      const afps::combat::Vec3 segment_end = Add(origin, Mul(shot_dir, hit_distance));
-	      const double capsule_radius = (std::isfinite(sim_config_.player_radius) && sim_config_.player_radius > 0.0)
-	                                        ? sim_config_.player_radius
-	                                        : 0.4;
-	      const double threshold = capsule_radius + kNearMissExtraRadius;
-	      const double threshold_sq = threshold * threshold;
-	      for (const auto &entry : pose_histories_) {
-	        const std::string &target_id = entry.first;
-	        if (target_id == event.connection_id) {
-	          continue;
-	        }
-	        if (!hit_target.empty() && target_id == hit_target) {
-	          continue;
-	        }
-	        afps::sim::PlayerState pose;
-	        if (!entry.second.SampleAtOrBefore(estimated_tick, pose)) {
-	          continue;
-	        }
-	        const afps::combat::Vec3 axis_start{pose.x, pose.y, pose.z};
-	        const afps::combat::Vec3 axis_end{pose.x, pose.y, pose.z + afps::combat::kPlayerHeight};
-	        const double dist_sq = SegmentSegmentDistanceSquared(segment_start, segment_end, axis_start, axis_end);
-	        if (dist_sq > threshold_sq) {
-	          continue;
-	        }
-	        const double dist = std::sqrt(std::max(0.0, dist_sq));
-	        const double closeness = Clamp01((threshold - dist) / threshold);
-	        const uint8_t strength = static_cast<uint8_t>(std::llround(closeness * 255.0));
-	        if (strength == 0) {
-	          continue;
-	        }
-	        NearMissFx near_miss;
-	        near_miss.shooter_id = event.connection_id;
-	        near_miss.shot_seq = shot_seq;
-	        near_miss.strength = strength;
-	        emit_fx_to(target_id, near_miss);
-	      }
+	      PendingHitscanShot pending;
+	      pending.event = &event;
+	      pending.weapon = weapon;
+	      pending.active_slot = active_slot;
+	      pending.shot_seq = shot_seq;
+	      pending.loadout_bits = loadout_bits;
+	      pending.estimated_tick = estimated_tick;
+	      pending.shooter_pose = shooter_pose;
+	      pending.origin = origin;
+	      pending.muzzle = muzzle;
+	      pending.shot_dir = shot_dir;
+	      pending.shot_view = shot_view;
+	      pending.dir_oct = dir_oct;
+	      pending.max_range = max_range;
+	      pending_hitscan_shots.push_back(pending);
 	    } else if (weapon->kind == afps::weapons::WeaponKind::kProjectile) {
-	      const afps::combat::Vec3 origin{state_iter->second.x,
-	                                      state_iter->second.y,
-	                                      state_iter->second.z + afps::combat::kPlayerEyeHeight};
+	      const afps::combat::Vec3 origin{shooter_state.x,
+	                                      shooter_state.y,
+	                                      shooter_state.z + afps::combat::kPlayerEyeHeight};
 	      const afps::combat::Vec3 muzzle = Add(origin, Mul(shot_dir, 0.2));
 	      if (weapon->projectile_speed > 0.0 && std::isfinite(weapon->projectile_speed)) {
 	        afps::combat::ProjectileState projectile;
-	        projectile.id = next_projectile_id_++;
-	        projectile.owner_id = event.connection_id;
+	        projectile.owner = entities_.HandleOf(event.slot);
 	        projectile.position = muzzle;
 	        projectile.velocity = {shot_dir.x * weapon->projectile_speed, shot_dir.y * weapon->projectile_speed,
 	                               shot_dir.z * weapon->projectile_speed};
@@ -2575,10 +2422,10 @@ void TickLoop::Step() {
 	            (weapon->explosion_radius > 0.0 && std::isfinite(weapon->explosion_radius))
 	                ? weapon->explosion_radius
 	                : 0.0;
-	        projectiles_.push_back(projectile);
+	        projectile.id = projectiles_.Spawn(projectile);
 
 	        ProjectileSpawnFx spawn;
-	        spawn.shooter_id = event.connection_id;
+	        spawn.shooter_id = shooter_id;
 	        spawn.weapon_slot = static_cast<uint8_t>(active_slot);
 	        spawn.shot_seq = shot_seq;
 	        spawn.projectile_id = projectile.id;
@@ -2600,78 +2447,413 @@ void TickLoop::Step() {
 	      }
 	      slot_state.reload_timer = reload_seconds;
 	      ReloadFx reload;
-	      reload.shooter_id = event.connection_id;
+	      reload.shooter_id = shooter_id;
 	      reload.weapon_slot = static_cast<uint8_t>(active_slot);
-	      emit_fx_all(reload);
+	      emit_fx_near(event.slot, shooter_position, afps::interest::kFxAudibleRadiusMeters, reload);
 	    }
 	  }
 
-	  if (!projectiles_.empty()) {
-    std::unordered_map<std::string, afps::sim::PlayerState> alive_players;
-    alive_players.reserve(players_.size());
-    for (const auto &entry : players_) {
-      auto combat_iter = combat_states_.find(entry.first);
-      if (combat_iter != combat_states_.end() && combat_iter->second.alive) {
-        alive_players.emplace(entry.first, entry.second);
-      }
-    }
+	  // All hitscan shots of the tick are traced as packets: player cylinders are tested against
+	  // targets sampled once per rewind tick and the static mesh TLAS is walked once for all eye
+	  // traces and once for all muzzle traces. Results are then applied in fire order. The rare
+	  // near-muzzle retrace ignores a per-shot instance, so it still runs on its own.
+	  if (!pending_hitscan_shots.empty()) {
+	    std::vector<afps::combat::HitscanQuery> hitscan_queries;
+	    std::vector<WorldHitscanRay> world_rays;
+	    hitscan_queries.reserve(pending_hitscan_shots.size());
+	    world_rays.reserve(pending_hitscan_shots.size());
+	    for (const auto &pending : pending_hitscan_shots) {
+	      afps::combat::HitscanQuery query;
+	      query.shooter = pending.event->slot;
+	      query.rewind_time = pending.estimated_tick;
+	      query.view = pending.shot_view;
+	      query.range = pending.weapon->range;
+	      hitscan_queries.push_back(query);
+	      world_rays.push_back({pending.origin, pending.shot_dir, pending.weapon->range});
+	    }
+	    std::vector<afps::combat::HitResult> player_hits;
+	    afps::combat::ResolveHitscanBatch(hitscan_queries, pose_histories_, sim_config_, player_hits);
+	    const WorldHitBackendMode world_hit_backend_mode = ResolveWorldHitBackendMode();
+	    const bool collision_mesh_enabled = collision_mesh_registry_loaded_ && !static_mesh_instances_.empty();
+	    std::vector<WorldHitscanHit> eye_world_hits;
+	    ResolveWorldHitscanPacket(world_rays, sim_config_, &collision_world_, static_mesh_instances_,
+	                              collision_mesh_registry_, static_mesh_tlas_, collision_mesh_enabled,
+	                              world_hit_backend_mode, eye_world_hits);
+
+	    // Muzzle traces check the span the eye trace covered, so they form a second packet.
+	    world_rays.clear();
+	    std::vector<size_t> muzzle_ray_index(pending_hitscan_shots.size(), 0);
+	    for (size_t shot_index = 0; shot_index < pending_hitscan_shots.size(); ++shot_index) {
+	      const auto &pending = pending_hitscan_shots[shot_index];
+	      const auto &eye_hit = eye_world_hits[shot_index];
+	      const double intended_distance = eye_hit.hit ? eye_hit.distance : pending.max_range;
+	      if (!std::isfinite(intended_distance) || intended_distance <= 0.0) {
+	        continue;
+	      }
+	      WorldHitscanRay ray{pending.muzzle, pending.shot_dir, intended_distance};
+	      ray.options.max_t = intended_distance;
+	      muzzle_ray_index[shot_index] = world_rays.size();
+	      world_rays.push_back(ray);
+	    }
+	    std::vector<WorldHitscanHit> muzzle_world_hits;
+	    ResolveWorldHitscanPacket(world_rays, sim_config_, &collision_world_, static_mesh_instances_,
+	                              collision_mesh_registry_, static_mesh_tlas_, collision_mesh_enabled,
+	                              world_hit_backend_mode, muzzle_world_hits);
+
+	    for (size_t shot_index = 0; shot_index < pending_hitscan_shots.size(); ++shot_index) {
+	      const auto &pending = pending_hitscan_shots[shot_index];
+	      const FireEvent &event = *pending.event;
+	      // As when shots resolved one at a time, a shooter killed by an earlier shot this tick does not
+	      // land theirs. The gather pass above has already spent the round and sent the fire FX.
+	      auto &shooter_combat = combat_states_[event.slot];
+	      if (!shooter_combat.alive) {
+	        continue;
+	      }
+	      const std::string &shooter_id = entities_.IdOf(event.slot);
+	      const auto *weapon = pending.weapon;
+	      const int active_slot = pending.active_slot;
+	      const int shot_seq = pending.shot_seq;
+	      const uint32_t loadout_bits = pending.loadout_bits;
+	      const int estimated_tick = pending.estimated_tick;
+	      const afps::combat::RewindPose &shooter_pose = pending.shooter_pose;
+	      const afps::combat::Vec3 &origin = pending.origin;
+	      const afps::combat::Vec3 &muzzle = pending.muzzle;
+	      const afps::combat::Vec3 &shot_dir = pending.shot_dir;
+	      const OctEncoded16 &dir_oct = pending.dir_oct;
+	      const double max_range = pending.max_range;
+	      const auto &result = player_hits[shot_index];
+	      WorldHitscanHit world_hit = eye_world_hits[shot_index];
+		    const WorldHitscanHit eye_world_hit = world_hit;
+		    WorldHitscanHit muzzle_block_hit;
+		    bool muzzle_block_checked = false;
+		    bool retry_attempted = false;
+		    bool retry_suppressed = false;
+		    bool retry_hit = false;
+		    WorldHitscanHit retry_world_hit;
+		    std::string world_hit_source = world_hit.hit ? "eye" : "none";
+		    const double intended_distance =
+		        world_hit.hit ? world_hit.distance : max_range;
+	    if (std::isfinite(intended_distance) && intended_distance > 0.0) {
+	      muzzle_block_checked = true;
+	      const WorldHitscanHit &muzzle_block = muzzle_world_hits[muzzle_ray_index[shot_index]];
+	      if (muzzle_block.hit) {
+	        muzzle_block_hit = muzzle_block;
+	      }
+	      if (muzzle_block.hit &&
+	          muzzle_block.distance + kShotRetraceEpsilonMeters < intended_distance) {
+	        bool suppressed_near_muzzle_block = false;
+	        const bool near_muzzle_block =
+	            muzzle_block.distance <= kShotNearMuzzleGraceMeters;
+	        uint32_t retry_ignore_instance_id = muzzle_block.instance_id;
+	        if (retry_ignore_instance_id == 0 && muzzle_block.collider_id > 0) {
+	          const auto collider_iter = collider_instance_lookup_.find(muzzle_block.collider_id);
+	          if (collider_iter != collider_instance_lookup_.end()) {
+	            retry_ignore_instance_id = collider_iter->second;
+	          }
+	        }
+	        const bool can_retry_ignore =
+	            (muzzle_block.collider_id > 0) || (retry_ignore_instance_id > 0);
+	        if (near_muzzle_block && can_retry_ignore) {
+	          retry_attempted = true;
+	          afps::sim::RaycastWorldOptions retry_options;
+	          retry_options.min_t = kShotNearMuzzleGraceMeters;
+	          retry_options.max_t = intended_distance;
+	          retry_options.ignore_collider_id = muzzle_block.collider_id;
+		          const auto retrace_hit = ResolveWorldHitscan(
+		              muzzle, shot_dir, sim_config_, &collision_world_, static_mesh_instances_,
+		              collision_mesh_registry_, static_mesh_tlas_, collision_mesh_enabled,
+		              intended_distance, world_hit_backend_mode, &collider_instance_lookup_,
+		              retry_options, retry_ignore_instance_id);
+	          if (retrace_hit.hit) {
+	            retry_hit = true;
+	            retry_world_hit = retrace_hit;
+	          }
+	          if (!retrace_hit.hit ||
+	              retrace_hit.distance + kShotRetraceEpsilonMeters >= intended_distance) {
+	            suppressed_near_muzzle_block = true;
+	            retry_suppressed = true;
+	            world_hit_source = "eye_near_muzzle_suppressed";
+	          } else {
+		            world_hit = retrace_hit;
+		            world_hit.distance = std::min(max_range,
+		                                          std::max(0.0, retrace_hit.distance + kShotMuzzleOffsetMeters));
+		            world_hit.position = Add(origin, Mul(shot_dir, world_hit.distance));
+		            world_hit_source = "muzzle_retry";
+		          }
+		        }
+	        if (!suppressed_near_muzzle_block &&
+	            !(near_muzzle_block && can_retry_ignore)) {
+		          world_hit = muzzle_block;
+		          world_hit.distance = std::min(max_range,
+		                                        std::max(0.0, muzzle_block.distance + kShotMuzzleOffsetMeters));
+		          world_hit.position = Add(origin, Mul(shot_dir, world_hit.distance));
+		          world_hit_source = "muzzle_block";
+		        }
+		      }
+		    }
+
+	    HitKind hit_kind = HitKind::None;
+	    SurfaceType surface_type = SurfaceType::Stone;
+	    afps::combat::Vec3 hit_normal{-shot_dir.x, -shot_dir.y, -shot_dir.z};
+	    double hit_distance = max_range;
+	    afps::entity::EntitySlot hit_target = afps::entity::kInvalidSlot;
+	    if (world_hit.hit &&
+	        world_hit.backend == WorldHitscanHit::Backend::Aabb &&
+	        world_hit.collider_id == -1 &&
+	        std::abs(world_hit.normal.z) < 0.5) {
+	      world_hit.hit = false;
+	      world_hit.distance = max_range;
+	      world_hit.backend = WorldHitscanHit::Backend::None;
+	      world_hit.instance_id = 0;
+	      world_hit.face_id = -1;
+	      world_hit.prefab_id.clear();
+	      world_hit_source = "arena_side_ignored";
+	    }
+	    if (world_hit.hit &&
+	        world_hit.backend == WorldHitscanHit::Backend::MeshBvh &&
+	        world_hit_source.find("mesh") == std::string::npos) {
+	      world_hit_source += "_mesh";
+	    }
+
+	    if (result.hit && (!world_hit.hit || result.distance <= world_hit.distance)) {
+	      hit_kind = HitKind::Player;
+	      hit_distance = result.distance;
+	      hit_target = result.target_slot;
+	      surface_type = SurfaceType::Energy;
+	    } else if (world_hit.hit) {
+	      hit_kind = HitKind::World;
+	      hit_distance = world_hit.distance;
+	      surface_type = world_hit.surface;
+	      hit_normal = world_hit.normal;
+	    }
+	    const afps::combat::Vec3 hit_position =
+	        (hit_kind == HitKind::World) ? world_hit.position : Add(origin, Mul(shot_dir, hit_distance));
+	    ShadowDetailedWorldHit shadow_world_hit;
+	    bool shadow_world_checked = false;
+	    if (event.request.debug_enabled || ShouldLogShotDebug()) {
+	      shadow_world_checked = collision_mesh_enabled;
+	      if (shadow_world_checked) {
+	        shadow_world_hit = ResolveShadowDetailedWorldHitscan(
+	            origin, shot_dir, hit_distance, static_mesh_instances_,
+	            collision_mesh_registry_, static_mesh_tlas_);
+	      }
+	    }
+		    LogHitscanShotDebug(server_tick_, shooter_id, weapon->id, active_slot, shot_seq, estimated_tick,
+		                        event.request, origin, muzzle, shot_dir, max_range, intended_distance, result,
+		                        entities_.IdOf(result.target_slot), eye_world_hit,
+		                        muzzle_block_checked, muzzle_block_hit, retry_attempted, retry_suppressed, retry_hit,
+		                        retry_world_hit, world_hit_source.c_str(), world_hit_backend_mode,
+		                        world_hit, shadow_world_checked, shadow_world_hit,
+		                        hit_kind, entities_.IdOf(hit_target), hit_distance,
+		                        hit_position, hit_normal, surface_type);
+
+	    if (hit_kind == HitKind::Player) {
+	      auto &target_state = players_[hit_target];
+	      const bool shield_active = target_state.shield_active;
+	      const bool shield_facing = shield_active ? resolve_shield_facing(hit_target, muzzle) : true;
+	      const bool killed = afps::combat::ApplyDamageWithShield(combat_states_[hit_target], &shooter_combat,
+	                                                              weapon->damage, shield_active && shield_facing,
+	                                                              sim_config_.shield_damage_multiplier);
+	      if (killed) {
+	        emit_kill_feed_all(event.slot, hit_target);
+	        target_state.vel_x = 0.0;
+	        target_state.vel_y = 0.0;
+	        target_state.vel_z = 0.0;
+	        target_state.dash_cooldown = 0.0;
+	      }
+	      if (shield_active && shield_facing) {
+	        surface_type = SurfaceType::Energy;
+	      }
+	      HitConfirmedFx confirmed;
+	      confirmed.target_id = entities_.IdOf(hit_target);
+	      confirmed.damage = weapon->damage;
+	      confirmed.killed = killed;
+	      emit_fx_to(event.slot, confirmed);
+	    }
+
+	    if (max_range > 0.0) {
+	      const auto normal_oct = EncodeOct16(hit_normal.x, hit_normal.y, hit_normal.z);
+	      ShotTraceFx trace;
+	      trace.shooter_id = shooter_id;
+	      trace.weapon_slot = static_cast<uint8_t>(active_slot);
+	      trace.shot_seq = shot_seq;
+	      trace.dir_oct_x = dir_oct.x;
+	      trace.dir_oct_y = dir_oct.y;
+	      trace.hit_dist_q = QuantizeU16(hit_distance, kHitDistanceStepMeters);
+	      trace.hit_kind = hit_kind;
+	      trace.surface_type = surface_type;
+	      trace.normal_oct_x = normal_oct.x;
+	      trace.normal_oct_y = normal_oct.y;
+	      trace.show_tracer = should_show_tracer(weapon, shot_seq, loadout_bits);
+	      trace.hit_pos_x_q = QuantizeI16(hit_position.x, kShotTracePositionStepMeters);
+	      trace.hit_pos_y_q = QuantizeI16(hit_position.y, kShotTracePositionStepMeters);
+	      trace.hit_pos_z_q = QuantizeI16(hit_position.z, kShotTracePositionStepMeters);
+
+	      // Unreliable traces only go to recipients near the shooter or the impact; those near only the
+	      // impact get hit data without the long-distance tracer.
+	      interest_matches.clear();
+	      interest_grid_.Query({shooter_pose.x, shooter_pose.y, shooter_pose.z}, kTraceCullDistanceMeters,
+	                           interest_matches);
+	      const size_t near_shooter_count = interest_matches.size();
+	      interest_grid_.Query({hit_position.x, hit_position.y, hit_position.z}, kTraceCullDistanceMeters,
+	                           interest_matches);
+	      for (size_t match = 0; match < interest_matches.size(); ++match) {
+	        const size_t index = interest_matches[match];
+	        if (trace_sent_[index]) {
+	          continue;
+	        }
+	        trace_sent_[index] = 1;
+	        ShotTraceFx recipient_trace = trace;
+	        if (match >= near_shooter_count) {
+	          recipient_trace.show_tracer = false;
+	        }
+	        emit_fx_to(static_cast<afps::entity::EntitySlot>(index), recipient_trace);
+	      }
+	      for (const size_t index : interest_matches) {
+	        trace_sent_[index] = 0;
+	      }
+
+	      if (hit_kind == HitKind::World) {
+	        const double cull_sq = kTraceCullDistanceMeters * kTraceCullDistanceMeters;
+	        for (const auto recipient : active_slots) {
+	          const auto &recipient_state = players_[recipient];
+	          const double dx = recipient_state.x - shooter_pose.x;
+	          const double dy = recipient_state.y - shooter_pose.y;
+	          const double dz = recipient_state.z - shooter_pose.z;
+	          const double dist_sq = dx * dx + dy * dy + dz * dz;
+	          ShotTraceFx recipient_trace = trace;
+	          if (dist_sq > cull_sq) {
+	            recipient_trace.show_tracer = false;
+	          }
+	          // Stream world-hit traces reliably to everyone so remote decals are authoritative.
+	          emit_reliable_decal_to(recipient, recipient_trace);
+	        }
+	      }
+	    }
+
+	    const afps::combat::Vec3 segment_start = origin;
+	    const afps::combat::Vec3 segment_end = Add(origin, Mul(shot_dir, hit_distance));
+	    const double capsule_radius = (std::isfinite(sim_config_.player_radius) && sim_config_.player_radius > 0.0)
+	                                      ? sim_config_.player_radius
+	                                      : 0.4;
+	    const double threshold = capsule_radius + kNearMissExtraRadius;
+	    const double threshold_sq = threshold * threshold;
+	    // The grid holds post-movement feet positions while the test below uses poses rewound to
+	    // estimated_tick, so the query also covers the capsule height and how far a player can have
+	    // moved since then.
+	    const double rewind_seconds = static_cast<double>(std::max(0, server_tick_ - estimated_tick)) * dt;
+	    const double near_miss_reach =
+	        threshold + afps::combat::kPlayerHeight + rewind_seconds * kNearMissRewindSpeedMetersPerSecond;
+	    interest_matches.clear();
+	    interest_grid_.QuerySegment({segment_start.x, segment_start.y, segment_start.z},
+	                                {segment_end.x, segment_end.y, segment_end.z}, near_miss_reach,
+	                                interest_matches);
+	    for (const size_t index : interest_matches) {
+	      const auto target = static_cast<afps::entity::EntitySlot>(index);
+	      if (target == event.slot || target == hit_target) {
+	        continue;
+	      }
+	      afps::combat::RewindPose pose;
+	      if (!pose_histories_[target].SampleAtOrBefore(estimated_tick, pose)) {
+	        continue;
+	      }
+	      const afps::combat::Vec3 axis_start{pose.x, pose.y, pose.z};
+	      const afps::combat::Vec3 axis_end{pose.x, pose.y, pose.z + afps::combat::kPlayerHeight};
+	      const double dist_sq = SegmentSegmentDistanceSquared(segment_start, segment_end, axis_start, axis_end);
+	      if (dist_sq > threshold_sq) {
+	        continue;
+	      }
+	      const double dist = std::sqrt(std::max(0.0, dist_sq));
+	      const double closeness = Clamp01((threshold - dist) / threshold);
+	      const uint8_t strength = static_cast<uint8_t>(std::llround(closeness * 255.0));
+	      if (strength == 0) {
+	        continue;
+	      }
+	      NearMissFx near_miss;
+	      near_miss.shooter_id = shooter_id;
+	      near_miss.shot_seq = shot_seq;
+	      near_miss.strength = strength;
+	      emit_fx_to(target, near_miss);
+	    }
+	    }
+	  }
 
-	    std::vector<afps::combat::ProjectileState> next_projectiles;
-	    next_projectiles.reserve(projectiles_.size());
-	    for (auto &projectile : projectiles_) {
-	      if (!std::isfinite(projectile.ttl) || projectile.ttl <= 0.0) {
+	  if (!projectiles_.empty()) {
+	    for (size_t index = 0; index < projectiles_.size(); ++index) {
+	      double &ttl = projectiles_.ttl(index);
+	      if (!std::isfinite(ttl) || ttl <= 0.0) {
 	        ProjectileRemoveFx remove;
-	        remove.projectile_id = projectile.id;
+	        remove.projectile_id = projectiles_.id(index);
 	        emit_fx_all(remove);
+	        projectiles_.Remove(index);
 	        continue;
 	      }
-	      projectile.ttl = std::max(0.0, projectile.ttl - dt);
-	      if (projectile.ttl <= 0.0) {
+	      ttl = std::max(0.0, ttl - dt);
+	      if (ttl <= 0.0) {
 	        ProjectileRemoveFx remove;
-	        remove.projectile_id = projectile.id;
+	        remove.projectile_id = projectiles_.id(index);
 	        emit_fx_all(remove);
+	        projectiles_.Remove(index);
 	        continue;
 	      }
+	      afps::combat::ProjectileState projectile = projectiles_.Get(index);
 	      const afps::combat::Vec3 delta{projectile.velocity.x * dt, projectile.velocity.y * dt,
 	                                     projectile.velocity.z * dt};
-	      const auto impact = afps::combat::ResolveProjectileImpact(
-          projectile, delta, sim_config_, alive_players, projectile.owner_id, &collision_world_);
+	      // The owner may have left since firing; a stale handle must not credit whoever reused the slot.
+	      const afps::entity::EntitySlot owner =
+	          entities_.IsCurrent(projectile.owner) ? projectile.owner.slot : afps::entity::kInvalidSlot;
+	      // Each sub-step is a swept test, so speed never tunnels; splitting only keeps the player query
+	      // around each piece tight.
+	      const int substeps = afps::combat::ProjectileSubsteps(delta, kProjectileSubstepMeters, kProjectileMaxSubsteps);
+	      const afps::combat::Vec3 step =
+	          substeps == 1 ? delta : afps::combat::Vec3{delta.x / substeps, delta.y / substeps, delta.z / substeps};
+	      const double step_reach = 0.5 * std::sqrt(step.x * step.x + step.y * step.y + step.z * step.z) +
+	                                afps::combat::PlayerCollisionReach(sim_config_, projectile.radius);
+	      afps::combat::ProjectileImpact impact;
+	      for (int substep = 0; substep < substeps; ++substep) {
+	        const afps::combat::Vec3 sweep_center{projectile.position.x + step.x * 0.5,
+	                                              projectile.position.y + step.y * 0.5,
+	                                              projectile.position.z + step.z * 0.5};
+	        impact = afps::combat::ResolveProjectileImpact(
+	            projectile, step, sim_config_, players_, gather_alive_targets(sweep_center, step_reach), owner,
+	            &collision_world_);
+	        if (impact.hit) {
+	          break;
+	        }
+	        projectile.position.x += step.x;
+	        projectile.position.y += step.y;
+	        projectile.position.z += step.z;
+	      }
 	      if (impact.hit) {
 	        const auto hits = afps::combat::ComputeExplosionDamage(
-	            impact.position, projectile.explosion_radius, projectile.damage, alive_players, "");
+	            impact.position, projectile.explosion_radius, projectile.damage, players_,
+	            gather_alive_targets(impact.position, projectile.explosion_radius + afps::combat::kPlayerHeight * 0.5),
+	            afps::entity::kInvalidSlot);
+	        afps::combat::CombatState *attacker =
+	            owner == afps::entity::kInvalidSlot ? nullptr : &combat_states_[owner];
 	        for (const auto &hit : hits) {
-          auto target_iter = combat_states_.find(hit.target_id);
-          if (target_iter == combat_states_.end() || !target_iter->second.alive) {
+          auto &target_combat = combat_states_[hit.target_slot];
+          if (!target_combat.alive) {
             continue;
           }
-          auto attacker_iter = combat_states_.find(projectile.owner_id);
-          afps::combat::CombatState *attacker =
-              attacker_iter == combat_states_.end() ? nullptr : &attacker_iter->second;
-          bool shield_active = false;
-          bool shield_facing = true;
-          auto state_iter = players_.find(hit.target_id);
-          if (state_iter != players_.end()) {
-            shield_active = state_iter->second.shield_active;
-          }
-	          if (shield_active) {
-	            shield_facing = resolve_shield_facing(hit.target_id, impact.position);
-	          }
-	          const bool killed = afps::combat::ApplyDamageWithShield(target_iter->second, attacker, hit.damage,
+          auto &target_state = players_[hit.target_slot];
+          const bool shield_active = target_state.shield_active;
+          const bool shield_facing =
+              shield_active ? resolve_shield_facing(hit.target_slot, impact.position) : true;
+	          const bool killed = afps::combat::ApplyDamageWithShield(target_combat, attacker, hit.damage,
 	                                                                  shield_active && shield_facing,
 	                                                                  sim_config_.shield_damage_multiplier);
 	          HitConfirmedFx hit_event;
-	          hit_event.target_id = hit.target_id;
+	          hit_event.target_id = entities_.IdOf(hit.target_slot);
 	          hit_event.damage = hit.damage;
 		          hit_event.killed = killed;
-		          emit_fx_to(projectile.owner_id, hit_event);
+		          emit_fx_to(owner, hit_event);
 		          if (killed) {
-		            emit_kill_feed_all(projectile.owner_id, hit.target_id);
-		            auto &target_state = players_[hit.target_id];
+		            emit_kill_feed_all(owner, hit.target_slot);
 		            target_state.vel_x = 0.0;
 		            target_state.vel_y = 0.0;
             target_state.vel_z = 0.0;
             target_state.dash_cooldown = 0.0;
-	            alive_players.erase(hit.target_id);
 	          }
 	        }
 	        afps::combat::Vec3 normal = impact.normal;
@@ -2680,7 +2862,7 @@ void TickLoop::Step() {
 	        ProjectileImpactFx impact_event;
 	        impact_event.projectile_id = projectile.id;
 	        impact_event.hit_world = impact.hit_world;
-	        impact_event.target_id = impact.target_id;
+	        impact_event.target_id = entities_.IdOf(impact.target_slot);
 	        impact_event.pos_x_q = QuantizeI16(impact.position.x, kProjectilePositionStepMeters);
 	        impact_event.pos_y_q = QuantizeI16(impact.position.y, kProjectilePositionStepMeters);
 	        impact_event.pos_z_q = QuantizeI16(impact.position.z, kProjectilePositionStepMeters);
@@ -2695,14 +2877,12 @@ void TickLoop::Step() {
 	        ProjectileRemoveFx remove_event;
 	        remove_event.projectile_id = projectile.id;
 	        emit_fx_all(remove_event);
+	        projectiles_.Remove(index);
 	        continue;
 	      }
-	      projectile.position.x += delta.x;
-	      projectile.position.y += delta.y;
-      projectile.position.z += delta.z;
-      next_projectiles.push_back(projectile);
-    }
-	    projectiles_.swap(next_projectiles);
+	      projectiles_.position(index) = projectile.position;
+	    }
+	    projectiles_.Compact();
 	  }
 
 	  auto fx_priority = [](const FxEventData &event) {
@@ -2730,13 +2910,13 @@ void TickLoop::Step() {
 	        event);
 	  };
 
-	  for (const auto &recipient_id : active_ids) {
-	    auto iter = fx_events.find(recipient_id);
-	    if (iter == fx_events.end() || iter->second.empty()) {
+	  for (const auto recipient : active_slots) {
+	    auto &events = fx_events[recipient];
+	    if (events.empty()) {
 	      continue;
 	    }
-	    auto &events = iter->second;
-	    const uint32_t server_seq_ack = store_.LastClientMessageSeq(recipient_id);
+	    const std::string &recipient_id = entities_.IdOf(recipient);
+	    const uint32_t server_seq_ack = transport_.LastClientMessageSeq(recipient_id);
 
 	    while (!events.empty()) {
 	      GameEventBatch batch;
@@ -2745,9 +2925,9 @@ void TickLoop::Step() {
 	      const auto probe = BuildGameEventBatch(batch, 0, server_seq_ack);
 	      if (probe.size() <= kMaxClientMessageBytes) {
 	        const auto payload = BuildGameEventBatch(batch,
-	                                                 store_.NextServerMessageSeq(recipient_id),
+	                                                 transport_.NextServerMessageSeq(recipient_id),
 	                                                 server_seq_ack);
-	        store_.SendUnreliable(recipient_id, payload);
+	        transport_.SendUnreliable(recipient_id, payload);
 	        break;
 	      }
 	      size_t drop_index = 0;
@@ -2764,12 +2944,12 @@ void TickLoop::Step() {
 	  }
 
 	  constexpr size_t kMaxReliableDecalEventsPerMessage = 24;
-	  for (const auto &recipient_id : active_ids) {
-	    auto iter = reliable_decal_events.find(recipient_id);
-	    if (iter == reliable_decal_events.end() || iter->second.empty()) {
+	  for (const auto recipient : active_slots) {
+	    auto &events = reliable_decal_events[recipient];
+	    if (events.empty()) {
 	      continue;
 	    }
-	    auto &events = iter->second;
+	    const std::string &recipient_id = entities_.IdOf(recipient);
 	    size_t index = 0;
 	    while (index < events.size()) {
 	      size_t count = std::min(kMaxReliableDecalEventsPerMessage, events.size() - index);
@@ -2781,10 +2961,10 @@ void TickLoop::Step() {
 	                            events.begin() + static_cast<long>(index),
 	                            events.begin() + static_cast<long>(index + count));
 	        const auto payload = BuildGameEventBatch(batch,
-	                                                 store_.NextServerMessageSeq(recipient_id),
-	                                                 store_.LastClientMessageSeq(recipient_id));
+	                                                 transport_.NextServerMessageSeq(recipient_id),
+	                                                 transport_.LastClientMessageSeq(recipient_id));
 	        if (payload.size() <= kMaxClientMessageBytes) {
-	          store_.SendReliable(recipient_id, payload);
+	          transport_.SendReliable(recipient_id, payload);
 	          index += count;
 	          sent = true;
 	        } else {
@@ -2804,59 +2984,52 @@ void TickLoop::Step() {
 	  }
   if (snapshot_accumulator_ >= 1.0) {
     snapshot_accumulator_ -= 1.0;
-    for (const auto &connection_id : active_ids) {
+    std::vector<StateSnapshot> states;
+    states.reserve(active_slots.size());
+    for (const auto entity : active_slots) {
       StateSnapshot snapshot;
       snapshot.server_tick = server_tick_;
-      snapshot.client_id = connection_id;
-      auto seq_iter = last_input_seq_.find(connection_id);
-      snapshot.last_processed_input_seq = (seq_iter == last_input_seq_.end()) ? -1 : seq_iter->second;
-      auto input_iter = last_inputs_.find(connection_id);
-      snapshot.weapon_slot = (input_iter == last_inputs_.end()) ? 0 : input_iter->second.weapon_slot;
+      snapshot.client_id = entities_.IdOf(entity);
+      snapshot.last_processed_input_seq = last_input_seq_[entity];
+      const InputCmd &input = last_inputs_[entity];
+      snapshot.weapon_slot = input.weapon_slot;
       if (!weapon_config_.slots.empty()) {
         const int max_slot = static_cast<int>(weapon_config_.slots.size() - 1);
         snapshot.weapon_slot = std::min(snapshot.weapon_slot, max_slot);
       }
-      auto weapon_state_iter = weapon_states_.find(connection_id);
-      if (weapon_state_iter != weapon_states_.end() &&
-          snapshot.weapon_slot >= 0 &&
-          static_cast<size_t>(snapshot.weapon_slot) < weapon_state_iter->second.slots.size()) {
-        snapshot.ammo_in_mag = weapon_state_iter->second.slots[snapshot.weapon_slot].ammo_in_mag;
-      }
-      auto state_iter = players_.find(connection_id);
-      if (state_iter != players_.end()) {
-        snapshot.pos_x = state_iter->second.x;
-        snapshot.pos_y = state_iter->second.y;
-        snapshot.pos_z = state_iter->second.z;
-        snapshot.vel_x = state_iter->second.vel_x;
-        snapshot.vel_y = state_iter->second.vel_y;
-        snapshot.vel_z = state_iter->second.vel_z;
-        snapshot.dash_cooldown = state_iter->second.dash_cooldown;
+      const auto &weapon_state = weapon_states_[entity];
+      const bool has_weapon_slot =
+          snapshot.weapon_slot >= 0 && static_cast<size_t>(snapshot.weapon_slot) < weapon_state.slots.size();
+      if (has_weapon_slot) {
+        snapshot.ammo_in_mag = weapon_state.slots[snapshot.weapon_slot].ammo_in_mag;
       }
-	      auto combat_iter = combat_states_.find(connection_id);
-	      if (combat_iter != combat_states_.end()) {
-	        snapshot.health = combat_iter->second.health;
-	        snapshot.kills = combat_iter->second.kills;
-	        snapshot.deaths = combat_iter->second.deaths;
-	      }
-	      const auto view = resolve_view(connection_id);
-	      snapshot.view_yaw_q = QuantizeYaw(view.yaw);
-	      snapshot.view_pitch_q = QuantizePitch(view.pitch);
+      const auto &state = players_[entity];
+      snapshot.pos_x_q = QuantizeSnapshotPosition(state.x);
+      snapshot.pos_y_q = QuantizeSnapshotPosition(state.y);
+      snapshot.pos_z_q = QuantizeSnapshotPosition(state.z);
+      snapshot.vel_x_q = QuantizeSnapshotVelocity(state.vel_x);
+      snapshot.vel_y_q = QuantizeSnapshotVelocity(state.vel_y);
+      snapshot.vel_z_q = QuantizeSnapshotVelocity(state.vel_z);
+      snapshot.dash_cooldown_q = QuantizeSnapshotDashCooldown(state.dash_cooldown);
+	      const auto &combat_state = combat_states_[entity];
+	      snapshot.health_q = QuantizeSnapshotHealth(combat_state.health);
+	      snapshot.kills = combat_state.kills;
+	      snapshot.deaths = combat_state.deaths;
+	      const auto view = resolve_view(entity);
+	      snapshot.view_yaw_q = QuantizeViewYaw(view.yaw);
+	      snapshot.view_pitch_q = QuantizeViewPitch(view.pitch);
 
 	      uint8_t flags = 0;
-	      if (input_iter != last_inputs_.end()) {
-	        if (input_iter->second.ads) {
-	          flags |= kPlayerFlagAds;
-	        }
-	        if (input_iter->second.sprint) {
-	          flags |= kPlayerFlagSprint;
-	        }
+	      if (input.ads) {
+	        flags |= kPlayerFlagAds;
+	      }
+	      if (input.sprint) {
+	        flags |= kPlayerFlagSprint;
 	      }
 	      bool reloading = false;
 	      bool overheated = false;
-	      if (weapon_state_iter != weapon_states_.end() &&
-	          snapshot.weapon_slot >= 0 &&
-	          static_cast<size_t>(snapshot.weapon_slot) < weapon_state_iter->second.slots.size()) {
-	        const auto &slot = weapon_state_iter->second.slots[snapshot.weapon_slot];
+	      if (has_weapon_slot) {
+	        const auto &slot = weapon_state.slots[snapshot.weapon_slot];
 	        reloading = slot.reload_timer > 0.0;
 	        overheated = slot.overheat_timer > 0.0;
 	        snapshot.weapon_heat_q = quantize_unit_u16(slot.heat);
@@ -2866,126 +3039,155 @@ void TickLoop::Step() {
 	      if (reloading) {
 	        flags |= kPlayerFlagReloading;
 	      }
-	      if (state_iter != players_.end() && state_iter->second.shield_active) {
+	      if (state.shield_active) {
 	        flags |= kPlayerFlagShieldActive;
 	      }
 	      if (overheated) {
 	        flags |= kPlayerFlagOverheated;
 	      }
-	      if (state_iter != players_.end() && state_iter->second.crouched) {
+	      if (state.crouched) {
 	        flags |= kPlayerFlagCrouched;
 	      }
 	      snapshot.player_flags = flags;
-	      auto loadout_iter = loadout_bits_.find(connection_id);
-	      snapshot.loadout_bits = (loadout_iter == loadout_bits_.end()) ? 0 : loadout_iter->second;
-	      auto baseline_iter = last_full_snapshots_.find(connection_id);
-	      int &sequence = snapshot_sequence_[connection_id];
-	      const bool needs_full = (baseline_iter == last_full_snapshots_.end()) ||
-	                              (snapshot_keyframe_interval_ <= 0) ||
-	                              (sequence % snapshot_keyframe_interval_ == 0);
-
-      if (needs_full) {
-        for (const auto &recipient_id : active_ids) {
-          const auto payload =
-              BuildStateSnapshot(snapshot,
-                                 store_.NextServerMessageSeq(recipient_id),
-                                 store_.LastClientMessageSeq(recipient_id));
-          if (store_.SendUnreliable(recipient_id, payload)) {
-            snapshot_count_ += 1;
-          }
-        }
-        last_full_snapshots_[connection_id] = snapshot;
-        sequence += 1;
-        continue;
-      }
-
-      const StateSnapshot &baseline = baseline_iter->second;
-      StateSnapshotDelta delta;
-      delta.server_tick = snapshot.server_tick;
-      delta.base_tick = baseline.server_tick;
-      delta.last_processed_input_seq = snapshot.last_processed_input_seq;
-      delta.client_id = snapshot.client_id;
-      delta.mask = 0;
-      if (snapshot.pos_x != baseline.pos_x) {
-        delta.mask |= kSnapshotMaskPosX;
-        delta.pos_x = snapshot.pos_x;
-      }
-      if (snapshot.pos_y != baseline.pos_y) {
-        delta.mask |= kSnapshotMaskPosY;
-        delta.pos_y = snapshot.pos_y;
+	      snapshot.loadout_bits = loadout_bits_[entity];
+	      states.push_back(std::move(snapshot));
+    }
+
+    // The client only keeps kSnapshotBaselineHistory reconstructed snapshots per player.
+    const int ticks_per_snapshot = std::max(1, accumulator_.tick_rate() / kSnapshotRate);
+    const int min_baseline_tick =
+        server_tick_ - static_cast<int>(kSnapshotBaselineHistory - 1) * ticks_per_snapshot;
+    const int snapshot_index = server_tick_ / ticks_per_snapshot;
+    auto &near_subjects = near_subjects_;
+    near_subjects.resize(entity_capacity, 0);
+    // What a recipient's history keeps for each state: the subject's handle and its quantized fields.
+    auto &subject_baselines = subject_baselines_;
+    subject_baselines.clear();
+    for (size_t i = 0; i < states.size(); ++i) {
+      subject_baselines.push_back({entities_.HandleOf(active_slots[i]), ToSnapshotBaseline(states[i])});
+    }
+    auto &sent_states = sent_states_;
+
+    // A subject's keyframe, and its delta from a given base tick, are the same bytes for every
+    // recipient, so each is encoded at most once per snapshot and shared.
+    auto &entry_cache = snapshot_entry_cache_;
+    if (entry_cache.size() < states.size()) {
+      entry_cache.resize(states.size());
+    }
+    // Every snapshot_keyframe_interval_ snapshots a subject goes out as a keyframe to everyone, so a
+    // client whose reconstructed state drifted from its baseline recovers. Subjects are staggered by
+    // hash so the keyframes spread over the interval.
+    const uint32_t keyframe_interval = static_cast<uint32_t>(std::max(1, snapshot_keyframe_interval_));
+    for (size_t i = 0; i < states.size(); ++i) {
+      entry_cache[i].keyframe_ready = false;
+      entry_cache[i].delta_count = 0;
+      entry_cache[i].keyframe_due =
+          (static_cast<uint32_t>(snapshot_index) + entity_hashes_[active_slots[i]]) % keyframe_interval == 0;
+    }
+    auto keyframe_entry = [&](size_t i) -> const EncodedSnapshotEntry * {
+      SnapshotEntryCache &cache = entry_cache[i];
+      if (!cache.keyframe_ready) {
+        cache.keyframe = EncodeSnapshotEntry(states[i], server_tick_);
+        cache.keyframe_ready = true;
       }
-      if (snapshot.pos_z != baseline.pos_z) {
-        delta.mask |= kSnapshotMaskPosZ;
-        delta.pos_z = snapshot.pos_z;
-      }
-      if (snapshot.vel_x != baseline.vel_x) {
-        delta.mask |= kSnapshotMaskVelX;
-        delta.vel_x = snapshot.vel_x;
-      }
-      if (snapshot.vel_y != baseline.vel_y) {
-        delta.mask |= kSnapshotMaskVelY;
-        delta.vel_y = snapshot.vel_y;
-      }
-      if (snapshot.vel_z != baseline.vel_z) {
-        delta.mask |= kSnapshotMaskVelZ;
-        delta.vel_z = snapshot.vel_z;
-      }
-      if (snapshot.weapon_slot != baseline.weapon_slot) {
-        delta.mask |= kSnapshotMaskWeaponSlot;
-        delta.weapon_slot = snapshot.weapon_slot;
+      return &cache.keyframe;
+    };
+    // Growing cache.deltas moves its entries, which is safe because a recipient takes at most one
+    // entry per subject and its packets are built before the next recipient starts.
+    auto delta_entry = [&](size_t i, const SnapshotBaseline &baseline) -> const EncodedSnapshotEntry * {
+      SnapshotEntryCache &cache = entry_cache[i];
+      for (size_t d = 0; d < cache.delta_count; ++d) {
+        if (cache.deltas[d].base_tick == baseline.server_tick) {
+          return &cache.deltas[d].entry;
+        }
       }
-      if (snapshot.ammo_in_mag != baseline.ammo_in_mag) {
-        delta.mask |= kSnapshotMaskAmmoInMag;
-        delta.ammo_in_mag = snapshot.ammo_in_mag;
+      if (cache.delta_count == cache.deltas.size()) {
+        cache.deltas.emplace_back();
       }
-      if (snapshot.dash_cooldown != baseline.dash_cooldown) {
-        delta.mask |= kSnapshotMaskDashCooldown;
-        delta.dash_cooldown = snapshot.dash_cooldown;
+      SnapshotEntryCache::Delta &delta = cache.deltas[cache.delta_count++];
+      delta.base_tick = baseline.server_tick;
+      delta.entry = EncodeSnapshotEntry(DiffStateSnapshot(baseline, states[i]), server_tick_);
+      return &delta.entry;
+    };
+    auto &picks = snapshot_picks_;
+    auto &recipient_entries = recipient_entries_;
+    for (const auto recipient : active_slots) {
+      const std::string &recipient_id = entities_.IdOf(recipient);
+      SnapshotHistory &history = snapshot_histories_[recipient];
+      history.DropBaselinesBefore(min_baseline_tick);
+
+      // Players within the near radius (and in line of sight, when occlusion is enabled) get every
+      // snapshot; everyone else is sent at a reduced rate.
+      std::fill(near_subjects.begin(), near_subjects.end(), 0);
+      near_subjects[recipient] = 1;
+      const afps::sim::Vec3 recipient_position{players_[recipient].x, players_[recipient].y, players_[recipient].z};
+      interest_matches.clear();
+      interest_grid_.Query(recipient_position, afps::interest::kNearRadiusMeters, interest_matches);
+      const double occlusion_min_sq =
+          afps::interest::kOcclusionMinDistanceMeters * afps::interest::kOcclusionMinDistanceMeters;
+      for (const size_t index : interest_matches) {
+        if (interest_occlusion_ && index != recipient) {
+          const afps::sim::PlayerState &subject_state = players_[index];
+          const double dx = subject_state.x - recipient_position.x;
+          const double dy = subject_state.y - recipient_position.y;
+          const double dz = subject_state.z - recipient_position.z;
+          if (dx * dx + dy * dy + dz * dz > occlusion_min_sq &&
+              afps::interest::IsLineOfSightBlocked(
+                  collision_world_,
+                  {recipient_position.x, recipient_position.y, recipient_position.z + afps::combat::kPlayerEyeHeight},
+                  {subject_state.x, subject_state.y, subject_state.z + afps::combat::kPlayerEyeHeight})) {
+            continue;
+          }
+        }
+        near_subjects[index] = 1;
       }
-      if (snapshot.health != baseline.health) {
-        delta.mask |= kSnapshotMaskHealth;
-        delta.health = snapshot.health;
+
+      picks.clear();
+      for (size_t i = 0; i < states.size(); ++i) {
+        const afps::entity::EntitySlot subject = active_slots[i];
+        if (!near_subjects[subject] &&
+            !afps::interest::ShouldSendFarSnapshot(snapshot_index, entity_hashes_[subject],
+                                                   afps::interest::kFarSnapshotDivisor)) {
+          continue;
+        }
+        const SnapshotBaseline *baseline =
+            entry_cache[i].keyframe_due ? nullptr : history.Baseline(subject_baselines[i].subject, min_baseline_tick);
+        if (!baseline) {
+          picks.push_back({kKeyframePickTick, i, keyframe_entry(i)});
+          continue;
+        }
+        picks.push_back({baseline->server_tick, i, delta_entry(i, *baseline)});
       }
-      if (snapshot.kills != baseline.kills) {
-        delta.mask |= kSnapshotMaskKills;
-        delta.kills = snapshot.kills;
+      // The last packet is the one the next ack most often names, so keyframes and the oldest
+      // baselines go at the end.
+      std::stable_sort(picks.begin(), picks.end(),
+                       [](const SnapshotPick &a, const SnapshotPick &b) { return a.base_tick > b.base_tick; });
+      recipient_entries.clear();
+      for (const auto &pick : picks) {
+        recipient_entries.push_back(pick.entry);
       }
-	      if (snapshot.deaths != baseline.deaths) {
-	        delta.mask |= kSnapshotMaskDeaths;
-	        delta.deaths = snapshot.deaths;
-	      }
-	      if (snapshot.view_yaw_q != baseline.view_yaw_q) {
-	        delta.mask |= kSnapshotMaskViewYawQ;
-	        delta.view_yaw_q = snapshot.view_yaw_q;
-	      }
-	      if (snapshot.view_pitch_q != baseline.view_pitch_q) {
-	        delta.mask |= kSnapshotMaskViewPitchQ;
-	        delta.view_pitch_q = snapshot.view_pitch_q;
-	      }
-	      if (snapshot.player_flags != baseline.player_flags) {
-	        delta.mask |= kSnapshotMaskPlayerFlags;
-	        delta.player_flags = snapshot.player_flags;
-	      }
-	      if (snapshot.weapon_heat_q != baseline.weapon_heat_q) {
-	        delta.mask |= kSnapshotMaskWeaponHeatQ;
-	        delta.weapon_heat_q = snapshot.weapon_heat_q;
-	      }
-	      if (snapshot.loadout_bits != baseline.loadout_bits) {
-	        delta.mask |= kSnapshotMaskLoadoutBits;
-	        delta.loadout_bits = snapshot.loadout_bits;
-	      }
 
-	      for (const auto &recipient_id : active_ids) {
-	        const auto payload =
-	            BuildStateSnapshotDelta(delta,
-                                    store_.NextServerMessageSeq(recipient_id),
-                                    store_.LastClientMessageSeq(recipient_id));
-        if (store_.SendUnreliable(recipient_id, payload)) {
-          snapshot_count_ += 1;
+      const uint32_t server_seq_ack = transport_.LastClientMessageSeq(recipient_id);
+      for (auto &packet : BuildWorldSnapshotPackets(server_tick_, recipient_entries)) {
+        const uint32_t msg_seq = transport_.NextServerMessageSeq(recipient_id);
+        if (!StampEnvelopeSequence(packet.message, msg_seq, server_seq_ack) ||
+            !transport_.SendUnreliable(recipient_id, packet.message)) {
+          continue;
+        }
+        snapshot_count_ += 1;
+        sent_states.clear();
+        for (size_t entry = packet.first_entry; entry < packet.first_entry + packet.entry_count; ++entry) {
+          sent_states.push_back(subject_baselines[picks[entry].state]);
         }
+        history.Record(msg_seq, sent_states);
       }
-      sequence += 1;
     }
   }
+
+  // Everything above was only queued; each connection's messages leave here in a few bundles.
+  const auto flush_start = TickAccumulator::Clock::now();
+  transport_.FlushOutbound(room_id_);
+  last_flush_ms_ =
+      std::chrono::duration<double, std::milli>(TickAccumulator::Clock::now() - flush_start).count();
 }
 #endif
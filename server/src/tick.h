@@ -24,16 +24,24 @@ private:
 #ifdef AFPS_ENABLE_WEBRTC
 #include <atomic>
 #include <cstddef>
+#include <limits>
 #include <string>
 #include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "combat.h"
+#include "entity_registry.h"
+#include "input_buffer.h"
+#include "interest.h"
 #include "map_world.h"
+#include "projectile_pool.h"
 #include "signaling.h"
+#include "snapshot_history.h"
+#include "static_mesh_tlas.h"
 #include "sim/sim.h"
 #include "weapons/weapon_defs.h"
+#include "work_pool.h"
 #include "world_collision_mesh.h"
 
 namespace afps::server {
@@ -53,19 +61,35 @@ struct WorldHitFallbackPolicyInput {
 
 bool WorldHitAllowsAabbFallback(const WorldHitFallbackPolicyInput &input);
 
+// Bounds on what a room's snapshots can carry, for checking against the quantized wire ranges at startup.
+SnapshotFieldBounds ComputeSnapshotFieldBounds(const afps::sim::SimConfig &config,
+                                               const afps::sim::CollisionWorld &world,
+                                               const afps::weapons::WeaponConfig &weapons);
+
 }  // namespace afps::server
 
 class TickLoop {
 public:
-  TickLoop(SignalingStore &store,
+  TickLoop(TickTransport &transport,
            int tick_rate,
            int snapshot_keyframe_interval,
            uint32_t map_seed = 0,
-           const afps::world::MapWorldOptions &map_options = {});
+           const afps::world::MapWorldOptions &map_options = {},
+           bool interest_occlusion = false,
+           std::string room_id = {},
+           size_t movement_workers = 1);
   ~TickLoop();
 
   void Start();
   void Stop();
+  // Runs every tick due at now and returns when the next one is due. Used by RoomManager
+  // workers instead of Start; must not be called concurrently with itself or Start.
+  TickAccumulator::Clock::time_point Advance(TickAccumulator::Clock::time_point now);
+  TickAccumulator::Clock::duration tick_duration() const;
+  const std::string &room_id() const;
+  size_t player_count() const;
+  // Time the last tick spent in FlushOutbound, included in its run time.
+  double last_flush_ms() const;
 
 private:
   struct WeaponSlotState {
@@ -89,32 +113,90 @@ private:
 
   void Run();
   void Step();
+  void ResizeEntityComponents(size_t count);
+  void ResetEntityComponents(afps::entity::EntitySlot slot);
 
-  SignalingStore &store_;
+  TickTransport &transport_;
+  std::string room_id_;
   TickAccumulator accumulator_;
   std::atomic<bool> running_{false};
   std::thread thread_;
-  std::unordered_map<std::string, InputCmd> last_inputs_;
-  std::unordered_map<std::string, afps::sim::PlayerState> players_;
-  std::unordered_map<std::string, int> last_input_seq_;
-  std::unordered_map<std::string, int> last_input_server_tick_;
-  std::unordered_map<std::string, StateSnapshot> last_full_snapshots_;
-  std::unordered_map<std::string, int> snapshot_sequence_;
-  std::unordered_map<std::string, PlayerWeaponState> weapon_states_;
-  std::unordered_map<std::string, uint32_t> loadout_bits_;
-  std::unordered_map<std::string, afps::combat::PoseHistory> pose_histories_;
-  std::unordered_map<std::string, afps::combat::CombatState> combat_states_;
-  std::vector<afps::combat::ProjectileState> projectiles_;
+  // Steps player movement and pose history in parallel chunks of players.
+  WorkPool movement_pool_;
+  // Connection ids are resolved to entity slots once per tick; per-player components below are
+  // indexed by slot and sized to entities_.capacity().
+  afps::entity::EntityRegistry entities_;
+  std::vector<uint32_t> entity_hashes_;
+  std::vector<InputCmd> last_inputs_;
+  std::vector<uint8_t> has_last_input_;
+  // Received inputs wait here until played; tick_inputs_ holds the ones played this tick.
+  std::vector<InputJitterBuffer> input_buffers_;
+  std::vector<std::vector<InputCmd>> tick_inputs_;
+  std::vector<afps::sim::PlayerState> players_;
+  std::vector<int> last_input_seq_;
+  std::vector<int> last_input_server_tick_;
+  std::vector<SnapshotHistory> snapshot_histories_;
+  std::vector<PlayerWeaponState> weapon_states_;
+  std::vector<uint32_t> loadout_bits_;
+  std::vector<afps::combat::PoseHistory> pose_histories_;
+  std::vector<afps::combat::CombatState> combat_states_;
+  std::vector<uint8_t> pickup_sync_sent_;
+  // Shot trace recipients already sent to; only the marked entries are cleared after each shot.
+  std::vector<uint8_t> trace_sent_;
+  // Per-recipient FX queues for the current tick. Cleared rather than rebuilt so their buffers
+  // carry over between ticks.
+  std::vector<std::vector<FxEventData>> fx_events_;
+  std::vector<std::vector<FxEventData>> reliable_decal_events_;
+  // Per-tick scratch for Step(), reused the same way.
+  struct FireEvent;
+  struct PendingHitscanShot;
+  struct ShockwaveEvent;
+  std::vector<afps::entity::EntitySlot> active_slots_;
+  std::vector<afps::entity::EntitySlot> joined_slots_;
+  std::vector<afps::entity::EntitySlot> released_slots_;
+  std::vector<size_t> interest_matches_;
+  std::vector<size_t> broadphase_matches_;
+  std::vector<afps::entity::EntitySlot> nearby_targets_;
+  std::vector<FireEvent> fire_events_;
+  std::vector<PendingHitscanShot> pending_hitscan_shots_;
+  std::vector<ShockwaveEvent> shockwave_events_;
+  std::vector<size_t> active_rank_;
+  std::vector<uint8_t> near_subjects_;
+  std::vector<SnapshotHistory::SentState> subject_baselines_;
+  std::vector<SnapshotHistory::SentState> sent_states_;
+  // Encoded snapshot entries for the current snapshot, indexed like its states.
+  struct SnapshotEntryCache {
+    struct Delta {
+      int base_tick = 0;
+      EncodedSnapshotEntry entry;
+    };
+    bool keyframe_ready = false;
+    bool keyframe_due = false;
+    EncodedSnapshotEntry keyframe;
+    std::vector<Delta> deltas;
+    size_t delta_count = 0;
+  };
+  // One entry picked for a recipient; keyframes use kKeyframePickTick so they sort last.
+  struct SnapshotPick {
+    int base_tick = 0;
+    size_t state = 0;
+    const EncodedSnapshotEntry *entry = nullptr;
+  };
+  static constexpr int kKeyframePickTick = std::numeric_limits<int>::min();
+  std::vector<SnapshotEntryCache> snapshot_entry_cache_;
+  std::vector<SnapshotPick> snapshot_picks_;
+  std::vector<const EncodedSnapshotEntry *> recipient_entries_;
+  afps::combat::ProjectilePool projectiles_;
   std::vector<PickupState> pickups_;
-  std::unordered_set<std::string> pickup_sync_sent_;
-  int next_projectile_id_ = 1;
   uint32_t map_seed_ = 0;
   afps::world::MapWorldOptions map_options_{};
+  bool interest_occlusion_ = false;
+  afps::interest::SpatialGrid interest_grid_;
   afps::sim::CollisionWorld collision_world_;
   std::vector<afps::world::StaticMeshInstance> static_mesh_instances_;
   std::unordered_map<int, uint32_t> collider_instance_lookup_;
   afps::world::CollisionMeshRegistry collision_mesh_registry_{};
-  std::unordered_map<std::string, size_t> collision_mesh_prefab_lookup_;
+  afps::world::StaticMeshTlas static_mesh_tlas_;
   bool collision_mesh_registry_loaded_ = false;
   afps::sim::SimConfig sim_config_ = afps::sim::kDefaultSimConfig;
   afps::weapons::WeaponConfig weapon_config_ = afps::weapons::BuildDefaultWeaponConfig();
@@ -124,8 +206,11 @@ private:
   int pose_history_limit_ = 0;
   size_t batch_count_ = 0;
   size_t input_count_ = 0;
+  size_t input_underrun_count_ = 0;
+  size_t input_catch_up_count_ = 0;
   size_t snapshot_count_ = 0;
   size_t tick_count_ = 0;
+  double last_flush_ms_ = 0.0;
   TickAccumulator::Clock::time_point last_log_time_{};
 };
 #endif
@@ -0,0 +1,113 @@
+#include "tick_scheduler.h"
+
+#include <algorithm>
+
+TickScheduler::TickScheduler(size_t worker_count) : worker_count_(worker_count) {}
+
+TickScheduler::~TickScheduler() {
+  Stop();
+}
+
+size_t TickScheduler::AddTask(Task task, Clock::duration period, Clock::time_point first_deadline) {
+  std::scoped_lock lock(mutex_);
+  if (running_ || !workers_.empty()) {
+    return entries_.size();
+  }
+  const size_t index = entries_.size();
+  entries_.push_back({std::move(task), period, {}});
+  queue_.push({first_deadline, index});
+  return index;
+}
+
+void TickScheduler::Start() {
+  std::scoped_lock lock(mutex_);
+  if (running_ || entries_.empty()) {
+    return;
+  }
+  if (worker_count_ == 0) {
+    worker_count_ = DefaultWorkerCount(entries_.size());
+  }
+  running_ = true;
+  workers_.reserve(worker_count_);
+  for (size_t i = 0; i < worker_count_; ++i) {
+    workers_.emplace_back(&TickScheduler::WorkerLoop, this);
+  }
+}
+
+void TickScheduler::Stop() {
+  {
+    std::scoped_lock lock(mutex_);
+    if (!running_) {
+      return;
+    }
+    running_ = false;
+  }
+  cv_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+  workers_.clear();
+}
+
+TickTaskMetrics TickScheduler::Metrics(size_t task) const {
+  std::scoped_lock lock(mutex_);
+  if (task >= entries_.size()) {
+    return {};
+  }
+  return entries_[task].metrics;
+}
+
+size_t TickScheduler::task_count() const {
+  std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+
+size_t TickScheduler::worker_count() const {
+  std::scoped_lock lock(mutex_);
+  return worker_count_;
+}
+
+size_t TickScheduler::DefaultWorkerCount(size_t task_count) {
+  const size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+  return std::max<size_t>(1, std::min(cores, task_count));
+}
+
+void TickScheduler::WorkerLoop() {
+  std::unique_lock lock(mutex_);
+  while (running_) {
+    if (queue_.empty()) {
+      cv_.wait(lock);
+      continue;
+    }
+    const Deadline next = queue_.top();
+    if (Clock::now() < next.first) {
+      cv_.wait_until(lock, next.first);
+      continue;
+    }
+    queue_.pop();
+    Entry &entry = entries_[next.second];
+    lock.unlock();
+
+    const auto start = Clock::now();
+    const auto next_deadline = entry.task(start);
+    const auto end = Clock::now();
+
+    lock.lock();
+    using Millis = std::chrono::duration<double, std::milli>;
+    const double run_ms = Millis(end - start).count();
+    const double lateness_ms = Millis(start - next.first).count();
+    TickTaskMetrics &metrics = entry.metrics;
+    metrics.runs += 1;
+    if (start - next.first > entry.period) {
+      metrics.late_runs += 1;
+    }
+    metrics.last_run_ms = run_ms;
+    metrics.max_run_ms = std::max(metrics.max_run_ms, run_ms);
+    metrics.avg_run_ms += (run_ms - metrics.avg_run_ms) / static_cast<double>(metrics.runs);
+    metrics.max_lateness_ms = std::max(metrics.max_lateness_ms, lateness_ms);
+    queue_.push({next_deadline, next.second});
+    cv_.notify_one();
+  }
+}
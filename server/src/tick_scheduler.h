@@ -0,0 +1,64 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct TickTaskMetrics {
+  uint64_t runs = 0;
+  // Runs that started more than one period after their deadline.
+  uint64_t late_runs = 0;
+  double last_run_ms = 0.0;
+  double max_run_ms = 0.0;
+  double avg_run_ms = 0.0;
+  double max_lateness_ms = 0.0;
+};
+
+// Runs periodic tasks on a fixed pool of worker threads, earliest deadline first.
+// A task is queued at most once, so it never runs on two workers at the same time.
+class TickScheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+  // Does the work due at now and returns the task's next deadline.
+  using Task = std::function<Clock::time_point(Clock::time_point now)>;
+
+  explicit TickScheduler(size_t worker_count = 0);
+  ~TickScheduler();
+
+  // Tasks can only be added before Start.
+  size_t AddTask(Task task, Clock::duration period, Clock::time_point first_deadline);
+  void Start();
+  void Stop();
+
+  TickTaskMetrics Metrics(size_t task) const;
+  size_t task_count() const;
+  size_t worker_count() const;
+
+  // One worker per core, but never more workers than tasks.
+  static size_t DefaultWorkerCount(size_t task_count);
+
+private:
+  struct Entry {
+    Task task;
+    Clock::duration period{};
+    TickTaskMetrics metrics;
+  };
+  using Deadline = std::pair<Clock::time_point, size_t>;
+
+  void WorkerLoop();
+
+  size_t worker_count_ = 0;
+  std::vector<Entry> entries_;
+  std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> queue_;
+  std::vector<std::thread> workers_;
+  bool running_ = false;
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+};
@@ -16,10 +16,17 @@ std::string UsageText(const char *argv0) {
   out << "  --turn-secret <secret> TURN REST shared secret (enables time-limited credentials)\n";
   out << "  --turn-user <user> TURN REST username suffix (default afps)\n";
   out << "  --turn-ttl <seconds> TURN REST credential TTL (default 3600)\n";
-  out << "  --snapshot-keyframe-interval <n> Keyframe interval in snapshots (default 5, 0=all)\n";
+  out << "  --snapshot-keyframe-interval <n> Keyframe every n snapshots (default 5, 0/1=no deltas)\n";
+  out << "  --interest-occlusion Send occluded nearby players at the far snapshot rate\n";
   out << "  --map-seed <n> Deterministic procedural map seed (default 0)\n";
   out << "  --map-mode <legacy|static> Authoritative map mode (default legacy)\n";
   out << "  --map-manifest <path> Static map manifest JSON path (required for --map-mode static)\n";
+  out << "  --rooms <n>     Number of match rooms, seeded from --map-seed upward (default 1)\n";
+  out << "  --room <id[:seed[:mode]]> Add a room with its own map seed and mode (repeatable)\n";
+  out << "  --room-capacity <n> Max connections per room (default 0=unlimited)\n";
+  out << "  --tick-workers <n> Tick worker threads (default 0=one per core, capped at room count)\n";
+  out << "  --movement-workers <n> Threads stepping each room's player movement (default 0=cores per tick worker)\n";
+  out << "  --send-workers <n> Threads sending DataChannel bundles off the tick threads (default 0=one per 8 cores)\n";
   out << "  --dump-map-signature Print deterministic map collider/pickup signature JSON and exit\n";
   out << "  --character-manifest <path> Character manifest JSON for allowlisting character ids\n";
   out << "  --http          Disable TLS (local development only)\n";
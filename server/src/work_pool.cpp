@@ -0,0 +1,102 @@
+#include "work_pool.h"
+
+#include <algorithm>
+
+WorkPool::WorkPool(size_t participants)
+    : participant_count_(std::max<size_t>(1, participants)), shares_(new Share[participant_count_]) {
+  workers_.reserve(participant_count_ - 1);
+  for (size_t i = 1; i < participant_count_; ++i) {
+    workers_.emplace_back(&WorkPool::WorkerLoop, this, i);
+  }
+}
+
+WorkPool::~WorkPool() {
+  {
+    std::scoped_lock lock(mutex_);
+    stopping_ = true;
+  }
+  start_cv_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void WorkPool::Run(size_t count, size_t chunk, RangeFn fn, void *context) {
+  if (count == 0) {
+    return;
+  }
+  const size_t safe_chunk = std::max<size_t>(1, chunk);
+  if (workers_.empty() || count <= safe_chunk) {
+    for (size_t begin = 0; begin < count; begin += safe_chunk) {
+      fn(context, begin, std::min(count, begin + safe_chunk));
+    }
+    return;
+  }
+
+  // Shares are whole chunks so every chunk starts at a multiple of safe_chunk.
+  const size_t chunk_count = (count + safe_chunk - 1) / safe_chunk;
+  const size_t share_size = ((chunk_count + participant_count_ - 1) / participant_count_) * safe_chunk;
+  {
+    std::scoped_lock lock(mutex_);
+    for (size_t i = 0; i < participant_count_; ++i) {
+      const size_t begin = std::min(count, i * share_size);
+      shares_[i].next.store(begin, std::memory_order_relaxed);
+      shares_[i].end = std::min(count, begin + share_size);
+    }
+    fn_ = fn;
+    context_ = context;
+    chunk_ = safe_chunk;
+    pending_ = workers_.size();
+    generation_ += 1;
+  }
+  start_cv_.notify_all();
+  Drain(0);
+
+  std::unique_lock lock(mutex_);
+  done_cv_.wait(lock, [this] { return pending_ == 0; });
+  fn_ = nullptr;
+  context_ = nullptr;
+}
+
+size_t WorkPool::participant_count() const {
+  return participant_count_;
+}
+
+size_t WorkPool::DefaultParticipantCount(size_t tick_workers) {
+  const size_t cores = std::max<size_t>(1, std::thread::hardware_concurrency());
+  return std::max<size_t>(1, cores / std::max<size_t>(1, tick_workers));
+}
+
+void WorkPool::WorkerLoop(size_t participant) {
+  uint64_t seen_generation = 0;
+  std::unique_lock lock(mutex_);
+  while (true) {
+    start_cv_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+    if (stopping_) {
+      return;
+    }
+    seen_generation = generation_;
+    lock.unlock();
+    Drain(participant);
+    lock.lock();
+    pending_ -= 1;
+    if (pending_ == 0) {
+      done_cv_.notify_one();
+    }
+  }
+}
+
+void WorkPool::Drain(size_t participant) {
+  for (size_t offset = 0; offset < participant_count_; ++offset) {
+    Share &share = shares_[(participant + offset) % participant_count_];
+    while (true) {
+      const size_t begin = share.next.fetch_add(chunk_, std::memory_order_relaxed);
+      if (begin >= share.end) {
+        break;
+      }
+      fn_(context_, begin, std::min(share.end, begin + chunk_));
+    }
+  }
+}
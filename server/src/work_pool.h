@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Runs one index range at a time across a fixed set of threads; the calling thread takes part.
+// Each participant starts on its own contiguous share of the range and claims it chunk by chunk,
+// then steals chunks from the other shares. Chunk boundaries depend only on the count, chunk size
+// and participant count, so callers whose chunks write disjoint state get the same result as a
+// serial loop however the chunks were scheduled.
+class WorkPool {
+public:
+  // participants counts the calling thread, so 1 runs everything inline.
+  explicit WorkPool(size_t participants = 1);
+  ~WorkPool();
+  WorkPool(const WorkPool &) = delete;
+  WorkPool &operator=(const WorkPool &) = delete;
+
+  // Calls task(begin, end) over [0, count) in chunks of at most chunk indices and returns once
+  // all have run. task is called by reference, never copied, so no call allocates. Must not be
+  // called concurrently with itself.
+  template <typename Task>
+  void ParallelFor(size_t count, size_t chunk, Task &&task) {
+    using TaskType = std::remove_reference_t<Task>;
+    Run(count, chunk,
+        [](void *context, size_t begin, size_t end) { (*static_cast<TaskType *>(context))(begin, end); },
+        const_cast<void *>(static_cast<const void *>(&task)));
+  }
+  size_t participant_count() const;
+
+  // Cores left over after one per tick worker, shared evenly; at least 1.
+  static size_t DefaultParticipantCount(size_t tick_workers);
+
+private:
+  using RangeFn = void (*)(void *context, size_t begin, size_t end);
+
+  struct Share {
+    std::atomic<size_t> next{0};
+    size_t end = 0;
+  };
+
+  void Run(size_t count, size_t chunk, RangeFn fn, void *context);
+  void WorkerLoop(size_t participant);
+  void Drain(size_t participant);
+
+  size_t participant_count_ = 1;
+  std::unique_ptr<Share[]> shares_;
+  RangeFn fn_ = nullptr;
+  void *context_ = nullptr;
+  size_t chunk_ = 1;
+  uint64_t generation_ = 0;
+  size_t pending_ = 0;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+};
@@ -5,20 +5,111 @@
 #include <cctype>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <limits>
+#include <numeric>
 #include <string>
+#include <type_traits>
 #include <unordered_set>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <nlohmann/json.hpp>
 
+#include "ray_kernels.h"
+
 namespace afps::world {
 namespace {
 constexpr const char *kDefaultCollisionMeshPath = "shared/data/collision_meshes_v1.json";
 constexpr uint64_t kFnvOffsetBasis = 1469598103934665603ull;
 constexpr uint64_t kFnvPrime = 1099511628211ull;
-constexpr uint32_t kBvhLeafTriangleCount = 8;
+// Prefab BVH build: SAH leaves stop paying off past a few triangles, and the depth caps keep
+// every path within the fixed traversal stack (median splits past kBvhSahMaxDepth halve the
+// range, so the forced leaves at kBvhMaxDepth stay within the uint16_t count).
+constexpr uint32_t kBvhMaxLeafTriangles = 8;
+constexpr uint32_t kBvhMaxLeafCount = std::numeric_limits<uint16_t>::max();
+constexpr uint32_t kBvhSahBinCount = 12;
+constexpr double kBvhTraversalCost = 1.0;
+constexpr uint32_t kBvhSahMaxDepth = 32;
+constexpr uint32_t kBvhMaxDepth = 56;
+constexpr size_t kBvhTraversalStackSize = 64;
+static_assert(kBvhMaxDepth < kBvhTraversalStackSize, "BVH depth must fit the traversal stack");
+constexpr char kBinaryMagic[8] = {'A', 'F', 'P', 'S', 'C', 'M', 'B', '\0'};
+constexpr uint32_t kBinaryFormatVersion = 2;
+constexpr uint32_t kBinaryEndianMarker = 0x01020304u;
+constexpr uint64_t kBinarySectionAlignment = 64;
+
+// Binary registry layout (host byte order, checked via endian_marker). Every section starts on a
+// kBinarySectionAlignment boundary so the mapped arrays can be used in place:
+//   BinaryHeader | BinaryPrefab[prefab_count] | strings | float vertices[9][triangle_count]
+//   | uint32_t indices[index_count] | BvhNode nodes[node_count]
+struct BinaryHeader {
+  char magic[8];
+  uint32_t format_version;
+  uint32_t endian_marker;
+  uint32_t registry_version;
+  uint32_t prefab_count;
+  uint64_t checksum;
+  uint64_t source_hash;
+  uint64_t file_size;
+  uint32_t triangle_count;
+  uint32_t index_count;
+  uint32_t node_count;
+  uint32_t node_size;
+  uint32_t string_size;
+  uint32_t source_asset_pack_size;
+  uint64_t prefabs_offset;
+  uint64_t strings_offset;
+  uint64_t vertices_offset;
+  uint64_t indices_offset;
+  uint64_t nodes_offset;
+};
+
+struct BinaryPrefab {
+  CollisionMeshBounds bounds;
+  uint32_t id_offset;
+  uint32_t id_size;
+  uint32_t triangle_first;
+  uint32_t triangle_count;
+  uint32_t index_first;
+  uint32_t index_count;
+  uint32_t node_first;
+  uint32_t node_count;
+  uint32_t declared_triangle_count;
+  uint8_t surface_type;
+  uint8_t has_explicit_triangles;
+  uint8_t reserved[2];
+};
+
+static_assert(std::is_trivially_copyable<BinaryHeader>::value, "BinaryHeader must be trivially copyable");
+static_assert(std::is_trivially_copyable<BinaryPrefab>::value, "BinaryPrefab must be trivially copyable");
+static_assert(std::is_trivially_copyable<CollisionMeshPrefab::BvhNode>::value,
+              "BvhNode must be trivially copyable");
+
+struct OwnedGeometry {
+  std::vector<float> vertices;
+  std::vector<uint32_t> indices;
+  std::vector<CollisionMeshPrefab::BvhNode> nodes;
+};
+
+class MappedFile {
+public:
+  MappedFile(void *data, size_t size) : data_(data), size_(size) {}
+  ~MappedFile() {
+    ::munmap(data_, size_);
+  }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+private:
+  void *data_;
+  size_t size_;
+};
 
 std::string NormalizePrefabId(std::string value) {
   std::transform(value.begin(), value.end(), value.begin(), [](unsigned char ch) {
@@ -71,107 +162,177 @@ bool ParseBounds(const nlohmann::json &value, CollisionMeshBounds &out) {
   return true;
 }
 
-CollisionMeshBounds BoundsFromTriangle(const CollisionMeshPrefab::Triangle &triangle) {
-  CollisionMeshBounds bounds;
-  bounds.min_x = std::min({triangle.v0_x, triangle.v1_x, triangle.v2_x});
-  bounds.max_x = std::max({triangle.v0_x, triangle.v1_x, triangle.v2_x});
-  bounds.min_y = std::min({triangle.v0_y, triangle.v1_y, triangle.v2_y});
-  bounds.max_y = std::max({triangle.v0_y, triangle.v1_y, triangle.v2_y});
-  bounds.min_z = std::min({triangle.v0_z, triangle.v1_z, triangle.v2_z});
-  bounds.max_z = std::max({triangle.v0_z, triangle.v1_z, triangle.v2_z});
-  return bounds;
-}
-
-CollisionMeshBounds UnionBounds(const CollisionMeshBounds &a, const CollisionMeshBounds &b) {
-  CollisionMeshBounds out;
-  out.min_x = std::min(a.min_x, b.min_x);
-  out.max_x = std::max(a.max_x, b.max_x);
-  out.min_y = std::min(a.min_y, b.min_y);
-  out.max_y = std::max(a.max_y, b.max_y);
-  out.min_z = std::min(a.min_z, b.min_z);
-  out.max_z = std::max(a.max_z, b.max_z);
-  return out;
-}
-
-std::array<double, 3> TriangleCentroid(const CollisionMeshPrefab::Triangle &triangle) {
-  return {(triangle.v0_x + triangle.v1_x + triangle.v2_x) / 3.0,
-          (triangle.v0_y + triangle.v1_y + triangle.v2_y) / 3.0,
-          (triangle.v0_z + triangle.v1_z + triangle.v2_z) / 3.0};
-}
-
-CollisionMeshBounds ComputeBoundsForRange(const CollisionMeshPrefab &prefab,
-                                          uint32_t begin,
-                                          uint32_t end) {
-  CollisionMeshBounds bounds{};
-  bool initialized = false;
-  for (uint32_t i = begin; i < end; ++i) {
-    if (i >= prefab.triangle_indices.size()) {
-      break;
+// Triangle bounds and centroids for the SAH build. Vertices are already float32, so every
+// bound is exactly representable in the float node.
+struct BvhBuildBounds {
+  std::array<double, 3> min{{std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+                             std::numeric_limits<double>::infinity()}};
+  std::array<double, 3> max{{-std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(),
+                             -std::numeric_limits<double>::infinity()}};
+
+  void Grow(const BvhBuildBounds &other) {
+    for (int axis = 0; axis < 3; ++axis) {
+      min[axis] = std::min(min[axis], other.min[axis]);
+      max[axis] = std::max(max[axis], other.max[axis]);
     }
-    const uint32_t triangle_index = prefab.triangle_indices[i];
-    if (triangle_index >= prefab.triangles.size()) {
-      continue;
+  }
+
+  void Grow(const std::array<double, 3> &point) {
+    for (int axis = 0; axis < 3; ++axis) {
+      min[axis] = std::min(min[axis], point[axis]);
+      max[axis] = std::max(max[axis], point[axis]);
     }
-    const CollisionMeshBounds tri_bounds = BoundsFromTriangle(prefab.triangles[triangle_index]);
-    if (!initialized) {
-      bounds = tri_bounds;
-      initialized = true;
-    } else {
-      bounds = UnionBounds(bounds, tri_bounds);
+  }
+
+  double HalfArea() const {
+    const double dx = max[0] - min[0];
+    const double dy = max[1] - min[1];
+    const double dz = max[2] - min[2];
+    if (!(dx >= 0.0 && dy >= 0.0 && dz >= 0.0)) {
+      return 0.0;
     }
+    return dx * dy + dy * dz + dz * dx;
   }
-  return bounds;
-}
+};
 
-uint32_t BuildBvhRecursive(CollisionMeshPrefab &prefab, uint32_t begin, uint32_t end) {
-  CollisionMeshPrefab::BvhNode node;
-  node.begin = begin;
-  node.end = end;
-  node.leaf = true;
-  node.bounds = ComputeBoundsForRange(prefab, begin, end);
+struct BvhBuilder {
+  CollisionMeshPrefabGeometry &prefab;
+  std::vector<BvhBuildBounds> triangle_bounds;
+  std::vector<std::array<double, 3>> centroids;
+};
 
+uint32_t SahBin(double centroid, double min_centroid, double scale) {
+  const double bin = (centroid - min_centroid) * scale;
+  if (!(bin > 0.0)) {
+    return 0;
+  }
+  return std::min(kBvhSahBinCount - 1, static_cast<uint32_t>(bin));
+}
+
+void BuildBvhNode(BvhBuilder &builder, uint32_t begin, uint32_t end, uint32_t depth) {
+  auto &prefab = builder.prefab;
   const uint32_t node_index = static_cast<uint32_t>(prefab.bvh_nodes.size());
-  prefab.bvh_nodes.push_back(node);
-  const uint32_t count = end > begin ? end - begin : 0;
-  if (count <= kBvhLeafTriangleCount) {
-    return node_index;
-  }
-
-  const double ext_x = node.bounds.max_x - node.bounds.min_x;
-  const double ext_y = node.bounds.max_y - node.bounds.min_y;
-  const double ext_z = node.bounds.max_z - node.bounds.min_z;
-  int axis = 0;
-  if (ext_y > ext_x && ext_y >= ext_z) {
-    axis = 1;
-  } else if (ext_z > ext_x && ext_z > ext_y) {
-    axis = 2;
-  }
-
-  const uint32_t mid = begin + (count / 2);
-  std::nth_element(
-      prefab.triangle_indices.begin() + begin,
-      prefab.triangle_indices.begin() + mid,
-      prefab.triangle_indices.begin() + end,
-      [&](uint32_t lhs_index, uint32_t rhs_index) {
-        const auto lhs = TriangleCentroid(prefab.triangles[lhs_index]);
-        const auto rhs = TriangleCentroid(prefab.triangles[rhs_index]);
-        return lhs[axis] < rhs[axis];
-      });
+  prefab.bvh_nodes.emplace_back();
+
+  BvhBuildBounds bounds;
+  BvhBuildBounds centroid_bounds;
+  for (uint32_t i = begin; i < end; ++i) {
+    const uint32_t triangle_index = prefab.triangle_indices[i];
+    bounds.Grow(builder.triangle_bounds[triangle_index]);
+    centroid_bounds.Grow(builder.centroids[triangle_index]);
+  }
+  {
+    auto &node = prefab.bvh_nodes[node_index];
+    node.min_x = static_cast<float>(bounds.min[0]);
+    node.min_y = static_cast<float>(bounds.min[1]);
+    node.min_z = static_cast<float>(bounds.min[2]);
+    node.max_x = static_cast<float>(bounds.max[0]);
+    node.max_y = static_cast<float>(bounds.max[1]);
+    node.max_z = static_cast<float>(bounds.max[2]);
+  }
+
+  const uint32_t count = end - begin;
+  auto make_leaf = [&]() {
+    auto &node = prefab.bvh_nodes[node_index];
+    node.offset = begin;
+    node.count = static_cast<uint16_t>(count);
+  };
+  if (count <= 1 || (depth >= kBvhMaxDepth && count <= kBvhMaxLeafCount)) {
+    make_leaf();
+    return;
+  }
 
+  // Binned SAH over the centroid extent of each axis; cost is in units of triangle tests.
+  int best_axis = -1;
+  uint32_t best_bin = 0;
+  double best_cost = static_cast<double>(count);
+  const double parent_area = bounds.HalfArea();
+  if (depth < kBvhSahMaxDepth && parent_area > 0.0) {
+    for (int axis = 0; axis < 3; ++axis) {
+      const double extent = centroid_bounds.max[axis] - centroid_bounds.min[axis];
+      if (!(extent > 0.0)) {
+        continue;
+      }
+      const double scale = static_cast<double>(kBvhSahBinCount) / extent;
+      std::array<BvhBuildBounds, kBvhSahBinCount> bin_bounds{};
+      std::array<uint32_t, kBvhSahBinCount> bin_counts{};
+      for (uint32_t i = begin; i < end; ++i) {
+        const uint32_t triangle_index = prefab.triangle_indices[i];
+        const uint32_t bin = SahBin(builder.centroids[triangle_index][axis], centroid_bounds.min[axis], scale);
+        bin_bounds[bin].Grow(builder.triangle_bounds[triangle_index]);
+        bin_counts[bin] += 1;
+      }
+
+      std::array<double, kBvhSahBinCount> right_cost{};
+      BvhBuildBounds right;
+      uint32_t right_count = 0;
+      for (uint32_t bin = kBvhSahBinCount - 1; bin > 0; --bin) {
+        right.Grow(bin_bounds[bin]);
+        right_count += bin_counts[bin];
+        right_cost[bin - 1] = right_count > 0 ? right.HalfArea() * right_count : 0.0;
+      }
+      BvhBuildBounds left;
+      uint32_t left_count = 0;
+      for (uint32_t bin = 0; bin + 1 < kBvhSahBinCount; ++bin) {
+        left.Grow(bin_bounds[bin]);
+        left_count += bin_counts[bin];
+        if (left_count == 0 || left_count == count) {
+          continue;
+        }
+        const double cost = kBvhTraversalCost + (left.HalfArea() * left_count + right_cost[bin]) / parent_area;
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_axis = axis;
+          best_bin = bin;
+        }
+      }
+    }
+  }
+
+  uint32_t mid = begin;
+  auto indices_begin = prefab.triangle_indices.begin();
+  if (best_axis >= 0) {
+    const double scale =
+        static_cast<double>(kBvhSahBinCount) / (centroid_bounds.max[best_axis] - centroid_bounds.min[best_axis]);
+    const double min_centroid = centroid_bounds.min[best_axis];
+    mid = static_cast<uint32_t>(
+        std::partition(indices_begin + begin, indices_begin + end,
+                       [&](uint32_t triangle_index) {
+                         return SahBin(builder.centroids[triangle_index][best_axis], min_centroid, scale) <=
+                                best_bin;
+                       }) -
+        indices_begin);
+  }
   if (mid == begin || mid == end) {
-    return node_index;
+    if (count <= kBvhMaxLeafTriangles) {
+      make_leaf();
+      return;
+    }
+    // SAH found nothing cheaper than a leaf (or the centroids coincide) but the leaf would be
+    // too large, so fall back to a median split along the widest centroid axis.
+    best_axis = 0;
+    for (int axis = 1; axis < 3; ++axis) {
+      if (centroid_bounds.max[axis] - centroid_bounds.min[axis] >
+          centroid_bounds.max[best_axis] - centroid_bounds.min[best_axis]) {
+        best_axis = axis;
+      }
+    }
+    mid = begin + count / 2;
+    std::nth_element(indices_begin + begin, indices_begin + mid, indices_begin + end,
+                     [&](uint32_t lhs_index, uint32_t rhs_index) {
+                       const double lhs = builder.centroids[lhs_index][best_axis];
+                       const double rhs = builder.centroids[rhs_index][best_axis];
+                       return lhs < rhs || (lhs == rhs && lhs_index < rhs_index);
+                     });
   }
 
-  const uint32_t left = BuildBvhRecursive(prefab, begin, mid);
-  const uint32_t right = BuildBvhRecursive(prefab, mid, end);
-  auto &stored = prefab.bvh_nodes[node_index];
-  stored.left = left;
-  stored.right = right;
-  stored.leaf = false;
-  return node_index;
+  prefab.bvh_nodes[node_index].axis = static_cast<uint16_t>(best_axis);
+  BuildBvhNode(builder, begin, mid, depth + 1);
+  prefab.bvh_nodes[node_index].offset = static_cast<uint32_t>(prefab.bvh_nodes.size());
+  BuildBvhNode(builder, mid, end, depth + 1);
 }
 
-void BuildPrefabBvh(CollisionMeshPrefab &prefab) {
+void BuildPrefabBvh(CollisionMeshPrefabGeometry &prefab) {
   prefab.bvh_nodes.clear();
   prefab.triangle_indices.clear();
   prefab.triangle_indices.reserve(prefab.triangles.size());
@@ -181,7 +342,22 @@ void BuildPrefabBvh(CollisionMeshPrefab &prefab) {
   if (prefab.triangle_indices.empty()) {
     return;
   }
-  BuildBvhRecursive(prefab, 0, static_cast<uint32_t>(prefab.triangle_indices.size()));
+
+  BvhBuilder builder{prefab, {}, {}};
+  builder.triangle_bounds.resize(prefab.triangles.size());
+  builder.centroids.resize(prefab.triangles.size());
+  for (size_t i = 0; i < prefab.triangles.size(); ++i) {
+    const auto &tri = prefab.triangles[i];
+    auto &bounds = builder.triangle_bounds[i];
+    bounds.Grow(std::array<double, 3>{{tri.v0_x, tri.v0_y, tri.v0_z}});
+    bounds.Grow(std::array<double, 3>{{tri.v1_x, tri.v1_y, tri.v1_z}});
+    bounds.Grow(std::array<double, 3>{{tri.v2_x, tri.v2_y, tri.v2_z}});
+    for (int axis = 0; axis < 3; ++axis) {
+      builder.centroids[i][axis] = (bounds.min[axis] + bounds.max[axis]) * 0.5;
+    }
+  }
+  prefab.bvh_nodes.reserve(prefab.triangles.size());
+  BuildBvhNode(builder, 0, static_cast<uint32_t>(prefab.triangle_indices.size()), 0);
 }
 
 void AddBoxTriangles(std::vector<CollisionMeshPrefab::Triangle> &triangles,
@@ -299,6 +475,246 @@ int64_t QuantizeMilli(double value) {
   }
   return static_cast<int64_t>(std::llround(value * 1000.0));
 }
+
+// Registries store vertices as float32, so round before building the BVH to keep node bounds
+// exact for the stored triangles.
+void RoundTrianglesToFloat(std::vector<CollisionMeshPrefab::Triangle> &triangles) {
+  auto round = [](double value) { return static_cast<double>(static_cast<float>(value)); };
+  for (auto &tri : triangles) {
+    tri.v0_x = round(tri.v0_x);
+    tri.v0_y = round(tri.v0_y);
+    tri.v0_z = round(tri.v0_z);
+    tri.v1_x = round(tri.v1_x);
+    tri.v1_y = round(tri.v1_y);
+    tri.v1_z = round(tri.v1_z);
+    tri.v2_x = round(tri.v2_x);
+    tri.v2_y = round(tri.v2_y);
+    tri.v2_z = round(tri.v2_z);
+  }
+}
+
+void BindPrefabGeometry(CollisionMeshPrefab &prefab,
+                        const BinaryPrefab &ranges,
+                        const float *vertices,
+                        size_t total_triangles,
+                        const uint32_t *indices,
+                        const CollisionMeshPrefab::BvhNode *nodes) {
+  std::array<const float *, CollisionMeshPrefab::Triangles::kComponentCount> components{};
+  for (size_t c = 0; c < components.size(); ++c) {
+    components[c] = vertices + c * total_triangles + ranges.triangle_first;
+  }
+  prefab.triangles = CollisionMeshPrefab::Triangles(components, ranges.triangle_count);
+  prefab.triangle_indices = CollisionMeshView<uint32_t>(indices + ranges.index_first, ranges.index_count);
+  prefab.bvh_nodes = CollisionMeshView<CollisionMeshPrefab::BvhNode>(nodes + ranges.node_first, ranges.node_count);
+}
+
+uint64_t AlignSection(uint64_t offset) {
+  return (offset + kBinarySectionAlignment - 1) / kBinarySectionAlignment * kBinarySectionAlignment;
+}
+
+bool SectionFits(uint64_t offset, uint64_t bytes, uint64_t file_size) {
+  return offset % kBinarySectionAlignment == 0 && offset <= file_size && bytes <= file_size - offset;
+}
+
+bool HasBinaryMagic(const std::string &path) {
+  std::ifstream input(path, std::ios::binary);
+  char magic[sizeof(kBinaryMagic)] = {};
+  return input.read(magic, sizeof(magic)) && std::memcmp(magic, kBinaryMagic, sizeof(magic)) == 0;
+}
+
+bool ValidateBinaryHeader(const BinaryHeader &header, uint64_t file_size, std::string &error) {
+  if (std::memcmp(header.magic, kBinaryMagic, sizeof(kBinaryMagic)) != 0) {
+    error = "collision mesh binary registry has bad magic";
+    return false;
+  }
+  if (header.format_version != kBinaryFormatVersion) {
+    error = "collision mesh binary registry format " + std::to_string(header.format_version) +
+            " unsupported (expected " + std::to_string(kBinaryFormatVersion) + ")";
+    return false;
+  }
+  if (header.endian_marker != kBinaryEndianMarker || header.node_size != sizeof(CollisionMeshPrefab::BvhNode)) {
+    error = "collision mesh binary registry was written for a different platform layout";
+    return false;
+  }
+  if (header.file_size != file_size) {
+    error = "collision mesh binary registry size mismatch";
+    return false;
+  }
+  const uint64_t vertex_bytes = static_cast<uint64_t>(header.triangle_count) *
+                                CollisionMeshPrefab::Triangles::kComponentCount * sizeof(float);
+  if (!SectionFits(header.prefabs_offset, static_cast<uint64_t>(header.prefab_count) * sizeof(BinaryPrefab),
+                   file_size) ||
+      !SectionFits(header.strings_offset, header.string_size, file_size) ||
+      !SectionFits(header.vertices_offset, vertex_bytes, file_size) ||
+      !SectionFits(header.indices_offset, static_cast<uint64_t>(header.index_count) * sizeof(uint32_t),
+                   file_size) ||
+      !SectionFits(header.nodes_offset,
+                   static_cast<uint64_t>(header.node_count) * sizeof(CollisionMeshPrefab::BvhNode), file_size) ||
+      header.source_asset_pack_size > header.string_size) {
+    error = "collision mesh binary registry section out of bounds";
+    return false;
+  }
+  return true;
+}
+
+bool ReadBinaryHeader(const std::string &path, BinaryHeader &header, std::string &error) {
+  std::error_code ec;
+  const uintmax_t file_size = std::filesystem::file_size(path, ec);
+  std::ifstream input(path, std::ios::binary);
+  if (ec || !input.is_open()) {
+    error = "collision mesh registry not found: " + path;
+    return false;
+  }
+  if (!input.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+    error = "collision mesh binary registry truncated: " + path;
+    return false;
+  }
+  return ValidateBinaryHeader(header, file_size, error);
+}
+
+bool LoadCollisionMeshRegistryBinary(const std::string &path,
+                                     CollisionMeshRegistry &out,
+                                     std::string &error) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    error = "collision mesh registry not found: " + path;
+    return false;
+  }
+  struct stat info {};
+  if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(BinaryHeader))) {
+    ::close(fd);
+    error = "collision mesh binary registry truncated: " + path;
+    return false;
+  }
+  const size_t file_size = static_cast<size_t>(info.st_size);
+  void *data = ::mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    error = "collision mesh binary registry mmap failed: " + path;
+    return false;
+  }
+  auto mapping = std::make_shared<MappedFile>(data, file_size);
+  const auto *bytes = static_cast<const uint8_t *>(data);
+
+  BinaryHeader header;
+  std::memcpy(&header, bytes, sizeof(header));
+  if (!ValidateBinaryHeader(header, file_size, error)) {
+    return false;
+  }
+
+  const char *strings = reinterpret_cast<const char *>(bytes + header.strings_offset);
+  const auto *vertices = reinterpret_cast<const float *>(bytes + header.vertices_offset);
+  const auto *indices = reinterpret_cast<const uint32_t *>(bytes + header.indices_offset);
+  const auto *nodes = reinterpret_cast<const CollisionMeshPrefab::BvhNode *>(bytes + header.nodes_offset);
+
+  out.version = header.registry_version;
+  out.source_asset_pack.assign(strings, header.source_asset_pack_size);
+  out.prefabs.resize(header.prefab_count);
+  for (uint32_t i = 0; i < header.prefab_count; ++i) {
+    BinaryPrefab ranges;
+    std::memcpy(&ranges, bytes + header.prefabs_offset + i * sizeof(BinaryPrefab), sizeof(ranges));
+    if (static_cast<uint64_t>(ranges.id_offset) + ranges.id_size > header.string_size ||
+        static_cast<uint64_t>(ranges.triangle_first) + ranges.triangle_count > header.triangle_count ||
+        static_cast<uint64_t>(ranges.index_first) + ranges.index_count > header.index_count ||
+        static_cast<uint64_t>(ranges.node_first) + ranges.node_count > header.node_count) {
+      out = {};
+      error = "collision mesh binary registry prefab " + std::to_string(i) + " out of bounds";
+      return false;
+    }
+    CollisionMeshPrefab &prefab = out.prefabs[i];
+    prefab.id.assign(strings + ranges.id_offset, ranges.id_size);
+    prefab.triangle_count = ranges.declared_triangle_count;
+    prefab.surface_type = ranges.surface_type;
+    prefab.has_explicit_triangles = ranges.has_explicit_triangles != 0;
+    prefab.bounds = ranges.bounds;
+    BindPrefabGeometry(prefab, ranges, vertices, header.triangle_count, indices, nodes);
+  }
+  out.storage = std::move(mapping);
+
+  if (out.prefabs.empty()) {
+    out = {};
+    error = "collision mesh registry has no valid prefab entries";
+    return false;
+  }
+  return true;
+}
+
+using Vec3 = afps::sim::Vec3;
+
+Vec3 Sub(const Vec3 &a, const Vec3 &b) {
+  return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+double Dot(const Vec3 &a, const Vec3 &b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+Vec3 Cross(const Vec3 &a, const Vec3 &b) {
+  return {a.y * b.z - a.z * b.y,
+          a.z * b.x - a.x * b.z,
+          a.x * b.y - a.y * b.x};
+}
+
+Vec3 Normalize(const Vec3 &v) {
+  const double len = std::sqrt(Dot(v, v));
+  if (!std::isfinite(len) || len <= 1e-8) {
+    return {0.0, -1.0, 0.0};
+  }
+  return {v.x / len, v.y / len, v.z / len};
+}
+
+double RaycastNodeBounds(const Vec3 &origin, const Vec3 &dir, const CollisionMeshPrefab::BvhNode &node) {
+  const double inf = std::numeric_limits<double>::infinity();
+  const double epsilon = 1e-8;
+  double t_min = -inf;
+  double t_max = inf;
+  auto update_axis = [&](double o, double d, double min_bound, double max_bound) -> bool {
+    if (std::abs(d) < epsilon) {
+      return o >= min_bound && o <= max_bound;
+    }
+    double t1 = (min_bound - o) / d;
+    double t2 = (max_bound - o) / d;
+    if (t1 > t2) {
+      std::swap(t1, t2);
+    }
+    t_min = std::max(t_min, t1);
+    t_max = std::min(t_max, t2);
+    return t_min <= t_max;
+  };
+  if (!update_axis(origin.x, dir.x, node.min_x, node.max_x) ||
+      !update_axis(origin.y, dir.y, node.min_y, node.max_y) ||
+      !update_axis(origin.z, dir.z, node.min_z, node.max_z)) {
+    return inf;
+  }
+  if (t_max < 0.0) {
+    return inf;
+  }
+  // Entry distance, clamped to 0 when the origin is inside: the exit distance would cull nodes
+  // that still hold hits closer than the current best.
+  return std::max(t_min, 0.0);
+}
+
+Vec3 TriangleNormal(const CollisionMeshPrefab::Triangle &triangle) {
+  const Vec3 v0{triangle.v0_x, triangle.v0_y, triangle.v0_z};
+  const Vec3 v1{triangle.v1_x, triangle.v1_y, triangle.v1_z};
+  const Vec3 v2{triangle.v2_x, triangle.v2_y, triangle.v2_z};
+  return Normalize(Cross(Sub(v1, v0), Sub(v2, v0)));
+}
+
+void LoadTriangleLane(const CollisionMeshPrefab::Triangles &triangles,
+                      uint32_t triangle_index,
+                      afps::combat::TriangleLanes &lanes,
+                      size_t lane) {
+  lanes.v0_x[lane] = triangles.component(0)[triangle_index];
+  lanes.v0_y[lane] = triangles.component(1)[triangle_index];
+  lanes.v0_z[lane] = triangles.component(2)[triangle_index];
+  lanes.v1_x[lane] = triangles.component(3)[triangle_index];
+  lanes.v1_y[lane] = triangles.component(4)[triangle_index];
+  lanes.v1_z[lane] = triangles.component(5)[triangle_index];
+  lanes.v2_x[lane] = triangles.component(6)[triangle_index];
+  lanes.v2_y[lane] = triangles.component(7)[triangle_index];
+  lanes.v2_z[lane] = triangles.component(8)[triangle_index];
+}
 }  // namespace
 
 std::string ResolveCollisionMeshRegistryPath() {
@@ -313,19 +729,64 @@ std::string ResolveCollisionMeshRegistryPath() {
       "../../" + std::string(kDefaultCollisionMeshPath),
   };
   for (const auto &candidate : candidates) {
-    if (std::filesystem::exists(candidate)) {
+    if (std::filesystem::exists(candidate) || std::filesystem::exists(ResolveCollisionMeshBinaryPath(candidate))) {
       return candidate;
     }
   }
   return kDefaultCollisionMeshPath;
 }
 
-bool LoadCollisionMeshRegistry(const std::string &path,
-                               CollisionMeshRegistry &out,
-                               std::string &error) {
-  out = {};
-  error.clear();
+std::string ResolveCollisionMeshBinaryPath(const std::string &json_path) {
+  return std::filesystem::path(json_path).replace_extension(".bin").string();
+}
+
+void AttachCollisionMeshGeometry(CollisionMeshRegistry &registry,
+                                 const std::vector<CollisionMeshPrefabGeometry> &geometry) {
+  auto owned = std::make_shared<OwnedGeometry>();
+  std::vector<BinaryPrefab> ranges(registry.prefabs.size());
+  size_t total_triangles = 0;
+  size_t total_indices = 0;
+  size_t total_nodes = 0;
+  for (size_t i = 0; i < ranges.size() && i < geometry.size(); ++i) {
+    ranges[i].triangle_first = static_cast<uint32_t>(total_triangles);
+    ranges[i].triangle_count = static_cast<uint32_t>(geometry[i].triangles.size());
+    ranges[i].index_first = static_cast<uint32_t>(total_indices);
+    ranges[i].index_count = static_cast<uint32_t>(geometry[i].triangle_indices.size());
+    ranges[i].node_first = static_cast<uint32_t>(total_nodes);
+    ranges[i].node_count = static_cast<uint32_t>(geometry[i].bvh_nodes.size());
+    total_triangles += geometry[i].triangles.size();
+    total_indices += geometry[i].triangle_indices.size();
+    total_nodes += geometry[i].bvh_nodes.size();
+  }
+
+  owned->vertices.resize(total_triangles * CollisionMeshPrefab::Triangles::kComponentCount);
+  owned->indices.reserve(total_indices);
+  owned->nodes.reserve(total_nodes);
+  for (size_t i = 0; i < ranges.size() && i < geometry.size(); ++i) {
+    for (size_t t = 0; t < geometry[i].triangles.size(); ++t) {
+      const auto &tri = geometry[i].triangles[t];
+      const double components[] = {tri.v0_x, tri.v0_y, tri.v0_z, tri.v1_x, tri.v1_y,
+                                   tri.v1_z, tri.v2_x, tri.v2_y, tri.v2_z};
+      for (size_t c = 0; c < CollisionMeshPrefab::Triangles::kComponentCount; ++c) {
+        owned->vertices[c * total_triangles + ranges[i].triangle_first + t] = static_cast<float>(components[c]);
+      }
+    }
+    owned->indices.insert(owned->indices.end(), geometry[i].triangle_indices.begin(),
+                          geometry[i].triangle_indices.end());
+    owned->nodes.insert(owned->nodes.end(), geometry[i].bvh_nodes.begin(), geometry[i].bvh_nodes.end());
+  }
 
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    BindPrefabGeometry(registry.prefabs[i], ranges[i], owned->vertices.data(), total_triangles,
+                       owned->indices.data(), owned->nodes.data());
+  }
+  registry.storage = std::move(owned);
+}
+
+namespace {
+bool LoadCollisionMeshRegistryJson(const std::string &path,
+                                   CollisionMeshRegistry &out,
+                                   std::string &error) {
   std::ifstream input(path);
   if (!input.is_open()) {
     error = "collision mesh registry not found: " + path;
@@ -361,6 +822,8 @@ bool LoadCollisionMeshRegistry(const std::string &path,
   }
 
   std::unordered_set<std::string> seen_ids;
+  std::vector<CollisionMeshPrefab> prefabs;
+  std::vector<CollisionMeshPrefabGeometry> geometry;
   for (const auto &entry : root.at("prefabs")) {
     if (!entry.is_object()) {
       continue;
@@ -390,14 +853,12 @@ bool LoadCollisionMeshRegistry(const std::string &path,
       continue;
     }
 
-    std::vector<CollisionMeshPrefab::Triangle> triangles;
+    CollisionMeshPrefabGeometry prefab_geometry;
     const bool parsed_triangles =
-        entry.contains("triangles") && ParseTriangles(entry.at("triangles"), triangles);
+        entry.contains("triangles") && ParseTriangles(entry.at("triangles"), prefab_geometry.triangles);
     prefab.has_explicit_triangles = parsed_triangles;
-    if (parsed_triangles) {
-      prefab.triangles = std::move(triangles);
-    } else {
-      AddBoxTriangles(prefab.triangles,
+    if (!parsed_triangles) {
+      AddBoxTriangles(prefab_geometry.triangles,
                       prefab.bounds.min_x,
                       prefab.bounds.min_y,
                       prefab.bounds.min_z,
@@ -405,32 +866,223 @@ bool LoadCollisionMeshRegistry(const std::string &path,
                       prefab.bounds.max_y,
                       prefab.bounds.max_z);
     }
-    prefab.triangle_count = static_cast<uint32_t>(prefab.triangles.size());
-    BuildPrefabBvh(prefab);
-    if (prefab.bvh_nodes.empty() || prefab.triangle_indices.empty()) {
+    RoundTrianglesToFloat(prefab_geometry.triangles);
+    prefab.triangle_count = static_cast<uint32_t>(prefab_geometry.triangles.size());
+    BuildPrefabBvh(prefab_geometry);
+    if (prefab_geometry.bvh_nodes.empty() || prefab_geometry.triangle_indices.empty()) {
       continue;
     }
 
     if (!seen_ids.insert(prefab.id).second) {
       continue;
     }
-    out.prefabs.push_back(prefab);
+    prefabs.push_back(std::move(prefab));
+    geometry.push_back(std::move(prefab_geometry));
   }
 
-  if (out.prefabs.empty()) {
+  if (prefabs.empty()) {
     error = "collision mesh registry has no valid prefab entries";
     return false;
   }
 
-  std::sort(out.prefabs.begin(), out.prefabs.end(), [](const CollisionMeshPrefab &a, const CollisionMeshPrefab &b) {
-    return a.id < b.id;
-  });
+  std::vector<size_t> order(prefabs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return prefabs[a].id < prefabs[b].id; });
+  std::vector<CollisionMeshPrefabGeometry> sorted_geometry;
+  sorted_geometry.reserve(order.size());
+  out.prefabs.reserve(order.size());
+  for (const size_t index : order) {
+    out.prefabs.push_back(std::move(prefabs[index]));
+    sorted_geometry.push_back(std::move(geometry[index]));
+  }
+  AttachCollisionMeshGeometry(out, sorted_geometry);
 
   return true;
 }
+}  // namespace
+
+bool LoadCollisionMeshRegistry(const std::string &path,
+                               CollisionMeshRegistry &out,
+                               std::string &error) {
+  out = {};
+  error.clear();
+  if (HasBinaryMagic(path)) {
+    return LoadCollisionMeshRegistryBinary(path, out, error);
+  }
+  return LoadCollisionMeshRegistryJson(path, out, error);
+}
 
 bool LoadCollisionMeshRegistry(CollisionMeshRegistry &out, std::string &error) {
-  return LoadCollisionMeshRegistry(ResolveCollisionMeshRegistryPath(), out, error);
+  const std::string path = ResolveCollisionMeshRegistryPath();
+  const std::string binary_path = ResolveCollisionMeshBinaryPath(path);
+  if (binary_path != path && IsCollisionMeshBinaryCurrent(binary_path, path) &&
+      LoadCollisionMeshRegistry(binary_path, out, error)) {
+    return true;
+  }
+  return LoadCollisionMeshRegistry(path, out, error);
+}
+
+bool HashCollisionMeshSourceFile(const std::string &path, uint64_t &out, std::string &error) {
+  std::ifstream input(path, std::ios::binary);
+  if (!input.is_open()) {
+    error = "collision mesh registry not found: " + path;
+    return false;
+  }
+  uint64_t hash = kFnvOffsetBasis;
+  std::array<char, 1 << 16> buffer{};
+  while (input) {
+    input.read(buffer.data(), buffer.size());
+    const std::streamsize count = input.gcount();
+    for (std::streamsize i = 0; i < count; ++i) {
+      hash = HashByte(hash, static_cast<uint8_t>(buffer[static_cast<size_t>(i)]));
+    }
+  }
+  out = hash;
+  return true;
+}
+
+bool ReadCollisionMeshBinaryInfo(const std::string &path, CollisionMeshBinaryInfo &out, std::string &error) {
+  BinaryHeader header;
+  if (!ReadBinaryHeader(path, header, error)) {
+    return false;
+  }
+  out.format_version = header.format_version;
+  out.registry_version = header.registry_version;
+  out.prefab_count = header.prefab_count;
+  out.triangle_count = header.triangle_count;
+  out.checksum = header.checksum;
+  out.source_hash = header.source_hash;
+  out.file_size = header.file_size;
+  return true;
+}
+
+bool WriteCollisionMeshRegistryBinary(const CollisionMeshRegistry &registry,
+                                      uint64_t source_hash,
+                                      const std::string &path,
+                                      std::string &error) {
+  BinaryHeader header{};
+  std::memcpy(header.magic, kBinaryMagic, sizeof(kBinaryMagic));
+  header.format_version = kBinaryFormatVersion;
+  header.endian_marker = kBinaryEndianMarker;
+  header.registry_version = registry.version;
+  header.prefab_count = static_cast<uint32_t>(registry.prefabs.size());
+  header.checksum = ComputeCollisionMeshRegistryChecksum(registry);
+  header.source_hash = source_hash;
+  header.node_size = sizeof(CollisionMeshPrefab::BvhNode);
+
+  std::string strings = registry.source_asset_pack;
+  header.source_asset_pack_size = static_cast<uint32_t>(strings.size());
+  std::vector<BinaryPrefab> prefabs(registry.prefabs.size());
+  for (size_t i = 0; i < registry.prefabs.size(); ++i) {
+    const auto &prefab = registry.prefabs[i];
+    BinaryPrefab &entry = prefabs[i];
+    entry.bounds = prefab.bounds;
+    entry.id_offset = static_cast<uint32_t>(strings.size());
+    entry.id_size = static_cast<uint32_t>(prefab.id.size());
+    strings += prefab.id;
+    entry.triangle_first = header.triangle_count;
+    entry.triangle_count = static_cast<uint32_t>(prefab.triangles.size());
+    entry.index_first = header.index_count;
+    entry.index_count = static_cast<uint32_t>(prefab.triangle_indices.size());
+    entry.node_first = header.node_count;
+    entry.node_count = static_cast<uint32_t>(prefab.bvh_nodes.size());
+    entry.declared_triangle_count = prefab.triangle_count;
+    entry.surface_type = prefab.surface_type;
+    entry.has_explicit_triangles = prefab.has_explicit_triangles ? 1 : 0;
+    header.triangle_count += entry.triangle_count;
+    header.index_count += entry.index_count;
+    header.node_count += entry.node_count;
+  }
+  header.string_size = static_cast<uint32_t>(strings.size());
+
+  header.prefabs_offset = AlignSection(sizeof(BinaryHeader));
+  header.strings_offset = AlignSection(header.prefabs_offset + prefabs.size() * sizeof(BinaryPrefab));
+  header.vertices_offset = AlignSection(header.strings_offset + strings.size());
+  header.indices_offset = AlignSection(header.vertices_offset + static_cast<uint64_t>(header.triangle_count) *
+                                                                    CollisionMeshPrefab::Triangles::kComponentCount *
+                                                                    sizeof(float));
+  header.nodes_offset = AlignSection(header.indices_offset + static_cast<uint64_t>(header.index_count) *
+                                                                 sizeof(uint32_t));
+  header.file_size = header.nodes_offset +
+                     static_cast<uint64_t>(header.node_count) * sizeof(CollisionMeshPrefab::BvhNode);
+
+  std::vector<uint8_t> buffer(header.file_size, 0);
+  std::memcpy(buffer.data(), &header, sizeof(header));
+  if (!prefabs.empty()) {
+    std::memcpy(buffer.data() + header.prefabs_offset, prefabs.data(), prefabs.size() * sizeof(BinaryPrefab));
+  }
+  std::memcpy(buffer.data() + header.strings_offset, strings.data(), strings.size());
+  auto *vertices = reinterpret_cast<float *>(buffer.data() + header.vertices_offset);
+  auto *indices = reinterpret_cast<uint32_t *>(buffer.data() + header.indices_offset);
+  uint8_t *nodes = buffer.data() + header.nodes_offset;
+  for (size_t i = 0; i < registry.prefabs.size(); ++i) {
+    const auto &prefab = registry.prefabs[i];
+    for (size_t c = 0; c < CollisionMeshPrefab::Triangles::kComponentCount; ++c) {
+      if (!prefab.triangles.empty()) {
+        std::memcpy(vertices + c * header.triangle_count + prefabs[i].triangle_first,
+                    prefab.triangles.component(c), prefab.triangles.size() * sizeof(float));
+      }
+    }
+    if (!prefab.triangle_indices.empty()) {
+      std::memcpy(indices + prefabs[i].index_first, prefab.triangle_indices.data(),
+                  prefab.triangle_indices.size() * sizeof(uint32_t));
+    }
+    if (!prefab.bvh_nodes.empty()) {
+      // BvhNode has no padding, so the nodes can be copied as-is.
+      std::memcpy(nodes + prefabs[i].node_first * sizeof(CollisionMeshPrefab::BvhNode), prefab.bvh_nodes.data(),
+                  prefab.bvh_nodes.size() * sizeof(CollisionMeshPrefab::BvhNode));
+    }
+  }
+
+  // Write beside the target and rename so concurrent readers never map a partial file.
+  const std::string temp_path = path + ".tmp";
+  {
+    std::ofstream output(temp_path, std::ios::binary | std::ios::trunc);
+    if (!output.is_open()) {
+      error = "unable to write collision mesh binary registry: " + temp_path;
+      return false;
+    }
+    output.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    if (!output) {
+      error = "unable to write collision mesh binary registry: " + temp_path;
+      return false;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(temp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    error = "unable to move collision mesh binary registry into place: " + path;
+    return false;
+  }
+  return true;
+}
+
+bool IsCollisionMeshBinaryCurrent(const std::string &binary_path, const std::string &source_path) {
+  CollisionMeshBinaryInfo info;
+  std::string error;
+  if (!ReadCollisionMeshBinaryInfo(binary_path, info, error)) {
+    return false;
+  }
+  if (!std::filesystem::exists(source_path)) {
+    return true;
+  }
+  uint64_t source_hash = 0;
+  return HashCollisionMeshSourceFile(source_path, source_hash, error) && source_hash == info.source_hash;
+}
+
+bool PackCollisionMeshRegistry(const std::string &source_path,
+                               const std::string &binary_path,
+                               std::string &error) {
+  uint64_t source_hash = 0;
+  if (!HashCollisionMeshSourceFile(source_path, source_hash, error)) {
+    return false;
+  }
+  CollisionMeshRegistry registry;
+  if (!LoadCollisionMeshRegistry(source_path, registry, error)) {
+    return false;
+  }
+  return WriteCollisionMeshRegistryBinary(registry, source_hash, binary_path, error);
 }
 
 std::vector<std::string> FindMissingCollisionMeshPrefabs(
@@ -486,7 +1138,8 @@ uint64_t ComputeCollisionMeshRegistryChecksum(const CollisionMeshRegistry &regis
     hash = HashInt64(hash, QuantizeMilli(prefab.bounds.max_y));
     hash = HashInt64(hash, QuantizeMilli(prefab.bounds.max_z));
     hash = HashInt64(hash, static_cast<int64_t>(prefab.triangles.size()));
-    for (const auto &triangle : prefab.triangles) {
+    for (size_t i = 0; i < prefab.triangles.size(); ++i) {
+      const auto triangle = prefab.triangles[i];
       hash = HashInt64(hash, QuantizeMilli(triangle.v0_x));
       hash = HashInt64(hash, QuantizeMilli(triangle.v0_y));
       hash = HashInt64(hash, QuantizeMilli(triangle.v0_z));
@@ -501,4 +1154,94 @@ uint64_t ComputeCollisionMeshRegistryChecksum(const CollisionMeshRegistry &regis
   return hash;
 }
 
+bool RaycastCollisionMeshPrefab(const CollisionMeshPrefab &prefab,
+                                const afps::sim::Vec3 &origin,
+                                const afps::sim::Vec3 &dir,
+                                double max_distance,
+                                CollisionMeshRayHit &out) {
+  if (prefab.bvh_nodes.empty() || prefab.triangle_indices.empty() || prefab.triangles.empty()) {
+    return false;
+  }
+  double best_t = max_distance;
+  uint32_t best_triangle = 0;
+  Vec3 best_normal{};
+  bool hit = false;
+
+  // Depth-first walk with a fixed stack: descend into the child on the ray's near side of the
+  // split and defer the far one, so best_t shrinks early and prunes more of the far subtrees.
+  const bool dir_negative[3] = {dir.x < 0.0, dir.y < 0.0, dir.z < 0.0};
+  const uint32_t node_count = static_cast<uint32_t>(prefab.bvh_nodes.size());
+  const uint32_t index_count = static_cast<uint32_t>(prefab.triangle_indices.size());
+  std::array<uint32_t, kBvhTraversalStackSize> stack;
+  size_t stack_size = 0;
+  uint32_t node_index = 0;
+  const afps::combat::KernelRay ray{{origin.x, origin.y, origin.z}, {dir.x, dir.y, dir.z}};
+  afps::combat::TriangleLanes lanes;
+  uint32_t lane_triangles[afps::combat::kRayKernelLanes] = {};
+  double lane_t[afps::combat::kRayKernelLanes] = {};
+  while (true) {
+    const auto &node = prefab.bvh_nodes[node_index];
+    const double node_t = RaycastNodeBounds(origin, dir, node);
+    if (std::isfinite(node_t) && node_t <= best_t) {
+      if (node.count > 0) {
+        const uint32_t end = static_cast<uint32_t>(
+            std::min<uint64_t>(static_cast<uint64_t>(node.offset) + node.count, index_count));
+        // Triangles go through the ray kernel kRayKernelLanes at a time. Lanes are accepted in
+        // order against the running best, which matches testing them one by one.
+        uint32_t i = node.offset;
+        while (i < end) {
+          size_t lane_count = 0;
+          while (i < end && lane_count < afps::combat::kRayKernelLanes) {
+            const uint32_t triangle_index = prefab.triangle_indices[i++];
+            if (triangle_index >= prefab.triangles.size()) {
+              continue;
+            }
+            LoadTriangleLane(prefab.triangles, triangle_index, lanes, lane_count);
+            lane_triangles[lane_count++] = triangle_index;
+          }
+          uint32_t mask = afps::combat::RaycastTriangleLanes(ray, lanes, lane_count, best_t, lane_t);
+          for (size_t lane = 0; mask != 0; ++lane, mask >>= 1) {
+            if ((mask & 1u) == 0 || lane_t[lane] > best_t) {
+              continue;
+            }
+            const Vec3 normal = TriangleNormal(prefab.triangles[lane_triangles[lane]]);
+            if (!std::isfinite(normal.x) || !std::isfinite(normal.y) || !std::isfinite(normal.z)) {
+              continue;
+            }
+            hit = true;
+            best_t = lane_t[lane];
+            best_triangle = lane_triangles[lane];
+            best_normal = normal;
+          }
+        }
+      } else {
+        uint32_t near_child = node_index + 1;
+        uint32_t far_child = node.offset;
+        if (node.axis < 3 && dir_negative[node.axis]) {
+          std::swap(near_child, far_child);
+        }
+        if (far_child < node_count && stack_size < stack.size()) {
+          stack[stack_size++] = far_child;
+        }
+        if (near_child < node_count) {
+          node_index = near_child;
+          continue;
+        }
+      }
+    }
+    if (stack_size == 0) {
+      break;
+    }
+    node_index = stack[--stack_size];
+  }
+
+  if (!hit) {
+    return false;
+  }
+  out.t = best_t;
+  out.triangle_index = best_triangle;
+  out.normal = best_normal;
+  return true;
+}
+
 }  // namespace afps::world
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "sim/sim.h"
+
 namespace afps::world {
 
 struct CollisionMeshBounds {
@@ -15,6 +20,37 @@ struct CollisionMeshBounds {
   double max_z = 0.0;
 };
 
+// Read-only view over registry-owned or memory-mapped storage.
+template <typename T>
+class CollisionMeshView {
+public:
+  CollisionMeshView() = default;
+  CollisionMeshView(const T *data, size_t size) : data_(data), size_(size) {}
+
+  const T &operator[](size_t index) const {
+    return data_[index];
+  }
+  const T *begin() const {
+    return data_;
+  }
+  const T *end() const {
+    return data_ + size_;
+  }
+  const T *data() const {
+    return data_;
+  }
+  size_t size() const {
+    return size_;
+  }
+  bool empty() const {
+    return size_ == 0;
+  }
+
+private:
+  const T *data_ = nullptr;
+  size_t size_ = 0;
+};
+
 struct CollisionMeshPrefab {
   struct Triangle {
     double v0_x = 0.0;
@@ -28,13 +64,49 @@ struct CollisionMeshPrefab {
     double v2_z = 0.0;
   };
 
+  // Nodes are stored depth-first: an inner node (count == 0) has its left child at the next index
+  // and its right child at offset; a leaf covers triangle_indices[offset, offset + count).
   struct BvhNode {
-    CollisionMeshBounds bounds{};
-    uint32_t left = 0;
-    uint32_t right = 0;
-    uint32_t begin = 0;
-    uint32_t end = 0;
-    bool leaf = true;
+    float min_x = 0.0f;
+    float min_y = 0.0f;
+    float min_z = 0.0f;
+    float max_x = 0.0f;
+    float max_y = 0.0f;
+    float max_z = 0.0f;
+    uint32_t offset = 0;
+    uint16_t count = 0;
+    // Split axis of inner nodes; traversal visits the child on the ray's near side first.
+    uint16_t axis = 0;
+  };
+  static_assert(sizeof(BvhNode) == 32, "BvhNode must stay 32 bytes");
+
+  // Float32 vertex components stored as nine parallel arrays (v0_x, v0_y, v0_z, v1_x, ...).
+  class Triangles {
+  public:
+    static constexpr size_t kComponentCount = 9;
+
+    Triangles() = default;
+    Triangles(const std::array<const float *, kComponentCount> &components, size_t size)
+        : components_(components), size_(size) {}
+
+    Triangle operator[](size_t index) const {
+      return {components_[0][index], components_[1][index], components_[2][index],
+              components_[3][index], components_[4][index], components_[5][index],
+              components_[6][index], components_[7][index], components_[8][index]};
+    }
+    const float *component(size_t component) const {
+      return components_[component];
+    }
+    size_t size() const {
+      return size_;
+    }
+    bool empty() const {
+      return size_ == 0;
+    }
+
+  private:
+    std::array<const float *, kComponentCount> components_{};
+    size_t size_ = 0;
   };
 
   std::string id;
@@ -42,29 +114,93 @@ struct CollisionMeshPrefab {
   uint8_t surface_type = 0;
   bool has_explicit_triangles = false;
   CollisionMeshBounds bounds{};
-  std::vector<Triangle> triangles;
-  std::vector<uint32_t> triangle_indices;
-  std::vector<BvhNode> bvh_nodes;
+  Triangles triangles;
+  CollisionMeshView<uint32_t> triangle_indices;
+  CollisionMeshView<BvhNode> bvh_nodes;
 };
 
+// Prefab geometry and BVH views point into storage, which is either owned arrays filled by
+// AttachCollisionMeshGeometry or a read-only mapping of a binary registry. Copies share it.
 struct CollisionMeshRegistry {
   uint32_t version = 0;
   std::string source_asset_pack;
   std::vector<CollisionMeshPrefab> prefabs;
+  std::shared_ptr<const void> storage;
+};
+
+struct CollisionMeshPrefabGeometry {
+  std::vector<CollisionMeshPrefab::Triangle> triangles;
+  std::vector<uint32_t> triangle_indices;
+  std::vector<CollisionMeshPrefab::BvhNode> bvh_nodes;
 };
 
+// Copies geometry[i] into storage owned by the registry (vertices rounded to float32) and points
+// prefabs[i] at it. geometry must have one entry per prefab.
+void AttachCollisionMeshGeometry(CollisionMeshRegistry &registry,
+                                 const std::vector<CollisionMeshPrefabGeometry> &geometry);
+
 std::string ResolveCollisionMeshRegistryPath();
 
+// Binary sidecar for a JSON registry: same path with a .bin extension.
+std::string ResolveCollisionMeshBinaryPath(const std::string &json_path);
+
+// Loads either format; binary registries are recognised by their magic and memory-mapped.
 bool LoadCollisionMeshRegistry(const std::string &path,
                                CollisionMeshRegistry &out,
                                std::string &error);
 
+// Loads the default registry, preferring its binary sidecar while that is current.
 bool LoadCollisionMeshRegistry(CollisionMeshRegistry &out, std::string &error);
 
+// FNV-1a over the raw bytes of a registry source file.
+bool HashCollisionMeshSourceFile(const std::string &path, uint64_t &out, std::string &error);
+
+struct CollisionMeshBinaryInfo {
+  uint32_t format_version = 0;
+  uint32_t registry_version = 0;
+  uint32_t prefab_count = 0;
+  uint32_t triangle_count = 0;
+  uint64_t checksum = 0;
+  uint64_t source_hash = 0;
+  uint64_t file_size = 0;
+};
+
+// Reads and validates only the header; checksum is ComputeCollisionMeshRegistryChecksum of the
+// registry the file was written from.
+bool ReadCollisionMeshBinaryInfo(const std::string &path, CollisionMeshBinaryInfo &out, std::string &error);
+
+bool WriteCollisionMeshRegistryBinary(const CollisionMeshRegistry &registry,
+                                      uint64_t source_hash,
+                                      const std::string &path,
+                                      std::string &error);
+
+// True when binary_path holds a valid binary registry built from the current bytes of
+// source_path, or when source_path does not exist.
+bool IsCollisionMeshBinaryCurrent(const std::string &binary_path, const std::string &source_path);
+
+// Parses source_path and writes its binary form to binary_path.
+bool PackCollisionMeshRegistry(const std::string &source_path,
+                               const std::string &binary_path,
+                               std::string &error);
+
 std::vector<std::string> FindMissingCollisionMeshPrefabs(
     const CollisionMeshRegistry &registry,
     const std::vector<std::string> &required_prefab_ids);
 
 uint64_t ComputeCollisionMeshRegistryChecksum(const CollisionMeshRegistry &registry);
 
+struct CollisionMeshRayHit {
+  double t = 0.0;
+  uint32_t triangle_index = 0;
+  afps::sim::Vec3 normal{};
+};
+
+// Closest triangle hit along a prefab-local ray with t in [0, max_distance]. The normal is the
+// unit triangle normal from its winding, not flipped toward the ray.
+bool RaycastCollisionMeshPrefab(const CollisionMeshPrefab &prefab,
+                                const afps::sim::Vec3 &origin,
+                                const afps::sim::Vec3 &dir,
+                                double max_distance,
+                                CollisionMeshRayHit &out);
+
 }  // namespace afps::world
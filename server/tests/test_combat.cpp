@@ -1,15 +1,18 @@
 #include "doctest.h"
 
 #include "combat.h"
+#include "interest.h"
 #include "sim/sim.h"
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <random>
-#include <unordered_map>
+#include <vector>
 
 using afps::combat::PoseHistory;
 using afps::combat::ResolveHitscan;
+using afps::combat::ResolveHitscanBatch;
 using afps::combat::ResolveProjectileImpact;
 using afps::combat::SanitizeViewAngles;
 using afps::combat::ApplyDamage;
@@ -23,6 +26,18 @@ using afps::combat::ViewAngles;
 using afps::combat::ComputeExplosionDamage;
 using afps::combat::ComputeShockwaveHits;
 using afps::combat::ProjectileState;
+using afps::entity::EntitySlot;
+using afps::entity::kInvalidSlot;
+
+namespace {
+std::vector<EntitySlot> AllSlots(const std::vector<afps::sim::PlayerState> &players) {
+  std::vector<EntitySlot> slots;
+  for (size_t i = 0; i < players.size(); ++i) {
+    slots.push_back(static_cast<EntitySlot>(i));
+  }
+  return slots;
+}
+}  // namespace
 
 TEST_CASE("PoseHistory returns latest sample at or before tick") {
   PoseHistory history(3);
@@ -34,13 +49,88 @@ TEST_CASE("PoseHistory returns latest sample at or before tick") {
   state.x = 3.0;
   history.Push(5, state);
 
-  afps::sim::PlayerState out;
+  afps::combat::RewindPose out;
   CHECK(history.SampleAtOrBefore(4, out));
   CHECK(out.x == doctest::Approx(2.0));
   CHECK(history.SampleAtOrBefore(5, out));
   CHECK(out.x == doctest::Approx(3.0));
 }
 
+TEST_CASE("PoseHistory keeps a fixed window of ticks") {
+  PoseHistory history(4);
+  afps::sim::PlayerState state;
+  for (int tick = 10; tick <= 20; ++tick) {
+    state.x = tick;
+    state.crouched = (tick % 2) == 0;
+    history.Push(tick, state, {0.1 * tick, 0.0});
+  }
+  CHECK(history.size() == 4);
+  CHECK(history.OldestTick() == 17);
+
+  afps::combat::RewindPose out;
+  CHECK_FALSE(history.SampleAtOrBefore(16, out));
+  REQUIRE(history.SampleAtOrBefore(18, out));
+  CHECK(out.x == doctest::Approx(18.0));
+  CHECK(out.crouched);
+  CHECK(out.view.yaw == doctest::Approx(1.8));
+  REQUIRE(history.SampleAtOrBefore(99, out));
+  CHECK(out.x == doctest::Approx(20.0));
+
+  // Ticks older than the window are dropped; a skipped tick falls back to the one before it.
+  state.x = 5.0;
+  history.Push(12, state);
+  CHECK(history.size() == 4);
+  state.x = 22.0;
+  history.Push(22, state);
+  CHECK(history.size() == 3);
+  REQUIRE(history.SampleAtOrBefore(21, out));
+  CHECK(out.x == doctest::Approx(20.0));
+  CHECK(history.OldestTick() == 19);
+
+  history.SetMaxSamples(2);
+  CHECK(history.size() == 1);
+  CHECK_FALSE(history.SampleAtOrBefore(20, out));
+  REQUIRE(history.SampleAtOrBefore(22, out));
+  CHECK(out.x == doctest::Approx(22.0));
+
+  PoseHistory disabled;
+  disabled.Push(1, state);
+  CHECK(disabled.size() == 0);
+  CHECK_FALSE(disabled.SampleAtOrBefore(1, out));
+}
+
+TEST_CASE("PoseHistory interpolates between ticks") {
+  PoseHistory history(8);
+  afps::sim::PlayerState state;
+  state.x = 0.0;
+  state.y = 4.0;
+  history.Push(3, state, {3.0, 0.2});
+  state.x = 2.0;
+  state.y = 8.0;
+  state.shield_active = true;
+  history.Push(4, state, {-3.0, 0.4});
+
+  afps::combat::RewindPose out;
+  REQUIRE(history.SampleAt(3.25, out));
+  CHECK(out.x == doctest::Approx(0.5));
+  CHECK(out.y == doctest::Approx(5.0));
+  CHECK(out.view.pitch == doctest::Approx(0.25));
+  CHECK_FALSE(out.shield_active);
+  // Yaw takes the short way across the +/-pi seam.
+  CHECK(std::abs(out.view.yaw) > 3.0);
+
+  REQUIRE(history.SampleAt(3.75, out));
+  CHECK(out.x == doctest::Approx(1.5));
+  CHECK(out.shield_active);
+
+  REQUIRE(history.SampleAt(4.5, out));
+  CHECK(out.x == doctest::Approx(2.0));
+  REQUIRE(history.SampleAt(3.0, out));
+  CHECK(out.x == doctest::Approx(0.0));
+  CHECK_FALSE(history.SampleAt(2.9, out));
+  CHECK_FALSE(history.SampleAt(std::numeric_limits<double>::quiet_NaN(), out));
+}
+
 TEST_CASE("ViewDirection aligns with yaw/pitch conventions") {
   const auto angles = SanitizeViewAngles(0.0, 0.0);
   const auto dir = ViewDirection(angles);
@@ -136,7 +226,7 @@ TEST_CASE("Shield directionality blocks attacks from the front") {
 }
 
 TEST_CASE("ComputeShockwaveHits applies falloff impulse inside radius") {
-  std::unordered_map<std::string, afps::sim::PlayerState> players;
+  std::vector<afps::sim::PlayerState> players;
   afps::sim::PlayerState self{};
   self.x = 0.0;
   self.y = 0.0;
@@ -149,9 +239,9 @@ TEST_CASE("ComputeShockwaveHits applies falloff impulse inside radius") {
   far.x = 6.0;
   far.y = 0.0;
   far.z = 0.0;
-  players.emplace("self", self);
-  players.emplace("near", near);
-  players.emplace("far", far);
+  players.push_back(self);
+  players.push_back(near);
+  players.push_back(far);
 
   afps::sim::SimConfig config = afps::sim::kDefaultSimConfig;
   config.arena_half_size = 50.0;
@@ -160,9 +250,9 @@ TEST_CASE("ComputeShockwaveHits applies falloff impulse inside radius") {
   config.obstacle_min_y = 0.0;
   config.obstacle_max_y = 0.0;
   const afps::combat::Vec3 center{0.0, 0.0, afps::combat::kPlayerHeight * 0.5};
-  const auto hits = ComputeShockwaveHits(center, 5.0, 10.0, 5.0, config, players, "self");
+  const auto hits = ComputeShockwaveHits(center, 5.0, 10.0, 5.0, config, players, AllSlots(players), 0);
   REQUIRE(hits.size() == 1);
-  CHECK(hits[0].target_id == "near");
+  CHECK(hits[0].target_slot == 1);
   CHECK(hits[0].distance == doctest::Approx(3.0));
   CHECK(hits[0].impulse.x == doctest::Approx(4.0));
   CHECK(hits[0].impulse.y == doctest::Approx(0.0));
@@ -171,7 +261,7 @@ TEST_CASE("ComputeShockwaveHits applies falloff impulse inside radius") {
 }
 
 TEST_CASE("ComputeShockwaveHits respects line of sight") {
-  std::unordered_map<std::string, afps::sim::PlayerState> players;
+  std::vector<afps::sim::PlayerState> players;
   afps::sim::PlayerState self{};
   self.x = 0.0;
   self.y = 0.0;
@@ -180,8 +270,8 @@ TEST_CASE("ComputeShockwaveHits respects line of sight") {
   blocked.x = 3.0;
   blocked.y = 0.0;
   blocked.z = 0.0;
-  players.emplace("self", self);
-  players.emplace("blocked", blocked);
+  players.push_back(self);
+  players.push_back(blocked);
 
   afps::sim::SimConfig config = afps::sim::kDefaultSimConfig;
   config.arena_half_size = 10.0;
@@ -191,7 +281,7 @@ TEST_CASE("ComputeShockwaveHits respects line of sight") {
   config.obstacle_max_y = 1.0;
 
   const afps::combat::Vec3 center{0.0, 0.0, afps::combat::kPlayerHeight * 0.5};
-  const auto hits = ComputeShockwaveHits(center, 6.0, 10.0, 5.0, config, players, "self");
+  const auto hits = ComputeShockwaveHits(center, 6.0, 10.0, 5.0, config, players, AllSlots(players), 0);
   CHECK(hits.empty());
 }
 
@@ -231,15 +321,13 @@ TEST_CASE("ResolveHitscan rewinds target positions") {
   target_state.y = 5.0;
   target.Push(11, target_state);
 
-  std::unordered_map<std::string, PoseHistory> histories;
-  histories.emplace("shooter", shooter);
-  histories.emplace("target", target);
+  std::vector<PoseHistory> histories{shooter, target};
 
-  const auto hit = ResolveHitscan("shooter", histories, 10, {0.0, 0.0}, config, 50.0);
+  const auto hit = ResolveHitscan(0, histories, 10, {0.0, 0.0}, config, 50.0);
   CHECK(hit.hit);
-  CHECK(hit.target_id == "target");
+  CHECK(hit.target_slot == 1);
 
-  const auto miss = ResolveHitscan("shooter", histories, 11, {0.0, 0.0}, config, 50.0);
+  const auto miss = ResolveHitscan(0, histories, 11, {0.0, 0.0}, config, 50.0);
   CHECK_FALSE(miss.hit);
 }
 
@@ -263,11 +351,9 @@ TEST_CASE("ResolveHitscan respects obstacle occlusion") {
   target_state.y = -5.0;
   target.Push(10, target_state);
 
-  std::unordered_map<std::string, PoseHistory> histories;
-  histories.emplace("shooter", shooter);
-  histories.emplace("target", target);
+  std::vector<PoseHistory> histories{shooter, target};
 
-  const auto blocked = ResolveHitscan("shooter", histories, 10, {0.0, 0.0}, config, 50.0);
+  const auto blocked = ResolveHitscan(0, histories, 10, {0.0, 0.0}, config, 50.0);
   CHECK_FALSE(blocked.hit);
 }
 
@@ -291,13 +377,11 @@ TEST_CASE("ResolveHitscan ignores obstacles behind the target") {
   target_state.y = -5.0;
   target.Push(10, target_state);
 
-  std::unordered_map<std::string, PoseHistory> histories;
-  histories.emplace("shooter", shooter);
-  histories.emplace("target", target);
+  std::vector<PoseHistory> histories{shooter, target};
 
-  const auto hit = ResolveHitscan("shooter", histories, 10, {0.0, 0.0}, config, 50.0);
+  const auto hit = ResolveHitscan(0, histories, 10, {0.0, 0.0}, config, 50.0);
   CHECK(hit.hit);
-  CHECK(hit.target_id == "target");
+  CHECK(hit.target_slot == 1);
 }
 
 TEST_CASE("ResolveHitscan misses when target history does not reach rewind tick") {
@@ -316,20 +400,71 @@ TEST_CASE("ResolveHitscan misses when target history does not reach rewind tick"
   target_state.y = -5.0;
   target.Push(20, target_state);
 
-  std::unordered_map<std::string, PoseHistory> histories;
-  histories.emplace("shooter", shooter);
-  histories.emplace("target", target);
+  std::vector<PoseHistory> histories{shooter, target};
 
-  const auto miss = ResolveHitscan("shooter", histories, 10, {0.0, 0.0}, config, 50.0);
+  const auto miss = ResolveHitscan(0, histories, 10, {0.0, 0.0}, config, 50.0);
   CHECK_FALSE(miss.hit);
 }
 
 TEST_CASE("ResolveHitscan returns no hit when shooter is missing") {
-  std::unordered_map<std::string, PoseHistory> histories;
-  const auto miss = ResolveHitscan("missing", histories, 5, {0.0, 0.0}, afps::sim::kDefaultSimConfig, 50.0);
+  std::vector<PoseHistory> histories;
+  const auto miss = ResolveHitscan(kInvalidSlot, histories, 5, {0.0, 0.0}, afps::sim::kDefaultSimConfig, 50.0);
   CHECK_FALSE(miss.hit);
 }
 
+TEST_CASE("ResolveHitscanBatch matches per-shot ResolveHitscan") {
+  afps::sim::SimConfig config = afps::sim::kDefaultSimConfig;
+  config.arena_half_size = 30.0;
+  config.obstacle_min_x = -1.0;
+  config.obstacle_max_x = 1.0;
+  config.obstacle_min_y = -1.0;
+  config.obstacle_max_y = 1.0;
+
+  // Players wander a small area so rewound shots regularly land on someone.
+  std::mt19937 rng(99);
+  std::uniform_real_distribution<double> coord(-8.0, 8.0);
+  std::uniform_real_distribution<double> unit(-1.0, 1.0);
+  std::vector<PoseHistory> histories(10, PoseHistory(8));
+  for (size_t slot = 0; slot < histories.size(); ++slot) {
+    // Slot 3 never spawned and slot 7 only joined on the last tick.
+    if (slot == 3) {
+      continue;
+    }
+    for (int tick = (slot == 7 ? 19 : 12); tick <= 19; ++tick) {
+      afps::sim::PlayerState state;
+      state.x = coord(rng);
+      state.y = coord(rng);
+      state.z = (slot % 2 == 0) ? 0.0 : 0.5;
+      histories[slot].Push(tick, state);
+    }
+  }
+
+  std::vector<afps::combat::HitscanQuery> queries;
+  for (int i = 0; i < 200; ++i) {
+    afps::combat::HitscanQuery query;
+    query.shooter = (i % 11 == 10) ? kInvalidSlot : static_cast<EntitySlot>(i % 10);
+    query.rewind_time = 10 + (i % 10);
+    query.view = {unit(rng) * 3.14159, unit(rng) * 0.3};
+    query.range = (i % 5 == 0) ? 6.0 : 40.0;
+    queries.push_back(query);
+  }
+
+  std::vector<afps::combat::HitResult> results;
+  ResolveHitscanBatch(queries, histories, config, results);
+  REQUIRE(results.size() == queries.size());
+  int hits = 0;
+  for (size_t i = 0; i < queries.size(); ++i) {
+    const auto &query = queries[i];
+    const auto expected =
+        ResolveHitscan(query.shooter, histories, query.rewind_time, query.view, config, query.range);
+    CHECK(results[i].hit == expected.hit);
+    CHECK(results[i].target_slot == expected.target_slot);
+    CHECK(results[i].distance == expected.distance);
+    hits += expected.hit ? 1 : 0;
+  }
+  CHECK(hits > 0);
+}
+
 TEST_CASE("ResolveHitscan respects weapon range") {
   afps::sim::SimConfig config = afps::sim::kDefaultSimConfig;
   config.arena_half_size = 100.0;
@@ -352,16 +487,14 @@ TEST_CASE("ResolveHitscan respects weapon range") {
   target_state.z = 0.0;
   target.Push(1, target_state);
 
-  std::unordered_map<std::string, PoseHistory> histories;
-  histories.emplace("shooter", shooter);
-  histories.emplace("target", target);
+  std::vector<PoseHistory> histories{shooter, target};
 
-  const auto short_range = ResolveHitscan("shooter", histories, 1, {0.0, 0.0}, config, 5.0);
+  const auto short_range = ResolveHitscan(0, histories, 1, {0.0, 0.0}, config, 5.0);
   CHECK_FALSE(short_range.hit);
 
-  const auto long_range = ResolveHitscan("shooter", histories, 1, {0.0, 0.0}, config, 15.0);
+  const auto long_range = ResolveHitscan(0, histories, 1, {0.0, 0.0}, config, 15.0);
   CHECK(long_range.hit);
-  CHECK(long_range.target_id == "target");
+  CHECK(long_range.target_slot == 1);
 }
 
 TEST_CASE("ResolveHitscan selects the closest target") {
@@ -393,14 +526,11 @@ TEST_CASE("ResolveHitscan selects the closest target") {
   far_state.z = 0.0;
   far_target.Push(2, far_state);
 
-  std::unordered_map<std::string, PoseHistory> histories;
-  histories.emplace("shooter", shooter);
-  histories.emplace("near", near_target);
-  histories.emplace("far", far_target);
+  std::vector<PoseHistory> histories{shooter, near_target, far_target};
 
-  const auto hit = ResolveHitscan("shooter", histories, 2, {0.0, 0.0}, config, 50.0);
+  const auto hit = ResolveHitscan(0, histories, 2, {0.0, 0.0}, config, 50.0);
   CHECK(hit.hit);
-  CHECK(hit.target_id == "near");
+  CHECK(hit.target_slot == 1);
 }
 
 TEST_CASE("ResolveHitscan uses rewound target position for hit distance") {
@@ -429,16 +559,14 @@ TEST_CASE("ResolveHitscan uses rewound target position for hit distance") {
   target_state.y = -9.0;
   target.Push(2, target_state);
 
-  std::unordered_map<std::string, PoseHistory> histories;
-  histories.emplace("shooter", shooter);
-  histories.emplace("target", target);
+  std::vector<PoseHistory> histories{shooter, target};
 
-  const auto near_hit = ResolveHitscan("shooter", histories, 1, {0.0, 0.0}, config, 50.0);
+  const auto near_hit = ResolveHitscan(0, histories, 1, {0.0, 0.0}, config, 50.0);
   CHECK(near_hit.hit);
   CHECK(near_hit.distance == doctest::Approx(4.5));
   CHECK(near_hit.position.y == doctest::Approx(-4.5));
 
-  const auto far_hit = ResolveHitscan("shooter", histories, 2, {0.0, 0.0}, config, 50.0);
+  const auto far_hit = ResolveHitscan(0, histories, 2, {0.0, 0.0}, config, 50.0);
   CHECK(far_hit.hit);
   CHECK(far_hit.distance == doctest::Approx(8.5));
   CHECK(far_hit.position.y == doctest::Approx(-8.5));
@@ -478,18 +606,15 @@ TEST_CASE("ResolveHitscan selects target based on rewind tick") {
   b_state.x = 0.0;
   target_b.Push(2, b_state);
 
-  std::unordered_map<std::string, PoseHistory> histories;
-  histories.emplace("shooter", shooter);
-  histories.emplace("a", target_a);
-  histories.emplace("b", target_b);
+  std::vector<PoseHistory> histories{shooter, target_a, target_b};
 
-  const auto hit_tick1 = ResolveHitscan("shooter", histories, 1, {0.0, 0.0}, config, 50.0);
+  const auto hit_tick1 = ResolveHitscan(0, histories, 1, {0.0, 0.0}, config, 50.0);
   CHECK(hit_tick1.hit);
-  CHECK(hit_tick1.target_id == "a");
+  CHECK(hit_tick1.target_slot == 1);
 
-  const auto hit_tick2 = ResolveHitscan("shooter", histories, 2, {0.0, 0.0}, config, 50.0);
+  const auto hit_tick2 = ResolveHitscan(0, histories, 2, {0.0, 0.0}, config, 50.0);
   CHECK(hit_tick2.hit);
-  CHECK(hit_tick2.target_id == "b");
+  CHECK(hit_tick2.target_slot == 2);
 }
 
 TEST_CASE("ResolveHitscan handles non-finite inputs safely") {
@@ -515,9 +640,7 @@ TEST_CASE("ResolveHitscan handles non-finite inputs safely") {
   target_state.z = 0.0;
   target.Push(1, target_state);
 
-  std::unordered_map<std::string, PoseHistory> histories;
-  histories.emplace("shooter", shooter);
-  histories.emplace("target", target);
+  std::vector<PoseHistory> histories{shooter, target};
 
   const double nan = std::numeric_limits<double>::quiet_NaN();
   const double inf = std::numeric_limits<double>::infinity();
@@ -533,9 +656,9 @@ TEST_CASE("ResolveHitscan handles non-finite inputs safely") {
 
   for (const auto &view : angles) {
     for (const auto range : ranges) {
-      const auto hit = ResolveHitscan("shooter", histories, 1, view, config, range);
+      const auto hit = ResolveHitscan(0, histories, 1, view, config, range);
       CHECK(hit.hit);
-      CHECK(hit.target_id == "target");
+      CHECK(hit.target_slot == 1);
       CHECK(std::isfinite(hit.distance));
       CHECK(hit.distance == doctest::Approx(4.5));
       CHECK(std::isfinite(hit.position.x));
@@ -568,9 +691,7 @@ TEST_CASE("ResolveHitscan handles random view inputs safely") {
   target_state.z = 0.0;
   target.Push(1, target_state);
 
-  std::unordered_map<std::string, PoseHistory> histories;
-  histories.emplace("shooter", shooter);
-  histories.emplace("target", target);
+  std::vector<PoseHistory> histories{shooter, target};
 
   std::mt19937 rng(1337);
   std::uniform_real_distribution<double> yaw_dist(-3.1415926535, 3.1415926535);
@@ -580,7 +701,7 @@ TEST_CASE("ResolveHitscan handles random view inputs safely") {
   for (int i = 0; i < 512; ++i) {
     const ViewAngles view{yaw_dist(rng), pitch_dist(rng)};
     const double range = range_dist(rng);
-    const auto hit = ResolveHitscan("shooter", histories, 1, view, config, range);
+    const auto hit = ResolveHitscan(0, histories, 1, view, config, range);
     if (hit.hit) {
       CHECK(std::isfinite(hit.distance));
       CHECK(hit.distance >= 0.0);
@@ -616,14 +737,12 @@ TEST_CASE("ResolveHitscan hits angled target with yaw") {
   target_state.z = 0.0;
   target.Push(1, target_state);
 
-  std::unordered_map<std::string, PoseHistory> histories;
-  histories.emplace("shooter", shooter);
-  histories.emplace("target", target);
+  std::vector<PoseHistory> histories{shooter, target};
 
   const double yaw = std::atan2(target_state.x - shooter_state.x, -(target_state.y - shooter_state.y));
-  const auto hit = ResolveHitscan("shooter", histories, 1, {yaw, 0.0}, config, 50.0);
+  const auto hit = ResolveHitscan(0, histories, 1, {yaw, 0.0}, config, 50.0);
   CHECK(hit.hit);
-  CHECK(hit.target_id == "target");
+  CHECK(hit.target_slot == 1);
 }
 
 TEST_CASE("ResolveHitscan rewinds shooter position") {
@@ -651,15 +770,13 @@ TEST_CASE("ResolveHitscan rewinds shooter position") {
   target.Push(5, target_state);
   target.Push(6, target_state);
 
-  std::unordered_map<std::string, PoseHistory> histories;
-  histories.emplace("shooter", shooter);
-  histories.emplace("target", target);
+  std::vector<PoseHistory> histories{shooter, target};
 
-  const auto rewind_hit = ResolveHitscan("shooter", histories, 5, {0.0, 0.0}, config, 50.0);
+  const auto rewind_hit = ResolveHitscan(0, histories, 5, {0.0, 0.0}, config, 50.0);
   CHECK(rewind_hit.hit);
-  CHECK(rewind_hit.target_id == "target");
+  CHECK(rewind_hit.target_slot == 1);
 
-  const auto moved_miss = ResolveHitscan("shooter", histories, 6, {0.0, 0.0}, config, 50.0);
+  const auto moved_miss = ResolveHitscan(0, histories, 6, {0.0, 0.0}, config, 50.0);
   CHECK_FALSE(moved_miss.hit);
 }
 
@@ -671,12 +788,12 @@ TEST_CASE("ResolveProjectileImpact hits player before world") {
   config.obstacle_min_y = 0.0;
   config.obstacle_max_y = 0.0;
 
-  std::unordered_map<std::string, afps::sim::PlayerState> players;
+  std::vector<afps::sim::PlayerState> players;
   afps::sim::PlayerState target;
   target.x = 0.0;
   target.y = -3.0;
   target.z = 0.0;
-  players.emplace("target", target);
+  players.push_back(target);
 
   ProjectileState projectile;
   projectile.position = {0.0, 0.0, 1.0};
@@ -685,9 +802,9 @@ TEST_CASE("ResolveProjectileImpact hits player before world") {
 
   const afps::combat::Vec3 delta{projectile.velocity.x * 0.5, projectile.velocity.y * 0.5,
                                  projectile.velocity.z * 0.5};
-  const auto impact = ResolveProjectileImpact(projectile, delta, config, players, "owner");
+  const auto impact = ResolveProjectileImpact(projectile, delta, config, players, AllSlots(players), kInvalidSlot);
   CHECK(impact.hit);
-  CHECK(impact.target_id == "target");
+  CHECK(impact.target_slot == 0);
   CHECK_FALSE(impact.hit_world);
 }
 
@@ -699,7 +816,7 @@ TEST_CASE("ResolveProjectileImpact hits arena boundary when no target") {
   config.obstacle_min_y = 0.0;
   config.obstacle_max_y = 0.0;
 
-  std::unordered_map<std::string, afps::sim::PlayerState> players;
+  std::vector<afps::sim::PlayerState> players;
 
   ProjectileState projectile;
   projectile.position = {0.0, 0.0, 1.0};
@@ -708,11 +825,51 @@ TEST_CASE("ResolveProjectileImpact hits arena boundary when no target") {
 
   const afps::combat::Vec3 delta{projectile.velocity.x * 0.5, projectile.velocity.y * 0.5,
                                  projectile.velocity.z * 0.5};
-  const auto impact = ResolveProjectileImpact(projectile, delta, config, players, "owner");
+  const auto impact = ResolveProjectileImpact(projectile, delta, config, players, AllSlots(players), kInvalidSlot);
   CHECK(impact.hit);
   CHECK(impact.hit_world);
 }
 
+TEST_CASE("ResolveProjectileImpact stops the projectile sphere at walls") {
+  afps::sim::SimConfig config = afps::sim::kDefaultSimConfig;
+  config.arena_half_size = 50.0;
+  config.obstacle_min_x = 0.0;
+  config.obstacle_max_x = 0.0;
+  config.obstacle_min_y = 0.0;
+  config.obstacle_max_y = 0.0;
+
+  afps::sim::CollisionWorld world;
+  afps::sim::SetAabbColliders(world, {afps::sim::AabbCollider{1, 4.0, -1.0, 0.0, 5.0, 1.0, 3.0, 1, 0}});
+  std::vector<afps::sim::PlayerState> players;
+
+  ProjectileState projectile;
+  projectile.position = {0.0, 0.0, 1.0};
+  projectile.radius = 0.5;
+  const afps::combat::Vec3 delta{8.0, 0.0, 0.0};
+  const auto impact =
+      ResolveProjectileImpact(projectile, delta, config, players, AllSlots(players), kInvalidSlot, &world);
+  REQUIRE(impact.hit);
+  CHECK(impact.hit_world);
+  CHECK(impact.position.x == doctest::Approx(3.5));
+  CHECK(impact.normal.x == doctest::Approx(-1.0));
+
+  // A fast projectile crossing the whole box in one step still stops in front of it.
+  const afps::combat::Vec3 fast_delta{400.0, 0.0, 0.0};
+  const auto fast =
+      ResolveProjectileImpact(projectile, fast_delta, config, players, AllSlots(players), kInvalidSlot, &world);
+  REQUIRE(fast.hit);
+  CHECK(fast.position.x == doctest::Approx(3.5));
+}
+
+TEST_CASE("ProjectileSubsteps bounds each step length") {
+  CHECK(afps::combat::ProjectileSubsteps({1.0, 0.0, 0.0}, 4.0, 8) == 1);
+  CHECK(afps::combat::ProjectileSubsteps({4.0, 0.0, 0.0}, 4.0, 8) == 1);
+  CHECK(afps::combat::ProjectileSubsteps({0.0, 9.0, 0.0}, 4.0, 8) == 3);
+  CHECK(afps::combat::ProjectileSubsteps({0.0, 0.0, 400.0}, 4.0, 8) == 8);
+  CHECK(afps::combat::ProjectileSubsteps({9.0, 0.0, 0.0}, 0.0, 8) == 1);
+  CHECK(afps::combat::ProjectileSubsteps({std::numeric_limits<double>::infinity(), 0.0, 0.0}, 4.0, 8) == 1);
+}
+
 TEST_CASE("ResolveProjectileImpact rejects non-finite deltas") {
   afps::sim::SimConfig config = afps::sim::kDefaultSimConfig;
   config.arena_half_size = 50.0;
@@ -721,18 +878,20 @@ TEST_CASE("ResolveProjectileImpact rejects non-finite deltas") {
   config.obstacle_min_y = 0.0;
   config.obstacle_max_y = 0.0;
 
-  std::unordered_map<std::string, afps::sim::PlayerState> players;
+  std::vector<afps::sim::PlayerState> players;
   ProjectileState projectile;
   projectile.position = {0.0, 0.0, 1.0};
   projectile.velocity = {0.0, -10.0, 0.0};
   projectile.radius = 0.0;
 
   const afps::combat::Vec3 delta_nan{std::numeric_limits<double>::quiet_NaN(), 0.0, 0.0};
-  const auto miss_nan = ResolveProjectileImpact(projectile, delta_nan, config, players, "owner");
+  const auto miss_nan =
+      ResolveProjectileImpact(projectile, delta_nan, config, players, AllSlots(players), kInvalidSlot);
   CHECK_FALSE(miss_nan.hit);
 
   const afps::combat::Vec3 delta_inf{std::numeric_limits<double>::infinity(), 0.0, 0.0};
-  const auto miss_inf = ResolveProjectileImpact(projectile, delta_inf, config, players, "owner");
+  const auto miss_inf =
+      ResolveProjectileImpact(projectile, delta_inf, config, players, AllSlots(players), kInvalidSlot);
   CHECK_FALSE(miss_inf.hit);
 }
 
@@ -744,12 +903,12 @@ TEST_CASE("ResolveProjectileImpact handles random deltas safely") {
   config.obstacle_min_y = 0.0;
   config.obstacle_max_y = 0.0;
 
-  std::unordered_map<std::string, afps::sim::PlayerState> players;
+  std::vector<afps::sim::PlayerState> players;
   afps::sim::PlayerState target;
   target.x = 0.0;
   target.y = -3.0;
   target.z = 0.0;
-  players.emplace("target", target);
+  players.push_back(target);
 
   ProjectileState projectile;
   projectile.position = {0.0, 0.0, 1.0};
@@ -762,7 +921,7 @@ TEST_CASE("ResolveProjectileImpact handles random deltas safely") {
 
   for (int i = 0; i < 512; ++i) {
     const afps::combat::Vec3 delta{delta_dist(rng), delta_dist(rng), z_dist(rng)};
-    const auto impact = ResolveProjectileImpact(projectile, delta, config, players, "owner");
+    const auto impact = ResolveProjectileImpact(projectile, delta, config, players, AllSlots(players), kInvalidSlot);
     if (impact.hit) {
       CHECK(std::isfinite(impact.t));
       CHECK(impact.t >= 0.0);
@@ -774,32 +933,104 @@ TEST_CASE("ResolveProjectileImpact handles random deltas safely") {
   }
 }
 
+TEST_CASE("Broadphase-narrowed targets match a full scan") {
+  afps::sim::SimConfig config = afps::sim::kDefaultSimConfig;
+  config.arena_half_size = 80.0;
+  config.obstacle_min_x = 0.0;
+  config.obstacle_max_x = 0.0;
+  config.obstacle_min_y = 0.0;
+  config.obstacle_max_y = 0.0;
+
+  std::mt19937 rng(4242);
+  std::uniform_real_distribution<double> pos_dist(-60.0, 60.0);
+  std::uniform_real_distribution<double> z_dist(0.0, 4.0);
+  std::uniform_real_distribution<double> delta_dist(-20.0, 20.0);
+  std::uniform_real_distribution<double> radius_dist(0.0, 12.0);
+
+  std::vector<afps::sim::PlayerState> players(96);
+  afps::interest::SpatialGrid grid;
+  for (size_t i = 0; i < players.size(); ++i) {
+    players[i].x = pos_dist(rng);
+    players[i].y = pos_dist(rng);
+    players[i].z = z_dist(rng);
+    grid.Insert(i, {players[i].x, players[i].y, players[i].z});
+  }
+  const auto all = AllSlots(players);
+  std::vector<size_t> matches;
+  auto nearby = [&](const afps::combat::Vec3 &center, double reach) {
+    matches.clear();
+    grid.Query({center.x, center.y, center.z}, reach + 0.01, matches);
+    std::vector<EntitySlot> slots(matches.begin(), matches.end());
+    std::sort(slots.begin(), slots.end());
+    return slots;
+  };
+
+  for (int i = 0; i < 256; ++i) {
+    ProjectileState projectile;
+    projectile.position = {pos_dist(rng), pos_dist(rng), z_dist(rng)};
+    projectile.radius = radius_dist(rng) * 0.05;
+    const afps::combat::Vec3 delta{delta_dist(rng), delta_dist(rng), delta_dist(rng) * 0.1};
+    const afps::combat::Vec3 sweep_center{projectile.position.x + delta.x * 0.5,
+                                          projectile.position.y + delta.y * 0.5,
+                                          projectile.position.z + delta.z * 0.5};
+    const double sweep_reach = 0.5 * std::sqrt(delta.x * delta.x + delta.y * delta.y + delta.z * delta.z) +
+                               afps::combat::PlayerCollisionReach(config, projectile.radius);
+    const auto full = ResolveProjectileImpact(projectile, delta, config, players, all, kInvalidSlot);
+    const auto narrow = ResolveProjectileImpact(projectile, delta, config, players,
+                                                nearby(sweep_center, sweep_reach), kInvalidSlot);
+    CHECK(narrow.hit == full.hit);
+    CHECK(narrow.target_slot == full.target_slot);
+    CHECK(narrow.t == full.t);
+
+    const afps::combat::Vec3 center{pos_dist(rng), pos_dist(rng), z_dist(rng)};
+    const double radius = radius_dist(rng);
+    const double reach = radius + afps::combat::kPlayerHeight * 0.5;
+    const auto full_explosion = ComputeExplosionDamage(center, radius, 100.0, players, all, kInvalidSlot);
+    const auto narrow_explosion =
+        ComputeExplosionDamage(center, radius, 100.0, players, nearby(center, reach), kInvalidSlot);
+    REQUIRE(narrow_explosion.size() == full_explosion.size());
+    for (size_t h = 0; h < full_explosion.size(); ++h) {
+      CHECK(narrow_explosion[h].target_slot == full_explosion[h].target_slot);
+      CHECK(narrow_explosion[h].damage == full_explosion[h].damage);
+    }
+
+    const auto full_shockwave =
+        ComputeShockwaveHits(center, radius, 10.0, 20.0, config, players, all, kInvalidSlot, nullptr);
+    const auto narrow_shockwave = ComputeShockwaveHits(center, radius, 10.0, 20.0, config, players,
+                                                       nearby(center, reach), kInvalidSlot, nullptr);
+    REQUIRE(narrow_shockwave.size() == full_shockwave.size());
+    for (size_t h = 0; h < full_shockwave.size(); ++h) {
+      CHECK(narrow_shockwave[h].target_slot == full_shockwave[h].target_slot);
+    }
+  }
+}
+
 TEST_CASE("ComputeExplosionDamage applies falloff") {
-  std::unordered_map<std::string, afps::sim::PlayerState> players;
+  std::vector<afps::sim::PlayerState> players;
   afps::sim::PlayerState a;
   a.x = 0.0;
   a.y = 0.0;
   a.z = 0.0;
-  players.emplace("a", a);
+  players.push_back(a);
   afps::sim::PlayerState b;
   b.x = 2.0;
   b.y = 0.0;
   b.z = 0.0;
-  players.emplace("b", b);
+  players.push_back(b);
 
   const double radius = 4.0;
   const double max_damage = 100.0;
   const afps::combat::Vec3 center{0.0, 0.0, afps::combat::kPlayerHeight * 0.5};
-  const auto hits = ComputeExplosionDamage(center, radius, max_damage, players, "");
+  const auto hits = ComputeExplosionDamage(center, radius, max_damage, players, AllSlots(players), kInvalidSlot);
   CHECK(hits.size() == 2);
 
   double damage_a = 0.0;
   double damage_b = 0.0;
   for (const auto &hit : hits) {
-    if (hit.target_id == "a") {
+    if (hit.target_slot == 0) {
       damage_a = hit.damage;
     }
-    if (hit.target_id == "b") {
+    if (hit.target_slot == 1) {
       damage_b = hit.damage;
     }
   }
@@ -807,37 +1038,49 @@ TEST_CASE("ComputeExplosionDamage applies falloff") {
   CHECK(damage_b == doctest::Approx(max_damage * 0.5));
 }
 
+TEST_CASE("ComputeExplosionDamage only considers listed target slots") {
+  std::vector<afps::sim::PlayerState> players(3);
+  players[1].x = 1.0;
+  players[2].x = -1.0;
+
+  const afps::combat::Vec3 center{0.0, 0.0, afps::combat::kPlayerHeight * 0.5};
+  const auto hits = ComputeExplosionDamage(center, 4.0, 100.0, players, {2, 1, 7}, 1);
+  REQUIRE(hits.size() == 1);
+  CHECK(hits[0].target_slot == 2);
+}
+
 TEST_CASE("ComputeExplosionDamage rejects invalid radius or damage") {
-  std::unordered_map<std::string, afps::sim::PlayerState> players;
+  std::vector<afps::sim::PlayerState> players;
   afps::sim::PlayerState a;
   a.x = 0.0;
   a.y = 0.0;
   a.z = 0.0;
-  players.emplace("a", a);
+  players.push_back(a);
 
   const afps::combat::Vec3 center{0.0, 0.0, afps::combat::kPlayerHeight * 0.5};
-  const auto empty_radius = ComputeExplosionDamage(center, -1.0, 100.0, players, "");
+  const auto empty_radius = ComputeExplosionDamage(center, -1.0, 100.0, players, AllSlots(players), kInvalidSlot);
   CHECK(empty_radius.empty());
 
-  const auto empty_damage = ComputeExplosionDamage(center, 4.0, -5.0, players, "");
+  const auto empty_damage = ComputeExplosionDamage(center, 4.0, -5.0, players, AllSlots(players), kInvalidSlot);
   CHECK(empty_damage.empty());
 
-  const auto empty_nan = ComputeExplosionDamage(center, std::numeric_limits<double>::quiet_NaN(), 100.0, players, "");
+  const auto empty_nan = ComputeExplosionDamage(center, std::numeric_limits<double>::quiet_NaN(), 100.0, players,
+                                                AllSlots(players), kInvalidSlot);
   CHECK(empty_nan.empty());
 }
 
 TEST_CASE("ComputeExplosionDamage handles random inputs safely") {
-  std::unordered_map<std::string, afps::sim::PlayerState> players;
+  std::vector<afps::sim::PlayerState> players;
   afps::sim::PlayerState a;
   a.x = 0.0;
   a.y = 0.0;
   a.z = 0.0;
-  players.emplace("a", a);
+  players.push_back(a);
   afps::sim::PlayerState b;
   b.x = 3.0;
   b.y = -2.0;
   b.z = 0.0;
-  players.emplace("b", b);
+  players.push_back(b);
 
   std::mt19937 rng(99);
   std::uniform_real_distribution<double> center_dist(-2.0, 2.0);
@@ -848,7 +1091,7 @@ TEST_CASE("ComputeExplosionDamage handles random inputs safely") {
     const afps::combat::Vec3 center{center_dist(rng), center_dist(rng), afps::combat::kPlayerHeight * 0.5};
     const double radius = radius_dist(rng);
     const double max_damage = damage_dist(rng);
-    const auto hits = ComputeExplosionDamage(center, radius, max_damage, players, "");
+    const auto hits = ComputeExplosionDamage(center, radius, max_damage, players, AllSlots(players), kInvalidSlot);
     for (const auto &hit : hits) {
       CHECK(std::isfinite(hit.damage));
       CHECK(hit.damage > 0.0);
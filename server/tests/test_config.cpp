@@ -50,6 +50,26 @@ TEST_CASE("ParseArgs parses required flags") {
   CHECK(result.config.use_https);
 }
 
+TEST_CASE("ValidateConfig bounds the snapshot keyframe interval") {
+  ServerConfig config;
+  config.use_https = false;
+  config.auth_token = "secret";
+  config.snapshot_keyframe_interval = 0;
+  CHECK(ValidateConfig(config).empty());
+  config.snapshot_keyframe_interval = 65535;
+  CHECK(ValidateConfig(config).empty());
+
+  config.snapshot_keyframe_interval = 65536;
+  const auto errors = ValidateConfig(config);
+  REQUIRE(errors.size() == 1);
+  CHECK(errors[0].find("keyframe interval") != std::string::npos);
+
+  const char *argv[] = {"afps_server", "--snapshot-keyframe-interval", "-2"};
+  const auto result = ParseArgs(static_cast<int>(sizeof(argv) / sizeof(argv[0])), argv);
+  REQUIRE(result.errors.size() == 1);
+  CHECK(result.errors[0] == "snapshot keyframe interval must be >= 0");
+}
+
 TEST_CASE("ParseArgs reports missing values") {
   const char *argv[] = {"afps_server", "--port"};
   const int argc = static_cast<int>(sizeof(argv) / sizeof(argv[0]));
@@ -158,6 +178,17 @@ TEST_CASE("ParseArgs accepts --dump-map-signature") {
   CHECK(result.config.dump_map_signature == true);
 }
 
+TEST_CASE("ParseArgs accepts --interest-occlusion") {
+  const char *argv[] = {"afps_server", "--interest-occlusion"};
+  const int argc = static_cast<int>(sizeof(argv) / sizeof(argv[0]));
+
+  const auto result = ParseArgs(argc, argv);
+
+  CHECK(result.errors.empty());
+  CHECK(result.config.interest_occlusion);
+  CHECK_FALSE(ParseArgs(1, argv).config.interest_occlusion);
+}
+
 TEST_CASE("ValidateConfig requires static manifest path in static mode") {
   ServerConfig config;
   config.use_https = false;
@@ -182,3 +213,65 @@ TEST_CASE("ValidateConfig skips auth and TLS requirements for map signature dump
 
   CHECK(errors.empty());
 }
+
+TEST_CASE("ParseArgs accepts room flags") {
+  const char *argv[] = {"afps_server", "--map-seed", "7", "--room", "alpha", "--room", "beta:42",
+                        "--room", "gamma::static", "--map-manifest", "map.json", "--room-capacity",
+                        "12", "--tick-workers", "3", "--movement-workers", "2",
+                        "--send-workers", "4"};
+  const int argc = static_cast<int>(sizeof(argv) / sizeof(argv[0]));
+
+  const auto result = ParseArgs(argc, argv);
+
+  CHECK(result.errors.empty());
+  REQUIRE(result.config.rooms.size() == 3);
+  CHECK(result.config.rooms[0].id == "alpha");
+  CHECK(result.config.rooms[0].map_seed == 7);
+  CHECK(result.config.rooms[0].map_mode == "legacy");
+  CHECK(result.config.rooms[1].map_seed == 42);
+  CHECK(result.config.rooms[2].map_seed == 7);
+  CHECK(result.config.rooms[2].map_mode == "static");
+  CHECK(result.config.room_capacity == 12);
+  CHECK(result.config.tick_workers == 3);
+  CHECK(result.config.movement_workers == 2);
+  CHECK(result.config.send_workers == 4);
+  CHECK(ResolveRooms(result.config).size() == 3);
+}
+
+TEST_CASE("ResolveRooms derives seeds from --rooms") {
+  const char *argv[] = {"afps_server", "--rooms", "3", "--map-seed", "100"};
+  const int argc = static_cast<int>(sizeof(argv) / sizeof(argv[0]));
+
+  const auto result = ParseArgs(argc, argv);
+
+  CHECK(result.errors.empty());
+  const auto rooms = ResolveRooms(result.config);
+  REQUIRE(rooms.size() == 3);
+  CHECK(rooms[0].id == "room-0");
+  CHECK(rooms[0].map_seed == 100);
+  CHECK(rooms[2].id == "room-2");
+  CHECK(rooms[2].map_seed == 102);
+  CHECK(ResolveRooms(ServerConfig{}).size() == 1);
+}
+
+TEST_CASE("ValidateConfig rejects bad room settings") {
+  ServerConfig config;
+  config.use_https = false;
+  config.auth_token = "secret";
+  config.rooms = {{"a", 1, "legacy"}, {"a", 2, "legacy"}, {"b", 3, "static"}, {"c", 4, "arena"},
+                  {"d\"", 5, "legacy"}};
+
+  const auto errors = ValidateConfig(config);
+
+  CHECK(errors.size() == 4);
+  CHECK(errors[0].find("Duplicate room id") != std::string::npos);
+  CHECK(errors[1].find("--map-manifest") != std::string::npos);
+  CHECK(errors[2].find("map mode") != std::string::npos);
+  CHECK(errors[3].find("Room id may only contain") != std::string::npos);
+
+  ServerConfig zero_rooms;
+  zero_rooms.use_https = false;
+  zero_rooms.auth_token = "secret";
+  zero_rooms.room_count = 0;
+  CHECK(ValidateConfig(zero_rooms).size() == 1);
+}
@@ -0,0 +1,68 @@
+#include "doctest.h"
+
+#include "entity_registry.h"
+
+using afps::entity::EntityHandle;
+using afps::entity::EntityRegistry;
+using afps::entity::EntitySlot;
+using afps::entity::kInvalidSlot;
+
+TEST_CASE("EntityRegistry assigns dense slots and reuses the lowest free slot") {
+  EntityRegistry registry;
+  const EntityHandle a = registry.Acquire("a");
+  const EntityHandle b = registry.Acquire("b");
+  const EntityHandle c = registry.Acquire("c");
+  CHECK(a.slot == 0);
+  CHECK(b.slot == 1);
+  CHECK(c.slot == 2);
+  CHECK(registry.Acquire("b").slot == 1);
+  CHECK(registry.size() == 3);
+  CHECK(registry.Find("c") == 2);
+  CHECK(registry.IdOf(1) == "b");
+
+  CHECK(registry.Release(2));
+  CHECK(registry.Release(0));
+  CHECK_FALSE(registry.Release(0));
+  CHECK(registry.Find("a") == kInvalidSlot);
+  CHECK(registry.IdOf(0).empty());
+  CHECK(registry.Acquire("d").slot == 0);
+  CHECK(registry.Acquire("e").slot == 2);
+  CHECK(registry.capacity() == 3);
+  CHECK(registry.size() == 3);
+
+  CHECK(registry.Acquire("").slot == kInvalidSlot);
+}
+
+TEST_CASE("EntityRegistry handles go stale when their slot is released") {
+  EntityRegistry registry;
+  const EntityHandle first = registry.Acquire("a");
+  CHECK(registry.IsCurrent(first));
+  registry.Release(first.slot);
+  CHECK_FALSE(registry.IsCurrent(first));
+
+  const EntityHandle second = registry.Acquire("b");
+  CHECK(second.slot == first.slot);
+  CHECK(second.generation != first.generation);
+  CHECK_FALSE(registry.IsCurrent(first));
+  CHECK(registry.IsCurrent(second));
+  CHECK_FALSE(registry.IsCurrent(EntityHandle{}));
+}
+
+TEST_CASE("EntityRegistry RetainOnly releases slots missing from the keep list") {
+  EntityRegistry registry;
+  registry.Acquire("a");
+  registry.Acquire("b");
+  registry.Acquire("c");
+
+  std::vector<EntitySlot> released;
+  registry.RetainOnly({2, 0}, released);
+  CHECK(released == std::vector<EntitySlot>{1});
+  CHECK(registry.IsLive(0));
+  CHECK_FALSE(registry.IsLive(1));
+  CHECK(registry.IsLive(2));
+
+  released.clear();
+  registry.RetainOnly({}, released);
+  CHECK(released == std::vector<EntitySlot>{0, 2});
+  CHECK(registry.size() == 0);
+}
@@ -0,0 +1,107 @@
+#include "doctest.h"
+
+#include <vector>
+
+#include "input_buffer.h"
+
+namespace {
+InputCmd MakeCmd(int seq) {
+  InputCmd cmd;
+  cmd.input_seq = seq;
+  cmd.move_x = static_cast<double>(seq);
+  return cmd;
+}
+}  // namespace
+
+TEST_CASE("InputJitterBuffer plays inputs in order behind its delay") {
+  InputJitterBuffer buffer;
+  std::vector<InputCmd> played;
+  CHECK(buffer.target_delay() == 1);
+
+  // The first input is held back until the one-tick reserve exists.
+  CHECK(buffer.Push(MakeCmd(1)));
+  CHECK(buffer.Take(played) == 0);
+  CHECK_FALSE(buffer.started());
+
+  // Out-of-order arrival is sorted; duplicates and replays are dropped.
+  CHECK(buffer.Push(MakeCmd(3)));
+  CHECK(buffer.Push(MakeCmd(2)));
+  CHECK_FALSE(buffer.Push(MakeCmd(3)));
+  REQUIRE(buffer.Take(played) == 2);
+  CHECK(played[0].input_seq == 1);
+  CHECK(played[1].input_seq == 2);
+  CHECK(buffer.depth() == 1);
+  CHECK(buffer.last_played_seq() == 2);
+  CHECK_FALSE(buffer.Push(MakeCmd(2)));
+  CHECK(buffer.stats().late_drops == 2);
+
+  for (int seq = 4; seq < 40; ++seq) {
+    played.clear();
+    buffer.Push(MakeCmd(seq));
+    REQUIRE(buffer.Take(played) == 1);
+    CHECK(played[0].input_seq == seq - 1);
+    CHECK(buffer.depth() == 1);
+  }
+  CHECK(buffer.stats().underruns == 0);
+  CHECK(buffer.stats().played == 38);
+}
+
+TEST_CASE("InputJitterBuffer adapts its delay to stalls and bursts") {
+  InputJitterConfig config;
+  config.initial_delay_ticks = 0;
+  config.max_steps_per_tick = 3;
+  config.shrink_after_ticks = 10;
+  InputJitterBuffer buffer(config);
+  std::vector<InputCmd> played;
+
+  int seq = 1;
+  buffer.Push(MakeCmd(seq++));
+  CHECK(buffer.Take(played) == 1);
+
+  // A stall underruns and raises the delay.
+  played.clear();
+  CHECK(buffer.Take(played) == 0);
+  CHECK(buffer.stats().underruns == 1);
+  CHECK(buffer.target_delay() == 1);
+
+  // The stalled inputs then arrive together; the backlog above the delay drains in bounded steps.
+  for (int i = 0; i < 6; ++i) {
+    buffer.Push(MakeCmd(seq++));
+  }
+  CHECK(buffer.Take(played) == 3);
+  played.clear();
+  buffer.Push(MakeCmd(seq++));
+  CHECK(buffer.Take(played) == 3);
+  CHECK(buffer.depth() == 1);
+  CHECK(buffer.stats().catch_up_steps == 4);
+
+  // A steady run that never touches the reserve shrinks the delay back down.
+  for (int tick = 0; tick < 8; ++tick) {
+    played.clear();
+    buffer.Push(MakeCmd(seq++));
+    CHECK(buffer.Take(played) == 1);
+  }
+  CHECK(buffer.target_delay() == 0);
+  played.clear();
+  buffer.Push(MakeCmd(seq++));
+  CHECK(buffer.Take(played) == 2);
+  CHECK(buffer.depth() == 0);
+
+  // Inputs beyond capacity push out the oldest.
+  InputJitterConfig small;
+  small.capacity = 4;
+  InputJitterBuffer bounded(small);
+  for (int i = 1; i <= 6; ++i) {
+    bounded.Push(MakeCmd(i));
+  }
+  CHECK(bounded.depth() == 4);
+  CHECK(bounded.stats().overflow_drops == 2);
+  played.clear();
+  CHECK(bounded.Take(played) == 3);
+  CHECK(played.front().input_seq == 3);
+
+  bounded.Reset();
+  CHECK(bounded.depth() == 0);
+  CHECK(bounded.last_played_seq() == -1);
+  CHECK(bounded.Push(MakeCmd(1)));
+}
@@ -0,0 +1,148 @@
+#include "doctest.h"
+
+#include "interest.h"
+
+#include <algorithm>
+#include <random>
+
+TEST_CASE("SpatialGrid returns entries within radius across cells") {
+  afps::interest::SpatialGrid grid(10.0);
+  grid.Insert(0, {0.0, 0.0, 0.0});
+  grid.Insert(1, {9.0, 0.0, 0.0});
+  grid.Insert(2, {12.0, 0.0, 0.0});
+  grid.Insert(3, {-25.0, -25.0, 0.0});
+  grid.Insert(4, {0.0, 0.0, 20.0});
+  CHECK(grid.size() == 5);
+
+  std::vector<size_t> matches;
+  grid.Query({0.0, 0.0, 0.0}, 12.0, matches);
+  std::sort(matches.begin(), matches.end());
+  CHECK(matches == std::vector<size_t>{0, 1, 2});
+
+  matches.clear();
+  grid.Query({-20.0, -20.0, 0.0}, 8.0, matches);
+  CHECK(matches == std::vector<size_t>{3});
+
+  grid.Clear();
+  matches.clear();
+  grid.Query({0.0, 0.0, 0.0}, 100.0, matches);
+  CHECK(matches.empty());
+  CHECK(grid.size() == 0);
+}
+
+TEST_CASE("SpatialGrid segment queries match a scan of every entry") {
+  std::mt19937 rng(2024);
+  std::uniform_real_distribution<double> coord(-60.0, 60.0);
+  std::uniform_real_distribution<double> height(-2.0, 6.0);
+  std::uniform_real_distribution<double> reach(0.0, 6.0);
+  afps::interest::SpatialGrid grid;
+  std::vector<afps::sim::Vec3> positions;
+  for (size_t i = 0; i < 300; ++i) {
+    positions.push_back({coord(rng), coord(rng), height(rng)});
+    grid.Insert(i, positions.back());
+  }
+
+  std::vector<size_t> matches;
+  for (int query = 0; query < 500; ++query) {
+    const afps::sim::Vec3 start{coord(rng), coord(rng), height(rng)};
+    // Every fourth segment runs along an axis or collapses to a point.
+    afps::sim::Vec3 end{coord(rng), coord(rng), height(rng)};
+    if (query % 4 == 1) {
+      end.y = start.y;
+    } else if (query % 4 == 2) {
+      end.x = start.x;
+    } else if (query % 4 == 3 && query % 8 == 3) {
+      end = start;
+    }
+    const double radius = reach(rng);
+    matches.clear();
+    grid.QuerySegment(start, end, radius, matches);
+    std::sort(matches.begin(), matches.end());
+
+    std::vector<size_t> expected;
+    const double dir_x = end.x - start.x;
+    const double dir_y = end.y - start.y;
+    const double dir_z = end.z - start.z;
+    const double length_sq = dir_x * dir_x + dir_y * dir_y + dir_z * dir_z;
+    for (size_t i = 0; i < positions.size(); ++i) {
+      const double rel_x = positions[i].x - start.x;
+      const double rel_y = positions[i].y - start.y;
+      const double rel_z = positions[i].z - start.z;
+      const double t =
+          length_sq > 0.0 ? std::clamp((rel_x * dir_x + rel_y * dir_y + rel_z * dir_z) / length_sq, 0.0, 1.0) : 0.0;
+      const double dx = rel_x - dir_x * t;
+      const double dy = rel_y - dir_y * t;
+      const double dz = rel_z - dir_z * t;
+      if (dx * dx + dy * dy + dz * dz <= radius * radius) {
+        expected.push_back(i);
+      }
+    }
+    CHECK(matches == expected);
+  }
+}
+
+TEST_CASE("ShouldSendFarSnapshot staggers subjects across snapshots") {
+  CHECK(afps::interest::ShouldSendFarSnapshot(7, 3u, 1));
+  for (uint32_t hash = 0; hash < 8; ++hash) {
+    int sent = 0;
+    for (int index = 0; index < 12; ++index) {
+      if (afps::interest::ShouldSendFarSnapshot(index, hash, 4)) {
+        sent += 1;
+      }
+    }
+    CHECK(sent == 3);
+  }
+  CHECK(afps::interest::ShouldSendFarSnapshot(0, 0u, 4) != afps::interest::ShouldSendFarSnapshot(0, 1u, 4));
+}
+
+TEST_CASE("IsLineOfSightBlocked only counts colliders between the endpoints") {
+  afps::sim::CollisionWorld world;
+  afps::sim::AabbCollider wall;
+  wall.id = 1;
+  wall.min_x = 4.0;
+  wall.max_x = 5.0;
+  wall.min_y = -2.0;
+  wall.max_y = 2.0;
+  wall.min_z = 0.0;
+  wall.max_z = 3.0;
+  world.colliders.push_back(wall);
+
+  CHECK(afps::interest::IsLineOfSightBlocked(world, {0.0, 0.0, 1.0}, {10.0, 0.0, 1.0}));
+  CHECK_FALSE(afps::interest::IsLineOfSightBlocked(world, {0.0, 0.0, 1.0}, {3.0, 0.0, 1.0}));
+  CHECK_FALSE(afps::interest::IsLineOfSightBlocked(world, {0.0, 0.0, 4.0}, {10.0, 0.0, 4.0}));
+  CHECK_FALSE(afps::interest::IsLineOfSightBlocked(world, {0.0, 5.0, 1.0}, {10.0, 5.0, 1.0}));
+}
+
+TEST_CASE("IsLineOfSightBlocked through the collider BVH matches a linear scan") {
+  std::mt19937 rng(4242);
+  std::uniform_real_distribution<double> coord(-40.0, 40.0);
+  std::uniform_real_distribution<double> extent(0.2, 6.0);
+  std::uniform_real_distribution<double> height(0.0, 6.0);
+  afps::sim::CollisionWorld scan;
+  for (int i = 0; i < 200; ++i) {
+    afps::sim::AabbCollider collider;
+    collider.id = i + 1;
+    collider.min_x = coord(rng);
+    collider.max_x = collider.min_x + extent(rng);
+    collider.min_y = coord(rng);
+    collider.max_y = collider.min_y + extent(rng);
+    collider.min_z = 0.0;
+    collider.max_z = extent(rng);
+    scan.colliders.push_back(collider);
+  }
+  afps::sim::CollisionWorld bvh = scan;
+  afps::sim::BuildColliderBvh(bvh);
+  REQUIRE(afps::sim::HasColliderBvh(bvh));
+  REQUIRE_FALSE(afps::sim::HasColliderBvh(scan));
+
+  int blocked = 0;
+  for (int i = 0; i < 2000; ++i) {
+    const afps::sim::Vec3 from{coord(rng), coord(rng), height(rng)};
+    const afps::sim::Vec3 to{coord(rng), coord(rng), height(rng)};
+    const bool expected = afps::interest::IsLineOfSightBlocked(scan, from, to);
+    CHECK(afps::interest::IsLineOfSightBlocked(bvh, from, to) == expected);
+    blocked += expected ? 1 : 0;
+  }
+  CHECK(blocked > 0);
+  CHECK(blocked < 2000);
+}
@@ -0,0 +1,59 @@
+#include "doctest.h"
+
+#include <string>
+
+#include "load_harness.h"
+
+TEST_CASE("Load harness parses its command line") {
+  const char *argv[] = {"afps_server_loadtest", "--clients", "12", "--ticks", "90", "--warmup-ticks", "0",
+                        "--map-mode", "static", "--map-manifest", "maps/arena.json", "--fire-rate", "2.5",
+                        "--movement-workers", "2", "--out", "report.json"};
+  LoadHarnessOptions options;
+  std::string error;
+  REQUIRE(ParseLoadHarnessArgs(static_cast<int>(sizeof(argv) / sizeof(argv[0])), argv, options, error));
+  CHECK(options.clients == 12);
+  CHECK(options.ticks == 90);
+  CHECK(options.warmup_ticks == 0);
+  CHECK(options.map_options.mode == afps::world::MapWorldMode::Static);
+  CHECK(options.map_options.static_manifest_path == "maps/arena.json");
+  CHECK(options.fire_rate == doctest::Approx(2.5));
+  CHECK(options.movement_workers == 2);
+  CHECK(options.output_path == "report.json");
+
+  const char *bad_clients[] = {"afps_server_loadtest", "--clients", "0"};
+  LoadHarnessOptions rejected;
+  CHECK_FALSE(ParseLoadHarnessArgs(3, bad_clients, rejected, error));
+  const char *unknown[] = {"afps_server_loadtest", "--bots", "4"};
+  CHECK_FALSE(ParseLoadHarnessArgs(3, unknown, rejected, error));
+  CHECK(error == "Unknown argument: --bots");
+}
+
+TEST_CASE("Load harness drives a tick loop and reports per-tick costs") {
+  LoadHarnessOptions options;
+  options.clients = 4;
+  options.ticks = 30;
+  options.warmup_ticks = 10;
+  options.fire_rate = 30.0;
+
+  LoadHarnessReport report;
+  std::string error;
+  REQUIRE(RunLoadHarness(options, report, error));
+  CHECK(report.inputs == 4 * 30);
+  CHECK(report.fire_requests > 0);
+  CHECK(report.unreliable_messages > 0);
+  CHECK(report.bytes_sent > 0);
+  CHECK(report.bytes_per_client_per_second > 0.0);
+  CHECK(report.messages_per_tick > 0.0);
+  CHECK(report.unreliable_bundles > 0);
+  CHECK(report.unreliable_bundles <= report.unreliable_messages);
+  CHECK(report.bundles_per_tick <= report.messages_per_tick);
+  CHECK(report.tick_p50_ms <= report.tick_p99_ms);
+  CHECK(report.tick_p99_ms <= report.tick_max_ms);
+  CHECK_FALSE(report.allocations_counted);
+
+  const std::string json = BuildLoadHarnessJson(report);
+  CHECK(json.find("\"clients\":4") != std::string::npos);
+  CHECK(json.find("\"tick_ms\":{\"p50\":") != std::string::npos);
+  CHECK(json.find("\"bytes_per_client_per_second\":") != std::string::npos);
+  CHECK(json.find("\"allocations\":null") != std::string::npos);
+}
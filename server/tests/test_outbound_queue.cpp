@@ -0,0 +1,53 @@
+#include "doctest.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "outbound_queue.h"
+
+namespace {
+std::vector<uint8_t> MakeMessage(size_t size, uint8_t fill) {
+  return std::vector<uint8_t>(size, fill);
+}
+}  // namespace
+
+TEST_CASE("OutboundQueue bundles consecutive messages up to the size limit") {
+  OutboundQueue queue;
+  const std::vector<size_t> sizes = {300, 500, 400, 1500, 100, 100, 900};
+  std::vector<uint8_t> expected;
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    const auto message = MakeMessage(sizes[i], static_cast<uint8_t>(i + 1));
+    queue.Push(message);
+    expected.insert(expected.end(), message.begin(), message.end());
+  }
+  queue.Push(nullptr, 0);
+  CHECK(queue.size() == sizes.size());
+  CHECK(queue.bytes() == expected.size());
+
+  std::vector<size_t> bundle_sizes;
+  std::vector<uint8_t> received;
+  const size_t accepted = queue.Flush(1000, [&](const uint8_t *data, size_t size) {
+    bundle_sizes.push_back(size);
+    received.insert(received.end(), data, data + size);
+    return true;
+  });
+  // 300+500 fit, 400 starts a new bundle, 1500 goes alone, then 100+100 and 900 would overflow.
+  const std::vector<size_t> expected_bundles = {800, 400, 1500, 200, 900};
+  CHECK(accepted == expected_bundles.size());
+  CHECK(bundle_sizes == expected_bundles);
+  CHECK(received == expected);
+  CHECK(queue.empty());
+  CHECK(queue.bytes() == 0);
+}
+
+TEST_CASE("OutboundQueue counts only accepted bundles and always empties") {
+  OutboundQueue queue;
+  CHECK(queue.Flush(1000, [](const uint8_t *, size_t) { return true; }) == 0);
+
+  queue.Push(MakeMessage(600, 1));
+  queue.Push(MakeMessage(600, 2));
+  size_t calls = 0;
+  CHECK(queue.Flush(1000, [&](const uint8_t *, size_t) { return ++calls == 2; }) == 1);
+  CHECK(calls == 2);
+  CHECK(queue.empty());
+}
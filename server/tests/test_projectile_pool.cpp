@@ -0,0 +1,79 @@
+#include "doctest.h"
+
+#include "projectile_pool.h"
+
+using afps::combat::kNoProjectileIndex;
+using afps::combat::ProjectilePool;
+using afps::combat::ProjectileState;
+
+namespace {
+ProjectileState MakeProjectile(double x, int ignored_id = 0) {
+  ProjectileState projectile;
+  projectile.id = ignored_id;
+  projectile.owner = {3, 1};
+  projectile.position = {x, 0.0, 1.0};
+  projectile.velocity = {10.0, 0.0, 0.0};
+  projectile.ttl = 2.0;
+  projectile.radius = 0.15;
+  projectile.damage = 40.0;
+  projectile.explosion_radius = 2.5;
+  return projectile;
+}
+}  // namespace
+
+TEST_CASE("ProjectilePool issues increasing ids and round-trips state") {
+  ProjectilePool pool;
+  CHECK(pool.empty());
+  const int a = pool.Spawn(MakeProjectile(1.0, 99));
+  const int b = pool.Spawn(MakeProjectile(2.0));
+  CHECK(a == 1);
+  CHECK(b == 2);
+  REQUIRE(pool.size() == 2);
+
+  const ProjectileState stored = pool.Get(pool.Find(a));
+  CHECK(stored.id == a);
+  CHECK(stored.owner.slot == 3);
+  CHECK(stored.owner.generation == 1);
+  CHECK(stored.position.x == 1.0);
+  CHECK(stored.velocity.x == 10.0);
+  CHECK(stored.ttl == 2.0);
+  CHECK(stored.radius == 0.15);
+  CHECK(stored.damage == 40.0);
+  CHECK(stored.explosion_radius == 2.5);
+
+  pool.position(1).x = 5.0;
+  pool.ttl(1) -= 0.5;
+  CHECK(pool.Get(1).position.x == 5.0);
+  CHECK(pool.Get(1).ttl == 1.5);
+  CHECK(pool.Find(42) == kNoProjectileIndex);
+}
+
+TEST_CASE("ProjectilePool compacts removed entries in spawn order") {
+  ProjectilePool pool;
+  for (int i = 0; i < 6; ++i) {
+    pool.Spawn(MakeProjectile(static_cast<double>(i)));
+  }
+  pool.Remove(0);
+  pool.Remove(3);
+  pool.Remove(3);
+  pool.Remove(17);
+  CHECK(pool.IsRemoved(3));
+  CHECK(pool.Find(4) == kNoProjectileIndex);
+  CHECK(pool.size() == 6);
+
+  pool.Compact();
+  REQUIRE(pool.size() == 4);
+  const int expected_ids[] = {2, 3, 5, 6};
+  for (size_t i = 0; i < pool.size(); ++i) {
+    CHECK(pool.id(i) == expected_ids[i]);
+    CHECK(pool.Find(expected_ids[i]) == i);
+    CHECK(pool.position(i).x == static_cast<double>(expected_ids[i] - 1));
+    CHECK_FALSE(pool.IsRemoved(i));
+  }
+
+  // Ids keep increasing after removals, so a new projectile never takes an old id.
+  CHECK(pool.Spawn(MakeProjectile(9.0)) == 7);
+  pool.Clear();
+  CHECK(pool.empty());
+  CHECK(pool.Spawn(MakeProjectile(0.0)) == 8);
+}
@@ -2,6 +2,12 @@
 
 #include <rapidcheck.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "ray_kernels.h"
 #include "sim/sim.h"
 
 TEST_CASE("ClampAxis clamps arbitrary inputs") {
@@ -13,3 +19,193 @@ TEST_CASE("ClampAxis clamps arbitrary inputs") {
     RC_ASSERT(std::isfinite(result));
   });
 }
+
+namespace {
+// Coordinates on a 1/8 grid so generated rays often graze edges, faces and vertices exactly.
+double GenCoordinate() {
+  return *rc::gen::inRange(-160, 161) / 8.0;
+}
+
+// Direction components are exactly zero one time in five to exercise the parallel-axis paths.
+double GenDirection() {
+  if (*rc::gen::inRange(0, 5) == 0) {
+    return 0.0;
+  }
+  return *rc::gen::inRange(-1000, 1001) / 1000.0;
+}
+
+afps::combat::KernelRay GenRay() {
+  afps::combat::KernelRay ray;
+  for (int axis = 0; axis < 3; ++axis) {
+    ray.origin[axis] = GenCoordinate();
+    ray.dir[axis] = GenDirection();
+  }
+  return ray;
+}
+
+bool SameBits(double a, double b) {
+  return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+std::vector<afps::combat::RayKernelBackend> SimdBackends() {
+  std::vector<afps::combat::RayKernelBackend> backends;
+  for (const auto backend : {afps::combat::RayKernelBackend::Sse2, afps::combat::RayKernelBackend::Avx2}) {
+    if (afps::combat::RayKernelBackendSupported(backend)) {
+      backends.push_back(backend);
+    }
+  }
+  return backends;
+}
+}  // namespace
+
+TEST_CASE("Ray box kernels match the scalar backend bit for bit") {
+  rc::check("SIMD box lanes report the scalar hit mask and slab distances", []() {
+    const auto ray = GenRay();
+    const size_t count = static_cast<size_t>(*rc::gen::inRange(1, 5));
+    afps::combat::BoxLanes boxes;
+    for (size_t lane = 0; lane < afps::combat::kRayKernelLanes; ++lane) {
+      const double x0 = GenCoordinate();
+      const double x1 = GenCoordinate();
+      const double y0 = GenCoordinate();
+      const double y1 = GenCoordinate();
+      const double z0 = GenCoordinate();
+      const double z1 = GenCoordinate();
+      boxes.min_x[lane] = std::min(x0, x1);
+      boxes.max_x[lane] = std::max(x0, x1);
+      boxes.min_y[lane] = std::min(y0, y1);
+      boxes.max_y[lane] = std::max(y0, y1);
+      boxes.min_z[lane] = std::min(z0, z1);
+      boxes.max_z[lane] = std::max(z0, z1);
+    }
+    double expected_enter[afps::combat::kRayKernelLanes] = {};
+    double expected_exit[afps::combat::kRayKernelLanes] = {};
+    const uint32_t expected = afps::combat::RaycastBoxLanes(
+        afps::combat::RayKernelBackend::Scalar, ray, boxes, count, expected_enter, expected_exit);
+    RC_ASSERT((expected >> count) == 0u);
+    for (const auto backend : SimdBackends()) {
+      double enter[afps::combat::kRayKernelLanes] = {};
+      double exit[afps::combat::kRayKernelLanes] = {};
+      const uint32_t mask = afps::combat::RaycastBoxLanes(backend, ray, boxes, count, enter, exit);
+      RC_ASSERT(mask == expected);
+      for (size_t lane = 0; lane < count; ++lane) {
+        if ((mask & (1u << lane)) != 0) {
+          RC_ASSERT(SameBits(enter[lane], expected_enter[lane]));
+          RC_ASSERT(SameBits(exit[lane], expected_exit[lane]));
+        }
+      }
+    }
+  });
+}
+
+TEST_CASE("Ray triangle kernels match the scalar backend bit for bit") {
+  rc::check("SIMD triangle lanes report the scalar hit mask and distances", []() {
+    const auto ray = GenRay();
+    const size_t count = static_cast<size_t>(*rc::gen::inRange(1, 5));
+    const double max_distance = *rc::gen::inRange(0, 400) / 8.0;
+    afps::combat::TriangleLanes triangles;
+    for (size_t lane = 0; lane < afps::combat::kRayKernelLanes; ++lane) {
+      triangles.v0_x[lane] = GenCoordinate();
+      triangles.v0_y[lane] = GenCoordinate();
+      triangles.v0_z[lane] = GenCoordinate();
+      triangles.v1_x[lane] = GenCoordinate();
+      triangles.v1_y[lane] = GenCoordinate();
+      triangles.v1_z[lane] = GenCoordinate();
+      triangles.v2_x[lane] = GenCoordinate();
+      triangles.v2_y[lane] = GenCoordinate();
+      triangles.v2_z[lane] = GenCoordinate();
+    }
+    double expected_t[afps::combat::kRayKernelLanes] = {};
+    const uint32_t expected = afps::combat::RaycastTriangleLanes(
+        afps::combat::RayKernelBackend::Scalar, ray, triangles, count, max_distance, expected_t);
+    for (const auto backend : SimdBackends()) {
+      double t[afps::combat::kRayKernelLanes] = {};
+      const uint32_t mask = afps::combat::RaycastTriangleLanes(backend, ray, triangles, count, max_distance, t);
+      RC_ASSERT(mask == expected);
+      for (size_t lane = 0; lane < count; ++lane) {
+        if ((mask & (1u << lane)) != 0) {
+          RC_ASSERT(SameBits(t[lane], expected_t[lane]));
+          RC_ASSERT(t[lane] >= 0.0);
+          RC_ASSERT(t[lane] <= max_distance);
+        }
+      }
+    }
+  });
+}
+
+TEST_CASE("Ray triangle kernels hit triangles through their centroid") {
+  rc::check("a ray aimed at a non-degenerate triangle's centroid hits it at that distance", []() {
+    const auto ray = GenRay();
+    afps::combat::TriangleLanes triangles;
+    triangles.v0_x[0] = GenCoordinate();
+    triangles.v0_y[0] = GenCoordinate();
+    triangles.v0_z[0] = GenCoordinate();
+    triangles.v1_x[0] = GenCoordinate();
+    triangles.v1_y[0] = GenCoordinate();
+    triangles.v1_z[0] = GenCoordinate();
+    triangles.v2_x[0] = GenCoordinate();
+    triangles.v2_y[0] = GenCoordinate();
+    triangles.v2_z[0] = GenCoordinate();
+    const double centroid[3] = {(triangles.v0_x[0] + triangles.v1_x[0] + triangles.v2_x[0]) / 3.0,
+                                (triangles.v0_y[0] + triangles.v1_y[0] + triangles.v2_y[0]) / 3.0,
+                                (triangles.v0_z[0] + triangles.v1_z[0] + triangles.v2_z[0]) / 3.0};
+    const double e1[3] = {triangles.v1_x[0] - triangles.v0_x[0], triangles.v1_y[0] - triangles.v0_y[0],
+                          triangles.v1_z[0] - triangles.v0_z[0]};
+    const double e2[3] = {triangles.v2_x[0] - triangles.v0_x[0], triangles.v2_y[0] - triangles.v0_y[0],
+                          triangles.v2_z[0] - triangles.v0_z[0]};
+    const double normal[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2],
+                              e1[0] * e2[1] - e1[1] * e2[0]};
+    const double normal_len = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+    double to_centroid[3] = {centroid[0] - ray.origin[0], centroid[1] - ray.origin[1], centroid[2] - ray.origin[2]};
+    const double distance = std::sqrt(to_centroid[0] * to_centroid[0] + to_centroid[1] * to_centroid[1] +
+                                      to_centroid[2] * to_centroid[2]);
+    RC_PRE(normal_len > 1e-3 && distance > 1e-3);
+    afps::combat::KernelRay aimed = ray;
+    for (int axis = 0; axis < 3; ++axis) {
+      aimed.dir[axis] = to_centroid[axis] / distance;
+    }
+    // Skip grazing rays, where the 1e-8 determinant threshold may reject the hit.
+    const double cos_angle =
+        std::abs(aimed.dir[0] * normal[0] + aimed.dir[1] * normal[1] + aimed.dir[2] * normal[2]) / normal_len;
+    RC_PRE(cos_angle > 1e-3);
+
+    for (const auto backend : {afps::combat::RayKernelBackend::Scalar, afps::combat::RayKernelBackend::Sse2,
+                               afps::combat::RayKernelBackend::Avx2}) {
+      if (!afps::combat::RayKernelBackendSupported(backend)) {
+        continue;
+      }
+      double t[afps::combat::kRayKernelLanes] = {};
+      const uint32_t mask = afps::combat::RaycastTriangleLanes(backend, aimed, triangles, 1, distance * 2.0, t);
+      RC_ASSERT(mask == 1u);
+      RC_ASSERT(std::abs(t[0] - distance) <= 1e-9 * std::max(1.0, distance));
+    }
+  });
+}
+
+TEST_CASE("Ray cylinder kernels match the scalar backend bit for bit") {
+  rc::check("SIMD cylinder lanes report the scalar hit mask and distances", []() {
+    const auto ray = GenRay();
+    const size_t count = static_cast<size_t>(*rc::gen::inRange(1, 5));
+    const double height = *rc::gen::inRange(1, 33) / 8.0;
+    const double radius = *rc::gen::inRange(1, 17) / 8.0;
+    afps::combat::CylinderLanes cylinders;
+    for (size_t lane = 0; lane < afps::combat::kRayKernelLanes; ++lane) {
+      cylinders.base_x[lane] = GenCoordinate();
+      cylinders.base_y[lane] = GenCoordinate();
+      cylinders.base_z[lane] = GenCoordinate();
+    }
+    double expected_t[afps::combat::kRayKernelLanes] = {};
+    const uint32_t expected = afps::combat::RaycastCylinderLanes(
+        afps::combat::RayKernelBackend::Scalar, ray, cylinders, count, height, radius, expected_t);
+    for (const auto backend : SimdBackends()) {
+      double t[afps::combat::kRayKernelLanes] = {};
+      const uint32_t mask = afps::combat::RaycastCylinderLanes(backend, ray, cylinders, count, height, radius, t);
+      RC_ASSERT(mask == expected);
+      for (size_t lane = 0; lane < count; ++lane) {
+        if ((mask & (1u << lane)) != 0) {
+          RC_ASSERT(SameBits(t[lane], expected_t[lane]));
+          RC_ASSERT(t[lane] >= 0.0);
+        }
+      }
+    }
+  });
+}
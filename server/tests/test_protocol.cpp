@@ -2,9 +2,13 @@
 
 #include "protocol.h"
 
+#include <cmath>
+#include <limits>
+
 #include <flatbuffers/flatbuffers.h>
 
 #include "afps_protocol_generated.h"
+#include "sim/sim.h"
 
 namespace {
 std::vector<uint8_t> BuildClientHelloMessage(const std::string &session, const std::string &connection) {
@@ -52,6 +56,29 @@ TEST_CASE("DecodeEnvelope rejects invalid headers") {
   CHECK(error == "invalid_magic");
 }
 
+TEST_CASE("DecodeEnvelopeView reads the payload in place") {
+  const auto message = BuildClientHelloMessage("sess", "conn");
+  EnvelopeView envelope;
+  std::string error;
+  REQUIRE(DecodeEnvelopeView(message, envelope, error));
+  CHECK(envelope.header.msg_type == MessageType::ClientHello);
+  CHECK(envelope.header.msg_seq == 1);
+  CHECK(envelope.payload.data() == message.data() + kProtocolHeaderBytes);
+  CHECK(envelope.payload.size() == message.size() - kProtocolHeaderBytes);
+
+  ClientHello hello;
+  CHECK(ParseClientHelloPayload(envelope.payload, hello, error));
+  CHECK(hello.session_token == "sess");
+  CHECK(hello.connection_id == "conn");
+
+  auto padded = message;
+  padded.push_back(0);
+  CHECK_FALSE(DecodeEnvelopeView(padded, envelope, error));
+  CHECK(error == "payload_size_mismatch");
+  CHECK_FALSE(DecodeEnvelopeView(ByteSpan(message.data(), kProtocolHeaderBytes - 1), envelope, error));
+  CHECK(error == "message_too_small");
+}
+
 TEST_CASE("BuildServerHello emits expected fields") {
   ServerHello hello;
   hello.protocol_version = kProtocolVersion;
@@ -161,28 +188,96 @@ TEST_CASE("ParseFireWeaponRequestPayload reads origin and direction") {
   CHECK(request.debug_projection_telemetry_enabled);
 }
 
-TEST_CASE("ParseInputCmdPayload reads decal debug telemetry") {
+TEST_CASE("ParseInputCmdPayload reads quantized frames newest first") {
+  const std::vector<afps::protocol::InputFrame> frames = {
+      {21, 13, -127, kInputButtonFire | kInputButtonCrouch, QuantizeViewYaw(1.5), QuantizeViewPitch(-0.6), 2},
+      {20, 0, 127, kInputButtonJump, 0, 0, 1}};
+  flatbuffers::FlatBufferBuilder builder(256);
+  builder.Finish(afps::protocol::CreateInputCmdDirect(builder, &frames, 0x80000001u));
+  const std::vector<uint8_t> payload(builder.GetBufferPointer(),
+                                     builder.GetBufferPointer() + builder.GetSize());
+
+  InputCmdFrames cmd;
+  std::string error;
+  REQUIRE(ParseInputCmdPayload(payload, cmd, error));
+  CHECK(error.empty());
+  CHECK(cmd.server_seq_ack_bits == 0x80000001u);
+  REQUIRE(cmd.count == 2);
+  const InputCmd &newest = cmd.frames[0];
+  CHECK(newest.input_seq == 21);
+  CHECK(newest.move_x == doctest::Approx(13.0 / 127.0));
+  CHECK(newest.move_y == -1.0);
+  CHECK(newest.view_yaw == doctest::Approx(1.5).epsilon(1e-4));
+  CHECK(newest.view_pitch == doctest::Approx(-0.6).epsilon(1e-4));
+  CHECK(newest.weapon_slot == 2);
+  CHECK(newest.fire);
+  CHECK(newest.crouch);
+  CHECK_FALSE(newest.jump);
+  CHECK(PackInputButtons(newest) == (kInputButtonFire | kInputButtonCrouch));
+  CHECK(cmd.frames[1].input_seq == 20);
+  CHECK(cmd.frames[1].move_y == 1.0);
+  CHECK(cmd.frames[1].jump);
+  CHECK_FALSE(cmd.frames[1].fire);
+}
+
+TEST_CASE("ParseInputCmdPayload rejects malformed frame lists") {
+  auto parse = [](const std::vector<afps::protocol::InputFrame> &frames, std::string &error) {
+    flatbuffers::FlatBufferBuilder builder(256);
+    builder.Finish(afps::protocol::CreateInputCmdDirect(builder, &frames));
+    const std::vector<uint8_t> payload(builder.GetBufferPointer(),
+                                       builder.GetBufferPointer() + builder.GetSize());
+    InputCmdFrames cmd;
+    return ParseInputCmdPayload(payload, cmd, error);
+  };
+  std::string error;
+  CHECK_FALSE(parse({}, error));
+  CHECK(error == "missing_field: frames");
+  CHECK_FALSE(parse({{4, 0, 0, 0, 0, 0, 0}, {5, 0, 0, 0, 0, 0, 0}}, error));
+  CHECK(error == "invalid_field: frameOrder");
+  CHECK_FALSE(parse({{5, 0, 0, 0, 0, 0, 0}, {5, 0, 0, 0, 0, 0, 0}}, error));
+  CHECK(error == "invalid_field: frameOrder");
+  CHECK_FALSE(parse({{5, 0, 0, 0, 0, 0, 0}, {4, 0, 0, 0, 0, 0, 0}, {3, 0, 0, 0, 0, 0, 0},
+                     {2, 0, 0, 0, 0, 0, 0}, {1, 0, 0, 0, 0, 0, 0}},
+                    error));
+  CHECK(error == "out_of_range: frames");
+  CHECK_FALSE(parse({{5, -128, 0, 0, 0, 0, 0}}, error));
+  CHECK(error == "out_of_range: moveX");
+  CHECK_FALSE(parse({{5, 0, 0, 1 << 12, 0, 0, 0}}, error));
+  CHECK(error == "invalid_field: buttons");
+
+  // Too short to hold a root offset, and a root offset pointing past the end.
+  for (const std::vector<uint8_t> &payload : {std::vector<uint8_t>{0x04}, std::vector<uint8_t>{0x04, 0x00, 0x00},
+                                              std::vector<uint8_t>{0xf0, 0x00, 0x00, 0x00, 0x00, 0x00}}) {
+    InputCmdFrames cmd;
+    error.clear();
+    CHECK_FALSE(ParseInputCmdPayload(payload, cmd, error));
+    CHECK(error == "invalid_flatbuffer");
+  }
+}
+
+TEST_CASE("Input quantization round trips on the wire steps") {
+  for (int q : {-32767, -12345, -1, 0, 1, 20000, 32766}) {
+    const auto value = static_cast<int16_t>(q);
+    CHECK(QuantizeViewYaw(DequantizeViewYaw(value)) == value);
+    CHECK(QuantizeViewPitch(DequantizeViewPitch(value)) == value);
+  }
+  // Yaw +pi and -pi are the same heading; it wraps to the negative end.
+  CHECK(QuantizeViewYaw(DequantizeViewYaw(32767)) == -32767);
+  CHECK(QuantizeViewPitch(DequantizeViewPitch(32767)) == 32767);
+  for (int q = -127; q <= 127; ++q) {
+    const auto value = static_cast<int8_t>(q);
+    CHECK(QuantizeInputAxis(DequantizeInputAxis(value)) == value);
+  }
+  CHECK(QuantizeViewYaw(3.14159265358979323846 * 3.0) == QuantizeViewYaw(3.14159265358979323846));
+  CHECK(QuantizeViewPitch(4.0) == 32767);
+  CHECK(QuantizeInputAxis(2.0) == 127);
+  CHECK(QuantizeInputAxis(std::nan("")) == 0);
+}
+
+TEST_CASE("ParseDecalDebugReportPayload reads decal debug telemetry") {
   flatbuffers::FlatBufferBuilder builder(256);
-  const auto offset = afps::protocol::CreateInputCmd(
+  const auto offset = afps::protocol::CreateDecalDebugReport(
       builder,
-      21,
-      0.1,
-      -0.2,
-      0.3,
-      -0.4,
-      1.5,
-      -0.6,
-      2,
-      false,
-      true,
-      false,
-      false,
-      false,
-      false,
-      false,
-      false,
-      true,
-      true,
       777,
       55,
       1,
@@ -209,34 +304,38 @@ TEST_CASE("ParseInputCmdPayload reads decal debug telemetry") {
   const std::vector<uint8_t> payload(builder.GetBufferPointer(),
                                      builder.GetBufferPointer() + builder.GetSize());
 
-  InputCmd cmd;
+  DecalDebugReport report;
   std::string error;
-  CHECK(ParseInputCmdPayload(payload, cmd, error));
+  CHECK(ParseDecalDebugReportPayload(payload, report, error));
   CHECK(error.empty());
-  CHECK(cmd.input_seq == 21);
-  CHECK(cmd.fire);
-  CHECK(cmd.crouch);
-  CHECK(cmd.debug_decal_report_present);
-  CHECK(cmd.debug_decal_server_tick == 777);
-  CHECK(cmd.debug_decal_shot_seq == 55);
-  CHECK(static_cast<int>(cmd.debug_decal_hit_kind) == 1);
-  CHECK(static_cast<int>(cmd.debug_decal_surface_type) == 2);
-  CHECK(cmd.debug_decal_authoritative_world_hit);
-  CHECK(cmd.debug_decal_used_projected_hit);
-  CHECK_FALSE(cmd.debug_decal_used_impact_projection);
-  CHECK(cmd.debug_decal_spawned);
-  CHECK(cmd.debug_decal_in_frustum);
-  CHECK(cmd.debug_decal_distance == doctest::Approx(3.25));
-  CHECK(cmd.debug_decal_position_x == doctest::Approx(11.0));
-  CHECK(cmd.debug_decal_position_y == doctest::Approx(12.0));
-  CHECK(cmd.debug_decal_position_z == doctest::Approx(13.0));
-  CHECK(cmd.debug_decal_normal_y == doctest::Approx(1.0));
-  CHECK(cmd.debug_trace_hit_position_x == doctest::Approx(21.0));
-  CHECK(cmd.debug_trace_hit_position_y == doctest::Approx(22.0));
-  CHECK(cmd.debug_trace_hit_position_z == doctest::Approx(23.0));
-  CHECK(cmd.debug_trace_hit_normal_x == doctest::Approx(0.2));
-  CHECK(cmd.debug_trace_hit_normal_y == doctest::Approx(0.3));
-  CHECK(cmd.debug_trace_hit_normal_z == doctest::Approx(0.4));
+  CHECK(report.server_tick == 777);
+  CHECK(report.shot_seq == 55);
+  CHECK(static_cast<int>(report.hit_kind) == 1);
+  CHECK(static_cast<int>(report.surface_type) == 2);
+  CHECK(report.authoritative_world_hit);
+  CHECK(report.used_projected_hit);
+  CHECK_FALSE(report.used_impact_projection);
+  CHECK(report.decal_spawned);
+  CHECK(report.decal_in_frustum);
+  CHECK(report.decal_distance == doctest::Approx(3.25));
+  CHECK(report.decal_position_x == doctest::Approx(11.0));
+  CHECK(report.decal_position_y == doctest::Approx(12.0));
+  CHECK(report.decal_position_z == doctest::Approx(13.0));
+  CHECK(report.decal_normal_y == doctest::Approx(1.0));
+  CHECK(report.trace_hit_position_x == doctest::Approx(21.0));
+  CHECK(report.trace_hit_position_y == doctest::Approx(22.0));
+  CHECK(report.trace_hit_position_z == doctest::Approx(23.0));
+  CHECK(report.trace_hit_normal_x == doctest::Approx(0.2));
+  CHECK(report.trace_hit_normal_y == doctest::Approx(0.3));
+  CHECK(report.trace_hit_normal_z == doctest::Approx(0.4));
+
+  flatbuffers::FlatBufferBuilder bad(256);
+  afps::protocol::DecalDebugReportBuilder bad_report(bad);
+  bad_report.add_decal_normal_x(std::numeric_limits<double>::infinity());
+  bad.Finish(bad_report.Finish());
+  const std::vector<uint8_t> bad_payload(bad.GetBufferPointer(), bad.GetBufferPointer() + bad.GetSize());
+  CHECK_FALSE(ParseDecalDebugReportPayload(bad_payload, report, error));
+  CHECK(error == "invalid_field: decal_debug_report");
 }
 
 TEST_CASE("BuildGameEventBatch emits projectile spawn fields") {
@@ -373,16 +472,16 @@ TEST_CASE("BuildStateSnapshot emits expected fields") {
   snapshot.server_tick = 42;
   snapshot.last_processed_input_seq = 7;
   snapshot.client_id = "client-1";
-  snapshot.pos_x = 1.5;
-  snapshot.pos_y = -2.0;
-  snapshot.pos_z = 3.25;
-  snapshot.vel_x = 0.75;
-  snapshot.vel_y = -1.25;
-  snapshot.vel_z = 0.5;
+  snapshot.pos_x_q = QuantizeSnapshotPosition(1.5);
+  snapshot.pos_y_q = QuantizeSnapshotPosition(-2.0);
+  snapshot.pos_z_q = QuantizeSnapshotPosition(3.25);
+  snapshot.vel_x_q = QuantizeSnapshotVelocity(0.75);
+  snapshot.vel_y_q = QuantizeSnapshotVelocity(-1.25);
+  snapshot.vel_z_q = QuantizeSnapshotVelocity(0.5);
   snapshot.weapon_slot = 1;
   snapshot.ammo_in_mag = 24;
-  snapshot.dash_cooldown = 0.4;
-  snapshot.health = 75.0;
+  snapshot.dash_cooldown_q = QuantizeSnapshotDashCooldown(0.4);
+  snapshot.health_q = QuantizeSnapshotHealth(75.0);
   snapshot.kills = 2;
   snapshot.deaths = 1;
   snapshot.view_yaw_q = 1234;
@@ -403,15 +502,16 @@ TEST_CASE("BuildStateSnapshot emits expected fields") {
   CHECK(parsed->server_tick() == 42);
   CHECK(parsed->last_processed_input_seq() == 7);
   CHECK(parsed->client_id()->str() == "client-1");
-  CHECK(parsed->pos_x() == doctest::Approx(1.5));
-  CHECK(parsed->pos_y() == doctest::Approx(-2.0));
-  CHECK(parsed->pos_z() == doctest::Approx(3.25));
-  CHECK(parsed->vel_x() == doctest::Approx(0.75));
-  CHECK(parsed->vel_y() == doctest::Approx(-1.25));
-  CHECK(parsed->vel_z() == doctest::Approx(0.5));
+  CHECK(parsed->pos_x_q() == 768);
+  CHECK(parsed->pos_y_q() == -1024);
+  CHECK(parsed->pos_z_q() == 1664);
+  CHECK(parsed->vel_x_q() == 96);
+  CHECK(parsed->vel_y_q() == -160);
+  CHECK(parsed->vel_z_q() == 64);
+  CHECK(parsed->weapon_slot() == 1);
   CHECK(parsed->ammo_in_mag() == 24);
-  CHECK(parsed->dash_cooldown() == doctest::Approx(0.4));
-  CHECK(parsed->health() == doctest::Approx(75.0));
+  CHECK(parsed->dash_cooldown_q() == 26);
+  CHECK(parsed->health_q() == 19200);
   CHECK(parsed->kills() == 2);
   CHECK(parsed->deaths() == 1);
   CHECK(parsed->view_yaw_q() == 1234);
@@ -429,11 +529,12 @@ TEST_CASE("BuildStateSnapshotDelta emits expected fields") {
   delta.client_id = "client-1";
   delta.mask = kSnapshotMaskPosX | kSnapshotMaskVelY | kSnapshotMaskAmmoInMag | kSnapshotMaskDashCooldown |
                kSnapshotMaskHealth | kSnapshotMaskKills | kSnapshotMaskDeaths;
-  delta.pos_x = 1.75;
-  delta.vel_y = -0.5;
+  delta.pos_x_q = 1234;
+  delta.pos_y_q = 4321;
+  delta.vel_y_q = -64;
   delta.ammo_in_mag = 15;
-  delta.dash_cooldown = 0.25;
-  delta.health = 50.0;
+  delta.dash_cooldown_q = 12;
+  delta.health_q = 5000;
   delta.kills = 3;
   delta.deaths = 2;
 
@@ -451,13 +552,253 @@ TEST_CASE("BuildStateSnapshotDelta emits expected fields") {
   CHECK(parsed->last_processed_input_seq() == 9);
   CHECK(parsed->mask() == delta.mask);
   CHECK(parsed->client_id()->str() == "client-1");
-  CHECK(parsed->pos_x() == doctest::Approx(1.75));
-  CHECK(parsed->vel_y() == doctest::Approx(-0.5));
+  CHECK(parsed->pos_x_q() == 1234);
+  CHECK(parsed->pos_y_q() == 0);
+  CHECK(parsed->vel_y_q() == -64);
   CHECK(parsed->ammo_in_mag() == 15);
-  CHECK(parsed->dash_cooldown() == doctest::Approx(0.25));
-  CHECK(parsed->health() == doctest::Approx(50.0));
+  CHECK(parsed->dash_cooldown_q() == 12);
+  CHECK(parsed->health_q() == 5000);
   CHECK(parsed->kills() == 3);
   CHECK(parsed->deaths() == 2);
+
+  StateSnapshotDelta unmasked = delta;
+  unmasked.pos_y_q = 0;
+  CHECK(BuildStateSnapshotDelta(unmasked, 6, 3) == payload);
+}
+
+TEST_CASE("Snapshot quantization round-trips within error bounds") {
+  for (double meters = -kSnapshotPositionRangeMeters; meters <= kSnapshotPositionRangeMeters; meters += 0.37) {
+    CHECK(std::abs(DequantizeSnapshotPosition(QuantizeSnapshotPosition(meters)) - meters) <=
+          kSnapshotPositionStepMeters * 0.5 + 1e-9);
+  }
+  CHECK(afps::sim::kDefaultSimConfig.arena_half_size < kSnapshotPositionRangeMeters);
+  CHECK(QuantizeSnapshotPosition(kSnapshotPositionRangeMeters * 2.0) == 32767);
+  CHECK(QuantizeSnapshotPosition(-kSnapshotPositionRangeMeters * 2.0) == std::numeric_limits<int16_t>::min());
+
+  for (double speed = -200.0; speed <= 200.0; speed += 0.73) {
+    CHECK(std::abs(DequantizeSnapshotVelocity(QuantizeSnapshotVelocity(speed)) - speed) <=
+          kSnapshotVelocityStepMetersPerSecond * 0.5 + 1e-9);
+  }
+  for (double seconds = 0.0; seconds <= 3.9; seconds += 0.013) {
+    CHECK(std::abs(DequantizeSnapshotDashCooldown(QuantizeSnapshotDashCooldown(seconds)) - seconds) <=
+          kSnapshotDashCooldownStepSeconds * 0.5 + 1e-9);
+  }
+  CHECK(QuantizeSnapshotDashCooldown(-1.0) == 0);
+  CHECK(QuantizeSnapshotDashCooldown(60.0) == 255);
+  CHECK(kSnapshotDashCooldownStepSeconds * 255.0 > afps::sim::kDefaultSimConfig.dash_cooldown);
+  for (double health = 0.0; health <= 100.0; health += 0.071) {
+    CHECK(std::abs(DequantizeSnapshotHealth(QuantizeSnapshotHealth(health)) - health) <=
+          kSnapshotHealthStep * 0.5 + 1e-9);
+  }
+  CHECK(DequantizeSnapshotHealth(QuantizeSnapshotHealth(100.0)) == 100.0);
+  CHECK(DequantizeSnapshotPosition(QuantizeSnapshotPosition(-12.625)) == -12.625);
+  CHECK(QuantizeSnapshotHealth(std::numeric_limits<double>::quiet_NaN()) == 0);
+  CHECK(QuantizeSnapshotVelocity(std::numeric_limits<double>::infinity()) == 0);
+}
+
+TEST_CASE("ValidateSnapshotFieldBounds rejects fields the wire encoding would clamp") {
+  SnapshotFieldBounds bounds;
+  bounds.max_abs_position = 40.0;
+  bounds.max_dash_cooldown = 0.5;
+  bounds.max_health = 100.0;
+  bounds.max_ammo_in_mag = 30;
+  std::string error;
+  CHECK(ValidateSnapshotFieldBounds(bounds, error));
+  CHECK(error.empty());
+
+  SnapshotFieldBounds far = bounds;
+  far.max_abs_position = kSnapshotPositionRangeMeters + 1.0;
+  CHECK_FALSE(ValidateSnapshotFieldBounds(far, error));
+  CHECK(error.find("position") != std::string::npos);
+
+  SnapshotFieldBounds slow_dash = bounds;
+  slow_dash.max_dash_cooldown = kSnapshotDashCooldownRangeSeconds + 0.1;
+  CHECK_FALSE(ValidateSnapshotFieldBounds(slow_dash, error));
+  CHECK(error.find("dash cooldown") != std::string::npos);
+
+  SnapshotFieldBounds tank = bounds;
+  tank.max_health = kSnapshotHealthRange + 1.0;
+  CHECK_FALSE(ValidateSnapshotFieldBounds(tank, error));
+  CHECK(error.find("health") != std::string::npos);
+
+  SnapshotFieldBounds drum = bounds;
+  drum.max_ammo_in_mag = 70000;
+  CHECK_FALSE(ValidateSnapshotFieldBounds(drum, error));
+  CHECK(error.find("magazine") != std::string::npos);
+}
+
+TEST_CASE("StampEnvelopeSequence matches a per-recipient build") {
+  StateSnapshot snapshot;
+  snapshot.server_tick = 90;
+  snapshot.client_id = "client-4";
+  snapshot.pos_x_q = QuantizeSnapshotPosition(4.0);
+  snapshot.health_q = QuantizeSnapshotHealth(60.0);
+
+  auto stamped = BuildStateSnapshot(snapshot, 0, 0);
+  REQUIRE(StampEnvelopeSequence(stamped, 17, 9));
+  CHECK(stamped == BuildStateSnapshot(snapshot, 17, 9));
+
+  REQUIRE(StampEnvelopeSequence(stamped, 18, 12));
+  DecodedEnvelope envelope;
+  std::string error;
+  REQUIRE(DecodeEnvelope(stamped, envelope, error));
+  CHECK(envelope.header.msg_type == MessageType::StateSnapshot);
+  CHECK(envelope.header.msg_seq == 18);
+  CHECK(envelope.header.server_seq_ack == 12);
+
+  std::vector<uint8_t> truncated(kProtocolHeaderBytes - 1, 0);
+  CHECK_FALSE(StampEnvelopeSequence(truncated, 1, 1));
+}
+
+TEST_CASE("BuildWorldSnapshotPackets splits entries within the packet budget") {
+  WorldSnapshot world;
+  world.server_tick = 300;
+  for (int i = 0; i < 24; ++i) {
+    StateSnapshot snapshot;
+    snapshot.server_tick = 300;
+    snapshot.client_id = "client-" + std::to_string(i);
+    snapshot.pos_x_q = static_cast<int16_t>(i);
+    world.snapshots.push_back(snapshot);
+  }
+  for (int i = 0; i < 24; ++i) {
+    StateSnapshotDelta delta;
+    delta.server_tick = 300;
+    delta.base_tick = 297;
+    delta.mask = kSnapshotMaskPosX;
+    delta.client_id = "delta-" + std::to_string(i);
+    delta.pos_x_q = static_cast<int16_t>(i + 100);
+    world.deltas.push_back(delta);
+  }
+
+  const auto packets = BuildWorldSnapshotPackets(world);
+  REQUIRE(packets.size() > 1);
+  CHECK(packets.size() < world.snapshots.size() + world.deltas.size());
+
+  size_t snapshot_total = 0;
+  size_t delta_total = 0;
+  for (const auto &packet : packets) {
+    CHECK(packet.message.size() <= kMaxSnapshotPacketBytes);
+    CHECK(packet.first_entry == snapshot_total + delta_total);
+    DecodedEnvelope envelope;
+    std::string error;
+    REQUIRE(DecodeEnvelope(packet.message, envelope, error));
+    CHECK(envelope.header.msg_type == MessageType::WorldSnapshot);
+    flatbuffers::Verifier verifier(envelope.payload.data(), envelope.payload.size());
+    const auto *parsed = flatbuffers::GetRoot<afps::protocol::WorldSnapshot>(envelope.payload.data());
+    REQUIRE(parsed->Verify(verifier));
+    CHECK(parsed->server_tick() == 300);
+    size_t entries = 0;
+    if (parsed->deltas()) {
+      CHECK(snapshot_total == 0);
+      for (const auto *entry : *parsed->deltas()) {
+        CHECK(entry->client_id()->str() == "delta-" + std::to_string(delta_total));
+        CHECK(entry->server_tick() == 0);
+        CHECK(entry->pos_x_q() == static_cast<int16_t>(delta_total + 100));
+        delta_total += 1;
+        entries += 1;
+      }
+    }
+    if (parsed->snapshots()) {
+      for (const auto *entry : *parsed->snapshots()) {
+        CHECK(entry->client_id()->str() == "client-" + std::to_string(snapshot_total));
+        snapshot_total += 1;
+        entries += 1;
+      }
+    }
+    CHECK(packet.entry_count == entries);
+  }
+  CHECK(snapshot_total == world.snapshots.size());
+  CHECK(delta_total == world.deltas.size());
+}
+
+TEST_CASE("BuildWorldSnapshotPackets sends oversized entries alone") {
+  WorldSnapshot world;
+  StateSnapshot snapshot;
+  snapshot.client_id = std::string(200, 'x');
+  world.snapshots.push_back(snapshot);
+  world.snapshots.push_back(snapshot);
+
+  const auto packets = BuildWorldSnapshotPackets(world, 64);
+  REQUIRE(packets.size() == 2);
+  CHECK(packets[1].first_entry == 1);
+  CHECK(packets[1].entry_count == 1);
+  CHECK(BuildWorldSnapshotPackets(WorldSnapshot{}).empty());
+}
+
+TEST_CASE("BuildWorldSnapshotPackets packs pre-encoded entries for several recipients") {
+  std::vector<EncodedSnapshotEntry> encoded;
+  for (int i = 0; i < 30; ++i) {
+    if (i % 2 == 0) {
+      StateSnapshot snapshot;
+      snapshot.server_tick = 120;
+      snapshot.client_id = "client-" + std::to_string(i);
+      snapshot.pos_x_q = static_cast<int16_t>(i);
+      encoded.push_back(EncodeSnapshotEntry(snapshot, 120));
+    } else {
+      StateSnapshotDelta delta;
+      delta.server_tick = 120;
+      delta.base_tick = 117;
+      delta.mask = (i % 4 == 1) ? kSnapshotMaskPosX : (kSnapshotMaskPosX | kSnapshotMaskHealth);
+      delta.client_id = "client-" + std::to_string(i);
+      delta.pos_x_q = static_cast<int16_t>(i);
+      delta.health_q = 50;
+      encoded.push_back(EncodeSnapshotEntry(delta, 120));
+    }
+  }
+
+  // Two recipients share the same encoded entries in different orders and subsets.
+  std::vector<const EncodedSnapshotEntry *> all;
+  std::vector<const EncodedSnapshotEntry *> odd_reversed;
+  for (size_t i = 0; i < encoded.size(); ++i) {
+    all.push_back(&encoded[i]);
+  }
+  for (size_t i = encoded.size(); i-- > 0;) {
+    if (i % 2 == 1) {
+      odd_reversed.push_back(&encoded[i]);
+    }
+  }
+
+  for (const auto *entries : {&all, &odd_reversed}) {
+    const auto packets = BuildWorldSnapshotPackets(120, *entries);
+    REQUIRE_FALSE(packets.empty());
+    size_t next_entry = 0;
+    for (const auto &packet : packets) {
+      CHECK(packet.message.size() <= kMaxSnapshotPacketBytes);
+      CHECK(packet.first_entry == next_entry);
+      DecodedEnvelope envelope;
+      std::string error;
+      REQUIRE(DecodeEnvelope(packet.message, envelope, error));
+      flatbuffers::Verifier verifier(envelope.payload.data(), envelope.payload.size());
+      const auto *parsed = flatbuffers::GetRoot<afps::protocol::WorldSnapshot>(envelope.payload.data());
+      REQUIRE(parsed->Verify(verifier));
+      CHECK(parsed->server_tick() == 120);
+      size_t snapshot_index = 0;
+      size_t delta_index = 0;
+      for (size_t entry = packet.first_entry; entry < packet.first_entry + packet.entry_count; ++entry) {
+        const auto *source = (*entries)[entry];
+        const size_t id = static_cast<size_t>(source - encoded.data());
+        if (source->delta) {
+          REQUIRE(parsed->deltas());
+          REQUIRE(delta_index < parsed->deltas()->size());
+          const auto *delta = parsed->deltas()->Get(static_cast<flatbuffers::uoffset_t>(delta_index++));
+          CHECK(delta->client_id()->str() == "client-" + std::to_string(id));
+          CHECK(delta->base_tick() == 117);
+          CHECK(delta->pos_x_q() == static_cast<int16_t>(id));
+          CHECK(delta->health_q() == ((id % 4 == 1) ? 0 : 50));
+        } else {
+          REQUIRE(parsed->snapshots());
+          REQUIRE(snapshot_index < parsed->snapshots()->size());
+          const auto *snapshot = parsed->snapshots()->Get(static_cast<flatbuffers::uoffset_t>(snapshot_index++));
+          CHECK(snapshot->client_id()->str() == "client-" + std::to_string(id));
+          CHECK(snapshot->pos_x_q() == static_cast<int16_t>(id));
+        }
+      }
+      CHECK(delta_index == (parsed->deltas() ? parsed->deltas()->size() : 0));
+      CHECK(snapshot_index == (parsed->snapshots() ? parsed->snapshots()->size() : 0));
+      next_entry += packet.entry_count;
+    }
+    CHECK(next_entry == entries->size());
+  }
 }
 
 TEST_CASE("BuildPlayerProfile emits expected fields") {
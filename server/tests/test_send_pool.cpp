@@ -0,0 +1,98 @@
+#include "doctest.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "send_pool.h"
+
+namespace {
+struct RecordingTarget {
+  std::vector<std::vector<uint8_t>> bundles;
+};
+
+bool RecordBundle(void *target, const uint8_t *data, size_t size) {
+  static_cast<RecordingTarget *>(target)->bundles.emplace_back(data, data + size);
+  return true;
+}
+
+struct GatedTarget {
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool open = false;
+  size_t sends = 0;
+};
+
+bool SendWhenOpen(void *target, const uint8_t *, size_t) {
+  auto *gate = static_cast<GatedTarget *>(target);
+  std::unique_lock lock(gate->mutex);
+  gate->cv.wait(lock, [&] { return gate->open; });
+  gate->sends += 1;
+  return true;
+}
+}  // namespace
+
+TEST_CASE("SendPool sends each key's queues in order on its own thread") {
+  SendPool pool(3, RecordBundle);
+  CHECK(pool.thread_count() == 3);
+  std::vector<std::shared_ptr<RecordingTarget>> targets;
+  for (size_t key = 0; key < 4; ++key) {
+    targets.push_back(std::make_shared<RecordingTarget>());
+  }
+
+  OutboundQueue queue;
+  CHECK_FALSE(pool.Post(0, targets[0], queue, 1000, false));
+  for (uint8_t round = 0; round < 25; ++round) {
+    for (size_t key = 0; key < targets.size(); ++key) {
+      queue.Push(std::vector<uint8_t>(600, round));
+      queue.Push(std::vector<uint8_t>(600, static_cast<uint8_t>(round + 100)));
+      REQUIRE(pool.Post(key, targets[key], queue, 1000, true));
+      CHECK(queue.empty());
+    }
+  }
+  pool.WaitIdle();
+
+  for (const auto &target : targets) {
+    REQUIRE(target->bundles.size() == 50);
+    for (uint8_t round = 0; round < 25; ++round) {
+      CHECK(target->bundles[round * 2u].front() == round);
+      CHECK(target->bundles[round * 2u + 1].front() == round + 100);
+    }
+  }
+  const auto metrics = pool.Metrics();
+  CHECK(metrics.batches == 100);
+  CHECK(metrics.bundles == 200);
+  CHECK(metrics.failed_bundles == 0);
+  CHECK(metrics.dropped_batches == 0);
+  CHECK(metrics.bytes == 100 * 1200);
+  CHECK(metrics.avg_send_ms <= metrics.max_send_ms);
+}
+
+TEST_CASE("SendPool drops droppable queues while a thread is backed up") {
+  auto gate = std::make_shared<GatedTarget>();
+  SendPool pool(1, SendWhenOpen, 1000);
+
+  OutboundQueue queue;
+  queue.Push(std::vector<uint8_t>(1500, 1));
+  REQUIRE(pool.Post(7, gate, queue, 2000, false));
+  queue.Push(std::vector<uint8_t>(100, 2));
+  CHECK_FALSE(pool.Post(7, gate, queue, 2000, true));
+  CHECK(queue.empty());
+  queue.Push(std::vector<uint8_t>(100, 3));
+  CHECK(pool.Post(7, gate, queue, 2000, false));
+
+  {
+    std::scoped_lock lock(gate->mutex);
+    gate->open = true;
+  }
+  gate->cv.notify_all();
+  pool.WaitIdle();
+
+  CHECK(gate->sends == 2);
+  const auto metrics = pool.Metrics();
+  CHECK(metrics.batches == 2);
+  CHECK(metrics.dropped_batches == 1);
+  CHECK(metrics.max_pending_bytes == 1600);
+}
@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <fstream>
 #include <limits>
+#include <random>
+#include <vector>
 
 #include <nlohmann/json.hpp>
 
@@ -517,6 +519,127 @@ TEST_CASE("Shared sim raycast options support collider ignore") {
   CHECK(hit.t == doctest::Approx(3.0));
 }
 
+TEST_CASE("Shared sim raycast sweeps a sphere when given a radius") {
+  afps::sim::SimConfig config = afps::sim::kDefaultSimConfig;
+  config.arena_half_size = 5.0;
+  config.obstacle_min_x = 0.0;
+  config.obstacle_max_x = 0.0;
+  config.obstacle_min_y = 0.0;
+  config.obstacle_max_y = 0.0;
+
+  afps::sim::CollisionWorld world;
+  afps::sim::SetAabbColliders(world, {afps::sim::AabbCollider{1, 0.0, -1.0, 0.0, 1.0, 1.0, 3.0, 1, 0}});
+
+  afps::sim::RaycastWorldOptions sweep;
+  sweep.sweep_radius = 0.25;
+  const auto point_hit = afps::sim::RaycastWorld({-1.0, 0.0, 1.6}, {1.0, 0.0, 0.0}, config, &world);
+  const auto sphere_hit = afps::sim::RaycastWorld({-1.0, 0.0, 1.6}, {1.0, 0.0, 0.0}, config, &world, sweep);
+  REQUIRE(point_hit.hit);
+  REQUIRE(sphere_hit.hit);
+  CHECK(point_hit.t == doctest::Approx(1.0));
+  CHECK(sphere_hit.t == doctest::Approx(0.75));
+  CHECK(sphere_hit.collider_id == 1);
+  CHECK(sphere_hit.normal_x == doctest::Approx(-1.0));
+
+  // A ray passing just beside the box misses as a point but grazes it as a sphere.
+  CHECK_FALSE(afps::sim::RaycastWorld({-1.0, 1.1, 1.6}, {1.0, 0.0, 0.0}, config, &world).collider_id == 1);
+  CHECK(afps::sim::RaycastWorld({-1.0, 1.1, 1.6}, {1.0, 0.0, 0.0}, config, &world, sweep).collider_id == 1);
+
+  const auto touching = afps::sim::RaycastWorld({-0.1, 0.0, 1.6}, {1.0, 0.0, 0.0}, config, &world, sweep);
+  REQUIRE(touching.hit);
+  CHECK(touching.t == 0.0);
+  CHECK(touching.collider_id == 1);
+  CHECK(touching.normal_x == doctest::Approx(-1.0));
+
+  const auto wall = afps::sim::RaycastWorld({0.0, -2.0, 1.6}, {0.0, -1.0, 0.0}, config, nullptr, sweep);
+  REQUIRE(wall.hit);
+  CHECK(wall.t == doctest::Approx(2.75));
+  const auto near_wall = afps::sim::RaycastWorld({0.0, -4.9, 1.6}, {0.0, -1.0, 0.0}, config, nullptr, sweep);
+  REQUIRE(near_wall.hit);
+  CHECK(near_wall.t == 0.0);
+
+  const auto floor = afps::sim::RaycastWorld({0.0, -2.0, 1.0}, {0.0, 0.0, -1.0}, config, nullptr, sweep);
+  REQUIRE(floor.hit);
+  CHECK(floor.t == doctest::Approx(0.75));
+  CHECK(floor.normal_z == doctest::Approx(1.0));
+}
+
+TEST_CASE("Shared sim collider BVH matches brute force movement and raycasts") {
+  afps::sim::SimConfig config = afps::sim::kDefaultSimConfig;
+  config.arena_half_size = 40.0;
+
+  std::mt19937 rng(909);
+  std::uniform_real_distribution<double> coord(-38.0, 38.0);
+  std::uniform_real_distribution<double> extent(0.2, 4.0);
+  std::uniform_real_distribution<double> height(0.0, 3.0);
+  std::uniform_real_distribution<double> unit(-1.0, 1.0);
+
+  afps::sim::CollisionWorld indexed;
+  afps::sim::CollisionWorld brute;
+  std::vector<afps::sim::AabbCollider> colliders;
+  for (int i = 0; i < 160; ++i) {
+    afps::sim::AabbCollider collider;
+    collider.id = i + 1;
+    collider.min_x = coord(rng);
+    collider.min_y = coord(rng);
+    collider.min_z = height(rng);
+    collider.max_x = collider.min_x + extent(rng);
+    collider.max_y = collider.min_y + extent(rng);
+    collider.max_z = collider.min_z + extent(rng);
+    collider.surface_type = static_cast<uint8_t>(i % 4);
+    colliders.push_back(collider);
+    afps::sim::AddAabbCollider(brute, collider);
+  }
+  afps::sim::SetAabbColliders(indexed, colliders);
+  REQUIRE(afps::sim::HasColliderBvh(indexed));
+  REQUIRE_FALSE(afps::sim::HasColliderBvh(brute));
+
+  for (int i = 0; i < 400; ++i) {
+    const afps::sim::Vec3 origin{coord(rng), coord(rng), height(rng) + 0.5};
+    const afps::sim::Vec3 dir{unit(rng), unit(rng), unit(rng) * 0.3};
+    afps::sim::RaycastWorldOptions options;
+    if (i % 3 == 0) {
+      options.max_t = 20.0;
+    }
+    if (i % 5 == 0) {
+      options.ignore_collider_id = 1 + (i % 160);
+    }
+    if (i % 4 == 0) {
+      options.sweep_radius = 0.3;
+    }
+    const auto expected = afps::sim::RaycastWorld(origin, dir, config, &brute, options);
+    const auto actual = afps::sim::RaycastWorld(origin, dir, config, &indexed, options);
+    CHECK(actual.hit == expected.hit);
+    CHECK(actual.t == expected.t);
+    CHECK(actual.collider_id == expected.collider_id);
+    CHECK(actual.normal_x == expected.normal_x);
+    CHECK(actual.normal_y == expected.normal_y);
+    CHECK(actual.normal_z == expected.normal_z);
+  }
+
+  const double dt = 1.0 / 60.0;
+  for (int player = 0; player < 12; ++player) {
+    afps::sim::PlayerState brute_state{coord(rng), coord(rng)};
+    afps::sim::PlayerState indexed_state = brute_state;
+    for (int tick = 0; tick < 240; ++tick) {
+      const auto input = afps::sim::MakeInput(unit(rng), unit(rng), tick % 7 == 0, tick % 45 == 0,
+                                              tick % 90 == 0, tick % 120 == 30, false, false,
+                                              unit(rng) * 3.14, unit(rng) * 0.5);
+      afps::sim::StepPlayer(brute_state, input, config, dt, &brute);
+      afps::sim::StepPlayer(indexed_state, input, config, dt, &indexed);
+      REQUIRE(indexed_state.x == brute_state.x);
+      REQUIRE(indexed_state.y == brute_state.y);
+      REQUIRE(indexed_state.z == brute_state.z);
+      REQUIRE(indexed_state.vel_x == brute_state.vel_x);
+      REQUIRE(indexed_state.vel_y == brute_state.vel_y);
+      REQUIRE(indexed_state.vel_z == brute_state.vel_z);
+      REQUIRE(indexed_state.grounded == brute_state.grounded);
+      REQUIRE(indexed_state.grapple_active == brute_state.grapple_active);
+      REQUIRE(indexed_state.grapple_anchor_x == brute_state.grapple_anchor_x);
+    }
+  }
+}
+
 TEST_CASE("Shared sim shield activates and triggers cooldown") {
   afps::sim::SimConfig config = afps::sim::kDefaultSimConfig;
   config.move_speed = 0.0;
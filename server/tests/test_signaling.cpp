@@ -29,26 +29,15 @@ std::vector<uint8_t> BuildClientHelloBinary(const std::string &session_token,
   return EncodeEnvelope(MessageType::ClientHello, builder.GetBufferPointer(), builder.GetSize(), 1, 0);
 }
 
-std::vector<uint8_t> BuildInputCmdBinary(int input_seq, uint32_t msg_seq = 2, uint32_t ack = 0) {
+// Frames input_seq down to input_seq - redundant, newest first, the way the client resends them.
+std::vector<uint8_t> BuildInputCmdBinary(int input_seq, uint32_t msg_seq = 2, uint32_t ack = 0, int redundant = 0,
+                                         uint32_t ack_bits = 0) {
   flatbuffers::FlatBufferBuilder builder(256);
-  const auto offset = afps::protocol::CreateInputCmd(
-      builder,
-      input_seq,
-      1.0,
-      0.0,
-      0.0,
-      0.0,
-      0.0,
-      0.0,
-      0,
-      false,
-      true,
-      false,
-      false,
-      false,
-      false,
-      false);
-  builder.Finish(offset);
+  std::vector<afps::protocol::InputFrame> frames;
+  for (int seq = input_seq; seq >= std::max(0, input_seq - redundant); --seq) {
+    frames.emplace_back(seq, 127, 0, kInputButtonFire, 0, 0, 0);
+  }
+  builder.Finish(afps::protocol::CreateInputCmdDirect(builder, &frames, ack_bits));
   return EncodeEnvelope(MessageType::InputCmd, builder.GetBufferPointer(), builder.GetSize(), msg_seq, ack);
 }
 
@@ -117,6 +106,29 @@ TEST_CASE("SignalingStore attaches TURN REST credentials") {
 }
 #endif
 
+TEST_CASE("SignalingStore routes connections to the least-loaded room") {
+  SignalingConfig config;
+  config.rooms = {{"alpha", 1}, {"beta", 2}};
+  config.room_capacity = 1;
+  SignalingStore store(config);
+
+  const auto session = store.CreateSession();
+  auto first = store.CreateConnection(session.token, std::chrono::milliseconds(2000));
+  auto second = store.CreateConnection(session.token, std::chrono::milliseconds(2000));
+  REQUIRE(first.ok);
+  REQUIRE(second.ok);
+  CHECK(store.RoomOf(first.value->connection_id) == "alpha");
+  CHECK(store.RoomOf(second.value->connection_id) == "beta");
+  CHECK(store.RoomOf("missing").empty());
+
+  auto third = store.CreateConnection(session.token, std::chrono::milliseconds(2000));
+  CHECK_FALSE(third.ok);
+  CHECK(third.error == SignalingError::RoomsFull);
+  CHECK(std::string(SignalingStore::ErrorCode(third.error)) == "rooms_full");
+  CHECK(store.ConnectionCount() == 2);
+  CHECK(store.ReadyConnectionIds("alpha").empty());
+}
+
 TEST_CASE("SignalingStore rejects invalid sessions") {
   SignalingConfig config;
   SignalingStore store(config);
@@ -281,7 +293,7 @@ TEST_CASE("SignalingStore queues input commands after handshake") {
   CHECK(answer_error == SignalingError::None);
 
   const auto hello = BuildClientHelloBinary(session.token, connect.value->connection_id);
-  const auto input = BuildInputCmdBinary(1);
+  const auto input = BuildInputCmdBinary(1, 2, 9, 0, 0x5u);
 
   const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
   while (std::chrono::steady_clock::now() < deadline && !input_sent) {
@@ -317,17 +329,18 @@ TEST_CASE("SignalingStore queues input commands after handshake") {
   CHECK(parsed->snapshot_keyframe_interval() == config.snapshot_keyframe_interval);
   CHECK(static_cast<uint32_t>(parsed->map_seed()) == config.map_seed);
 
-  auto batches = store.DrainAllInputs();
+  auto batches = store.DrainAllCommands();
   REQUIRE(batches.size() == 1);
   CHECK(batches[0].connection_id == connect.value->connection_id);
   REQUIRE(batches[0].inputs.size() == 1);
   CHECK(batches[0].inputs[0].input_seq == 1);
   CHECK(batches[0].inputs[0].fire);
-
-  auto drained = store.DrainInputs(session.token, connect.value->connection_id);
-  CHECK(drained.ok);
-  REQUIRE(drained.value.has_value());
-  CHECK(drained.value->empty());
+  CHECK(batches[0].fire_requests.empty());
+  CHECK(batches[0].loadout_requests.empty());
+  REQUIRE(batches[0].seq_acks.size() == 1);
+  CHECK(batches[0].seq_acks[0].server_seq_ack == 9);
+  CHECK(batches[0].seq_acks[0].ack_bits == 0x5u);
+  CHECK(store.DrainAllCommands().empty());
 }
 
 TEST_CASE("SignalingStore normalizes character ids in PlayerProfile") {
@@ -626,7 +639,9 @@ TEST_CASE("SignalingStore exposes ready connections and sends unreliable message
     }
 
     if (server_hello && !sent) {
-      sent = store.SendUnreliable(connect.value->connection_id, BuildPong(pong_payload, 2, 1));
+      // Sends are queued until the flush; it reports zero bundles until the channel is open.
+      sent = store.SendUnreliable(connect.value->connection_id, BuildPong(pong_payload, 2, 1)) &&
+             store.FlushOutbound() > 0;
     }
 
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
@@ -751,10 +766,10 @@ TEST_CASE("SignalingStore rate limits input commands") {
   REQUIRE(sent_one);
   REQUIRE(sent_two);
 
-  std::vector<InputBatch> drained;
+  std::vector<CommandBatch> drained;
   const auto drain_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
   while (std::chrono::steady_clock::now() < drain_deadline) {
-    drained = store.DrainAllInputs();
+    drained = store.DrainAllCommands();
     if (!drained.empty()) {
       break;
     }
@@ -766,6 +781,132 @@ TEST_CASE("SignalingStore rate limits input commands") {
   CHECK(drained[0].inputs[0].input_seq == 1);
 }
 
+TEST_CASE("SignalingStore queues resent input frames it has not seen") {
+  rtc::InitLogger(rtc::LogLevel::None);
+
+  SignalingConfig config;
+  SignalingStore store(config);
+
+  const auto session = store.CreateSession();
+  auto connect = store.CreateConnection(session.token, std::chrono::milliseconds(2000));
+  REQUIRE(connect.ok);
+  REQUIRE(connect.value.has_value());
+
+  rtc::Configuration rtc_config;
+  rtc_config.iceServers.clear();
+  RtcEchoPeer remote(rtc_config, false);
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool server_hello = false;
+  std::optional<rtc::Description> answer;
+
+  remote.SetCallbacks({
+      [&](const rtc::Description &description) {
+        std::scoped_lock lock(mutex);
+        answer = description;
+        cv.notify_all();
+      },
+      [&](const rtc::Candidate &candidate) {
+        store.AddRemoteCandidate(session.token, connect.value->connection_id, candidate.candidate(),
+                                 candidate.mid());
+      },
+      nullptr,
+      nullptr,
+      nullptr,
+      [&](const std::string &label, const rtc::binary &message) {
+        if (label != kReliableChannelLabel) {
+          return;
+        }
+        const auto message_bytes = ToByteVector(message);
+        DecodedEnvelope envelope;
+        std::string error;
+        if (!DecodeEnvelope(message_bytes, envelope, error)) {
+          return;
+        }
+        if (envelope.header.msg_type == MessageType::ServerHello) {
+          std::scoped_lock lock(mutex);
+          server_hello = true;
+          cv.notify_all();
+        }
+      }});
+
+  remote.SetRemoteDescription(connect.value->offer);
+  remote.SetLocalDescription();
+
+  {
+    std::unique_lock lock(mutex);
+    cv.wait_for(lock, std::chrono::seconds(2), [&] { return answer.has_value(); });
+  }
+
+  REQUIRE(answer.has_value());
+
+  const auto answer_error = store.ApplyAnswer(session.token, connect.value->connection_id,
+                                              std::string(*answer), answer->typeString());
+  CHECK(answer_error == SignalingError::None);
+
+  const auto hello = BuildClientHelloBinary(session.token, connect.value->connection_id);
+  // Input 2 and 3 travel only as resends inside the packet for input 4.
+  const auto input_one = BuildInputCmdBinary(1, 2);
+  const auto input_two = BuildInputCmdBinary(4, 3, 0, 2);
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+  bool hello_sent = false;
+  bool sent_one = false;
+  bool sent_two = false;
+
+  while (std::chrono::steady_clock::now() < deadline && !sent_two) {
+    auto candidates = store.DrainLocalCandidates(session.token, connect.value->connection_id);
+    if (candidates.ok && candidates.value.has_value()) {
+      for (const auto &candidate : *candidates.value) {
+        if (candidate.mid.empty()) {
+          remote.AddRemoteCandidate(rtc::Candidate(candidate.candidate));
+        } else {
+          remote.AddRemoteCandidate(rtc::Candidate(candidate.candidate, candidate.mid));
+        }
+      }
+    }
+
+    if (!hello_sent) {
+      hello_sent = remote.SendOn(kReliableChannelLabel, ToRtcBinary(hello));
+    }
+
+    {
+      std::unique_lock lock(mutex);
+      if (!server_hello) {
+        cv.wait_for(lock, std::chrono::milliseconds(10));
+      }
+    }
+
+    if (server_hello && !sent_one) {
+      sent_one = remote.SendOn(kUnreliableChannelLabel, ToRtcBinary(input_one));
+    }
+    if (server_hello && sent_one && !sent_two) {
+      sent_two = remote.SendOn(kUnreliableChannelLabel, ToRtcBinary(input_two));
+    }
+  }
+
+  REQUIRE(server_hello);
+  REQUIRE(sent_one);
+  REQUIRE(sent_two);
+
+  std::vector<InputCmd> inputs;
+  const auto drain_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while (std::chrono::steady_clock::now() < drain_deadline && inputs.size() < 4) {
+    for (const auto &batch : store.DrainAllCommands()) {
+      inputs.insert(inputs.end(), batch.inputs.begin(), batch.inputs.end());
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  REQUIRE(inputs.size() == 4);
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    CHECK(inputs[i].input_seq == static_cast<int>(i + 1));
+    CHECK(inputs[i].move_x == doctest::Approx(1.0));
+    CHECK(inputs[i].fire);
+  }
+}
+
 TEST_CASE("SignalingStore closes connection after invalid inputs") {
   rtc::InitLogger(rtc::LogLevel::None);
 
@@ -837,16 +978,23 @@ TEST_CASE("SignalingStore closes connection after invalid inputs") {
 
   REQUIRE(sent);
 
-  SignalingResult<std::vector<InputCmd>> result;
+  size_t drained_inputs = 0;
+  SignalingResult<std::vector<IceCandidate>> result;
   const auto close_deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
   while (std::chrono::steady_clock::now() < close_deadline) {
-    result = store.DrainInputs(session.token, connect.value->connection_id);
+    for (const auto &batch : store.DrainAllCommands()) {
+      if (batch.connection_id == connect.value->connection_id) {
+        drained_inputs += batch.inputs.size();
+      }
+    }
+    result = store.DrainLocalCandidates(session.token, connect.value->connection_id);
     if (!result.ok && result.error == SignalingError::ConnectionNotFound) {
       break;
     }
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
   }
 
+  CHECK(drained_inputs == 0);
   REQUIRE_FALSE(result.ok);
   CHECK(result.error == SignalingError::ConnectionNotFound);
 }
@@ -0,0 +1,209 @@
+#include "doctest.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "projectile_pool.h"
+#include "sim/sim.h"
+#include "work_pool.h"
+
+#ifdef AFPS_ENABLE_WEBRTC
+#include <string>
+
+#include <flatbuffers/flatbuffers.h>
+
+#include "afps_protocol_generated.h"
+#include "protocol.h"
+#endif
+
+// Counts every global allocation in the test binary; tests read the difference across a loop
+// that must not allocate.
+namespace {
+std::atomic<size_t> g_allocation_count{0};
+
+void *CountedAllocate(std::size_t size) noexcept {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return std::malloc(size == 0 ? 1 : size);
+}
+}  // namespace
+
+void *operator new(std::size_t size) {
+  if (void *ptr = CountedAllocate(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+  if (void *ptr = CountedAllocate(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return CountedAllocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return CountedAllocate(size);
+}
+
+void operator delete(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  std::free(ptr);
+}
+
+namespace {
+size_t AllocationCount() {
+  return g_allocation_count.load(std::memory_order_relaxed);
+}
+
+struct MovementFixture {
+  afps::sim::SimConfig config = afps::sim::kDefaultSimConfig;
+  afps::sim::CollisionWorld world;
+  std::vector<afps::sim::PlayerState> players;
+  std::mt19937 rng{77};
+
+  explicit MovementFixture(bool build_bvh) {
+    config.arena_half_size = 30.0;
+    std::uniform_real_distribution<double> coord(-28.0, 28.0);
+    std::uniform_real_distribution<double> extent(0.5, 3.0);
+    std::vector<afps::sim::AabbCollider> colliders;
+    for (int i = 0; i < 120; ++i) {
+      afps::sim::AabbCollider collider;
+      collider.id = i + 1;
+      collider.min_x = coord(rng);
+      collider.min_y = coord(rng);
+      collider.max_x = collider.min_x + extent(rng);
+      collider.max_y = collider.min_y + extent(rng);
+      collider.max_z = extent(rng);
+      colliders.push_back(collider);
+    }
+    if (build_bvh) {
+      afps::sim::SetAabbColliders(world, colliders);
+    } else {
+      for (const auto &collider : colliders) {
+        afps::sim::AddAabbCollider(world, collider);
+      }
+    }
+    players.resize(32);
+    for (auto &state : players) {
+      state.x = coord(rng);
+      state.y = coord(rng);
+    }
+  }
+
+  void Tick(int tick) {
+    std::uniform_real_distribution<double> unit(-1.0, 1.0);
+    for (size_t i = 0; i < players.size(); ++i) {
+      const auto input = afps::sim::MakeInput(unit(rng), unit(rng), tick % 3 == 0, (tick + static_cast<int>(i)) % 30 == 0,
+                                              tick % 50 == 0, tick % 90 == 10, tick % 70 == 0, false,
+                                              unit(rng) * 3.14, unit(rng) * 0.5, tick % 40 < 10);
+      afps::sim::StepPlayer(players[i], input, config, 1.0 / 60.0, &world);
+    }
+  }
+};
+}  // namespace
+
+TEST_CASE("StepPlayer does not allocate once its scratch has warmed up") {
+  for (const bool build_bvh : {true, false}) {
+    MovementFixture fixture(build_bvh);
+    for (int tick = 0; tick < 600; ++tick) {
+      fixture.Tick(tick);
+    }
+    const size_t before = AllocationCount();
+    for (int tick = 0; tick < 240; ++tick) {
+      fixture.Tick(tick);
+    }
+    CHECK(AllocationCount() - before == 0);
+  }
+}
+
+TEST_CASE("WorkPool and ProjectilePool reuse their storage between ticks") {
+  WorkPool pool(3);
+  std::vector<double> values(200, 1.0);
+  auto scale = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      values[i] *= 1.0001;
+    }
+  };
+  pool.ParallelFor(values.size(), 8, scale);
+
+  afps::combat::ProjectilePool projectiles;
+  afps::combat::ProjectileState projectile;
+  projectile.ttl = 1.0;
+  auto cycle = [&]() {
+    for (int i = 0; i < 16; ++i) {
+      projectiles.Spawn(projectile);
+    }
+    for (size_t i = 0; i < projectiles.size(); i += 2) {
+      projectiles.Remove(i);
+    }
+    projectiles.Compact();
+    while (projectiles.size() > 24) {
+      projectiles.Remove(0);
+      projectiles.Compact();
+    }
+  };
+  for (int tick = 0; tick < 8; ++tick) {
+    cycle();
+  }
+
+  const size_t before = AllocationCount();
+  for (int tick = 0; tick < 100; ++tick) {
+    pool.ParallelFor(values.size(), 8, scale);
+    cycle();
+  }
+  CHECK(AllocationCount() - before == 0);
+}
+
+#ifdef AFPS_ENABLE_WEBRTC
+TEST_CASE("Client inputs decode in place without allocating") {
+  flatbuffers::FlatBufferBuilder builder(256);
+  const std::vector<afps::protocol::InputFrame> frames = {{3, 127, -64, kInputButtonJump, 0, 0, 0},
+                                                          {2, 127, -64, 0, 0, 0, 0}};
+  builder.Finish(afps::protocol::CreateInputCmdDirect(builder, &frames));
+  const auto message =
+      EncodeEnvelope(MessageType::InputCmd, builder.GetBufferPointer(), builder.GetSize(), 2, 0);
+
+  EnvelopeView envelope;
+  InputCmdFrames cmd;
+  std::string error;
+  bool ok = true;
+  const size_t before = AllocationCount();
+  for (int i = 0; i < 100; ++i) {
+    ok = ok && DecodeEnvelopeView(ByteSpan(message.data(), message.size()), envelope, error) &&
+         ParseInputCmdPayload(envelope.payload, cmd, error);
+  }
+  CHECK(AllocationCount() - before == 0);
+  REQUIRE(ok);
+  CHECK(envelope.header.msg_type == MessageType::InputCmd);
+  REQUIRE(cmd.count == 2);
+  CHECK(cmd.frames[0].input_seq == 3);
+  CHECK(cmd.frames[0].jump);
+  CHECK(cmd.frames[0].move_y == doctest::Approx(-64.0 / 127.0));
+}
+#endif
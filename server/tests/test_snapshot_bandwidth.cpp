@@ -19,16 +19,16 @@ TEST_CASE("Snapshot bandwidth stays within budget") {
   snapshot.server_tick = 120;
   snapshot.last_processed_input_seq = 118;
   snapshot.client_id = "player";
-  snapshot.pos_x = 10.0;
-  snapshot.pos_y = -2.5;
-  snapshot.pos_z = 0.5;
-  snapshot.vel_x = 2.0;
-  snapshot.vel_y = 0.0;
-  snapshot.vel_z = 0.0;
+  snapshot.pos_x_q = QuantizeSnapshotPosition(10.0);
+  snapshot.pos_y_q = QuantizeSnapshotPosition(-2.5);
+  snapshot.pos_z_q = QuantizeSnapshotPosition(0.5);
+  snapshot.vel_x_q = QuantizeSnapshotVelocity(2.0);
+  snapshot.vel_y_q = QuantizeSnapshotVelocity(0.0);
+  snapshot.vel_z_q = QuantizeSnapshotVelocity(0.0);
   snapshot.weapon_slot = 1;
   snapshot.ammo_in_mag = 30;
-  snapshot.dash_cooldown = 0.2;
-  snapshot.health = 85.0;
+  snapshot.dash_cooldown_q = QuantizeSnapshotDashCooldown(0.2);
+  snapshot.health_q = QuantizeSnapshotHealth(85.0);
   snapshot.kills = 2;
   snapshot.deaths = 1;
 
@@ -38,16 +38,16 @@ TEST_CASE("Snapshot bandwidth stays within budget") {
   delta.last_processed_input_seq = 118;
   delta.mask = kSnapshotMaskAll;
   delta.client_id = "player";
-  delta.pos_x = 10.1;
-  delta.pos_y = -2.4;
-  delta.pos_z = 0.6;
-  delta.vel_x = 2.1;
-  delta.vel_y = 0.1;
-  delta.vel_z = 0.0;
+  delta.pos_x_q = QuantizeSnapshotPosition(10.1);
+  delta.pos_y_q = QuantizeSnapshotPosition(-2.4);
+  delta.pos_z_q = QuantizeSnapshotPosition(0.6);
+  delta.vel_x_q = QuantizeSnapshotVelocity(2.1);
+  delta.vel_y_q = QuantizeSnapshotVelocity(0.1);
+  delta.vel_z_q = QuantizeSnapshotVelocity(0.0);
   delta.weapon_slot = 1;
   delta.ammo_in_mag = 28;
-  delta.dash_cooldown = 0.1;
-  delta.health = 85.0;
+  delta.dash_cooldown_q = QuantizeSnapshotDashCooldown(0.1);
+  delta.health_q = QuantizeSnapshotHealth(85.0);
   delta.kills = 2;
   delta.deaths = 1;
 
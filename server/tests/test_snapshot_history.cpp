@@ -0,0 +1,106 @@
+#include "doctest.h"
+
+#include "snapshot_history.h"
+
+namespace {
+const afps::entity::EntityHandle kA{0, 1};
+const afps::entity::EntityHandle kB{3, 1};
+
+SnapshotHistory::SentState MakeState(const afps::entity::EntityHandle &subject, int server_tick, int16_t pos_x_q) {
+  SnapshotHistory::SentState sent;
+  sent.subject = subject;
+  sent.state.server_tick = server_tick;
+  sent.state.pos_x_q = pos_x_q;
+  return sent;
+}
+}  // namespace
+
+TEST_CASE("SnapshotHistory only promotes acked packets to baselines") {
+  SnapshotHistory history;
+  history.Record(10, {MakeState(kA, 30, 10), MakeState(kB, 30, 20)});
+  history.Record(11, {MakeState(kA, 33, 30)});
+
+  CHECK(history.Baseline(kA, 0) == nullptr);
+  CHECK_FALSE(history.Acknowledge(12));
+  CHECK(history.Baseline(kA, 0) == nullptr);
+
+  REQUIRE(history.Acknowledge(10));
+  const SnapshotBaseline *baseline = history.Baseline(kA, 0);
+  REQUIRE(baseline != nullptr);
+  CHECK(baseline->server_tick == 30);
+  CHECK(history.Baseline(kB, 0) != nullptr);
+  CHECK_FALSE(history.Acknowledge(10));
+
+  REQUIRE(history.Acknowledge(11));
+  baseline = history.Baseline(kA, 0);
+  REQUIRE(baseline != nullptr);
+  CHECK(baseline->server_tick == 33);
+  CHECK(baseline->pos_x_q == 30);
+  CHECK(history.Baseline(kB, 0)->server_tick == 30);
+}
+
+TEST_CASE("SnapshotHistory ignores stale acks and aged baselines") {
+  SnapshotHistory history(2);
+  history.Record(1, {MakeState(kA, 3, 10)});
+  history.Record(2, {MakeState(kA, 6, 20)});
+  history.Record(3, {MakeState(kA, 9, 30)});
+  CHECK(history.size() == 2);
+  CHECK_FALSE(history.Acknowledge(1));
+
+  REQUIRE(history.Acknowledge(3));
+  REQUIRE(history.Acknowledge(2));
+  CHECK(history.Baseline(kA, 0)->server_tick == 9);
+  CHECK(history.Baseline(kA, 10) == nullptr);
+
+  history.DropBaselinesBefore(10);
+  CHECK(history.Baseline(kA, 0) == nullptr);
+}
+
+TEST_CASE("SnapshotHistory acks packets named by the ack bits") {
+  SnapshotHistory history;
+  // Snapshot packets 10 and 12, with an FX message (11) and a pong (13) in the same seq space.
+  history.Record(10, {MakeState(kA, 30, 10)});
+  history.Record(12, {MakeState(kA, 33, 20), MakeState(kB, 33, 40)});
+
+  // The client saw 13 last; bit 0 is 12, bit 1 is 11, bit 2 is 10.
+  CHECK_FALSE(history.Acknowledge(13));
+  CHECK(history.Baseline(kA, 0) == nullptr);
+
+  // 12 was lost, 10 arrived.
+  REQUIRE(history.Acknowledge(13, 0b110u));
+  REQUIRE(history.Baseline(kA, 0) != nullptr);
+  CHECK(history.Baseline(kA, 0)->server_tick == 30);
+  CHECK(history.Baseline(kB, 0) == nullptr);
+
+  // A later ack whose bits reach back to 12.
+  REQUIRE(history.Acknowledge(15, 0b100u));
+  CHECK(history.Baseline(kA, 0)->server_tick == 33);
+  CHECK(history.Baseline(kB, 0) != nullptr);
+  CHECK_FALSE(history.Acknowledge(15, ~0u));
+}
+
+TEST_CASE("SnapshotHistory ignores ack bits past the 32 message window") {
+  SnapshotHistory history;
+  history.Record(100, {MakeState(kA, 30, 10)});
+  CHECK_FALSE(history.Acknowledge(133, ~0u));
+  CHECK_FALSE(history.Acknowledge(99, ~0u));
+  REQUIRE(history.Acknowledge(132, 1u << 31));
+  CHECK(history.Baseline(kA, 0) != nullptr);
+}
+
+TEST_CASE("SnapshotHistory does not hand a reused slot the previous player's baseline") {
+  SnapshotHistory history;
+  history.Record(1, {MakeState(kA, 30, 10)});
+  REQUIRE(history.Acknowledge(1));
+  REQUIRE(history.Baseline(kA, 0) != nullptr);
+
+  const afps::entity::EntityHandle reused{kA.slot, static_cast<uint16_t>(kA.generation + 1)};
+  CHECK(history.Baseline(reused, 0) == nullptr);
+  CHECK(history.Baseline({afps::entity::EntitySlot{9}, 1}, 0) == nullptr);
+
+  history.Record(2, {MakeState(reused, 33, 20)});
+  REQUIRE(history.Acknowledge(2));
+  REQUIRE(history.Baseline(reused, 0) != nullptr);
+  CHECK(history.Baseline(reused, 0)->pos_x_q == 20);
+  CHECK(history.Baseline(kA, 0) == nullptr);
+}
@@ -0,0 +1,61 @@
+#include "doctest.h"
+
+#include <thread>
+#include <vector>
+
+#include "spsc_ring.h"
+
+TEST_CASE("SpscRing keeps FIFO order and rejects pushes when full") {
+  SpscRing<int, 4> ring;
+  CHECK(ring.empty());
+  CHECK(ring.capacity() == 4);
+  for (int i = 0; i < 4; ++i) {
+    CHECK(ring.TryPush(i));
+  }
+  CHECK_FALSE(ring.TryPush(4));
+  CHECK(ring.size() == 4);
+
+  int value = -1;
+  REQUIRE(ring.TryPop(value));
+  CHECK(value == 0);
+  CHECK(ring.TryPush(5));
+
+  std::vector<int> drained;
+  CHECK(ring.Drain([&](int item) { drained.push_back(item); }) == 4);
+  CHECK(drained == std::vector<int>{1, 2, 3, 5});
+  CHECK(ring.empty());
+  CHECK_FALSE(ring.TryPop(value));
+  CHECK(ring.Drain([](int) {}) == 0);
+}
+
+TEST_CASE("SpscRing hands items across threads in order") {
+  constexpr int kCount = 100000;
+  SpscRing<int, 64> ring;
+
+  std::thread producer([&] {
+    for (int i = 0; i < kCount;) {
+      if (ring.TryPush(i)) {
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int expected = 0;
+  bool ordered = true;
+  while (expected < kCount) {
+    const size_t popped = ring.Drain([&](int item) {
+      ordered = ordered && item == expected;
+      ++expected;
+    });
+    if (popped == 0) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+
+  CHECK(ordered);
+  CHECK(expected == kCount);
+  CHECK(ring.empty());
+}
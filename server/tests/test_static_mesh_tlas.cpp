@@ -0,0 +1,228 @@
+#include "doctest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "static_mesh_tlas.h"
+
+namespace {
+afps::world::CollisionMeshRegistry MakeBoxRegistry() {
+  afps::world::CollisionMeshPrefab prefab;
+  prefab.id = "box.glb";
+  prefab.triangle_count = 1;
+  prefab.bounds = {-1.0, -2.0, 0.0, 1.0, 2.0, 3.0};
+  afps::world::CollisionMeshPrefabGeometry geometry;
+  geometry.triangles.push_back({-1.0, -2.0, 0.0, 1.0, -2.0, 0.0, 1.0, 2.0, 3.0});
+  geometry.triangle_indices.push_back(0);
+  afps::world::CollisionMeshPrefab::BvhNode node;
+  node.min_x = -1.0f;
+  node.min_y = -2.0f;
+  node.min_z = 0.0f;
+  node.max_x = 1.0f;
+  node.max_y = 2.0f;
+  node.max_z = 3.0f;
+  node.count = 1;
+  geometry.bvh_nodes.push_back(node);
+
+  afps::world::CollisionMeshRegistry registry;
+  registry.prefabs.push_back(prefab);
+  afps::world::AttachCollisionMeshGeometry(registry, {geometry});
+  return registry;
+}
+
+bool RayHitsBounds(double ox,
+                   double oy,
+                   double oz,
+                   double dx,
+                   double dy,
+                   double dz,
+                   double max_t,
+                   const afps::world::CollisionMeshBounds &bounds) {
+  double t_min = -std::numeric_limits<double>::infinity();
+  double t_max = std::numeric_limits<double>::infinity();
+  const double origin[3] = {ox, oy, oz};
+  const double dir[3] = {dx, dy, dz};
+  const double mins[3] = {bounds.min_x, bounds.min_y, bounds.min_z};
+  const double maxs[3] = {bounds.max_x, bounds.max_y, bounds.max_z};
+  for (int axis = 0; axis < 3; ++axis) {
+    if (std::abs(dir[axis]) < 1e-8) {
+      if (origin[axis] < mins[axis] || origin[axis] > maxs[axis]) {
+        return false;
+      }
+      continue;
+    }
+    double t1 = (mins[axis] - origin[axis]) / dir[axis];
+    double t2 = (maxs[axis] - origin[axis]) / dir[axis];
+    if (t1 > t2) {
+      std::swap(t1, t2);
+    }
+    t_min = std::max(t_min, t1);
+    t_max = std::min(t_max, t2);
+    if (t_min > t_max) {
+      return false;
+    }
+  }
+  if (t_max < 0.0) {
+    return false;
+  }
+  return (t_min >= 0.0 ? t_min : t_max) <= max_t;
+}
+}  // namespace
+
+TEST_CASE("StaticMeshTlas resolves prefabs and rotated world bounds up front") {
+  const auto registry = MakeBoxRegistry();
+  std::vector<afps::world::StaticMeshInstance> instances(2);
+  instances[0].instance_id = 1;
+  instances[0].prefab_id = "box.glb";
+  instances[0].center_x = 10.0;
+  instances[0].center_y = 5.0;
+  instances[0].base_z = 1.0;
+  instances[0].yaw_quarter_turns = 1;
+  instances[0].scale = 2.0;
+  instances[1].instance_id = 2;
+  instances[1].prefab_id = "missing.glb";
+
+  const auto tlas = afps::world::BuildStaticMeshTlas(instances, registry);
+  REQUIRE(tlas.prefab_indices.size() == 2);
+  CHECK(tlas.prefab_indices[0] == 0);
+  CHECK(tlas.prefab_indices[1] == afps::world::kNoStaticMeshPrefab);
+  CHECK(tlas.instance_indices == std::vector<uint32_t>{0});
+
+  const auto &bounds = tlas.instance_bounds[0];
+  CHECK(bounds.min_x == doctest::Approx(6.0));
+  CHECK(bounds.max_x == doctest::Approx(14.0));
+  CHECK(bounds.min_y == doctest::Approx(3.0));
+  CHECK(bounds.max_y == doctest::Approx(7.0));
+  CHECK(bounds.min_z == doctest::Approx(1.0));
+  CHECK(bounds.max_z == doctest::Approx(7.0));
+
+  std::vector<uint32_t> hits;
+  afps::world::QueryStaticMeshTlas(tlas, 0.0, 5.0, 2.0, 1.0, 0.0, 0.0, 100.0, hits);
+  CHECK(hits == std::vector<uint32_t>{0});
+  afps::world::QueryStaticMeshTlas(tlas, 0.0, 5.0, 2.0, 1.0, 0.0, 0.0, 5.0, hits);
+  CHECK(hits.empty());
+  afps::world::QueryStaticMeshTlas(tlas, 0.0, 5.0, 2.0, -1.0, 0.0, 0.0, 100.0, hits);
+  CHECK(hits.empty());
+}
+
+TEST_CASE("StaticMeshTlas query returns every instance a brute-force scan hits") {
+  const auto registry = MakeBoxRegistry();
+  std::vector<afps::world::StaticMeshInstance> instances;
+  for (int gx = 0; gx < 24; ++gx) {
+    for (int gy = 0; gy < 24; ++gy) {
+      afps::world::StaticMeshInstance instance;
+      instance.instance_id = static_cast<uint32_t>(instances.size() + 1);
+      instance.prefab_id = "box.glb";
+      instance.center_x = gx * 8.0 - 96.0;
+      instance.center_y = gy * 8.0 - 96.0;
+      instance.yaw_quarter_turns = static_cast<uint8_t>((gx + gy) & 3);
+      instance.scale = 1.0 + 0.25 * ((gx * 7 + gy) % 3);
+      instances.push_back(instance);
+    }
+  }
+  const auto tlas = afps::world::BuildStaticMeshTlas(instances, registry);
+  REQUIRE(tlas.instance_indices.size() == instances.size());
+
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<double> coord(-110.0, 110.0);
+  std::uniform_real_distribution<double> unit(-1.0, 1.0);
+  std::vector<uint32_t> hits;
+  size_t total_candidates = 0;
+  for (int i = 0; i < 500; ++i) {
+    const double ox = coord(rng);
+    const double oy = coord(rng);
+    const double oz = 1.0 + unit(rng);
+    double dx = unit(rng);
+    double dy = unit(rng);
+    double dz = (i % 4 == 0) ? 0.0 : unit(rng) * 0.1;
+    const double len = std::sqrt(dx * dx + dy * dy + dz * dz);
+    dx /= len;
+    dy /= len;
+    dz /= len;
+    const double max_t = (i % 2 == 0) ? 30.0 : 400.0;
+
+    afps::world::QueryStaticMeshTlas(tlas, ox, oy, oz, dx, dy, dz, max_t, hits);
+    CHECK(std::is_sorted(hits.begin(), hits.end()));
+    total_candidates += hits.size();
+    for (uint32_t index = 0; index < instances.size(); ++index) {
+      if (RayHitsBounds(ox, oy, oz, dx, dy, dz, max_t, tlas.instance_bounds[index])) {
+        CHECK(std::binary_search(hits.begin(), hits.end(), index));
+      }
+    }
+  }
+  CHECK(total_candidates < instances.size() * 500 / 4);
+}
+
+TEST_CASE("StaticMeshTlas packet query matches per-ray queries") {
+  const auto registry = MakeBoxRegistry();
+  std::vector<afps::world::StaticMeshInstance> instances;
+  for (int gx = 0; gx < 16; ++gx) {
+    for (int gy = 0; gy < 16; ++gy) {
+      afps::world::StaticMeshInstance instance;
+      instance.instance_id = static_cast<uint32_t>(instances.size() + 1);
+      instance.prefab_id = "box.glb";
+      instance.center_x = gx * 6.0 - 48.0;
+      instance.center_y = gy * 6.0 - 48.0;
+      instance.yaw_quarter_turns = static_cast<uint8_t>(gx & 3);
+      instances.push_back(instance);
+    }
+  }
+  const auto tlas = afps::world::BuildStaticMeshTlas(instances, registry);
+
+  // Bursts from a handful of shooters, like a tick of full-auto fire, plus scattered strays.
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> coord(-60.0, 60.0);
+  std::uniform_real_distribution<double> unit(-1.0, 1.0);
+  std::vector<afps::world::StaticMeshTlasRay> rays;
+  for (int shooter = 0; shooter < 6; ++shooter) {
+    const double ox = coord(rng);
+    const double oy = coord(rng);
+    const double yaw = unit(rng) * 3.14159;
+    for (int shot = 0; shot < 12; ++shot) {
+      afps::world::StaticMeshTlasRay ray;
+      ray.origin_x = ox;
+      ray.origin_y = oy;
+      ray.origin_z = 1.6;
+      const double spread = unit(rng) * 0.05;
+      ray.dir_x = std::cos(yaw + spread);
+      ray.dir_y = std::sin(yaw + spread);
+      ray.max_t = (shot % 3 == 0) ? 20.0 : 200.0;
+      rays.push_back(ray);
+    }
+  }
+  for (int i = 0; i < 20; ++i) {
+    afps::world::StaticMeshTlasRay ray;
+    ray.origin_x = coord(rng);
+    ray.origin_y = coord(rng);
+    ray.origin_z = 1.0 + unit(rng);
+    double dx = unit(rng);
+    double dy = unit(rng);
+    double dz = unit(rng) * 0.2;
+    const double len = std::sqrt(dx * dx + dy * dy + dz * dz);
+    ray.dir_x = dx / len;
+    ray.dir_y = dy / len;
+    ray.dir_z = dz / len;
+    ray.max_t = 150.0;
+    rays.push_back(ray);
+  }
+
+  std::vector<std::vector<uint32_t>> packet_hits;
+  afps::world::QueryStaticMeshTlasPacket(tlas, rays, packet_hits);
+  REQUIRE(packet_hits.size() == rays.size());
+  std::vector<uint32_t> hits;
+  size_t total_candidates = 0;
+  for (size_t i = 0; i < rays.size(); ++i) {
+    const auto &ray = rays[i];
+    afps::world::QueryStaticMeshTlas(tlas, ray.origin_x, ray.origin_y, ray.origin_z, ray.dir_x, ray.dir_y,
+                                     ray.dir_z, ray.max_t, hits);
+    CHECK(packet_hits[i] == hits);
+    total_candidates += hits.size();
+  }
+  CHECK(total_candidates > 0);
+
+  afps::world::QueryStaticMeshTlasPacket(tlas, {}, packet_hits);
+  CHECK(packet_hits.empty());
+}
@@ -1,6 +1,13 @@
 #include "doctest.h"
 #include "tick.h"
 
+#ifdef AFPS_ENABLE_WEBRTC
+#include <flatbuffers/flatbuffers.h>
+
+#include "afps_protocol_generated.h"
+#include "protocol.h"
+#endif
+
 TEST_CASE("TickAccumulator advances deterministically") {
   using Clock = TickAccumulator::Clock;
   TickAccumulator accumulator(10);
@@ -42,4 +49,175 @@ TEST_CASE("mesh_only backend still permits non-building fallback") {
   input.mesh_hit = false;
   CHECK(afps::server::WorldHitAllowsAabbFallback(input));
 }
+
+TEST_CASE("Generated maps and default configs fit the snapshot field ranges") {
+  const auto weapons = afps::weapons::BuildDefaultWeaponConfig();
+  for (const uint32_t seed : {0u, 1u, 1234u, 0xdeadbeefu}) {
+    const auto generated = afps::world::GenerateMapWorld(afps::sim::kDefaultSimConfig, seed, 60);
+    const SnapshotFieldBounds bounds =
+        afps::server::ComputeSnapshotFieldBounds(afps::sim::kDefaultSimConfig, generated.collision_world, weapons);
+    CHECK(bounds.max_abs_position >= afps::sim::kDefaultSimConfig.arena_half_size);
+    CHECK(bounds.max_health == afps::combat::kMaxHealth);
+    CHECK(bounds.max_ammo_in_mag > 0);
+    std::string error;
+    CHECK(ValidateSnapshotFieldBounds(bounds, error));
+    CHECK(error.empty());
+  }
+
+  afps::sim::CollisionWorld tower;
+  afps::sim::AabbCollider collider;
+  collider.id = 1;
+  collider.min_x = -1.0;
+  collider.max_x = 1.0;
+  collider.min_y = -1.0;
+  collider.max_y = 1.0;
+  collider.min_z = 0.0;
+  collider.max_z = kSnapshotPositionRangeMeters;
+  tower.colliders.push_back(collider);
+  const SnapshotFieldBounds bounds =
+      afps::server::ComputeSnapshotFieldBounds(afps::sim::kDefaultSimConfig, tower, weapons);
+  CHECK(bounds.max_abs_position > kSnapshotPositionRangeMeters);
+  std::string error;
+  CHECK_FALSE(ValidateSnapshotFieldBounds(bounds, error));
+  CHECK(error.find("position") != std::string::npos);
+}
+
+namespace {
+// One ready client whose command batches are queued by the test and whose unreliable messages are
+// kept until the test clears them.
+class RecordingTransport final : public TickTransport {
+public:
+  std::vector<CommandBatch> DrainAllCommands(const std::string &) override {
+    std::vector<CommandBatch> drained;
+    drained.swap(pending);
+    return drained;
+  }
+  std::vector<std::string> ReadyConnectionIds(const std::string &) override {
+    return {kClientId};
+  }
+  bool SendReliable(const std::string &, const std::vector<uint8_t> &) override {
+    return true;
+  }
+  bool SendUnreliable(const std::string &, const std::vector<uint8_t> &message) override {
+    unreliable.push_back(message);
+    return true;
+  }
+  uint32_t NextServerMessageSeq(const std::string &) override {
+    return ++next_server_msg_seq;
+  }
+  uint32_t LastClientMessageSeq(const std::string &) override {
+    return 0;
+  }
+  size_t ConnectionCount() const override {
+    return 1;
+  }
+  size_t FlushOutbound(const std::string &) override {
+    return 0;
+  }
+
+  static constexpr const char *kClientId = "client-a";
+  std::vector<CommandBatch> pending;
+  std::vector<std::vector<uint8_t>> unreliable;
+  uint32_t next_server_msg_seq = 0;
+};
+
+struct SentSnapshot {
+  uint32_t msg_seq = 0;
+  int server_tick = 0;
+  std::vector<int> delta_base_ticks;
+  size_t keyframes = 0;
+};
+
+std::vector<SentSnapshot> TakeSnapshots(RecordingTransport &transport) {
+  std::vector<SentSnapshot> snapshots;
+  for (const auto &message : transport.unreliable) {
+    DecodedEnvelope envelope;
+    std::string error;
+    REQUIRE(DecodeEnvelope(message, envelope, error));
+    if (envelope.header.msg_type != MessageType::WorldSnapshot) {
+      continue;
+    }
+    const auto *parsed = flatbuffers::GetRoot<afps::protocol::WorldSnapshot>(envelope.payload.data());
+    SentSnapshot sent;
+    sent.msg_seq = envelope.header.msg_seq;
+    sent.server_tick = parsed->server_tick();
+    if (parsed->deltas()) {
+      for (const auto *delta : *parsed->deltas()) {
+        sent.delta_base_ticks.push_back(delta->base_tick());
+      }
+    }
+    sent.keyframes = parsed->snapshots() ? parsed->snapshots()->size() : 0;
+    snapshots.push_back(std::move(sent));
+  }
+  transport.unreliable.clear();
+  return snapshots;
+}
+}  // namespace
+
+TEST_CASE("TickLoop applies snapshot acks drained on ticks without a snapshot") {
+  RecordingTransport transport;
+  TickLoop loop(transport, 60, 100);
+  auto now = TickAccumulator::Clock::time_point{};
+  loop.Advance(now);
+
+  std::vector<SentSnapshot> first;
+  for (int tick = 0; tick < 10 && first.empty(); ++tick) {
+    now += loop.tick_duration();
+    loop.Advance(now);
+    first = TakeSnapshots(transport);
+  }
+  REQUIRE(first.size() == 1);
+  CHECK(first[0].keyframes == 1);
+
+  // The tick after a snapshot never sends one at 60 Hz / 20 Hz, so this ack is drained on its own.
+  CommandBatch ack;
+  ack.connection_id = RecordingTransport::kClientId;
+  ack.seq_acks.push_back({first[0].msg_seq, 0});
+  transport.pending.push_back(ack);
+  now += loop.tick_duration();
+  loop.Advance(now);
+  CHECK(TakeSnapshots(transport).empty());
+
+  std::vector<SentSnapshot> next;
+  for (int tick = 0; tick < 10 && next.empty(); ++tick) {
+    now += loop.tick_duration();
+    loop.Advance(now);
+    next = TakeSnapshots(transport);
+  }
+  REQUIRE(next.size() == 1);
+  CHECK(next[0].keyframes == 0);
+  REQUIRE(next[0].delta_base_ticks.size() == 1);
+  CHECK(next[0].delta_base_ticks[0] == first[0].server_tick);
+}
+
+TEST_CASE("TickLoop keyframes each subject every keyframe interval even with acked baselines") {
+  RecordingTransport transport;
+  TickLoop loop(transport, 60, 2);
+  auto now = TickAccumulator::Clock::time_point{};
+  loop.Advance(now);
+
+  int keyframes = 0;
+  int deltas = 0;
+  for (int snapshot = 0; snapshot < 7;) {
+    now += loop.tick_duration();
+    loop.Advance(now);
+    const auto sent = TakeSnapshots(transport);
+    if (sent.empty()) {
+      continue;
+    }
+    REQUIRE(sent.size() == 1);
+    // The first snapshot has no baseline yet; after that every snapshot is acked before the next.
+    if (snapshot > 0) {
+      keyframes += static_cast<int>(sent[0].keyframes);
+      deltas += static_cast<int>(sent[0].delta_base_ticks.size());
+    }
+    CommandBatch ack;
+    ack.connection_id = RecordingTransport::kClientId;
+    ack.seq_acks.push_back({sent[0].msg_seq, 0});
+    transport.pending.push_back(ack);
+    snapshot += 1;
+  }
+  CHECK(keyframes == 3);
+  CHECK(deltas == 3);
+}
 #endif
@@ -0,0 +1,95 @@
+#include "doctest.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "tick_scheduler.h"
+
+TEST_CASE("TickScheduler runs every task on its own period") {
+  using Clock = TickScheduler::Clock;
+  TickScheduler scheduler(2);
+  std::atomic<int> fast_runs{0};
+  std::atomic<int> slow_runs{0};
+  const auto fast_period = std::chrono::milliseconds(2);
+  const auto slow_period = std::chrono::milliseconds(20);
+  const auto start = Clock::now();
+  const size_t fast = scheduler.AddTask(
+      [&](Clock::time_point now) {
+        fast_runs.fetch_add(1);
+        return now + fast_period;
+      },
+      fast_period, start);
+  const size_t slow = scheduler.AddTask(
+      [&](Clock::time_point now) {
+        slow_runs.fetch_add(1);
+        return now + slow_period;
+      },
+      slow_period, start + slow_period);
+
+  scheduler.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  scheduler.Stop();
+
+  CHECK(scheduler.task_count() == 2);
+  CHECK(scheduler.worker_count() == 2);
+  CHECK(fast_runs.load() > slow_runs.load());
+  CHECK(slow_runs.load() >= 1);
+  CHECK(slow_runs.load() <= 6);
+  CHECK(scheduler.Metrics(fast).runs == static_cast<uint64_t>(fast_runs.load()));
+  CHECK(scheduler.Metrics(slow).runs == static_cast<uint64_t>(slow_runs.load()));
+  CHECK(scheduler.Metrics(slow).max_run_ms >= scheduler.Metrics(slow).avg_run_ms);
+  CHECK(scheduler.Metrics(99).runs == 0);
+}
+
+TEST_CASE("TickScheduler never runs a task on two workers at once") {
+  using Clock = TickScheduler::Clock;
+  TickScheduler scheduler(4);
+  std::atomic<int> in_flight{0};
+  std::atomic<int> overlaps{0};
+  std::atomic<int> runs{0};
+  const size_t task = scheduler.AddTask(
+      [&](Clock::time_point now) {
+        if (in_flight.fetch_add(1) != 0) {
+          overlaps.fetch_add(1);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        in_flight.fetch_sub(1);
+        runs.fetch_add(1);
+        // Always due again, so idle workers would pick it up if it were queued twice.
+        return now;
+      },
+      std::chrono::milliseconds(1), Clock::now());
+
+  scheduler.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  scheduler.Stop();
+
+  CHECK(runs.load() > 0);
+  CHECK(overlaps.load() == 0);
+  CHECK(scheduler.Metrics(task).runs == static_cast<uint64_t>(runs.load()));
+}
+
+TEST_CASE("TickScheduler counts runs that start a full period late") {
+  using Clock = TickScheduler::Clock;
+  TickScheduler scheduler(1);
+  const auto period = std::chrono::milliseconds(5);
+  const size_t task = scheduler.AddTask([&](Clock::time_point now) { return now + std::chrono::hours(1); },
+                                        period, Clock::now() - std::chrono::milliseconds(50));
+
+  scheduler.Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  scheduler.Stop();
+
+  const auto metrics = scheduler.Metrics(task);
+  CHECK(metrics.runs == 1);
+  CHECK(metrics.late_runs == 1);
+  CHECK(metrics.max_lateness_ms >= 50.0);
+}
+
+TEST_CASE("TickScheduler sizes the pool to cores and tasks") {
+  CHECK(TickScheduler::DefaultWorkerCount(0) == 1);
+  CHECK(TickScheduler::DefaultWorkerCount(1) == 1);
+  CHECK(TickScheduler::DefaultWorkerCount(1000) >= 1);
+  CHECK(TickScheduler::DefaultWorkerCount(1000) <= std::max(1u, std::thread::hardware_concurrency()));
+}
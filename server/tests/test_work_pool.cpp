@@ -0,0 +1,89 @@
+#include "doctest.h"
+
+#include <atomic>
+#include <random>
+#include <vector>
+
+#include "sim/sim.h"
+#include "work_pool.h"
+
+TEST_CASE("WorkPool runs every index once in fixed chunks") {
+  WorkPool pool(4);
+  CHECK(pool.participant_count() == 4);
+  for (const size_t count : {0u, 1u, 7u, 8u, 9u, 100u, 1001u}) {
+    std::vector<std::atomic<int>> visits(count);
+    std::atomic<bool> aligned{true};
+    pool.ParallelFor(count, 8, [&](size_t begin, size_t end) {
+      if (begin % 8 != 0 || end > count || end - begin > 8 || (end - begin < 8 && end != count)) {
+        aligned.store(false);
+      }
+      for (size_t i = begin; i < end; ++i) {
+        visits[i].fetch_add(1);
+      }
+    });
+    CHECK(aligned.load());
+    for (size_t i = 0; i < count; ++i) {
+      CHECK(visits[i].load() == 1);
+    }
+  }
+}
+
+TEST_CASE("WorkPool movement matches a serial step bit for bit") {
+  afps::sim::SimConfig config = afps::sim::kDefaultSimConfig;
+  config.arena_half_size = 40.0;
+
+  std::mt19937 rng(512);
+  std::uniform_real_distribution<double> coord(-36.0, 36.0);
+  std::uniform_real_distribution<double> extent(0.5, 4.0);
+  std::uniform_real_distribution<double> unit(-1.0, 1.0);
+
+  std::vector<afps::sim::AabbCollider> colliders;
+  for (int i = 0; i < 80; ++i) {
+    afps::sim::AabbCollider collider;
+    collider.id = i + 1;
+    collider.min_x = coord(rng);
+    collider.min_y = coord(rng);
+    collider.min_z = 0.0;
+    collider.max_x = collider.min_x + extent(rng);
+    collider.max_y = collider.min_y + extent(rng);
+    collider.max_z = extent(rng);
+    colliders.push_back(collider);
+  }
+  afps::sim::CollisionWorld world;
+  afps::sim::SetAabbColliders(world, colliders);
+
+  std::vector<afps::sim::PlayerState> serial(96);
+  for (auto &state : serial) {
+    state.x = coord(rng);
+    state.y = coord(rng);
+  }
+  std::vector<afps::sim::PlayerState> parallel = serial;
+
+  WorkPool pool(4);
+  const double dt = 1.0 / 60.0;
+  std::vector<afps::sim::SimInput> inputs(serial.size());
+  for (int tick = 0; tick < 120; ++tick) {
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      inputs[i] = afps::sim::MakeInput(unit(rng), unit(rng), tick % 5 == 0, (tick + static_cast<int>(i)) % 40 == 0,
+                                       tick % 70 == 0, false, false, false, unit(rng) * 3.14, unit(rng) * 0.5);
+    }
+    for (size_t i = 0; i < serial.size(); ++i) {
+      afps::sim::StepPlayer(serial[i], inputs[i], config, dt, &world);
+    }
+    pool.ParallelFor(parallel.size(), 8, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        afps::sim::StepPlayer(parallel[i], inputs[i], config, dt, &world);
+      }
+    });
+  }
+  for (size_t i = 0; i < serial.size(); ++i) {
+    CHECK(parallel[i].x == serial[i].x);
+    CHECK(parallel[i].y == serial[i].y);
+    CHECK(parallel[i].z == serial[i].z);
+    CHECK(parallel[i].vel_x == serial[i].vel_x);
+    CHECK(parallel[i].vel_y == serial[i].vel_y);
+    CHECK(parallel[i].vel_z == serial[i].vel_z);
+    CHECK(parallel[i].grounded == serial[i].grounded);
+    CHECK(parallel[i].dash_cooldown == serial[i].dash_cooldown);
+  }
+}
@@ -3,8 +3,13 @@
 #include "map_world.h"
 #include "world_collision_mesh.h"
 
+#include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <limits>
+#include <random>
+#include <vector>
 
 TEST_CASE("LoadCollisionMeshRegistry parses and normalizes prefab ids") {
   const std::filesystem::path temp_path =
@@ -98,3 +103,169 @@ TEST_CASE("Bundled collision mesh registry covers generated map prefabs") {
       registry, static_world.building_prefab_ids);
   CHECK(static_missing.empty());
 }
+
+TEST_CASE("Collision mesh prefab BVH raycasts match a brute-force triangle scan") {
+  afps::world::CollisionMeshRegistry registry;
+  std::string error;
+  REQUIRE(afps::world::LoadCollisionMeshRegistry(registry, error));
+  REQUIRE(registry.prefabs.size() >= 4);
+
+  // The reference registry puts every triangle in a single root leaf, so it runs the same
+  // triangle test over the whole prefab.
+  afps::world::CollisionMeshRegistry reference;
+  std::vector<afps::world::CollisionMeshPrefabGeometry> geometry;
+  for (size_t p = 0; p < 4; ++p) {
+    const auto &prefab = registry.prefabs[p];
+    reference.prefabs.push_back(prefab);
+    afps::world::CollisionMeshPrefabGeometry flat;
+    for (size_t i = 0; i < prefab.triangles.size(); ++i) {
+      flat.triangles.push_back(prefab.triangles[i]);
+      flat.triangle_indices.push_back(static_cast<uint32_t>(i));
+    }
+    REQUIRE(flat.triangles.size() <= std::numeric_limits<uint16_t>::max());
+    afps::world::CollisionMeshPrefab::BvhNode root;
+    root.min_x = static_cast<float>(prefab.bounds.min_x - 1.0);
+    root.min_y = static_cast<float>(prefab.bounds.min_y - 1.0);
+    root.min_z = static_cast<float>(prefab.bounds.min_z - 1.0);
+    root.max_x = static_cast<float>(prefab.bounds.max_x + 1.0);
+    root.max_y = static_cast<float>(prefab.bounds.max_y + 1.0);
+    root.max_z = static_cast<float>(prefab.bounds.max_z + 1.0);
+    root.count = static_cast<uint16_t>(flat.triangles.size());
+    flat.bvh_nodes.push_back(root);
+    geometry.push_back(std::move(flat));
+
+    // Children sit inside their parent and every triangle index lands in exactly one leaf.
+    std::vector<uint32_t> covered(prefab.triangle_indices.size(), 0);
+    for (size_t n = 0; n < prefab.bvh_nodes.size(); ++n) {
+      const auto &node = prefab.bvh_nodes[n];
+      if (node.count > 0) {
+        REQUIRE(node.offset + node.count <= covered.size());
+        for (uint32_t i = node.offset; i < node.offset + node.count; ++i) {
+          covered[i] += 1;
+        }
+        continue;
+      }
+      REQUIRE(node.offset < prefab.bvh_nodes.size());
+      for (const size_t child : {n + 1, static_cast<size_t>(node.offset)}) {
+        CHECK(prefab.bvh_nodes[child].min_x >= node.min_x);
+        CHECK(prefab.bvh_nodes[child].max_z <= node.max_z);
+      }
+    }
+    CHECK(std::all_of(covered.begin(), covered.end(), [](uint32_t value) { return value == 1; }));
+  }
+  afps::world::AttachCollisionMeshGeometry(reference, geometry);
+
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> unit(-1.0, 1.0);
+  size_t hits = 0;
+  for (size_t p = 0; p < reference.prefabs.size(); ++p) {
+    const auto &bounds = registry.prefabs[p].bounds;
+    for (int i = 0; i < 400; ++i) {
+      const afps::sim::Vec3 origin{bounds.max_x * 2.0 * unit(rng), bounds.max_y * 2.0 * unit(rng),
+                                   bounds.min_z + (bounds.max_z - bounds.min_z) * (1.0 + unit(rng))};
+      afps::sim::Vec3 dir{unit(rng), unit(rng), unit(rng)};
+      const double len = std::sqrt(dir.x * dir.x + dir.y * dir.y + dir.z * dir.z);
+      if (len < 1e-6) {
+        continue;
+      }
+      dir = {dir.x / len, dir.y / len, dir.z / len};
+
+      afps::world::CollisionMeshRayHit expected;
+      afps::world::CollisionMeshRayHit actual;
+      const bool expected_hit =
+          afps::world::RaycastCollisionMeshPrefab(reference.prefabs[p], origin, dir, 100.0, expected);
+      const bool actual_hit =
+          afps::world::RaycastCollisionMeshPrefab(registry.prefabs[p], origin, dir, 100.0, actual);
+      REQUIRE(actual_hit == expected_hit);
+      if (expected_hit) {
+        ++hits;
+        CHECK(actual.t == expected.t);
+      }
+    }
+  }
+  CHECK(hits > 0);
+}
+
+TEST_CASE("Binary collision mesh registry maps the same geometry and checksum as JSON") {
+  const std::string json_path = afps::world::ResolveCollisionMeshRegistryPath();
+  const std::filesystem::path binary_path =
+      std::filesystem::temp_directory_path() / "afps_collision_mesh_registry_test.bin";
+
+  afps::world::CollisionMeshRegistry json_registry;
+  std::string error;
+  REQUIRE(afps::world::LoadCollisionMeshRegistry(json_path, json_registry, error));
+  REQUIRE(afps::world::PackCollisionMeshRegistry(json_path, binary_path.string(), error));
+  CHECK(afps::world::IsCollisionMeshBinaryCurrent(binary_path.string(), json_path));
+
+  afps::world::CollisionMeshBinaryInfo info;
+  REQUIRE(afps::world::ReadCollisionMeshBinaryInfo(binary_path.string(), info, error));
+  afps::world::CollisionMeshRegistry binary_registry;
+  REQUIRE(afps::world::LoadCollisionMeshRegistry(binary_path.string(), binary_registry, error));
+
+  const uint64_t json_checksum = afps::world::ComputeCollisionMeshRegistryChecksum(json_registry);
+  CHECK(afps::world::ComputeCollisionMeshRegistryChecksum(binary_registry) == json_checksum);
+  CHECK(info.checksum == json_checksum);
+  CHECK(binary_registry.version == json_registry.version);
+  CHECK(binary_registry.source_asset_pack == json_registry.source_asset_pack);
+  REQUIRE(binary_registry.prefabs.size() == json_registry.prefabs.size());
+  for (size_t i = 0; i < json_registry.prefabs.size(); ++i) {
+    const auto &expected = json_registry.prefabs[i];
+    const auto &actual = binary_registry.prefabs[i];
+    CHECK(actual.id == expected.id);
+    CHECK(actual.has_explicit_triangles == expected.has_explicit_triangles);
+    REQUIRE(actual.triangles.size() == expected.triangles.size());
+    REQUIRE(actual.triangle_indices.size() == expected.triangle_indices.size());
+    REQUIRE(actual.bvh_nodes.size() == expected.bvh_nodes.size());
+    CHECK(std::equal(actual.triangle_indices.begin(), actual.triangle_indices.end(),
+                     expected.triangle_indices.begin()));
+    for (size_t c = 0; c < afps::world::CollisionMeshPrefab::Triangles::kComponentCount; ++c) {
+      CHECK(std::equal(actual.triangles.component(c), actual.triangles.component(c) + actual.triangles.size(),
+                       expected.triangles.component(c)));
+    }
+    for (size_t n = 0; n < expected.bvh_nodes.size(); ++n) {
+      CHECK(actual.bvh_nodes[n].min_x == expected.bvh_nodes[n].min_x);
+      CHECK(actual.bvh_nodes[n].max_z == expected.bvh_nodes[n].max_z);
+      CHECK(actual.bvh_nodes[n].offset == expected.bvh_nodes[n].offset);
+      CHECK(actual.bvh_nodes[n].count == expected.bvh_nodes[n].count);
+      CHECK(actual.bvh_nodes[n].axis == expected.bvh_nodes[n].axis);
+    }
+  }
+
+  // Copies share the mapping, so views stay valid after the original is gone.
+  afps::world::CollisionMeshRegistry copy = binary_registry;
+  binary_registry = {};
+  CHECK(afps::world::ComputeCollisionMeshRegistryChecksum(copy) == json_checksum);
+
+  std::error_code ec;
+  std::filesystem::remove(binary_path, ec);
+}
+
+TEST_CASE("Binary collision mesh registry rejects truncated and stale files") {
+  const std::filesystem::path temp_dir = std::filesystem::temp_directory_path();
+  const std::filesystem::path json_path = temp_dir / "afps_collision_mesh_stale_test.json";
+  const std::filesystem::path binary_path = temp_dir / "afps_collision_mesh_stale_test.bin";
+  auto write_json = [&](int surface_type) {
+    std::ofstream out(json_path);
+    out << R"json({"version": 1, "prefabs": [{"id": "a.glb", "surfaceType": )json" << surface_type
+        << R"json(, "bounds": {"min": [0, 0, 0], "max": [1, 1, 1]}}]})json";
+  };
+
+  write_json(1);
+  std::string error;
+  REQUIRE(afps::world::PackCollisionMeshRegistry(json_path.string(), binary_path.string(), error));
+  CHECK(afps::world::ResolveCollisionMeshBinaryPath(json_path.string()) == binary_path.string());
+  CHECK(afps::world::IsCollisionMeshBinaryCurrent(binary_path.string(), json_path.string()));
+  write_json(2);
+  CHECK_FALSE(afps::world::IsCollisionMeshBinaryCurrent(binary_path.string(), json_path.string()));
+
+  const auto full_size = std::filesystem::file_size(binary_path);
+  std::filesystem::resize_file(binary_path, full_size - 4);
+  afps::world::CollisionMeshRegistry registry;
+  CHECK_FALSE(afps::world::LoadCollisionMeshRegistry(binary_path.string(), registry, error));
+  CHECK_FALSE(error.empty());
+  CHECK(registry.prefabs.empty());
+
+  std::error_code ec;
+  std::filesystem::remove(json_path, ec);
+  std::filesystem::remove(binary_path, ec);
+}
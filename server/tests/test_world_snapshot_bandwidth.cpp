@@ -0,0 +1,117 @@
+#include "doctest.h"
+
+#include <string>
+
+#include "protocol.h"
+
+namespace {
+// UDP/IPv4 + DTLS record + SCTP common header and DATA chunk, per datagram.
+constexpr size_t kTransportOverheadBytes = 8 + 20 + 29 + 12 + 16;
+
+StateSnapshot MakeSnapshot(int index) {
+  StateSnapshot snapshot;
+  snapshot.server_tick = 120;
+  snapshot.last_processed_input_seq = 118;
+  snapshot.client_id = "player-" + std::to_string(index);
+  snapshot.pos_x_q = QuantizeSnapshotPosition(10.0 + index);
+  snapshot.pos_y_q = QuantizeSnapshotPosition(-2.5);
+  snapshot.pos_z_q = QuantizeSnapshotPosition(0.5);
+  snapshot.vel_x_q = QuantizeSnapshotVelocity(2.0);
+  snapshot.weapon_slot = 1;
+  snapshot.ammo_in_mag = 30;
+  snapshot.dash_cooldown_q = QuantizeSnapshotDashCooldown(0.2);
+  snapshot.health_q = QuantizeSnapshotHealth(85.0);
+  snapshot.kills = 2;
+  snapshot.deaths = 1;
+  return snapshot;
+}
+
+StateSnapshotDelta MakeDelta(int index) {
+  StateSnapshotDelta delta;
+  delta.server_tick = 121;
+  delta.base_tick = 120;
+  delta.last_processed_input_seq = 119;
+  delta.mask = kSnapshotMaskPosX | kSnapshotMaskPosY | kSnapshotMaskVelX | kSnapshotMaskViewYawQ;
+  delta.client_id = "player-" + std::to_string(index);
+  delta.pos_x_q = QuantizeSnapshotPosition(10.1 + index);
+  delta.pos_y_q = QuantizeSnapshotPosition(-2.4);
+  delta.vel_x_q = QuantizeSnapshotVelocity(2.1);
+  delta.view_yaw_q = 1200;
+  return delta;
+}
+}  // namespace
+
+TEST_CASE("World snapshots cut per-recipient packets and bytes") {
+  constexpr int kPlayers = 48;
+
+  WorldSnapshot keyframes;
+  keyframes.server_tick = 120;
+  WorldSnapshot deltas;
+  deltas.server_tick = 121;
+  size_t legacy_keyframe_bytes = 0;
+  size_t legacy_delta_bytes = 0;
+  for (int i = 0; i < kPlayers; ++i) {
+    keyframes.snapshots.push_back(MakeSnapshot(i));
+    deltas.deltas.push_back(MakeDelta(i));
+    legacy_keyframe_bytes += BuildStateSnapshot(keyframes.snapshots.back(), 1, 0).size() + kTransportOverheadBytes;
+    legacy_delta_bytes += BuildStateSnapshotDelta(deltas.deltas.back(), 1, 0).size() + kTransportOverheadBytes;
+  }
+
+  const auto keyframe_packets = BuildWorldSnapshotPackets(keyframes);
+  const auto delta_packets = BuildWorldSnapshotPackets(deltas);
+  size_t world_keyframe_bytes = 0;
+  for (const auto &packet : keyframe_packets) {
+    CHECK(packet.message.size() <= kMaxSnapshotPacketBytes);
+    world_keyframe_bytes += packet.message.size() + kTransportOverheadBytes;
+  }
+  size_t world_delta_bytes = 0;
+  for (const auto &packet : delta_packets) {
+    CHECK(packet.message.size() <= kMaxSnapshotPacketBytes);
+    world_delta_bytes += packet.message.size() + kTransportOverheadBytes;
+  }
+
+  MESSAGE("keyframe packets " << kPlayers << " -> " << keyframe_packets.size() << ", bytes "
+                              << legacy_keyframe_bytes << " -> " << world_keyframe_bytes);
+  MESSAGE("delta packets " << kPlayers << " -> " << delta_packets.size() << ", bytes " << legacy_delta_bytes
+                           << " -> " << world_delta_bytes);
+
+  CHECK(keyframe_packets.size() * 4 <= static_cast<size_t>(kPlayers));
+  CHECK(delta_packets.size() * 4 <= static_cast<size_t>(kPlayers));
+  CHECK(world_keyframe_bytes < legacy_keyframe_bytes);
+  CHECK(world_delta_bytes < legacy_delta_bytes);
+
+  const int interval = kSnapshotKeyframeInterval > 0 ? kSnapshotKeyframeInterval : 1;
+  const double legacy_packets_per_second =
+      static_cast<double>(kPlayers) * static_cast<double>(kSnapshotRate);
+  const double world_packets_per_second =
+      (static_cast<double>(keyframe_packets.size()) +
+       static_cast<double>(interval - 1) * static_cast<double>(delta_packets.size())) /
+      static_cast<double>(interval) * static_cast<double>(kSnapshotRate);
+  CHECK(world_packets_per_second * 4.0 <= legacy_packets_per_second);
+}
+
+TEST_CASE("Quantized world snapshot entries stay compact") {
+  constexpr int kPlayers = 48;
+  WorldSnapshot keyframes;
+  keyframes.server_tick = 120;
+  WorldSnapshot deltas;
+  deltas.server_tick = 121;
+  for (int i = 0; i < kPlayers; ++i) {
+    keyframes.snapshots.push_back(MakeSnapshot(i));
+    deltas.deltas.push_back(MakeDelta(i));
+  }
+  size_t keyframe_bytes = 0;
+  for (const auto &packet : BuildWorldSnapshotPackets(keyframes)) {
+    keyframe_bytes += packet.message.size();
+  }
+  size_t delta_bytes = 0;
+  for (const auto &packet : BuildWorldSnapshotPackets(deltas)) {
+    delta_bytes += packet.message.size();
+  }
+  MESSAGE("bytes per player: keyframe " << keyframe_bytes / kPlayers << ", delta " << delta_bytes / kPlayers);
+
+  // With doubles on the wire these entries cost ~107 (keyframe) and ~84 (delta) bytes per player; the
+  // client_id string and table offsets are now most of what remains.
+  CHECK(keyframe_bytes <= static_cast<size_t>(kPlayers) * 64);
+  CHECK(delta_bytes <= static_cast<size_t>(kPlayers) * 56);
+}
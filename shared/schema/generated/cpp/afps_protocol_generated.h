@@ -84,10 +84,16 @@ struct JoinAccept;
 struct JoinAcceptBuilder;
 struct JoinAcceptT;
 
+struct InputFrame;
+
 struct InputCmd;
 struct InputCmdBuilder;
 struct InputCmdT;
 
+struct DecalDebugReport;
+struct DecalDebugReportBuilder;
+struct DecalDebugReportT;
+
 struct FireWeaponRequest;
 struct FireWeaponRequestBuilder;
 struct FireWeaponRequestT;
@@ -128,6 +134,10 @@ struct Disconnect;
 struct DisconnectBuilder;
 struct DisconnectT;
 
+struct WorldSnapshot;
+struct WorldSnapshotBuilder;
+struct WorldSnapshotT;
+
 enum class SchemaVersion : uint16_t {
   V1 = 1,
   MIN = V1,
@@ -171,11 +181,13 @@ enum class MessageType : uint16_t {
   Disconnect = 13,
   FireWeaponRequest = 14,
   SetLoadoutRequest = 15,
+  WorldSnapshot = 16,
+  DecalDebugReport = 17,
   MIN = ClientHello,
-  MAX = SetLoadoutRequest
+  MAX = DecalDebugReport
 };
 
-inline const MessageType (&EnumValuesMessageType())[15] {
+inline const MessageType (&EnumValuesMessageType())[17] {
   static const MessageType values[] = {
     MessageType::ClientHello,
     MessageType::ServerHello,
@@ -191,13 +203,15 @@ inline const MessageType (&EnumValuesMessageType())[15] {
     MessageType::Error,
     MessageType::Disconnect,
     MessageType::FireWeaponRequest,
-    MessageType::SetLoadoutRequest
+    MessageType::SetLoadoutRequest,
+    MessageType::WorldSnapshot,
+    MessageType::DecalDebugReport
   };
   return values;
 }
 
 inline const char * const *EnumNamesMessageType() {
-  static const char * const names[16] = {
+  static const char * const names[18] = {
     "ClientHello",
     "ServerHello",
     "JoinRequest",
@@ -213,13 +227,15 @@ inline const char * const *EnumNamesMessageType() {
     "Disconnect",
     "FireWeaponRequest",
     "SetLoadoutRequest",
+    "WorldSnapshot",
+    "DecalDebugReport",
     nullptr
   };
   return names;
 }
 
 inline const char *EnumNameMessageType(MessageType e) {
-  if (::flatbuffers::IsOutRange(e, MessageType::ClientHello, MessageType::SetLoadoutRequest)) return "";
+  if (::flatbuffers::IsOutRange(e, MessageType::ClientHello, MessageType::DecalDebugReport)) return "";
   const size_t index = static_cast<size_t>(e) - static_cast<size_t>(MessageType::ClientHello);
   return EnumNamesMessageType()[index];
 }
@@ -645,6 +661,68 @@ bool VerifyFxEvent(::flatbuffers::VerifierTemplate<B> &verifier, const void *obj
 template <bool B = false>
 bool VerifyFxEventVector(::flatbuffers::VerifierTemplate<B> &verifier, const ::flatbuffers::Vector<::flatbuffers::Offset<void>> *values, const ::flatbuffers::Vector<FxEvent> *types);
 
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) InputFrame FLATBUFFERS_FINAL_CLASS {
+ private:
+  int32_t input_seq_;
+  int8_t move_x_q_;
+  int8_t move_y_q_;
+  uint16_t buttons_;
+  int16_t view_yaw_q_;
+  int16_t view_pitch_q_;
+  uint8_t weapon_slot_;
+  int8_t padding0__;  int16_t padding1__;
+
+ public:
+  InputFrame()
+      : input_seq_(0),
+        move_x_q_(0),
+        move_y_q_(0),
+        buttons_(0),
+        view_yaw_q_(0),
+        view_pitch_q_(0),
+        weapon_slot_(0),
+        padding0__(0),
+        padding1__(0) {
+    (void)padding0__;
+    (void)padding1__;
+  }
+  InputFrame(int32_t _input_seq, int8_t _move_x_q, int8_t _move_y_q, uint16_t _buttons, int16_t _view_yaw_q, int16_t _view_pitch_q, uint8_t _weapon_slot)
+      : input_seq_(::flatbuffers::EndianScalar(_input_seq)),
+        move_x_q_(::flatbuffers::EndianScalar(_move_x_q)),
+        move_y_q_(::flatbuffers::EndianScalar(_move_y_q)),
+        buttons_(::flatbuffers::EndianScalar(_buttons)),
+        view_yaw_q_(::flatbuffers::EndianScalar(_view_yaw_q)),
+        view_pitch_q_(::flatbuffers::EndianScalar(_view_pitch_q)),
+        weapon_slot_(::flatbuffers::EndianScalar(_weapon_slot)),
+        padding0__(0),
+        padding1__(0) {
+    (void)padding0__;
+    (void)padding1__;
+  }
+  int32_t input_seq() const {
+    return ::flatbuffers::EndianScalar(input_seq_);
+  }
+  int8_t move_x_q() const {
+    return ::flatbuffers::EndianScalar(move_x_q_);
+  }
+  int8_t move_y_q() const {
+    return ::flatbuffers::EndianScalar(move_y_q_);
+  }
+  uint16_t buttons() const {
+    return ::flatbuffers::EndianScalar(buttons_);
+  }
+  int16_t view_yaw_q() const {
+    return ::flatbuffers::EndianScalar(view_yaw_q_);
+  }
+  int16_t view_pitch_q() const {
+    return ::flatbuffers::EndianScalar(view_pitch_q_);
+  }
+  uint8_t weapon_slot() const {
+    return ::flatbuffers::EndianScalar(weapon_slot_);
+  }
+};
+FLATBUFFERS_STRUCT_END(InputFrame, 16);
+
 struct ShotFiredFxT : public ::flatbuffers::NativeTable {
   typedef ShotFiredFx TableType;
   std::string shooter_id{};
@@ -2549,485 +2627,413 @@ inline ::flatbuffers::Offset<JoinAccept> CreateJoinAcceptDirect(
 
 struct InputCmdT : public ::flatbuffers::NativeTable {
   typedef InputCmd TableType;
-  int32_t input_seq = 0;
-  double move_x = 0.0;
-  double move_y = 0.0;
-  double look_delta_x = 0.0;
-  double look_delta_y = 0.0;
-  double view_yaw = 0.0;
-  double view_pitch = 0.0;
-  int32_t weapon_slot = 0;
-  bool jump = false;
-  bool fire = false;
-  bool ads = false;
-  bool sprint = false;
-  bool dash = false;
-  bool grapple = false;
-  bool shield = false;
-  bool shockwave = false;
-  bool crouch = false;
-  bool debug_decal_report_present = false;
-  int32_t debug_decal_server_tick = 0;
-  int32_t debug_decal_shot_seq = 0;
-  uint8_t debug_decal_hit_kind = 0;
-  uint8_t debug_decal_surface_type = 0;
-  bool debug_decal_authoritative_world_hit = false;
-  bool debug_decal_used_projected_hit = false;
-  bool debug_decal_used_impact_projection = false;
-  bool debug_decal_spawned = false;
-  bool debug_decal_in_frustum = false;
-  double debug_decal_distance = -1.0;
-  double debug_decal_position_x = 0.0;
-  double debug_decal_position_y = 0.0;
-  double debug_decal_position_z = 0.0;
-  double debug_decal_normal_x = 0.0;
-  double debug_decal_normal_y = 0.0;
-  double debug_decal_normal_z = 0.0;
-  double debug_trace_hit_position_x = 0.0;
-  double debug_trace_hit_position_y = 0.0;
-  double debug_trace_hit_position_z = 0.0;
-  double debug_trace_hit_normal_x = 0.0;
-  double debug_trace_hit_normal_y = 0.0;
-  double debug_trace_hit_normal_z = 0.0;
+  std::vector<afps::protocol::InputFrame> frames{};
+  uint32_t server_seq_ack_bits = 0;
 };
 
 struct InputCmd FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef InputCmdT NativeTableType;
   typedef InputCmdBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
-    VT_INPUT_SEQ = 4,
-    VT_MOVE_X = 6,
-    VT_MOVE_Y = 8,
-    VT_LOOK_DELTA_X = 10,
-    VT_LOOK_DELTA_Y = 12,
-    VT_VIEW_YAW = 14,
-    VT_VIEW_PITCH = 16,
-    VT_WEAPON_SLOT = 18,
-    VT_JUMP = 20,
-    VT_FIRE = 22,
-    VT_ADS = 24,
-    VT_SPRINT = 26,
-    VT_DASH = 28,
-    VT_GRAPPLE = 30,
-    VT_SHIELD = 32,
-    VT_SHOCKWAVE = 34,
-    VT_CROUCH = 36,
-    VT_DEBUG_DECAL_REPORT_PRESENT = 38,
-    VT_DEBUG_DECAL_SERVER_TICK = 40,
-    VT_DEBUG_DECAL_SHOT_SEQ = 42,
-    VT_DEBUG_DECAL_HIT_KIND = 44,
-    VT_DEBUG_DECAL_SURFACE_TYPE = 46,
-    VT_DEBUG_DECAL_AUTHORITATIVE_WORLD_HIT = 48,
-    VT_DEBUG_DECAL_USED_PROJECTED_HIT = 50,
-    VT_DEBUG_DECAL_USED_IMPACT_PROJECTION = 52,
-    VT_DEBUG_DECAL_SPAWNED = 54,
-    VT_DEBUG_DECAL_IN_FRUSTUM = 56,
-    VT_DEBUG_DECAL_DISTANCE = 58,
-    VT_DEBUG_DECAL_POSITION_X = 60,
-    VT_DEBUG_DECAL_POSITION_Y = 62,
-    VT_DEBUG_DECAL_POSITION_Z = 64,
-    VT_DEBUG_DECAL_NORMAL_X = 66,
-    VT_DEBUG_DECAL_NORMAL_Y = 68,
-    VT_DEBUG_DECAL_NORMAL_Z = 70,
-    VT_DEBUG_TRACE_HIT_POSITION_X = 72,
-    VT_DEBUG_TRACE_HIT_POSITION_Y = 74,
-    VT_DEBUG_TRACE_HIT_POSITION_Z = 76,
-    VT_DEBUG_TRACE_HIT_NORMAL_X = 78,
-    VT_DEBUG_TRACE_HIT_NORMAL_Y = 80,
-    VT_DEBUG_TRACE_HIT_NORMAL_Z = 82
+    VT_FRAMES = 4,
+    VT_SERVER_SEQ_ACK_BITS = 6
   };
-  int32_t input_seq() const {
-    return GetField<int32_t>(VT_INPUT_SEQ, 0);
-  }
-  double move_x() const {
-    return GetField<double>(VT_MOVE_X, 0.0);
-  }
-  double move_y() const {
-    return GetField<double>(VT_MOVE_Y, 0.0);
+  const ::flatbuffers::Vector<const afps::protocol::InputFrame *> *frames() const {
+    return GetPointer<const ::flatbuffers::Vector<const afps::protocol::InputFrame *> *>(VT_FRAMES);
   }
-  double look_delta_x() const {
-    return GetField<double>(VT_LOOK_DELTA_X, 0.0);
-  }
-  double look_delta_y() const {
-    return GetField<double>(VT_LOOK_DELTA_Y, 0.0);
-  }
-  double view_yaw() const {
-    return GetField<double>(VT_VIEW_YAW, 0.0);
-  }
-  double view_pitch() const {
-    return GetField<double>(VT_VIEW_PITCH, 0.0);
-  }
-  int32_t weapon_slot() const {
-    return GetField<int32_t>(VT_WEAPON_SLOT, 0);
+  uint32_t server_seq_ack_bits() const {
+    return GetField<uint32_t>(VT_SERVER_SEQ_ACK_BITS, 0);
   }
-  bool jump() const {
-    return GetField<uint8_t>(VT_JUMP, 0) != 0;
-  }
-  bool fire() const {
-    return GetField<uint8_t>(VT_FIRE, 0) != 0;
-  }
-  bool ads() const {
-    return GetField<uint8_t>(VT_ADS, 0) != 0;
-  }
-  bool sprint() const {
-    return GetField<uint8_t>(VT_SPRINT, 0) != 0;
-  }
-  bool dash() const {
-    return GetField<uint8_t>(VT_DASH, 0) != 0;
-  }
-  bool grapple() const {
-    return GetField<uint8_t>(VT_GRAPPLE, 0) != 0;
+  template <bool B = false>
+  bool Verify(::flatbuffers::VerifierTemplate<B> &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_FRAMES) &&
+           verifier.VerifyVector(frames()) &&
+           VerifyField<uint32_t>(verifier, VT_SERVER_SEQ_ACK_BITS, 4) &&
+           verifier.EndTable();
   }
-  bool shield() const {
-    return GetField<uint8_t>(VT_SHIELD, 0) != 0;
+  InputCmdT *UnPack(const ::flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(InputCmdT *_o, const ::flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static ::flatbuffers::Offset<InputCmd> Pack(::flatbuffers::FlatBufferBuilder &_fbb, const InputCmdT* _o, const ::flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct InputCmdBuilder {
+  typedef InputCmd Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_frames(::flatbuffers::Offset<::flatbuffers::Vector<const afps::protocol::InputFrame *>> frames) {
+    fbb_.AddOffset(InputCmd::VT_FRAMES, frames);
   }
-  bool shockwave() const {
-    return GetField<uint8_t>(VT_SHOCKWAVE, 0) != 0;
+  void add_server_seq_ack_bits(uint32_t server_seq_ack_bits) {
+    fbb_.AddElement<uint32_t>(InputCmd::VT_SERVER_SEQ_ACK_BITS, server_seq_ack_bits, 0);
   }
-  bool crouch() const {
-    return GetField<uint8_t>(VT_CROUCH, 0) != 0;
+  explicit InputCmdBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
   }
-  bool debug_decal_report_present() const {
-    return GetField<uint8_t>(VT_DEBUG_DECAL_REPORT_PRESENT, 0) != 0;
+  ::flatbuffers::Offset<InputCmd> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<InputCmd>(end);
+    return o;
   }
-  int32_t debug_decal_server_tick() const {
-    return GetField<int32_t>(VT_DEBUG_DECAL_SERVER_TICK, 0);
+};
+
+inline ::flatbuffers::Offset<InputCmd> CreateInputCmd(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    ::flatbuffers::Offset<::flatbuffers::Vector<const afps::protocol::InputFrame *>> frames = 0,
+    uint32_t server_seq_ack_bits = 0) {
+  InputCmdBuilder builder_(_fbb);
+  builder_.add_server_seq_ack_bits(server_seq_ack_bits);
+  builder_.add_frames(frames);
+  return builder_.Finish();
+}
+
+inline ::flatbuffers::Offset<InputCmd> CreateInputCmdDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<afps::protocol::InputFrame> *frames = nullptr,
+    uint32_t server_seq_ack_bits = 0) {
+  auto frames__ = frames ? _fbb.CreateVectorOfStructs<afps::protocol::InputFrame>(*frames) : 0;
+  return afps::protocol::CreateInputCmd(
+      _fbb,
+      frames__,
+      server_seq_ack_bits);
+}
+
+::flatbuffers::Offset<InputCmd> CreateInputCmd(::flatbuffers::FlatBufferBuilder &_fbb, const InputCmdT *_o, const ::flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct DecalDebugReportT : public ::flatbuffers::NativeTable {
+  typedef DecalDebugReport TableType;
+  int32_t server_tick = 0;
+  int32_t shot_seq = 0;
+  uint8_t hit_kind = 0;
+  uint8_t surface_type = 0;
+  bool authoritative_world_hit = false;
+  bool used_projected_hit = false;
+  bool used_impact_projection = false;
+  bool decal_spawned = false;
+  bool decal_in_frustum = false;
+  double decal_distance = -1.0;
+  double decal_position_x = 0.0;
+  double decal_position_y = 0.0;
+  double decal_position_z = 0.0;
+  double decal_normal_x = 0.0;
+  double decal_normal_y = 0.0;
+  double decal_normal_z = 0.0;
+  double trace_hit_position_x = 0.0;
+  double trace_hit_position_y = 0.0;
+  double trace_hit_position_z = 0.0;
+  double trace_hit_normal_x = 0.0;
+  double trace_hit_normal_y = 0.0;
+  double trace_hit_normal_z = 0.0;
+};
+
+struct DecalDebugReport FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef DecalDebugReportT NativeTableType;
+  typedef DecalDebugReportBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_SERVER_TICK = 4,
+    VT_SHOT_SEQ = 6,
+    VT_HIT_KIND = 8,
+    VT_SURFACE_TYPE = 10,
+    VT_AUTHORITATIVE_WORLD_HIT = 12,
+    VT_USED_PROJECTED_HIT = 14,
+    VT_USED_IMPACT_PROJECTION = 16,
+    VT_DECAL_SPAWNED = 18,
+    VT_DECAL_IN_FRUSTUM = 20,
+    VT_DECAL_DISTANCE = 22,
+    VT_DECAL_POSITION_X = 24,
+    VT_DECAL_POSITION_Y = 26,
+    VT_DECAL_POSITION_Z = 28,
+    VT_DECAL_NORMAL_X = 30,
+    VT_DECAL_NORMAL_Y = 32,
+    VT_DECAL_NORMAL_Z = 34,
+    VT_TRACE_HIT_POSITION_X = 36,
+    VT_TRACE_HIT_POSITION_Y = 38,
+    VT_TRACE_HIT_POSITION_Z = 40,
+    VT_TRACE_HIT_NORMAL_X = 42,
+    VT_TRACE_HIT_NORMAL_Y = 44,
+    VT_TRACE_HIT_NORMAL_Z = 46
+  };
+  int32_t server_tick() const {
+    return GetField<int32_t>(VT_SERVER_TICK, 0);
   }
-  int32_t debug_decal_shot_seq() const {
-    return GetField<int32_t>(VT_DEBUG_DECAL_SHOT_SEQ, 0);
+  int32_t shot_seq() const {
+    return GetField<int32_t>(VT_SHOT_SEQ, 0);
   }
-  uint8_t debug_decal_hit_kind() const {
-    return GetField<uint8_t>(VT_DEBUG_DECAL_HIT_KIND, 0);
+  uint8_t hit_kind() const {
+    return GetField<uint8_t>(VT_HIT_KIND, 0);
   }
-  uint8_t debug_decal_surface_type() const {
-    return GetField<uint8_t>(VT_DEBUG_DECAL_SURFACE_TYPE, 0);
+  uint8_t surface_type() const {
+    return GetField<uint8_t>(VT_SURFACE_TYPE, 0);
   }
-  bool debug_decal_authoritative_world_hit() const {
-    return GetField<uint8_t>(VT_DEBUG_DECAL_AUTHORITATIVE_WORLD_HIT, 0) != 0;
+  bool authoritative_world_hit() const {
+    return GetField<uint8_t>(VT_AUTHORITATIVE_WORLD_HIT, 0) != 0;
   }
-  bool debug_decal_used_projected_hit() const {
-    return GetField<uint8_t>(VT_DEBUG_DECAL_USED_PROJECTED_HIT, 0) != 0;
+  bool used_projected_hit() const {
+    return GetField<uint8_t>(VT_USED_PROJECTED_HIT, 0) != 0;
   }
-  bool debug_decal_used_impact_projection() const {
-    return GetField<uint8_t>(VT_DEBUG_DECAL_USED_IMPACT_PROJECTION, 0) != 0;
+  bool used_impact_projection() const {
+    return GetField<uint8_t>(VT_USED_IMPACT_PROJECTION, 0) != 0;
   }
-  bool debug_decal_spawned() const {
-    return GetField<uint8_t>(VT_DEBUG_DECAL_SPAWNED, 0) != 0;
+  bool decal_spawned() const {
+    return GetField<uint8_t>(VT_DECAL_SPAWNED, 0) != 0;
   }
-  bool debug_decal_in_frustum() const {
-    return GetField<uint8_t>(VT_DEBUG_DECAL_IN_FRUSTUM, 0) != 0;
+  bool decal_in_frustum() const {
+    return GetField<uint8_t>(VT_DECAL_IN_FRUSTUM, 0) != 0;
   }
-  double debug_decal_distance() const {
-    return GetField<double>(VT_DEBUG_DECAL_DISTANCE, -1.0);
+  double decal_distance() const {
+    return GetField<double>(VT_DECAL_DISTANCE, -1.0);
   }
-  double debug_decal_position_x() const {
-    return GetField<double>(VT_DEBUG_DECAL_POSITION_X, 0.0);
+  double decal_position_x() const {
+    return GetField<double>(VT_DECAL_POSITION_X, 0.0);
   }
-  double debug_decal_position_y() const {
-    return GetField<double>(VT_DEBUG_DECAL_POSITION_Y, 0.0);
+  double decal_position_y() const {
+    return GetField<double>(VT_DECAL_POSITION_Y, 0.0);
   }
-  double debug_decal_position_z() const {
-    return GetField<double>(VT_DEBUG_DECAL_POSITION_Z, 0.0);
+  double decal_position_z() const {
+    return GetField<double>(VT_DECAL_POSITION_Z, 0.0);
   }
-  double debug_decal_normal_x() const {
-    return GetField<double>(VT_DEBUG_DECAL_NORMAL_X, 0.0);
+  double decal_normal_x() const {
+    return GetField<double>(VT_DECAL_NORMAL_X, 0.0);
   }
-  double debug_decal_normal_y() const {
-    return GetField<double>(VT_DEBUG_DECAL_NORMAL_Y, 0.0);
+  double decal_normal_y() const {
+    return GetField<double>(VT_DECAL_NORMAL_Y, 0.0);
   }
-  double debug_decal_normal_z() const {
-    return GetField<double>(VT_DEBUG_DECAL_NORMAL_Z, 0.0);
+  double decal_normal_z() const {
+    return GetField<double>(VT_DECAL_NORMAL_Z, 0.0);
   }
-  double debug_trace_hit_position_x() const {
-    return GetField<double>(VT_DEBUG_TRACE_HIT_POSITION_X, 0.0);
+  double trace_hit_position_x() const {
+    return GetField<double>(VT_TRACE_HIT_POSITION_X, 0.0);
   }
-  double debug_trace_hit_position_y() const {
-    return GetField<double>(VT_DEBUG_TRACE_HIT_POSITION_Y, 0.0);
+  double trace_hit_position_y() const {
+    return GetField<double>(VT_TRACE_HIT_POSITION_Y, 0.0);
   }
-  double debug_trace_hit_position_z() const {
-    return GetField<double>(VT_DEBUG_TRACE_HIT_POSITION_Z, 0.0);
+  double trace_hit_position_z() const {
+    return GetField<double>(VT_TRACE_HIT_POSITION_Z, 0.0);
   }
-  double debug_trace_hit_normal_x() const {
-    return GetField<double>(VT_DEBUG_TRACE_HIT_NORMAL_X, 0.0);
+  double trace_hit_normal_x() const {
+    return GetField<double>(VT_TRACE_HIT_NORMAL_X, 0.0);
   }
-  double debug_trace_hit_normal_y() const {
-    return GetField<double>(VT_DEBUG_TRACE_HIT_NORMAL_Y, 0.0);
+  double trace_hit_normal_y() const {
+    return GetField<double>(VT_TRACE_HIT_NORMAL_Y, 0.0);
   }
-  double debug_trace_hit_normal_z() const {
-    return GetField<double>(VT_DEBUG_TRACE_HIT_NORMAL_Z, 0.0);
+  double trace_hit_normal_z() const {
+    return GetField<double>(VT_TRACE_HIT_NORMAL_Z, 0.0);
   }
   template <bool B = false>
   bool Verify(::flatbuffers::VerifierTemplate<B> &verifier) const {
     return VerifyTableStart(verifier) &&
-           VerifyField<int32_t>(verifier, VT_INPUT_SEQ, 4) &&
-           VerifyField<double>(verifier, VT_MOVE_X, 8) &&
-           VerifyField<double>(verifier, VT_MOVE_Y, 8) &&
-           VerifyField<double>(verifier, VT_LOOK_DELTA_X, 8) &&
-           VerifyField<double>(verifier, VT_LOOK_DELTA_Y, 8) &&
-           VerifyField<double>(verifier, VT_VIEW_YAW, 8) &&
-           VerifyField<double>(verifier, VT_VIEW_PITCH, 8) &&
-           VerifyField<int32_t>(verifier, VT_WEAPON_SLOT, 4) &&
-           VerifyField<uint8_t>(verifier, VT_JUMP, 1) &&
-           VerifyField<uint8_t>(verifier, VT_FIRE, 1) &&
-           VerifyField<uint8_t>(verifier, VT_ADS, 1) &&
-           VerifyField<uint8_t>(verifier, VT_SPRINT, 1) &&
-           VerifyField<uint8_t>(verifier, VT_DASH, 1) &&
-           VerifyField<uint8_t>(verifier, VT_GRAPPLE, 1) &&
-           VerifyField<uint8_t>(verifier, VT_SHIELD, 1) &&
-           VerifyField<uint8_t>(verifier, VT_SHOCKWAVE, 1) &&
-           VerifyField<uint8_t>(verifier, VT_CROUCH, 1) &&
-           VerifyField<uint8_t>(verifier, VT_DEBUG_DECAL_REPORT_PRESENT, 1) &&
-           VerifyField<int32_t>(verifier, VT_DEBUG_DECAL_SERVER_TICK, 4) &&
-           VerifyField<int32_t>(verifier, VT_DEBUG_DECAL_SHOT_SEQ, 4) &&
-           VerifyField<uint8_t>(verifier, VT_DEBUG_DECAL_HIT_KIND, 1) &&
-           VerifyField<uint8_t>(verifier, VT_DEBUG_DECAL_SURFACE_TYPE, 1) &&
-           VerifyField<uint8_t>(verifier, VT_DEBUG_DECAL_AUTHORITATIVE_WORLD_HIT, 1) &&
-           VerifyField<uint8_t>(verifier, VT_DEBUG_DECAL_USED_PROJECTED_HIT, 1) &&
-           VerifyField<uint8_t>(verifier, VT_DEBUG_DECAL_USED_IMPACT_PROJECTION, 1) &&
-           VerifyField<uint8_t>(verifier, VT_DEBUG_DECAL_SPAWNED, 1) &&
-           VerifyField<uint8_t>(verifier, VT_DEBUG_DECAL_IN_FRUSTUM, 1) &&
-           VerifyField<double>(verifier, VT_DEBUG_DECAL_DISTANCE, 8) &&
-           VerifyField<double>(verifier, VT_DEBUG_DECAL_POSITION_X, 8) &&
-           VerifyField<double>(verifier, VT_DEBUG_DECAL_POSITION_Y, 8) &&
-           VerifyField<double>(verifier, VT_DEBUG_DECAL_POSITION_Z, 8) &&
-           VerifyField<double>(verifier, VT_DEBUG_DECAL_NORMAL_X, 8) &&
-           VerifyField<double>(verifier, VT_DEBUG_DECAL_NORMAL_Y, 8) &&
-           VerifyField<double>(verifier, VT_DEBUG_DECAL_NORMAL_Z, 8) &&
-           VerifyField<double>(verifier, VT_DEBUG_TRACE_HIT_POSITION_X, 8) &&
-           VerifyField<double>(verifier, VT_DEBUG_TRACE_HIT_POSITION_Y, 8) &&
-           VerifyField<double>(verifier, VT_DEBUG_TRACE_HIT_POSITION_Z, 8) &&
-           VerifyField<double>(verifier, VT_DEBUG_TRACE_HIT_NORMAL_X, 8) &&
-           VerifyField<double>(verifier, VT_DEBUG_TRACE_HIT_NORMAL_Y, 8) &&
-           VerifyField<double>(verifier, VT_DEBUG_TRACE_HIT_NORMAL_Z, 8) &&
+           VerifyField<int32_t>(verifier, VT_SERVER_TICK, 4) &&
+           VerifyField<int32_t>(verifier, VT_SHOT_SEQ, 4) &&
+           VerifyField<uint8_t>(verifier, VT_HIT_KIND, 1) &&
+           VerifyField<uint8_t>(verifier, VT_SURFACE_TYPE, 1) &&
+           VerifyField<uint8_t>(verifier, VT_AUTHORITATIVE_WORLD_HIT, 1) &&
+           VerifyField<uint8_t>(verifier, VT_USED_PROJECTED_HIT, 1) &&
+           VerifyField<uint8_t>(verifier, VT_USED_IMPACT_PROJECTION, 1) &&
+           VerifyField<uint8_t>(verifier, VT_DECAL_SPAWNED, 1) &&
+           VerifyField<uint8_t>(verifier, VT_DECAL_IN_FRUSTUM, 1) &&
+           VerifyField<double>(verifier, VT_DECAL_DISTANCE, 8) &&
+           VerifyField<double>(verifier, VT_DECAL_POSITION_X, 8) &&
+           VerifyField<double>(verifier, VT_DECAL_POSITION_Y, 8) &&
+           VerifyField<double>(verifier, VT_DECAL_POSITION_Z, 8) &&
+           VerifyField<double>(verifier, VT_DECAL_NORMAL_X, 8) &&
+           VerifyField<double>(verifier, VT_DECAL_NORMAL_Y, 8) &&
+           VerifyField<double>(verifier, VT_DECAL_NORMAL_Z, 8) &&
+           VerifyField<double>(verifier, VT_TRACE_HIT_POSITION_X, 8) &&
+           VerifyField<double>(verifier, VT_TRACE_HIT_POSITION_Y, 8) &&
+           VerifyField<double>(verifier, VT_TRACE_HIT_POSITION_Z, 8) &&
+           VerifyField<double>(verifier, VT_TRACE_HIT_NORMAL_X, 8) &&
+           VerifyField<double>(verifier, VT_TRACE_HIT_NORMAL_Y, 8) &&
+           VerifyField<double>(verifier, VT_TRACE_HIT_NORMAL_Z, 8) &&
            verifier.EndTable();
   }
-  InputCmdT *UnPack(const ::flatbuffers::resolver_function_t *_resolver = nullptr) const;
-  void UnPackTo(InputCmdT *_o, const ::flatbuffers::resolver_function_t *_resolver = nullptr) const;
-  static ::flatbuffers::Offset<InputCmd> Pack(::flatbuffers::FlatBufferBuilder &_fbb, const InputCmdT* _o, const ::flatbuffers::rehasher_function_t *_rehasher = nullptr);
+  DecalDebugReportT *UnPack(const ::flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(DecalDebugReportT *_o, const ::flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static ::flatbuffers::Offset<DecalDebugReport> Pack(::flatbuffers::FlatBufferBuilder &_fbb, const DecalDebugReportT* _o, const ::flatbuffers::rehasher_function_t *_rehasher = nullptr);
 };
 
-struct InputCmdBuilder {
-  typedef InputCmd Table;
+struct DecalDebugReportBuilder {
+  typedef DecalDebugReport Table;
   ::flatbuffers::FlatBufferBuilder &fbb_;
   ::flatbuffers::uoffset_t start_;
-  void add_input_seq(int32_t input_seq) {
-    fbb_.AddElement<int32_t>(InputCmd::VT_INPUT_SEQ, input_seq, 0);
-  }
-  void add_move_x(double move_x) {
-    fbb_.AddElement<double>(InputCmd::VT_MOVE_X, move_x, 0.0);
-  }
-  void add_move_y(double move_y) {
-    fbb_.AddElement<double>(InputCmd::VT_MOVE_Y, move_y, 0.0);
-  }
-  void add_look_delta_x(double look_delta_x) {
-    fbb_.AddElement<double>(InputCmd::VT_LOOK_DELTA_X, look_delta_x, 0.0);
-  }
-  void add_look_delta_y(double look_delta_y) {
-    fbb_.AddElement<double>(InputCmd::VT_LOOK_DELTA_Y, look_delta_y, 0.0);
-  }
-  void add_view_yaw(double view_yaw) {
-    fbb_.AddElement<double>(InputCmd::VT_VIEW_YAW, view_yaw, 0.0);
-  }
-  void add_view_pitch(double view_pitch) {
-    fbb_.AddElement<double>(InputCmd::VT_VIEW_PITCH, view_pitch, 0.0);
-  }
-  void add_weapon_slot(int32_t weapon_slot) {
-    fbb_.AddElement<int32_t>(InputCmd::VT_WEAPON_SLOT, weapon_slot, 0);
-  }
-  void add_jump(bool jump) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_JUMP, static_cast<uint8_t>(jump), 0);
-  }
-  void add_fire(bool fire) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_FIRE, static_cast<uint8_t>(fire), 0);
-  }
-  void add_ads(bool ads) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_ADS, static_cast<uint8_t>(ads), 0);
-  }
-  void add_sprint(bool sprint) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_SPRINT, static_cast<uint8_t>(sprint), 0);
-  }
-  void add_dash(bool dash) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_DASH, static_cast<uint8_t>(dash), 0);
-  }
-  void add_grapple(bool grapple) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_GRAPPLE, static_cast<uint8_t>(grapple), 0);
-  }
-  void add_shield(bool shield) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_SHIELD, static_cast<uint8_t>(shield), 0);
-  }
-  void add_shockwave(bool shockwave) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_SHOCKWAVE, static_cast<uint8_t>(shockwave), 0);
-  }
-  void add_crouch(bool crouch) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_CROUCH, static_cast<uint8_t>(crouch), 0);
-  }
-  void add_debug_decal_report_present(bool debug_decal_report_present) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_DEBUG_DECAL_REPORT_PRESENT, static_cast<uint8_t>(debug_decal_report_present), 0);
-  }
-  void add_debug_decal_server_tick(int32_t debug_decal_server_tick) {
-    fbb_.AddElement<int32_t>(InputCmd::VT_DEBUG_DECAL_SERVER_TICK, debug_decal_server_tick, 0);
+  void add_server_tick(int32_t server_tick) {
+    fbb_.AddElement<int32_t>(DecalDebugReport::VT_SERVER_TICK, server_tick, 0);
   }
-  void add_debug_decal_shot_seq(int32_t debug_decal_shot_seq) {
-    fbb_.AddElement<int32_t>(InputCmd::VT_DEBUG_DECAL_SHOT_SEQ, debug_decal_shot_seq, 0);
+  void add_shot_seq(int32_t shot_seq) {
+    fbb_.AddElement<int32_t>(DecalDebugReport::VT_SHOT_SEQ, shot_seq, 0);
   }
-  void add_debug_decal_hit_kind(uint8_t debug_decal_hit_kind) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_DEBUG_DECAL_HIT_KIND, debug_decal_hit_kind, 0);
+  void add_hit_kind(uint8_t hit_kind) {
+    fbb_.AddElement<uint8_t>(DecalDebugReport::VT_HIT_KIND, hit_kind, 0);
   }
-  void add_debug_decal_surface_type(uint8_t debug_decal_surface_type) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_DEBUG_DECAL_SURFACE_TYPE, debug_decal_surface_type, 0);
+  void add_surface_type(uint8_t surface_type) {
+    fbb_.AddElement<uint8_t>(DecalDebugReport::VT_SURFACE_TYPE, surface_type, 0);
   }
-  void add_debug_decal_authoritative_world_hit(bool debug_decal_authoritative_world_hit) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_DEBUG_DECAL_AUTHORITATIVE_WORLD_HIT, static_cast<uint8_t>(debug_decal_authoritative_world_hit), 0);
+  void add_authoritative_world_hit(bool authoritative_world_hit) {
+    fbb_.AddElement<uint8_t>(DecalDebugReport::VT_AUTHORITATIVE_WORLD_HIT, static_cast<uint8_t>(authoritative_world_hit), 0);
   }
-  void add_debug_decal_used_projected_hit(bool debug_decal_used_projected_hit) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_DEBUG_DECAL_USED_PROJECTED_HIT, static_cast<uint8_t>(debug_decal_used_projected_hit), 0);
+  void add_used_projected_hit(bool used_projected_hit) {
+    fbb_.AddElement<uint8_t>(DecalDebugReport::VT_USED_PROJECTED_HIT, static_cast<uint8_t>(used_projected_hit), 0);
   }
-  void add_debug_decal_used_impact_projection(bool debug_decal_used_impact_projection) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_DEBUG_DECAL_USED_IMPACT_PROJECTION, static_cast<uint8_t>(debug_decal_used_impact_projection), 0);
+  void add_used_impact_projection(bool used_impact_projection) {
+    fbb_.AddElement<uint8_t>(DecalDebugReport::VT_USED_IMPACT_PROJECTION, static_cast<uint8_t>(used_impact_projection), 0);
   }
-  void add_debug_decal_spawned(bool debug_decal_spawned) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_DEBUG_DECAL_SPAWNED, static_cast<uint8_t>(debug_decal_spawned), 0);
+  void add_decal_spawned(bool decal_spawned) {
+    fbb_.AddElement<uint8_t>(DecalDebugReport::VT_DECAL_SPAWNED, static_cast<uint8_t>(decal_spawned), 0);
   }
-  void add_debug_decal_in_frustum(bool debug_decal_in_frustum) {
-    fbb_.AddElement<uint8_t>(InputCmd::VT_DEBUG_DECAL_IN_FRUSTUM, static_cast<uint8_t>(debug_decal_in_frustum), 0);
+  void add_decal_in_frustum(bool decal_in_frustum) {
+    fbb_.AddElement<uint8_t>(DecalDebugReport::VT_DECAL_IN_FRUSTUM, static_cast<uint8_t>(decal_in_frustum), 0);
   }
-  void add_debug_decal_distance(double debug_decal_distance) {
-    fbb_.AddElement<double>(InputCmd::VT_DEBUG_DECAL_DISTANCE, debug_decal_distance, -1.0);
+  void add_decal_distance(double decal_distance) {
+    fbb_.AddElement<double>(DecalDebugReport::VT_DECAL_DISTANCE, decal_distance, -1.0);
   }
-  void add_debug_decal_position_x(double debug_decal_position_x) {
-    fbb_.AddElement<double>(InputCmd::VT_DEBUG_DECAL_POSITION_X, debug_decal_position_x, 0.0);
+  void add_decal_position_x(double decal_position_x) {
+    fbb_.AddElement<double>(DecalDebugReport::VT_DECAL_POSITION_X, decal_position_x, 0.0);
   }
-  void add_debug_decal_position_y(double debug_decal_position_y) {
-    fbb_.AddElement<double>(InputCmd::VT_DEBUG_DECAL_POSITION_Y, debug_decal_position_y, 0.0);
+  void add_decal_position_y(double decal_position_y) {
+    fbb_.AddElement<double>(DecalDebugReport::VT_DECAL_POSITION_Y, decal_position_y, 0.0);
   }
-  void add_debug_decal_position_z(double debug_decal_position_z) {
-    fbb_.AddElement<double>(InputCmd::VT_DEBUG_DECAL_POSITION_Z, debug_decal_position_z, 0.0);
+  void add_decal_position_z(double decal_position_z) {
+    fbb_.AddElement<double>(DecalDebugReport::VT_DECAL_POSITION_Z, decal_position_z, 0.0);
   }
-  void add_debug_decal_normal_x(double debug_decal_normal_x) {
-    fbb_.AddElement<double>(InputCmd::VT_DEBUG_DECAL_NORMAL_X, debug_decal_normal_x, 0.0);
+  void add_decal_normal_x(double decal_normal_x) {
+    fbb_.AddElement<double>(DecalDebugReport::VT_DECAL_NORMAL_X, decal_normal_x, 0.0);
   }
-  void add_debug_decal_normal_y(double debug_decal_normal_y) {
-    fbb_.AddElement<double>(InputCmd::VT_DEBUG_DECAL_NORMAL_Y, debug_decal_normal_y, 0.0);
+  void add_decal_normal_y(double decal_normal_y) {
+    fbb_.AddElement<double>(DecalDebugReport::VT_DECAL_NORMAL_Y, decal_normal_y, 0.0);
   }
-  void add_debug_decal_normal_z(double debug_decal_normal_z) {
-    fbb_.AddElement<double>(InputCmd::VT_DEBUG_DECAL_NORMAL_Z, debug_decal_normal_z, 0.0);
+  void add_decal_normal_z(double decal_normal_z) {
+    fbb_.AddElement<double>(DecalDebugReport::VT_DECAL_NORMAL_Z, decal_normal_z, 0.0);
   }
-  void add_debug_trace_hit_position_x(double debug_trace_hit_position_x) {
-    fbb_.AddElement<double>(InputCmd::VT_DEBUG_TRACE_HIT_POSITION_X, debug_trace_hit_position_x, 0.0);
+  void add_trace_hit_position_x(double trace_hit_position_x) {
+    fbb_.AddElement<double>(DecalDebugReport::VT_TRACE_HIT_POSITION_X, trace_hit_position_x, 0.0);
   }
-  void add_debug_trace_hit_position_y(double debug_trace_hit_position_y) {
-    fbb_.AddElement<double>(InputCmd::VT_DEBUG_TRACE_HIT_POSITION_Y, debug_trace_hit_position_y, 0.0);
+  void add_trace_hit_position_y(double trace_hit_position_y) {
+    fbb_.AddElement<double>(DecalDebugReport::VT_TRACE_HIT_POSITION_Y, trace_hit_position_y, 0.0);
   }
-  void add_debug_trace_hit_position_z(double debug_trace_hit_position_z) {
-    fbb_.AddElement<double>(InputCmd::VT_DEBUG_TRACE_HIT_POSITION_Z, debug_trace_hit_position_z, 0.0);
+  void add_trace_hit_position_z(double trace_hit_position_z) {
+    fbb_.AddElement<double>(DecalDebugReport::VT_TRACE_HIT_POSITION_Z, trace_hit_position_z, 0.0);
   }
-  void add_debug_trace_hit_normal_x(double debug_trace_hit_normal_x) {
-    fbb_.AddElement<double>(InputCmd::VT_DEBUG_TRACE_HIT_NORMAL_X, debug_trace_hit_normal_x, 0.0);
+  void add_trace_hit_normal_x(double trace_hit_normal_x) {
+    fbb_.AddElement<double>(DecalDebugReport::VT_TRACE_HIT_NORMAL_X, trace_hit_normal_x, 0.0);
   }
-  void add_debug_trace_hit_normal_y(double debug_trace_hit_normal_y) {
-    fbb_.AddElement<double>(InputCmd::VT_DEBUG_TRACE_HIT_NORMAL_Y, debug_trace_hit_normal_y, 0.0);
+  void add_trace_hit_normal_y(double trace_hit_normal_y) {
+    fbb_.AddElement<double>(DecalDebugReport::VT_TRACE_HIT_NORMAL_Y, trace_hit_normal_y, 0.0);
   }
-  void add_debug_trace_hit_normal_z(double debug_trace_hit_normal_z) {
-    fbb_.AddElement<double>(InputCmd::VT_DEBUG_TRACE_HIT_NORMAL_Z, debug_trace_hit_normal_z, 0.0);
+  void add_trace_hit_normal_z(double trace_hit_normal_z) {
+    fbb_.AddElement<double>(DecalDebugReport::VT_TRACE_HIT_NORMAL_Z, trace_hit_normal_z, 0.0);
   }
-  explicit InputCmdBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+  explicit DecalDebugReportBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
-  ::flatbuffers::Offset<InputCmd> Finish() {
+  ::flatbuffers::Offset<DecalDebugReport> Finish() {
     const auto end = fbb_.EndTable(start_);
-    auto o = ::flatbuffers::Offset<InputCmd>(end);
+    auto o = ::flatbuffers::Offset<DecalDebugReport>(end);
     return o;
   }
 };
 
-inline ::flatbuffers::Offset<InputCmd> CreateInputCmd(
+inline ::flatbuffers::Offset<DecalDebugReport> CreateDecalDebugReport(
     ::flatbuffers::FlatBufferBuilder &_fbb,
-    int32_t input_seq = 0,
-    double move_x = 0.0,
-    double move_y = 0.0,
-    double look_delta_x = 0.0,
-    double look_delta_y = 0.0,
-    double view_yaw = 0.0,
-    double view_pitch = 0.0,
-    int32_t weapon_slot = 0,
-    bool jump = false,
-    bool fire = false,
-    bool ads = false,
-    bool sprint = false,
-    bool dash = false,
-    bool grapple = false,
-    bool shield = false,
-    bool shockwave = false,
-    bool crouch = false,
-    bool debug_decal_report_present = false,
-    int32_t debug_decal_server_tick = 0,
-    int32_t debug_decal_shot_seq = 0,
-    uint8_t debug_decal_hit_kind = 0,
-    uint8_t debug_decal_surface_type = 0,
-    bool debug_decal_authoritative_world_hit = false,
-    bool debug_decal_used_projected_hit = false,
-    bool debug_decal_used_impact_projection = false,
-    bool debug_decal_spawned = false,
-    bool debug_decal_in_frustum = false,
-    double debug_decal_distance = -1.0,
-    double debug_decal_position_x = 0.0,
-    double debug_decal_position_y = 0.0,
-    double debug_decal_position_z = 0.0,
-    double debug_decal_normal_x = 0.0,
-    double debug_decal_normal_y = 0.0,
-    double debug_decal_normal_z = 0.0,
-    double debug_trace_hit_position_x = 0.0,
-    double debug_trace_hit_position_y = 0.0,
-    double debug_trace_hit_position_z = 0.0,
-    double debug_trace_hit_normal_x = 0.0,
-    double debug_trace_hit_normal_y = 0.0,
-    double debug_trace_hit_normal_z = 0.0) {
-  InputCmdBuilder builder_(_fbb);
-  builder_.add_debug_trace_hit_normal_z(debug_trace_hit_normal_z);
-  builder_.add_debug_trace_hit_normal_y(debug_trace_hit_normal_y);
-  builder_.add_debug_trace_hit_normal_x(debug_trace_hit_normal_x);
-  builder_.add_debug_trace_hit_position_z(debug_trace_hit_position_z);
-  builder_.add_debug_trace_hit_position_y(debug_trace_hit_position_y);
-  builder_.add_debug_trace_hit_position_x(debug_trace_hit_position_x);
-  builder_.add_debug_decal_normal_z(debug_decal_normal_z);
-  builder_.add_debug_decal_normal_y(debug_decal_normal_y);
-  builder_.add_debug_decal_normal_x(debug_decal_normal_x);
-  builder_.add_debug_decal_position_z(debug_decal_position_z);
-  builder_.add_debug_decal_position_y(debug_decal_position_y);
-  builder_.add_debug_decal_position_x(debug_decal_position_x);
-  builder_.add_debug_decal_distance(debug_decal_distance);
-  builder_.add_view_pitch(view_pitch);
-  builder_.add_view_yaw(view_yaw);
-  builder_.add_look_delta_y(look_delta_y);
-  builder_.add_look_delta_x(look_delta_x);
-  builder_.add_move_y(move_y);
-  builder_.add_move_x(move_x);
-  builder_.add_debug_decal_shot_seq(debug_decal_shot_seq);
-  builder_.add_debug_decal_server_tick(debug_decal_server_tick);
-  builder_.add_weapon_slot(weapon_slot);
-  builder_.add_input_seq(input_seq);
-  builder_.add_debug_decal_in_frustum(debug_decal_in_frustum);
-  builder_.add_debug_decal_spawned(debug_decal_spawned);
-  builder_.add_debug_decal_used_impact_projection(debug_decal_used_impact_projection);
-  builder_.add_debug_decal_used_projected_hit(debug_decal_used_projected_hit);
-  builder_.add_debug_decal_authoritative_world_hit(debug_decal_authoritative_world_hit);
-  builder_.add_debug_decal_surface_type(debug_decal_surface_type);
-  builder_.add_debug_decal_hit_kind(debug_decal_hit_kind);
-  builder_.add_debug_decal_report_present(debug_decal_report_present);
-  builder_.add_crouch(crouch);
-  builder_.add_shockwave(shockwave);
-  builder_.add_shield(shield);
-  builder_.add_grapple(grapple);
-  builder_.add_dash(dash);
-  builder_.add_sprint(sprint);
-  builder_.add_ads(ads);
-  builder_.add_fire(fire);
-  builder_.add_jump(jump);
+    int32_t server_tick = 0,
+    int32_t shot_seq = 0,
+    uint8_t hit_kind = 0,
+    uint8_t surface_type = 0,
+    bool authoritative_world_hit = false,
+    bool used_projected_hit = false,
+    bool used_impact_projection = false,
+    bool decal_spawned = false,
+    bool decal_in_frustum = false,
+    double decal_distance = -1.0,
+    double decal_position_x = 0.0,
+    double decal_position_y = 0.0,
+    double decal_position_z = 0.0,
+    double decal_normal_x = 0.0,
+    double decal_normal_y = 0.0,
+    double decal_normal_z = 0.0,
+    double trace_hit_position_x = 0.0,
+    double trace_hit_position_y = 0.0,
+    double trace_hit_position_z = 0.0,
+    double trace_hit_normal_x = 0.0,
+    double trace_hit_normal_y = 0.0,
+    double trace_hit_normal_z = 0.0) {
+  DecalDebugReportBuilder builder_(_fbb);
+  builder_.add_trace_hit_normal_z(trace_hit_normal_z);
+  builder_.add_trace_hit_normal_y(trace_hit_normal_y);
+  builder_.add_trace_hit_normal_x(trace_hit_normal_x);
+  builder_.add_trace_hit_position_z(trace_hit_position_z);
+  builder_.add_trace_hit_position_y(trace_hit_position_y);
+  builder_.add_trace_hit_position_x(trace_hit_position_x);
+  builder_.add_decal_normal_z(decal_normal_z);
+  builder_.add_decal_normal_y(decal_normal_y);
+  builder_.add_decal_normal_x(decal_normal_x);
+  builder_.add_decal_position_z(decal_position_z);
+  builder_.add_decal_position_y(decal_position_y);
+  builder_.add_decal_position_x(decal_position_x);
+  builder_.add_decal_distance(decal_distance);
+  builder_.add_shot_seq(shot_seq);
+  builder_.add_server_tick(server_tick);
+  builder_.add_decal_in_frustum(decal_in_frustum);
+  builder_.add_decal_spawned(decal_spawned);
+  builder_.add_used_impact_projection(used_impact_projection);
+  builder_.add_used_projected_hit(used_projected_hit);
+  builder_.add_authoritative_world_hit(authoritative_world_hit);
+  builder_.add_surface_type(surface_type);
+  builder_.add_hit_kind(hit_kind);
   return builder_.Finish();
 }
 
-::flatbuffers::Offset<InputCmd> CreateInputCmd(::flatbuffers::FlatBufferBuilder &_fbb, const InputCmdT *_o, const ::flatbuffers::rehasher_function_t *_rehasher = nullptr);
+inline ::flatbuffers::Offset<DecalDebugReport> CreateDecalDebugReportDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    int32_t server_tick = 0,
+    int32_t shot_seq = 0,
+    uint8_t hit_kind = 0,
+    uint8_t surface_type = 0,
+    bool authoritative_world_hit = false,
+    bool used_projected_hit = false,
+    bool used_impact_projection = false,
+    bool decal_spawned = false,
+    bool decal_in_frustum = false,
+    double decal_distance = -1.0,
+    double decal_position_x = 0.0,
+    double decal_position_y = 0.0,
+    double decal_position_z = 0.0,
+    double decal_normal_x = 0.0,
+    double decal_normal_y = 0.0,
+    double decal_normal_z = 0.0,
+    double trace_hit_position_x = 0.0,
+    double trace_hit_position_y = 0.0,
+    double trace_hit_position_z = 0.0,
+    double trace_hit_normal_x = 0.0,
+    double trace_hit_normal_y = 0.0,
+    double trace_hit_normal_z = 0.0) {
+  return afps::protocol::CreateDecalDebugReport(
+      _fbb,
+      server_tick,
+      shot_seq,
+      hit_kind,
+      surface_type,
+      authoritative_world_hit,
+      used_projected_hit,
+      used_impact_projection,
+      decal_spawned,
+      decal_in_frustum,
+      decal_distance,
+      decal_position_x,
+      decal_position_y,
+      decal_position_z,
+      decal_normal_x,
+      decal_normal_y,
+      decal_normal_z,
+      trace_hit_position_x,
+      trace_hit_position_y,
+      trace_hit_position_z,
+      trace_hit_normal_x,
+      trace_hit_normal_y,
+      trace_hit_normal_z);
+}
+
+::flatbuffers::Offset<DecalDebugReport> CreateDecalDebugReport(::flatbuffers::FlatBufferBuilder &_fbb, const DecalDebugReportT *_o, const ::flatbuffers::rehasher_function_t *_rehasher = nullptr);
 
 struct FireWeaponRequestT : public ::flatbuffers::NativeTable {
   typedef FireWeaponRequest TableType;
@@ -3345,18 +3351,18 @@ struct StateSnapshotT : public ::flatbuffers::NativeTable {
   int32_t server_tick = 0;
   int32_t last_processed_input_seq = 0;
   std::string client_id{};
-  double pos_x = 0.0;
-  double pos_y = 0.0;
-  double pos_z = 0.0;
-  double vel_x = 0.0;
-  double vel_y = 0.0;
-  double vel_z = 0.0;
-  int32_t weapon_slot = 0;
-  int32_t ammo_in_mag = 0;
-  double dash_cooldown = 0.0;
-  double health = 0.0;
-  int32_t kills = 0;
-  int32_t deaths = 0;
+  int16_t pos_x_q = 0;
+  int16_t pos_y_q = 0;
+  int16_t pos_z_q = 0;
+  int16_t vel_x_q = 0;
+  int16_t vel_y_q = 0;
+  int16_t vel_z_q = 0;
+  uint8_t weapon_slot = 0;
+  uint16_t ammo_in_mag = 0;
+  uint8_t dash_cooldown_q = 0;
+  uint16_t health_q = 0;
+  uint16_t kills = 0;
+  uint16_t deaths = 0;
   int16_t view_yaw_q = 0;
   int16_t view_pitch_q = 0;
   uint8_t player_flags = 0;
@@ -3371,16 +3377,16 @@ struct StateSnapshot FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
     VT_SERVER_TICK = 4,
     VT_LAST_PROCESSED_INPUT_SEQ = 6,
     VT_CLIENT_ID = 8,
-    VT_POS_X = 10,
-    VT_POS_Y = 12,
-    VT_POS_Z = 14,
-    VT_VEL_X = 16,
-    VT_VEL_Y = 18,
-    VT_VEL_Z = 20,
+    VT_POS_X_Q = 10,
+    VT_POS_Y_Q = 12,
+    VT_POS_Z_Q = 14,
+    VT_VEL_X_Q = 16,
+    VT_VEL_Y_Q = 18,
+    VT_VEL_Z_Q = 20,
     VT_WEAPON_SLOT = 22,
     VT_AMMO_IN_MAG = 24,
-    VT_DASH_COOLDOWN = 26,
-    VT_HEALTH = 28,
+    VT_DASH_COOLDOWN_Q = 26,
+    VT_HEALTH_Q = 28,
     VT_KILLS = 30,
     VT_DEATHS = 32,
     VT_VIEW_YAW_Q = 34,
@@ -3398,41 +3404,41 @@ struct StateSnapshot FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   const ::flatbuffers::String *client_id() const {
     return GetPointer<const ::flatbuffers::String *>(VT_CLIENT_ID);
   }
-  double pos_x() const {
-    return GetField<double>(VT_POS_X, 0.0);
+  int16_t pos_x_q() const {
+    return GetField<int16_t>(VT_POS_X_Q, 0);
   }
-  double pos_y() const {
-    return GetField<double>(VT_POS_Y, 0.0);
+  int16_t pos_y_q() const {
+    return GetField<int16_t>(VT_POS_Y_Q, 0);
   }
-  double pos_z() const {
-    return GetField<double>(VT_POS_Z, 0.0);
+  int16_t pos_z_q() const {
+    return GetField<int16_t>(VT_POS_Z_Q, 0);
   }
-  double vel_x() const {
-    return GetField<double>(VT_VEL_X, 0.0);
+  int16_t vel_x_q() const {
+    return GetField<int16_t>(VT_VEL_X_Q, 0);
   }
-  double vel_y() const {
-    return GetField<double>(VT_VEL_Y, 0.0);
+  int16_t vel_y_q() const {
+    return GetField<int16_t>(VT_VEL_Y_Q, 0);
   }
-  double vel_z() const {
-    return GetField<double>(VT_VEL_Z, 0.0);
+  int16_t vel_z_q() const {
+    return GetField<int16_t>(VT_VEL_Z_Q, 0);
   }
-  int32_t weapon_slot() const {
-    return GetField<int32_t>(VT_WEAPON_SLOT, 0);
+  uint8_t weapon_slot() const {
+    return GetField<uint8_t>(VT_WEAPON_SLOT, 0);
   }
-  int32_t ammo_in_mag() const {
-    return GetField<int32_t>(VT_AMMO_IN_MAG, 0);
+  uint16_t ammo_in_mag() const {
+    return GetField<uint16_t>(VT_AMMO_IN_MAG, 0);
   }
-  double dash_cooldown() const {
-    return GetField<double>(VT_DASH_COOLDOWN, 0.0);
+  uint8_t dash_cooldown_q() const {
+    return GetField<uint8_t>(VT_DASH_COOLDOWN_Q, 0);
   }
-  double health() const {
-    return GetField<double>(VT_HEALTH, 0.0);
+  uint16_t health_q() const {
+    return GetField<uint16_t>(VT_HEALTH_Q, 0);
   }
-  int32_t kills() const {
-    return GetField<int32_t>(VT_KILLS, 0);
+  uint16_t kills() const {
+    return GetField<uint16_t>(VT_KILLS, 0);
   }
-  int32_t deaths() const {
-    return GetField<int32_t>(VT_DEATHS, 0);
+  uint16_t deaths() const {
+    return GetField<uint16_t>(VT_DEATHS, 0);
   }
   int16_t view_yaw_q() const {
     return GetField<int16_t>(VT_VIEW_YAW_Q, 0);
@@ -3456,18 +3462,18 @@ struct StateSnapshot FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
            VerifyField<int32_t>(verifier, VT_LAST_PROCESSED_INPUT_SEQ, 4) &&
            VerifyOffset(verifier, VT_CLIENT_ID) &&
            verifier.VerifyString(client_id()) &&
-           VerifyField<double>(verifier, VT_POS_X, 8) &&
-           VerifyField<double>(verifier, VT_POS_Y, 8) &&
-           VerifyField<double>(verifier, VT_POS_Z, 8) &&
-           VerifyField<double>(verifier, VT_VEL_X, 8) &&
-           VerifyField<double>(verifier, VT_VEL_Y, 8) &&
-           VerifyField<double>(verifier, VT_VEL_Z, 8) &&
-           VerifyField<int32_t>(verifier, VT_WEAPON_SLOT, 4) &&
-           VerifyField<int32_t>(verifier, VT_AMMO_IN_MAG, 4) &&
-           VerifyField<double>(verifier, VT_DASH_COOLDOWN, 8) &&
-           VerifyField<double>(verifier, VT_HEALTH, 8) &&
-           VerifyField<int32_t>(verifier, VT_KILLS, 4) &&
-           VerifyField<int32_t>(verifier, VT_DEATHS, 4) &&
+           VerifyField<int16_t>(verifier, VT_POS_X_Q, 2) &&
+           VerifyField<int16_t>(verifier, VT_POS_Y_Q, 2) &&
+           VerifyField<int16_t>(verifier, VT_POS_Z_Q, 2) &&
+           VerifyField<int16_t>(verifier, VT_VEL_X_Q, 2) &&
+           VerifyField<int16_t>(verifier, VT_VEL_Y_Q, 2) &&
+           VerifyField<int16_t>(verifier, VT_VEL_Z_Q, 2) &&
+           VerifyField<uint8_t>(verifier, VT_WEAPON_SLOT, 1) &&
+           VerifyField<uint16_t>(verifier, VT_AMMO_IN_MAG, 2) &&
+           VerifyField<uint8_t>(verifier, VT_DASH_COOLDOWN_Q, 1) &&
+           VerifyField<uint16_t>(verifier, VT_HEALTH_Q, 2) &&
+           VerifyField<uint16_t>(verifier, VT_KILLS, 2) &&
+           VerifyField<uint16_t>(verifier, VT_DEATHS, 2) &&
            VerifyField<int16_t>(verifier, VT_VIEW_YAW_Q, 2) &&
            VerifyField<int16_t>(verifier, VT_VIEW_PITCH_Q, 2) &&
            VerifyField<uint8_t>(verifier, VT_PLAYER_FLAGS, 1) &&
@@ -3493,41 +3499,41 @@ struct StateSnapshotBuilder {
   void add_client_id(::flatbuffers::Offset<::flatbuffers::String> client_id) {
     fbb_.AddOffset(StateSnapshot::VT_CLIENT_ID, client_id);
   }
-  void add_pos_x(double pos_x) {
-    fbb_.AddElement<double>(StateSnapshot::VT_POS_X, pos_x, 0.0);
+  void add_pos_x_q(int16_t pos_x_q) {
+    fbb_.AddElement<int16_t>(StateSnapshot::VT_POS_X_Q, pos_x_q, 0);
   }
-  void add_pos_y(double pos_y) {
-    fbb_.AddElement<double>(StateSnapshot::VT_POS_Y, pos_y, 0.0);
+  void add_pos_y_q(int16_t pos_y_q) {
+    fbb_.AddElement<int16_t>(StateSnapshot::VT_POS_Y_Q, pos_y_q, 0);
   }
-  void add_pos_z(double pos_z) {
-    fbb_.AddElement<double>(StateSnapshot::VT_POS_Z, pos_z, 0.0);
+  void add_pos_z_q(int16_t pos_z_q) {
+    fbb_.AddElement<int16_t>(StateSnapshot::VT_POS_Z_Q, pos_z_q, 0);
   }
-  void add_vel_x(double vel_x) {
-    fbb_.AddElement<double>(StateSnapshot::VT_VEL_X, vel_x, 0.0);
+  void add_vel_x_q(int16_t vel_x_q) {
+    fbb_.AddElement<int16_t>(StateSnapshot::VT_VEL_X_Q, vel_x_q, 0);
   }
-  void add_vel_y(double vel_y) {
-    fbb_.AddElement<double>(StateSnapshot::VT_VEL_Y, vel_y, 0.0);
+  void add_vel_y_q(int16_t vel_y_q) {
+    fbb_.AddElement<int16_t>(StateSnapshot::VT_VEL_Y_Q, vel_y_q, 0);
   }
-  void add_vel_z(double vel_z) {
-    fbb_.AddElement<double>(StateSnapshot::VT_VEL_Z, vel_z, 0.0);
+  void add_vel_z_q(int16_t vel_z_q) {
+    fbb_.AddElement<int16_t>(StateSnapshot::VT_VEL_Z_Q, vel_z_q, 0);
   }
-  void add_weapon_slot(int32_t weapon_slot) {
-    fbb_.AddElement<int32_t>(StateSnapshot::VT_WEAPON_SLOT, weapon_slot, 0);
+  void add_weapon_slot(uint8_t weapon_slot) {
+    fbb_.AddElement<uint8_t>(StateSnapshot::VT_WEAPON_SLOT, weapon_slot, 0);
   }
-  void add_ammo_in_mag(int32_t ammo_in_mag) {
-    fbb_.AddElement<int32_t>(StateSnapshot::VT_AMMO_IN_MAG, ammo_in_mag, 0);
+  void add_ammo_in_mag(uint16_t ammo_in_mag) {
+    fbb_.AddElement<uint16_t>(StateSnapshot::VT_AMMO_IN_MAG, ammo_in_mag, 0);
   }
-  void add_dash_cooldown(double dash_cooldown) {
-    fbb_.AddElement<double>(StateSnapshot::VT_DASH_COOLDOWN, dash_cooldown, 0.0);
+  void add_dash_cooldown_q(uint8_t dash_cooldown_q) {
+    fbb_.AddElement<uint8_t>(StateSnapshot::VT_DASH_COOLDOWN_Q, dash_cooldown_q, 0);
   }
-  void add_health(double health) {
-    fbb_.AddElement<double>(StateSnapshot::VT_HEALTH, health, 0.0);
+  void add_health_q(uint16_t health_q) {
+    fbb_.AddElement<uint16_t>(StateSnapshot::VT_HEALTH_Q, health_q, 0);
   }
-  void add_kills(int32_t kills) {
-    fbb_.AddElement<int32_t>(StateSnapshot::VT_KILLS, kills, 0);
+  void add_kills(uint16_t kills) {
+    fbb_.AddElement<uint16_t>(StateSnapshot::VT_KILLS, kills, 0);
   }
-  void add_deaths(int32_t deaths) {
-    fbb_.AddElement<int32_t>(StateSnapshot::VT_DEATHS, deaths, 0);
+  void add_deaths(uint16_t deaths) {
+    fbb_.AddElement<uint16_t>(StateSnapshot::VT_DEATHS, deaths, 0);
   }
   void add_view_yaw_q(int16_t view_yaw_q) {
     fbb_.AddElement<int16_t>(StateSnapshot::VT_VIEW_YAW_Q, view_yaw_q, 0);
@@ -3560,44 +3566,44 @@ inline ::flatbuffers::Offset<StateSnapshot> CreateStateSnapshot(
     int32_t server_tick = 0,
     int32_t last_processed_input_seq = 0,
     ::flatbuffers::Offset<::flatbuffers::String> client_id = 0,
-    double pos_x = 0.0,
-    double pos_y = 0.0,
-    double pos_z = 0.0,
-    double vel_x = 0.0,
-    double vel_y = 0.0,
-    double vel_z = 0.0,
-    int32_t weapon_slot = 0,
-    int32_t ammo_in_mag = 0,
-    double dash_cooldown = 0.0,
-    double health = 0.0,
-    int32_t kills = 0,
-    int32_t deaths = 0,
+    int16_t pos_x_q = 0,
+    int16_t pos_y_q = 0,
+    int16_t pos_z_q = 0,
+    int16_t vel_x_q = 0,
+    int16_t vel_y_q = 0,
+    int16_t vel_z_q = 0,
+    uint8_t weapon_slot = 0,
+    uint16_t ammo_in_mag = 0,
+    uint8_t dash_cooldown_q = 0,
+    uint16_t health_q = 0,
+    uint16_t kills = 0,
+    uint16_t deaths = 0,
     int16_t view_yaw_q = 0,
     int16_t view_pitch_q = 0,
     uint8_t player_flags = 0,
     uint16_t weapon_heat_q = 0,
     uint32_t loadout_bits = 0) {
   StateSnapshotBuilder builder_(_fbb);
-  builder_.add_health(health);
-  builder_.add_dash_cooldown(dash_cooldown);
-  builder_.add_vel_z(vel_z);
-  builder_.add_vel_y(vel_y);
-  builder_.add_vel_x(vel_x);
-  builder_.add_pos_z(pos_z);
-  builder_.add_pos_y(pos_y);
-  builder_.add_pos_x(pos_x);
   builder_.add_loadout_bits(loadout_bits);
-  builder_.add_deaths(deaths);
-  builder_.add_kills(kills);
-  builder_.add_ammo_in_mag(ammo_in_mag);
-  builder_.add_weapon_slot(weapon_slot);
   builder_.add_client_id(client_id);
   builder_.add_last_processed_input_seq(last_processed_input_seq);
   builder_.add_server_tick(server_tick);
   builder_.add_weapon_heat_q(weapon_heat_q);
   builder_.add_view_pitch_q(view_pitch_q);
   builder_.add_view_yaw_q(view_yaw_q);
+  builder_.add_deaths(deaths);
+  builder_.add_kills(kills);
+  builder_.add_health_q(health_q);
+  builder_.add_ammo_in_mag(ammo_in_mag);
+  builder_.add_vel_z_q(vel_z_q);
+  builder_.add_vel_y_q(vel_y_q);
+  builder_.add_vel_x_q(vel_x_q);
+  builder_.add_pos_z_q(pos_z_q);
+  builder_.add_pos_y_q(pos_y_q);
+  builder_.add_pos_x_q(pos_x_q);
   builder_.add_player_flags(player_flags);
+  builder_.add_dash_cooldown_q(dash_cooldown_q);
+  builder_.add_weapon_slot(weapon_slot);
   return builder_.Finish();
 }
 
@@ -3606,18 +3612,18 @@ inline ::flatbuffers::Offset<StateSnapshot> CreateStateSnapshotDirect(
     int32_t server_tick = 0,
     int32_t last_processed_input_seq = 0,
     const char *client_id = nullptr,
-    double pos_x = 0.0,
-    double pos_y = 0.0,
-    double pos_z = 0.0,
-    double vel_x = 0.0,
-    double vel_y = 0.0,
-    double vel_z = 0.0,
-    int32_t weapon_slot = 0,
-    int32_t ammo_in_mag = 0,
-    double dash_cooldown = 0.0,
-    double health = 0.0,
-    int32_t kills = 0,
-    int32_t deaths = 0,
+    int16_t pos_x_q = 0,
+    int16_t pos_y_q = 0,
+    int16_t pos_z_q = 0,
+    int16_t vel_x_q = 0,
+    int16_t vel_y_q = 0,
+    int16_t vel_z_q = 0,
+    uint8_t weapon_slot = 0,
+    uint16_t ammo_in_mag = 0,
+    uint8_t dash_cooldown_q = 0,
+    uint16_t health_q = 0,
+    uint16_t kills = 0,
+    uint16_t deaths = 0,
     int16_t view_yaw_q = 0,
     int16_t view_pitch_q = 0,
     uint8_t player_flags = 0,
@@ -3629,16 +3635,16 @@ inline ::flatbuffers::Offset<StateSnapshot> CreateStateSnapshotDirect(
       server_tick,
       last_processed_input_seq,
       client_id__,
-      pos_x,
-      pos_y,
-      pos_z,
-      vel_x,
-      vel_y,
-      vel_z,
+      pos_x_q,
+      pos_y_q,
+      pos_z_q,
+      vel_x_q,
+      vel_y_q,
+      vel_z_q,
       weapon_slot,
       ammo_in_mag,
-      dash_cooldown,
-      health,
+      dash_cooldown_q,
+      health_q,
       kills,
       deaths,
       view_yaw_q,
@@ -3657,18 +3663,18 @@ struct StateSnapshotDeltaT : public ::flatbuffers::NativeTable {
   int32_t last_processed_input_seq = 0;
   int32_t mask = 0;
   std::string client_id{};
-  double pos_x = 0.0;
-  double pos_y = 0.0;
-  double pos_z = 0.0;
-  double vel_x = 0.0;
-  double vel_y = 0.0;
-  double vel_z = 0.0;
-  int32_t weapon_slot = 0;
-  int32_t ammo_in_mag = 0;
-  double dash_cooldown = 0.0;
-  double health = 0.0;
-  int32_t kills = 0;
-  int32_t deaths = 0;
+  int16_t pos_x_q = 0;
+  int16_t pos_y_q = 0;
+  int16_t pos_z_q = 0;
+  int16_t vel_x_q = 0;
+  int16_t vel_y_q = 0;
+  int16_t vel_z_q = 0;
+  uint8_t weapon_slot = 0;
+  uint16_t ammo_in_mag = 0;
+  uint8_t dash_cooldown_q = 0;
+  uint16_t health_q = 0;
+  uint16_t kills = 0;
+  uint16_t deaths = 0;
   int16_t view_yaw_q = 0;
   int16_t view_pitch_q = 0;
   uint8_t player_flags = 0;
@@ -3685,16 +3691,16 @@ struct StateSnapshotDelta FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table
     VT_LAST_PROCESSED_INPUT_SEQ = 8,
     VT_MASK = 10,
     VT_CLIENT_ID = 12,
-    VT_POS_X = 14,
-    VT_POS_Y = 16,
-    VT_POS_Z = 18,
-    VT_VEL_X = 20,
-    VT_VEL_Y = 22,
-    VT_VEL_Z = 24,
+    VT_POS_X_Q = 14,
+    VT_POS_Y_Q = 16,
+    VT_POS_Z_Q = 18,
+    VT_VEL_X_Q = 20,
+    VT_VEL_Y_Q = 22,
+    VT_VEL_Z_Q = 24,
     VT_WEAPON_SLOT = 26,
     VT_AMMO_IN_MAG = 28,
-    VT_DASH_COOLDOWN = 30,
-    VT_HEALTH = 32,
+    VT_DASH_COOLDOWN_Q = 30,
+    VT_HEALTH_Q = 32,
     VT_KILLS = 34,
     VT_DEATHS = 36,
     VT_VIEW_YAW_Q = 38,
@@ -3718,41 +3724,41 @@ struct StateSnapshotDelta FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table
   const ::flatbuffers::String *client_id() const {
     return GetPointer<const ::flatbuffers::String *>(VT_CLIENT_ID);
   }
-  double pos_x() const {
-    return GetField<double>(VT_POS_X, 0.0);
+  int16_t pos_x_q() const {
+    return GetField<int16_t>(VT_POS_X_Q, 0);
   }
-  double pos_y() const {
-    return GetField<double>(VT_POS_Y, 0.0);
+  int16_t pos_y_q() const {
+    return GetField<int16_t>(VT_POS_Y_Q, 0);
   }
-  double pos_z() const {
-    return GetField<double>(VT_POS_Z, 0.0);
+  int16_t pos_z_q() const {
+    return GetField<int16_t>(VT_POS_Z_Q, 0);
   }
-  double vel_x() const {
-    return GetField<double>(VT_VEL_X, 0.0);
+  int16_t vel_x_q() const {
+    return GetField<int16_t>(VT_VEL_X_Q, 0);
   }
-  double vel_y() const {
-    return GetField<double>(VT_VEL_Y, 0.0);
+  int16_t vel_y_q() const {
+    return GetField<int16_t>(VT_VEL_Y_Q, 0);
   }
-  double vel_z() const {
-    return GetField<double>(VT_VEL_Z, 0.0);
+  int16_t vel_z_q() const {
+    return GetField<int16_t>(VT_VEL_Z_Q, 0);
   }
-  int32_t weapon_slot() const {
-    return GetField<int32_t>(VT_WEAPON_SLOT, 0);
+  uint8_t weapon_slot() const {
+    return GetField<uint8_t>(VT_WEAPON_SLOT, 0);
   }
-  int32_t ammo_in_mag() const {
-    return GetField<int32_t>(VT_AMMO_IN_MAG, 0);
+  uint16_t ammo_in_mag() const {
+    return GetField<uint16_t>(VT_AMMO_IN_MAG, 0);
   }
-  double dash_cooldown() const {
-    return GetField<double>(VT_DASH_COOLDOWN, 0.0);
+  uint8_t dash_cooldown_q() const {
+    return GetField<uint8_t>(VT_DASH_COOLDOWN_Q, 0);
   }
-  double health() const {
-    return GetField<double>(VT_HEALTH, 0.0);
+  uint16_t health_q() const {
+    return GetField<uint16_t>(VT_HEALTH_Q, 0);
   }
-  int32_t kills() const {
-    return GetField<int32_t>(VT_KILLS, 0);
+  uint16_t kills() const {
+    return GetField<uint16_t>(VT_KILLS, 0);
   }
-  int32_t deaths() const {
-    return GetField<int32_t>(VT_DEATHS, 0);
+  uint16_t deaths() const {
+    return GetField<uint16_t>(VT_DEATHS, 0);
   }
   int16_t view_yaw_q() const {
     return GetField<int16_t>(VT_VIEW_YAW_Q, 0);
@@ -3778,18 +3784,18 @@ struct StateSnapshotDelta FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table
            VerifyField<int32_t>(verifier, VT_MASK, 4) &&
            VerifyOffset(verifier, VT_CLIENT_ID) &&
            verifier.VerifyString(client_id()) &&
-           VerifyField<double>(verifier, VT_POS_X, 8) &&
-           VerifyField<double>(verifier, VT_POS_Y, 8) &&
-           VerifyField<double>(verifier, VT_POS_Z, 8) &&
-           VerifyField<double>(verifier, VT_VEL_X, 8) &&
-           VerifyField<double>(verifier, VT_VEL_Y, 8) &&
-           VerifyField<double>(verifier, VT_VEL_Z, 8) &&
-           VerifyField<int32_t>(verifier, VT_WEAPON_SLOT, 4) &&
-           VerifyField<int32_t>(verifier, VT_AMMO_IN_MAG, 4) &&
-           VerifyField<double>(verifier, VT_DASH_COOLDOWN, 8) &&
-           VerifyField<double>(verifier, VT_HEALTH, 8) &&
-           VerifyField<int32_t>(verifier, VT_KILLS, 4) &&
-           VerifyField<int32_t>(verifier, VT_DEATHS, 4) &&
+           VerifyField<int16_t>(verifier, VT_POS_X_Q, 2) &&
+           VerifyField<int16_t>(verifier, VT_POS_Y_Q, 2) &&
+           VerifyField<int16_t>(verifier, VT_POS_Z_Q, 2) &&
+           VerifyField<int16_t>(verifier, VT_VEL_X_Q, 2) &&
+           VerifyField<int16_t>(verifier, VT_VEL_Y_Q, 2) &&
+           VerifyField<int16_t>(verifier, VT_VEL_Z_Q, 2) &&
+           VerifyField<uint8_t>(verifier, VT_WEAPON_SLOT, 1) &&
+           VerifyField<uint16_t>(verifier, VT_AMMO_IN_MAG, 2) &&
+           VerifyField<uint8_t>(verifier, VT_DASH_COOLDOWN_Q, 1) &&
+           VerifyField<uint16_t>(verifier, VT_HEALTH_Q, 2) &&
+           VerifyField<uint16_t>(verifier, VT_KILLS, 2) &&
+           VerifyField<uint16_t>(verifier, VT_DEATHS, 2) &&
            VerifyField<int16_t>(verifier, VT_VIEW_YAW_Q, 2) &&
            VerifyField<int16_t>(verifier, VT_VIEW_PITCH_Q, 2) &&
            VerifyField<uint8_t>(verifier, VT_PLAYER_FLAGS, 1) &&
@@ -3821,41 +3827,41 @@ struct StateSnapshotDeltaBuilder {
   void add_client_id(::flatbuffers::Offset<::flatbuffers::String> client_id) {
     fbb_.AddOffset(StateSnapshotDelta::VT_CLIENT_ID, client_id);
   }
-  void add_pos_x(double pos_x) {
-    fbb_.AddElement<double>(StateSnapshotDelta::VT_POS_X, pos_x, 0.0);
+  void add_pos_x_q(int16_t pos_x_q) {
+    fbb_.AddElement<int16_t>(StateSnapshotDelta::VT_POS_X_Q, pos_x_q, 0);
   }
-  void add_pos_y(double pos_y) {
-    fbb_.AddElement<double>(StateSnapshotDelta::VT_POS_Y, pos_y, 0.0);
+  void add_pos_y_q(int16_t pos_y_q) {
+    fbb_.AddElement<int16_t>(StateSnapshotDelta::VT_POS_Y_Q, pos_y_q, 0);
   }
-  void add_pos_z(double pos_z) {
-    fbb_.AddElement<double>(StateSnapshotDelta::VT_POS_Z, pos_z, 0.0);
+  void add_pos_z_q(int16_t pos_z_q) {
+    fbb_.AddElement<int16_t>(StateSnapshotDelta::VT_POS_Z_Q, pos_z_q, 0);
   }
-  void add_vel_x(double vel_x) {
-    fbb_.AddElement<double>(StateSnapshotDelta::VT_VEL_X, vel_x, 0.0);
+  void add_vel_x_q(int16_t vel_x_q) {
+    fbb_.AddElement<int16_t>(StateSnapshotDelta::VT_VEL_X_Q, vel_x_q, 0);
   }
-  void add_vel_y(double vel_y) {
-    fbb_.AddElement<double>(StateSnapshotDelta::VT_VEL_Y, vel_y, 0.0);
+  void add_vel_y_q(int16_t vel_y_q) {
+    fbb_.AddElement<int16_t>(StateSnapshotDelta::VT_VEL_Y_Q, vel_y_q, 0);
   }
-  void add_vel_z(double vel_z) {
-    fbb_.AddElement<double>(StateSnapshotDelta::VT_VEL_Z, vel_z, 0.0);
+  void add_vel_z_q(int16_t vel_z_q) {
+    fbb_.AddElement<int16_t>(StateSnapshotDelta::VT_VEL_Z_Q, vel_z_q, 0);
   }
-  void add_weapon_slot(int32_t weapon_slot) {
-    fbb_.AddElement<int32_t>(StateSnapshotDelta::VT_WEAPON_SLOT, weapon_slot, 0);
+  void add_weapon_slot(uint8_t weapon_slot) {
+    fbb_.AddElement<uint8_t>(StateSnapshotDelta::VT_WEAPON_SLOT, weapon_slot, 0);
   }
-  void add_ammo_in_mag(int32_t ammo_in_mag) {
-    fbb_.AddElement<int32_t>(StateSnapshotDelta::VT_AMMO_IN_MAG, ammo_in_mag, 0);
+  void add_ammo_in_mag(uint16_t ammo_in_mag) {
+    fbb_.AddElement<uint16_t>(StateSnapshotDelta::VT_AMMO_IN_MAG, ammo_in_mag, 0);
   }
-  void add_dash_cooldown(double dash_cooldown) {
-    fbb_.AddElement<double>(StateSnapshotDelta::VT_DASH_COOLDOWN, dash_cooldown, 0.0);
+  void add_dash_cooldown_q(uint8_t dash_cooldown_q) {
+    fbb_.AddElement<uint8_t>(StateSnapshotDelta::VT_DASH_COOLDOWN_Q, dash_cooldown_q, 0);
   }
-  void add_health(double health) {
-    fbb_.AddElement<double>(StateSnapshotDelta::VT_HEALTH, health, 0.0);
+  void add_health_q(uint16_t health_q) {
+    fbb_.AddElement<uint16_t>(StateSnapshotDelta::VT_HEALTH_Q, health_q, 0);
   }
-  void add_kills(int32_t kills) {
-    fbb_.AddElement<int32_t>(StateSnapshotDelta::VT_KILLS, kills, 0);
+  void add_kills(uint16_t kills) {
+    fbb_.AddElement<uint16_t>(StateSnapshotDelta::VT_KILLS, kills, 0);
   }
-  void add_deaths(int32_t deaths) {
-    fbb_.AddElement<int32_t>(StateSnapshotDelta::VT_DEATHS, deaths, 0);
+  void add_deaths(uint16_t deaths) {
+    fbb_.AddElement<uint16_t>(StateSnapshotDelta::VT_DEATHS, deaths, 0);
   }
   void add_view_yaw_q(int16_t view_yaw_q) {
     fbb_.AddElement<int16_t>(StateSnapshotDelta::VT_VIEW_YAW_Q, view_yaw_q, 0);
@@ -3890,37 +3896,25 @@ inline ::flatbuffers::Offset<StateSnapshotDelta> CreateStateSnapshotDelta(
     int32_t last_processed_input_seq = 0,
     int32_t mask = 0,
     ::flatbuffers::Offset<::flatbuffers::String> client_id = 0,
-    double pos_x = 0.0,
-    double pos_y = 0.0,
-    double pos_z = 0.0,
-    double vel_x = 0.0,
-    double vel_y = 0.0,
-    double vel_z = 0.0,
-    int32_t weapon_slot = 0,
-    int32_t ammo_in_mag = 0,
-    double dash_cooldown = 0.0,
-    double health = 0.0,
-    int32_t kills = 0,
-    int32_t deaths = 0,
+    int16_t pos_x_q = 0,
+    int16_t pos_y_q = 0,
+    int16_t pos_z_q = 0,
+    int16_t vel_x_q = 0,
+    int16_t vel_y_q = 0,
+    int16_t vel_z_q = 0,
+    uint8_t weapon_slot = 0,
+    uint16_t ammo_in_mag = 0,
+    uint8_t dash_cooldown_q = 0,
+    uint16_t health_q = 0,
+    uint16_t kills = 0,
+    uint16_t deaths = 0,
     int16_t view_yaw_q = 0,
     int16_t view_pitch_q = 0,
     uint8_t player_flags = 0,
     uint16_t weapon_heat_q = 0,
     uint32_t loadout_bits = 0) {
   StateSnapshotDeltaBuilder builder_(_fbb);
-  builder_.add_health(health);
-  builder_.add_dash_cooldown(dash_cooldown);
-  builder_.add_vel_z(vel_z);
-  builder_.add_vel_y(vel_y);
-  builder_.add_vel_x(vel_x);
-  builder_.add_pos_z(pos_z);
-  builder_.add_pos_y(pos_y);
-  builder_.add_pos_x(pos_x);
   builder_.add_loadout_bits(loadout_bits);
-  builder_.add_deaths(deaths);
-  builder_.add_kills(kills);
-  builder_.add_ammo_in_mag(ammo_in_mag);
-  builder_.add_weapon_slot(weapon_slot);
   builder_.add_client_id(client_id);
   builder_.add_mask(mask);
   builder_.add_last_processed_input_seq(last_processed_input_seq);
@@ -3929,7 +3923,19 @@ inline ::flatbuffers::Offset<StateSnapshotDelta> CreateStateSnapshotDelta(
   builder_.add_weapon_heat_q(weapon_heat_q);
   builder_.add_view_pitch_q(view_pitch_q);
   builder_.add_view_yaw_q(view_yaw_q);
+  builder_.add_deaths(deaths);
+  builder_.add_kills(kills);
+  builder_.add_health_q(health_q);
+  builder_.add_ammo_in_mag(ammo_in_mag);
+  builder_.add_vel_z_q(vel_z_q);
+  builder_.add_vel_y_q(vel_y_q);
+  builder_.add_vel_x_q(vel_x_q);
+  builder_.add_pos_z_q(pos_z_q);
+  builder_.add_pos_y_q(pos_y_q);
+  builder_.add_pos_x_q(pos_x_q);
   builder_.add_player_flags(player_flags);
+  builder_.add_dash_cooldown_q(dash_cooldown_q);
+  builder_.add_weapon_slot(weapon_slot);
   return builder_.Finish();
 }
 
@@ -3940,18 +3946,18 @@ inline ::flatbuffers::Offset<StateSnapshotDelta> CreateStateSnapshotDeltaDirect(
     int32_t last_processed_input_seq = 0,
     int32_t mask = 0,
     const char *client_id = nullptr,
-    double pos_x = 0.0,
-    double pos_y = 0.0,
-    double pos_z = 0.0,
-    double vel_x = 0.0,
-    double vel_y = 0.0,
-    double vel_z = 0.0,
-    int32_t weapon_slot = 0,
-    int32_t ammo_in_mag = 0,
-    double dash_cooldown = 0.0,
-    double health = 0.0,
-    int32_t kills = 0,
-    int32_t deaths = 0,
+    int16_t pos_x_q = 0,
+    int16_t pos_y_q = 0,
+    int16_t pos_z_q = 0,
+    int16_t vel_x_q = 0,
+    int16_t vel_y_q = 0,
+    int16_t vel_z_q = 0,
+    uint8_t weapon_slot = 0,
+    uint16_t ammo_in_mag = 0,
+    uint8_t dash_cooldown_q = 0,
+    uint16_t health_q = 0,
+    uint16_t kills = 0,
+    uint16_t deaths = 0,
     int16_t view_yaw_q = 0,
     int16_t view_pitch_q = 0,
     uint8_t player_flags = 0,
@@ -3965,16 +3971,16 @@ inline ::flatbuffers::Offset<StateSnapshotDelta> CreateStateSnapshotDeltaDirect(
       last_processed_input_seq,
       mask,
       client_id__,
-      pos_x,
-      pos_y,
-      pos_z,
-      vel_x,
-      vel_y,
-      vel_z,
+      pos_x_q,
+      pos_y_q,
+      pos_z_q,
+      vel_x_q,
+      vel_y_q,
+      vel_z_q,
       weapon_slot,
       ammo_in_mag,
-      dash_cooldown,
-      health,
+      dash_cooldown_q,
+      health_q,
       kills,
       deaths,
       view_yaw_q,
@@ -4432,6 +4438,103 @@ inline ::flatbuffers::Offset<Disconnect> CreateDisconnectDirect(
 
 ::flatbuffers::Offset<Disconnect> CreateDisconnect(::flatbuffers::FlatBufferBuilder &_fbb, const DisconnectT *_o, const ::flatbuffers::rehasher_function_t *_rehasher = nullptr);
 
+struct WorldSnapshotT : public ::flatbuffers::NativeTable {
+  typedef WorldSnapshot TableType;
+  int32_t server_tick = 0;
+  std::vector<std::unique_ptr<afps::protocol::StateSnapshotT>> snapshots{};
+  std::vector<std::unique_ptr<afps::protocol::StateSnapshotDeltaT>> deltas{};
+  WorldSnapshotT() = default;
+  WorldSnapshotT(const WorldSnapshotT &o);
+  WorldSnapshotT(WorldSnapshotT&&) FLATBUFFERS_NOEXCEPT = default;
+  WorldSnapshotT &operator=(WorldSnapshotT o) FLATBUFFERS_NOEXCEPT;
+};
+
+struct WorldSnapshot FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef WorldSnapshotT NativeTableType;
+  typedef WorldSnapshotBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_SERVER_TICK = 4,
+    VT_SNAPSHOTS = 6,
+    VT_DELTAS = 8
+  };
+  int32_t server_tick() const {
+    return GetField<int32_t>(VT_SERVER_TICK, 0);
+  }
+  const ::flatbuffers::Vector<::flatbuffers::Offset<afps::protocol::StateSnapshot>> *snapshots() const {
+    return GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<afps::protocol::StateSnapshot>> *>(VT_SNAPSHOTS);
+  }
+  const ::flatbuffers::Vector<::flatbuffers::Offset<afps::protocol::StateSnapshotDelta>> *deltas() const {
+    return GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<afps::protocol::StateSnapshotDelta>> *>(VT_DELTAS);
+  }
+  template <bool B = false>
+  bool Verify(::flatbuffers::VerifierTemplate<B> &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<int32_t>(verifier, VT_SERVER_TICK, 4) &&
+           VerifyOffset(verifier, VT_SNAPSHOTS) &&
+           verifier.VerifyVector(snapshots()) &&
+           verifier.VerifyVectorOfTables(snapshots()) &&
+           VerifyOffset(verifier, VT_DELTAS) &&
+           verifier.VerifyVector(deltas()) &&
+           verifier.VerifyVectorOfTables(deltas()) &&
+           verifier.EndTable();
+  }
+  WorldSnapshotT *UnPack(const ::flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(WorldSnapshotT *_o, const ::flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static ::flatbuffers::Offset<WorldSnapshot> Pack(::flatbuffers::FlatBufferBuilder &_fbb, const WorldSnapshotT* _o, const ::flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct WorldSnapshotBuilder {
+  typedef WorldSnapshot Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_server_tick(int32_t server_tick) {
+    fbb_.AddElement<int32_t>(WorldSnapshot::VT_SERVER_TICK, server_tick, 0);
+  }
+  void add_snapshots(::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<afps::protocol::StateSnapshot>>> snapshots) {
+    fbb_.AddOffset(WorldSnapshot::VT_SNAPSHOTS, snapshots);
+  }
+  void add_deltas(::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<afps::protocol::StateSnapshotDelta>>> deltas) {
+    fbb_.AddOffset(WorldSnapshot::VT_DELTAS, deltas);
+  }
+  explicit WorldSnapshotBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<WorldSnapshot> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<WorldSnapshot>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<WorldSnapshot> CreateWorldSnapshot(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    int32_t server_tick = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<afps::protocol::StateSnapshot>>> snapshots = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<afps::protocol::StateSnapshotDelta>>> deltas = 0) {
+  WorldSnapshotBuilder builder_(_fbb);
+  builder_.add_deltas(deltas);
+  builder_.add_snapshots(snapshots);
+  builder_.add_server_tick(server_tick);
+  return builder_.Finish();
+}
+
+inline ::flatbuffers::Offset<WorldSnapshot> CreateWorldSnapshotDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    int32_t server_tick = 0,
+    const std::vector<::flatbuffers::Offset<afps::protocol::StateSnapshot>> *snapshots = nullptr,
+    const std::vector<::flatbuffers::Offset<afps::protocol::StateSnapshotDelta>> *deltas = nullptr) {
+  auto snapshots__ = snapshots ? _fbb.CreateVector<::flatbuffers::Offset<afps::protocol::StateSnapshot>>(*snapshots) : 0;
+  auto deltas__ = deltas ? _fbb.CreateVector<::flatbuffers::Offset<afps::protocol::StateSnapshotDelta>>(*deltas) : 0;
+  return afps::protocol::CreateWorldSnapshot(
+      _fbb,
+      server_tick,
+      snapshots__,
+      deltas__);
+}
+
+::flatbuffers::Offset<WorldSnapshot> CreateWorldSnapshot(::flatbuffers::FlatBufferBuilder &_fbb, const WorldSnapshotT *_o, const ::flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
 inline ShotFiredFxT *ShotFiredFx::UnPack(const ::flatbuffers::resolver_function_t *_resolver) const {
   auto _o = std::unique_ptr<ShotFiredFxT>(new ShotFiredFxT());
   UnPackTo(_o.get(), _resolver);
@@ -5078,46 +5181,8 @@ inline InputCmdT *InputCmd::UnPack(const ::flatbuffers::resolver_function_t *_re
 inline void InputCmd::UnPackTo(InputCmdT *_o, const ::flatbuffers::resolver_function_t *_resolver) const {
   (void)_o;
   (void)_resolver;
-  { auto _e = input_seq(); _o->input_seq = _e; }
-  { auto _e = move_x(); _o->move_x = _e; }
-  { auto _e = move_y(); _o->move_y = _e; }
-  { auto _e = look_delta_x(); _o->look_delta_x = _e; }
-  { auto _e = look_delta_y(); _o->look_delta_y = _e; }
-  { auto _e = view_yaw(); _o->view_yaw = _e; }
-  { auto _e = view_pitch(); _o->view_pitch = _e; }
-  { auto _e = weapon_slot(); _o->weapon_slot = _e; }
-  { auto _e = jump(); _o->jump = _e; }
-  { auto _e = fire(); _o->fire = _e; }
-  { auto _e = ads(); _o->ads = _e; }
-  { auto _e = sprint(); _o->sprint = _e; }
-  { auto _e = dash(); _o->dash = _e; }
-  { auto _e = grapple(); _o->grapple = _e; }
-  { auto _e = shield(); _o->shield = _e; }
-  { auto _e = shockwave(); _o->shockwave = _e; }
-  { auto _e = crouch(); _o->crouch = _e; }
-  { auto _e = debug_decal_report_present(); _o->debug_decal_report_present = _e; }
-  { auto _e = debug_decal_server_tick(); _o->debug_decal_server_tick = _e; }
-  { auto _e = debug_decal_shot_seq(); _o->debug_decal_shot_seq = _e; }
-  { auto _e = debug_decal_hit_kind(); _o->debug_decal_hit_kind = _e; }
-  { auto _e = debug_decal_surface_type(); _o->debug_decal_surface_type = _e; }
-  { auto _e = debug_decal_authoritative_world_hit(); _o->debug_decal_authoritative_world_hit = _e; }
-  { auto _e = debug_decal_used_projected_hit(); _o->debug_decal_used_projected_hit = _e; }
-  { auto _e = debug_decal_used_impact_projection(); _o->debug_decal_used_impact_projection = _e; }
-  { auto _e = debug_decal_spawned(); _o->debug_decal_spawned = _e; }
-  { auto _e = debug_decal_in_frustum(); _o->debug_decal_in_frustum = _e; }
-  { auto _e = debug_decal_distance(); _o->debug_decal_distance = _e; }
-  { auto _e = debug_decal_position_x(); _o->debug_decal_position_x = _e; }
-  { auto _e = debug_decal_position_y(); _o->debug_decal_position_y = _e; }
-  { auto _e = debug_decal_position_z(); _o->debug_decal_position_z = _e; }
-  { auto _e = debug_decal_normal_x(); _o->debug_decal_normal_x = _e; }
-  { auto _e = debug_decal_normal_y(); _o->debug_decal_normal_y = _e; }
-  { auto _e = debug_decal_normal_z(); _o->debug_decal_normal_z = _e; }
-  { auto _e = debug_trace_hit_position_x(); _o->debug_trace_hit_position_x = _e; }
-  { auto _e = debug_trace_hit_position_y(); _o->debug_trace_hit_position_y = _e; }
-  { auto _e = debug_trace_hit_position_z(); _o->debug_trace_hit_position_z = _e; }
-  { auto _e = debug_trace_hit_normal_x(); _o->debug_trace_hit_normal_x = _e; }
-  { auto _e = debug_trace_hit_normal_y(); _o->debug_trace_hit_normal_y = _e; }
-  { auto _e = debug_trace_hit_normal_z(); _o->debug_trace_hit_normal_z = _e; }
+  { auto _e = frames(); if (_e) { _o->frames.resize(_e->size()); for (::flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->frames[_i] = *_e->Get(_i); } } else { _o->frames.resize(0); } }
+  { auto _e = server_seq_ack_bits(); _o->server_seq_ack_bits = _e; }
 }
 
 inline ::flatbuffers::Offset<InputCmd> CreateInputCmd(::flatbuffers::FlatBufferBuilder &_fbb, const InputCmdT *_o, const ::flatbuffers::rehasher_function_t *_rehasher) {
@@ -5128,88 +5193,101 @@ inline ::flatbuffers::Offset<InputCmd> InputCmd::Pack(::flatbuffers::FlatBufferB
   (void)_rehasher;
   (void)_o;
   struct _VectorArgs { ::flatbuffers::FlatBufferBuilder *__fbb; const InputCmdT* __o; const ::flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
-  auto _input_seq = _o->input_seq;
-  auto _move_x = _o->move_x;
-  auto _move_y = _o->move_y;
-  auto _look_delta_x = _o->look_delta_x;
-  auto _look_delta_y = _o->look_delta_y;
-  auto _view_yaw = _o->view_yaw;
-  auto _view_pitch = _o->view_pitch;
-  auto _weapon_slot = _o->weapon_slot;
-  auto _jump = _o->jump;
-  auto _fire = _o->fire;
-  auto _ads = _o->ads;
-  auto _sprint = _o->sprint;
-  auto _dash = _o->dash;
-  auto _grapple = _o->grapple;
-  auto _shield = _o->shield;
-  auto _shockwave = _o->shockwave;
-  auto _crouch = _o->crouch;
-  auto _debug_decal_report_present = _o->debug_decal_report_present;
-  auto _debug_decal_server_tick = _o->debug_decal_server_tick;
-  auto _debug_decal_shot_seq = _o->debug_decal_shot_seq;
-  auto _debug_decal_hit_kind = _o->debug_decal_hit_kind;
-  auto _debug_decal_surface_type = _o->debug_decal_surface_type;
-  auto _debug_decal_authoritative_world_hit = _o->debug_decal_authoritative_world_hit;
-  auto _debug_decal_used_projected_hit = _o->debug_decal_used_projected_hit;
-  auto _debug_decal_used_impact_projection = _o->debug_decal_used_impact_projection;
-  auto _debug_decal_spawned = _o->debug_decal_spawned;
-  auto _debug_decal_in_frustum = _o->debug_decal_in_frustum;
-  auto _debug_decal_distance = _o->debug_decal_distance;
-  auto _debug_decal_position_x = _o->debug_decal_position_x;
-  auto _debug_decal_position_y = _o->debug_decal_position_y;
-  auto _debug_decal_position_z = _o->debug_decal_position_z;
-  auto _debug_decal_normal_x = _o->debug_decal_normal_x;
-  auto _debug_decal_normal_y = _o->debug_decal_normal_y;
-  auto _debug_decal_normal_z = _o->debug_decal_normal_z;
-  auto _debug_trace_hit_position_x = _o->debug_trace_hit_position_x;
-  auto _debug_trace_hit_position_y = _o->debug_trace_hit_position_y;
-  auto _debug_trace_hit_position_z = _o->debug_trace_hit_position_z;
-  auto _debug_trace_hit_normal_x = _o->debug_trace_hit_normal_x;
-  auto _debug_trace_hit_normal_y = _o->debug_trace_hit_normal_y;
-  auto _debug_trace_hit_normal_z = _o->debug_trace_hit_normal_z;
+  auto _frames = _o->frames.size() ? _fbb.CreateVectorOfStructs(_o->frames) : 0;
+  auto _server_seq_ack_bits = _o->server_seq_ack_bits;
   return afps::protocol::CreateInputCmd(
       _fbb,
-      _input_seq,
-      _move_x,
-      _move_y,
-      _look_delta_x,
-      _look_delta_y,
-      _view_yaw,
-      _view_pitch,
-      _weapon_slot,
-      _jump,
-      _fire,
-      _ads,
-      _sprint,
-      _dash,
-      _grapple,
-      _shield,
-      _shockwave,
-      _crouch,
-      _debug_decal_report_present,
-      _debug_decal_server_tick,
-      _debug_decal_shot_seq,
-      _debug_decal_hit_kind,
-      _debug_decal_surface_type,
-      _debug_decal_authoritative_world_hit,
-      _debug_decal_used_projected_hit,
-      _debug_decal_used_impact_projection,
-      _debug_decal_spawned,
-      _debug_decal_in_frustum,
-      _debug_decal_distance,
-      _debug_decal_position_x,
-      _debug_decal_position_y,
-      _debug_decal_position_z,
-      _debug_decal_normal_x,
-      _debug_decal_normal_y,
-      _debug_decal_normal_z,
-      _debug_trace_hit_position_x,
-      _debug_trace_hit_position_y,
-      _debug_trace_hit_position_z,
-      _debug_trace_hit_normal_x,
-      _debug_trace_hit_normal_y,
-      _debug_trace_hit_normal_z);
+      _frames,
+      _server_seq_ack_bits);
+}
+
+inline DecalDebugReportT *DecalDebugReport::UnPack(const ::flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = std::unique_ptr<DecalDebugReportT>(new DecalDebugReportT());
+  UnPackTo(_o.get(), _resolver);
+  return _o.release();
+}
+
+inline void DecalDebugReport::UnPackTo(DecalDebugReportT *_o, const ::flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = server_tick(); _o->server_tick = _e; }
+  { auto _e = shot_seq(); _o->shot_seq = _e; }
+  { auto _e = hit_kind(); _o->hit_kind = _e; }
+  { auto _e = surface_type(); _o->surface_type = _e; }
+  { auto _e = authoritative_world_hit(); _o->authoritative_world_hit = _e; }
+  { auto _e = used_projected_hit(); _o->used_projected_hit = _e; }
+  { auto _e = used_impact_projection(); _o->used_impact_projection = _e; }
+  { auto _e = decal_spawned(); _o->decal_spawned = _e; }
+  { auto _e = decal_in_frustum(); _o->decal_in_frustum = _e; }
+  { auto _e = decal_distance(); _o->decal_distance = _e; }
+  { auto _e = decal_position_x(); _o->decal_position_x = _e; }
+  { auto _e = decal_position_y(); _o->decal_position_y = _e; }
+  { auto _e = decal_position_z(); _o->decal_position_z = _e; }
+  { auto _e = decal_normal_x(); _o->decal_normal_x = _e; }
+  { auto _e = decal_normal_y(); _o->decal_normal_y = _e; }
+  { auto _e = decal_normal_z(); _o->decal_normal_z = _e; }
+  { auto _e = trace_hit_position_x(); _o->trace_hit_position_x = _e; }
+  { auto _e = trace_hit_position_y(); _o->trace_hit_position_y = _e; }
+  { auto _e = trace_hit_position_z(); _o->trace_hit_position_z = _e; }
+  { auto _e = trace_hit_normal_x(); _o->trace_hit_normal_x = _e; }
+  { auto _e = trace_hit_normal_y(); _o->trace_hit_normal_y = _e; }
+  { auto _e = trace_hit_normal_z(); _o->trace_hit_normal_z = _e; }
+}
+
+inline ::flatbuffers::Offset<DecalDebugReport> CreateDecalDebugReport(::flatbuffers::FlatBufferBuilder &_fbb, const DecalDebugReportT *_o, const ::flatbuffers::rehasher_function_t *_rehasher) {
+  return DecalDebugReport::Pack(_fbb, _o, _rehasher);
+}
+
+inline ::flatbuffers::Offset<DecalDebugReport> DecalDebugReport::Pack(::flatbuffers::FlatBufferBuilder &_fbb, const DecalDebugReportT* _o, const ::flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { ::flatbuffers::FlatBufferBuilder *__fbb; const DecalDebugReportT* __o; const ::flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _server_tick = _o->server_tick;
+  auto _shot_seq = _o->shot_seq;
+  auto _hit_kind = _o->hit_kind;
+  auto _surface_type = _o->surface_type;
+  auto _authoritative_world_hit = _o->authoritative_world_hit;
+  auto _used_projected_hit = _o->used_projected_hit;
+  auto _used_impact_projection = _o->used_impact_projection;
+  auto _decal_spawned = _o->decal_spawned;
+  auto _decal_in_frustum = _o->decal_in_frustum;
+  auto _decal_distance = _o->decal_distance;
+  auto _decal_position_x = _o->decal_position_x;
+  auto _decal_position_y = _o->decal_position_y;
+  auto _decal_position_z = _o->decal_position_z;
+  auto _decal_normal_x = _o->decal_normal_x;
+  auto _decal_normal_y = _o->decal_normal_y;
+  auto _decal_normal_z = _o->decal_normal_z;
+  auto _trace_hit_position_x = _o->trace_hit_position_x;
+  auto _trace_hit_position_y = _o->trace_hit_position_y;
+  auto _trace_hit_position_z = _o->trace_hit_position_z;
+  auto _trace_hit_normal_x = _o->trace_hit_normal_x;
+  auto _trace_hit_normal_y = _o->trace_hit_normal_y;
+  auto _trace_hit_normal_z = _o->trace_hit_normal_z;
+  return afps::protocol::CreateDecalDebugReport(
+      _fbb,
+      _server_tick,
+      _shot_seq,
+      _hit_kind,
+      _surface_type,
+      _authoritative_world_hit,
+      _used_projected_hit,
+      _used_impact_projection,
+      _decal_spawned,
+      _decal_in_frustum,
+      _decal_distance,
+      _decal_position_x,
+      _decal_position_y,
+      _decal_position_z,
+      _decal_normal_x,
+      _decal_normal_y,
+      _decal_normal_z,
+      _trace_hit_position_x,
+      _trace_hit_position_y,
+      _trace_hit_position_z,
+      _trace_hit_normal_x,
+      _trace_hit_normal_y,
+      _trace_hit_normal_z);
 }
 
 inline FireWeaponRequestT *FireWeaponRequest::UnPack(const ::flatbuffers::resolver_function_t *_resolver) const {
@@ -5321,16 +5399,16 @@ inline void StateSnapshot::UnPackTo(StateSnapshotT *_o, const ::flatbuffers::res
   { auto _e = server_tick(); _o->server_tick = _e; }
   { auto _e = last_processed_input_seq(); _o->last_processed_input_seq = _e; }
   { auto _e = client_id(); if (_e) _o->client_id = _e->str(); }
-  { auto _e = pos_x(); _o->pos_x = _e; }
-  { auto _e = pos_y(); _o->pos_y = _e; }
-  { auto _e = pos_z(); _o->pos_z = _e; }
-  { auto _e = vel_x(); _o->vel_x = _e; }
-  { auto _e = vel_y(); _o->vel_y = _e; }
-  { auto _e = vel_z(); _o->vel_z = _e; }
+  { auto _e = pos_x_q(); _o->pos_x_q = _e; }
+  { auto _e = pos_y_q(); _o->pos_y_q = _e; }
+  { auto _e = pos_z_q(); _o->pos_z_q = _e; }
+  { auto _e = vel_x_q(); _o->vel_x_q = _e; }
+  { auto _e = vel_y_q(); _o->vel_y_q = _e; }
+  { auto _e = vel_z_q(); _o->vel_z_q = _e; }
   { auto _e = weapon_slot(); _o->weapon_slot = _e; }
   { auto _e = ammo_in_mag(); _o->ammo_in_mag = _e; }
-  { auto _e = dash_cooldown(); _o->dash_cooldown = _e; }
-  { auto _e = health(); _o->health = _e; }
+  { auto _e = dash_cooldown_q(); _o->dash_cooldown_q = _e; }
+  { auto _e = health_q(); _o->health_q = _e; }
   { auto _e = kills(); _o->kills = _e; }
   { auto _e = deaths(); _o->deaths = _e; }
   { auto _e = view_yaw_q(); _o->view_yaw_q = _e; }
@@ -5351,16 +5429,16 @@ inline ::flatbuffers::Offset<StateSnapshot> StateSnapshot::Pack(::flatbuffers::F
   auto _server_tick = _o->server_tick;
   auto _last_processed_input_seq = _o->last_processed_input_seq;
   auto _client_id = _o->client_id.empty() ? 0 : _fbb.CreateString(_o->client_id);
-  auto _pos_x = _o->pos_x;
-  auto _pos_y = _o->pos_y;
-  auto _pos_z = _o->pos_z;
-  auto _vel_x = _o->vel_x;
-  auto _vel_y = _o->vel_y;
-  auto _vel_z = _o->vel_z;
+  auto _pos_x_q = _o->pos_x_q;
+  auto _pos_y_q = _o->pos_y_q;
+  auto _pos_z_q = _o->pos_z_q;
+  auto _vel_x_q = _o->vel_x_q;
+  auto _vel_y_q = _o->vel_y_q;
+  auto _vel_z_q = _o->vel_z_q;
   auto _weapon_slot = _o->weapon_slot;
   auto _ammo_in_mag = _o->ammo_in_mag;
-  auto _dash_cooldown = _o->dash_cooldown;
-  auto _health = _o->health;
+  auto _dash_cooldown_q = _o->dash_cooldown_q;
+  auto _health_q = _o->health_q;
   auto _kills = _o->kills;
   auto _deaths = _o->deaths;
   auto _view_yaw_q = _o->view_yaw_q;
@@ -5373,16 +5451,16 @@ inline ::flatbuffers::Offset<StateSnapshot> StateSnapshot::Pack(::flatbuffers::F
       _server_tick,
       _last_processed_input_seq,
       _client_id,
-      _pos_x,
-      _pos_y,
-      _pos_z,
-      _vel_x,
-      _vel_y,
-      _vel_z,
+      _pos_x_q,
+      _pos_y_q,
+      _pos_z_q,
+      _vel_x_q,
+      _vel_y_q,
+      _vel_z_q,
       _weapon_slot,
       _ammo_in_mag,
-      _dash_cooldown,
-      _health,
+      _dash_cooldown_q,
+      _health_q,
       _kills,
       _deaths,
       _view_yaw_q,
@@ -5406,16 +5484,16 @@ inline void StateSnapshotDelta::UnPackTo(StateSnapshotDeltaT *_o, const ::flatbu
   { auto _e = last_processed_input_seq(); _o->last_processed_input_seq = _e; }
   { auto _e = mask(); _o->mask = _e; }
   { auto _e = client_id(); if (_e) _o->client_id = _e->str(); }
-  { auto _e = pos_x(); _o->pos_x = _e; }
-  { auto _e = pos_y(); _o->pos_y = _e; }
-  { auto _e = pos_z(); _o->pos_z = _e; }
-  { auto _e = vel_x(); _o->vel_x = _e; }
-  { auto _e = vel_y(); _o->vel_y = _e; }
-  { auto _e = vel_z(); _o->vel_z = _e; }
+  { auto _e = pos_x_q(); _o->pos_x_q = _e; }
+  { auto _e = pos_y_q(); _o->pos_y_q = _e; }
+  { auto _e = pos_z_q(); _o->pos_z_q = _e; }
+  { auto _e = vel_x_q(); _o->vel_x_q = _e; }
+  { auto _e = vel_y_q(); _o->vel_y_q = _e; }
+  { auto _e = vel_z_q(); _o->vel_z_q = _e; }
   { auto _e = weapon_slot(); _o->weapon_slot = _e; }
   { auto _e = ammo_in_mag(); _o->ammo_in_mag = _e; }
-  { auto _e = dash_cooldown(); _o->dash_cooldown = _e; }
-  { auto _e = health(); _o->health = _e; }
+  { auto _e = dash_cooldown_q(); _o->dash_cooldown_q = _e; }
+  { auto _e = health_q(); _o->health_q = _e; }
   { auto _e = kills(); _o->kills = _e; }
   { auto _e = deaths(); _o->deaths = _e; }
   { auto _e = view_yaw_q(); _o->view_yaw_q = _e; }
@@ -5438,16 +5516,16 @@ inline ::flatbuffers::Offset<StateSnapshotDelta> StateSnapshotDelta::Pack(::flat
   auto _last_processed_input_seq = _o->last_processed_input_seq;
   auto _mask = _o->mask;
   auto _client_id = _o->client_id.empty() ? 0 : _fbb.CreateString(_o->client_id);
-  auto _pos_x = _o->pos_x;
-  auto _pos_y = _o->pos_y;
-  auto _pos_z = _o->pos_z;
-  auto _vel_x = _o->vel_x;
-  auto _vel_y = _o->vel_y;
-  auto _vel_z = _o->vel_z;
+  auto _pos_x_q = _o->pos_x_q;
+  auto _pos_y_q = _o->pos_y_q;
+  auto _pos_z_q = _o->pos_z_q;
+  auto _vel_x_q = _o->vel_x_q;
+  auto _vel_y_q = _o->vel_y_q;
+  auto _vel_z_q = _o->vel_z_q;
   auto _weapon_slot = _o->weapon_slot;
   auto _ammo_in_mag = _o->ammo_in_mag;
-  auto _dash_cooldown = _o->dash_cooldown;
-  auto _health = _o->health;
+  auto _dash_cooldown_q = _o->dash_cooldown_q;
+  auto _health_q = _o->health_q;
   auto _kills = _o->kills;
   auto _deaths = _o->deaths;
   auto _view_yaw_q = _o->view_yaw_q;
@@ -5462,16 +5540,16 @@ inline ::flatbuffers::Offset<StateSnapshotDelta> StateSnapshotDelta::Pack(::flat
       _last_processed_input_seq,
       _mask,
       _client_id,
-      _pos_x,
-      _pos_y,
-      _pos_z,
-      _vel_x,
-      _vel_y,
-      _vel_z,
+      _pos_x_q,
+      _pos_y_q,
+      _pos_z_q,
+      _vel_x_q,
+      _vel_y_q,
+      _vel_z_q,
       _weapon_slot,
       _ammo_in_mag,
-      _dash_cooldown,
-      _health,
+      _dash_cooldown_q,
+      _health_q,
       _kills,
       _deaths,
       _view_yaw_q,
@@ -5655,6 +5733,53 @@ inline ::flatbuffers::Offset<Disconnect> Disconnect::Pack(::flatbuffers::FlatBuf
       _message);
 }
 
+inline WorldSnapshotT::WorldSnapshotT(const WorldSnapshotT &o)
+      : server_tick(o.server_tick) {
+  snapshots.reserve(o.snapshots.size());
+  for (const auto &snapshots_ : o.snapshots) { snapshots.emplace_back((snapshots_) ? new afps::protocol::StateSnapshotT(*snapshots_) : nullptr); }
+  deltas.reserve(o.deltas.size());
+  for (const auto &deltas_ : o.deltas) { deltas.emplace_back((deltas_) ? new afps::protocol::StateSnapshotDeltaT(*deltas_) : nullptr); }
+}
+
+inline WorldSnapshotT &WorldSnapshotT::operator=(WorldSnapshotT o) FLATBUFFERS_NOEXCEPT {
+  std::swap(server_tick, o.server_tick);
+  std::swap(snapshots, o.snapshots);
+  std::swap(deltas, o.deltas);
+  return *this;
+}
+
+inline WorldSnapshotT *WorldSnapshot::UnPack(const ::flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = std::unique_ptr<WorldSnapshotT>(new WorldSnapshotT());
+  UnPackTo(_o.get(), _resolver);
+  return _o.release();
+}
+
+inline void WorldSnapshot::UnPackTo(WorldSnapshotT *_o, const ::flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = server_tick(); _o->server_tick = _e; }
+  { auto _e = snapshots(); if (_e) { _o->snapshots.resize(_e->size()); for (::flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if(_o->snapshots[_i]) { _e->Get(_i)->UnPackTo(_o->snapshots[_i].get(), _resolver); } else { _o->snapshots[_i] = std::unique_ptr<afps::protocol::StateSnapshotT>(_e->Get(_i)->UnPack(_resolver)); }; } } else { _o->snapshots.resize(0); } }
+  { auto _e = deltas(); if (_e) { _o->deltas.resize(_e->size()); for (::flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if(_o->deltas[_i]) { _e->Get(_i)->UnPackTo(_o->deltas[_i].get(), _resolver); } else { _o->deltas[_i] = std::unique_ptr<afps::protocol::StateSnapshotDeltaT>(_e->Get(_i)->UnPack(_resolver)); }; } } else { _o->deltas.resize(0); } }
+}
+
+inline ::flatbuffers::Offset<WorldSnapshot> CreateWorldSnapshot(::flatbuffers::FlatBufferBuilder &_fbb, const WorldSnapshotT *_o, const ::flatbuffers::rehasher_function_t *_rehasher) {
+  return WorldSnapshot::Pack(_fbb, _o, _rehasher);
+}
+
+inline ::flatbuffers::Offset<WorldSnapshot> WorldSnapshot::Pack(::flatbuffers::FlatBufferBuilder &_fbb, const WorldSnapshotT* _o, const ::flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { ::flatbuffers::FlatBufferBuilder *__fbb; const WorldSnapshotT* __o; const ::flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _server_tick = _o->server_tick;
+  auto _snapshots = _o->snapshots.size() ? _fbb.CreateVector<::flatbuffers::Offset<afps::protocol::StateSnapshot>> (_o->snapshots.size(), [](size_t i, _VectorArgs *__va) { return CreateStateSnapshot(*__va->__fbb, __va->__o->snapshots[i].get(), __va->__rehasher); }, &_va ) : 0;
+  auto _deltas = _o->deltas.size() ? _fbb.CreateVector<::flatbuffers::Offset<afps::protocol::StateSnapshotDelta>> (_o->deltas.size(), [](size_t i, _VectorArgs *__va) { return CreateStateSnapshotDelta(*__va->__fbb, __va->__o->deltas[i].get(), __va->__rehasher); }, &_va ) : 0;
+  return afps::protocol::CreateWorldSnapshot(
+      _fbb,
+      _server_tick,
+      _snapshots,
+      _deltas);
+}
+
 template <bool B>
 inline bool VerifyFxEvent(::flatbuffers::VerifierTemplate<B> &verifier, const void *obj, FxEvent type) {
   switch (type) {
@@ -67,8 +67,26 @@ struct AabbCollider {
   uint32_t tags = 0;
 };
 
+// Bounding volume node over collider indices. Inner nodes have count == 0 and children at
+// first and first + 1; leaves cover bvh_indices[first, first + count).
+struct ColliderBvhNode {
+  double min_x = 0.0;
+  double min_y = 0.0;
+  double min_z = 0.0;
+  double max_x = 0.0;
+  double max_y = 0.0;
+  double max_z = 0.0;
+  uint32_t first = 0;
+  uint32_t count = 0;
+};
+
 struct CollisionWorld {
   std::vector<AabbCollider> colliders;
+  // Built by SetAabbColliders/BuildColliderBvh. Queries fall back to scanning every collider
+  // once colliders has grown past bvh_collider_count (e.g. after AddAabbCollider).
+  std::vector<ColliderBvhNode> bvh_nodes;
+  std::vector<uint32_t> bvh_indices;
+  size_t bvh_collider_count = 0;
 };
 
 inline bool IsValidAabbCollider(const AabbCollider &collider) {
@@ -84,6 +102,9 @@ inline bool IsValidAabbCollider(const AabbCollider &collider) {
 
 inline void ClearColliders(CollisionWorld &world) {
   world.colliders.clear();
+  world.bvh_nodes.clear();
+  world.bvh_indices.clear();
+  world.bvh_collider_count = 0;
 }
 
 inline void AddAabbCollider(CollisionWorld &world, const AabbCollider &collider) {
@@ -93,12 +114,151 @@ inline void AddAabbCollider(CollisionWorld &world, const AabbCollider &collider)
   world.colliders.push_back(collider);
 }
 
+constexpr uint32_t kColliderBvhLeafSize = 4;
+constexpr size_t kColliderBvhStackSize = 64;
+// Node bounds are padded so rounding in the node tests can only add candidates, never drop one.
+constexpr double kColliderBvhPadding = 1e-6;
+
+inline bool HasColliderBvh(const CollisionWorld &world) {
+  return world.bvh_collider_count == world.colliders.size();
+}
+
+inline void BuildColliderBvhNode(CollisionWorld &world, uint32_t node_index, uint32_t begin, uint32_t end,
+                                 uint32_t depth) {
+  ColliderBvhNode node;
+  node.min_x = std::numeric_limits<double>::infinity();
+  node.min_y = node.min_x;
+  node.min_z = node.min_x;
+  node.max_x = -std::numeric_limits<double>::infinity();
+  node.max_y = node.max_x;
+  node.max_z = node.max_x;
+  double centroid_min[3] = {node.min_x, node.min_x, node.min_x};
+  double centroid_max[3] = {node.max_x, node.max_x, node.max_x};
+  for (uint32_t i = begin; i < end; ++i) {
+    const AabbCollider &collider = world.colliders[world.bvh_indices[i]];
+    node.min_x = std::min(node.min_x, collider.min_x);
+    node.min_y = std::min(node.min_y, collider.min_y);
+    node.min_z = std::min(node.min_z, collider.min_z);
+    node.max_x = std::max(node.max_x, collider.max_x);
+    node.max_y = std::max(node.max_y, collider.max_y);
+    node.max_z = std::max(node.max_z, collider.max_z);
+    const double centroid[3] = {collider.min_x + collider.max_x, collider.min_y + collider.max_y,
+                                collider.min_z + collider.max_z};
+    for (int axis = 0; axis < 3; ++axis) {
+      centroid_min[axis] = std::min(centroid_min[axis], centroid[axis]);
+      centroid_max[axis] = std::max(centroid_max[axis], centroid[axis]);
+    }
+  }
+  const double pad_x = kColliderBvhPadding * (1.0 + std::max(std::abs(node.min_x), std::abs(node.max_x)));
+  const double pad_y = kColliderBvhPadding * (1.0 + std::max(std::abs(node.min_y), std::abs(node.max_y)));
+  const double pad_z = kColliderBvhPadding * (1.0 + std::max(std::abs(node.min_z), std::abs(node.max_z)));
+  node.min_x -= pad_x;
+  node.max_x += pad_x;
+  node.min_y -= pad_y;
+  node.max_y += pad_y;
+  node.min_z -= pad_z;
+  node.max_z += pad_z;
+
+  int axis = 0;
+  for (int candidate = 1; candidate < 3; ++candidate) {
+    if (centroid_max[candidate] - centroid_min[candidate] > centroid_max[axis] - centroid_min[axis]) {
+      axis = candidate;
+    }
+  }
+  const bool splittable = centroid_max[axis] > centroid_min[axis];
+  if (end - begin <= kColliderBvhLeafSize || !splittable || depth + 2 >= kColliderBvhStackSize) {
+    node.first = begin;
+    node.count = end - begin;
+    world.bvh_nodes[node_index] = node;
+    return;
+  }
+
+  auto centroid_of = [&world, axis](uint32_t index) {
+    const AabbCollider &collider = world.colliders[index];
+    return axis == 0 ? collider.min_x + collider.max_x
+                     : (axis == 1 ? collider.min_y + collider.max_y : collider.min_z + collider.max_z);
+  };
+  const uint32_t mid = begin + (end - begin) / 2;
+  std::nth_element(world.bvh_indices.begin() + begin, world.bvh_indices.begin() + mid,
+                   world.bvh_indices.begin() + end, [&centroid_of](uint32_t a, uint32_t b) {
+                     const double ca = centroid_of(a);
+                     const double cb = centroid_of(b);
+                     return ca < cb || (ca == cb && a < b);
+                   });
+  const auto left = static_cast<uint32_t>(world.bvh_nodes.size());
+  world.bvh_nodes.emplace_back();
+  world.bvh_nodes.emplace_back();
+  node.first = left;
+  node.count = 0;
+  world.bvh_nodes[node_index] = node;
+  BuildColliderBvhNode(world, left, begin, mid, depth + 1);
+  BuildColliderBvhNode(world, left + 1, mid, end, depth + 1);
+}
+
+inline void BuildColliderBvh(CollisionWorld &world) {
+  world.bvh_nodes.clear();
+  world.bvh_indices.clear();
+  world.bvh_indices.reserve(world.colliders.size());
+  for (size_t i = 0; i < world.colliders.size(); ++i) {
+    if (IsValidAabbCollider(world.colliders[i])) {
+      world.bvh_indices.push_back(static_cast<uint32_t>(i));
+    }
+  }
+  world.bvh_collider_count = world.colliders.size();
+  if (world.bvh_indices.empty()) {
+    return;
+  }
+  world.bvh_nodes.reserve(2 * (world.bvh_indices.size() / kColliderBvhLeafSize + 1));
+  world.bvh_nodes.emplace_back();
+  BuildColliderBvhNode(world, 0, 0, static_cast<uint32_t>(world.bvh_indices.size()), 0);
+}
+
 inline void SetAabbColliders(CollisionWorld &world, const std::vector<AabbCollider> &colliders) {
   world.colliders.clear();
   world.colliders.reserve(colliders.size());
   for (const auto &collider : colliders) {
     AddAabbCollider(world, collider);
   }
+  BuildColliderBvh(world);
+}
+
+// Replaces out with the indices, ascending, of every collider whose XY bounds may touch the
+// rectangle. Ascending order lets callers visit candidates in the same order as a full scan.
+// May include extra colliders; callers still run their exact tests.
+inline void QueryColliderIndices(const CollisionWorld &world,
+                                 double min_x,
+                                 double max_x,
+                                 double min_y,
+                                 double max_y,
+                                 std::vector<uint32_t> &out) {
+  out.clear();
+  if (!HasColliderBvh(world)) {
+    out.reserve(world.colliders.size());
+    for (size_t i = 0; i < world.colliders.size(); ++i) {
+      out.push_back(static_cast<uint32_t>(i));
+    }
+    return;
+  }
+  if (world.bvh_nodes.empty()) {
+    return;
+  }
+  uint32_t stack[kColliderBvhStackSize];
+  size_t stack_size = 0;
+  stack[stack_size++] = 0;
+  while (stack_size > 0) {
+    const ColliderBvhNode &node = world.bvh_nodes[stack[--stack_size]];
+    if (node.max_x < min_x || node.min_x > max_x || node.max_y < min_y || node.min_y > max_y) {
+      continue;
+    }
+    if (node.count > 0) {
+      out.insert(out.end(), world.bvh_indices.begin() + node.first,
+                 world.bvh_indices.begin() + node.first + node.count);
+      continue;
+    }
+    stack[stack_size++] = node.first;
+    stack[stack_size++] = node.first + 1;
+  }
+  std::sort(out.begin(), out.end());
 }
 
 struct PlayerState {
@@ -280,6 +440,10 @@ struct RaycastWorldOptions {
   double min_t = 0.0;
   double max_t = std::numeric_limits<double>::infinity();
   int ignore_collider_id = std::numeric_limits<int>::min();
+  // Sweeps a sphere of this radius instead of a point: boxes grow by it (with square edges), the
+  // arena shrinks by it, and hits report where the sphere's center stops. A sweep that starts
+  // inside a grown box hits it at min_t.
+  double sweep_radius = 0.0;
 };
 
 inline double WrapAngle(double angle) {
@@ -504,6 +668,203 @@ inline bool GetObstacleAabb(const SimConfig &config,
   return true;
 }
 
+// Same result as testing every collider in order: the nearest hit wins and equal distances go
+// to the lowest collider index, but hits must still beat best.t strictly.
+inline bool ConsiderColliderRayHit(const AabbCollider &collider,
+                                   const Vec3 &origin,
+                                   const Vec3 &dir,
+                                   double min_t,
+                                   double max_t,
+                                   const RaycastWorldOptions &options,
+                                   RaycastHit &best) {
+  if (!IsValidAabbCollider(collider)) {
+    return false;
+  }
+  const double grow = options.sweep_radius;
+  const double min_x = collider.min_x - grow;
+  const double max_x = collider.max_x + grow;
+  const double min_y = collider.min_y - grow;
+  const double max_y = collider.max_y + grow;
+  const double min_z = collider.min_z - grow;
+  const double max_z = collider.max_z + grow;
+  double t = 0.0;
+  double normal_x = 0.0;
+  double normal_y = 0.0;
+  double normal_z = 0.0;
+  if (grow > 0.0 && origin.x > min_x && origin.x < max_x && origin.y > min_y && origin.y < max_y &&
+      origin.z > min_z && origin.z < max_z) {
+    // Already touching: push out through the nearest face.
+    t = min_t;
+    const double faces[6] = {origin.x - min_x, max_x - origin.x, origin.y - min_y,
+                             max_y - origin.y, origin.z - min_z, max_z - origin.z};
+    size_t nearest = 0;
+    for (size_t face = 1; face < 6; ++face) {
+      if (faces[face] < faces[nearest]) {
+        nearest = face;
+      }
+    }
+    const double sign = (nearest % 2 == 0) ? -1.0 : 1.0;
+    normal_x = nearest / 2 == 0 ? sign : 0.0;
+    normal_y = nearest / 2 == 1 ? sign : 0.0;
+    normal_z = nearest / 2 == 2 ? sign : 0.0;
+  } else if (!RaycastAabb3D(origin.x, origin.y, origin.z, dir.x, dir.y, dir.z, min_x, max_x, min_y, max_y,
+                            min_z, max_z, t, normal_x, normal_y, normal_z)) {
+    return false;
+  }
+  if (!std::isfinite(t) || t < min_t || t > max_t || t >= best.t) {
+    return false;
+  }
+  if (collider.id == options.ignore_collider_id) {
+    return false;
+  }
+  best.hit = true;
+  best.t = t;
+  best.normal_x = normal_x;
+  best.normal_y = normal_y;
+  best.normal_z = normal_z;
+  best.collider_id = collider.id;
+  best.surface_type = collider.surface_type;
+  return true;
+}
+
+// Slab test against a padded node grown by grow; uses the same near-parallel rule as
+// RaycastAabb3D so it never rejects a node holding a collider that RaycastAabb3D would hit.
+inline bool RayOverlapsBvhNode(const ColliderBvhNode &node,
+                               const Vec3 &origin,
+                               const Vec3 &dir,
+                               double min_t,
+                               double max_t,
+                               double grow = 0.0) {
+  const double epsilon = 1e-8;
+  double t_enter = -std::numeric_limits<double>::infinity();
+  double t_exit = std::numeric_limits<double>::infinity();
+  auto clip_axis = [&](double o, double d, double lo, double hi) {
+    if (std::abs(d) < epsilon) {
+      return o >= lo && o <= hi;
+    }
+    const double inv = 1.0 / d;
+    const double t1 = (lo - o) * inv;
+    const double t2 = (hi - o) * inv;
+    t_enter = std::max(t_enter, std::min(t1, t2));
+    t_exit = std::min(t_exit, std::max(t1, t2));
+    return t_enter <= t_exit;
+  };
+  if (!clip_axis(origin.x, dir.x, node.min_x - grow, node.max_x + grow) ||
+      !clip_axis(origin.y, dir.y, node.min_y - grow, node.max_y + grow) ||
+      !clip_axis(origin.z, dir.z, node.min_z - grow, node.max_z + grow)) {
+    return false;
+  }
+  return t_exit >= min_t && t_enter <= max_t;
+}
+
+inline void RaycastColliders(const CollisionWorld &world,
+                             const Vec3 &origin,
+                             const Vec3 &dir,
+                             double min_t,
+                             double max_t,
+                             const RaycastWorldOptions &options,
+                             RaycastHit &best) {
+  if (!HasColliderBvh(world)) {
+    for (const auto &collider : world.colliders) {
+      ConsiderColliderRayHit(collider, origin, dir, min_t, max_t, options, best);
+    }
+    return;
+  }
+  if (world.bvh_nodes.empty()) {
+    return;
+  }
+  bool collider_hit = false;
+  uint32_t best_index = 0;
+  uint32_t stack[kColliderBvhStackSize];
+  size_t stack_size = 0;
+  stack[stack_size++] = 0;
+  while (stack_size > 0) {
+    const ColliderBvhNode &node = world.bvh_nodes[stack[--stack_size]];
+    if (!RayOverlapsBvhNode(node, origin, dir, min_t, best.t, options.sweep_radius)) {
+      continue;
+    }
+    if (node.count == 0) {
+      stack[stack_size++] = node.first + 1;
+      stack[stack_size++] = node.first;
+      continue;
+    }
+    for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+      const uint32_t index = world.bvh_indices[i];
+      const AabbCollider &collider = world.colliders[index];
+      RaycastHit candidate = best;
+      if (collider_hit) {
+        // Re-run against the previous best's distance plus one ulp so an equal t can be
+        // compared on index below.
+        candidate.t = std::nextafter(best.t, std::numeric_limits<double>::infinity());
+      }
+      if (!ConsiderColliderRayHit(collider, origin, dir, min_t, max_t, options, candidate)) {
+        continue;
+      }
+      if (collider_hit && candidate.t == best.t && index > best_index) {
+        continue;
+      }
+      best = candidate;
+      best_index = index;
+      collider_hit = true;
+    }
+  }
+}
+
+// Any-hit query for occlusion tests: true if some collider is hit with min_t < t < max_t. Stops at the
+// first hit, so it skips the nearest-hit bookkeeping RaycastColliders needs.
+inline bool RayHitsAnyCollider(const CollisionWorld &world,
+                               const Vec3 &origin,
+                               const Vec3 &dir,
+                               double min_t,
+                               double max_t) {
+  auto hits = [&](const AabbCollider &collider) {
+    if (!IsValidAabbCollider(collider)) {
+      return false;
+    }
+    double t = 0.0;
+    double normal_x = 0.0;
+    double normal_y = 0.0;
+    double normal_z = 0.0;
+    if (!RaycastAabb3D(origin.x, origin.y, origin.z, dir.x, dir.y, dir.z, collider.min_x, collider.max_x,
+                       collider.min_y, collider.max_y, collider.min_z, collider.max_z, t, normal_x, normal_y,
+                       normal_z)) {
+      return false;
+    }
+    return std::isfinite(t) && t > min_t && t < max_t;
+  };
+  if (!HasColliderBvh(world)) {
+    for (const auto &collider : world.colliders) {
+      if (hits(collider)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (world.bvh_nodes.empty()) {
+    return false;
+  }
+  uint32_t stack[kColliderBvhStackSize];
+  size_t stack_size = 0;
+  stack[stack_size++] = 0;
+  while (stack_size > 0) {
+    const ColliderBvhNode &node = world.bvh_nodes[stack[--stack_size]];
+    if (!RayOverlapsBvhNode(node, origin, dir, min_t, max_t)) {
+      continue;
+    }
+    if (node.count == 0) {
+      stack[stack_size++] = node.first + 1;
+      stack[stack_size++] = node.first;
+      continue;
+    }
+    for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+      if (hits(world.colliders[world.bvh_indices[i]])) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 inline RaycastHit RaycastWorld(const Vec3 &origin,
                                const Vec3 &dir,
                                const SimConfig &config,
@@ -518,11 +879,27 @@ inline RaycastHit RaycastWorld(const Vec3 &origin,
   const double max_t =
       (std::isfinite(options.max_t) && options.max_t >= min_t) ? options.max_t : std::numeric_limits<double>::infinity();
   best.t = max_t;
+  const double sweep =
+      (std::isfinite(options.sweep_radius) && options.sweep_radius > 0.0) ? options.sweep_radius : 0.0;
   double arena_min = 0.0;
   double arena_max = 0.0;
   if (GetArenaAabb(config, arena_min, arena_max)) {
+    double wall_min_x = arena_min;
+    double wall_max_x = arena_max;
+    double wall_min_y = arena_min;
+    double wall_max_y = arena_max;
+    if (sweep > 0.0) {
+      // Walls move in by the radius. A sweep already within the radius of a wall and heading into
+      // it hits at once instead of slipping past the moved plane.
+      const double inset = std::min(sweep, arena_max);
+      wall_min_x = dir.x < 0.0 ? std::min(arena_min + inset, origin.x) : arena_min + inset;
+      wall_max_x = dir.x > 0.0 ? std::max(arena_max - inset, origin.x) : arena_max - inset;
+      wall_min_y = dir.y < 0.0 ? std::min(arena_min + inset, origin.y) : arena_min + inset;
+      wall_max_y = dir.y > 0.0 ? std::max(arena_max - inset, origin.y) : arena_max - inset;
+    }
     const double before_t = best.t;
-    RaycastAabb2D(origin.x, origin.y, dir.x, dir.y, arena_min, arena_max, arena_min, arena_max, min_t, max_t, best);
+    RaycastAabb2D(origin.x, origin.y, dir.x, dir.y, wall_min_x, wall_max_x, wall_min_y, wall_max_y, min_t, max_t,
+                  best);
     if (best.hit && best.t < before_t) {
       best.collider_id = -1;
       best.surface_type = 0;
@@ -555,8 +932,11 @@ inline RaycastHit RaycastWorld(const Vec3 &origin,
       const double player_height =
           (std::isfinite(config.player_height) && config.player_height >= 0.0) ? config.player_height : 0.0;
       ceiling_z = std::max(0.0, half_size - player_height);
-      test_plane_z(0.0, 1.0);
-      test_plane_z(ceiling_z, -1.0);
+      const double floor_z = dir.z < 0.0 ? std::min(sweep, std::max(0.0, origin.z)) : sweep;
+      const double roof_z =
+          dir.z > 0.0 ? std::max(ceiling_z - sweep, std::min(ceiling_z, origin.z)) : ceiling_z - sweep;
+      test_plane_z(floor_z, 1.0);
+      test_plane_z(roof_z, -1.0);
     }
   }
   double obs_min_x = 0.0;
@@ -565,40 +945,17 @@ inline RaycastHit RaycastWorld(const Vec3 &origin,
   double obs_max_y = 0.0;
   if (GetObstacleAabb(config, obs_min_x, obs_max_x, obs_min_y, obs_max_y)) {
     const double before_t = best.t;
-    RaycastAabb2D(origin.x, origin.y, dir.x, dir.y, obs_min_x, obs_max_x, obs_min_y, obs_max_y, min_t, max_t, best);
+    RaycastAabb2D(origin.x, origin.y, dir.x, dir.y, obs_min_x - sweep, obs_max_x + sweep, obs_min_y - sweep,
+                  obs_max_y + sweep, min_t, max_t, best);
     if (best.hit && best.t < before_t) {
       best.collider_id = -2;
       best.surface_type = 1;
     }
   }
   if (world) {
-    for (const auto &collider : world->colliders) {
-      if (!IsValidAabbCollider(collider)) {
-        continue;
-      }
-      double t = 0.0;
-      double normal_x = 0.0;
-      double normal_y = 0.0;
-      double normal_z = 0.0;
-      if (!RaycastAabb3D(origin.x, origin.y, origin.z, dir.x, dir.y, dir.z, collider.min_x, collider.max_x,
-                         collider.min_y, collider.max_y, collider.min_z, collider.max_z, t, normal_x, normal_y,
-                         normal_z)) {
-        continue;
-      }
-      if (!std::isfinite(t) || t < min_t || t > max_t || t >= best.t) {
-        continue;
-      }
-      if (collider.id == options.ignore_collider_id) {
-        continue;
-      }
-      best.hit = true;
-      best.t = t;
-      best.normal_x = normal_x;
-      best.normal_y = normal_y;
-      best.normal_z = normal_z;
-      best.collider_id = collider.id;
-      best.surface_type = collider.surface_type;
-    }
+    RaycastWorldOptions collider_options = options;
+    collider_options.sweep_radius = sweep;
+    RaycastColliders(*world, origin, dir, min_t, max_t, collider_options, best);
   }
   return best;
 }
@@ -633,6 +990,27 @@ inline double ResolveEyeHeight(const SimConfig &config, bool crouched = false) {
   return std::min(player_height, kDefaultEyeHeight);
 }
 
+struct ExpandedAabb2D {
+  double min_x = 0.0;
+  double max_x = 0.0;
+  double min_y = 0.0;
+  double max_y = 0.0;
+};
+
+// Buffers reused by StepPlayer's collider queries. They grow to the densest spot a player has
+// visited and are never shrunk, so a warmed-up StepPlayer does not touch the heap.
+struct SimScratch {
+  std::vector<uint32_t> candidates;
+  std::vector<ExpandedAabb2D> expanded_aabbs;
+};
+
+// One per thread so players can be stepped in parallel; without threads (the WASM build) this
+// is a single global.
+inline SimScratch &ThreadSimScratch() {
+  thread_local SimScratch scratch;
+  return scratch;
+}
+
 inline bool CanOccupyHeight(const PlayerState &state,
                             const SimConfig &config,
                             const CollisionWorld *world,
@@ -644,7 +1022,10 @@ inline bool CanOccupyHeight(const PlayerState &state,
   const double min_z = state.z;
   const double max_z = state.z + test_height;
   if (world) {
-    for (const auto &collider : world->colliders) {
+    std::vector<uint32_t> &candidates = ThreadSimScratch().candidates;
+    QueryColliderIndices(*world, state.x - radius, state.x + radius, state.y - radius, state.y + radius, candidates);
+    for (const uint32_t index : candidates) {
+      const AabbCollider &collider = world->colliders[index];
       if (!IsValidAabbCollider(collider)) {
         continue;
       }
@@ -841,13 +1222,6 @@ inline void SweepAabb(double prev_x, double prev_y, double delta_x, double delta
   ConsiderSweepHit(best, hit_t, normal_x, normal_y, clamp_x, clamp_x_valid, clamp_y, clamp_y_valid);
 }
 
-struct ExpandedAabb2D {
-  double min_x = 0.0;
-  double max_x = 0.0;
-  double min_y = 0.0;
-  double max_y = 0.0;
-};
-
 inline bool BuildExpandedAabbFromCollider(const AabbCollider &collider,
                                           const PlayerState &state,
                                           const SimConfig &config,
@@ -884,6 +1258,69 @@ inline void ResolveOverlaps(PlayerState &state, const std::vector<ExpandedAabb2D
   }
 }
 
+// Expanded AABBs of the colliders at the player's height whose XY bounds may touch the
+// rectangle, followed by the config obstacle. Order matches a scan over every collider.
+inline void CollectExpandedAabbs(const PlayerState &state,
+                                 const SimConfig &config,
+                                 const CollisionWorld *world,
+                                 double min_x,
+                                 double max_x,
+                                 double min_y,
+                                 double max_y,
+                                 std::vector<uint32_t> &candidates,
+                                 std::vector<ExpandedAabb2D> &out) {
+  out.clear();
+  if (world && !world->colliders.empty()) {
+    const double radius =
+        (std::isfinite(config.player_radius) && config.player_radius > 0.0) ? config.player_radius : 0.0;
+    QueryColliderIndices(*world, min_x - radius, max_x + radius, min_y - radius, max_y + radius, candidates);
+    for (const uint32_t index : candidates) {
+      ExpandedAabb2D expanded;
+      if (BuildExpandedAabbFromCollider(world->colliders[index], state, config, expanded)) {
+        out.push_back(expanded);
+      }
+    }
+  }
+  double obs_min_x = 0.0;
+  double obs_max_x = 0.0;
+  double obs_min_y = 0.0;
+  double obs_max_y = 0.0;
+  if (GetExpandedObstacleAabb(config, obs_min_x, obs_max_x, obs_min_y, obs_max_y)) {
+    out.push_back({obs_min_x, obs_max_x, obs_min_y, obs_max_y});
+  }
+}
+
+// ResolveOverlaps only ever moves the player onto an edge of a box it is inside. Growing the
+// query rectangle until every touching box lies within it therefore collects every box that
+// resolution can reach, and skipping the rest leaves the result unchanged.
+inline void CollectOverlapAabbs(const PlayerState &state,
+                                const SimConfig &config,
+                                const CollisionWorld *world,
+                                std::vector<uint32_t> &candidates,
+                                std::vector<ExpandedAabb2D> &out) {
+  double min_x = state.x;
+  double max_x = state.x;
+  double min_y = state.y;
+  double max_y = state.y;
+  bool grown = true;
+  while (grown) {
+    grown = false;
+    CollectExpandedAabbs(state, config, world, min_x, max_x, min_y, max_y, candidates, out);
+    for (const auto &aabb : out) {
+      if (aabb.max_x < min_x || aabb.min_x > max_x || aabb.max_y < min_y || aabb.min_y > max_y) {
+        continue;
+      }
+      if (aabb.min_x < min_x || aabb.max_x > max_x || aabb.min_y < min_y || aabb.max_y > max_y) {
+        min_x = std::min(min_x, aabb.min_x);
+        max_x = std::max(max_x, aabb.max_x);
+        min_y = std::min(min_y, aabb.min_y);
+        max_y = std::max(max_y, aabb.max_y);
+        grown = true;
+      }
+    }
+  }
+}
+
 inline void AdvanceWithCollisions(PlayerState &state,
                                   const SimConfig &config,
                                   double dt,
@@ -892,33 +1329,18 @@ inline void AdvanceWithCollisions(PlayerState &state,
   double arena_max = 0.0;
   const bool has_arena = GetArenaBounds(config, arena_min, arena_max);
 
+  SimScratch &scratch = ThreadSimScratch();
+  std::vector<uint32_t> &candidates = scratch.candidates;
+  std::vector<ExpandedAabb2D> &expanded_aabbs = scratch.expanded_aabbs;
   double remaining = dt;
   for (int iteration = 0; iteration < 3 && remaining > 0.0; ++iteration) {
-    std::vector<ExpandedAabb2D> expanded_aabbs;
-    if (world && !world->colliders.empty()) {
-      expanded_aabbs.reserve(world->colliders.size() + 1);
-      for (const auto &collider : world->colliders) {
-        ExpandedAabb2D expanded;
-        if (BuildExpandedAabbFromCollider(collider, state, config, expanded)) {
-          expanded_aabbs.push_back(expanded);
-        }
-      }
-    }
-    double obs_min_x = 0.0;
-    double obs_max_x = 0.0;
-    double obs_min_y = 0.0;
-    double obs_max_y = 0.0;
-    const bool has_obstacle = GetExpandedObstacleAabb(config, obs_min_x, obs_max_x, obs_min_y, obs_max_y);
-    if (has_obstacle) {
-      expanded_aabbs.push_back({obs_min_x, obs_max_x, obs_min_y, obs_max_y});
-    }
-
     if (has_arena) {
       if (state.x < arena_min || state.x > arena_max || state.y < arena_min || state.y > arena_max) {
         ResolveArenaPenetration(state, arena_min, arena_max);
       }
     }
 
+    CollectOverlapAabbs(state, config, world, candidates, expanded_aabbs);
     ResolveOverlaps(state, expanded_aabbs);
 
     const double prev_x = state.x;
@@ -933,6 +1355,13 @@ inline void AdvanceWithCollisions(PlayerState &state,
     if (has_arena) {
       SweepArenaBounds(prev_x, prev_y, delta_x, delta_y, arena_min, arena_max, best);
     }
+    const double end_x = prev_x + delta_x;
+    const double end_y = prev_y + delta_y;
+    const double pad_x = kColliderBvhPadding * (1.0 + std::abs(prev_x) + std::abs(delta_x));
+    const double pad_y = kColliderBvhPadding * (1.0 + std::abs(prev_y) + std::abs(delta_y));
+    CollectExpandedAabbs(state, config, world, std::min(prev_x, end_x) - pad_x, std::max(prev_x, end_x) + pad_x,
+                         std::min(prev_y, end_y) - pad_y, std::max(prev_y, end_y) + pad_y, candidates,
+                         expanded_aabbs);
     for (const auto &aabb : expanded_aabbs) {
       const bool prev_inside = prev_x >= aabb.min_x && prev_x <= aabb.max_x && prev_y >= aabb.min_y && prev_y <= aabb.max_y;
       if (!prev_inside) {
@@ -965,25 +1394,9 @@ inline void AdvanceWithCollisions(PlayerState &state,
     remaining *= (1.0 - best.t);
   }
 
-  std::vector<ExpandedAabb2D> final_aabbs;
-  if (world && !world->colliders.empty()) {
-    final_aabbs.reserve(world->colliders.size() + 1);
-    for (const auto &collider : world->colliders) {
-      ExpandedAabb2D expanded;
-      if (BuildExpandedAabbFromCollider(collider, state, config, expanded)) {
-        final_aabbs.push_back(expanded);
-      }
-    }
-  }
-  double obs_min_x = 0.0;
-  double obs_max_x = 0.0;
-  double obs_min_y = 0.0;
-  double obs_max_y = 0.0;
-  if (GetExpandedObstacleAabb(config, obs_min_x, obs_max_x, obs_min_y, obs_max_y)) {
-    final_aabbs.push_back({obs_min_x, obs_max_x, obs_min_y, obs_max_y});
-  }
-  if (!final_aabbs.empty()) {
-    ResolveOverlaps(state, final_aabbs);
+  CollectOverlapAabbs(state, config, world, candidates, expanded_aabbs);
+  if (!expanded_aabbs.empty()) {
+    ResolveOverlaps(state, expanded_aabbs);
   }
   if (has_arena) {
     ResolveArenaPenetration(state, arena_min, arena_max);
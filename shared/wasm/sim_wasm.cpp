@@ -198,6 +198,9 @@ void sim_step(WasmSimState *state,
   }
   const auto input = afps::sim::MakeInput(move_x, move_y, sprint != 0, jump != 0, dash != 0, grapple != 0,
                                           shield != 0, shockwave != 0, view_yaw, view_pitch, crouch != 0);
+  if (!afps::sim::HasColliderBvh(state->world)) {
+    afps::sim::BuildColliderBvh(state->world);
+  }
   afps::sim::StepPlayer(state->player, input, state->config, dt, &state->world);
 }
 